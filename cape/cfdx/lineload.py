@@ -31,6 +31,10 @@ to create this surface triangulation, some solvers require steps to
 process the native CFD output. Those steps are performed by the
 solver-specific :mod:`lineload` modules.
 
+Alternatively, setting the ``"Integrator"`` option to ``"native"``
+computes the same loads using :func:`cape.trifile.Triq.GetLineLoads`,
+which does not need ``triloadCmd`` (but does not write seam curves).
+
 """
 
 # Standard library
@@ -41,6 +45,7 @@ import numpy as np
 
 # Local imports
 from .. import util
+from .. import trifile
 from . import databook
 from . import casecntl
 from .options import odict
@@ -648,6 +653,7 @@ class LineLoadDataBook(databook.DataBookComp):
             * 2016-12-21 ``@ddalle``: v2.1; add PBS
             * 2017-04-24 ``@ddalle``: v3.0; remove PBS and added output
             * 2021-12-01 ``@ddalle``: v3.1; add *seam*
+            * 2026-10-14 ``@ddalle``: v3.2; add ``"native"`` loads
         """
         # Try to find a match in the data book
         j = self.FindMatch(i)
@@ -723,10 +729,15 @@ class LineLoadDataBook(databook.DataBookComp):
             # Status update
             print("    " + frun)
             print("      Adding new databook entry at iteration %i." % nIter)
-            # Write triloadCmd input file
-            self.WriteTriloadInput(ftriq, i)
-            # Run the command
-            self.RunTriload(qtriq, ftriq, i=i)
+            # Check which tool to use
+            if self.opts.get_DataBookOpt(self.comp, "Integrator") == "native":
+                # Calculate loads directly
+                self.RunLineLoads(qtriq, ftriq, i=i)
+            else:
+                # Write triloadCmd input file
+                self.WriteTriloadInput(ftriq, i)
+                # Run the command
+                self.RunTriload(qtriq, ftriq, i=i)
         else:
             # Status update
             print("    " + frun)
@@ -998,6 +1009,37 @@ class LineLoadDataBook(databook.DataBookComp):
                 Open file handle from :func:`WriteTriloadInputBase`
         :Versions:
             * 2017-04-14 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; use :func:`GetTransformation`
+        """
+        # Combined rotation matrix
+        R = self.GetTransformation(i)
+        # Check if no transformations
+        if R is None:
+            f.write('n\n')
+            return
+        # Yes, we are doing transformations
+        f.write('y\n')
+        # Write the transformation
+        for row in R:
+            f.write("%9.6f %9.6f %9.6f\n" % tuple(row))
+
+    # Combine transformations
+    def GetTransformation(self, i):
+        r"""Get combined rotation matrix from ``"Transformations"``
+
+        :Call:
+            >>> R = DBL.GetTransformation(i)
+        :Inputs:
+            *DBL*: :class:`cape.cfdx.lineload.LineLoadDataBook`
+                Line load data book
+            *i*: :class:`int`
+                Case number
+        :Outputs:
+            *R*: ``None`` | :class:`np.ndarray` shape=(3,3)
+                Rotation matrix, if any
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0; from
+              :func:`WriteTriloadTransformations`
         """
         # Get the raw option from the data book
         db_transforms = self.opts.get_DataBookTransformations(self.comp)
@@ -1015,15 +1057,8 @@ class LineLoadDataBook(databook.DataBookComp):
                 else:
                     # Compound
                     R = np.dot(R, Ri)
-        # Check if no transformations
-        if R is None:
-            f.write('n\n')
-            return
-        # Yes, we are doing transformations
-        f.write('y\n')
-        # Write the transformation
-        for row in R:
-            f.write("%9.6f %9.6f %9.6f\n" % tuple(row))
+        # Output
+        return R
 
     # Calculate transformations
     def CalculateTriloadTransformation(self, i, topts):
@@ -1148,6 +1183,143 @@ class LineLoadDataBook(databook.DataBookComp):
         if ierr:
             return SystemError("Failure while running ``triloadCmd``")
 
+    # Calculate line loads without triload
+    def RunLineLoads(self, qtriq=False, ftriq=None, i=None):
+        r"""Calculate line loads for a case without ``triloadCmd``
+
+        :Call:
+            >>> DBL.RunLineLoads(qtriq=False, ftriq=None, i=None)
+        :Inputs:
+            *DBL*: :class:`cape.cfdx.lineload.LineLoadDataBook`
+                Line load data book
+            *qtriq*: ``True`` | {``False``}
+                Whether or not preprocessing is needed to create TRIQ file
+            *ftriq*: {``None``} | :class:`str`
+                Name of TRIQ file (if needed)
+            *i*: {``None``} | :class:`int`
+                Case index
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Convert
+        if qtriq:
+            self.PreprocessTriq(ftriq, i=i)
+        # Status update
+        print("    Calculating line loads for %s" % self.comp)
+        # Calculate loads and write them
+        self.CalculateLineLoads(ftriq, i)
+
+    # Calculate line loads and write them
+    def CalculateLineLoads(self, ftriq, i, **kw):
+        r"""Calculate line loads and write them like ``triloadCmd``
+
+        :Call:
+            >>> DBL.CalculateLineLoads(ftriq, i, **kw)
+        :Inputs:
+            *DBL*: :class:`cape.cfdx.lineload.LineLoadDataBook`
+                Line load data book
+            *ftriq*: :class:`str`
+                Name of the ``triq`` file to analyze
+            *i*: :class:`int`
+                Case number
+        :Keyword arguments:
+            *mach*: :class:`float`
+                Override Mach number
+            *Re*: :class:`float`
+                Override Reynolds number input
+            *gamma*: :class:`float`
+                Override ratio of specific heats
+            *MRP*: :class:`float`
+                Override the moment reference point from the JSON input file
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        self.CalculateLineLoadsBase(ftriq, i, **kw)
+
+    # Calculate line loads and write them
+    def CalculateLineLoadsBase(self, ftriq, i, **kw):
+        r"""Calculate line loads and write them like ``triloadCmd``
+
+        The loads are written to the same file that ``triloadCmd``
+        would write, using the same options as
+        :func:`WriteTriloadInputBase`.
+
+        :Call:
+            >>> DBL.CalculateLineLoadsBase(ftriq, i, **kw)
+        :Inputs:
+            *DBL*: :class:`cape.cfdx.lineload.LineLoadDataBook`
+                Line load data book
+            *ftriq*: :class:`str`
+                Name of the ``triq`` file to analyze
+            *i*: :class:`int`
+                Case number
+        :Keyword arguments:
+            *mach*: :class:`float`
+                Override Mach number
+            *Re*: :class:`float`
+                Override Reynolds number input
+            *gamma*: :class:`float`
+                Override ratio of specific heats
+            *MRP*: :class:`float`
+                Override the moment reference point from the JSON input file
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Momentum and gauge settings
+        qm = self.opts.get_DataBookMomentum(self.comp)
+        qg = self.opts.get_DataBookGauge(self.comp)
+        # Number of cuts
+        nCut = self.opts.get_DataBookNCut(self.comp)
+        self.nCut = nCut
+        # Cut direction
+        cutdir = self.opts.get_DataBookOpt(self.comp, "CutPlaneNormal")
+        # Get Mach number, Reynolds number, and ratio of specific heats
+        Re = kw.get('Re', self.x.GetReynoldsNumber(i))
+        gam = kw.get('gamma', self.x.GetGamma(i))
+        mach = kw.get('mach', self.x.GetMach(i))
+        # Check for NaNs
+        mach = 1.0 if mach is None else mach
+        Re = 1.0 if Re is None else Re
+        gam = 1.4 if gam is None else gam
+        # Let's save these parameters
+        self.mach = mach
+        self.Re   = Re
+        self.gam  = gam
+        # Reference quantities
+        Aref = self.GetRefArea()
+        Lref = self.GetRefLength()
+        MRP = kw.get('MRP', self.GetMRP())
+        # Check for missing values
+        if Aref is None:
+            raise ValueError(
+                "No reference area specified for %s" % self.RefComp)
+        if Lref is None:
+            raise ValueError(
+                "No reference length specified for %s" % self.RefComp)
+        if MRP is None:
+            raise ValueError(
+                "No moment reference point specified for %s" % self.RefComp)
+        # Read the surface
+        triq = trifile.Triq(ftriq)
+        # Calculate the loads
+        LL = triq.GetLineLoads(
+            self.CompID, nCut=nCut, axis=cutdir, sec=self.sec,
+            R=self.GetTransformation(i),
+            mach=mach, Re=Re, gamma=gam, incm=qm, gauge=qg,
+            Aref=Aref, Lref=Lref, MRP=MRP)
+        # Name of loads file
+        flds = '%s_%s.%s' % (self.proj, self.comp, self.sec)
+        # Columns
+        cols = ['x', 'CA', 'CY', 'CN', 'CLL', 'CLM', 'CLN']
+        # Write the file
+        with open(flds, 'w') as fp:
+            # Header
+            fp.write('# ' + ' '.join(cols) + '\n')
+            # Loop through stations
+            for j in range(LL['x'].size):
+                fp.write(' '.join(['%13.6E' % LL[k][j] for k in cols]))
+                fp.write('\n')
+
     # Convert
     def PreprocessTriq(self, ftriq, **kw):
         """Perform any necessary preprocessing to create ``triq`` file
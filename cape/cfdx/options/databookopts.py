@@ -207,6 +207,7 @@ class LineLoadDataBookOpts(DBCompOpts):
     _optlist = {
         "CutPlaneNormal",
         "Gauge",
+        "Integrator",
         "Momentum",
         "NCut",
         "SectionType",
@@ -227,6 +228,7 @@ class LineLoadDataBookOpts(DBCompOpts):
     _opttypes = {
         "CutPlaneNormal": str,
         "Gauge": BOOL_TYPES,
+        "Integrator": str,
         "Momentum": BOOL_TYPES,
         "NCut": INT_TYPES,
         "Trim": INT_TYPES,
@@ -236,6 +238,7 @@ class LineLoadDataBookOpts(DBCompOpts):
     # Allowed values
     _optvals = {
         "CutPlaneNormal": ("x", "y", "z"),
+        "Integrator": ("triload", "native"),
         "SectionType": {"dlds", "clds", "slds"},
         "TriqFormat": {"", "lr4", "lb4", "r4", "b4"},
     }
@@ -244,6 +247,7 @@ class LineLoadDataBookOpts(DBCompOpts):
     _rc = {
         "CutPlaneNormal": "x",
         "Gauge": True,
+        "Integrator": "triload",
         "Momentum": False,
         "NCut": 200,
         "SectionType": "dlds",
@@ -255,6 +259,7 @@ class LineLoadDataBookOpts(DBCompOpts):
     _rst_descriptions = {
         "CutPlaneNormal": "direction to step between each cut",
         "Gauge": "option to use gauge pressures in computations",
+        "Integrator": "tool to calculate line loads",
         "Momentum": "whether to use momentum flux in line load computations",
         "NCut": "number of cuts to make using ``triload`` (-> +1 slice)",
         "SectionType": "line load section type",
@@ -24,6 +24,7 @@ collection.
 """
 
 # Standard library modules
+import os
 
 # Third-party modules
 import numpy as np
@@ -32,6 +33,12 @@ import numpy as np
 from ..tnakit import typeutils
 from .basedata import BaseData, BaseDataDefn, BaseDataOpts
 
+# Local extension
+try:
+    import _cape
+except ImportError:
+    _cape = None
+
 # Fixed parameter for size of new chunks
 NUM_ARRAY_CHUNK = 5000
 
@@ -45,6 +52,7 @@ class BaseFileOpts(BaseDataOpts):
    # --- Global Options ---
     # List of options
     _optlist = {
+        "Cache",
         "Prefix",
         "Suffix",
         "Translators"
@@ -52,6 +60,7 @@ class BaseFileOpts(BaseDataOpts):
 
     # Alternate names
     _optmap = {
+        "cache": "Cache",
         "prefix": "Prefix",
         "suffix": "Suffix",
         "translators": "Translators",
@@ -60,6 +69,7 @@ class BaseFileOpts(BaseDataOpts):
    # --- Types ---
     # Types allowed
     _opttypes = {
+        "Cache": bool,
         "Prefix": (typeutils.strlike, dict),
         "Suffix": (typeutils.strlike, dict),
         "Translators": dict,
@@ -378,6 +388,123 @@ class BaseFile(BaseData):
             self._nmax[col] = n
   # >
 
+  # ===============
+  # Binary Cache
+  # ===============
+  # <
+    # Name of cache file
+    def get_colcache_fname(self, fname):
+        r"""Get name of binary column cache for a source file
+
+        :Call:
+            >>> fcache = db.get_colcache_fname(fname)
+        :Inputs:
+            *db*: :class:`cape.dkit.ftypes.basefile.BaseFile`
+                Data file interface
+            *fname*: :class:`str`
+                Name of source (text) file
+        :Outputs:
+            *fcache*: :class:`str`
+                Name of cache file, next to *fname*
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        return fname + ".capecol"
+
+    # Source file if caching is enabled
+    def _get_colcache_src(self, f):
+        # Check option and compiled module
+        if _cape is None or not self.get_option("Cache", False):
+            return
+        # Get name of open file
+        fname = getattr(f, "name", None)
+        # Only cache actual files
+        if isinstance(fname, str) and os.path.isfile(fname):
+            return fname
+
+    # Read columns from cache
+    def read_colcache(self, f):
+        r"""Read data columns from binary cache, if valid
+
+        The cache is only used if the *Cache* option is set and the
+        cache matches the size, modification time, and hash of the
+        source file and the columns and types from its header.
+        Numeric columns are then views into a memory mapping of the
+        cache.
+
+        :Call:
+            >>> q = db.read_colcache(f)
+        :Inputs:
+            *db*: :class:`cape.dkit.ftypes.basefile.BaseFile`
+                Data file interface
+            *f*: :class:`file`
+                Source file, open just after header
+        :Outputs:
+            *q*: ``True`` | ``False``
+                Whether columns were read from cache; if so, *f* is
+                moved to the end of the file
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Get source file
+        fname = self._get_colcache_src(f)
+        if fname is None:
+            return False
+        # Compare cache to types from header
+        try:
+            self.create_c_dtypes()
+            q = _cape.ColCacheRead(self, self.get_colcache_fname(fname), fname)
+        except Exception:
+            q = False
+        # Delete _c_dtypes
+        self.__dict__.pop("_c_dtypes", None)
+        if not q:
+            return False
+        # Get lengths
+        self._n = {k: len(self[k]) for k in self.cols}
+        # Save overall length
+        self.n = self._n[self.cols[0]] if self.cols else 0
+        # Skip text that was cached
+        f.seek(0, 2)
+        return True
+
+    # Write columns to cache
+    def write_colcache(self, f):
+        r"""Write data columns to binary cache, if enabled
+
+        Nothing is written unless the *Cache* option is set.  Failures,
+        e.g. from a read-only folder or a data type that can't be
+        cached, are ignored.
+
+        :Call:
+            >>> q = db.write_colcache(f)
+        :Inputs:
+            *db*: :class:`cape.dkit.ftypes.basefile.BaseFile`
+                Data file interface
+            *f*: :class:`file`
+                Source file that columns were just read from
+        :Outputs:
+            *q*: ``True`` | ``False``
+                Whether cache was written
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Get source file
+        fname = self._get_colcache_src(f)
+        if fname is None:
+            return False
+        # Write cache
+        try:
+            self.create_c_dtypes()
+            _cape.ColCacheWrite(self, self.get_colcache_fname(fname), fname)
+            q = True
+        except Exception:
+            q = False
+        # Delete _c_dtypes
+        self.__dict__.pop("_c_dtypes", None)
+        return q
+  # >
+
   # ===============
   # Attributes
   # ===============
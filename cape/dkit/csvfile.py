@@ -274,6 +274,61 @@ class CSVFile(BaseFile, TextInterpreter):
         # Parse 2D arrays, if any
         self.parse_2d_cols()
 
+    # Reader: new rows only
+    def read_csv_tail(self, fname=None):
+        r"""Read rows appended to a CSV file since the last call
+
+        The first call (or any call after the file was truncated or
+        rewritten) reads the whole file and saves the position of the
+        end of the last complete line. Later calls parse only the lines
+        added since then and append them to the existing columns.
+
+        :Call:
+            >>> db.read_csv_tail(fname=None)
+        :Inputs:
+            *db*: :class:`cape.dkit.ftypes.csvfile.CSVFile`
+                CSV file interface
+            *fname*: {*db.fname*} | :class:`str`
+                Name of file to read
+        :Effects:
+            *db._csv_tail*: ``None`` | :class:`tuple`\ [:class:`int`]
+                Byte offset, row count, and checksum of last read
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Default file name
+        if fname is None:
+            fname = self.fname
+        # Saved state
+        state = getattr(self, "_csv_tail", None)
+        # Try reading new rows only
+        if _cape is not None and state is not None and fname == self.fname:
+            try:
+                self.create_c_dtypes()
+                state = _cape.CSVFileReadTail(self, fname, state)
+            except Exception:
+                state = None
+            # Delete _c_dtypes
+            self.__dict__.pop("_c_dtypes", None)
+            # Check for valid incremental read
+            if state is not None:
+                self._csv_tail = state
+                # Get lengths
+                self._n = {k: len(self[k]) for k in self.cols}
+                self.n = self._n[self.cols[0]]
+                return
+        # Full read
+        self.fname = fname
+        with open(fname, 'r') as f:
+            self._read_csv(f)
+            # Position of end of read
+            pos = f.tell()
+        # Save state for next read
+        if _cape is None:
+            self._csv_tail = None
+        else:
+            self._csv_tail = _cape.CSVFileTailState(fname, pos, self.n)
+
     # Reader: C only
     def c_read_csv(self, fname, **kw):
         r"""Read an entire CSV file, including header using C
@@ -583,7 +638,11 @@ class CSVFile(BaseFile, TextInterpreter):
         :Versions:
             * 2019-11-25 ``@ddalle``: v1.0
             * 2019-11-29 ``@ddalle``: Tries C versionfirst
+            * 2026-10-14 ``@ddalle``: v1.2; binary cache if *Cache*
         """
+        # Try binary cache of previous read
+        if self.read_colcache(f):
+            return
         # Save position
         pos = f.tell()
         # Try C then Python readers
@@ -594,6 +653,8 @@ class CSVFile(BaseFile, TextInterpreter):
             f.seek(pos)
             # Read using Python
             self.py_read_csv_data(f)
+        # Save binary cache for next read
+        self.write_colcache(f)
 
     # Read data: C implementation
     def c_read_csv_data(self, f):
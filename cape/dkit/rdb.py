@@ -56,6 +56,12 @@ from .xlsfile import XLSFile
 from ..tnakit import kwutils
 from ..tnakit import typeutils
 
+# Local extension
+try:
+    import _cape
+except ImportError:
+    _cape = None
+
 
 # Accepted list for response_method
 RESPONSE_METHODS = [
@@ -247,6 +253,15 @@ class DataKit(BaseData):
         "rbf-linear": "_create_rbf_linear",
         "rbf-map": "_create_rbf_map",
     }
+
+    # Evaluators for many points at once using :mod:`_cape`
+    _method_batch = {
+        "rcall_multilinear": "_rcall_multilinear_batch",
+        "rcall_multilinear_schedule": "_rcall_multilinear_schedule_batch",
+        "rcall_rbf": "_rcall_rbf_batch",
+        "rcall_rbf_linear": "_rcall_rbf_linear_batch",
+        "rcall_rbf_schedule": "_rcall_rbf_schedule_batch",
+    }
   # >
 
   # =============
@@ -2902,6 +2917,7 @@ class DataKit(BaseData):
             * 2019-01-07 ``@ddalle``: Version 1.0
             * 2019-12-30 ``@ddalle``: Version 2.0: map of methods
             * 2020-04-20 ``@ddalle``: Moved meat from :func:`__call__`
+            * 2026-10-14 ``@ddalle``: Version 2.1; batch evaluation
         """
        # --- Get coefficient name ---
         # Process coefficient
@@ -2973,6 +2989,11 @@ class DataKit(BaseData):
             # Output
             return v
         else:
+            # Try evaluating all points at once
+            V = self._rcall_batch(f, col, args_col, X, **kw_fn)
+            # Check for success
+            if V is not None:
+                return V.reshape(dims)
             # Initialize output
             V = np.zeros(nx)
             # Loop through points
@@ -3012,6 +3033,422 @@ class DataKit(BaseData):
             # Output
             return V
 
+   # --- Batch Evaluation ---
+    # Evaluate response at all points at once
+    def _rcall_batch(self, f, col, args, X, **kw):
+        r"""Evaluate a response at many points using :mod:`_cape`
+
+        This is used by :func:`rcall` for the ``"multilinear"``,
+        ``"multilinear-schedule"``, ``"rbf"``, ``"rbf-linear"``, and
+        ``"rbf-map"`` methods.  If the compiled module is missing, the
+        method has been redefined by a subclass, or the batch evaluator
+        fails for any reason, the result is ``None`` and :func:`rcall`
+        evaluates one point at a time instead (which also gives the
+        more detailed error messages).
+
+        :Call:
+            >>> V = db._rcall_batch(f, col, args, X, **kw)
+        :Inputs:
+            *db*: :class:`DataKit`
+                Database with scalar output functions
+            *f*: :class:`instancemethod`
+                Scalar evaluation method, e.g. :func:`rcall_rbf`
+            *col*: :class:`str`
+                Name of column to evaluate
+            *args*: :class:`list`\ [:class:`str`]
+                List of lookup key names
+            *X*: :class:`list`\ [:class:`np.ndarray`]
+                Values of each arg, each with the same size
+        :Outputs:
+            *V*: ``None`` | :class:`np.ndarray`\ [:class:`float`]
+                Values of *col* at each point, if batch evaluation
+                is possible
+        :Versions:
+            * 2026-10-14 ``@ddalle``: Version 1.0
+        """
+        # Check for compiled module
+        if _cape is None:
+            return
+        # Get name of scalar method
+        fname = getattr(f, "__name__", None)
+        # Get batch version
+        fbatch = self._method_batch.get(fname)
+        # Check for methods redefined by subclasses
+        if fbatch is None:
+            return
+        if getattr(f, "__func__", None) is not getattr(DataKit, fname):
+            return
+        # Evaluate all points
+        try:
+            return getattr(self, fbatch)(col, args, X, **kw)
+        except Exception:
+            # Fall back to one point at a time
+            return
+
+    # Multilinear interpolation at many points
+    def _rcall_multilinear_batch(self, col, args, X, I=None, j=None, **kw):
+        r"""Perform linear interpolation in *n* dimensions at many points
+
+        :Call:
+            >>> V = db._rcall_multilinear_batch(col, args, X, I, j)
+        :Inputs:
+            *db*: :class:`DataKit`
+                Database with scalar output functions
+            *col*: :class:`str`
+                Name of column to evaluate
+            *args*: :class:`list` | :class:`tuple`
+                List of lookup key names
+            *X*: :class:`list`\ [:class:`np.ndarray`]
+                Values of each arg, each with the same size
+            *I*: {``None``} | :class:`np.ndarray`\ [:class:`int`]
+                Optional subset of database on which to perform
+                interpolation
+            *j*: {``None``} | :class:`int`
+                Slice index, used by :func:`rcall_multilinear_schedule`
+        :Outputs:
+            *V*: :class:`np.ndarray`\ [:class:`float`]
+                Interpolated values from ``db[col]``
+        :Versions:
+            * 2026-10-14 ``@ddalle``: Version 1.0
+        """
+        # Interpolation of break points is done one point at a time
+        if kw.get("bkpt", kw.get("breakpoint", False)):
+            raise ValueError("Break point lookup is not a batch method")
+        # Extrapolation option
+        extrap = kw.get("extrap", "hold")
+        # Convert to option of compiled module
+        if extrap in ["hold", "holdlast", "last"]:
+            iextrap = 1
+        elif extrap in ["linear"]:
+            iextrap = 2
+        else:
+            iextrap = 0
+        # Values, possibly a subset
+        V = self[col]
+        if I is not None:
+            V = V[I]
+        # Only scalar outputs
+        if V.ndim != 1:
+            raise ValueError("Col '%s' is not 1D" % col)
+        # Get break points for this schedule
+        bkpts = [self._scheduled_bkpts(k, j) for k in args]
+        # Interpolate
+        return _cape.MultilinearEval(bkpts, V, X, iextrap)
+
+    # Scheduled multilinear interpolation at many points
+    def _rcall_multilinear_schedule_batch(self, col, args, X, **kw):
+        r"""Perform "scheduled" linear interpolation at many points
+
+        :Call:
+            >>> V = db._rcall_multilinear_schedule_batch(col, args, X)
+        :Inputs:
+            *db*: :class:`DataKit`
+                Database with scalar output functions
+            *col*: :class:`str`
+                Name of column to evaluate
+            *args*: :class:`list` | :class:`tuple`
+                List of lookup key names
+            *X*: :class:`list`\ [:class:`np.ndarray`]
+                Values of each arg, each with the same size
+            *tol*: {``1e-6``} | :class:`float` >= 0
+                Tolerance for matching slice key
+        :Outputs:
+            *V*: :class:`np.ndarray`\ [:class:`float`]
+                Interpolated values from ``db[col]``
+        :Versions:
+            * 2026-10-14 ``@ddalle``: Version 1.0
+        """
+        # Slice tolerance
+        tol = kw.get("tol", 1e-6)
+        # Name of master (slice) key
+        skey = args[0]
+        # Get lookup points at both sides of scheduling key
+        I0, I1, F, X0, X1 = self._get_schedule_batch(
+            args, X, extrap=kw.get("extrap", False))
+
+        # Interpolation at one slice
+        def fslice(i, Xi):
+            # Find indices of the slice
+            xs = self.get_bkpt(skey, i)
+            J = np.where(np.abs(self[skey] - xs) <= tol)[0]
+            # Interpolate the remaining args
+            return self._rcall_multilinear_batch(col, args[1:], Xi, I=J, j=i)
+        # Values at both slices
+        Y0 = self._rcall_slices(fslice, I0, X0)
+        Y1 = self._rcall_slices(fslice, I1, X1)
+        # Linear interpolation in the schedule key
+        return (1-F)*Y0 + F*Y1
+
+    # Global RBF at many points
+    def _rcall_rbf_batch(self, col, args, X, **kw):
+        r"""Evaluate a single radial basis function at many points
+
+        :Call:
+            >>> V = db._rcall_rbf_batch(col, args, X)
+        :Inputs:
+            *db*: :class:`DataKit`
+                Database with scalar output functions
+            *col*: :class:`str`
+                Name of column to evaluate
+            *args*: :class:`list` | :class:`tuple`
+                List of lookup key names
+            *X*: :class:`list`\ [:class:`np.ndarray`]
+                Values of each arg, each with the same size
+        :Outputs:
+            *V*: :class:`np.ndarray`\ [:class:`float`]
+                Values of RBF for *col*
+        :Versions:
+            * 2026-10-14 ``@ddalle``: Version 1.0
+        """
+        return self._eval_rbf_batch(self.get_rbf(col), X)
+
+    # RBFs at two slices of first arg at many points
+    def _rcall_rbf_linear_batch(self, col, args, X, **kw):
+        r"""Evaluate two RBFs at slices of first *arg* at many points
+
+        :Call:
+            >>> V = db._rcall_rbf_linear_batch(col, args, X)
+        :Inputs:
+            *db*: :class:`DataKit`
+                Database with scalar output functions
+            *col*: :class:`str`
+                Name of column to evaluate
+            *args*: :class:`list` | :class:`tuple`
+                List of lookup key names
+            *X*: :class:`list`\ [:class:`np.ndarray`]
+                Values of each arg, each with the same size
+        :Outputs:
+            *V*: :class:`np.ndarray`\ [:class:`float`]
+                Interpolated values from *db[col]*
+        :Versions:
+            * 2026-10-14 ``@ddalle``: Version 1.0
+        """
+        # Lookup slices of first variable
+        I0, F = self._bkpt_index_batch(args[0], X[0])
+
+        # Evaluate RBF at one slice
+        def fslice(i, Xi):
+            return self._eval_rbf_batch(self.get_rbf(col, i), Xi)
+        # Evaluate at both slices
+        Y0 = self._rcall_slices(fslice, I0, X[1:])
+        Y1 = self._rcall_slices(fslice, I0 + 1, X[1:])
+        # Interpolate
+        return (1-F)*Y0 + F*Y1
+
+    # RBFs at two slices of scheduled args at many points
+    def _rcall_rbf_schedule_batch(self, col, args, X, **kw):
+        r"""Evaluate two scheduled RBFs at many points and interpolate
+
+        :Call:
+            >>> V = db._rcall_rbf_schedule_batch(col, args, X)
+        :Inputs:
+            *db*: :class:`DataKit`
+                Database with scalar output functions
+            *col*: :class:`str`
+                Name of column to evaluate
+            *args*: :class:`list` | :class:`tuple`
+                List of lookup key names
+            *X*: :class:`list`\ [:class:`np.ndarray`]
+                Values of each arg, each with the same size
+        :Outputs:
+            *V*: :class:`np.ndarray`\ [:class:`float`]
+                Interpolated values from *db[col]*
+        :Versions:
+            * 2026-10-14 ``@ddalle``: Version 1.0
+        """
+        # Get lookup points at both sides of scheduling key
+        I0, I1, F, X0, X1 = self._get_schedule_batch(
+            args, X, extrap=kw.get("extrap", False))
+
+        # Evaluate RBF at one slice
+        def fslice(i, Xi):
+            return self._eval_rbf_batch(self.get_rbf(col, i), Xi)
+        # Evaluate the RBFs at both slices
+        Y0 = self._rcall_slices(fslice, I0, X0)
+        Y1 = self._rcall_slices(fslice, I1, X1)
+        # Interpolate between the slices
+        return (1-F)*Y0 + F*Y1
+
+    # Evaluate one function per slice
+    def _rcall_slices(self, fslice, I, X):
+        r"""Evaluate a response for each slice at the points in it
+
+        :Call:
+            >>> V = db._rcall_slices(fslice, I, X)
+        :Inputs:
+            *db*: :class:`DataKit`
+                Database with scalar output functions
+            *fslice*: :class:`function`
+                Function returning values at slice *i* from
+                ``fslice(i, Xi)``
+            *I*: :class:`np.ndarray`\ [:class:`int`]
+                Slice index of each point
+            *X*: :class:`list`\ [:class:`np.ndarray`]
+                Values of each arg, each with same size as *I*
+        :Outputs:
+            *V*: :class:`np.ndarray`\ [:class:`float`]
+                Value at each point
+        :Versions:
+            * 2026-10-14 ``@ddalle``: Version 1.0
+        """
+        # Initialize output
+        V = np.zeros(I.size)
+        # Loop through slices that have points
+        for i in np.unique(I):
+            # Points in this slice
+            K = np.where(I == i)[0]
+            # Evaluate
+            V[K] = fslice(i, [Xk[K] for Xk in X])
+        # Output
+        return V
+
+    # Evaluate RBF using its stored coefficients
+    def _eval_rbf_batch(self, rbf, X):
+        r"""Evaluate a SciPy RBF at many points using :mod:`_cape`
+
+        :Call:
+            >>> V = db._eval_rbf_batch(rbf, X)
+        :Inputs:
+            *db*: :class:`DataKit`
+                Database with scalar output functions
+            *rbf*: :class:`scipy.interpolate.Rbf`
+                Radial basis function
+            *X*: :class:`list`\ [:class:`np.ndarray`]
+                Values of each arg, each with the same size
+        :Outputs:
+            *V*: :class:`np.ndarray`\ [:class:`float`]
+                Value of *rbf* at each point
+        :Versions:
+            * 2026-10-14 ``@ddalle``: Version 1.0
+        """
+        # Only named basis functions with default norm
+        if not isinstance(rbf.function, str):
+            raise TypeError("RBF basis function is not a name")
+        if getattr(rbf, "norm", "euclidean") != "euclidean":
+            raise ValueError("RBF does not use Euclidean norm")
+        # Centers, one row per arg
+        xi = np.asarray(rbf.xi, dtype="float")
+        xi = xi.reshape((-1, xi.shape[-1]))
+        # Evaluate
+        return _cape.RBFEval(
+            xi, np.asarray(rbf.nodes, dtype="float"),
+            rbf.function.lower(), float(rbf.epsilon),
+            [np.asarray(Xk, dtype="float") for Xk in X])
+
+    # Break point intervals of many values
+    def _bkpt_index_batch(self, col, v):
+        r"""Get interpolation weights for 1D interpolation at many values
+
+        This is a batch version of :func:`get_bkpt_index` that does not
+        allow extrapolation.
+
+        :Call:
+            >>> I0, F = db._bkpt_index_batch(col, v)
+        :Inputs:
+            *db*: :class:`DataKit`
+                Data container
+            *col*: :class:`str`
+                Individual lookup variable from *db.bkpts*
+            *v*: :class:`np.ndarray`\ [:class:`float`]
+                Values at which to lookup
+        :Outputs:
+            *I0*: :class:`np.ndarray`\ [:class:`int`]
+                Lower bound index of each value
+            *F*: :class:`np.ndarray`\ [:class:`float`]
+                Lookup fraction of each value
+        :Versions:
+            * 2026-10-14 ``@ddalle``: Version 1.0
+        """
+        # Break points
+        V = self.get_bkpt(col)
+        # Lookup all values (same tolerance as get_bkpt_index)
+        I0, F = _cape.BkptIndex(V, np.asarray(v, dtype="float"), 1e-8)
+        # Check for extrapolation
+        if np.any(I0 < 0) or np.any(I0 >= len(V) - 1):
+            raise ValueError(
+                "Values of col '%s' outside break points" % col)
+        # Output
+        return I0, F
+
+    # Schedule lookup points at many points
+    def _get_schedule_batch(self, args, X, extrap=True):
+        r"""Get lookup points for scheduled interpolation at many points
+
+        This is a batch version of :func:`get_schedule`.
+
+        :Call:
+            >>> I0, I1, F, X0, X1 = db._get_schedule_batch(args, X)
+        :Inputs:
+            *db*: :class:`DataKit`
+                Database with scalar output functions
+            *args*: :class:`list`\ [:class:`str`]
+                List of input argument names (*args[0]* is master key)
+            *X*: :class:`list`\ [:class:`np.ndarray`]
+                Values of each arg, each with the same size
+            *extrap*: {``True``} | ``False``
+                If ``False``, raise error when lookup value is outside
+                break point range for any key at any slice
+        :Outputs:
+            *I0*: :class:`np.ndarray`\ [:class:`int`]
+                Lower slice index of each point
+            *I1*: :class:`np.ndarray`\ [:class:`int`]
+                Upper slice index of each point
+            *F*: :class:`np.ndarray`\ [:class:`float`]
+                Lookup fraction of each point
+            *X0*: :class:`list`\ [:class:`np.ndarray`]
+                Evaluation values for ``args[1:]`` at *I0*
+            *X1*: :class:`list`\ [:class:`np.ndarray`]
+                Evaluation values for ``args[1:]`` at *I1*
+        :Versions:
+            * 2026-10-14 ``@ddalle``: Version 1.0
+        """
+        # Error check
+        if len(args) < 2:
+            raise ValueError("At least two args required for scheduled lookup")
+        # Slice/scheduling key
+        skey = args[0]
+        # Lookup value for first variable
+        I0, F = self._bkpt_index_batch(skey, X[0])
+        I1 = I0 + 1
+        # Number of slices
+        ns = len(self.get_bkpt(skey))
+        # Initialize lookup points at slices *I0* and *I1*
+        X0 = []
+        X1 = []
+        # Loop through arguments
+        for j, k in enumerate(args[1:]):
+            # Get min and max values at each slice
+            try:
+                # Try the case of varying break points indexed to *skey*
+                xmin = np.array([self.get_bkpt(k, i, 0) for i in range(ns)])
+                xmax = np.array([self.get_bkpt(k, i, -1) for i in range(ns)])
+            except TypeError:
+                # Fixed break points (apparently)
+                xmin = np.full(ns, self.get_bkpt(k, 0))
+                xmax = np.full(ns, self.get_bkpt(k, -1))
+            # Values at each side of each point
+            xmin0 = xmin[I0]
+            xmin1 = xmin[I1]
+            xmax0 = xmax[I0]
+            xmax1 = xmax[I1]
+            # Interpolate to current *skey* values
+            xlo = (1-F)*xmin0 + F*xmin1
+            xhi = (1-F)*xmax0 + F*xmax1
+            # Progress fraction at current inter-slice *skey* values
+            dx = xhi - xlo
+            mask = dx < 1e-8
+            fj = (X[j+1] - xlo) / np.where(mask, 1.0, dx)
+            fj[mask] = 0.0
+            # Check for extrapolation
+            if not extrap and np.any((fj < -1e-3) | (fj - 1 > 1e-3)):
+                raise ValueError(
+                    "Values of arg %i (%s) are outside bounds" % (j, k))
+            # Lookup points at slices *I0* and *I1* using this prog frac
+            X0.append((1-fj)*xmin0 + fj*xmax0)
+            X1.append((1-fj)*xmin1 + fj*xmax1)
+        # Output
+        return I0, I1, F, X0, X1
+
    # --- Alternative Evaluation ---
     # Find exact match
     def rcall_exact(self, col, args, *a, **kw):
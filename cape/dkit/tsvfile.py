@@ -576,11 +576,17 @@ class TSVFile(BaseFile, TextInterpreter):
             * 2019-11-25 ``@ddalle``: Version 1.0 (CSVFile)
             * 2019-11-29 ``@ddalle``: Version 1.1; try C first
             * 2021-01-14 ``@ddalle``: Version 1.0
+            * 2026-10-14 ``@ddalle``: Version 1.1; binary cache
         """
+        # Try binary cache of previous read
+        if self.read_colcache(f):
+            return
         try:
             self.c_read_tsv_data(f)
         except Exception:
             self.py_read_tsv_data(f)
+        # Save binary cache for next read
+        self.write_colcache(f)
 
     # Read data: C implementation
     def c_read_tsv_data(self, f):
@@ -0,0 +1,853 @@
+r"""
+:mod:`cape.extbench`: Throughput benchmarks of the :mod:`_cape` extension
+===========================================================================
+
+This module times the compiled readers, writers, and kernels of
+:mod:`_cape` so that their throughput can be tracked from one release to
+the next.  Each benchmark runs on the files that come with CAPE
+(``samples/bJet.i.tri``, ``test/902_pyfun/005_workers/arrow-far.ugrid``,
+and the databook CSV and TSV files of the tests) and on synthetic inputs
+made by tiling them, so that the same case can be repeated at several
+sizes.
+
+Covered functions are
+
+    * ``.tri`` and ``.triq`` writers in ASCII and all eight Fortran
+      record formats, and the binary readers
+    * AFLR3 ``.surf``, STL, and UH3D writers and readers (no STL reader)
+    * UGRID readers and writers in ASCII and several binary formats
+    * CSV and TSV readers, including the binary column cache
+    * geometry, topology, search, force, and line load kernels
+    * batch interpolation kernels of :mod:`cape.dkit.rdb`
+
+Results are a :class:`list` of :class:`dict`, one for each benchmark,
+with the best wall time of several repeats, the throughput in MB/s
+(10\ :sup:`6` bytes per second of file content) and elements per second,
+the peak resident memory of the process so far, and the calls, bytes,
+and time of the native function from :func:`_cape.io_stats`.  The
+command-line interface ``cape-bench`` writes them as JSON.
+"""
+
+# Standard library
+import fnmatch
+import glob
+import json
+import os
+import platform
+import shutil
+import sys
+import tempfile
+import time
+
+# Third-party modules
+import numpy as np
+
+# Local imports
+from . import argread
+from . import text as textutils
+
+# Attempt to load the compiled helper module
+try:
+    import _cape
+except ImportError:
+    # No module
+    _cape = None
+
+# Attempt to load module for peak memory (not on Windows)
+try:
+    import resource
+except ImportError:
+    resource = None
+
+
+# Help message for executable
+HELP_BENCH = r"""
+``cape-bench``: Measure throughput of the compiled ``_cape`` extension
+=======================================================================
+
+Time each native reader, writer, and kernel on the files that come with
+CAPE and on synthetic meshes made by tiling them, and write the results
+as JSON.
+
+:Usage:
+    .. code-block:: console
+
+        $ cape-bench [PAT1 PAT2 ...] [OPTIONS]
+
+:Inputs:
+    *PAT1*: Optional pattern; only run benchmarks whose name matches
+    *PAT2*: Second pattern, run benchmarks matching *PAT1* or *PAT2*
+
+:Options:
+
+    -h, --help
+        Display this help message and quit
+
+    -o JSON
+        Write results to *JSON* instead of standard output
+
+    --scale SCALES
+        Comma-separated list of tiling factors for synthetic inputs
+        (default ``1,4``)
+
+    --repeat N
+        Number of times to run each benchmark; best time is reported
+        (default ``3``)
+
+    --tmp DIR
+        Write temporary files in folder *DIR* (default: system default)
+
+    --keep
+        Do not delete temporary files
+
+    --root ROOT
+        Look for input files (``samples/``, ``test/``) in folder *ROOT*
+        instead of the CAPE source tree; missing inputs are skipped
+
+:Versions:
+    * 2026-10-14 ``@ddalle``: v1.0
+"""
+
+# Root of CAPE source tree (default folder for input files)
+CAPE_ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+# Input files, relative to *CAPE_ROOT*
+FIXTURE_TRI = os.path.join("samples", "bJet.i.tri")
+FIXTURE_UGRID = os.path.join(
+    "test", "902_pyfun", "005_workers", "arrow-far.ugrid")
+FIXTURE_CSV = os.path.join(
+    "test", "001_cape", "007_databook", "data", "aero_*.csv")
+FIXTURE_TSV = os.path.join(
+    "test", "002_attdb", "015_read_tsv", "CN-*.tsv")
+
+# Formats of each file type
+TRI_FORMATS = ("b4", "lb4", "b8", "lb8", "r4", "lr4", "r8", "lr8")
+SURF_FORMATS = ("ascii", "lb8", "b8", "lr8", "r4")
+UGRID_FORMATS = ("ascii", "lb8", "b8", "lr8", "r4")
+
+# Number of states in synthetic ``.triq`` files
+TRIQ_NQ = 9
+
+# Approximate size of synthetic CSV and TSV files at scale 1 (bytes)
+TEXT_SIZE = 8 * 1024 * 1024
+
+# Freestream conditions for force kernels
+FM_MACH = 0.8
+FM_REY = 1e6
+FM_GAM = 1.4
+
+
+# Class to run benchmarks and collect results
+class ExtBench(object):
+    r"""Benchmarks of :mod:`_cape` readers, writers, and kernels
+
+    :Call:
+        >>> bench = ExtBench(**kw)
+    :Inputs:
+        *scales*: {``(1, 4)``} | :class:`list`\ [:class:`int`]
+            Tiling factors for synthetic inputs
+        *repeat*: {``3``} | :class:`int`
+            Number of times to run each benchmark
+        *pats*: {``None``} | :class:`list`\ [:class:`str`]
+            Only run benchmarks whose name matches one of these patterns
+        *tmp*: {``None``} | :class:`str`
+            Folder for temporary files
+        *keep*: ``True`` | {``False``}
+            Whether to keep temporary files
+        *root*: {``None``} | :class:`str`
+            Folder containing input files; default is CAPE source tree
+    :Outputs:
+        *bench*: :class:`ExtBench`
+            Benchmark runner
+    :Attributes:
+        *bench.results*: :class:`list`\ [:class:`dict`]
+            One entry for each benchmark that was run
+    :Versions:
+        * 2026-10-14 ``@ddalle``: v1.0
+    """
+    # Initialization method
+    def __init__(self, **kw):
+        # Options
+        self.scales = [int(s) for s in kw.get("scales", (1, 4))]
+        self.repeat = max(1, int(kw.get("repeat", 3)))
+        self.pats = kw.get("pats")
+        self.tmp = kw.get("tmp")
+        self.keep = kw.get("keep", False)
+        self.root = kw.get("root") or CAPE_ROOT
+        # Results
+        self.results = []
+        # Folder for outputs
+        self.workdir = None
+
+   # --- Run ---
+    # Run all benchmarks
+    def run(self):
+        r"""Run all benchmarks and return report
+
+        :Call:
+            >>> report = bench.run()
+        :Inputs:
+            *bench*: :class:`ExtBench`
+                Benchmark runner
+        :Outputs:
+            *report*: :class:`dict`
+                Description of machine and build, and *bench.results*
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Check for extension
+        if _cape is None:
+            raise ImportError("No _cape extension module")
+        # Create folder for outputs
+        self.workdir = tempfile.mkdtemp(prefix="cape-bench-", dir=self.tmp)
+        try:
+            # Run each group
+            self.run_tri()
+            self.run_ugrid()
+            self.run_text()
+            self.run_interp()
+        finally:
+            # Clean up
+            if not self.keep:
+                shutil.rmtree(self.workdir, ignore_errors=True)
+        # Output
+        return self.get_report()
+
+    # Run triangulation benchmarks
+    def run_tri(self):
+        r"""Run tri, triq, surf, STL, and UH3D I/O and mesh kernels
+
+        The fixture is read once and tiled by each factor in
+        *bench.scales* along *x*.
+
+        :Call:
+            >>> bench.run_tri()
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Local import (:mod:`trifile` is large)
+        from .trifile import Tri
+        # Absolute path to fixture
+        fname = os.path.join(self.root, FIXTURE_TRI)
+        if not os.path.isfile(fname):
+            return
+        # Read ASCII fixture (no native reader), then time it
+        tri = Tri(fname)
+        self.bench_read("Tri.Read", os.path.basename(fname), tri.nTri,
+            fname, lambda: Tri(fname))
+        # Native arrays
+        P0 = np.ascontiguousarray(tri.Nodes, dtype="f8")
+        T0 = np.ascontiguousarray(tri.Tris, dtype="i4")
+        C0 = np.ascontiguousarray(tri.CompID, dtype="i4")
+        # Loop through sizes
+        for scale in self.scales:
+            P, T, C = tile_tri(P0, T0, C0, scale)
+            case = "bJet x%i" % scale
+            self.run_tri_io(case, P, T, C)
+            self.run_tri_kernels(case, P, T, C)
+
+    # Run tri file I/O benchmarks for one mesh
+    def run_tri_io(self, case, P, T, C):
+        r"""Run tri, triq, surf, STL, and UH3D I/O for one mesh
+
+        :Call:
+            >>> bench.run_tri_io(case, P, T, C)
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Sizes
+        ntri = T.shape[0]
+        nnode = P.shape[0]
+        # Synthetic states
+        Q = synthetic_states(P)
+        # ASCII tri and triq (no native ASCII readers)
+        self.bench_write("WriteTri", case, ntri, "ascii.tri",
+            lambda f: _cape.WriteTri(P, T, C, f))
+        self.bench_write("WriteTriQ", case, ntri, "ascii.triq",
+            lambda f: _cape.WriteTriQ(P, T, C, Q, f))
+        # Binary Fortran record formats
+        for fmt in TRI_FORMATS:
+            writer = getattr(_cape, "WriteTri_%s" % fmt)
+            # Tri
+            fname = self.bench_write(
+                "WriteTri_%s" % fmt, case, ntri, "%s.tri" % fmt,
+                lambda f: writer(P, T, C, f))
+            self.bench_read("ReadTri", case + " " + fmt, ntri, fname,
+                lambda: _cape.ReadTri(fname))
+            # Triq
+            fname = self.bench_write(
+                "WriteTri_%s" % fmt, case + " triq", ntri, "%s.triq" % fmt,
+                lambda f: writer(P, T, C, f, 4, Q))
+            self.bench_read("ReadTriQ", case + " " + fmt, ntri, fname,
+                lambda: _cape.ReadTriQ(fname))
+        # Stream (no record markers)
+        for bo in ("little", "big"):
+            fname = self.bench_write(
+                "WriteTriStream", case + " " + bo, ntri, "%s.stream" % bo,
+                lambda f: _cape.WriteTriStream(f, P, T, C, Q, bo))
+            self.bench_read("ReadTriStream", case + " " + bo, ntri, fname,
+                lambda: _cape.ReadTriStream(fname))
+        # Background write
+        self.bench_write("WriteTriQAsync", case, ntri, "async.triq",
+            lambda f: _cape.WriteWait(
+                _cape.WriteTriQAsync(P, T, C, Q, f)))
+        # AFLR3 surf, with no quads
+        blds = np.zeros(nnode)
+        bldel = np.zeros(nnode)
+        BCT = np.zeros(ntri, dtype="i4")
+        Q4 = np.zeros((0, 4), dtype="i4")
+        CQ = np.zeros(0, dtype="i4")
+        for fmt in SURF_FORMATS:
+            fname = self.bench_write(
+                "WriteSurf", case + " " + fmt, ntri, "%s.surf" % fmt,
+                lambda f: _cape.WriteSurf(
+                    P, blds, bldel, T, C, BCT, Q4, CQ, CQ, f, fmt))
+            self.bench_read("ReadSurf", case + " " + fmt, ntri, fname,
+                lambda: _cape.ReadSurf(fname, fmt))
+        # STL (write only)
+        self.bench_write("WriteTriSTL", case, ntri, "ascii.stl",
+            lambda f: _cape.WriteTriSTL(P, T, None, f))
+        self.bench_write("WriteTriSTLBin", case, ntri, "bin.stl",
+            lambda f: _cape.WriteTriSTLBin(P, T, None, f))
+        # UH3D, with components numbered from 1
+        cids, K = np.unique(C, return_inverse=True)
+        K = np.ascontiguousarray(K.flatten() + 1, dtype="i4")
+        labels = [str(c) for c in cids]
+        fname = self.bench_write("WriteUH3D", case, ntri, "uh3d",
+            lambda f: _cape.WriteUH3D(P, T, K, labels, f))
+        self.bench_read("ReadUH3D", case, ntri, fname,
+            lambda: _cape.ReadUH3D(fname))
+
+    # Run mesh kernel benchmarks for one mesh
+    def run_tri_kernels(self, case, P, T, C):
+        r"""Run mesh and force kernels for one mesh
+
+        :Call:
+            >>> bench.run_tri_kernels(case, P, T, C)
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Sizes
+        ntri = T.shape[0]
+        nnode = P.shape[0]
+        # Synthetic states
+        Q = synthetic_states(P)
+        # Geometry
+        self.bench_kernel("TriGeom", case, ntri,
+            lambda: _cape.TriGeom(P, T))
+        self.bench_kernel("TriNodeNormals", case, ntri,
+            lambda: _cape.TriNodeNormals(P, T))
+        self.bench_kernel("TriCompGeom", case, ntri,
+            lambda: _cape.TriCompGeom(P, T, C))
+        # Topology and cleanup
+        self.bench_kernel("TriTopology", case, ntri,
+            lambda: _cape.TriTopology(T, nnode))
+        # (works in place, so copy time is included)
+        self.bench_kernel("TriWeldNodes", case, ntri,
+            lambda: _cape.TriWeldNodes(P.copy(), T.copy(), 1e-8))
+        # Search tree and nearest-tri queries from perturbed nodes
+        self.bench_kernel("TriBVH", case, ntri,
+            lambda: _cape.TriBVH(P, T, C))
+        bvh = _cape.TriBVH(P, T, C)
+        X = np.ascontiguousarray(P[::4] + 1e-3)
+        self.bench_kernel("TriBVHNearest", case, X.shape[0],
+            lambda: _cape.TriBVHNearest(bvh, X, 1))
+        # Forces and line loads
+        self.bench_kernel("TriqForces", case, ntri,
+            lambda: _cape.TriqForces(P, T, Q, C, FM_MACH, FM_REY, FM_GAM))
+        xcut = np.linspace(np.min(P[:, 0]), np.max(P[:, 0]), 101)
+        axis = np.array([1.0, 0.0, 0.0])
+        self.bench_kernel("TriqLineLoads", case, ntri,
+            lambda: _cape.TriqLineLoads(
+                P, T, Q, C, xcut, axis, FM_MACH, FM_REY, FM_GAM))
+
+    # Run UGRID benchmarks
+    def run_ugrid(self):
+        r"""Run UGRID readers and writers on volume grid fixture
+
+        :Call:
+            >>> bench.run_ugrid()
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Absolute path to fixture
+        fname = os.path.join(self.root, FIXTURE_UGRID)
+        if not os.path.isfile(fname):
+            return
+        # Read header to get sizes
+        ns, data = _cape.ReadUGrid(fname, "ascii")
+        nelem = int(sum(ns[1:]))
+        case = os.path.basename(fname)
+        # Read fixture
+        self.bench_read("ReadUGrid", case + " ascii", nelem, fname,
+            lambda: _cape.ReadUGrid(fname, "ascii"))
+        # Write and read each format
+        for fmt in UGRID_FORMATS:
+            fout = self.bench_write(
+                "WriteUGrid", case + " " + fmt, nelem, "%s.ugrid" % fmt,
+                lambda f: _cape.WriteUGrid(f, fmt, data))
+            self.bench_read("ReadUGrid", case + " " + fmt, nelem, fout,
+                lambda: _cape.ReadUGrid(fout, fmt))
+
+    # Run CSV and TSV benchmarks
+    def run_text(self):
+        r"""Run CSV and TSV readers on fixtures and repeated rows
+
+        :Call:
+            >>> bench.run_text()
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Local imports (:mod:`cape.dkit` is large)
+        from .dkit.csvfile import CSVFile
+        from .dkit.tsvfile import TSVFile
+        # Loop through file types
+        for cls, name, pat in (
+                (CSVFile, "CSVFileReadData", FIXTURE_CSV),
+                (TSVFile, "TSVFileReadData", FIXTURE_TSV)):
+            # Fixtures
+            fnames = sorted(glob.glob(os.path.join(self.root, pat)))
+            for fname in fnames:
+                self.bench_text(name, cls, os.path.basename(fname), fname)
+            # Synthetic files from largest fixture
+            if len(fnames) == 0:
+                continue
+            fsrc = max(fnames, key=os.path.getsize)
+            ext = fsrc.rsplit(".", 1)[-1]
+            for scale in self.scales:
+                fname = os.path.join(
+                    self.workdir, "rows-x%i.%s" % (scale, ext))
+                repeat_rows(fsrc, fname, scale * TEXT_SIZE)
+                case = "%s rows x%i" % (os.path.basename(fsrc), scale)
+                self.bench_text(name, cls, case, fname)
+                # Binary column cache (first read writes it)
+                if cls is CSVFile:
+                    cls(fname, Cache=True)
+                    self.bench_text(
+                        "ColCacheRead", cls, case + " cache", fname,
+                        Cache=True)
+
+    # Run interpolation benchmarks
+    def run_interp(self):
+        r"""Run batch multilinear and RBF kernels on synthetic tables
+
+        :Call:
+            >>> bench.run_interp()
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Repeatable inputs
+        rng = np.random.RandomState(1)
+        for scale in self.scales:
+            case = "synthetic x%i" % scale
+            # Multilinear table with three args
+            nx = 250000 * scale
+            bkpts = [np.linspace(0.0, 1.0, nb) for nb in (21, 11, 6)]
+            V = rng.rand(21 * 11 * 6)
+            X = [rng.rand(nx) for _ in bkpts]
+            self.bench_kernel("MultilinearEval", case, nx,
+                lambda: _cape.MultilinearEval(bkpts, V, X))
+            # Cubic RBF with two args
+            nx = 10000 * scale
+            xi = rng.rand(2, 500)
+            w = rng.rand(500)
+            X = [rng.rand(nx) for _ in range(2)]
+            self.bench_kernel("RBFEval", case, nx,
+                lambda: _cape.RBFEval(xi, w, "cubic", 0.1, X))
+
+   # --- Timing ---
+    # Time a writer
+    def bench_write(self, name, case, nelem, suffix, fn):
+        r"""Time a writer and return name of file it wrote
+
+        :Call:
+            >>> fname = bench.bench_write(name, case, nelem, suffix, fn)
+        :Inputs:
+            *bench*: :class:`ExtBench`
+                Benchmark runner
+            *name*: :class:`str`
+                Name of native function
+            *case*: :class:`str`
+                Description of inputs
+            *nelem*: :class:`int`
+                Number of elements written
+            *suffix*: :class:`str`
+                End of output file name
+            *fn*: :class:`callable`
+                Function that writes to the file name it is given
+        :Outputs:
+            *fname*: :class:`str`
+                Name of file written by last repeat
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Output file
+        fname = os.path.join(self.workdir, "bench.%s" % suffix)
+        # Check for filter (file still needed by readers)
+        if not self.check_name(name):
+            fn(fname)
+            return fname
+        # Run it
+        stats0 = _cape.io_stats()
+        t = self.time_best(lambda: fn(fname))
+        stats1 = _cape.io_stats()
+        # Save results
+        self.add_result(
+            name, case, nelem, os.path.getsize(fname), t,
+            diff_stats(stats0, stats1, name))
+        return fname
+
+    # Time a reader
+    def bench_read(self, name, case, nelem, fname, fn):
+        r"""Time a reader
+
+        :Call:
+            >>> bench.bench_read(name, case, nelem, fname, fn)
+        :Inputs:
+            *bench*: :class:`ExtBench`
+                Benchmark runner
+            *name*: :class:`str`
+                Name of native function
+            *case*: :class:`str`
+                Description of inputs
+            *nelem*: :class:`int`
+                Number of elements read
+            *fname*: :class:`str`
+                Name of file read by *fn*
+            *fn*: :class:`callable`
+                Function with no arguments that reads *fname*
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        self.bench_kernel(name, case, nelem, fn, os.path.getsize(fname))
+
+    # Time CSV or TSV reader
+    def bench_text(self, name, cls, case, fname, **kw):
+        # Check for filter
+        if not self.check_name(name):
+            return
+        # Read once for size
+        db = cls(fname, **kw)
+        nelem = db.n * len(db.cols)
+        # Time it
+        self.bench_kernel(
+            name, case, nelem, lambda: cls(fname, **kw),
+            os.path.getsize(fname))
+
+    # Time a function
+    def bench_kernel(self, name, case, nelem, fn, nbyte=None):
+        r"""Time a native function with no file output
+
+        :Call:
+            >>> bench.bench_kernel(name, case, nelem, fn, nbyte=None)
+        :Inputs:
+            *bench*: :class:`ExtBench`
+                Benchmark runner
+            *name*: :class:`str`
+                Name of native function
+            *case*: :class:`str`
+                Description of inputs
+            *nelem*: :class:`int`
+                Number of elements processed
+            *fn*: :class:`callable`
+                Function with no arguments
+            *nbyte*: {``None``} | :class:`int`
+                Number of bytes of file content processed
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Check for filter
+        if not self.check_name(name):
+            return
+        # Run it
+        stats0 = _cape.io_stats()
+        t = self.time_best(fn)
+        stats1 = _cape.io_stats()
+        # Save results
+        self.add_result(
+            name, case, nelem, nbyte, t, diff_stats(stats0, stats1, name))
+
+    # Best time of several calls
+    def time_best(self, fn):
+        r"""Get smallest wall time of *bench.repeat* calls to *fn*
+
+        :Call:
+            >>> t = bench.time_best(fn)
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Initialize
+        tbest = None
+        for _ in range(self.repeat):
+            t0 = time.perf_counter()
+            fn()
+            t = time.perf_counter() - t0
+            tbest = t if tbest is None else min(t, tbest)
+        return tbest
+
+   # --- Results ---
+    # Check if benchmark should run
+    def check_name(self, name):
+        # Run everything if no patterns
+        if not self.pats:
+            return True
+        return any(fnmatch.fnmatch(name, pat) for pat in self.pats)
+
+    # Save result of one benchmark
+    def add_result(self, name, case, nelem, nbyte, t, native):
+        r"""Save result of one benchmark
+
+        :Call:
+            >>> bench.add_result(name, case, nelem, nbyte, t, native)
+        :Inputs:
+            *bench*: :class:`ExtBench`
+                Benchmark runner
+            *name*: :class:`str`
+                Name of native function
+            *case*: :class:`str`
+                Description of inputs
+            *nelem*: :class:`int`
+                Number of elements processed in each call
+            *nbyte*: :class:`int` | ``None``
+                Number of bytes of file content in each call
+            *t*: :class:`float`
+                Best wall time of one call (seconds)
+            *native*: :class:`dict` | ``None``
+                Change in :func:`_cape.io_stats` for *name*
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Avoid dividing by zero for very fast kernels
+        tdiv = max(t, 1e-9)
+        # Create result
+        result = {
+            "name": name,
+            "case": case,
+            "elements": int(nelem),
+            "bytes": None if nbyte is None else int(nbyte),
+            "time": t,
+            "MB/s": None if nbyte is None else 1e-6 * nbyte / tdiv,
+            "elements/s": nelem / tdiv,
+            "peak_rss_MB": get_peak_rss(),
+            "native": native,
+        }
+        self.results.append(result)
+        # Progress
+        sys.stderr.write("%-18s %-24s %10.4f s\n" % (name, case, t))
+        sys.stderr.flush()
+
+    # Overall report
+    def get_report(self):
+        r"""Get description of machine and build with all results
+
+        :Call:
+            >>> report = bench.get_report()
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Local import to avoid cycle
+        from . import __version__
+        # Output
+        return {
+            "cape": __version__,
+            "python": platform.python_version(),
+            "platform": platform.platform(),
+            "machine": platform.machine(),
+            "cpus": os.cpu_count(),
+            "codecs": list(_cape.ZipCodecs()),
+            "scales": self.scales,
+            "repeat": self.repeat,
+            "peak_rss_MB": get_peak_rss(),
+            "results": self.results,
+        }
+
+
+# Tile a triangulation along *x*
+def tile_tri(P, T, C, n):
+    r"""Make *n* copies of a triangulation, side by side along *x*
+
+    :Call:
+        >>> P1, T1, C1 = tile_tri(P, T, C, n)
+    :Inputs:
+        *P*: :class:`np.ndarray`\ [:class:`float`] (*nNode*, 3)
+            Nodal coordinates
+        *T*: :class:`np.ndarray`\ [:class:`int`] (*nTri*, 3)
+            One-based node numbers of each tri
+        *C*: :class:`np.ndarray`\ [:class:`int`] (*nTri*,)
+            Component ID of each tri
+        *n*: :class:`int`
+            Number of copies
+    :Outputs:
+        *P1*: :class:`np.ndarray`\ [:class:`float`] (*n* x *nNode*, 3)
+            Nodal coordinates of tiled mesh
+        *T1*: :class:`np.ndarray`\ [:class:`int`] (*n* x *nTri*, 3)
+            Tris of tiled mesh
+        *C1*: :class:`np.ndarray`\ [:class:`int`] (*n* x *nTri*,)
+            Component IDs of tiled mesh
+    :Versions:
+        * 2026-10-14 ``@ddalle``: v1.0
+    """
+    # Nothing to do for one copy
+    if n <= 1:
+        return P, T, C
+    # Spacing between copies
+    dx = 1.1 * (np.max(P[:, 0]) - np.min(P[:, 0])) or 1.0
+    nnode = P.shape[0]
+    # Shifted nodes and renumbered tris
+    P1 = np.vstack([P + np.array([k*dx, 0.0, 0.0]) for k in range(n)])
+    T1 = np.vstack([T + k*nnode for k in range(n)])
+    C1 = np.tile(C, n)
+    # Output
+    return (
+        np.ascontiguousarray(P1, dtype="f8"),
+        np.ascontiguousarray(T1, dtype="i4"),
+        np.ascontiguousarray(C1, dtype="i4"))
+
+
+# States for synthetic ``.triq`` files
+def synthetic_states(P):
+    r"""Create smooth states at each node for ``.triq`` benchmarks
+
+    Columns are *Cp*, *rho*, *rhoU*, *rhoV*, *rhoW*, *e*, and three
+    viscous terms, so that force kernels see finite values.
+
+    :Call:
+        >>> Q = synthetic_states(P)
+    :Versions:
+        * 2026-10-14 ``@ddalle``: v1.0
+    """
+    # Initialize
+    Q = np.zeros((P.shape[0], TRIQ_NQ))
+    # Pressure varying with *x*, uniform flow otherwise
+    Q[:, 0] = 0.1 * np.sin(P[:, 0])
+    Q[:, 1] = 1.0
+    Q[:, 2] = FM_MACH
+    Q[:, 5] = 1.0 / (FM_GAM * (FM_GAM - 1)) + 0.5 * FM_MACH**2
+    Q[:, 6:] = 1e-3
+    return Q
+
+
+# Write a text file by repeating data rows of another
+def repeat_rows(fsrc, fname, size):
+    r"""Write a CSV or TSV file by repeating data rows of *fsrc*
+
+    Header (comment) lines are written once, and then all data rows are
+    repeated until the file is at least *size* bytes.
+
+    :Call:
+        >>> repeat_rows(fsrc, fname, size)
+    :Versions:
+        * 2026-10-14 ``@ddalle``: v1.0
+    """
+    # Read source
+    with open(fsrc) as fp:
+        lines = fp.readlines()
+    # Split header and data
+    head = [line for line in lines if line.lstrip().startswith("#")]
+    data = "".join(line for line in lines if not (
+        line.lstrip().startswith("#") or line.strip() == ""))
+    # Check for data
+    nrep = max(1, size // max(1, len(data)))
+    # Write
+    with open(fname, "w") as fp:
+        fp.write("".join(head))
+        for _ in range(nrep):
+            fp.write(data)
+
+
+# Change in native counters
+def diff_stats(stats0, stats1, name):
+    r"""Get change in :func:`_cape.io_stats` of one function
+
+    :Call:
+        >>> d = diff_stats(stats0, stats1, name)
+    :Inputs:
+        *stats0*: :class:`dict`
+            Counters before benchmark
+        *stats1*: :class:`dict`
+            Counters after benchmark
+        *name*: :class:`str`
+            Name of function
+    :Outputs:
+        *d*: :class:`dict` | ``None``
+            Change in ``"calls"``, ``"bytes"``, and ``"time"``; ``None``
+            if *name* was not called
+    :Versions:
+        * 2026-10-14 ``@ddalle``: v1.0
+    """
+    # Counters after
+    s1 = stats1.get(name)
+    if s1 is None:
+        return None
+    # Counters before (zero if not called yet)
+    s0 = stats0.get(name, {})
+    # Difference
+    d = {k: v - s0.get(k, 0) for k, v in s1.items()}
+    # Check for no new calls
+    if d["calls"] == 0:
+        return None
+    return d
+
+
+# Peak memory of this process
+def get_peak_rss():
+    r"""Get peak resident memory of this process so far
+
+    :Call:
+        >>> mb = get_peak_rss()
+    :Outputs:
+        *mb*: :class:`float` | ``None``
+            Peak resident set size in MB (10\ :sup:`6` bytes), or
+            ``None`` if not available
+    :Versions:
+        * 2026-10-14 ``@ddalle``: v1.0
+    """
+    # Check for module
+    if resource is None:
+        return None
+    # Peak resident set size; KiB on Linux but bytes on macOS
+    rss = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    if sys.platform == "darwin":
+        return 1e-6 * rss
+    return 1.024e-3 * rss
+
+
+# Command-line interface
+def main():
+    r"""Command-line interface to ``cape-bench``
+
+    :Call:
+        >>> main()
+    :Versions:
+        * 2026-10-14 ``@ddalle``: v1.0
+    """
+    # Process command-line parameters
+    a, kw = argread.readkeys(sys.argv)
+    # Check for "help" option
+    if kw.get("h") or kw.get("help"):
+        print(textutils.markdown(HELP_BENCH))
+        return
+    # Options
+    scales = str(kw.get("scale", "1,4")).split(",")
+    bench = ExtBench(
+        scales=[s for s in scales if s.strip()],
+        repeat=kw.get("repeat", 3),
+        pats=list(a),
+        tmp=kw.get("tmp"),
+        keep=kw.get("keep", False),
+        root=kw.get("root"))
+    # Run
+    report = bench.run()
+    # Write results
+    fjson = kw.get("o")
+    if fjson:
+        with open(fjson, "w") as fp:
+            json.dump(report, fp, indent=1)
+            fp.write("\n")
+    else:
+        json.dump(report, sys.stdout, indent=1)
+        sys.stdout.write("\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -6,6 +6,13 @@ One key functionality of this module is to determine the file type of
 ``.ugrid`` files or determine that they are not recognizable files of
 that format.
 
+If the compiled :mod:`_cape` module is available, files given by name
+are read with :func:`_cape.ReadUGrid`, and all files are written with
+:func:`_cape.WriteUGrid`.
+Binary files are then mapped into memory, and only the requested sections
+are read, so the surface of a large volume mesh can be extracted without
+reading its volume cells.
+
 """
 
 # Standard library
@@ -28,6 +35,12 @@ from .umeshbase import UmeshBase
 from .errors import GruvocValueError, assert_isinstance
 from .fileutils import keep_pos, openfile
 
+# Attempt to load the compiled helper module
+try:
+    import _cape
+except ImportError:
+    # No module
+    _cape = None
 
 # Special file type
 UGRIDFileType = namedtuple(
@@ -63,7 +76,7 @@ SLOT_GROUPS = {
     "surf_flags": ("tri_flags", "quad_flags"),
     "surf_bcs": ("tri_bcs", "quad_bcs"),
 }
-# Descriptions of each group
+# Descriptions of each group, in the order they are written
 FIELD_DESCRIPTIONS = {
     "nodes": "node coordinates",
     "tris": "tri face node indices",
@@ -80,6 +93,15 @@ FIELD_DESCRIPTIONS = {
     "blds": "initial normal grid spacing",
     "bldel": "total BL height for each node",
 }
+# Groups skipped when reading only the surface
+VOL_FIELDS = (
+    "tets",
+    "pyrs",
+    "pris",
+    "hexs",
+    "ntet_bl",
+    "vol_ids",
+)
 
 
 # Read UGRID file
@@ -88,12 +110,13 @@ def read_ugrid(
         fname_or_fp: Union[str, IOBase],
         meta: bool = False,
         fmt: Optional[str] = None,
-        novol: bool = False):
+        novol: bool = False,
+        sections: Optional[tuple] = None):
     r"""Read data to a mesh object from ``.ugrid`` file
 
     :Call:
-        >>> read_ugrid(mesh, fname, meta=False, fmt=None)
-        >>> read_ugrid(mesh, fp, meta=False, fmt=None)
+        >>> read_ugrid(mesh, fname, meta=False, fmt=None, **kw)
+        >>> read_ugrid(mesh, fp, meta=False, fmt=None, **kw)
     :Inputs:
         *mesh*: :class:`Umesh`
             Unstructured mesh object
@@ -105,6 +128,14 @@ def read_ugrid(
             Read only metadata (number of nodes, tris, etc.)
         *fmt*: {``None``} | :class:`str`
             Manual data format, ``"l?[br][48]l?"``
+        *novol*: ``True`` | {``False``}
+            Skip volume cells and their IDs
+        *sections*: {``None``} | :class:`tuple`\ [:class:`str`]
+            Groups to read, e.g. ``("nodes", "tris", "surf_ids")``;
+            keys of :data:`FIELD_DESCRIPTIONS`
+    :Versions:
+        * 2026-10-14 ``@ddalle``: v1.1; add *sections*, compiled reader
+        * 2026-10-14 ``@ddalle``: v1.2; compiled reader for names only
     """
     # Check type
     assert_isinstance(mesh, UmeshBase, "mesh object to store data in")
@@ -119,10 +150,22 @@ def read_ugrid(
                 f"Unable to recognize UGRID file format for '{fp.name}'")
         # Get format
         fmt = ugridmode.fmt
+        # Groups to read
+        if meta:
+            sections = ()
+        elif novol and sections is None:
+            sections = tuple(
+                field for field in FIELD_DESCRIPTIONS
+                if field not in VOL_FIELDS)
+        # Use compiled reader for files opened here; an open file given
+        # by the caller is read from its current position and mode
+        if _cape is not None and isinstance(fname_or_fp, str):
+            _read_ugrid_c(mesh, fp.name, fmt, sections)
+            return
         # Get appropriate int and float readers for this format
         iread, fread = READ_FUNCS[fmt]
         # Read file
-        _read_ugrid(mesh, fp, iread, fread, meta=meta, novol=novol)
+        _read_ugrid(mesh, fp, iread, fread, meta=meta, sections=sections)
 
 
 # Write UGRID file
@@ -144,6 +187,8 @@ def write_ugrid(
             File object
         *fmt*: {``None``} | :class:`str`
             Manual data format, ``"l?[br][48]l?"``
+    :Versions:
+        * 2026-10-14 ``@ddalle``: v1.1; use compiled writer if available
     """
     # Check type
     assert_isinstance(mesh, UmeshBase, "mesh object to write to")
@@ -158,6 +203,10 @@ def write_ugrid(
                 f"Unable to recognize UGRID file format for '{fp.name}'")
         # Get data format
         fmt = ugridmode.fmt
+        # Use compiled writer if available
+        if _cape is not None:
+            _write_ugrid_c(mesh, fp, fmt)
+            return
         # Get writer functions
         iwrite, fwrite = WRITE_FUNCS[fmt]
         # Write file
@@ -297,7 +346,7 @@ def _read_ugrid(
         iread: Callable,
         fread: Callable,
         meta: bool = False,
-        novol: bool = False):
+        sections: Optional[tuple] = None):
     # Resulting settings induced from ugrid
     mesh.mesh_type = "unstruc"
     # Save location
@@ -349,24 +398,78 @@ def _read_ugrid(
         ("blds", fread, (nnode,), None),
         ("bldel", fread, (nnode,), None),
     )
+    # Groups to read
+    sections = FIELD_DESCRIPTIONS if sections is None else sections
+    # Index of last group needed
+    jlast = max(
+        (j for j, row in enumerate(read_sequence) if row[0] in sections),
+        default=-1)
     # Loop through read sequence
-    for field, fn, shape, brks in read_sequence:
+    for field, fn, shape, brks in read_sequence[:jlast + 1]:
         # Size
         n = np.prod(shape)
         # Check for EOF
         if (n > 0) and (fp.tell() >= fsize):
             return
+        # Skip groups that weren't requested
+        if field not in sections:
+            fn(fp, n)
+            continue
         # Get description
         desc = FIELD_DESCRIPTIONS[field]
         # Get groups if necessary
         slot_or_slots = SLOT_GROUPS.get(field, field)
-        # Check surface-only flag
-        if novol and (field == "tets"):
-            return
         # Read nodes
         mesh._read_to_slot(fp, slot_or_slots, fn, shape, desc, brks)
 
 
+# Read UGRID using compiled reader
+def _read_ugrid_c(
+        mesh: UmeshBase,
+        fname: str,
+        fmt: str,
+        sections: Optional[tuple] = None):
+    # Resulting settings induced from ugrid
+    mesh.mesh_type = "unstruc"
+    # Save location
+    mesh.path = os.path.dirname(os.path.abspath(fname))
+    mesh.name = os.path.basename(fname).split(".")[0]
+    # Read header and requested groups
+    ns, data = _cape.ReadUGrid(fname, fmt, sections)
+    # Unpack sizes
+    nnode, ntri, nquad, ntet, npyr, npri, nhex = ns
+    # Save parameters
+    mesh.nnode = nnode
+    mesh.ntri = ntri
+    mesh.nquad = nquad
+    mesh.ntet = ntet
+    mesh.npyr = npyr
+    mesh.npri = npri
+    mesh.nhex = nhex
+    # Sizes of each part of combined groups
+    breaks = {
+        "surf_ids": (ntri,),
+        "vol_ids": (ntet, npyr, npri),
+        "surf_flags": (ntri,),
+        "surf_bcs": (ntri,),
+    }
+    # Save each group that was read
+    for field, x in data.items():
+        # Get groups if necessary
+        slot_or_slots = SLOT_GROUPS.get(field, field)
+        # Check for single slot or multiple
+        if isinstance(slot_or_slots, str):
+            setattr(mesh, slot_or_slots, x)
+            continue
+        # Split ranges into start and end indices
+        cuts = np.cumsum(breaks[field])
+        ia = np.hstack((0, cuts))
+        ib = np.hstack((cuts, x.size))
+        # Save each range (views into *x*)
+        for slotj, iaj, ibj in zip(slot_or_slots, ia, ib):
+            setattr(mesh, slotj, x[iaj:ibj])
+
+
 # Write UGRID
 def _write_ugrid(
         mesh: UmeshBase,
@@ -414,6 +517,37 @@ def _write_ugrid(
             f"File {fp.name} missing minimal information (nodes+tris)")
 
 
+# Write UGRID using compiled writer
+def _write_ugrid_c(
+        mesh: UmeshBase,
+        fp: IOBase,
+        fmt: str):
+    # Collect groups in order, up to first missing one
+    data = {}
+    for field in FIELD_DESCRIPTIONS:
+        # Get slot(s) for this group
+        slot_or_slots = SLOT_GROUPS.get(field, field)
+        # Check for single slot or multiple
+        if isinstance(slot_or_slots, str):
+            x = getattr(mesh, slot_or_slots)
+        else:
+            # Get each part
+            xs = [getattr(mesh, slot) for slot in slot_or_slots]
+            # Combine them unless one is missing
+            x = None if any(xj is None for xj in xs) else np.hstack(xs)
+        # Exit loop if one of the slots was ``None``
+        if x is None:
+            break
+        # Save group (scalars as 1-D arrays)
+        data[field] = np.atleast_1d(x)
+    # Check if we have minimal elements
+    if len(data) < 2:
+        raise GruvocValueError(
+            f"File {fp.name} missing minimal information (nodes+tris)")
+    # Write file
+    _cape.WriteUGrid(fp, fmt, data)
+
+
 def _get_ugrid_mode_fname(
         fname: str,
         fmt: Optional[str] = None) -> UGRIDFileType:
@@ -275,8 +275,10 @@ class Umesh(UmeshBase):
             fname_or_fp: Union[str, IOBase],
             meta: bool = False,
             fmt: Optional[str] = None,
-            novol: bool = False):
-        read_ugrid(self, fname_or_fp, meta, fmt, novol=novol)
+            novol: bool = False,
+            sections: Optional[tuple] = None):
+        read_ugrid(
+            self, fname_or_fp, meta, fmt, novol=novol, sections=sections)
 
     def read_uh3d(
             self,
@@ -8,6 +8,11 @@ The :class:`cape.plot3d.Q` interface to solution files also exists, but
 it is not reliable since Plot3D solution files are dependent on the
 solver used to create the solution file.
 
+If the compiled :mod:`_cape` module is available, binary files are
+mapped into memory and indexed with :func:`_cape.ReadP3D`, so that
+reading a few grids of a large multiple-grid file only reads those
+grids.
+
 """
 
 # Standard library
@@ -22,6 +27,13 @@ from . import util
 from . import trifile
 from .filecntl import namelist2
 
+# Attempt to load the compiled helper module
+try:
+    import _cape
+except ImportError:
+    # No module
+    _cape = None
+
 
 # Default tolerances for mapping triangulations
 atoldef = 3e-2
@@ -44,21 +56,27 @@ class X(object):
   # Config
   # ========
   # <
+    # Kind of file for :func:`_cape.ReadP3D`
+    _kind = "x"
+
     # Initialization method
-    def __init__(self, fname=None):
+    def __init__(self, fname=None, grids=None):
         r"""Initialization method
 
         :Call:
-            >>> x = X(fname=None)
+            >>> x = X(fname=None, grids=None)
         :Inputs:
             *fname*: :class:`str`
                 Name of Plot3D grid file to read
+            *grids*: {``None``} | :class:`list`\ [:class:`int`]
+                Grid numbers (1-based) to read; default is all
         :Versions:
             * 2016-10-11 ``@ddalle``: Version 1.0
+            * 2026-10-14 ``@ddalle``: Version 1.1; add *grids*
         """
         # Check for a file to read
         if fname is not None:
-            self.Read(fname)
+            self.Read(fname, grids=grids)
 
     # Display method
     def __repr__(self):
@@ -87,10 +105,17 @@ class X(object):
         r"""Read a Plot3D grid file of any format
 
         :Call:
-            >>> x.Read(fname)
+            >>> x.Read(fname, grids=None, **kw)
         :Inputs:
             *x*: :class:`cape.plot3d.X`
                 Plot3D grid interface
+            *fname*: :class:`str`
+                Name of Plot3D file
+            *grids*: {``None``} | :class:`list`\ [:class:`int`]
+                Grid numbers (1-based) to read; default is all (only
+                used by compiled reader, see :func:`ReadGrids`)
+            *lb8*, *b8*, *lb4*, ..., *ascii*: ``True`` | {``False``}
+                Read in specified format instead of detecting it
         :Attributes:
             *x.X*: :class:`np.ndarray` (:class:`float` shape=(N,3))
                 Array of coordinates of all points in the grid
@@ -105,7 +130,18 @@ class X(object):
         :Versions:
             * 2016-10-15 ``@ddalle``: Version 1.0
             * 2017-02-07 ``@ddalle``: Version 1.1, updated doc
+            * 2026-10-14 ``@ddalle``: Version 1.2; use compiled reader
         """
+        # Use compiled reader for binary files if available
+        if (_cape is not None) and (not kw.get("ascii")):
+            # Get format from keywords, if any
+            fmt = None
+            for ext in ("lb8", "b8", "lb4", "b4", "lr8", "r8", "lr4", "r4"):
+                if kw.get(ext):
+                    fmt = ext
+            # Read (text files are left for Python reader)
+            if self.ReadGrids(fname, kw.get("grids"), fmt) != "ascii":
+                return
         # Check for keywords
         if kw.get('lb8'):
             # Read as little-endian double stream
@@ -174,6 +210,78 @@ class X(object):
             # Read as an ASCII file
             self.Read_ASCII(fname)
 
+    # Read selected grids using compiled module
+    def ReadGrids(self, fname, grids=None, fmt=None):
+        r"""Read all or selected grids of a binary Plot3D file
+
+        The file is mapped into memory and indexed by
+        :func:`_cape.ReadP3D`, so grids that are not requested are never
+        read.  The attributes describe only the grids that were read, in
+        the order they appear in the file.
+
+        :Call:
+            >>> ext = x.ReadGrids(fname, grids=None, fmt=None)
+        :Inputs:
+            *x*: :class:`cape.plot3d.X`
+                Plot3D grid interface
+            *fname*: :class:`str`
+                Name of Plot3D file
+            *grids*: {``None``} | :class:`list`\ [:class:`int`]
+                Grid numbers (1-based) to read; default is all
+            *fmt*: {``None``} | ``"lr8"`` | ``"b4"`` | ...
+                File format; detected from file size if ``None``
+        :Outputs:
+            *ext*: ``"ascii"`` | ``"l?[br][48]"``
+                File type; nothing is read if ``"ascii"``
+        :Attributes:
+            *x.IG*: :class:`np.ndarray`\ [:class:`int`]
+                Grid number in file (1-based) of each grid read
+            *x.X*: :class:`np.ndarray` (:class:`float` shape=(3,N))
+                Coordinates of all points of grids read (grid files)
+            *x.IB*: :class:`np.ndarray`\ [:class:`int`]
+                IBLANK of each point, if *x.iblank*
+            *x.Q*: :class:`list`\ [:class:`np.ndarray`]
+                Values of each grid read, shape (*NQ*, *NL*, *NK*, *NJ*)
+                (function files)
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Zero-based grid indices
+        if grids is not None:
+            grids = [ig - 1 for ig in grids]
+        # Index and read grids
+        H, G, B = _cape.ReadP3D(fname, self._kind, fmt, grids)
+        # Check for text file
+        self.ext = H["fmt"]
+        if self.ext == "ascii":
+            return self.ext
+        # File type
+        self.byteorder = "little" if self.ext.startswith("l") else "big"
+        self.filetype = "record" if "r" in self.ext else "stream"
+        self.p3dtype = "multiple" if H["multi"] else "single"
+        self.iblank = H["iblank"]
+        # Grids that were read
+        IG = [i for i, g in enumerate(G) if g is not None]
+        self.IG = np.array(IG, dtype="int") + 1
+        self.NG = len(IG)
+        self.dims = H["dims"][IG]
+        self.NJ = self.dims[:, 0]
+        self.NK = self.dims[:, 1]
+        self.NL = self.dims[:, 2]
+        # Check for function file
+        if self._kind == "f":
+            self.NQ = self.dims[:, 3]
+            self.Q = [G[i] for i in IG]
+            return self.ext
+        # Join coordinates of the grids
+        self.X = np.hstack(
+            [np.asarray(G[i], dtype="float").reshape((3, -1)) for i in IG])
+        # Join IBLANKs
+        if self.iblank:
+            self.IB = np.hstack([B[i].flatten() for i in IG])
+        # Output
+        return self.ext
+
     # Determine file type blindly
     def GetFileType(self, fname):
         r"""Get full file type of a Plot3D grid file
@@ -887,6 +995,66 @@ class X(object):
   # Writers
   # =======
   # <
+    # Write in any format
+    def Write(self, fname, fmt="lr8", single=False):
+        r"""Write a Plot3D grid file in any format
+
+        Uses :func:`_cape.WriteP3D` if the compiled module is available,
+        which can write all binary formats and includes IBLANK if
+        *x.iblank* is set.  Otherwise only ``"ascii"`` and record formats
+        are available.
+
+        :Call:
+            >>> x.Write(fname, fmt="lr8", single=False)
+        :Inputs:
+            *x*: :class:`cape.plot3d.X`
+                Plot3D grid interface
+            *fname*: :class:`str`
+                Name of Plot3D file
+            *fmt*: ``"ascii"`` | {``"lr8"``} | ``"b4"`` | ...
+                File format
+            *single*: ``True`` | {``False``}
+                If ``True``, write a single-zone file
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Check for Python writers
+        if (_cape is None) or (fmt == "ascii"):
+            # The record writers are named by byte order and precision
+            funcs = {
+                "ascii": self.Write_ASCII,
+                "lr8": self.Write_lb8,
+                "lr4": self.Write_lb4,
+                "r8": self.Write_b8,
+                "r4": self.Write_b4,
+            }
+            # Check format
+            if fmt not in funcs:
+                raise ValueError(
+                    "Plot3D format '%s' requires compiled module" % fmt)
+            funcs[fmt](fname, single=single)
+            return
+        # Point counts
+        npt = np.prod(self.dims, axis=1)
+        mpt = np.append([0], np.cumsum(npt))
+        # Coordinates of each grid as (3, NL, NK, NJ) views
+        G = []
+        B = None
+        for i in range(self.NG):
+            nj, nk, nl = self.dims[i]
+            G.append(self.X[:, mpt[i]:mpt[i+1]].reshape((3, nl, nk, nj)))
+        # IBLANK of each grid
+        if getattr(self, "iblank", False) and hasattr(self, "IB"):
+            B = [self.IB[mpt[i]:mpt[i+1]] for i in range(self.NG)]
+        # Header
+        H = {
+            "kind": "x",
+            "fmt": fmt,
+            "multi": not (single and self.NG == 1),
+        }
+        # Write
+        _cape.WriteP3D(fname, H, G, B)
+
     # Write as an ASCII file
     def Write_ASCII(self, fname, single=False):
         r"""Write a multiple-zone ASCII Plot3D file
@@ -1229,6 +1397,7 @@ class X(object):
 
         :Versions:
             * 2017-02-08 ``@ddalle``: Version 1.0
+            * 2026-10-14 ``@ddalle``: Version 1.1; search all points at once
         """
         # Check grid number
         if n > self.NG:
@@ -1257,7 +1426,7 @@ class X(object):
         rnftol = kw.get("rnftol", kw.get("RelProjFamilyTol", rnftoldef))
         cnftol = kw.get("cnftol", kw.get("CompProjFamilyTol", cnftoldef))
         # Get scale of the entire triangulation
-        L = trifile.GetCompScale()
+        L = tri.GetCompScale()
         # Initialize scales of components
         LC = {}
         # Put together absolute and relative tols
@@ -1266,7 +1435,7 @@ class X(object):
         ftol  = aftol  + rftol*L
         nftol = anftol + rnftol*L
         # Get number of points in prior grids
-        ia = np.prod(self.NJ[:n-1] * self.NK[:n-1] * self.NL[:n-1]) - 1
+        ia = np.sum(self.NJ[:n-1] * self.NK[:n-1] * self.NL[:n-1])
         # Get number of points
         nj = self.NJ[n-1]
         nk = self.NK[n-1]
@@ -1275,6 +1444,10 @@ class X(object):
         v = kw.get("v", False)
         # Initialize components for each surface grid
         C = np.zeros((nj,nk,4), dtype=int)
+        # Indices of surface points, in the same order as the loops below
+        I = ia + np.arange(nj*nk)
+        # Search for nearest tris to all points at once
+        TK = tri.GetNearestTris(self.X[:,I].T, n=4)
         # Loop through columns
         for k in range(nk):
             # Status update if verbose
@@ -1284,8 +1457,11 @@ class X(object):
             for j in range(nj):
                 # Get overall index
                 i = ia + k*nj + j
-                # Perform search
-                T = trifile.GetNearestTri(self.X[:,i])
+                # Search results for this point, skipping missing comps
+                T = {}
+                for key, V in TK.items():
+                    if TK["k" + key[1:]][i - ia] >= 0:
+                        T[key] = V[i - ia]
                 # Get components
                 c1 = T.get("c1")
                 c2 = T.get("c2")
@@ -1293,10 +1469,10 @@ class X(object):
                 c4 = T.get("c4")
                 # Make sure component scale is present
                 if c1 not in LC:
-                    LC[c1] = trifile.GetCompScale(c1)
+                    LC[c1] = tri.GetCompScale(c1)
                 # Make sure secondary component scale is present
                 if (c2 is not None) and (c2 not in LC):
-                    LC[c2] = trifile.GetCompScale(c2)
+                    LC[c2] = tri.GetCompScale(c2)
                 # Get overall tolerances
                 toli  = tol + ctol*LC[c1]
                 ntoli = ntol + cntol*LC[c1]
@@ -1311,7 +1487,7 @@ class X(object):
                 if (c2 is not None):
                      # Make sure secondary component scale is present
                     if c2 not in LC:
-                        LC[c2] = trifile.GetCompScale(c2)
+                        LC[c2] = tri.GetCompScale(c2)
                     # Maximum component scale
                     Li = max(LC[c1], LC[c2])
                     # Get overall tolerances
@@ -1526,16 +1702,20 @@ class Q(X):
     :Versions:
         * 2016-10-11 ``@ddalle``: Version 1.0
     """
+    # Kind of file for :func:`_cape.ReadP3D`
+    _kind = "f"
+
     # Initialization method
-    def __init__(self, fname=None):
+    def __init__(self, fname=None, grids=None):
         r"""Initialization method
 
         :Versions:
             * 2016-10-11 ``@ddalle``: Version 1.0
+            * 2026-10-14 ``@ddalle``: Version 1.1; add *grids*
         """
         # Check for a file to read
         if fname is not None:
-            self.Read(fname)
+            self.Read(fname, grids=grids)
 
   # =======
   # Readers
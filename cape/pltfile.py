@@ -21,6 +21,12 @@ See also:
     * :mod:`cape.tri`
     * :mod:`cape.pyfun.plt`
 
+If the compiled :mod:`_cape` module is available, binary files are read
+with :func:`_cape.ReadPlt` and written with :func:`_cape.WritePlt`.  The
+file is then mapped into memory and scanned once, each zone's variable
+blocks are converted to a point-by-variable array in a single pass, and
+the min/max of each variable is computed while the data is written.
+
 """
 
 # Standard library
@@ -34,6 +40,12 @@ from . import capeio
 from . import trifile as trifile
 from . import util as capeutil
 
+# Attempt to load the compiled helper module
+try:
+    import _cape
+except ImportError:
+    # No module
+    _cape = None
 
 # Text patterns
 REGEX_VARS = re.compile("variables", re.IGNORECASE)
@@ -212,7 +224,12 @@ class Plt(object):
         :Versions:
             * 2016-11-22 ``@ddalle``: Version 1.0
             * 2022-09-16 ``@ddalle``: Version 2.0; unstruc volume
+            * 2026-10-14 ``@ddalle``: Version 2.1; use compiled reader
         """
+        # Use compiled reader if available
+        if _cape is not None:
+            self._read_plt_c(fname)
+            return
         # Open the file
         f = open(fname, 'rb')
         # Read the opening string
@@ -460,6 +477,7 @@ class Plt(object):
             * 2017-03-29 ``@ddalle``: Version 1.0
             * 2017-05-16 ``@ddalle``: Version 1.1; variable list
             * 2017-12-18 ``@ddalle``: Version 1.2; *CompID* input
+            * 2026-10-14 ``@ddalle``: Version 1.3; use compiled writer
         """
         # Default variable list
         if Vars is None:
@@ -470,6 +488,10 @@ class Plt(object):
         IZone = kw.get("CompID", range(self.nZone))
         # Indices of variabels
         IVar = np.array([self.Vars.index(v) for v in Vars])
+        # Use compiled writer if available
+        if _cape is not None:
+            self._write_plt_c(fname, Vars, IVar, IZone)
+            return
         # Open the file
         f = open(fname, 'wb')
         # Write the opening string
@@ -575,6 +597,108 @@ class Plt(object):
         # Close the file
         f.close()
 
+    # Compiled binary reader
+    def _read_plt_c(self, fname):
+        r"""Read a Tecplot binary file using :func:`_cape.ReadPlt`
+
+        :Call:
+            >>> pltfile._read_plt_c(fname)
+        :Inputs:
+            *plt*: :class:`pyFun.pltfile.Plt`
+                Tecplot PLT interface
+            *fname*: :class:`str`
+                Name of file to read
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Read and index whole file
+        D = _cape.ReadPlt(fname)
+        # Header
+        self.line2 = np.array([1, 0], dtype="i4")
+        self.title = D["title"]
+        self.Vars = D["vars"]
+        self.nVar = len(self.Vars)
+        # Zone names, stripping quotes like the Python reader
+        self.Zones = []
+        for zone in D["zones"]:
+            if zone.startswith('"') and zone.endswith('"'):
+                zone = zone.strip('"')
+            self.Zones.append(zone)
+        self.nZone = len(self.Zones)
+        # Zone properties
+        self.ParentZone = list(D["parent"])
+        self.StrandID = list(D["strand"])
+        self.t = list(D["time"])
+        self.ZoneType = list(D["type"])
+        self.ZoneAux = D["aux"]
+        # Only node-centered variables are supported
+        self.QVarLoc = [0] * self.nZone
+        self.VarLocs = [[] for _ in range(self.nZone)]
+        # Sizes
+        self.nPt = np.array(D["npt"])
+        self.nElem = np.array(D["nelem"])
+        # Data
+        self.fmt = D["fmt"]
+        self.qmin = D["qmin"]
+        self.qmax = D["qmax"]
+        self.q = D["q"]
+        self.Tris = D["elems"]
+
+    # Compiled binary writer
+    def _write_plt_c(self, fname, Vars, IVar, IZone):
+        r"""Write a Tecplot binary file using :func:`_cape.WritePlt`
+
+        :Call:
+            >>> pltfile._write_plt_c(fname, Vars, IVar, IZone)
+        :Inputs:
+            *plt*: :class:`pyFun.pltfile.Plt`
+                Tecplot PLT interface
+            *fname*: :class:`str`
+                Name of file to write
+            *Vars*: :class:`list`\ [:class:`str`]
+                Names of variables to write
+            *IVar*: :class:`np.ndarray`\ [:class:`int`]
+                Index of each variable in *pltfile.Vars*
+            *IZone*: :class:`list`\ [:class:`int`]
+                Indices of zones to write
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Get property of zone *i*, with default
+        def zoneprop(attr, i, vdef):
+            try:
+                return getattr(self, attr)[i]
+            except Exception:
+                return vdef
+        # Zone names, wrapped in double quotes like the Python writer
+        zones = []
+        for i in IZone:
+            zone = self.Zones[i]
+            if '"' not in zone:
+                zone = '"' + zone + '"'
+            zones.append(zone)
+        # Store doubles for variables read as doubles (or 4-byte ints)
+        fmt = np.ones((len(IZone), len(Vars)), dtype="i4")
+        for j, i in enumerate(IZone):
+            fmtj = np.asarray(zoneprop("fmt", i, fmt[j]))[IVar]
+            fmt[j] = np.where((fmtj == 2) | (fmtj == 3), 2, 1)
+        # Everything the writer needs; min/max are computed during write
+        D = {
+            "title": getattr(self, "title", "untitled"),
+            "vars": list(Vars),
+            "zones": zones,
+            "aux": [zoneprop("ZoneAux", i, {}) for i in IZone],
+            "parent": [zoneprop("ParentZone", i, -1) for i in IZone],
+            "strand": [zoneprop("StrandID", i, 1000 + i) for i in IZone],
+            "time": [zoneprop("t", i, 0.0) for i in IZone],
+            "type": [zoneprop("ZoneType", i, 3) for i in IZone],
+            "fmt": fmt,
+            "q": [np.asarray(self.q[i])[:, IVar] for i in IZone],
+            "elems": [self.Tris[i] for i in IZone],
+        }
+        # Write
+        _cape.WritePlt(fname, D)
+
     # Tec Boundary reader
     def ReadDat(self, fname):
         r"""Read an ASCII Tecplot data file
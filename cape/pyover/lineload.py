@@ -515,6 +515,36 @@ class LineLoadDataBook(lineload.LineLoadDataBook):
         # Point to a fixed "grid.i.triq" file
         self.WriteTriloadInputBase("grid.i.triq", i, **kw)
 
+    # Calculate line loads without triload
+    def CalculateLineLoads(self, ftriq, i, **kw):
+        """Calculate line loads and write them like ``triloadCmd``
+
+        This versions uses a fixed input solution/grid file, ``"grid.i.triq"``
+
+        :Call:
+            >>> DBL.CalculateLineLoads(ftriq, i, **kw)
+        :Inputs:
+            *DBL*: :class:`LineLoadDataBook`
+                Line load data book
+            *ftriq*: :class:`str`
+                Name of the ``triq`` file to analyze
+            *i*: :class:`int`
+                Case number
+        :Keyword arguments:
+            *mach*: :class:`float`
+                Override Mach number
+            *Re*: :class:`float`
+                Override Reynolds number input
+            *gamma*: :class:`float`
+                Override ratio of specific heats
+            *MRP*: :class:`float`
+                Override the moment reference point from the JSON input file
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Point to a fixed "grid.i.triq" file
+        self.CalculateLineLoadsBase("grid.i.triq", i, **kw)
+
     # Preprocess triq file (convert from PLT)
     def PreprocessTriq(self, fq, **kw):
         """Perform any necessary preprocessing to create ``triq`` file
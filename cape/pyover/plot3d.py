@@ -13,6 +13,10 @@ custommized header from OVERFLOW ``q`` files, it also contains special
 calculators such as :func:`Q.get_Cp` that calculate derived quantities
 from the native OVERFLOW output state variables.
 
+If the compiled :mod:`_cape` module is available, ``q`` files are mapped
+into memory and indexed once, and the solution of each grid is only read
+when requested (see :func:`Q.GetQ`).
+
 :See also:
     * :mod:`cape.plot3d`
 """
@@ -26,6 +30,13 @@ import numpy as np
 from .. import plot3d
 from ..tnakit import typeutils
 
+# Attempt to load the compiled helper module
+try:
+    import _cape
+except ImportError:
+    # No module
+    _cape = None
+
 
 # OVERFLOW Plot3D template
 class P3D(plot3d.X):
@@ -291,24 +302,28 @@ class Q(P3D):
     General OVERFLOW ``q`` file interface
 
     :Call:
-        >>> q = pyOver.plot3d.Q(fname, endian=None)
+        >>> q = pyOver.plot3d.Q(fname, endian=None, grids=None)
     :Inputs:
         *fname*: :class:`str`
             Name of file to read
         *endian*: {``None``} | "big" | "little"
             Manually-specified byte order
+        *grids*: {``None``} | :class:`list`\ [:class:`int`]
+            Grid numbers (1-based) to read; default is all
     :Outputs:
         *q*: :class:`pyOver.plot3d.Q`
             General OVERFLOW q-file interface
     :Versions:
         * 2016-02-26 ``@ddalle``: First version
+        * 2026-10-14 ``@ddalle``: Version 1.1; add *grids*
     """
     # Initialization method
-    def __init__(self, fname, endian=None):
+    def __init__(self, fname, endian=None, grids=None):
         """Initialization method
 
         :Versions:
             * 2016-02-26 ``@ddalle``: First version
+            * 2026-10-14 ``@ddalle``: Version 1.1; add *grids*
         """
         # Save the file name
         self.fname = fname
@@ -326,17 +341,20 @@ class Q(P3D):
         # Get flags
         self.get_dtypes()
         # Read the file
-        self.Read()
+        self.Read(grids)
 
     # Read the file
-    def Read(self):
+    def Read(self, grids=None):
         """Read an OVERFLOW generic Q file
 
         :Call:
-            >>> q.Read()
+            >>> q.Read(grids=None)
         :Inputs:
             *q*: :class:`pyOver.plot3d.Q`
                 General OVERFLOW q-file interface
+            *grids*: {``None``} | :class:`list`\ [:class:`int`]
+                Grid numbers (1-based) to read; default is all (only
+                used by compiled reader, see :func:`ReadQGrids`)
         :Data members:
             *q.nGrid*: :class:`int`
                 Number of grids
@@ -346,24 +364,30 @@ class Q(P3D):
                 List of solution arrays
         :Versions:
             * 2016-02-26 ``@ddalle``: First version
+            * 2026-10-14 ``@ddalle``: Version 1.1; use compiled reader
         """
-        # Open file if necessary
-        self.open()
-        # Get number of grids
-        nGrid = self.GetNGrid()
-        # Read grid dimensions
-        self.GetGridDims()
-        # Initialize header quantities
-        self.InitHeaders()
-        # Loop through grids
-        for i in range(nGrid):
-            # Read headers
-            self.ReadQHeader(i+1)
-            self.ReadQData(i+1)
-        # Reread if q.restart...
-
-        # Close the file
-        self.close()
+        # Check for compiled reader
+        if _cape is not None:
+            # Index file and read requested grids
+            self.ReadQGrids(grids)
+        else:
+            # Open file if necessary
+            self.open()
+            # Get number of grids
+            nGrid = self.GetNGrid()
+            # Read grid dimensions
+            self.GetGridDims()
+            # Initialize header quantities
+            self.InitHeaders()
+            # Loop through grids
+            for i in range(nGrid):
+                # Read headers
+                self.ReadQHeader(i+1)
+                self.ReadQData(i+1)
+            # Reread if q.restart...
+
+            # Close the file
+            self.close()
         # Freestream viscosity
         self.MUINF = self.mu0 * self.TINF**1.5 / (self.TINF+self.TREF)
         # Freestream speed of sound
@@ -377,6 +401,113 @@ class Q(P3D):
         # Dynamic pressure
         self.QINF = 0.5*self.RHOINF * self.UINF**2
 
+    # Read grids using compiled module
+    def ReadQGrids(self, grids=None):
+        r"""Read headers and all or selected grids using compiled module
+
+        The file is mapped into memory and indexed by
+        :func:`_cape.ReadP3D`, which also reads the header of every grid.
+        Solutions of grids that are not requested are left as ``None``
+        and can be read later with :func:`GetQ`.
+
+        :Call:
+            >>> q.ReadQGrids(grids=None)
+        :Inputs:
+            *q*: :class:`pyOver.plot3d.Q`
+                General OVERFLOW q-file interface
+            *grids*: {``None``} | :class:`list`\ [:class:`int`]
+                Grid numbers (1-based) to read; default is all
+        :Data members:
+            *q.ext*: ``"lr8"`` | ``"r8"`` | ``"lr4"`` | ...
+                File format
+            *q.Q*: :class:`list` (:class:`numpy.ndarray` | ``None``)
+                List of solution arrays
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Zero-based grid indices
+        if grids is not None:
+            grids = [IG - 1 for IG in grids]
+        # Index file and read grids
+        H, G, B = _cape.ReadP3D(self.fname, "q", None, grids)
+        # Check for binary OVERFLOW file
+        if H["fmt"] == "ascii":
+            raise ValueError(
+                "File '%s' is not a binary OVERFLOW q file" % self.fname)
+        # Format
+        self.ext = H["fmt"]
+        self.endian = "little" if self.ext.startswith("l") else "big"
+        # Number of grids
+        self.mGrid = H["multi"]
+        self.nGrid = len(G)
+        # Dimensions of each grid
+        self.JD = H["dims"][:, 0]
+        self.KD = H["dims"][:, 1]
+        self.LD = H["dims"][:, 2]
+        # Number of states and species
+        self.NQ = H["nq"]
+        self.NQC = H["nqc"]
+        nRGAS = max(2, self.NQC)
+        # Reference quantities of each grid
+        F = H["header"]
+        self._REFMACH = F[:, 0]
+        self._ALPHA   = F[:, 1]
+        self._REY     = F[:, 2]
+        self._TIME    = F[:, 3]
+        self._GAMINF  = F[:, 4]
+        self._BETA    = F[:, 5]
+        self._TINF    = F[:, 6]
+        self._IGAMMA  = np.asarray(F[:, 7], dtype="int")
+        self._HTINF   = F[:, 8]
+        self._HT1     = F[:, 9]
+        self._HT2     = F[:, 10]
+        self._RGAS    = F[:, 11:11+nRGAS]
+        self._FSMACH  = F[:, 11+nRGAS]
+        self._TVREF   = F[:, 12+nRGAS]
+        self._DTVREF  = F[:, 13+nRGAS]
+        # Current values are from the last grid, as in :func:`ReadQHeader`
+        self.REFMACH = self._REFMACH[-1]
+        self.ALPHA   = self._ALPHA[-1]
+        self.REY     = self._REY[-1]
+        self.TIME    = self._TIME[-1]
+        self.GAMINF  = self._GAMINF[-1]
+        self.BETA    = self._BETA[-1]
+        self.TINF    = self._TINF[-1]
+        self.IGAMMA  = self._IGAMMA[-1]
+        self.HTINF   = self._HTINF[-1]
+        self.HT1     = self._HT1[-1]
+        self.HT2     = self._HT2[-1]
+        self.RGAS    = self._RGAS[-1]
+        self.FSMACH  = self._FSMACH[-1]
+        self.TVREF   = self._TVREF[-1]
+        self.DTVREF  = self._DTVREF[-1]
+        # Solution of each grid, ``None`` for grids not read
+        self.Q = G
+
+    # Get solution of one grid
+    def GetQ(self, IG):
+        r"""Get solution array of one grid, reading it if necessary
+
+        :Call:
+            >>> Q = q.GetQ(IG)
+        :Inputs:
+            *q*: :class:`pyOver.plot3d.Q`
+                General OVERFLOW q-file interface
+            *IG*: :class:`int`
+                Grid number (one-based index)
+        :Outputs:
+            *Q*: :class:`numpy.ndarray`\ [:class:`float`]
+                Solution array, shape (*NQ* + *NQC*, *LD*, *KD*, *JD*)
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Read just this grid if necessary
+        if self.Q[IG-1] is None:
+            H, G, B = _cape.ReadP3D(self.fname, "q", self.ext, [IG-1])
+            self.Q[IG-1] = G[IG-1]
+        # Output
+        return self.Q[IG-1]
+
     # Get the number of grids
     def GetNGrid(self):
         """Read the number of grids and determine multiple grid status
@@ -666,7 +797,7 @@ class Q(P3D):
         M_inf = self.FSMACH
         g_inf = self.GAMINF
         # Extract the *q* grid
-        Q = self.Q[IG-1]
+        Q = self.GetQ(IG)
         # Get normalized density and energy
         rhostar = Q[0,J,K,L]
         # Get the velocity components
@@ -730,7 +861,7 @@ class Q(P3D):
         M_inf = self.FSMACH
         g_inf = self.GAMINF
         # Extract the *q* grid
-        Q = self.Q[IG-1]
+        Q = self.GetQ(IG)
         # Get normalized density and energy
         rhostar = Q[0,J,K,L]
         # Get the velocity components
@@ -797,7 +928,7 @@ class Q(P3D):
         g_inf = self.GAMINF
         p_inf = self.PINF
         # Extract the *q* grid
-        Q = self.Q[IG-1]
+        Q = self.GetQ(IG)
         # Get normalized density and energy
         rhostar = Q[0,J,K,L]
         # Get the velocity components
@@ -860,7 +991,7 @@ class Q(P3D):
         g_inf = self.GAMINF
         T_inf = self.TINF
         # Extract the *q* grid
-        Q = self.Q[IG-1]
+        Q = self.GetQ(IG)
         # Get normalized density and energy
         rhostar = Q[0,J,K,L]
         # Number of species
@@ -100,6 +100,7 @@ SETUP_SETTINGS = dict(
             "cape-tri2surf=cape.tricli:main_tri2surf",
             "cape-uh3d2tri=cape.tricli:main_uh3d2tri",
             "cape-writell=cape.writell:main",
+            "cape-bench=cape.extbench:main",
             "pyfun-plt2triq=cape.pyfun.tricli:main_plt2triq",
         ],
     })
@@ -48,6 +48,12 @@ from .splitzones import SplitZones
 # Constants
 INT_TYPES = (int, np.int64, np.int32)
 
+# Suffixes of compressed files (read and written only by compiled code)
+ZIP_EXTS = (".gz", ".zst")
+
+# Binary AFLR3 surface formats, e.g. "Components.lb8.surf"
+SURF_FMTS = ("lb4", "lb8", "b4", "b8", "lr4", "lr8", "r4", "r8")
+
 # Default tolerances for mapping triangulations
 atoldef = options.rc.get("atoldef", 1e-2)
 rtoldef = options.rc.get("rtoldef", 1e-4)
@@ -333,9 +339,13 @@ class TriBase(object):
                 Name of file, use the extension to guess format
         :Versions:
             * 2016-10-21 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; skip ``.gz`` or ``.zst``
         """
         # Split based on '.'
         fext = fname.split('.')
+        # Ignore compression suffix, e.g. "Components.i.triq.zst"
+        if len(fext) > 2 and ("." + fext[-1]) in ZIP_EXTS:
+            fext.pop()
         # Get the extension
         if len(fext) < 2:
             # Odd case, no extension given
@@ -468,11 +478,20 @@ class TriBase(object):
                 Name of triangulation file to read
         :Versions:
             * 2014-06-02 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; read ``.gz`` and ``.zst`` files
         """
         # Get the file type
-        self.GetTriFileType(fname)
-        # Check if ASCII
-        if self.filetype == 'ascii':
+        if fname.endswith(ZIP_EXTS):
+            # Compressed files must be binary (read by C only)
+            self.filetype = 'zip'
+        else:
+            self.GetTriFileType(fname)
+        # Check for compressed or ASCII file
+        if self.filetype == 'zip':
+            # Read and decompress the binary file
+            self.ReadTriBinFast(fname)
+            self.n = n
+        elif self.filetype == 'ascii':
             # Read the ASCII file
             self.ReadASCII(fname, n=n)
         else:
@@ -579,6 +598,79 @@ class TriBase(object):
                 Name of file to write
         :Versions:
             * 2016-08-18 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; try :func:`ReadTriBinFast`
+        """
+        try:
+            # Compiled (C) version
+            self.ReadTriBinFast(fname)
+        except Exception:
+            # Python fall-back function
+            self.ReadTriBinSlow(fname, ni=ni, nf=nf)
+
+    # Read TRI file as a binary file using C
+    def ReadTriBinFast(self, fname, view=False):
+        r"""Use compiled C code to read binary unformatted tri/triq file
+
+        The file is memory-mapped and each record is copied (and
+        byte-swapped if needed) in one pass.  Byte order and precision
+        are detected from the Fortran record markers.
+
+        With *view*, *tri.Tris*, *tri.CompID*, and double-precision
+        *tri.Nodes* and *tri.q* in native byte order are instead views
+        into the mapping.  That saves a copy of a large file, but the
+        file must not be truncated or overwritten in place while they
+        are in use; for example ``tri.Write(fname)`` to the same file
+        would kill the process with ``SIGBUS``.
+
+        :Call:
+            >>> tri.ReadTriBinFast(fname, view=False)
+        :Inputs:
+            *tri*: :class:`cape.trifile.Tri`
+                Triangultion instance to be translated
+            *fname*: {``'Components.i.tri'``} | :class:`str`
+                Name of file to read
+            *view*: ``True`` | {``False``}
+                Use arrays in native byte order without copying them
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; copy unless *view*
+        """
+        # Read all records
+        P, T, C, Q = _cape.ReadTriQ(fname, view)
+        # Save sizes
+        self.nNode = P.shape[0]
+        self.nTri = T.shape[0]
+        # Nodes; single-precision is promoted to double
+        self.Nodes = np.asarray(P, dtype="float")
+        self.Tris = T
+        # Quit if no component IDs
+        if C is None:
+            self.nq = 0
+            return
+        self.CompID = C
+        # Check for states
+        if Q is None:
+            self.nq = 0
+            return
+        # Save states
+        self.nq = Q.shape[1]
+        self.q = np.asarray(Q, dtype="float")
+        # Count (used for averaging triq files)
+        self.n = 1
+
+    # Read TRI file as a binary file using Python
+    def ReadTriBinSlow(self, fname, ni=4, nf=4):
+        r"""Use Python code to read binary unformatted triangulation file
+
+        :Call:
+            >>> tri.ReadTriBinSlow(fname)
+        :Inputs:
+            *tri*: :class:`cape.trifile.Tri`
+                Triangultion instance to be translated
+            *fname*: {``'Components.i.tri'``} | :class:`str`
+                Name of file to read
+        :Versions:
+            * 2016-08-18 ``@ddalle``: v1.0 (:func:`ReadTriBin`)
         """
         # Open the file for binary reading
         fid = open(fname, 'rb')
@@ -1114,6 +1206,8 @@ class TriBase(object):
                 Use double-precision (default is single-precision)
             *sp*: ``True`` | {``False``}
                 Use single-precision (no effect since default is single)
+            *i8*: ``True`` | {``False``}
+                Use 8-byte integers in binary files
         :Examples:
             >>> tri = cape.ReadTri('bJet.i.tri')
             >>> tri.Write('bjet2.tri')
@@ -1122,12 +1216,23 @@ class TriBase(object):
             * 2015-01-03 ``@ddalle``: v1.1; add C capability
             * 2015-02-25 ``@ddalle``: v1.2; add status update
             * 2016-10-02 ``@ddalle``: v1.3; check for binary/ASCII
+            * 2026-10-14 ``@ddalle``: v1.4; add *i8*
+            * 2026-10-14 ``@ddalle``: v1.5; write ``.gz`` and ``.zst``
         """
         # Status update.
         if kw.get('v', False):
             print("    Writing triangulation: '%s'" % fname)
         # Get the extension
         ext = self.GetOutputFileType(**kw)
+        # Compressed files (C only)
+        if fname.endswith(ZIP_EXTS):
+            ni = 8 if kw.get("i8", False) else 4
+            self.WriteTriZip(fname, ext, q=False, ni=ni)
+            return
+        # Check for 8-byte integers (binary only)
+        if kw.get("i8", False) and ext != "ascii":
+            self.WriteTriI8(fname, ext)
+            return
         # Check text vs. binary
         if ext == 'ascii':
             # Try the ASCII writers
@@ -1380,15 +1485,10 @@ class TriBase(object):
                 Name of triangulation file to create
         :Versions:
             * 2015-01-03 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; write directly to *fname*
         """
-        # Write the nodes.
-        _cape.WriteTri(self.Nodes, self.Tris)
-        # Write the component IDs.
-        _cape.WriteCompID(self.CompID)
-        # Check the file name.
-        if fname != "Components.pyCart.tri":
-            # Move the file.
-            os.rename("Components.pyCart.tri", fname)
+        # Write the nodes, tris, and component IDs
+        _cape.WriteTri(self.Nodes, self.Tris, self.CompID, fname)
 
     # Function to write a triangulation to file the old-fashioned way.
     def WriteSlow_ASCII(self, fname='Components.i.tri', nq=None):
@@ -1473,12 +1573,10 @@ class TriBase(object):
                 Name of file to write
         :Versions:
             * 2016-10-10 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; write directly to *fname*
         """
-        #
-        _cape.WriteTri_lb4(self.Nodes, self.Tris, self.CompID)
-        # Check the file name and rename if necessary
-        if fname != "Components.pyCart.tri":
-            os.rename("Components.pyCart.tri", fname)
+        # Write directly to file
+        _cape.WriteTri_lb4(self.Nodes, self.Tris, self.CompID, fname)
 
     # Write TRI file as little-endian single-precision
     def WriteSlow_lb4(self, fname='Components.i.tri'):
@@ -1553,12 +1651,10 @@ class TriBase(object):
                 Name of file to write
         :Versions:
             * 2016-10-10 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; write directly to *fname*
         """
-        #
-        _cape.WriteTri_b4(self.Nodes, self.Tris, self.CompID)
-        # Check the file name and rename if necessary
-        if fname != "Components.pyCart.tri":
-            os.rename("Components.pyCart.tri", fname)
+        # Write directly to file
+        _cape.WriteTri_b4(self.Nodes, self.Tris, self.CompID, fname)
 
     # Write TRI file as big-endian single-precision
     def WriteSlow_b4(self, fname='Components.i.tri'):
@@ -1633,12 +1729,10 @@ class TriBase(object):
                 Name of file to write
         :Versions:
             * 2016-10-10 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; write directly to *fname*
         """
-        #
-        _cape.WriteTri_lb8(self.Nodes, self.Tris, self.CompID)
-        # Check the file name and rename if necessary
-        if fname != "Components.pyCart.tri":
-            os.rename("Components.pyCart.tri", fname)
+        # Write directly to file
+        _cape.WriteTri_lb8(self.Nodes, self.Tris, self.CompID, fname)
 
     # Write TRI file as little-endian double-precision
     def WriteSlow_lb8(self, fname='Components.i.tri'):
@@ -1713,12 +1807,10 @@ class TriBase(object):
                 Name of file to write
         :Versions:
             * 2016-10-10 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; write directly to *fname*
         """
-        #
-        _cape.WriteTri_b8(self.Nodes, self.Tris, self.CompID)
-        # Check the file name and rename if necessary
-        if fname != "Components.pyCart.tri":
-            os.rename("Components.pyCart.tri", fname)
+        # Write directly to file
+        _cape.WriteTri_b8(self.Nodes, self.Tris, self.CompID, fname)
 
     # Write TRI file as big-endian double-precision
     def WriteSlow_b8(self, fname='Components.i.tri'):
@@ -1793,12 +1885,10 @@ class TriBase(object):
                 Name of file to write
         :Versions:
             * 2016-10-10 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; write directly to *fname*
         """
-        #
-        _cape.WriteTri_lr4(self.Nodes, self.Tris, self.CompID)
-        # Check the file name and rename if necessary
-        if fname != "Components.pyCart.tri":
-            os.rename("Components.pyCart.tri", fname)
+        # Write directly to file
+        _cape.WriteTri_lr4(self.Nodes, self.Tris, self.CompID, fname)
 
     # Write TRI file as little-endian single-precision
     def WriteSlow_lr4(self, fname='Components.i.tri'):
@@ -1873,12 +1963,10 @@ class TriBase(object):
                 Name of file to write
         :Versions:
             * 2016-10-10 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; write directly to *fname*
         """
-        #
-        _cape.WriteTri_r4(self.Nodes, self.Tris, self.CompID)
-        # Check the file name and rename if necessary
-        if fname != "Components.pyCart.tri":
-            os.rename("Components.pyCart.tri", fname)
+        # Write directly to file
+        _cape.WriteTri_r4(self.Nodes, self.Tris, self.CompID, fname)
 
     # Write TRI file as big-endian single-precision
     def WriteSlow_r4(self, fname='Components.i.tri'):
@@ -1953,12 +2041,10 @@ class TriBase(object):
                 Name of file to write
         :Versions:
             * 2016-10-10 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; write directly to *fname*
         """
-        #
-        _cape.WriteTri_lr8(self.Nodes, self.Tris, self.CompID)
-        # Check the file name and rename if necessary
-        if fname != "Components.pyCart.tri":
-            os.rename("Components.pyCart.tri", fname)
+        # Write directly to file
+        _cape.WriteTri_lr8(self.Nodes, self.Tris, self.CompID, fname)
 
     # Write TRI file as little-endian double-precision
     def WriteSlow_lr8(self, fname='Components.i.tri'):
@@ -2033,12 +2119,10 @@ class TriBase(object):
                 Name of file to write
         :Versions:
             * 2016-10-10 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; write directly to *fname*
         """
-        #
-        _cape.WriteTri_r8(self.Nodes, self.Tris, self.CompID)
-        # Check the file name and rename if necessary
-        if fname != "Components.pyCart.tri":
-            os.rename("Components.pyCart.tri", fname)
+        # Write directly to file
+        _cape.WriteTri_r8(self.Nodes, self.Tris, self.CompID, fname)
 
     # Write TRI file as big-endian double-precision
     def WriteSlow_r8(self, fname='Components.i.tri'):
@@ -2079,6 +2163,224 @@ class TriBase(object):
         # Close the file
         fid.close()
 
+    # Write TRI file with 8-byte integers
+    def WriteTriI8(self, fname, ext="lb8", q=False):
+        r"""Write a binary tri/triq file with 8-byte integers using C
+
+        The header counts, node indices, and component IDs are all 8-byte
+        integers, which is needed for meshes with more than 2147483647
+        nodes or tris.  Records larger than 2 GiB are split into
+        sub-records the same way as gfortran.
+
+        :Call:
+            >>> tri.WriteTriI8(fname, ext="lb8", q=False)
+        :Inputs:
+            *tri*: :class:`cape.trifile.Tri`
+                Triangulation instance
+            *fname*: :class:`str`
+                Name of file to write
+            *ext*: ``"b4"`` | ``"lb4"`` | ``"b8"`` | {``"lb8"``} | ``"r4"``
+                Binary format; see :func:`GetOutputFileType`
+            *q*: ``True`` | {``False``}
+                Whether to write states (if any) as a ``.triq`` file
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Check for state vars
+        if q and getattr(self, "nq", 0) > 0:
+            Q = self.q
+        else:
+            Q = None
+        # Compiled writer for this format
+        func = getattr(_cape, "WriteTri_%s" % ext)
+        # Write
+        func(self.Nodes, self.Tris, self.CompID, fname, 8, Q)
+
+    # Write compressed TRI file
+    def WriteTriZip(self, fname, ext="ascii", q=False, ni=4):
+        r"""Write a gzip or Zstandard compressed tri/triq file using C
+
+        The format is selected by the extension of *fname*, ``.gz`` or
+        ``.zst``, and the data is compressed as it is written, so no
+        uncompressed copy is ever created.  Compressed files are always
+        binary (the default binary format is used if *ext* is
+        ``"ascii"``) because they can only be read by the compiled
+        readers.
+
+        :Call:
+            >>> tri.WriteTriZip(fname, ext="ascii", q=False, ni=4)
+        :Inputs:
+            *tri*: :class:`cape.trifile.Tri`
+                Triangulation instance
+            *fname*: :class:`str`
+                Name of file to write, ending in ``.gz`` or ``.zst``
+            *ext*: {``"ascii"``} | ``"b4"`` | ``"lb4"`` | ``"lr4"`` | ...
+                Binary format of data; see :func:`GetOutputFileType`
+            *q*: ``True`` | {``False``}
+                Whether to write states (if any) as a ``.triq`` file
+            *ni*: {``4``} | ``8``
+                Bytes per integer in binary files
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Check for state vars
+        if q and getattr(self, "nq", 0) > 0:
+            Q = self.q
+        else:
+            Q = None
+        # Binary only
+        if ext == "ascii":
+            ext = self.GetOutputFileType(bin=True)
+        # Compiled writer for this format
+        func = getattr(_cape, "WriteTri_%s" % ext)
+        func(self.Nodes, self.Tris, self.CompID, fname, ni, Q)
+
+    # Write TRI file as Fortran stream file
+    def WriteTriStream(self, fname, byteorder=None, bytecount=4, intcount=4):
+        r"""Write a triangulation as a Fortran stream file (no records)
+
+        The file contains ``nNode, nTri[, nq]``, nodes, tris, component
+        IDs, and states (if any) with no Fortran record markers, as
+        written by ``access='stream'``.
+
+        :Call:
+            >>> tri.WriteTriStream(fname, byteorder=None, bytecount=4)
+        :Inputs:
+            *tri*: :class:`cape.trifile.Tri`
+                Triangulation instance
+            *fname*: :class:`str`
+                Name of file to write
+            *byteorder*: {``None``} | ``"big"`` | ``"little"``
+                Byte order; default from :func:`cape.capeio.get_env_byte_order`
+            *bytecount*: {``4``} | ``8``
+                Bytes per float
+            *intcount*: {``4``} | ``8``
+                Bytes per integer
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; add *intcount*
+        """
+        # Default byte order
+        if byteorder is None:
+            byteorder = io.get_env_byte_order()
+        try:
+            # Compiled (C) version
+            self.WriteStreamFast(fname, byteorder, bytecount, intcount)
+        except Exception:
+            # Python fall-back function
+            self.WriteStreamSlow(fname, byteorder, bytecount, intcount)
+
+    # Write TRI file as Fortran stream file using C
+    def WriteStreamFast(self, fname, byteorder, bytecount=4, intcount=4):
+        r"""Use compiled C code to write Fortran stream tri file
+
+        :Call:
+            >>> tri.WriteStreamFast(fname, byteorder, bytecount=4)
+        :Inputs:
+            *tri*: :class:`cape.trifile.Tri`
+                Triangulation instance
+            *fname*: :class:`str`
+                Name of file to write
+            *byteorder*: ``"big"`` | ``"little"``
+                Byte order
+            *bytecount*: {``4``} | ``8``
+                Bytes per float
+            *intcount*: {``4``} | ``8``
+                Bytes per integer
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; add *intcount*
+        """
+        # Check for state vars
+        if getattr(self, "nq", 0) > 0:
+            q = self.q
+        else:
+            q = None
+        # Write
+        _cape.WriteTriStream(
+            fname, self.Nodes, self.Tris, self.CompID, q,
+            byteorder, bytecount, intcount)
+
+    # Write TRI file as Fortran stream file using Python
+    def WriteStreamSlow(self, fname, byteorder, bytecount=4, intcount=4):
+        r"""Use Python code to write Fortran stream tri file
+
+        :Call:
+            >>> tri.WriteStreamSlow(fname, byteorder, bytecount=4)
+        :Inputs:
+            *tri*: :class:`cape.trifile.Tri`
+                Triangulation instance
+            *fname*: :class:`str`
+                Name of file to write
+            *byteorder*: ``"big"`` | ``"little"``
+                Byte order
+            *bytecount*: {``4``} | ``8``
+                Bytes per float
+            *intcount*: {``4``} | ``8``
+                Bytes per integer
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; add *intcount*
+        """
+        # Data types
+        bo = ">" if byteorder == "big" else "<"
+        fi = bo + "i%i" % intcount
+        ff = bo + "f%i" % bytecount
+        # Check for state vars
+        qq = getattr(self, "nq", 0) > 0
+        # Open the file
+        with open(fname, 'wb') as fid:
+            # Write the header
+            if qq:
+                hdr = [self.nNode, self.nTri, self.nq]
+            else:
+                hdr = [self.nNode, self.nTri]
+            np.array(hdr, dtype=fi).tofile(fid)
+            # Write the nodes, tris, and compIDs
+            np.asarray(self.Nodes, dtype=ff).tofile(fid)
+            np.asarray(self.Tris, dtype=fi).tofile(fid)
+            if self.CompID is not None:
+                np.asarray(self.CompID, dtype=fi).tofile(fid)
+            # Write states if appropriate
+            if qq:
+                np.asarray(self.q, dtype=ff).tofile(fid)
+
+    # Read Fortran stream TRI file
+    def ReadTriStream(self, fname):
+        r"""Read a Fortran stream (no record marker) tri or triq file
+
+        Byte order and precision are inferred from the header and the
+        size of the file.
+
+        :Call:
+            >>> tri.ReadTriStream(fname)
+        :Inputs:
+            *tri*: :class:`cape.trifile.Tri`
+                Triangulation instance
+            *fname*: :class:`str`
+                Name of file to read
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Read all blocks
+        P, T, C, Q = _cape.ReadTriStream(fname)
+        # Save sizes
+        self.nNode = P.shape[0]
+        self.nTri = T.shape[0]
+        self.nQuad = 0
+        # Nodes; single-precision is promoted to double
+        self.Nodes = np.asarray(P, dtype="float")
+        self.Tris = T
+        self.CompID = C
+        # Check for states
+        if Q is None:
+            self.nq = 0
+        else:
+            self.nq = Q.shape[1]
+            self.q = np.asarray(Q, dtype="float")
+        # Count (used for averaging triq files)
+        self.n = 1
+
    # }
   # >
 
@@ -2100,6 +2402,60 @@ class TriBase(object):
         :Versions:
             * 2014-06-02 ``@ddalle``: v1.0
             * 2014-10-27 ``@ddalle``: v1.1; read comp names
+            * 2026-10-14 ``@ddalle``: v1.2; try :func:`ReadUH3DFast`
+        """
+        try:
+            # Compiled (C) version
+            self.ReadUH3DFast(fname)
+        except Exception:
+            # Python fall-back function
+            self.ReadUH3DSlow(fname)
+
+    # Read from a .uh3d file using C
+    def ReadUH3DFast(self, fname):
+        r"""Use compiled C code to read a UH3D triangulation file
+
+        The node and tri arrays are allocated from the counts on the
+        second line and filled in a single pass.  Node indices and
+        component IDs are :class:`int32`.
+
+        :Call:
+            >>> tri.ReadUH3DFast(fname)
+        :Inputs:
+            *tri*: :class:`cape.trifile.Tri`
+                Triangulation instance
+            *fname*: :class:`str`
+                Name of triangulation file to read
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Read everything, including component names
+        P, T, C, Conf = _cape.ReadUH3D(fname)
+        # Save the statistics.
+        self.nNode = P.shape[0]
+        self.nTri = T.shape[0]
+        self.nQuad = 0
+        # Save
+        self.Nodes = P
+        self.Tris = T
+        self.CompID = C
+        self.Conf = Conf
+
+    # Read from a .uh3d file using Python
+    def ReadUH3DSlow(self, fname):
+        r"""Use Python code to read a UH3D triangulation file
+
+        :Call:
+            >>> tri.ReadUH3DSlow(fname)
+        :Inputs:
+            *tri*: :class:`cape.trifile.Tri`
+                Triangulation instance
+            *fname*: :class:`str`
+                Name of triangulation file to read
+        :Versions:
+            * 2014-06-02 ``@ddalle``: v1.0
+            * 2014-10-27 ``@ddalle``: v1.1; read comp names
+            * 2026-10-14 ``@ddalle``: v1.2; was :func:`ReadUH3D`
         """
         # Open the file
         fid = open(fname, 'r')
@@ -2211,18 +2567,79 @@ class TriBase(object):
             fid.close()
 
     # Read surface file
-    def ReadSurf(self, fname: str):
+    def ReadSurf(self, fname: str, fmt=None):
         r"""Read an AFLR3 surface file
 
         :Call:
-            >>> tri.ReadUH3D(fname)
+            >>> tri.ReadSurf(fname, fmt=None)
         :Inputs:
             *tri*: :class:`cape.trifile.Tri`
                 Triangulation instance
             *fname*: :class:`str`
                 Name of triangulation file to read
+            *fmt*: {``None``} | ``"ascii"`` | ``"lb8"`` | ``"r4"`` | ...
+                File format; detected from file size if ``None``
         :Versions:
             * 2014-06-02 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; try compiled reader first
+        """
+        try:
+            # Compiled version (ASCII or binary)
+            self.ReadSurfFast(fname, fmt)
+        except Exception:
+            # Fall back to ASCII Python version
+            self.ReadSurfSlow(fname)
+
+    # Read AFLR3 surface file with compiled code
+    def ReadSurfFast(self, fname: str, fmt=None):
+        r"""Read an ASCII or binary AFLR3 surface file with compiled code
+
+        :Call:
+            >>> tri.ReadSurfFast(fname, fmt=None)
+        :Inputs:
+            *tri*: :class:`cape.trifile.Tri`
+                Triangulation instance
+            *fname*: :class:`str`
+                Name of triangulation file to read
+            *fmt*: {``None``} | ``"ascii"`` | ``"lb8"`` | ``"r4"`` | ...
+                File format; detected from file size if ``None``
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Read nodes, tris, and quads
+        X, T, Q = _cape.ReadSurf(fname, fmt)
+        # Save counts
+        self.nNode = X.shape[0]
+        self.nTri = T.shape[0]
+        self.nQuad = Q.shape[0]
+        # Nodes and BL parameters (if present)
+        self.Nodes = X[:, :3]
+        if X.shape[1] > 3:
+            self.blds = X[:, 3]
+        if X.shape[1] > 4:
+            self.bldel = X[:, 4]
+        # Tris: nodes, ID, reconnection flag, BC
+        self.Tris = T[:, :3]
+        self.CompID = T[:, 3]
+        self.BCs = T[:, 5]
+        # Quads
+        self.Quads = Q[:, :4]
+        self.CompIDQuad = Q[:, 4]
+        self.BCsQuad = Q[:, 6]
+
+    # Read ASCII AFLR3 surface file
+    def ReadSurfSlow(self, fname: str):
+        r"""Read an ASCII AFLR3 surface file
+
+        :Call:
+            >>> tri.ReadSurfSlow(fname)
+        :Inputs:
+            *tri*: :class:`cape.trifile.Tri`
+                Triangulation instance
+            *fname*: :class:`str`
+                Name of triangulation file to read
+        :Versions:
+            * 2014-06-02 ``@ddalle``: v1.0 (``ReadSurf``)
         """
         # Open the file
         fid = open(fname, 'r')
@@ -2571,17 +2988,30 @@ class TriBase(object):
                 Use double-precision (default is single-precision)
             *sp*: ``True`` | {``False``}
                 Use single-precision (no effect since default is single)
+            *i8*: ``True`` | {``False``}
+                Use 8-byte integers in binary files
         :Examples:
             >>> triq = cape.ReadTriq('bJet.i.triq')
             >>> triq.Write('bjet2.triq', b4=True)
         :Versions:
             * 2015-09-14 ``@ddalle``: v1.0; from :func:`Tri.WriteTri`
+            * 2026-10-14 ``@ddalle``: v1.1; add *i8*
+            * 2026-10-14 ``@ddalle``: v1.2; write ``.gz`` and ``.zst``
         """
         # Status update.
         if kw.get('v', False):
             print("    Writing triangulation: '%s'" % fname)
         # Get the extension
         ext = self.GetOutputFileType(**kw)
+        # Compressed files (C only)
+        if fname.endswith(ZIP_EXTS):
+            ni = 8 if kw.get("i8", False) else 4
+            self.WriteTriZip(fname, ext, q=True, ni=ni)
+            return
+        # Check for 8-byte integers (binary only)
+        if kw.get("i8", False) and ext != "ascii":
+            self.WriteTriI8(fname, ext, q=True)
+            return
         # Check text vs. binary
         if ext == 'ascii':
             # Try the ASCII writers
@@ -2687,13 +3117,40 @@ class TriBase(object):
             >>> triq.Write('bjet2.triq')
         :Versions:
             * 2015-09-14 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; write directly to *fname*
         """
-        # Write the nodes.
-        _cape.WriteTriQ(self.Nodes, self.Tris, self.CompID, self.q)
-        # Check the file name.
-        if fname != "Components.pyCart.tri":
-            # Move the file.
-            os.rename("Components.pyCart.tri", fname)
+        # Write the nodes, tris, component IDs, and states
+        _cape.WriteTriQ(self.Nodes, self.Tris, self.CompID, self.q, fname)
+
+    # Function to start writing a triq file in the background
+    def WriteTriqAsync(self, fname='Components.i.triq'):
+        r"""Start writing a triangulation file with state in the background
+
+        The file is written by a C thread, so Python can continue (e.g.
+        preparing the next case) meanwhile.  Call :func:`_cape.WriteWait`
+        on the handle to wait for the write and check for errors, and do
+        not modify the triangulation until then.
+
+        :Call:
+            >>> h = triq.WriteTriqAsync(fname='Components.i.triq')
+        :Inputs:
+            *triq*: :class:`cape.trifile.Triq`
+                Triangulation instance to be written
+            *fname*: :class:`str`
+                Name of triangulation file to create
+        :Outputs:
+            *h*: :class:`PyCapsule`
+                Handle of the running write
+        :Examples:
+            >>> triq = cape.ReadTriQ('bJet.i.triq')
+            >>> h = triq.WriteTriqAsync('bjet2.triq')
+            >>> _cape.WriteWait(h)
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Start writing nodes, tris, component IDs, and states
+        return _cape.WriteTriQAsync(
+            self.Nodes, self.Tris, self.CompID, self.q, fname)
    # >
 
    # ++++++++++++
@@ -2716,6 +3173,7 @@ class TriBase(object):
             >>> tri.WriteUH3D('bjet2.uh3d')
         :Versions:
             * 2015-04-17 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; try :func:`WriteUH3DFast`
         """
         # Initialize labels
         lbls = {}
@@ -2743,7 +3201,39 @@ class TriBase(object):
         except Exception:
             pass
         # Write the file.
-        self.WriteUH3DSlow(fname, lbls)
+        try:
+            # Fast method using compiled C.
+            self.WriteUH3DFast(fname, lbls)
+        except Exception:
+            # Slow method using Python code.
+            self.WriteUH3DSlow(fname, lbls)
+
+    # Function to write a UH3D file using C
+    def WriteUH3DFast(self, fname='Components.i.uh3d', lbls={}):
+        r"""Use compiled C code to write a triangulation to a UH3D file
+
+        The output is the same as :func:`WriteUH3DSlow`.
+
+        :Call:
+            >>> tri.WriteUH3DFast(fname='Components.i.uh3d', lbls={})
+        :Inputs:
+            *tri*: :class:`cape.trifile.Tri`
+                Triangulation instance to be translated
+            *fname*: :class:`str`
+                Name of triangulation file to create
+            *lbls*: :class:`dict`
+                Optional dict of names for component IDs, e.g.
+                ``{1: "body"}``
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Actual component IDs and index of each tri's ID in that list
+        cID, kID = np.unique(self.CompID, return_inverse=True)
+        # Name that will be written for each component
+        labels = [str(lbls.get(c, str(k+1))) for k, c in enumerate(cID)]
+        # Write (with CompIDs renumbered from 1)
+        _cape.WriteUH3D(
+            self.Nodes, self.Tris, kID.flatten() + 1, labels, fname)
 
     # Function to write a UH3D file the old-fashioned way.
     def WriteUH3DSlow(self, fname='Components.i.uh3d', lbls={}):
@@ -2808,18 +3298,21 @@ class TriBase(object):
    # +++++++++++
    # {
     # Write STL using python language
-    def WriteSTL(self, fname='Components.i.stl', v=False):
+    def WriteSTL(self, fname='Components.i.stl', v=False, binary=False):
         r"""Write a triangulation to an STL file
 
         :Call:
-            >>> tri.WriteSTL(fname='Components.i.tri')
+            >>> tri.WriteSTL(fname='Components.i.tri', binary=False)
         :Inputs:
             *tri*: :class:`cape.trifile.Tri`
                 Triangulation instance to be translated
             *fname*: :class:`str`
                 Name of triangulation file to create
+            *binary*: ``True`` | {``False``}
+                Whether to write binary STL instead of ASCII
         :Versions:
             * 2015-11-22 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; add *binary*
         """
         # Status update.
         if v:
@@ -2827,35 +3320,70 @@ class TriBase(object):
         # Try the fast way.
         try:
             # Fast method using compiled C.
-            self.WriteSTLFast(fname)
+            self.WriteSTLFast(fname, binary=binary)
         except Exception:
             # Slow method using Python code.
-            self.WriteSTLSlow(fname)
+            self.WriteSTLSlow(fname, binary=binary)
+
+    # Write binary STL
+    def WriteSTLBin(self, fname='Components.i.stl', v=False):
+        r"""Write a triangulation to a binary STL file
+
+        :Call:
+            >>> tri.WriteSTLBin(fname='Components.i.stl')
+        :Inputs:
+            *tri*: :class:`cape.trifile.Tri`
+                Triangulation instance to be translated
+            *fname*: :class:`str`
+                Name of triangulation file to create
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        self.WriteSTL(fname, v=v, binary=True)
 
     # Write STL using python language
-    def WriteSTLSlow(self, fname='Components.i.stl'):
+    def WriteSTLSlow(self, fname='Components.i.stl', binary=False):
         r"""Write a triangulation to an STL file
 
         :Call:
-            >>> tri.WriteSTLSlow(fname='Components.i.stl')
+            >>> tri.WriteSTLSlow(fname='Components.i.stl', binary=False)
         :Inputs:
             *tri*: :class:`cape.trifile.Tri`
                 Triangulation instance to be translated
             *fname*: :class:`str`
                 Name of triangulation file to create
+            *binary*: ``True`` | {``False``}
+                Whether to write binary STL instead of ASCII
         :Versions:
             * 2015-11-22 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; fix node indices; *binary*
         """
         # Ensure that normals have been calculated
         self.GetNormals()
+        # Check for binary output
+        if binary:
+            # One 50-byte record per facet
+            dt = np.dtype([
+                ("normal", "<f4", (3,)),
+                ("vertex", "<f4", (3, 3)),
+                ("attr", "<u2")])
+            facets = np.zeros(self.nTri, dtype=dt)
+            facets["normal"] = self.Normals
+            facets["vertex"] = self.Nodes[self.Tris - 1]
+            # Write header, number of facets, and facets
+            with open(fname, 'wb') as f:
+                f.write(b"CAPE binary STL".ljust(80, b"\0"))
+                f.write(np.array(self.nTri, dtype="<u4").tobytes())
+                f.write(facets.tobytes())
+            return
         # Open the file for creation.
         f = open(fname, 'w')
         # Header
         f.write('solid\n')
         # Loop through triangles
         for i in np.arange(self.nTri):
-            # Triangle
-            ti = self.Tris[i]
+            # Triangle (1-based node numbers)
+            ti = self.Tris[i] - 1
             # Normal
             ni = self.Normals[i]
             # Vertices
@@ -2863,12 +3391,12 @@ class TriBase(object):
             x1 = self.Nodes[ti[1]]
             x2 = self.Nodes[ti[2]]
             # Write header and normal vector
-            f.write('   facet normal   %12.5e %12.5e %12.5e\n' % tuple(ni))
+            f.write('   facet normal   %+.8E %+.8E %+.8E\n' % tuple(ni))
             # Write vertices
             f.write('      outer loop\n')
-            f.write('         vertex   %12.5e %12.5e %12.5e\n' % tuple(x0))
-            f.write('         vertex   %12.5e %12.5e %12.5e\n' % tuple(x1))
-            f.write('         vertex   %12.5e %12.5e %12.5e\n' % tuple(x2))
+            f.write('         vertex   %+.8E %+.8E %+.8E\n' % tuple(x0))
+            f.write('         vertex   %+.8E %+.8E %+.8E\n' % tuple(x1))
+            f.write('         vertex   %+.8E %+.8E %+.8E\n' % tuple(x2))
             # Close the loop
             f.write('      endloop\n')
             f.write('   endfacet\n')
@@ -2878,25 +3406,29 @@ class TriBase(object):
         f.close()
 
     # Function to write a triangulation to file as fast as possible.
-    def WriteSTLFast(self, fname='Components.i.stl'):
+    def WriteSTLFast(self, fname='Components.i.stl', binary=False):
         r"""Try using a compiled function to write to file
 
         :Call:
-            >>> tri.WriteFast(fname='Components.i.tri')
+            >>> tri.WriteSTLFast(fname='Components.i.stl', binary=False)
         :Inputs:
             *tri*: :class:`cape.trifile.Tri`
                 Triangulation instance to be translated
             *fname*: :class:`str`
                 Name of triangulation file to create
+            *binary*: ``True`` | {``False``}
+                Whether to write binary STL instead of ASCII
         :Versions:
             * 2016-04-08 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; normals computed in C
         """
-        # Write the nodes.
-        _cape.WriteTriSTL(self.Nodes, self.Tris)
-        # Check the file name.
-        if fname != "Components.pyCart.stl":
-            # Move the file.
-            os.rename("Components.pyCart.stl", fname)
+        # Use normals if already computed; otherwise C computes them
+        N = getattr(self, "Normals", None)
+        # Write the facets.
+        if binary:
+            _cape.WriteTriSTLBin(self.Nodes, self.Tris, N, fname)
+        else:
+            _cape.WriteTriSTL(self.Nodes, self.Tris, N, fname)
    # }
 
    # ++++++++++
@@ -2904,19 +3436,32 @@ class TriBase(object):
    # ++++++++++
    # {
     # Function to write a UH3D file
-    def WriteSurf(self, fname='Components.i.surf'):
+    def WriteSurf(self, fname='Components.i.surf', fmt=None):
         r"""Write a triangulation to a AFLR3 surface file
 
         :Call:
-            >>> tri.WriteSurf(fname='Components.i.surf')
+            >>> tri.WriteSurf(fname='Components.i.surf', fmt=None)
         :Inputs:
             *tri*: :class:`cape.trifile.Tri`
                 Triangulation instance to be translated
             *fname*: :class:`str`
                 Name of triangulation file to create
+            *fmt*: {``None``} | ``"ascii"`` | ``"lb8"`` | ``"r4"`` | ...
+                File format; default from *fname*, e.g.
+                ``Components.lb8.surf``, else ``"ascii"``
         :Versions:
             * 2015-11-19 ``@ddalle``: v1.0
-        """
+            * 2026-10-14 ``@ddalle``: v1.1; add *fmt*
+        """
+        # Get format from file name, e.g. "Components.lb8.surf.gz"
+        if fmt is None:
+            parts = fname.split(".")
+            if len(parts) > 2 and ("." + parts[-1]) in ZIP_EXTS:
+                parts.pop()
+            if len(parts) > 2 and parts[-2] in SURF_FMTS:
+                fmt = parts[-2]
+            else:
+                fmt = "ascii"
         # Status update
         print("    Writing ALFR3 surface: '%s'" % fname)
         # Make sure we have BL parameters
@@ -2933,6 +3478,10 @@ class TriBase(object):
             self.nQuad
         except AttributeError:
             self.nQuad = 0
+        # Binary and compressed files are only written by compiled code
+        if fmt != "ascii" or fname.endswith(ZIP_EXTS):
+            self.WriteSurfFast(fname, fmt)
+            return
         # Write the file.
         try:
             # Try compiled versoin
@@ -2986,28 +3535,28 @@ class TriBase(object):
         fid.close()
 
     # Function to write a triangulation to file as fast as possible.
-    def WriteSurfFast(self, fname='Components.i.surf'):
+    def WriteSurfFast(self, fname='Components.i.surf', fmt="ascii"):
         r"""Try using a compiled function to write to AFLR3 ``surf`` file
 
         :Call:
-            >>> tri.WriteSurfFast(fname='Components.i.surf')
+            >>> tri.WriteSurfFast(fname='Components.i.surf', fmt="ascii")
         :Inputs:
             *tri*: :class:`cape.trifile.Tri`
                 Triangulation instance to be translated
             *fname*: :class:`str`
                 Name of triangulation file to create
+            *fmt*: {``"ascii"``} | ``"lb8"`` | ``"lb4"`` | ``"r8"`` | ...
+                File format
         :Versions:
             * 2015-01-03 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; write directly to *fname*
+            * 2026-10-14 ``@ddalle``: v1.2; add *fmt*
         """
         # Write the nodes.
         _cape.WriteSurf(
             self.Nodes, self.blds,       self.bldel,
             self.Tris,  self.CompID,     self.BCs,
-            self.Quads, self.CompIDQuad, self.BCsQuad)
-        # Check the file name.
-        if fname != "Components.pyCart.surf":
-            # Move the file.
-            os.rename("Components.pyCart.surf", fname)
+            self.Quads, self.CompIDQuad, self.BCsQuad, fname, fmt)
 
    # }
   # >
@@ -3017,7 +3566,7 @@ class TriBase(object):
   # =====================
   # <
     # Add a second triangulation without destroying component numbers.
-    def Add(self, tri):
+    def Add(self, tri, tol=None):
         r"""Add a second triangulation file.
 
         If the new triangulation begins with a component ID less than the
@@ -3027,14 +3576,18 @@ class TriBase(object):
         triangulation, *tri2*, will be changed to 4, 5, and 6.
 
         No checks are performed, and intersections are not analyzed.
+        If *tol* is given, coincident nodes are merged afterward using
+        :func:`WeldNodes`.
 
         :Call:
-            >>> tri.Add(tri2)
+            >>> tri.Add(tri2, tol=None)
         :Inputs:
             *tri*: :class:`cape.trifile.Tri`
                 Triangulation instance to be altered
             *tri2*: :class:`cape.trifile.Tri`
                 Triangulation instance to be added to the first
+            *tol*: {``None``} | :class:`float` >= 0
+                Distance tolerance for merging nodes
         :Effects:
             All nodes and triangles from *tri2* are added to *tri*.  As a
             result, the number of nodes, number of tris, and number of
@@ -3042,6 +3595,7 @@ class TriBase(object):
         :Versions:
             * 2014-06-12 ``@ddalle``: v1.0
             * 2014-10-03 ``@ddalle``: v1.1; detect CompID overlap
+            * 2026-10-14 ``@ddalle``: v1.2; add *tol*
         """
         # Concatenate the node matrix.
         self.Nodes = np.vstack((self.Nodes, tri.Nodes))
@@ -3145,6 +3699,9 @@ class TriBase(object):
         except AttributeError:
             # No *Conf* to merge
             pass
+        # Merge coincident nodes
+        if tol is not None:
+            self.WeldNodes(tol)
 
     # Add a second triangulation without altering component numbers.
     def AddRawCompID(self, tri, warn=False, newnodes=True):
@@ -4391,6 +4948,11 @@ class TriBase(object):
     def RemoveUnusedNodes(self, v=False):
         r"""Remove any nodes that are not used in any triangles
 
+        With the compiled module, *tri.Nodes* and *tri.Tris* are
+        compacted in place (after conversion to contiguous ``f8`` and
+        ``i4`` arrays, if needed), so any other references to those
+        arrays see the overwritten data.
+
         :Call:
             >>> tri.RemoveUnusedNodes(v=False)
         :Inputs:
@@ -4401,7 +4963,21 @@ class TriBase(object):
         :Versions:
             * 2017-02-10 ``@ddalle``: v1.0
             * 2019-06-18 ``@ddalle``: v2.0; NO LOOPS
-        """
+            * 2026-10-14 ``@ddalle``: v2.1; in place using :mod:`_cape`
+        """
+        # Try compiled version
+        if _cape is not None:
+            # Original number of nodes
+            nNode = self.Nodes.shape[0]
+            # Move used nodes forward and renumber tris in place
+            self._RequireCleanArrays()
+            J = _cape.TriRemoveUnusedNodes(self.Nodes, self.Tris)
+            # Status update
+            if v:
+                print("Removing %i unused nodes" % (nNode - J.size))
+            # Downselect nodes
+            self._ApplyNodeMap(J)
+            return
         # Get nodes that are used
         N = np.unique(self.Tris)
         # Output number of nodes
@@ -4430,10 +5006,151 @@ class TriBase(object):
         except AttributeError:
             pass
 
+    # Merge coincident nodes
+    def WeldNodes(self, tol=0.0, v=False):
+        r"""Merge nodes that are within a distance tolerance
+
+        Each node is merged into the first earlier node within *tol* of
+        it that was not itself merged, using a spatial hash on cubes of
+        width *tol*.  Tris are renumbered but not removed.  The
+        compiled version (:func:`_cape.TriWeldNodes`) and the Python
+        fall-back give the same result.
+
+        With the compiled module, *tri.Nodes* and *tri.Tris* are
+        compacted in place (after conversion to contiguous ``f8`` and
+        ``i4`` arrays, if needed), so any other references to those
+        arrays see the overwritten data.
+
+        :Call:
+            >>> tri.WeldNodes(tol=0.0, v=False)
+        :Inputs:
+            *tri*: :class:`cape.trifile.Tri`
+                Triangulation instance
+            *tol*: {``0.0``} | :class:`float` >= 0
+                Distance tolerance; ``0.0`` merges identical nodes
+            *v*: ``True`` | {``False``}
+                Verbosity flag
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; same distance test w/o C
+        """
+        # Original number of nodes
+        nNode = self.Nodes.shape[0]
+        # Try compiled version
+        if _cape is not None:
+            # Merge nodes and renumber tris in place
+            self._RequireCleanArrays()
+            J = _cape.TriWeldNodes(self.Nodes, self.Tris, tol)
+        else:
+            # Cell of each node; far-away nodes share an outer cell
+            X = np.asarray(self.Nodes, dtype="f8")
+            if tol > 0:
+                C = np.floor(X / tol)
+                C[~(np.abs(C) < 1e18)] = 2.0**62
+                C = C.astype("i8").tolist()
+                D = [(a, b, c)
+                     for a in (-1, 0, 1)
+                     for b in (-1, 0, 1)
+                     for c in (-1, 0, 1)]
+            else:
+                C = (X + 0.0).tolist()
+                D = [(0, 0, 0)]
+            tol2 = tol*tol
+            # Kept nodes in each cell, new index of each node
+            cells = {}
+            K = np.zeros(nNode, dtype="int")
+            J = []
+            # Loop through nodes in order
+            P = X.tolist()
+            for i, x in enumerate(P):
+                c = C[i]
+                # Find lowest-indexed kept node within tolerance
+                kbest = -1
+                for d in D:
+                    cell = cells.get((c[0] + d[0], c[1] + d[1], c[2] + d[2]))
+                    for k in (cell or ()):
+                        if kbest >= 0 and k >= kbest:
+                            break
+                        dx = P[k][0] - x[0]
+                        dy = P[k][1] - x[1]
+                        dz = P[k][2] - x[2]
+                        if dx*dx + dy*dy + dz*dz <= tol2:
+                            kbest = k
+                            break
+                # Merge into that node
+                if kbest >= 0:
+                    K[i] = K[kbest]
+                    continue
+                # Keep this node and add it to its cell
+                K[i] = len(J)
+                J.append(i)
+                cells.setdefault(tuple(c), []).append(i)
+            # Renumber tris and move kept nodes forward
+            J = np.array(J, dtype="int")
+            self.Tris = K[self.Tris - 1] + 1
+            self.Nodes = self.Nodes[J]
+        # Status update
+        if v:
+            print("Merging %i duplicate nodes" % (nNode - J.size))
+        # Downselect nodes
+        self._ApplyNodeMap(J)
+
+    # Prepare arrays for in-place compaction
+    def _RequireCleanArrays(self):
+        r"""Convert nodes, tris, and IDs for compiled compaction
+
+        No copies are made if the arrays already have the right types
+        and are writable and contiguous, in which case the compiled
+        functions overwrite the caller's arrays.
+
+        :Call:
+            >>> tri._RequireCleanArrays()
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Requirements for in-place modification
+        req = ["C", "A", "W"]
+        self.Nodes = np.require(self.Nodes, "f8", req)
+        self.Tris = np.require(self.Tris, "i4", req)
+        # Component IDs, if any
+        if getattr(self, "CompID", None) is not None:
+            self.CompID = np.require(self.CompID, "i4", req)
+
+    # Apply results of compaction
+    def _ApplyNodeMap(self, J):
+        r"""Downselect nodes after compaction
+
+        :Call:
+            >>> tri._ApplyNodeMap(J)
+        :Inputs:
+            *J*: :class:`np.ndarray`\ [:class:`int`]
+                Original (0-based) index of each remaining node
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Nodes have been moved to the front; new views of both arrays
+        # so that saved topology and BVH are rebuilt
+        self.nNode = J.size
+        self.Nodes = self.Nodes[:J.size]
+        self.Tris = self.Tris[:self.Tris.shape[0]]
+        # Downselect *q* if available
+        try:
+            self.q = self.q[J, :]
+        except AttributeError:
+            pass
+        # Sorted edge tables are out of date
+        self.__dict__.pop("Edges", None)
+        self.__dict__.pop("EdgeTable", None)
+
     # Eliminate small triangles
     def RemoveSmallTris(self, smalltri=1e-5, v=False, recurse=True):
         r"""Remove any triangles that are below a certain size
 
+        With the compiled module, *tri.Nodes*, *tri.Tris*, and
+        *tri.CompID* are compacted in place (after conversion to
+        contiguous ``f8`` and ``i4`` arrays, if needed), so any other
+        references to those arrays see the overwritten data.
+
         :Call:
           >>> tri.RemoveSmallTris(smalltri=1e-5, v=False, recurse=True)
         :Inputs:
@@ -4447,7 +5164,35 @@ class TriBase(object):
                 Whether or not to remove newly created small tris
         :Versions:
             * 2017-06-19 ``@ddalle``: v1.0
-        """
+            * 2026-10-14 ``@ddalle``: v1.1; clear cached edge tables
+            * 2026-10-14 ``@ddalle``: v1.2; in place using :mod:`_cape`
+        """
+        # Try compiled version
+        if _cape is not None:
+            # Original number of tris
+            nTri = self.Tris.shape[0]
+            # Collapse small tris in place, all passes at once
+            self._RequireCleanArrays()
+            CompID = getattr(self, "CompID", None)
+            n, J = _cape.TriRemoveSmallTris(
+                self.Nodes, self.Tris, CompID, smalltri, 0 if recurse else 1)
+            # Status update
+            if v:
+                print(
+                    "Removing %i triangles (A<=%.2e) in total"
+                    % (nTri - n, smalltri))
+            # Downselect tris
+            self.Tris = self.Tris[:n]
+            self.nTri = n
+            if CompID is not None:
+                self.CompID = self.CompID[:n]
+            # Delete area calculations if any tris were removed
+            if n < nTri:
+                self.__dict__.pop("Areas", None)
+                self.__dict__.pop("Normals", None)
+            # Downselect nodes
+            self._ApplyNodeMap(J)
+            return
         # Calculate areas
         self.GetNormals()
         # Filter areas
@@ -4539,6 +5284,10 @@ class TriBase(object):
         # Delete area calculations, some of which will need updating
         delattr(self, "Areas")
         delattr(self, "Normals")
+        # Sorted edge tables are also out of date; topology from
+        # GetTopology() is rebuilt for the new *Tris* when needed
+        self.__dict__.pop("Edges", None)
+        self.__dict__.pop("EdgeTable", None)
         # Final removal count
         if v:
             print("Removing %i triangles in total" % ndel)
@@ -4572,6 +5321,7 @@ class TriBase(object):
                 Only consider tris in this component(s)
         :Versions:
             * 2017-02-09 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; search all tris at once
         """
         # Check triangulation type
         tt = type(tri).__name__
@@ -4618,43 +5368,31 @@ class TriBase(object):
         comps = np.unique(self.CompID)
         # Mapping *tri.CompID* to *self.CompID*
         compmap = {}
-        # Loop through columns
-        for i, k in enumerate(K):
-            # Get triangle number
-            k = K[i]
-            # Status update if verbose
-            if v and ((i+1) % (1000*v) == 0):
-                sys.stdout.write("  Mapping triangle %i/%i\r" % (i+1, len(K)))
-                sys.stdout.flush()
-            # Perform search
-            T = tri.GetNearestTri(self.Centers[k, :], n=1)
-            # Get components
-            c1 = T.get("c1")
-            # Make sure component scale is present
-            if c1 not in LC:
-                # Get the component scale
-                LC[c1] = tri.GetCompScale(c1)
-                # Check if the component is already used by *tri*
-                if c1 in comps:
-                    # Need to shift the component number
-                    c = c1 + max(comps)
-                else:
-                    # Already have the component
-                    c = c1
-                # Save the component map
-                compmap[c1] = c
-            # Get overall tolerances
-            toli  = tol + ctol*LC[c1]
-            ntoli = ntol + cntol*LC[c1]
-            # Filter results
-            if (T["t1"] > toli) or (T["z1"] > ntoli):
-                continue
-            # Save new component ID
-            self.CompID[k] = compmap[c1]
-        # Clean up prompt
-        if v:
-            sys.stdout.write("%72s\r" % "")
-            sys.stdout.flush()
+        # Search for all candidate tri centers at once
+        T = tri.GetNearestTris(self.Centers[K, :], n=1, v=v)
+        C1 = T["c1"]
+        # Loop through components that were found
+        for c1 in np.unique(C1):
+            # Get the component scale
+            LC[c1] = tri.GetCompScale(c1)
+            # Check if the component is already used by *tri*
+            if c1 in comps:
+                # Need to shift the component number
+                c = c1 + max(comps)
+            else:
+                # Already have the component
+                c = c1
+            # Save the component map
+            compmap[c1] = c
+        # Scale of matching component for each tri
+        LK = np.array([LC[c1] for c1 in C1], dtype="f8")
+        # Get overall tolerances
+        toli = tol + ctol*LK
+        ntoli = ntol + cntol*LK
+        # Filter results
+        I = np.logical_and(T["t1"] <= toli, T["z1"] <= ntoli)
+        # Save new component IDs
+        self.CompID[K[I]] = [compmap[c1] for c1 in C1[I]]
         # Update *self.config* if applicable
         try:
             # Loop through faces in the target map
@@ -5099,6 +5837,49 @@ class TriBase(object):
         self.TriY = self.Nodes[self.Tris-1, 1]
         self.TriZ = self.Nodes[self.Tris-1, 2]
 
+    # Get all per-tri geometry in one pass
+    def GetTriGeom(self):
+        r"""Get centers, normals, areas, and edge lengths of each tri
+
+        This uses :func:`_cape.TriGeom`, which computes all of these
+        quantities in one pass over the tris.  Nothing is done if the
+        compiled module is not available.
+
+        :Call:
+            >>> q = tri.GetTriGeom()
+        :Inputs:
+            *tri*: :class:`cape.trifile.Tri`
+                Triangulation instance
+        :Outputs:
+            *q*: ``True`` | ``False``
+                Whether or not compiled function was used
+        :Attributes:
+            *trifile.Centers*: :class:`np.ndarray`\ [:class:`float`]
+                Center of each triangle
+            *trifile.Normals*: :class:`np.ndarray`\ [:class:`float`]
+                Unit normal of each triangle
+            *trifile.Areas*: :class:`np.ndarray`\ [:class:`float`]
+                Area of each triangle
+            *trifile.AreaVectors*: :class:`np.ndarray`\ [:class:`float`]
+                Area vector of each triangle
+            *trifile.Lengths*: :class:`np.ndarray`\ [:class:`float`]
+                Length of each edge of each triangle
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Check for compiled module and 3D nodes
+        if _cape is None or self.Nodes.shape[1] != 3:
+            return False
+        # Compute everything at once
+        X, N, A, AV, L = _cape.TriGeom(self.Nodes, self.Tris)
+        # Save
+        self.Centers = X
+        self.Normals = N
+        self.Areas = A
+        self.AreaVectors = AV
+        self.Lengths = L
+        return True
+
     # Get centers of nodes
     def GetCenters(self):
         r"""Get the centroids of each triangle
@@ -5113,6 +5894,7 @@ class TriBase(object):
                 Center of each triangle
         :Versions:
             * 2017-02-09 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; use :func:`GetTriGeom`
         """
         # Check for centers
         try:
@@ -5120,6 +5902,9 @@ class TriBase(object):
             return
         except AttributeError:
             pass
+        # Try compiled version
+        if self.GetTriGeom():
+            return
         # Calculate the center of each tri, one coordinate at a time
         x = np.mean(self.Nodes[self.Tris-1, 0], axis=1)
         y = np.mean(self.Nodes[self.Tris-1, 1], axis=1)
@@ -5144,6 +5929,7 @@ class TriBase(object):
         :Versions:
             * 2014-06-12 ``@ddalle``: v1.0
             * 2016-01-23 ``@ddalle``: v1.1; check before calculating
+            * 2026-10-14 ``@ddalle``: v1.2; use :func:`GetTriGeom`
         """
         # Check for normals.
         try:
@@ -5151,6 +5937,9 @@ class TriBase(object):
             return
         except AttributeError:
             pass
+        # Try compiled version
+        if self.GetTriGeom():
+            return
         # Extract the vertices of each trifile.
         x = self.Nodes[self.Tris-1, 0]
         y = self.Nodes[self.Tris-1, 1]
@@ -5189,6 +5978,7 @@ class TriBase(object):
             * 2014-06-12 ``@ddalle``: v1.0
             * 2016-01-23 ``@ddalle``: v1.1; check before calculating
             * 2025-04-03 ``@ddalle``: v1.2; divide cross product by 2
+            * 2026-10-14 ``@ddalle``: v1.3; use :func:`GetTriGeom`
         """
         # Check for normals.
         try:
@@ -5196,6 +5986,9 @@ class TriBase(object):
             return
         except AttributeError:
             pass
+        # Try compiled version
+        if self.GetTriGeom():
+            return
         # Extract the vertices of each trifile.
         x = self.Nodes[self.Tris-1, 0]
         y = self.Nodes[self.Tris-1, 1]
@@ -5281,12 +6074,16 @@ class TriBase(object):
                 Length of edge of each triangle
         :Versions:
             * 2015-02-21 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; use :func:`GetTriGeom`
         """
         try:
             self.Lengths
             return
         except AttributeError:
             pass
+        # Try compiled version
+        if self.GetTriGeom():
+            return
         # Extract the vertices of each trifile.
         x = self.Nodes[self.Tris-1, 0]
         y = self.Nodes[self.Tris-1, 1]
@@ -5301,6 +6098,124 @@ class TriBase(object):
             np.sqrt(np.sum(x12**2, 0)),
             np.sqrt(np.sum(x20**2, 0))))
 
+    # Get bounding volume hierarchy
+    def GetBVH(self):
+        r"""Get tree of bounding boxes for nearest-tri searches
+
+        The tree is built once using :func:`_cape.TriBVH` and saved;
+        it is built again if *tri.Nodes*, *tri.Tris*, or *tri.CompID*
+        has been replaced since then.  The tree keeps its own copy of
+        the component IDs, so *tri.CompID* is also compared to the
+        values it was built with, and the tree is rebuilt after in-place
+        edits such as those of :func:`ApplyConfig`.
+
+        :Call:
+            >>> bvh = tri.GetBVH()
+        :Inputs:
+            *tri*: :class:`cape.trifile.Tri`
+                Triangulation instance
+        :Outputs:
+            *bvh*: ``None`` | :class:`PyCapsule`
+                Tree; ``None`` if compiled module is not available
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Check for compiled module and 3D nodes
+        if _cape is None or self.Nodes.shape[1] != 3:
+            return None
+        # Check for existing tree of same arrays
+        bvh = getattr(self, "_bvh", None)
+        if bvh is not None:
+            # Check if arrays and component IDs are the same as when built
+            if (
+                    bvh[1] is self.Nodes and bvh[2] is self.Tris and
+                    bvh[3] is self.CompID and
+                    np.array_equal(bvh[4], self.CompID)):
+                return bvh[0]
+        # Build tree
+        cap = _cape.TriBVH(self.Nodes, self.Tris, self.CompID)
+        self._bvh = (
+            cap, self.Nodes, self.Tris, self.CompID, np.array(self.CompID))
+        return cap
+
+    # Get nearest tris to many points
+    def GetNearestTris(self, X, n=4, **kw):
+        r"""Get the nearest triangles to each of several points
+
+        The compiled version searches a tree of bounding boxes from
+        :func:`GetBVH` using several threads.  Without it, this calls
+        :func:`GetNearestTri` for each point.
+
+        :Call:
+            >>> T = tri.GetNearestTris(X, n=4, **kw)
+        :Inputs:
+            *tri*: :class:`cape.trifile.Tri`
+                Triangulation instance
+            *X*: :class:`np.ndarray`\ [:class:`float`]
+                Coordinates of test points, shape=(*nPt*, 3)
+            *n*: {``4``} | ``1`` | ``2`` | ``3``
+                Number of *tri* components to search.
+            *v*: ``True`` | {``False``}
+                Verbose flag for fallback version
+        :Outputs:
+            *T*: :class:`dict`\ [:class:`np.ndarray`]
+                Same keys as :func:`GetNearestTri` with one entry per
+                point; *k2* is ``-1`` and *d2* is NaN if no tri outside
+                component *c1* (and similarly for *k3*, *k4*)
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Ensure array of points
+        X = np.asarray(X, dtype="f8").reshape((-1, 3))
+        # Number of points
+        nPt = X.shape[0]
+        # Try compiled version
+        bvh = self.GetBVH() if n <= 4 else None
+        if bvh is not None:
+            # Search all points in one call
+            K, C, D, Z, TT = _cape.TriBVHNearest(bvh, X, n)
+        else:
+            # Initialize outputs
+            K = np.full((nPt, n), -1, dtype="i4")
+            C = np.zeros((nPt, n), dtype="i4")
+            D = np.full((nPt, n), np.nan)
+            Z = np.full((nPt, n), np.nan)
+            TT = np.full((nPt, n), np.nan)
+            # Verbose flag
+            v = kw.get("v", False)
+            # Loop through points
+            for i in range(nPt):
+                # Status update if verbose
+                if v and ((i+1) % (1000*v) == 0):
+                    sys.stdout.write("  Search point %i/%i\r" % (i+1, nPt))
+                    sys.stdout.flush()
+                # Search one point
+                Ti = self.GetNearestTri(X[i], n=n, **kw)
+                # Save results
+                for j in range(n):
+                    sj = str(j + 1)
+                    if "k" + sj not in Ti:
+                        break
+                    K[i, j] = Ti["k" + sj]
+                    C[i, j] = Ti["c" + sj]
+                    D[i, j] = Ti["d" + sj]
+                    Z[i, j] = Ti["z" + sj]
+                    TT[i, j] = Ti["t" + sj]
+            # Clean up prompt
+            if v:
+                sys.stdout.write("%72s\r" % "")
+                sys.stdout.flush()
+        # Output
+        T = {}
+        for j in range(n):
+            sj = str(j + 1)
+            T["k" + sj] = K[:, j]
+            T["c" + sj] = C[:, j]
+            T["d" + sj] = D[:, j]
+            T["z" + sj] = Z[:, j]
+            T["t" + sj] = TT[:, j]
+        return T
+
     def GetNearestTri(self, x, n=4, **kw):
         r"""Get the triangle that is nearest to a point, and the distance
 
@@ -5315,9 +6230,9 @@ class TriBase(object):
                 Number of *tri* components to search. Sub-region
                 accelerated processing will only apply if n=1.
             *ztol*: {_ztol_} | positive :class:`float`
-                Maximum extra projection distance
-            *rztol*: {_antol_} | positive :class:`float`
-                Maximum relative projection distance
+                Maximum extra projection distance; Python version only
+            *rztol*: {_rztol_} | positive :class:`float`
+                Maximum relative projection distance; Python version only
         :Outputs:
             *T*: :class:`dict`
                 Dictionary of match parameters
@@ -5348,7 +6263,23 @@ class TriBase(object):
             * 2017-02-07 ``@ddalle``: v1.1; search for 2nd comp
             * 2017-02-08 ``@ddalle``: v1.2; 3rd and 4th comp
             * 2024-06-08 ``@sfoxman``: accelerate with SplitZones
-        """
+            * 2026-10-14 ``@ddalle``: v1.3; use :func:`GetBVH`
+        """
+        # Try compiled tree search; it measures the true distance to each
+        # tri, so *ztol* and *rztol* (which only limit which tris the
+        # Python version checks) don't apply
+        if n <= 4 and self.GetBVH() is not None:
+            # Search one point
+            TT = self.GetNearestTris(x, n=n)
+            # Convert to scalars, skipping missing components
+            T = {}
+            for j in range(n):
+                sj = str(j + 1)
+                if TT["k" + sj][0] < 0:
+                    break
+                for key in "kcdzt":
+                    T[key + sj] = TT[key + sj][0].item()
+            return T
 
         if n == 1:
             # we can accelerate by pre-calculating sub-regions of triangles
@@ -5547,7 +6478,12 @@ class TriBase(object):
         :Versions:
             * 2016-01-23 ``@ddalle``: v1.0
             * 2025-04-03 ``@ddalle``: v1.1; fix indexing using add.at()
+            * 2026-10-14 ``@ddalle``: v1.2; compiled version
         """
+        # Try compiled version
+        if _cape is not None and self.Nodes.shape[1] == 3:
+            self.NodeNormals = _cape.TriNodeNormals(self.Nodes, self.Tris)
+            return
         # Ensure normals are present
         self.GetAreaVectors()
         # Get non-unit tri normals
@@ -5603,6 +6539,118 @@ class TriBase(object):
    # Edges
    # +++++
    # {
+    # Get edges and adjacency
+    def GetTopology(self):
+        r"""Get unique edges and node, edge, and tri adjacency
+
+        The topology is built once using :func:`_cape.TriTopology` and
+        saved; it is built again if *tri.Tris* has been replaced since
+        then.  Adjacency lists are in compressed sparse row form, so the
+        (0-based) tris using node *i* (1-based) are
+        ``T["n2t"][T["n2t_ptr"][i-1]:T["n2t_ptr"][i]]``.
+
+        :Call:
+            >>> T = tri.GetTopology()
+        :Inputs:
+            *tri*: :class:`cape.trifile.TriBase`
+                Triangulation instance
+        :Outputs:
+            *T*: ``None`` | :class:`dict`\ [:class:`np.ndarray`]
+                Outputs of :func:`_cape.TriTopology`; ``None`` if
+                compiled module is not available
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Check for compiled module
+        if _cape is None:
+            return None
+        # Number of nodes
+        nNode = self.Nodes.shape[0]
+        # Check for existing topology of same tris
+        topo = getattr(self, "_topo", None)
+        if topo is not None:
+            # Check if arrays are the same as when built
+            if topo[1] is self.Tris and topo[2] == nNode:
+                return topo[0]
+        # Build topology
+        T = _cape.TriTopology(self.Tris, nNode)
+        self._topo = (T, self.Tris, nNode)
+        return T
+
+    # Get tris of each unique edge
+    def _GetEdgeTris(self):
+        r"""Get unique edges and the tris using each one
+
+        :Call:
+            >>> E, ptr, K = tri._GetEdgeTris()
+        :Inputs:
+            *tri*: :class:`cape.trifile.TriBase`
+                Triangulation instance
+        :Outputs:
+            *E*: :class:`np.ndarray`\ [:class:`int`]
+                Nodes (0-based, lower first) of each edge, shape=(n, 2)
+            *ptr*: :class:`np.ndarray`\ [:class:`int`]
+                Start of each edge's tris in *K*
+            *K*: :class:`np.ndarray`\ [:class:`int`]
+                Tris (0-based) using each edge
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Try compiled version
+        topo = self.GetTopology()
+        if topo is not None:
+            return topo["edges"], topo["e2t_ptr"], topo["e2t"]
+        # Sides 0->1, 1->2, 2->0 of each tri, lower node first
+        T = self.Tris - 1
+        E = np.sort(np.vstack((T[:, [0, 1]], T[:, [1, 2]], T[:, [2, 0]])))
+        # Unique edges
+        E, J, n = np.unique(
+            E, axis=0, return_inverse=True, return_counts=True)
+        # Tri of each side, grouped by edge
+        K = np.argsort(J.ravel(), kind="stable") % self.nTri
+        ptr = np.hstack(([0], np.cumsum(n)))
+        return E, ptr, K
+
+    # Get open edges
+    def GetOpenEdges(self):
+        r"""Get edges that are used by only one tri
+
+        :Call:
+            >>> E = tri.GetOpenEdges()
+        :Inputs:
+            *tri*: :class:`cape.trifile.TriBase`
+                Triangulation instance
+        :Outputs:
+            *E*: :class:`np.ndarray`\ [:class:`int`]
+                Node indices [1-based] of each open edge, shape=(n, 2)
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Unique edges and their tris
+        E, ptr, K = self._GetEdgeTris()
+        # Edges with one tri
+        return E[np.diff(ptr) == 1] + 1
+
+    # Get non-manifold edges
+    def GetNonManifoldEdges(self):
+        r"""Get edges that are used by more than two tris
+
+        :Call:
+            >>> E = tri.GetNonManifoldEdges()
+        :Inputs:
+            *tri*: :class:`cape.trifile.TriBase`
+                Triangulation instance
+        :Outputs:
+            *E*: :class:`np.ndarray`\ [:class:`int`]
+                Node indices [1-based] of each non-manifold edge
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Unique edges and their tris
+        E, ptr, K = self._GetEdgeTris()
+        # Edges with three or more tris
+        return E[np.diff(ptr) > 2] + 1
+
     # Get edges
     def GetEdges(self):
         r"""Get the list of edges
@@ -5681,6 +6729,35 @@ class TriBase(object):
         # Save sorted edges
         self.EdgeTable = E[I, :]
 
+    # Find nodes connected to a node
+    def GetNodeNeighbors(self, i):
+        r"""Find the end nodes of edges starting at one node
+
+        :Call:
+            >>> I = tri.GetNodeNeighbors(i)
+        :Inputs:
+            *tri*: :class:`cape.trifile.TriBase`
+                Triangulation instance
+            *i*: :class:`int` > 0
+                Node index [1-based]
+        :Outputs:
+            *I*: :class:`np.ndarray`\ [:class:`int`]
+                Sorted end nodes [1-based] of tri sides *i* -> *I[j]*
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Try compiled topology
+        topo = self.GetTopology()
+        if topo is None:
+            # Search sorted edges
+            self.GetEdges()
+            return self.Edges[self.Edges[:, 0] == i, 1]
+        # Tris using node *i*
+        ptr = topo["n2t_ptr"]
+        T = self.Tris[topo["n2t"][ptr[i-1]:ptr[i]]]
+        # Node after *i* in each of those tris
+        return np.sort(np.roll(T, -1, axis=1)[T == i])
+
     # Find neighbor
     def FindTriFromEdge(self, i0, i1):
         r"""Find the triangle index from a specified edge
@@ -5700,7 +6777,21 @@ class TriBase(object):
                 if no match, returns ``0``
         :Versions:
             * 2019-06-20 ``@ddalle``: v1.0
-        """
+            * 2026-10-14 ``@ddalle``: v1.1; use node-to-tri adjacency
+        """
+        # Try compiled topology
+        topo = self.GetTopology()
+        if topo is not None:
+            # Tris using node *i0*
+            ptr = topo["n2t_ptr"]
+            K = topo["n2t"][ptr[i0-1]:ptr[i0]]
+            T = self.Tris[K]
+            # Find the ones with side *i0* -> *i1*
+            K = K[np.any((T == i0) & (np.roll(T, -1, axis=1) == i1), axis=1)]
+            # Check validity
+            if K.size != 1:
+                return 0
+            return K[0] + 1
         # Get edge table
         self.GetEdgeTable()
         # Get handle
@@ -5754,6 +6845,80 @@ class TriBase(object):
    # Components
    # ++++++++++
    # {
+    # Get edges between components
+    def GetCompBoundaryEdges(self, compID=None):
+        r"""Get edges between tris with different component IDs
+
+        :Call:
+            >>> E = tri.GetCompBoundaryEdges(compID=None)
+        :Inputs:
+            *tri*: :class:`cape.trifile.Tri`
+                Triangulation instance
+            *compID*: {``None``} | :class:`int` | :class:`str` | :class:`list`
+                If used, only edges between tris in *compID* and tris
+                outside it (or open edges of *compID*)
+        :Outputs:
+            *E*: :class:`np.ndarray`\ [:class:`int`]
+                Node indices [1-based] of each edge, shape=(n, 2)
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Unique edges and their tris
+        E, ptr, K = self._GetEdgeTris()
+        # Check for trivial triangulation
+        if E.shape[0] == 0:
+            return E + 1
+        # Values to compare for tris of each edge
+        if compID is None:
+            # Component ID
+            C = self.CompID[K]
+        else:
+            # Whether in *compID*
+            C = np.isin(self.CompID[K], self.GetCompID(compID)).astype("i4")
+        # Edges whose tris have more than one value
+        cmin = np.minimum.reduceat(C, ptr[:-1])
+        cmax = np.maximum.reduceat(C, ptr[:-1])
+        # Open edges of *compID* also border the outside
+        if compID is not None:
+            cmin[np.diff(ptr) == 1] = 0
+        return E[cmin != cmax] + 1
+
+    # Get sums for each component in one pass
+    def GetCompGeom(self, compID=None):
+        r"""Get area, area vector, and centroid of each component
+
+        This uses :func:`_cape.TriCompGeom`, which adds each tri to the
+        sums for its component in one pass.  The sums are not saved
+        because *tri.CompID* is often renumbered.
+
+        :Call:
+            >>> G = tri.GetCompGeom(compID=None)
+        :Inputs:
+            *tri*: :class:`cape.trifile.Tri`
+                Triangulation instance
+            *compID*: {``None``} | :class:`int` | :class:`str` | :class:`list`
+                Component(s) to keep; all components if ``None``
+        :Outputs:
+            *G*: ``None`` | :class:`tuple`\ [:class:`np.ndarray`]
+                Areas, area vectors, and centroids of each component
+                with tris; ``None`` if compiled module is not available
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Check for compiled module and 3D nodes
+        if _cape is None or self.Nodes.shape[1] != 3:
+            return None
+        # Compute sums
+        ids, A, AV, X = _cape.TriCompGeom(self.Nodes, self.Tris, self.CompID)
+        # Check for whole triangulation
+        if compID is None:
+            return A, AV, X
+        elif isinstance(compID, str) and (compID == 'entire'):
+            return A, AV, X
+        # Rows of requested component IDs
+        i = np.isin(ids, self.GetCompID(compID))
+        return A[i], AV[i], X[i]
+
     # Get normals and areas
     def GetCompArea(self, compID=None, n=None):
         r"""Get total area of a component
@@ -5776,7 +6941,12 @@ class TriBase(object):
                 Area of the component
         :Versions:
             * 2014-06-13 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; use :func:`GetCompGeom`
         """
+        # Use sums by component if no projection
+        G = None if n is not None else self.GetCompGeom(compID)
+        if G is not None:
+            return np.sum(G[0])
         # Check for areas.
         try:
             self.Areas
@@ -5821,7 +6991,12 @@ class TriBase(object):
                 Area of the component
         :Versions:
             * 2014-06-13 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; use :func:`GetCompGeom`
         """
+        # Use sums by component
+        G = self.GetCompGeom(compID)
+        if G is not None:
+            return np.sum(G[1], axis=0)
         # Check for areas.
         self.GetAreaVectors()
         # Find the indices of tris in the component.
@@ -5886,7 +7061,17 @@ class TriBase(object):
                 Coordinate of the centroid
         :Versions:
             * 2016-03-29 ``@ddalle``: v1.0
-        """
+            * 2026-10-14 ``@ddalle``: v1.1; use :func:`GetCompGeom`
+        """
+        # Use sums by component
+        G = self.GetCompGeom(compID)
+        if G is not None:
+            A, _, X = G
+            # Check for no triangles
+            if A.size == 0:
+                raise ValueError("Found no tris for comp '%s'" % compID)
+            # Area-weighted average of centroids
+            return np.sum(A[:, None]*X, axis=0) / np.sum(A)
         # Check for areas.
         try:
             self.Areas
@@ -6342,13 +7527,14 @@ class TriBase(object):
                 Number of curve segments to discount from next search
         :Versions:
             * 2016-09-29 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; use node-to-tri adjacency
         """
         # Direction tolerance
         atol = np.cos(kw.get('atol', 60.0) * np.pi/180)
         # Distance tolerance
         dtol = kw.get('dtol', 0.05)
         # Get the indices of neighboring nodes (leave zero-based)
-        I = self.Edges[self.Edges[:, 0] == icur, 1]
+        I = self.GetNodeNeighbors(icur)
         # Get coordinates of neighboring nodes
         X = self.Nodes[I-1, :]
         # Current node
@@ -7454,7 +8640,14 @@ class Triq(TriBase):
                 Overall axial force coefficient
         :Versions:
             * 2017-02-15 ``@ddalle``: v1.0
-        """
+            * 2026-10-14 ``@ddalle``: v1.1; use :func:`GetTriForceSums`
+            * 2026-10-14 ``@ddalle``: v1.2; fix *CLN* using *zc*
+        """
+        # Try compiled version unless each tri's forces are needed
+        if not kw.get("save", False):
+            S = self.GetTriForceSums([comp], **kw)
+            if S is not None:
+                return self.GetTriForceCoeffs(S[0], **kw)
        # ------
        # Inputs
        # ------
@@ -7640,19 +8833,19 @@ class Triq(TriBase):
         # Calculate pressure moments
         Mpx = ((yc-yMRP)*Fp[:, 2] - (zc-zMRP)*Fp[:, 1])/bref
         Mpy = ((zc-zMRP)*Fp[:, 0] - (xc-xMRP)*Fp[:, 2])/Lref
-        Mpz = ((zc-xMRP)*Fp[:, 1] - (yc-yMRP)*Fp[:, 0])/bref
+        Mpz = ((xc-xMRP)*Fp[:, 1] - (yc-yMRP)*Fp[:, 0])/bref
         # Calculate vacuum pressure moments
         Mcx = ((yc-yMRP)*Fvac[:, 2] - (zc-zMRP)*Fvac[:, 1])/bref
         Mcy = ((zc-zMRP)*Fvac[:, 0] - (xc-xMRP)*Fvac[:, 2])/Lref
-        Mcz = ((zc-xMRP)*Fvac[:, 1] - (yc-yMRP)*Fvac[:, 0])/bref
+        Mcz = ((xc-xMRP)*Fvac[:, 1] - (yc-yMRP)*Fvac[:, 0])/bref
         # Calculate momentum moments
         Mmx = ((yc-yMRP)*Fm[:, 2] - (zc-zMRP)*Fm[:, 1])/bref
         Mmy = ((zc-zMRP)*Fm[:, 0] - (xc-xMRP)*Fm[:, 2])/Lref
-        Mmz = ((zc-xMRP)*Fm[:, 1] - (yc-yMRP)*Fm[:, 0])/bref
+        Mmz = ((xc-xMRP)*Fm[:, 1] - (yc-yMRP)*Fm[:, 0])/bref
         # Calculate viscous moments
         Mvx = ((yc-yMRP)*Fv[:, 2] - (zc-zMRP)*Fv[:, 1])/bref
         Mvy = ((zc-zMRP)*Fv[:, 0] - (xc-xMRP)*Fv[:, 2])/Lref
-        Mvz = ((zc-xMRP)*Fv[:, 1] - (yc-yMRP)*Fv[:, 0])/bref
+        Mvz = ((xc-xMRP)*Fv[:, 1] - (yc-yMRP)*Fv[:, 0])/bref
         # Assemble
         Mp = stackcol((Mpx, Mpy, Mpz))
         Mvac = stackcol((Mcx, Mcy, Mcz))
@@ -7733,6 +8926,368 @@ class Triq(TriBase):
         C["CLNv"] = np.sum(Mv[:, 2])
         # Output
         return C
+
+    # Integrate forces by component in one pass
+    def GetTriForceSums(self, comps=None, **kw):
+        r"""Add up forces and moments for several components at once
+
+        This uses :func:`_cape.TriqForces`, which integrates the forces
+        on every tri and adds them up by component ID in one threaded
+        pass.  The sums by component ID are saved, so later calls with
+        the same arrays and freestream state only add up rows.
+
+        :Call:
+            >>> S = triq.GetTriForceSums(comps=None, **kw)
+        :Inputs:
+            *triq*: :class:`cape.trifile.Triq`
+                Annotated surface triangulation
+            *comps*: {``None``} | :class:`list`
+                List of components, each as in :func:`GetTriForces`;
+                defaults to ``[None]``
+            *m*, *mach*: {``1.0``} | :class:`float`
+                Freestream Mach number
+            *Re*, *Rey*: {``1.0``} | :class:`float`
+                Reynolds number per grid unit
+            *gam*, *gamma*: {``1.4``} | :class:`float` > 1
+                Freestream ratio of specific heats
+        :Outputs:
+            *S*: ``None`` | :class:`np.ndarray`\\ [:class:`float`]
+                Sums for each component, shape=(len(*comps*), 28), see
+                :func:`_cape.TriqForces`; ``None`` if compiled module
+                is not available
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Check for compiled module and 3D nodes
+        if _cape is None or self.Nodes.shape[1] != 3:
+            return None
+        # Default list of components
+        if comps is None:
+            comps = [None]
+        # Freestream state
+        REY = kw.get("Re", kw.get("Rey", 1.0))
+        mach = kw.get("RefMach", kw.get("mach", kw.get("m", 1.0)))
+        gam = kw.get("gamma", 1.4)
+        SMALLVOL = kw.get("SMALLVOL", 1e-20)
+        state = (float(mach), float(REY), float(gam), float(SMALLVOL))
+        # Check for sums from same arrays and state
+        sums = getattr(self, "_fmsums", None)
+        if not (
+                sums is not None and sums[0] == state and
+                sums[1] is self.Nodes and sums[2] is self.Tris and
+                sums[3] is self.q and sums[4] is self.CompID):
+            # Integrate all tris
+            I, S = _cape.TriqForces(
+                self.Nodes, self.Tris, self.q, self.CompID, *state)
+            # Save
+            sums = (state, self.Nodes, self.Tris, self.q, self.CompID, I, S)
+            self._fmsums = sums
+        # Unpack sums by component ID
+        I, S = sums[5:]
+        # Initialize output
+        SC = np.zeros((len(comps), S.shape[1]))
+        # Loop through components
+        for i, comp in enumerate(comps):
+            # Check for whole triangulation
+            if comp is None:
+                SC[i] = np.sum(S, axis=0)
+            elif isinstance(comp, str) and (comp == 'entire'):
+                SC[i] = np.sum(S, axis=0)
+            else:
+                # Rows of requested component IDs
+                SC[i] = np.sum(S[np.isin(I, self.GetCompID(comp))], axis=0)
+        # Output
+        return SC
+
+    # Convert sums to coefficients
+    def GetTriForceCoeffs(self, s, **kw):
+        r"""Calculate force and moment coefficients from sums
+
+        :Call:
+            >>> C = triq.GetTriForceCoeffs(s, **kw)
+        :Inputs:
+            *triq*: :class:`cape.trifile.Triq`
+                Annotated surface triangulation
+            *s*: :class:`np.ndarray`\\ [:class:`float`]
+                One row of output from :func:`GetTriForceSums`, or
+                several rows, e.g. from :func:`GetLineLoadSums`
+            *R*: {``None``} | :class:`np.ndarray` (3, 3)
+                Rotation applied to forces and moments about MRP
+            *kw*: :class:`dict`
+                Same options as :func:`GetTriForces`
+        :Outputs:
+            *C*: :class:`dict` (:class:`float` | :class:`np.ndarray`)
+                Same coefficients as :func:`GetTriForces`, one for
+                each row of *s*
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+            * 2026-10-14 ``@ddalle``: v1.1; multiple rows; add *R*
+        """
+        # Which things to calculate
+        incm = kw.get("incm", kw.get("momentum", False))
+        gauge = kw.get("gauge", True)
+        # Freestream mach number
+        mach = kw.get("RefMach", kw.get("mach", kw.get("m", 1.0)))
+        # Freestream pressure and gamma
+        gam  = kw.get("gamma", 1.4)
+        pref = kw.get("p", 1.0/gam)
+        # Dynamic pressure
+        qref = 0.5*gam*pref*mach**2
+        # Reference length/area
+        Aref = kw.get("RefArea",   kw.get("Aref", 1.0))
+        Lref = kw.get("RefLength", kw.get("Lref", 1.0))
+        bref = kw.get("RefSpan",   kw.get("bref", Lref))
+        # Moment reference point
+        MRP = kw.get("MRP", np.array([0.0, 0.0, 0.0]))
+        xMRP = kw.get("xMRP", MRP[0])
+        yMRP = kw.get("yMRP", MRP[1])
+        zMRP = kw.get("zMRP", MRP[2])
+        MRP = np.array([xMRP, yMRP, zMRP], dtype="f8")
+        # Moment scales
+        LM = np.array([bref, Lref, bref])
+        # Optional rotation
+        R = kw.get("R")
+        # Forces (normalized) and moments about MRP for each type
+        FM = {}
+        for k, j, f in (
+                ("p", 3, Aref), ("vac", 9, Aref),
+                ("m", 15, qref*Aref), ("v", 21, qref*Aref)):
+            # Normalized force and moment about origin
+            F = s[..., j:j+3] / f
+            M = s[..., j+3:j+6] / f
+            # Transfer moment to MRP
+            M = M - np.cross(MRP, F)
+            # Rotate
+            if R is not None:
+                F = np.dot(F, np.transpose(R))
+                M = np.dot(M, np.transpose(R))
+            FM[k] = (F, M / LM)
+        # Add up forces
+        F = FM["p"][0] + FM["v"][0]
+        M = FM["p"][1] + FM["v"][1]
+        # Include momentum if requested
+        if incm:
+            F = F + FM["m"][0]
+            M = M + FM["m"][1]
+        # Use p=0 as reference pressure if not gauge
+        if not gauge:
+            F = F + FM["vac"][0]
+            M = M + FM["vac"][1]
+        FM[""] = (F, M)
+        # Dictionary of results
+        C = {}
+        # Save areas
+        C["Ax"] = s[..., 0]
+        C["Ay"] = s[..., 1]
+        C["Az"] = s[..., 2]
+        # Total forces, then each contribution
+        for k in ("", "p", "vac", "m", "v"):
+            F, M = FM[k]
+            C["CA" + k] = F[..., 0]
+            C["CY" + k] = F[..., 1]
+            C["CN" + k] = F[..., 2]
+            C["CLL" + k] = M[..., 0]
+            C["CLM" + k] = M[..., 1]
+            C["CLN" + k] = M[..., 2]
+        # Output
+        return C
+
+    # Calculate forces and moments on several components
+    def GetCompTriForces(self, comps, **kw):
+        r"""Calculate forces on several components at once
+
+        :Call:
+            >>> FM = triq.GetCompTriForces(comps, **kw)
+            >>> FM = triq.GetCompTriForces(comps, MRPs=MRPs, **kw)
+        :Inputs:
+            *triq*: :class:`cape.trifile.Triq`
+                Annotated surface triangulation
+            *comps*: :class:`list`
+                List of components, each as *comp* in
+                :func:`GetTriForces`
+            *MRPs*: {``None``} | :class:`list`\\ [:class:`list`]
+                List of moment reference points
+            *kw*: :class:`dict`
+                Other options, same as :func:`GetTriForces`
+        :Outputs:
+            *FM*: :class:`list`\\ [:class:`dict`]
+                Coefficients for each component; if *MRPs* is given,
+                each entry is a list with one :class:`dict` per MRP
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # List of moment reference points
+        MRPs = kw.pop("MRPs", None)
+        # Options for each MRP
+        if MRPs is None:
+            kws = [kw]
+        else:
+            kws = [
+                dict(kw, MRP=mrp, xMRP=mrp[0], yMRP=mrp[1], zMRP=mrp[2])
+                for mrp in MRPs
+            ]
+        # Add up forces by component in one pass
+        S = self.GetTriForceSums(comps, **kw)
+        # Initialize output
+        FM = []
+        # Loop through components
+        for i, comp in enumerate(comps):
+            # Calculate coefficients for each MRP
+            if S is None:
+                FMi = [self.GetTriForces(comp, **kwj) for kwj in kws]
+            else:
+                FMi = [self.GetTriForceCoeffs(S[i], **kwj) for kwj in kws]
+            # Save
+            FM.append(FMi[0] if MRPs is None else FMi)
+        # Output
+        return FM
+
+    # Add up forces and moments in slabs
+    def GetLineLoadSums(self, X, comp=None, **kw):
+        r"""Add up forces and moments in slabs along an axis
+
+        This uses :func:`_cape.TriqLineLoads`, which cuts each tri at
+        the slab boundaries and splits its forces between the pieces by
+        area in one threaded pass.
+
+        :Call:
+            >>> S = triq.GetLineLoadSums(X, comp=None, **kw)
+        :Inputs:
+            *triq*: :class:`cape.trifile.Triq`
+                Annotated surface triangulation
+            *X*: :class:`np.ndarray`\\ [:class:`float`]
+                Increasing coordinates of slab boundaries along *axis*
+            *comp*: {``None``} | :class:`str` | :class:`int`
+                Subset component ID or name or list thereof
+            *axis*: {``"x"``} | ``"y"`` | ``"z"`` | :class:`list`
+                Direction normal to each cut
+            *m*, *mach*: {``1.0``} | :class:`float`
+                Freestream Mach number
+            *Re*, *Rey*: {``1.0``} | :class:`float`
+                Reynolds number per grid unit
+            *gam*, *gamma*: {``1.4``} | :class:`float` > 1
+                Freestream ratio of specific heats
+        :Outputs:
+            *S*: :class:`np.ndarray`\\ [:class:`float`]
+                Sums for each slab, shape=(len(*X*) - 1, 28), with the
+                same columns as :func:`GetTriForceSums`
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Check for compiled module
+        if _cape is None:
+            raise ImportError("Line loads require compiled _cape module")
+        # Direction of cuts
+        a = kw.get("axis", "x")
+        if isinstance(a, str):
+            a = {"x": [1., 0., 0.], "y": [0., 1., 0.], "z": [0., 0., 1.]}[a]
+        # Freestream state
+        REY = kw.get("Re", kw.get("Rey", 1.0))
+        mach = kw.get("RefMach", kw.get("mach", kw.get("m", 1.0)))
+        gam = kw.get("gamma", 1.4)
+        SMALLVOL = kw.get("SMALLVOL", 1e-20)
+        # Tris to include
+        if comp is None or (isinstance(comp, str) and comp == "entire"):
+            T = self.Tris
+            C = self.CompID
+        else:
+            K = self.GetTrisFromCompID(comp)
+            T = self.Tris[K]
+            C = self.CompID[K]
+        # Add up sums for each slab and component ID
+        I, S = _cape.TriqLineLoads(
+            self.Nodes, T, self.q, C,
+            np.asarray(X, dtype="f8"), np.asarray(a, dtype="f8"),
+            float(mach), float(REY), float(gam), float(SMALLVOL))
+        # Combine components
+        return np.sum(S, axis=0)
+
+    # Calculate line loads
+    def GetLineLoads(self, comp=None, **kw):
+        r"""Calculate sectional loads along an axis
+
+        The stations are *nCut* + 1 evenly spaced points spanning
+        *comp* unless given directly.  Each station is the center of a
+        slab that reaches halfway to its neighbors, and the first and
+        last slabs are as wide as their neighbors.
+
+        :Call:
+            >>> LL = triq.GetLineLoads(comp=None, **kw)
+        :Inputs:
+            *triq*: :class:`cape.trifile.Triq`
+                Annotated surface triangulation
+            *comp*: {``None``} | :class:`str` | :class:`int`
+                Subset component ID or name or list thereof
+            *nCut*: {``200``} | :class:`int`
+                Number of intervals between stations
+            *x*: {``None``} | :class:`np.ndarray`\\ [:class:`float`]
+                Increasing stations along *axis*, after rotation *R*
+            *axis*: {``"x"``} | ``"y"`` | ``"z"`` | :class:`list`
+                Direction of line loads, after rotation *R*
+            *R*: {``None``} | :class:`np.ndarray` (3, 3)
+                Rotation from triangulation to line load coordinates
+            *sec*: {``"dlds"``} | ``"slds"`` | ``"clds"``
+                Derivative, sectional, or cumulative loads
+            *kw*: :class:`dict`
+                Other options, same as :func:`GetTriForces`
+        :Outputs:
+            *LL*: :class:`dict`\\ [:class:`np.ndarray`]
+                Stations *x* and coefficients as from
+                :func:`GetTriForces` at each station; derivative
+                loads are per unit *x*/*Lref*
+        :Versions:
+            * 2026-10-14 ``@ddalle``: v1.0
+        """
+        # Options
+        nCut = kw.get("nCut", 200)
+        sec = kw.get("sec", "dlds")
+        R = kw.get("R")
+        Lref = kw.get("RefLength", kw.get("Lref", 1.0))
+        # Direction of line loads
+        a = kw.get("axis", "x")
+        if isinstance(a, str):
+            a = {"x": [1., 0., 0.], "y": [0., 1., 0.], "z": [0., 0., 1.]}[a]
+        a = np.asarray(a, dtype="f8")
+        a = a / np.sqrt(np.sum(a**2))
+        # Same direction before rotation
+        if R is not None:
+            a = np.dot(a, R)
+        # Stations
+        x = kw.get("x")
+        if x is None:
+            # Coordinates of nodes of component
+            K = self.GetTrisFromCompID(comp)
+            s = np.dot(self.Nodes[self.Tris[K] - 1], a)
+            # Check for empty component
+            if s.size == 0:
+                raise ValueError("No tris found for component '%s'" % comp)
+            x = np.linspace(np.min(s), np.max(s), nCut + 1)
+        x = np.asarray(x, dtype="f8")
+        # Check for at least two stations
+        if x.size < 2 or not np.all(np.diff(x) > 0):
+            raise ValueError("Need at least two increasing stations")
+        # Slab boundaries halfway between stations
+        X = np.hstack((
+            1.5*x[0] - 0.5*x[1], 0.5*(x[:-1] + x[1:]), 1.5*x[-1] - 0.5*x[-2]))
+        # Add up forces in each slab
+        S = self.GetLineLoadSums(X, comp, **dict(kw, axis=a))
+        # Convert to coefficients
+        LL = self.GetTriForceCoeffs(S, **kw)
+        # Convert sectional loads
+        for k, v in LL.items():
+            # Only convert coefficients
+            if not k.startswith("C"):
+                continue
+            if sec == "dlds":
+                # Load per unit length
+                LL[k] = v / (np.diff(X) / Lref)
+            elif sec == "clds":
+                # Cumulative loads
+                LL[k] = np.cumsum(v)
+        # Save stations
+        LL["x"] = x
+        # Output
+        return LL
   # >
 
 
@@ -281,6 +281,9 @@ def triqfm(*a, **kw):
         "bref": float(bref),
         "incm": incm
     }
+    # Names and component IDs to process
+    cnames = []
+    compids = []
     # Loop through components
     for comp in comps:
         # Process component
@@ -302,10 +305,14 @@ def triqfm(*a, **kw):
             cname = str(comp)
             # If the component is an integer, make sure we use the map
             comp = compmap.get(comp, comp)
-        # Read the forces and moments right from the TRIQ file
-        FMc = triq.GetTriForces(comp, **kwfm)
         # Save it
-        FM[cname] = FMc
+        cnames.append(cname)
+        compids.append(comp)
+    # Read the forces and moments right from the TRIQ file, in one pass
+    FMc = triq.GetCompTriForces(compids, **kwfm)
+    # Save them
+    for cname, FMi in zip(cnames, FMc):
+        FM[cname] = FMi
    # ------
    # Output
    # ------
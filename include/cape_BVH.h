@@ -0,0 +1,61 @@
+#ifndef _CAPE_BVH_H
+#define _CAPE_BVH_H
+
+PyObject *
+cape_TriBVH(PyObject *self, PyObject *args);
+char doc_TriBVH[] =
+"Build bounding volume hierarchy of triangles for nearest-tri searches\n"
+"\n"
+"The tree keeps its own copy of the vertices of each triangle, so it\n"
+"does not change if *P*, *T*, or *C* are modified afterwards.\n"
+"\n"
+":Call:\n"
+"    >>> bvh = _cape.TriBVH(P, T, C)\n"
+":Inputs:\n"
+"    *P*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, 3)\n"
+"        Matrix of nodal coordinates\n"
+"    *T*: :class:`numpy.ndarray` (:class:`int`) (*nTri*, 3)\n"
+"        Matrix of (1-based) nodal indices for each triangle\n"
+"    *C*: :class:`numpy.ndarray` (:class:`int`) (*nTri*,)\n"
+"        Component ID of each triangle\n"
+":Outputs:\n"
+"    *bvh*: :class:`PyCapsule`\n"
+"        Tree for use with :func:`TriBVHNearest`\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+PyObject *
+cape_TriBVHNearest(PyObject *self, PyObject *args);
+char doc_TriBVHNearest[] =
+"Find nearest triangles to each of several points\n"
+"\n"
+"Column *j* of each output is for the nearest triangle whose component ID\n"
+"is not in columns 0 to *j*-1 of *C* for the same point.  If there is no\n"
+"such triangle, *K* is ``-1``, *C* is ``0``, and the distances are NaN.\n"
+"\n"
+":Call:\n"
+"    >>> K, C, D, Z, T = _cape.TriBVHNearest(bvh, X, n=1, nthread=0)\n"
+":Inputs:\n"
+"    *bvh*: :class:`PyCapsule`\n"
+"        Tree from :func:`TriBVH`\n"
+"    *X*: :class:`numpy.ndarray` (:class:`float`) (*nPt*, 3)\n"
+"        Coordinates of test points\n"
+"    *n*: {``1``} | ``2`` | ``3`` | ``4``\n"
+"        Number of components to find for each point\n"
+"    *nthread*: {``0``} | :class:`int`\n"
+"        Maximum number of threads; ``0`` to use all CPUs\n"
+":Outputs:\n"
+"    *K*: :class:`numpy.ndarray` (:class:`int`) (*nPt*, *n*)\n"
+"        0-based index of nearest triangles\n"
+"    *C*: :class:`numpy.ndarray` (:class:`int`) (*nPt*, *n*)\n"
+"        Component ID of nearest triangles\n"
+"    *D*: :class:`numpy.ndarray` (:class:`float`) (*nPt*, *n*)\n"
+"        Distance from each point to nearest triangles\n"
+"    *Z*: :class:`numpy.ndarray` (:class:`float`) (*nPt*, *n*)\n"
+"        Projection distance from each point to plane of triangles\n"
+"    *T*: :class:`numpy.ndarray` (:class:`float`) (*nPt*, *n*)\n"
+"        Tangential distance within plane of triangles\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+#endif  // _CAPE_BVH_H
@@ -28,14 +28,68 @@ char doc_CSVFileReadData[] =
 "Read data from CSV file\n"
 "\n"
 ":Call:\n"
-"    >>> CSVFileReadData(db, f)\n"
+"    >>> CSVFileReadData(db, f, nthread=0)\n"
 ":Inputs:\n"
 "    *db*: :class:`cape.attdb.ftypes.csv.CSVFile`\n"
 "        CSV data file interface\n"
 "    *f*: :class:`file`\n"
 "        Open file interface\n"
+"    *nthread*: {``0``} | :class:`int`\n"
+"        Number of threads; ``0`` for one per processor (files smaller\n"
+"        than about 2 MiB are always read with one thread)\n"
 ":Versions:\n"
 "    * 2019-11-29 ``@ddalle``: First version\n"
+"    * 2026-10-14 ``@ddalle``: v1.1; add *nthread*\n"
+"\n";
+
+//! \brief Create state for incremental reads of CSV file
+PyObject *
+cape_CSVFileTailState(PyObject *self, PyObject *args);
+char doc_CSVFileTailState[] = 
+"Create state for incremental reads of a CSV file that was just read\n"
+"\n"
+":Call:\n"
+"    >>> state = CSVFileTailState(fname, offset, nrow)\n"
+":Inputs:\n"
+"    *fname*: :class:`str`\n"
+"        Name of CSV file\n"
+"    *offset*: :class:`int`\n"
+"        Number of bytes read, i.e. ``f.tell()`` after reading\n"
+"    *nrow*: :class:`int`\n"
+"        Number of data rows read\n"
+":Outputs:\n"
+"    *state*: ``None`` | :class:`tuple`\\[:class:`int`]\n"
+"        Byte offset, row count, and hash of text before *offset*;\n"
+"        ``None`` if *offset* is not just after a newline\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n"
+"\n";
+
+//! \brief Read rows appended to CSV file since previous read
+PyObject *
+cape_CSVFileReadTail(PyObject *self, PyObject *args);
+char doc_CSVFileReadTail[] = 
+"Read rows appended to CSV file since previous read\n"
+"\n"
+"Only complete lines after the saved offset are parsed; they are added\n"
+"to the existing columns of *db*, which grow with spare capacity so that\n"
+"repeated calls don't copy the whole column each time.\n"
+"\n"
+":Call:\n"
+"    >>> state = CSVFileReadTail(db, fname, state)\n"
+":Inputs:\n"
+"    *db*: :class:`cape.attdb.ftypes.csv.CSVFile`\n"
+"        CSV data file interface with *db._c_dtypes* set\n"
+"    *fname*: :class:`str`\n"
+"        Name of CSV file\n"
+"    *state*: :class:`tuple`\\[:class:`int`]\n"
+"        State from previous read, see :func:`CSVFileTailState`\n"
+":Outputs:\n"
+"    *state*: ``None`` | :class:`tuple`\\[:class:`int`]\n"
+"        Updated state; ``None`` (and *db* unchanged) if the file was\n"
+"        truncated or rewritten or the columns of *db* don't match\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n"
 "\n";
 
 #endif  // _CAPE_CSVFILE_H
\ No newline at end of file
@@ -0,0 +1,52 @@
+#ifndef _CAPE_COLCACHE_H
+#define _CAPE_COLCACHE_H
+
+PyObject *
+cape_ColCacheWrite(PyObject *self, PyObject *args);
+char doc_ColCacheWrite[] =
+"Write binary columnar cache of a data file's columns\n"
+"\n"
+"The cache records the size, modification time, and a hash of the first\n"
+"and last 64 KiB of the source file.  Each numeric column is written as a\n"
+"raw block aligned to 64 bytes, and each string column as offsets into a\n"
+"block of UTF-8 text.  The file is written to a temporary name and then\n"
+"renamed into place.\n"
+"\n"
+":Call:\n"
+"    >>> ColCacheWrite(db, fname, fsrc)\n"
+":Inputs:\n"
+"    *db*: :class:`cape.dkit.basefile.BaseFile`\n"
+"        Data file interface with *db.cols* and *db._c_dtypes*\n"
+"    *fname*: :class:`str`\n"
+"        Name of cache file to write\n"
+"    *fsrc*: :class:`str`\n"
+"        Name of source file that *db* was read from\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+PyObject *
+cape_ColCacheRead(PyObject *self, PyObject *args);
+char doc_ColCacheRead[] =
+"Read columns from binary columnar cache of a data file\n"
+"\n"
+"The cache is used only if it matches the current size, modification\n"
+"time, and hash of *fsrc* and has the same columns and data types as\n"
+"*db.cols* and *db._c_dtypes*.  Numeric columns are views into a memory\n"
+"mapping of the cache, so processes reading the same cache share pages.\n"
+"\n"
+":Call:\n"
+"    >>> q = ColCacheRead(db, fname, fsrc)\n"
+":Inputs:\n"
+"    *db*: :class:`cape.dkit.basefile.BaseFile`\n"
+"        Data file interface with *db.cols* and *db._c_dtypes*\n"
+"    *fname*: :class:`str`\n"
+"        Name of cache file\n"
+"    *fsrc*: :class:`str`\n"
+"        Name of source file\n"
+":Outputs:\n"
+"    *q*: ``True`` | ``False``\n"
+"        Whether columns of *db* were read from valid cache\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+#endif  // _CAPE_COLCACHE_H
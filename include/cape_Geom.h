@@ -0,0 +1,87 @@
+#ifndef _CAPE_GEOM_H
+#define _CAPE_GEOM_H
+
+PyObject *
+cape_TriGeom(PyObject *self, PyObject *args);
+char doc_TriGeom[] =
+"Compute centers, normals, areas, and edge lengths of each triangle\n"
+"\n"
+"All outputs are computed in one pass over *T* without any intermediate\n"
+"arrays, using several threads for large triangulations.  Results match\n"
+"the NumPy calculations in :class:`cape.trifile.Tri`.\n"
+"\n"
+":Call:\n"
+"    >>> X, N, A, AV, L = _cape.TriGeom(P, T, nthread=0)\n"
+":Inputs:\n"
+"    *P*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, 3)\n"
+"        Matrix of nodal coordinates\n"
+"    *T*: :class:`numpy.ndarray` (:class:`int`) (*nTri*, 3)\n"
+"        Matrix of (1-based) nodal indices for each triangle\n"
+"    *nthread*: {``0``} | :class:`int`\n"
+"        Maximum number of threads; ``0`` to use all CPUs\n"
+":Outputs:\n"
+"    *X*: :class:`numpy.ndarray` (:class:`float`) (*nTri*, 3)\n"
+"        Center of each triangle\n"
+"    *N*: :class:`numpy.ndarray` (:class:`float`) (*nTri*, 3)\n"
+"        Unit normal of each triangle\n"
+"    *A*: :class:`numpy.ndarray` (:class:`float`) (*nTri*,)\n"
+"        Area of each triangle\n"
+"    *AV*: :class:`numpy.ndarray` (:class:`float`) (*nTri*, 3)\n"
+"        Area vector (area times unit normal) of each triangle\n"
+"    *L*: :class:`numpy.ndarray` (:class:`float`) (*nTri*, 3)\n"
+"        Lengths of edges 0-1, 1-2, and 2-0 of each triangle\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+PyObject *
+cape_TriNodeNormals(PyObject *self, PyObject *args);
+char doc_TriNodeNormals[] =
+"Compute area-weighted unit normal at each node\n"
+"\n"
+":Call:\n"
+"    >>> N = _cape.TriNodeNormals(P, T, nthread=0)\n"
+":Inputs:\n"
+"    *P*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, 3)\n"
+"        Matrix of nodal coordinates\n"
+"    *T*: :class:`numpy.ndarray` (:class:`int`) (*nTri*, 3)\n"
+"        Matrix of (1-based) nodal indices for each triangle\n"
+"    *nthread*: {``0``} | :class:`int`\n"
+"        Maximum number of threads; ``0`` to use all CPUs\n"
+":Outputs:\n"
+"    *N*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, 3)\n"
+"        Unit normal at each node\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+PyObject *
+cape_TriCompGeom(PyObject *self, PyObject *args);
+char doc_TriCompGeom[] =
+"Compute area, area vector, and centroid of each component\n"
+"\n"
+"Each triangle is added to the sums for its component ID in one pass;\n"
+"only component IDs that appear in *C* are included in the outputs.\n"
+"\n"
+":Call:\n"
+"    >>> I, A, AV, X = _cape.TriCompGeom(P, T, C, nthread=0)\n"
+":Inputs:\n"
+"    *P*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, 3)\n"
+"        Matrix of nodal coordinates\n"
+"    *T*: :class:`numpy.ndarray` (:class:`int`) (*nTri*, 3)\n"
+"        Matrix of (1-based) nodal indices for each triangle\n"
+"    *C*: :class:`numpy.ndarray` (:class:`int`) (*nTri*,)\n"
+"        Component ID of each triangle\n"
+"    *nthread*: {``0``} | :class:`int`\n"
+"        Maximum number of threads; ``0`` to use all CPUs\n"
+":Outputs:\n"
+"    *I*: :class:`numpy.ndarray` (:class:`int`) (*nComp*,)\n"
+"        Sorted list of component IDs\n"
+"    *A*: :class:`numpy.ndarray` (:class:`float`) (*nComp*,)\n"
+"        Total area of each component\n"
+"    *AV*: :class:`numpy.ndarray` (:class:`float`) (*nComp*, 3)\n"
+"        Total area vector of each component\n"
+"    *X*: :class:`numpy.ndarray` (:class:`float`) (*nComp*, 3)\n"
+"        Area-weighted centroid of each component\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+#endif  // _CAPE_GEOM_H
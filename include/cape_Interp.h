@@ -0,0 +1,95 @@
+#ifndef _CAPE_INTERP_H
+#define _CAPE_INTERP_H
+
+PyObject *
+cape_BkptIndex(PyObject *self, PyObject *args);
+char doc_BkptIndex[] =
+"Find break point interval and progress fraction of each value\n"
+"\n"
+"This is a batch version of :func:`cape.dkit.rdb.DataKit._bkpt_index`.\n"
+"The search for each value starts from the interval of the previous one,\n"
+"so sorted or clustered values need very few comparisons.\n"
+"\n"
+":Call:\n"
+"    >>> I, F = _cape.BkptIndex(V, x, tol=1e-5)\n"
+":Inputs:\n"
+"    *V*: :class:`numpy.ndarray` (:class:`float`) (*n*,)\n"
+"        Ascending break points; *n* must be at least 2\n"
+"    *x*: :class:`numpy.ndarray` (:class:`float`) (*nx*,)\n"
+"        Values to look up\n"
+"    *tol*: {``1e-5``} | :class:`float` >= 0\n"
+"        Tolerance for left and right bounds, relative to range of *V*\n"
+":Outputs:\n"
+"    *I*: :class:`numpy.ndarray` (:class:`int`) (*nx*,)\n"
+"        Start of interval of each value; ``-1`` if below *V* and ``n-1``\n"
+"        if above it\n"
+"    *F*: :class:`numpy.ndarray` (:class:`float`) (*nx*,)\n"
+"        Progress fraction in interval (first or last one if outside)\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+PyObject *
+cape_MultilinearEval(PyObject *self, PyObject *args);
+char doc_MultilinearEval[] =
+"Evaluate multilinear interpolation of a regular table at many points\n"
+"\n"
+"Results match :func:`cape.dkit.rdb.DataKit._rcall_multilinear` for a\n"
+"1D column.  Points are processed in blocks and split among threads for\n"
+"large inputs, and the GIL is released during the calculation.\n"
+"\n"
+":Call:\n"
+"    >>> y = _cape.MultilinearEval(bkpts, V, X, extrap=1, tol=1e-5, "
+"nthread=0)\n"
+":Inputs:\n"
+"    *bkpts*: :class:`list`\\ [:class:`numpy.ndarray`]\n"
+"        Ascending break points of each arg (at least 2 each)\n"
+"    *V*: :class:`numpy.ndarray` (:class:`float`)\n"
+"        Values at each combination of break points, with the first arg\n"
+"        varying the most slowly\n"
+"    *X*: :class:`list`\\ [:class:`numpy.ndarray`]\n"
+"        Values of each arg at each of *nx* points\n"
+"    *extrap*: ``0`` | {``1``} | ``2``\n"
+"        Extrapolation: error, hold first/last value, or linear\n"
+"    *tol*: {``1e-5``} | :class:`float` >= 0\n"
+"        Tolerance for left and right bounds, relative to range\n"
+"    *nthread*: {``0``} | :class:`int`\n"
+"        Maximum number of threads; ``0`` to use all CPUs\n"
+":Outputs:\n"
+"    *y*: :class:`numpy.ndarray` (:class:`float`) (*nx*,)\n"
+"        Interpolated value at each point\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+PyObject *
+cape_RBFEval(PyObject *self, PyObject *args);
+char doc_RBFEval[] =
+"Evaluate a radial basis function at many points\n"
+"\n"
+"The inputs are the stored coefficients of a\n"
+":class:`scipy.interpolate.Rbf` (as written by\n"
+":func:`cape.dkit.rdb.DataKit.write_rbf_csv`).  Distances to blocks of\n"
+"centers use SIMD when available, points are split among threads, and the\n"
+"GIL is released during the calculation.\n"
+"\n"
+":Call:\n"
+"    >>> y = _cape.RBFEval(xi, nodes, func, eps, X, nthread=0)\n"
+":Inputs:\n"
+"    *xi*: :class:`numpy.ndarray` (:class:`float`) (*nd*, *n*)\n"
+"        Coordinates of RBF centers\n"
+"    *nodes*: :class:`numpy.ndarray` (:class:`float`) (*n*,)\n"
+"        Weight of each center\n"
+"    *func*: :class:`str`\n"
+"        Name of basis function, for example ``\"cubic\"``\n"
+"    *eps*: :class:`float`\n"
+"        Scale factor of basis function\n"
+"    *X*: :class:`list`\\ [:class:`numpy.ndarray`]\n"
+"        Values of each of *nd* args at each of *nx* points\n"
+"    *nthread*: {``0``} | :class:`int`\n"
+"        Maximum number of threads; ``0`` to use all CPUs\n"
+":Outputs:\n"
+"    *y*: :class:`numpy.ndarray` (:class:`float`) (*nx*,)\n"
+"        Value of RBF at each point\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+#endif  // _CAPE_INTERP_H
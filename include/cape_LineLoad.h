@@ -0,0 +1,50 @@
+#ifndef _CAPE_LINELOAD_H
+#define _CAPE_LINELOAD_H
+
+PyObject *
+cape_TriqLineLoads(PyObject *self, PyObject *args);
+char doc_TriqLineLoads[] =
+"Add up sectional forces and moments in slabs along an axis\n"
+"\n"
+"Each tri is cut by the planes normal to *a* at each slab boundary, and\n"
+"the forces from :func:`TriqForces` are split between the pieces in\n"
+"proportion to their areas.  Each piece acts at its own centroid, so\n"
+"the sums for each slab are exact for forces that are constant on each\n"
+"tri.  Parts of tris outside of all slabs are skipped.\n"
+"\n"
+":Call:\n"
+"    >>> I, S = _cape.TriqLineLoads(P, T, Q, C, X, a, mach, Rey, gam)\n"
+"    >>> I, S = _cape.TriqLineLoads(P, T, Q, C, X, a, mach, Rey, gam, v, n)\n"
+":Inputs:\n"
+"    *P*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, 3)\n"
+"        Matrix of nodal coordinates\n"
+"    *T*: :class:`numpy.ndarray` (:class:`int`) (*nTri*, 3)\n"
+"        Matrix of (1-based) nodal indices for each triangle\n"
+"    *Q*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, *nq*)\n"
+"        States at each node\n"
+"    *C*: :class:`numpy.ndarray` (:class:`int`) (*nTri*,)\n"
+"        Component ID of each triangle\n"
+"    *X*: :class:`numpy.ndarray` (:class:`float`) (*nSlab* + 1,)\n"
+"        Increasing coordinates of slab boundaries along *a*\n"
+"    *a*: :class:`numpy.ndarray` (:class:`float`) (3,)\n"
+"        Direction normal to each cut\n"
+"    *mach*: :class:`float`\n"
+"        Freestream Mach number\n"
+"    *Rey*: :class:`float`\n"
+"        Reynolds number per grid unit\n"
+"    *gam*: :class:`float`\n"
+"        Freestream ratio of specific heats\n"
+"    *v*: {``1e-20``} | :class:`float`\n"
+"        Smallest prism volume used for viscous forces\n"
+"    *n*: {``0``} | :class:`int`\n"
+"        Maximum number of threads; ``0`` to use all CPUs\n"
+":Outputs:\n"
+"    *I*: :class:`numpy.ndarray` (:class:`int`) (*nComp*,)\n"
+"        Sorted list of component IDs with tris in any slab\n"
+"    *S*: :class:`numpy.ndarray` (:class:`float`) (*nComp*, *nSlab*, 28)\n"
+"        Sums for each component and slab with the same columns as\n"
+"        :func:`TriqForces`\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+#endif  // _CAPE_LINELOAD_H
@@ -0,0 +1,66 @@
+#ifndef _CAPE_P3D_H
+#define _CAPE_P3D_H
+
+PyObject *
+cape_ReadP3D(PyObject *self, PyObject *args);
+char doc_ReadP3D[] =
+"Read selected grids of a binary PLOT3D grid, function, or OVERFLOW file\n"
+"\n"
+"The file is mapped into memory and the offset of each grid is computed\n"
+"from the header, so only the requested grids are read from disk.\n"
+"Arrays are copied from the mapping unless *view* is set.  Files that\n"
+"don't match any binary layout are reported with *fmt* of ``\"ascii\"``\n"
+"and no grids.\n"
+"\n"
+":Call:\n"
+"    >>> H, G, B = _cape.ReadP3D(fname, kind=\"x\", fmt=None, grids=None,\n"
+"            view=False)\n"
+":Inputs:\n"
+"    *fname*: :class:`str`\n"
+"        Name of file to read\n"
+"    *kind*: {``\"x\"``} | ``\"f\"`` | ``\"q\"``\n"
+"        Grid file, function file, or OVERFLOW ``q`` file\n"
+"    *fmt*: {``None``} | ``\"lr8\"`` | ``\"b4\"`` | ...\n"
+"        File format; detected from file size if ``None``\n"
+"    *grids*: {``None``} | :class:`list`\\ [:class:`int`]\n"
+"        Indices (0-based) of grids to read; default is all\n"
+"    *view*: ``True`` | {``False``}\n"
+"        Return arrays in native byte order as views into the mapping\n"
+"        (see :func:`ReadTri`)\n"
+":Outputs:\n"
+"    *H*: :class:`dict`\n"
+"        Header with *kind*, *fmt*, *multi*, *iblank*, and *dims*; for\n"
+"        ``q`` files also *nq*, *nqc*, and *header*, which has the\n"
+"        reference values of each grid (*IGAMMA* as a float)\n"
+"    *G*: :class:`list`\\ [:class:`numpy.ndarray` | ``None``]\n"
+"        Values of each grid read, with shape (*nvar*, *L*, *K*, *J*)\n"
+"    *B*: :class:`list`\\ [:class:`numpy.ndarray` | ``None``]\n"
+"        IBLANK (:class:`int32`, shape (*L*, *K*, *J*)) of each grid read\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+PyObject *
+cape_WriteP3D(PyObject *self, PyObject *args);
+char doc_WriteP3D[] =
+"Write a binary PLOT3D grid, function, or OVERFLOW file\n"
+"\n"
+"Dimensions come from the shape of each grid.  IBLANK is written (in the\n"
+"same record as the coordinates) for grid files if *B* is given.\n"
+"\n"
+":Call:\n"
+"    >>> _cape.WriteP3D(target, H, G, B=None)\n"
+":Inputs:\n"
+"    *target*: ``None`` | :class:`str` | :class:`file` | :class:`int`\n"
+"        Output file name, open file, or descriptor\n"
+"    *H*: :class:`dict`\n"
+"        Header with *kind* (``\"x\"``), *fmt* (``\"lr8\"``), *multi*\n"
+"        (``True``), and, for ``q`` files, *nqc* and *header* as from\n"
+"        :func:`ReadP3D`\n"
+"    *G*: :class:`list`\\ [:class:`numpy.ndarray`]\n"
+"        Values of each grid, with shape (*nvar*, *L*, *K*, *J*)\n"
+"    *B*: {``None``} | :class:`list`\\ [:class:`numpy.ndarray`]\n"
+"        IBLANK of each grid\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+#endif  // _CAPE_P3D_H
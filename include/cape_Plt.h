@@ -0,0 +1,55 @@
+#ifndef _CAPE_PLT_H
+#define _CAPE_PLT_H
+
+PyObject *
+cape_ReadPlt(PyObject *self, PyObject *args);
+char doc_ReadPlt[] =
+"Read a Tecplot binary (``#!TDV112``) file with finite-element zones\n"
+"\n"
+"The file is mapped into memory and the header and the blocks of each\n"
+"zone are found in one scan.  Each zone's variable blocks are converted\n"
+"to a (*npt*, *nvar*) array in one pass without the GIL; the array is\n"
+":class:`float32` unless some variable is stored as a double or 4-byte\n"
+"int.  Passive variables are zero, and shared variables and connectivity\n"
+"are copied from the zone they are shared with.  Connectivity arrays are\n"
+"copied from the mapping unless *view* is set.\n"
+"\n"
+":Call:\n"
+"    >>> D = _cape.ReadPlt(fname, view=False)\n"
+":Inputs:\n"
+"    *fname*: :class:`str`\n"
+"        Name of file to read\n"
+"    *view*: ``True`` | {``False``}\n"
+"        Return arrays in native byte order as views into the mapping\n"
+"        (see :func:`ReadTri`)\n"
+":Outputs:\n"
+"    *D*: :class:`dict`\n"
+"        *title*, *vars*, *zones*, *aux* (one :class:`dict` per zone),\n"
+"        *parent*, *strand*, *type*, *npt*, *nelem*, *time*, *fmt*\n"
+"        (*nzone* x *nvar*), *qmin*, *qmax*, *q* (list of values), and\n"
+"        *elems* (list of 0-based node indices of each element)\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+PyObject *
+cape_WritePlt(PyObject *self, PyObject *args);
+char doc_WritePlt[] =
+"Write a Tecplot binary (``#!TDV112``) file with finite-element zones\n"
+"\n"
+"The file is written in native byte order.  Each zone's values are\n"
+"converted to 4- or 8-byte floats (according to *fmt*) in one pass that\n"
+"also computes the min and max of each variable, without the GIL.\n"
+"\n"
+":Call:\n"
+"    >>> _cape.WritePlt(target, D)\n"
+":Inputs:\n"
+"    *target*: ``None`` | :class:`str` | :class:`file` | :class:`int`\n"
+"        Output file name, open file, or descriptor\n"
+"    *D*: :class:`dict`\n"
+"        *vars*, *q*, and *elems* as from :func:`ReadPlt`; optional\n"
+"        *title*, *zones*, *aux*, *parent* (``-1``), *strand*\n"
+"        (``1000+i``), *time* (``0``), *type* (``3``), and *fmt* (``1``)\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+#endif  // _CAPE_PLT_H
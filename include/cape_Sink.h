@@ -0,0 +1,68 @@
+#ifndef _CAPE_SINK_H
+#define _CAPE_SINK_H
+
+PyObject *
+cape_SetWritePipeline(PyObject *self, PyObject *args);
+char doc_SetWritePipeline[] =
+"Set pipelined output and sync options for later writers\n"
+"\n"
+"With *nbuf* of 2 or more, every writer that outputs to a file name, open\n"
+"file, or file descriptor copies its output into *nbuf* rotating buffers\n"
+"of *bufsize* bytes, and a helper thread writes each full buffer while the\n"
+"next one is formatted.  In-memory targets are not affected.  The *sync*\n"
+"option applies to files whether or not pipelining is on: ``\"fsync\"``\n"
+"waits for the data to reach the disk, and ``\"dontneed\"`` also drops the\n"
+"new pages from the page cache so that a large output does not evict other\n"
+"cached files.\n"
+"\n"
+":Call:\n"
+"    >>> _cape.SetWritePipeline(nbuf=0, bufsize=0, sync=None)\n"
+":Inputs:\n"
+"    *nbuf*: {``0``} | :class:`int`\n"
+"        Number of buffers; less than 2 turns pipelining off\n"
+"    *bufsize*: {``0``} | :class:`int`\n"
+"        Size of each buffer in bytes; ``0`` for 4 MiB\n"
+"    *sync*: {``None``} | ``\"fsync\"`` | ``\"dontneed\"``\n"
+"        What to do after the last write to each file\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+PyObject *
+cape_WriteWait(PyObject *self, PyObject *args);
+char doc_WriteWait[] =
+"Wait for a background writer and deliver its output\n"
+"\n"
+"Raises the same exceptions the corresponding synchronous writer would.\n"
+"Waiting again on the same handle returns immediately.  A handle that is\n"
+"discarded without waiting still finishes its output, but any error is\n"
+"lost.\n"
+"\n"
+":Call:\n"
+"    >>> n = _cape.WriteWait(h)\n"
+":Inputs:\n"
+"    *h*: :class:`PyCapsule`\n"
+"        Handle from a writer such as :func:`WriteTriQAsync`\n"
+":Outputs:\n"
+"    *n*: ``None`` | :class:`int`\n"
+"        Number of bytes written if the target is a fixed-size buffer\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+PyObject *
+cape_ZipCodecs(PyObject *self, PyObject *args);
+char doc_ZipCodecs[] =
+"List compression formats available in this build\n"
+"\n"
+"Writers compress output to file names ending with ``.gz`` (``\"gzip\"``)\n"
+"or ``.zst`` (``\"zstd\"``), and readers decompress such files, if the\n"
+"format is available.  Otherwise they raise :class:`NotImplementedError`.\n"
+"\n"
+":Call:\n"
+"    >>> codecs = _cape.ZipCodecs()\n"
+":Outputs:\n"
+"    *codecs*: :class:`list` (:class:`str`)\n"
+"        Available formats, from ``\"gzip\"`` and ``\"zstd\"``\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+#endif  // _CAPE_SINK_H
@@ -0,0 +1,34 @@
+#ifndef _CAPE_STATS_H
+#define _CAPE_STATS_H
+
+// Replace functions of module *m* (except *skip*) with counted copies
+int
+cape_StatWrap(PyObject *m, PyMethodDef *methods, const char *skip);
+
+PyObject *
+cape_IOStats(PyObject *self, PyObject *args, PyObject *kwargs);
+char doc_IOStats[] =
+"Get number of calls, bytes, and time of each extension function\n"
+"\n"
+"Every function of :mod:`_cape` counts its calls and the time spent in\n"
+"it; readers and writers also count the bytes they read or write.  Bytes\n"
+"are uncompressed sizes for ``.gz`` and ``.zst`` files, and output to\n"
+"descriptors that cannot report their position (such as pipes) is not\n"
+"counted.  Output of a background write, such as\n"
+":func:`WriteTriQAsync`, is charged to the function that started it\n"
+"when it is delivered.  Only functions that have been called since the\n"
+"last reset are included.\n"
+"\n"
+":Call:\n"
+"    >>> stats = _cape.io_stats(reset=False)\n"
+":Inputs:\n"
+"    *reset*: ``True`` | {``False``}\n"
+"        Whether to zero all counters after reading them\n"
+":Outputs:\n"
+"    *stats*: :class:`dict`\\ [:class:`dict`]\n"
+"        ``\"calls\"``, ``\"bytes\"``, and ``\"time\"`` (seconds) of each\n"
+"        function, by name\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+#endif  // _CAPE_STATS_H
@@ -0,0 +1,35 @@
+#ifndef _CAPE_SURF_H
+#define _CAPE_SURF_H
+
+PyObject *
+cape_ReadSurf(PyObject *self, PyObject *args);
+char doc_ReadSurf[] =
+"Read nodes, tris, and quads of an AFLR3 surface file\n"
+"\n"
+"Binary files are mapped into memory, and the outputs are copied from the\n"
+"mapping unless *view* is set.  The byte order, record markers,\n"
+"precision, and number of node columns are found from the size of the\n"
+"file if *fmt* is ``None``; files that don't match any binary format are\n"
+"read as ASCII.\n"
+"\n"
+":Call:\n"
+"    >>> X, T, Q = _cape.ReadSurf(fname, fmt=None, view=False)\n"
+":Inputs:\n"
+"    *fname*: :class:`str`\n"
+"        Name of file to read (may end with ``.gz`` or ``.zst``)\n"
+"    *fmt*: {``None``} | ``\"ascii\"`` | :class:`str`\n"
+"        File format, for example ``\"lb8\"`` or ``\"r4\"``\n"
+"    *view*: ``True`` | {``False``}\n"
+"        Return arrays in native byte order as views into the mapping\n"
+"        (see :func:`ReadTri`)\n"
+":Outputs:\n"
+"    *X*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, *ncol*)\n"
+"        Nodal coordinates, then *blds* and *bldel* if present\n"
+"    *T*: :class:`numpy.ndarray` (:class:`int32`) (*nTri*, 6)\n"
+"        Node indices, component ID, reconnection flag, and BC of tris\n"
+"    *Q*: :class:`numpy.ndarray` (:class:`int32`) (*nQuad*, 7)\n"
+"        Node indices, component ID, reconnection flag, and BC of quads\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+#endif  // _CAPE_SURF_H
@@ -0,0 +1,44 @@
+#ifndef _CAPE_TSVFILE_H
+#define _CAPE_TSVFILE_H
+
+//! \brief Read number of data lines from current position to end of file
+//!
+//! \return Number of lines in file
+PyObject *
+cape_TSVFileCountLines(PyObject *self, PyObject *args);
+char doc_TSVFileCountLines[] = 
+"Read TSV file to count valid data lines\n"
+"\n"
+":Call:\n"
+"    >>> n = TSVFileCountLines(f)\n"
+":Inputs:\n"
+"    *f*: :class:`file`\n"
+"        Open file interface\n"
+":Outputs:\n"
+"    *n*: :class:`int`\n"
+"        Number of data lines from current position\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n"
+"\n";
+
+//! \brief Read data portion of TSV file in C
+PyObject *
+cape_TSVFileReadData(PyObject *self, PyObject *args);
+char doc_TSVFileReadData[] = 
+"Read data from whitespace-delimited (TSV) file\n"
+"\n"
+"Fields may be separated by any run of spaces and/or tabs.  Blank lines\n"
+"and lines starting with ``#`` are skipped.\n"
+"\n"
+":Call:\n"
+"    >>> TSVFileReadData(db, f)\n"
+":Inputs:\n"
+"    *db*: :class:`cape.dkit.tsvfile.TSVFile`\n"
+"        TSV data file interface\n"
+"    *f*: :class:`file`\n"
+"        Open file interface\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n"
+"\n";
+
+#endif  // _CAPE_TSVFILE_H
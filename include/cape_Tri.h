@@ -7,25 +7,34 @@ char doc_WriteTri[] =
 "Write a Cart3D triangulation to :file:`Components.pyCart.tri` file\n"
 "\n"
 ":Call:\n"
-"    >>> _cape.WriteTri(P, T)\n"
+"    >>> _cape.WriteTri(P, T, C=None, f=None)\n"
 ":Inputs:\n"
 "    *P*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, 3)\n"
 "        Matrix of nodal coordinates\n"
 "    *T*: :class:`numpy.ndarray` (:class:`int`) (*nTri*, 3)\n"
 "        Matrix of of nodal indices for each triangle\n"
+"    *C*: {``None``} | :class:`numpy.ndarray` (:class:`int`) (*nTri*)\n"
+"        Vector of component IDs, written in the same pass if given\n"
+"    *f*: {``None``} | :class:`str` | :class:`file` | :class:`bytearray`\n"
+"        Output file name, open file, file descriptor, or writable buffer\n"
+"        (``bytearray`` is appended to); default ``Components.pyCart.tri``\n"
+":Outputs:\n"
+"    *n*: ``None`` | :class:`int`\n"
+"        Number of bytes written if *f* is a fixed-size buffer\n"
 ":Versions:\n"
-"   * 2014-01-02 ``@ddalle``: First version\n";
+"   * 2014-01-02 ``@ddalle``: First version\n"
+"   * 2026-10-14 ``@ddalle``: v1.1; add *f*\n";
 
 PyObject *
 cape_WriteTri_b4(PyObject *self, PyObject *args);
 char doc_WriteTri_b4[] =
 "Write a single-precision big-endian Fortran-style triangulation file\n"
 "\n"
-"The file written is :file:`Components.pyCart.tri`.  It is the reverse of\n"
+"The default file is :file:`Components.pyCart.tri`.  It is the reverse of\n"
 "whatever the native byte order is.  Fortran record markers are included.\n"
 "\n"
 ":Call:\n"
-"    >>> _cape.WriteTri_b4(P, T, C)\n"
+"    >>> _cape.WriteTri_b4(P, T, C, f=None, ni=4, Q=None)\n"
 ":Inputs:\n"
 "    *P*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, 3)\n"
 "        Matrix of nodal coordinates\n"
@@ -33,19 +42,31 @@ char doc_WriteTri_b4[] =
 "        Vector of component IDs\n"
 "    *T*: :class:`numpy.ndarray` (:class:`int`) (*nTri*, 3)\n"
 "        Matrix of of nodal indices for each triangle\n"
+"    *f*: {``None``} | :class:`str` | :class:`file` | :class:`bytearray`\n"
+"        Output file name, open file, file descriptor, or writable buffer\n"
+"        (``bytearray`` is appended to); default ``Components.pyCart.tri``\n"
+"    *ni*: {``4``} | ``8``\n"
+"        Bytes per integer in header, tris, and component IDs\n"
+"    *Q*: {``None``} | :class:`numpy.ndarray` (*nNode*, *nq*)\n"
+"        Matrix of states at each node; writes a ``.triq`` file\n"
+":Outputs:\n"
+"    *n*: ``None`` | :class:`int`\n"
+"        Number of bytes written if *f* is a fixed-size buffer\n"
 ":Versions:\n"
-"    * 2016-10-10 ``@ddalle``: First version\n";
+"    * 2016-10-10 ``@ddalle``: First version\n"
+"    * 2026-10-14 ``@ddalle``: v1.1; add *f*\n"
+"    * 2026-10-14 ``@ddalle``: v1.2; add *ni* and *Q*\n";
 
 PyObject *
 cape_WriteTri_lb4(PyObject *self, PyObject *args);
 char doc_WriteTri_lb4[] =
 "Write a single-precision little-endian Fortran-style triangulation file\n"
 "\n"
-"The file written is :file:`Components.pyCart.tri`.  It is the reverse of\n"
+"The default file is :file:`Components.pyCart.tri`.  It is the reverse of\n"
 "whatever the native byte order is.  Fortran record markers are included.\n"
 "\n"
 ":Call:\n"
-"    >>> _cape.WriteTri_lb4(P, T, C)\n"
+"    >>> _cape.WriteTri_lb4(P, T, C, f=None, ni=4, Q=None)\n"
 ":Inputs:\n"
 "    *P*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, 3)\n"
 "        Matrix of nodal coordinates\n"
@@ -53,19 +74,31 @@ char doc_WriteTri_lb4[] =
 "        Vector of component IDs\n"
 "    *T*: :class:`numpy.ndarray` (:class:`int`) (*nTri*, 3)\n"
 "        Matrix of of nodal indices for each triangle\n"
+"    *f*: {``None``} | :class:`str` | :class:`file` | :class:`bytearray`\n"
+"        Output file name, open file, file descriptor, or writable buffer\n"
+"        (``bytearray`` is appended to); default ``Components.pyCart.tri``\n"
+"    *ni*: {``4``} | ``8``\n"
+"        Bytes per integer in header, tris, and component IDs\n"
+"    *Q*: {``None``} | :class:`numpy.ndarray` (*nNode*, *nq*)\n"
+"        Matrix of states at each node; writes a ``.triq`` file\n"
+":Outputs:\n"
+"    *n*: ``None`` | :class:`int`\n"
+"        Number of bytes written if *f* is a fixed-size buffer\n"
 ":Versions:\n"
-"    * 2016-10-10 ``@ddalle``: First version\n";
+"    * 2016-10-10 ``@ddalle``: First version\n"
+"    * 2026-10-14 ``@ddalle``: v1.1; add *f*\n"
+"    * 2026-10-14 ``@ddalle``: v1.2; add *ni* and *Q*\n";
 
 PyObject *
 cape_WriteTri_b8(PyObject *self, PyObject *args);
 char doc_WriteTri_b8[] =
 "Write a double-precision big-endian Fortran-style triangulation file\n"
 "\n"
-"The file written is :file:`Components.pyCart.tri`.  It is the reverse of\n"
+"The default file is :file:`Components.pyCart.tri`.  It is the reverse of\n"
 "whatever the native byte order is.  Fortran record markers are included.\n"
 "\n"
 ":Call:\n"
-"    >>> _cape.WriteTri_b8(P, T, C)\n"
+"    >>> _cape.WriteTri_b8(P, T, C, f=None, ni=4, Q=None)\n"
 ":Inputs:\n"
 "    *P*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, 3)\n"
 "        Matrix of nodal coordinates\n"
@@ -73,19 +106,31 @@ char doc_WriteTri_b8[] =
 "        Vector of component IDs\n"
 "    *T*: :class:`numpy.ndarray` (:class:`int`) (*nTri*, 3)\n"
 "        Matrix of of nodal indices for each triangle\n"
+"    *f*: {``None``} | :class:`str` | :class:`file` | :class:`bytearray`\n"
+"        Output file name, open file, file descriptor, or writable buffer\n"
+"        (``bytearray`` is appended to); default ``Components.pyCart.tri``\n"
+"    *ni*: {``4``} | ``8``\n"
+"        Bytes per integer in header, tris, and component IDs\n"
+"    *Q*: {``None``} | :class:`numpy.ndarray` (*nNode*, *nq*)\n"
+"        Matrix of states at each node; writes a ``.triq`` file\n"
+":Outputs:\n"
+"    *n*: ``None`` | :class:`int`\n"
+"        Number of bytes written if *f* is a fixed-size buffer\n"
 ":Versions:\n"
-"    * 2016-10-10 ``@ddalle``: First version\n";
+"    * 2016-10-10 ``@ddalle``: First version\n"
+"    * 2026-10-14 ``@ddalle``: v1.1; add *f*\n"
+"    * 2026-10-14 ``@ddalle``: v1.2; add *ni* and *Q*\n";
 
 PyObject *
 cape_WriteTri_lb8(PyObject *self, PyObject *args);
 char doc_WriteTri_lb8[] =
 "Write a double-precision little-endian Fortran-style triangulation file\n"
 "\n"
-"The file written is :file:`Components.pyCart.tri`.  It is the reverse of\n"
+"The default file is :file:`Components.pyCart.tri`.  It is the reverse of\n"
 "whatever the native byte order is.  Fortran record markers are included.\n"
 "\n"
 ":Call:\n"
-"    >>> _cape.WriteTri_lb8(P, T, C)\n"
+"    >>> _cape.WriteTri_lb8(P, T, C, f=None, ni=4, Q=None)\n"
 ":Inputs:\n"
 "    *P*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, 3)\n"
 "        Matrix of nodal coordinates\n"
@@ -93,8 +138,182 @@ char doc_WriteTri_lb8[] =
 "        Vector of component IDs\n"
 "    *T*: :class:`numpy.ndarray` (:class:`int`) (*nTri*, 3)\n"
 "        Matrix of of nodal indices for each triangle\n"
+"    *f*: {``None``} | :class:`str` | :class:`file` | :class:`bytearray`\n"
+"        Output file name, open file, file descriptor, or writable buffer\n"
+"        (``bytearray`` is appended to); default ``Components.pyCart.tri``\n"
+"    *ni*: {``4``} | ``8``\n"
+"        Bytes per integer in header, tris, and component IDs\n"
+"    *Q*: {``None``} | :class:`numpy.ndarray` (*nNode*, *nq*)\n"
+"        Matrix of states at each node; writes a ``.triq`` file\n"
+":Outputs:\n"
+"    *n*: ``None`` | :class:`int`\n"
+"        Number of bytes written if *f* is a fixed-size buffer\n"
 ":Versions:\n"
-"    * 2016-10-10 ``@ddalle``: First version\n";
+"    * 2016-10-10 ``@ddalle``: First version\n"
+"    * 2026-10-14 ``@ddalle``: v1.1; add *f*\n"
+"    * 2026-10-14 ``@ddalle``: v1.2; add *ni* and *Q*\n";
+
+PyObject *
+cape_WriteTri_r4(PyObject *self, PyObject *args);
+char doc_WriteTri_r4[] =
+"Write a single-precision big-endian Fortran record triangulation file\n"
+"\n"
+"The default file is :file:`Components.pyCart.tri`.  Fortran record markers\n"
+"are included; the output is the same as :func:`WriteTri_b4`.\n"
+"\n"
+":Call:\n"
+"    >>> _cape.WriteTri_r4(P, T, C, f=None, ni=4, Q=None)\n"
+":Inputs:\n"
+"    *P*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, 3)\n"
+"        Matrix of nodal coordinates\n"
+"    *T*: :class:`numpy.ndarray` (:class:`int`) (*nTri*, 3)\n"
+"        Matrix of of nodal indices for each triangle\n"
+"    *C*: :class:`numpy.ndarray` (:class:`int`) (*nTri*)\n"
+"        Vector of component IDs\n"
+"    *f*: {``None``} | :class:`str` | :class:`file` | :class:`bytearray`\n"
+"        Output file name, open file, file descriptor, or writable buffer\n"
+"        (``bytearray`` is appended to); default ``Components.pyCart.tri``\n"
+"    *ni*: {``4``} | ``8``\n"
+"        Bytes per integer in header, tris, and component IDs\n"
+"    *Q*: {``None``} | :class:`numpy.ndarray` (*nNode*, *nq*)\n"
+"        Matrix of states at each node; writes a ``.triq`` file\n"
+":Outputs:\n"
+"    *n*: ``None`` | :class:`int`\n"
+"        Number of bytes written if *f* is a fixed-size buffer\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n"
+"    * 2026-10-14 ``@ddalle``: v1.1; add *f*\n"
+"    * 2026-10-14 ``@ddalle``: v1.2; add *ni* and *Q*\n";
+
+PyObject *
+cape_WriteTri_lr4(PyObject *self, PyObject *args);
+char doc_WriteTri_lr4[] =
+"Write a single-precision little-endian Fortran record triangulation file\n"
+"\n"
+"The default file is :file:`Components.pyCart.tri`.  Fortran record markers\n"
+"are included; the output is the same as :func:`WriteTri_lb4`.\n"
+"\n"
+":Call:\n"
+"    >>> _cape.WriteTri_lr4(P, T, C, f=None, ni=4, Q=None)\n"
+":Inputs:\n"
+"    *P*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, 3)\n"
+"        Matrix of nodal coordinates\n"
+"    *T*: :class:`numpy.ndarray` (:class:`int`) (*nTri*, 3)\n"
+"        Matrix of of nodal indices for each triangle\n"
+"    *C*: :class:`numpy.ndarray` (:class:`int`) (*nTri*)\n"
+"        Vector of component IDs\n"
+"    *f*: {``None``} | :class:`str` | :class:`file` | :class:`bytearray`\n"
+"        Output file name, open file, file descriptor, or writable buffer\n"
+"        (``bytearray`` is appended to); default ``Components.pyCart.tri``\n"
+"    *ni*: {``4``} | ``8``\n"
+"        Bytes per integer in header, tris, and component IDs\n"
+"    *Q*: {``None``} | :class:`numpy.ndarray` (*nNode*, *nq*)\n"
+"        Matrix of states at each node; writes a ``.triq`` file\n"
+":Outputs:\n"
+"    *n*: ``None`` | :class:`int`\n"
+"        Number of bytes written if *f* is a fixed-size buffer\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n"
+"    * 2026-10-14 ``@ddalle``: v1.1; add *f*\n"
+"    * 2026-10-14 ``@ddalle``: v1.2; add *ni* and *Q*\n";
+
+PyObject *
+cape_WriteTri_r8(PyObject *self, PyObject *args);
+char doc_WriteTri_r8[] =
+"Write a double-precision big-endian Fortran record triangulation file\n"
+"\n"
+"The default file is :file:`Components.pyCart.tri`.  Fortran record markers\n"
+"are included; the output is the same as :func:`WriteTri_b8`.\n"
+"\n"
+":Call:\n"
+"    >>> _cape.WriteTri_r8(P, T, C, f=None, ni=4, Q=None)\n"
+":Inputs:\n"
+"    *P*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, 3)\n"
+"        Matrix of nodal coordinates\n"
+"    *T*: :class:`numpy.ndarray` (:class:`int`) (*nTri*, 3)\n"
+"        Matrix of of nodal indices for each triangle\n"
+"    *C*: :class:`numpy.ndarray` (:class:`int`) (*nTri*)\n"
+"        Vector of component IDs\n"
+"    *f*: {``None``} | :class:`str` | :class:`file` | :class:`bytearray`\n"
+"        Output file name, open file, file descriptor, or writable buffer\n"
+"        (``bytearray`` is appended to); default ``Components.pyCart.tri``\n"
+"    *ni*: {``4``} | ``8``\n"
+"        Bytes per integer in header, tris, and component IDs\n"
+"    *Q*: {``None``} | :class:`numpy.ndarray` (*nNode*, *nq*)\n"
+"        Matrix of states at each node; writes a ``.triq`` file\n"
+":Outputs:\n"
+"    *n*: ``None`` | :class:`int`\n"
+"        Number of bytes written if *f* is a fixed-size buffer\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n"
+"    * 2026-10-14 ``@ddalle``: v1.1; add *f*\n"
+"    * 2026-10-14 ``@ddalle``: v1.2; add *ni* and *Q*\n";
+
+PyObject *
+cape_WriteTri_lr8(PyObject *self, PyObject *args);
+char doc_WriteTri_lr8[] =
+"Write a double-precision little-endian Fortran record triangulation file\n"
+"\n"
+"The default file is :file:`Components.pyCart.tri`.  Fortran record markers\n"
+"are included; the output is the same as :func:`WriteTri_lb8`.\n"
+"\n"
+":Call:\n"
+"    >>> _cape.WriteTri_lr8(P, T, C, f=None, ni=4, Q=None)\n"
+":Inputs:\n"
+"    *P*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, 3)\n"
+"        Matrix of nodal coordinates\n"
+"    *T*: :class:`numpy.ndarray` (:class:`int`) (*nTri*, 3)\n"
+"        Matrix of of nodal indices for each triangle\n"
+"    *C*: :class:`numpy.ndarray` (:class:`int`) (*nTri*)\n"
+"        Vector of component IDs\n"
+"    *f*: {``None``} | :class:`str` | :class:`file` | :class:`bytearray`\n"
+"        Output file name, open file, file descriptor, or writable buffer\n"
+"        (``bytearray`` is appended to); default ``Components.pyCart.tri``\n"
+"    *ni*: {``4``} | ``8``\n"
+"        Bytes per integer in header, tris, and component IDs\n"
+"    *Q*: {``None``} | :class:`numpy.ndarray` (*nNode*, *nq*)\n"
+"        Matrix of states at each node; writes a ``.triq`` file\n"
+":Outputs:\n"
+"    *n*: ``None`` | :class:`int`\n"
+"        Number of bytes written if *f* is a fixed-size buffer\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n"
+"    * 2026-10-14 ``@ddalle``: v1.1; add *f*\n"
+"    * 2026-10-14 ``@ddalle``: v1.2; add *ni* and *Q*\n";
+
+PyObject *
+cape_WriteTriStream(PyObject *self, PyObject *args);
+char doc_WriteTriStream[] =
+"Write a Fortran stream (``access='stream'``) tri or triq file\n"
+"\n"
+"The layout is the same as the Fortran record formats, but with no record\n"
+"markers:  ``nNode, nTri[, nq]``, nodes, tris, component IDs, and states.\n"
+"\n"
+":Call:\n"
+"    >>> _cape.WriteTriStream(f, P, T, C, Q=None, bo=None, nf=4, ni=4)\n"
+":Inputs:\n"
+"    *f*: :class:`str` | :class:`file` | :class:`bytearray`\n"
+"        Output file name, open file, file descriptor, or writable buffer\n"
+"    *P*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, 3)\n"
+"        Matrix of nodal coordinates\n"
+"    *T*: :class:`numpy.ndarray` (:class:`int`) (*nTri*, 3)\n"
+"        Matrix of of nodal indices for each triangle\n"
+"    *C*: :class:`numpy.ndarray` (:class:`int`) (*nTri*) | ``None``\n"
+"        Vector of component IDs\n"
+"    *Q*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, *nq*) | ``None``\n"
+"        Matrix of states at each node\n"
+"    *bo*: {``None``} | ``\"big\"`` | ``\"little\"``\n"
+"        Byte order; native if ``None``\n"
+"    *nf*: {``4``} | ``8``\n"
+"        Bytes per float\n"
+"    *ni*: {``4``} | ``8``\n"
+"        Bytes per integer in header, tris, and component IDs\n"
+":Outputs:\n"
+"    *n*: ``None`` | :class:`int`\n"
+"        Number of bytes written if *f* is a fixed-size buffer\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n"
+"    * 2026-10-14 ``@ddalle``: v1.1; add *ni*\n";
 
 
 PyObject *
@@ -103,12 +322,19 @@ char doc_WriteCompID[] =
 "Write component ID numbers to :file:`Components.pyCart.tri`\n"
 "\n"
 ":Call:\n"
-"    >>> _cape.WriteCompID(C)\n"
+"    >>> _cape.WriteCompID(C, f=None)\n"
 ":Inputs:\n"
 "    *C*: :class:`numpy.ndarray` (:class:`int`) (*nTri*)\n"
 "        Vector of component IDs\n"
+"    *f*: {``None``} | :class:`str` | :class:`file` | :class:`bytearray`\n"
+"        Output file name (appended to), open file, file descriptor, or\n"
+"        writable buffer; default is :file:`Components.pyCart.tri`\n"
+":Outputs:\n"
+"    *n*: ``None`` | :class:`int`\n"
+"        Number of bytes written if *f* is a fixed-size buffer\n"
 ":Versions:\n"
-"   * 2014-01-02 ``@ddalle``: First version\n";
+"   * 2014-01-02 ``@ddalle``: First version\n"
+"   * 2026-10-14 ``@ddalle``: v1.1; add *f*\n";
 
 
 PyObject *
@@ -117,7 +343,7 @@ char doc_WriteTriQ[] =
 "Write ``.triq`` file to :file:`Components.pyCart.tri`\n"
 "\n"
 ":Call:\n"
-"    >>> _cape.WriteTriQ(P, T, C, Q)\n"
+"    >>> _cape.WriteTriQ(P, T, C, Q, f=None)\n"
 ":Inputs:\n"
 "    *P*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, 3)\n"
 "        Matrix of nodal coordinates\n"
@@ -127,16 +353,56 @@ char doc_WriteTriQ[] =
 "        Vector of component IDs\n"
 "    *Q*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, *nq*)\n"
 "        Matrix of states at each node\n"
+"    *f*: {``None``} | :class:`str` | :class:`file` | :class:`bytearray`\n"
+"        Output file name, open file, file descriptor, or writable buffer\n"
+"        (``bytearray`` is appended to); default ``Components.pyCart.tri``\n"
+":Outputs:\n"
+"    *n*: ``None`` | :class:`int`\n"
+"        Number of bytes written if *f* is a fixed-size buffer\n"
 ":Versions:\n"
-"    * 2015-09-24 ``@ddalle``: First version\n";
+"    * 2015-09-24 ``@ddalle``: First version\n"
+"    * 2026-10-14 ``@ddalle``: v1.1; add *f*\n";
+
+PyObject *
+cape_WriteTriQAsync(PyObject *self, PyObject *args);
+char doc_WriteTriQAsync[] =
+"Start writing ``.triq`` file in a background thread\n"
+"\n"
+"The output is the same as :func:`WriteTriQ`, but this returns as soon as\n"
+"the file is open.  Pass the handle to :func:`WriteWait` to wait for the\n"
+"write to finish and check for errors.  The arrays must not be modified\n"
+"until then.\n"
+"\n"
+":Call:\n"
+"    >>> h = _cape.WriteTriQAsync(P, T, C, Q, f=None)\n"
+":Inputs:\n"
+"    *P*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, 3)\n"
+"        Matrix of nodal coordinates\n"
+"    *T*: :class:`numpy.ndarray` (:class:`int`) (*nTri*, 3)\n"
+"        Matrix of of nodal indices for each triangle\n"
+"    *C*: :class:`numpy.ndarray` (:class:`int`) (*nTri*)\n"
+"        Vector of component IDs\n"
+"    *Q*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, *nq*)\n"
+"        Matrix of states at each node\n"
+"    *f*: {``None``} | :class:`str` | :class:`file` | :class:`bytearray`\n"
+"        Output file name, open file, file descriptor, or writable buffer\n"
+"        (``bytearray`` is appended to); default ``Components.pyCart.tri``\n"
+":Outputs:\n"
+"    *h*: :class:`PyCapsule`\n"
+"        Handle of the running write\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
 
 PyObject *
 cape_WriteSurf(PyObject *self, PyObject *args);
 char doc_WriteSurf[] =
 "Write AFLR3 surface file to :file:`Components.pyCart.surf`\n"
 "\n"
+"Binary formats pack each node with its *blds* and *bldel* and each face\n"
+"with its flags, then write nodes, tris, and quads as one record each.\n"
+"\n"
 ":Call:\n"
-"    >>> cape_WriteSurf(P, blds, bldel, T, CT, BCT, Q, CQ, BCQ)\n"
+"    >>> _cape.WriteSurf(P, blds, bldel, T, CT, BCT, Q, CQ, BCQ, f, fmt)\n"
 ":Inputs:\n"
 "    *P*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, 3)\n"
 "        Matrix of nodal coordinates\n"
@@ -152,23 +418,166 @@ char doc_WriteSurf[] =
 "        Vector of component IDs for each quadrangle\n"
 "    *BCQ*: :class:`numpy.ndarray` (:class:`int`) (*nQuad*)\n"
 "        Vector of AFLR3 boundary condition flags for each quadrangle\n"
+"    *f*: {``None``} | :class:`str` | :class:`file` | :class:`bytearray`\n"
+"        Output file name, open file, file descriptor, or writable buffer\n"
+"        (``bytearray`` is appended to); default ``Components.pyCart.surf``\n"
+"    *fmt*: {``\"ascii\"``} | ``\"lb8\"`` | ``\"lb4\"`` | ``\"lr8\"`` | ...\n"
+"        File format, as in :func:`_cape.WriteUGrid`\n"
+":Outputs:\n"
+"    *n*: ``None`` | :class:`int`\n"
+"        Number of bytes written if *f* is a fixed-size buffer\n"
 ":Versions:\n"
-"    * 2016-04-13 ``@ddalle``: First version\n";
+"    * 2016-04-13 ``@ddalle``: First version\n"
+"    * 2026-10-14 ``@ddalle``: v1.1; add *f*\n"
+"    * 2026-10-14 ``@ddalle``: v1.2; add binary *fmt*\n";
 
 PyObject *
 cape_WriteTriSTL(PyObject *self, PyObject *args);
-char doc_WriteTriSTL[] = 
-"Write ``.stl`` file to :file:`Components.pyCart.stl`\n"
+char doc_WriteTriSTL[] =
+"Write ASCII ``.stl`` file to :file:`Components.pyCart.stl`\n"
+"\n"
+"Coordinates and normals are written with nine significant digits.\n"
 "\n"
 ":Call:\n"
-"    >>> _cape.WriteTriSTL(P, T, N)\n"
+"    >>> _cape.WriteTriSTL(P, T, N=None, f=None)\n"
 ":Inputs:\n"
 "    *P*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, 3)\n"
 "        Matrix of nodal coordinates\n"
 "    *T*: :class:`numpy.ndarray` (:class:`int`) (*nTri*, 3)\n"
-"        Matrix of of nodal indices for each triangle\n"
-"    *N*: :class:`numpy.ndarray` (:class:`int`) (*nTri*, 3)\n"
-"        Vector of triangle normals\n"
+"        Matrix of of (1-based) nodal indices for each triangle\n"
+"    *N*: {``None``} | :class:`numpy.ndarray` (:class:`float`) (*nTri*, 3)\n"
+"        Triangle normals; computed from *P* and *T* if ``None``\n"
+"    *f*: {``None``} | :class:`str` | :class:`file` | :class:`bytearray`\n"
+"        Output file name, open file, file descriptor, or writable buffer\n"
+"        (``bytearray`` is appended to); default ``Components.pyCart.stl``\n"
+":Outputs:\n"
+"    *n*: ``None`` | :class:`int`\n"
+"        Number of bytes written if *f* is a fixed-size buffer\n"
+":Versions:\n"
+"    * 2015-11-23 ``@ddalle``: First version\n"
+"    * 2026-10-14 ``@ddalle``: v1.1; add *f*\n"
+"    * 2026-10-14 ``@ddalle``: v1.2; full precision, optional *N*\n";
+
+PyObject *
+cape_WriteTriSTLBin(PyObject *self, PyObject *args);
+char doc_WriteTriSTLBin[] =
+"Write binary ``.stl`` file to :file:`Components.pyCart.stl`\n"
+"\n"
+"Each facet is a 50-byte little-endian record with single-precision\n"
+"normal and vertices.  Normals are computed from *P* and *T* if *N* is\n"
+"not given.\n"
+"\n"
+":Call:\n"
+"    >>> _cape.WriteTriSTLBin(P, T, N=None, f=None)\n"
+":Inputs:\n"
+"    *P*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, 3)\n"
+"        Matrix of nodal coordinates\n"
+"    *T*: :class:`numpy.ndarray` (:class:`int`) (*nTri*, 3)\n"
+"        Matrix of of (1-based) nodal indices for each triangle\n"
+"    *N*: {``None``} | :class:`numpy.ndarray` (:class:`float`) (*nTri*, 3)\n"
+"        Triangle normals; computed from *P* and *T* if ``None``\n"
+"    *f*: {``None``} | :class:`str` | :class:`file` | :class:`bytearray`\n"
+"        Output file name, open file, file descriptor, or writable buffer\n"
+"        (``bytearray`` is appended to); default ``Components.pyCart.stl``\n"
+":Outputs:\n"
+"    *n*: ``None`` | :class:`int`\n"
+"        Number of bytes written if *f* is a fixed-size buffer\n"
 ":Versions:\n"
-"    * 2015-11-23 ``@ddalle``: First version\n";
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+PyObject *
+cape_ReadTri(PyObject *self, PyObject *args);
+char doc_ReadTri[] =
+"Read a binary (Fortran unformatted) Cart3D triangulation file\n"
+"\n"
+"Byte order and precision are detected from the record markers, so any of\n"
+"the ``b4``, ``lb4``, ``b8``, ``lb8``, ``r4``, ``lr4``, ``r8``, or ``lr8``\n"
+"formats can be read.  The file is memory-mapped, and each array is copied\n"
+"(and byte-swapped if needed) from the mapping in one pass.  Floats are\n"
+"returned in the precision of the file.  Files with 8-byte integers give\n"
+"``int64`` tris and component IDs, and records split into gfortran\n"
+"sub-records (over 2 GiB) are joined.\n"
+"\n"
+"With *view*, arrays in native byte order are instead views into the\n"
+"private mapping, which stays open as long as any of them does.  This\n"
+"avoids the copy, but the views are only valid while the file keeps its\n"
+"size: if it is truncated or rewritten in place (for example by writing\n"
+"the same triangulation back to *fname*), reading them kills the process\n"
+"with ``SIGBUS``.\n"
+"\n"
+":Call:\n"
+"    >>> P, T, C = _cape.ReadTri(fname, view=False)\n"
+":Inputs:\n"
+"    *fname*: :class:`str`\n"
+"        Name of file to read\n"
+"    *view*: ``True`` | {``False``}\n"
+"        Return arrays in native byte order as views into the mapping\n"
+":Outputs:\n"
+"    *P*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, 3)\n"
+"        Matrix of nodal coordinates\n"
+"    *T*: :class:`numpy.ndarray` (:class:`int32` | :class:`int64`)\n"
+"        Matrix of of nodal indices for each triangle (*nTri*, 3)\n"
+"    *C*: :class:`numpy.ndarray` (*nTri*) | ``None``\n"
+"        Vector of component IDs, if present in file; same type as *T*\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n"
+"    * 2026-10-14 ``@ddalle``: v1.1; 8-byte ints and sub-records\n"
+"    * 2026-10-14 ``@ddalle``: v1.2; copy unless *view*\n";
+
+PyObject *
+cape_ReadTriQ(PyObject *self, PyObject *args);
+char doc_ReadTriQ[] =
+"Read a binary (Fortran unformatted) Cart3D annotated triangulation file\n"
+"\n"
+"See :func:`ReadTri`; this also returns the state record, if present.\n"
+"\n"
+":Call:\n"
+"    >>> P, T, C, Q = _cape.ReadTriQ(fname, view=False)\n"
+":Inputs:\n"
+"    *fname*: :class:`str`\n"
+"        Name of file to read\n"
+"    *view*: ``True`` | {``False``}\n"
+"        Return arrays in native byte order as views into the mapping\n"
+":Outputs:\n"
+"    *P*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, 3)\n"
+"        Matrix of nodal coordinates\n"
+"    *T*: :class:`numpy.ndarray` (:class:`int32` | :class:`int64`)\n"
+"        Matrix of of nodal indices for each triangle (*nTri*, 3)\n"
+"    *C*: :class:`numpy.ndarray` (*nTri*) | ``None``\n"
+"        Vector of component IDs, if present in file; same type as *T*\n"
+"    *Q*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, *nq*) | ``None``\n"
+"        Matrix of states at each node, if present in file\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n"
+"    * 2026-10-14 ``@ddalle``: v1.1; 8-byte ints and sub-records\n"
+"    * 2026-10-14 ``@ddalle``: v1.2; copy unless *view*\n";
+
+
+PyObject *
+cape_ReadTriStream(PyObject *self, PyObject *args);
+char doc_ReadTriStream[] =
+"Read a Fortran stream (no record marker) tri or triq file\n"
+"\n"
+"Byte order, precision, and whether the header includes *nq* are inferred\n"
+"from the header counts and the size of the file.  Component IDs and states\n"
+"are optional.  Arrays are views or copies as in :func:`ReadTri`.\n"
+"\n"
+":Call:\n"
+"    >>> P, T, C, Q = _cape.ReadTriStream(fname)\n"
+":Inputs:\n"
+"    *fname*: :class:`str`\n"
+"        Name of file to read\n"
+":Outputs:\n"
+"    *P*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, 3)\n"
+"        Matrix of nodal coordinates\n"
+"    *T*: :class:`numpy.ndarray` (:class:`int32` | :class:`int64`)\n"
+"        Matrix of of nodal indices for each triangle (*nTri*, 3)\n"
+"    *C*: :class:`numpy.ndarray` (*nTri*) | ``None``\n"
+"        Vector of component IDs, if present in file; same type as *T*\n"
+"    *Q*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, *nq*) | ``None``\n"
+"        Matrix of states at each node, if present in file\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n"
+"    * 2026-10-14 ``@ddalle``: v1.1; 8-byte ints and sub-records\n";
+
 #endif
@@ -0,0 +1,85 @@
+#ifndef _CAPE_TRICLEAN_H
+#define _CAPE_TRICLEAN_H
+
+PyObject *
+cape_TriRemoveUnusedNodes(PyObject *self, PyObject *args);
+char doc_TriRemoveUnusedNodes[] =
+"Remove nodes that are not used by any tri, in place\n"
+"\n"
+"Nodes in use are moved to the start of *P* in their original order and\n"
+"*T* is renumbered, using one map from old to new node index.\n"
+"\n"
+":Call:\n"
+"    >>> J = _cape.TriRemoveUnusedNodes(P, T)\n"
+":Inputs:\n"
+"    *P*: :class:`numpy.ndarray` (:class:`float64`) (*nNode*, 3)\n"
+"        Matrix of nodal coordinates (modified)\n"
+"    *T*: :class:`numpy.ndarray` (:class:`int32`) (*nTri*, 3)\n"
+"        Matrix of (1-based) nodal indices for each triangle (modified)\n"
+":Outputs:\n"
+"    *J*: :class:`numpy.ndarray` (:class:`int32`)\n"
+"        Original (0-based) index of each remaining node; new nodes are\n"
+"        ``P[:J.size]``\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+PyObject *
+cape_TriWeldNodes(PyObject *self, PyObject *args);
+char doc_TriWeldNodes[] =
+"Merge nodes within a distance tolerance of each other, in place\n"
+"\n"
+"Nodes are binned into a hash table of cubes of width *tol*, so only\n"
+"nodes in neighboring cubes are compared.  Each node is merged into the\n"
+"first kept node within *tol* of it; *tol* of ``0`` merges only nodes\n"
+"with identical coordinates.  Tris are renumbered but not removed.\n"
+"\n"
+":Call:\n"
+"    >>> J = _cape.TriWeldNodes(P, T, tol)\n"
+":Inputs:\n"
+"    *P*: :class:`numpy.ndarray` (:class:`float64`) (*nNode*, 3)\n"
+"        Matrix of nodal coordinates (modified)\n"
+"    *T*: :class:`numpy.ndarray` (:class:`int32`) (*nTri*, 3)\n"
+"        Matrix of (1-based) nodal indices for each triangle (modified)\n"
+"    *tol*: :class:`float`\n"
+"        Distance tolerance\n"
+":Outputs:\n"
+"    *J*: :class:`numpy.ndarray` (:class:`int32`)\n"
+"        Original (0-based) index of each remaining node; new nodes are\n"
+"        ``P[:J.size]``\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+PyObject *
+cape_TriRemoveSmallTris(PyObject *self, PyObject *args);
+char doc_TriRemoveSmallTris[] =
+"Collapse tris with small areas and remove unused nodes, in place\n"
+"\n"
+"In each pass, the shortest edge of each tri with area no greater than\n"
+"*smalltri* is collapsed (or the whole tri if no edge is longer than\n"
+"the square root of *smalltri*), and tris with repeated nodes are\n"
+"removed.  Passes are repeated until no small tris are left or *npass*\n"
+"passes (if positive) have been made.\n"
+"\n"
+":Call:\n"
+"    >>> nTri, J = _cape.TriRemoveSmallTris(P, T, C, smalltri, npass)\n"
+":Inputs:\n"
+"    *P*: :class:`numpy.ndarray` (:class:`float64`) (*nNode*, 3)\n"
+"        Matrix of nodal coordinates (modified)\n"
+"    *T*: :class:`numpy.ndarray` (:class:`int32`) (*nTri*, 3)\n"
+"        Matrix of (1-based) nodal indices for each triangle (modified)\n"
+"    *C*: ``None`` | :class:`numpy.ndarray` (:class:`int32`) (*nTri*)\n"
+"        Component ID of each triangle (modified)\n"
+"    *smalltri*: :class:`float`\n"
+"        Maximum area of triangles to collapse\n"
+"    *npass*: :class:`int`\n"
+"        Maximum number of passes; ``0`` for no limit\n"
+":Outputs:\n"
+"    *nTri*: :class:`int`\n"
+"        Number of remaining triangles, ``T[:nTri]`` and ``C[:nTri]``\n"
+"    *J*: :class:`numpy.ndarray` (:class:`int32`)\n"
+"        Original (0-based) index of each remaining node; new nodes are\n"
+"        ``P[:J.size]``\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+#endif  // _CAPE_TRICLEAN_H
@@ -0,0 +1,31 @@
+#ifndef _CAPE_TRITOPO_H
+#define _CAPE_TRITOPO_H
+
+PyObject *
+cape_TriTopology(PyObject *self, PyObject *args);
+char doc_TriTopology[] =
+"Find unique edges and CSR adjacency of a triangulation\n"
+"\n"
+"Edges are found with a hash table in one pass through the tris, which\n"
+"also counts open and non-manifold edges.  Each adjacency list is stored\n"
+"in compressed sparse row form, so the tris of node *i* are\n"
+"``n2t[n2t_ptr[i]:n2t_ptr[i+1]]``.  All outputs are 0-based.\n"
+"\n"
+":Call:\n"
+"    >>> D = _cape.TriTopology(T, nNode)\n"
+":Inputs:\n"
+"    *T*: :class:`numpy.ndarray` (:class:`int`) (*nTri*, 3)\n"
+"        Matrix of (1-based) nodal indices for each triangle\n"
+"    *nNode*: :class:`int`\n"
+"        Number of nodes\n"
+":Outputs:\n"
+"    *D*: :class:`dict`\n"
+"        *edges* (nodes of each edge, lower first), *tri_edges* (edge of\n"
+"        side *k*, from node *k* to node *k*\\ +1, of each tri), CSR\n"
+"        pairs *n2t_ptr*/*n2t*, *e2t_ptr*/*e2t*, and *t2t_ptr*/*t2t*\n"
+"        (each neighbor once per shared edge), and counts *nedge*,\n"
+"        *nopen*, and *nnonmanifold*\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+#endif  // _CAPE_TRITOPO_H
@@ -0,0 +1,47 @@
+#ifndef _CAPE_TRIQFM_H
+#define _CAPE_TRIQFM_H
+
+PyObject *
+cape_TriqForces(PyObject *self, PyObject *args);
+char doc_TriqForces[] =
+"Add up forces and moments on the triangles of each component\n"
+"\n"
+"Pressure, vacuum, momentum, and viscous forces on each triangle are\n"
+"computed as in :func:`cape.trifile.Triq.GetTriForces` and added to the\n"
+"sums for its component ID in one pass.  Each force is followed by the\n"
+"sum of its moment about the origin, so that moments about any point can\n"
+"be computed from the sums.  Forces are not normalized.\n"
+"\n"
+":Call:\n"
+"    >>> I, S = _cape.TriqForces(P, T, Q, C, mach, Rey, gam, **kw)\n"
+"    >>> I, S = _cape.TriqForces(P, T, Q, C, mach, Rey, gam, vmin, n)\n"
+":Inputs:\n"
+"    *P*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, 3)\n"
+"        Matrix of nodal coordinates\n"
+"    *T*: :class:`numpy.ndarray` (:class:`int`) (*nTri*, 3)\n"
+"        Matrix of (1-based) nodal indices for each triangle\n"
+"    *Q*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, *nq*)\n"
+"        States at each node\n"
+"    *C*: :class:`numpy.ndarray` (:class:`int`) (*nTri*,)\n"
+"        Component ID of each triangle\n"
+"    *mach*: :class:`float`\n"
+"        Freestream Mach number\n"
+"    *Rey*: :class:`float`\n"
+"        Reynolds number per grid unit\n"
+"    *gam*: :class:`float`\n"
+"        Freestream ratio of specific heats\n"
+"    *vmin*: {``1e-20``} | :class:`float`\n"
+"        Smallest prism volume used for viscous forces\n"
+"    *n*: {``0``} | :class:`int`\n"
+"        Maximum number of threads; ``0`` to use all CPUs\n"
+":Outputs:\n"
+"    *I*: :class:`numpy.ndarray` (:class:`int`) (*nComp*,)\n"
+"        Sorted list of component IDs\n"
+"    *S*: :class:`numpy.ndarray` (:class:`float`) (*nComp*, 28)\n"
+"        Area vector; then pressure, vacuum, momentum, and viscous\n"
+"        forces, each followed by its moment about the origin; then\n"
+"        number of triangles\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+#endif  // _CAPE_TRIQFM_H
@@ -0,0 +1,60 @@
+#ifndef _CAPE_UGRID_H
+#define _CAPE_UGRID_H
+
+PyObject *
+cape_ReadUGrid(PyObject *self, PyObject *args);
+char doc_ReadUGrid[] =
+"Read selected sections of an AFLR3 UGRID volume mesh\n"
+"\n"
+"Binary files are mapped into memory and each section is located from\n"
+"the header, so only the requested sections are read from disk.  Arrays\n"
+"are copied from the mapping unless *view* is set.  ASCII files\n"
+"are scanned in order, skipping values of other sections, and reading\n"
+"stops after the last requested section.  Optional sections missing\n"
+"from the end of the file are left out of *D*.\n"
+"\n"
+":Call:\n"
+"    >>> ns, D = _cape.ReadUGrid(fname, fmt=None, sections=None, view=False)\n"
+":Inputs:\n"
+"    *fname*: :class:`str`\n"
+"        Name of file to read\n"
+"    *fmt*: {``None``} | ``\"ascii\"`` | ``\"lb8\"`` | ``\"r4\"`` | ...\n"
+"        File format; detected from file size if ``None``\n"
+"    *sections*: {``None``} | :class:`list`\\ [:class:`str`]\n"
+"        Names of sections to read, e.g. ``\"nodes\"``, ``\"tris\"``,\n"
+"        ``\"surf_ids\"``, ``\"tets\"``, ``\"surf_bcs\"``; default is all\n"
+"    *view*: ``True`` | {``False``}\n"
+"        Return arrays in native byte order as views into the mapping\n"
+"        (see :func:`ReadTri`)\n"
+":Outputs:\n"
+"    *ns*: :class:`tuple`\\ [:class:`int`]\n"
+"        Number of nodes, tris, quads, tets, pyramids, prisms, and hexs\n"
+"    *D*: :class:`dict`\\ [:class:`numpy.ndarray`]\n"
+"        Array for each section read; node indices and IDs are\n"
+"        :class:`int32`, and grouped sections such as *surf_ids* are\n"
+"        one-dimensional with tris first\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+PyObject *
+cape_WriteUGrid(PyObject *self, PyObject *args);
+char doc_WriteUGrid[] =
+"Write an AFLR3 UGRID volume mesh in any ASCII or binary format\n"
+"\n"
+"The header counts come from the number of rows of each element array.\n"
+"Sections are written in order until the first one missing from *D*.\n"
+"\n"
+":Call:\n"
+"    >>> _cape.WriteUGrid(target, fmt, D)\n"
+":Inputs:\n"
+"    *target*: ``None`` | :class:`str` | :class:`file` | :class:`int`\n"
+"        Output file name, open file, or descriptor\n"
+"    *fmt*: ``\"ascii\"`` | ``\"lb8\"`` | ``\"b4\"`` | ``\"lr8\"`` | ...\n"
+"        File format\n"
+"    *D*: :class:`dict`\\ [:class:`numpy.ndarray`]\n"
+"        Array for each section, with the names used by\n"
+"        :func:`ReadUGrid`\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+#endif  // _CAPE_UGRID_H
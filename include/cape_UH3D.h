@@ -0,0 +1,59 @@
+#ifndef _CAPE_UH3D_H
+#define _CAPE_UH3D_H
+
+PyObject *
+cape_ReadUH3D(PyObject *self, PyObject *args);
+char doc_ReadUH3D[] =
+"Read nodes, tris, component IDs, and component names of a UH3D file\n"
+"\n"
+"The arrays are allocated from the counts on the second line, and the\n"
+"nodes and tris are then parsed in a single pass without the GIL.  The\n"
+"component names are read with the same rules as\n"
+":func:`cape.trifile.Tri.ReadUH3DCompIDList`.\n"
+"\n"
+":Call:\n"
+"    >>> P, T, C, conf = _cape.ReadUH3D(fname)\n"
+":Inputs:\n"
+"    *fname*: :class:`str`\n"
+"        Name of file to read\n"
+":Outputs:\n"
+"    *P*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, 3)\n"
+"        Matrix of nodal coordinates\n"
+"    *T*: :class:`numpy.ndarray` (:class:`int32`) (*nTri*, 3)\n"
+"        Matrix of 1-based nodal indices for each triangle\n"
+"    *C*: :class:`numpy.ndarray` (:class:`int32`) (*nTri*)\n"
+"        Vector of component IDs\n"
+"    *conf*: :class:`dict`\\ [:class:`int` | :class:`list`]\n"
+"        Component ID (or list of IDs) for each component name\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+PyObject *
+cape_WriteUH3D(PyObject *self, PyObject *args);
+char doc_WriteUH3D[] =
+"Write a triangulation to a UH3D file\n"
+"\n"
+"The output matches :func:`cape.trifile.Tri.WriteUH3DSlow`.  The caller\n"
+"is responsible for numbering the components ``1`` to *nID*.\n"
+"\n"
+":Call:\n"
+"    >>> _cape.WriteUH3D(P, T, C, labels, f=None)\n"
+":Inputs:\n"
+"    *P*: :class:`numpy.ndarray` (:class:`float`) (*nNode*, 3)\n"
+"        Matrix of nodal coordinates\n"
+"    *T*: :class:`numpy.ndarray` (:class:`int`) (*nTri*, 3)\n"
+"        Matrix of of nodal indices for each triangle\n"
+"    *C*: :class:`numpy.ndarray` (:class:`int`) (*nTri*)\n"
+"        Vector of component IDs, from ``1`` to *nID*\n"
+"    *labels*: :class:`list`\\ [:class:`str`]\n"
+"        Name of each component, in order\n"
+"    *f*: {``None``} | :class:`str` | :class:`file` | :class:`bytearray`\n"
+"        Output file name, open file, file descriptor, or writable buffer\n"
+"        (``bytearray`` is appended to); default ``Components.i.uh3d``\n"
+":Outputs:\n"
+"    *n*: ``None`` | :class:`int`\n"
+"        Number of bytes written if *f* is a fixed-size buffer\n"
+":Versions:\n"
+"    * 2026-10-14 ``@ddalle``: v1.0\n";
+
+#endif  // _CAPE_UH3D_H
@@ -0,0 +1,104 @@
+/*!
+  \file capec_BVH.h
+  \brief Bounding volume hierarchy of tris for CAPE C extension
+
+  This file contains functions to build a tree of axis-aligned bounding
+  boxes around the tris of a triangulation and to use it to find the
+  nearest tri to each of many points.  Each query can also find the nearest
+  tri outside the components already found, which is how points are
+  matched to up to four nearby components.  A tree keeps its own copy of
+  the tri vertices, so it stays valid after the input arrays are released.
+  These functions do not use the Python API and may be called with the GIL
+  released.
+*/
+#ifndef _CAPEC_BVH_H
+#define _CAPEC_BVH_H
+
+#include <stddef.h>
+
+
+//! Largest number of tris in a leaf of the tree
+#define capeBVH_LEAF 4
+
+//! Largest number of components found for each point
+#define capeBVH_NCOMP 4
+
+//! Smallest number of points given to one thread
+#define capeBVH_CHUNKMIN 512
+
+//! Status codes of tree functions
+enum capecBVH_STATUS {
+    capeBVH_OK,             //!< Success
+    capeBVH_ERR_INDEX,      //!< Node index out of range
+    capeBVH_ERR_MEM         //!< Failed to allocate tree
+};
+
+//! One box of the tree
+typedef struct {
+    double lo[3];           //!< Minimum coordinates of box
+    double hi[3];           //!< Maximum coordinates of box
+    int left;               //!< First child (branch) or first tri (leaf)
+    int count;              //!< Number of tris (leaf) or 0 (branch)
+    int comp;               //!< Component ID, if all tris have the same one
+    int mixed;              //!< Whether tris of box have several comp IDs
+} capecBVHNode;
+
+//! Tree of bounding boxes; tris are stored in tree order
+typedef struct {
+    capecBVHNode *nodes;    //!< Boxes; children of a branch are adjacent
+    size_t nnode;           //!< Number of boxes
+    double *X;              //!< Vertex coordinates of each tri (ntri x 9)
+    int *C;                 //!< Component ID of each tri
+    int *K;                 //!< Original (0-based) index of each tri
+    size_t ntri;            //!< Number of tris
+} capecBVH;
+
+//! Outputs of :c:func:`capec_BVHNearest`, each (nPt x ncomp)
+typedef struct {
+    int *K;                 //!< Index of tri, or -1 if none found
+    int *C;                 //!< Component ID of tri, or 0 if none found
+    double *D;              //!< Distance from point to tri
+    double *Z;              //!< Distance from point to plane of tri
+    double *T;              //!< Distance within plane of tri
+} capecBVHHits;
+
+
+//! \brief Build a tree of the tris of a triangulation
+//!
+//! Boxes are split at the median tri center along their longest axis.
+//! On failure *b* is left empty.
+//!
+//! \return Status code, see :c:type:`capecBVH_STATUS`
+int
+capec_BVHBuild(
+    capecBVH *b,            //!< Tree to initialize
+    const double *P,        //!< Node coordinates (nNode x 3)
+    size_t nNode,           //!< Number of nodes
+    const int *T,           //!< Tri node indices, 1-based (nTri x 3)
+    const int *C,           //!< Component ID of each tri (nTri)
+    size_t nTri             //!< Number of tris
+    );
+
+//! \brief Release memory of a tree
+void
+capec_BVHFree(
+    capecBVH *b             //!< Tree to clear
+    );
+
+//! \brief Find nearest tris to each of several points
+//!
+//! Column *j* of each output is the nearest tri whose component ID is
+//! different from those in columns 0 to *j*-1 for the same point.
+//!
+//! \return Status code, see :c:type:`capecBVH_STATUS`
+int
+capec_BVHNearest(
+    const capecBVH *b,      //!< Tree of tris
+    const double *X,        //!< Coordinates of points (nPt x 3)
+    size_t nPt,             //!< Number of points
+    int ncomp,              //!< Number of components, 1 to capeBVH_NCOMP
+    capecBVHHits *h,        //!< Outputs
+    int nthread             //!< Max number of threads (0 for all CPUs)
+    );
+
+#endif  // _CAPEC_BVH_H
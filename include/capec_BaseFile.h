@@ -1,7 +1,7 @@
 /*!
   \file capec_BaseFile.h
   \brief Key file-reading utilities for CAPE C extension
-  
+
   This file contains functions that perform basic tasks of reading text files
   for the extension module for CAPE.
 */
@@ -44,6 +44,18 @@ static char *capeDTYPE_NAMES[capeDTYPE_Last] = {
     "str"
 };
 
+//! Initial number of rows allocated for each column by single-pass readers
+#define capeFILE_NROW0 1024
+
+//! Function to split one line of text and save values to each column
+typedef int (*capeFILE_LineReader)(
+    char *line,             //!< Text of line (null-terminated)
+    void **coldata,         //!< Pointer to data (list or C array) by column
+    int *DTYPES,            //!< Data type index for each column
+    size_t ncol,            //!< Number of columns
+    size_t irow             //!< Row index to save data to
+    );
+
 
 //! \brief Advance file to end of current line
 void
@@ -72,6 +84,14 @@ int capec_AddDTypes(
     PyObject *m      //!< Handle to module to which DTYPEs are added
     );
 
+//! \brief Get NumPy type number for a data type code
+//!
+//! \return NumPy type number, or -1 if column is not a NumPy array
+int
+capeFILE_TypeNum(
+    int dtype              //!< Data type index
+    );
+
 //! \brief Allocate a column's 1D array according to size and data type
 //!
 //! \return Python array or list
@@ -81,4 +101,115 @@ capeFILE_NewCol1D(
     size_t n               //!< Length of array/list
     );
 
-#endif
\ No newline at end of file
+//! \brief Get C file handle at current position of Python file object
+//!
+//! The handle uses a duplicate of the file descriptor, which shares its
+//! offset with *f*.  It must be released with :func:`capeFILE_ClosePyFile`
+//! so that the Python file object's own position stays consistent.
+//!
+//! \return File handle, or ``NULL`` on failure
+FILE *
+capeFILE_FromPyFile(
+    PyObject *f,            //!< Python file object
+    off_t *pos0             //!< OS offset of descriptor before call (output)
+    );
+
+//! \brief Close handle from :func:`capeFILE_FromPyFile`
+//!
+//! The shared descriptor offset is restored to *pos0*.  If *atend* is set,
+//! the Python file is then moved to the end, marking the data as consumed.
+//!
+//! \return Error flag (0 for ok)
+int
+capeFILE_ClosePyFile(
+    PyObject *f,            //!< Python file object
+    FILE *fp,               //!< C file handle to close
+    off_t pos0,             //!< Original OS offset
+    int atend               //!< Whether to seek *f* to end of file
+    );
+
+//! \brief Check *db.cols* and read data type codes from *db._c_dtypes*
+//!
+//! \return Error flag (0 for ok)
+int
+capeFILE_GetDTypes(
+    PyObject *db,           //!< Data file interface (``dict`` subclass)
+    Py_ssize_t *ncol,       //!< Number of columns (output)
+    int **DTYPES            //!< New array of type codes (output)
+    );
+
+//! \brief Create each column of *db* and save pointer to its data
+//!
+//! \return Error flag (0 for ok)
+int
+capeFILE_InitCols(
+    PyObject *db,           //!< Data file interface (``dict`` subclass)
+    Py_ssize_t ncol,        //!< Number of columns
+    int *DTYPES,            //!< Type code for each column
+    size_t nrow,            //!< Number of rows to allocate
+    void **coldata          //!< List or data pointer for each col (output)
+    );
+
+//! \brief Change number of rows of each column created by
+//! :func:`capeFILE_InitCols`
+//!
+//! Arrays are reallocated (so *coldata* is updated), and lists are padded
+//! with ``None`` or truncated.
+//!
+//! \return Error flag (0 for ok)
+int
+capeFILE_ResizeCols(
+    PyObject *db,           //!< Data file interface (``dict`` subclass)
+    Py_ssize_t ncol,        //!< Number of columns
+    size_t nrow,            //!< New number of rows
+    void **coldata          //!< List or data pointer for each col (updated)
+    );
+
+//! \brief Add rows to end of existing columns of *db*
+//!
+//! Each array column is replaced (in *db*) by a view of the first *nrow*
+//! entries of a buffer with spare capacity, which grows geometrically, so
+//! repeated extensions only copy existing data occasionally.  Existing
+//! references to the old arrays remain valid.  String columns must be lists,
+//! which are padded with ``None``.
+//!
+//! \return 0 for ok, -1 if columns don't match *DTYPES* or *nrow0* (no
+//! exception set), otherwise error flag
+int
+capeFILE_ExtendCols(
+    PyObject *db,           //!< Data file interface (``dict`` subclass)
+    Py_ssize_t ncol,        //!< Number of columns
+    int *DTYPES,            //!< Type code for each column
+    size_t nrow0,           //!< Current number of rows
+    size_t nrow,            //!< New number of rows
+    void **coldata          //!< List or data pointer for each col (output)
+    );
+
+//! \brief Convert one null-terminated text field and save it to a column
+//!
+//! The entire field must be consumed by the conversion.
+//!
+//! \return Error flag (0 for ok)
+int
+capeFILE_FromText(
+    const char *s,          //!< Text of field
+    void *coldata,          //!< Pointer to data (list or C array)
+    int dtype,              //!< Column data type index
+    size_t irow             //!< Row index to save value to
+    );
+
+//! \brief Read data lines of an open file into columns of *db*
+//!
+//! The file is read in large blocks in a single pass; columns start with
+//! :c:macro:`capeFILE_NROW0` rows and double in size as needed, then are
+//! trimmed to the number of rows read.  *f* is left at end of file.
+//!
+//! \return Error flag (0 for ok)
+int
+capeFILE_ReadData(
+    PyObject *db,           //!< Data file interface (``dict`` subclass)
+    PyObject *f,            //!< Python file object
+    capeFILE_LineReader readline    //!< Function to parse each line
+    );
+
+#endif
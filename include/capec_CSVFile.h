@@ -8,11 +8,51 @@
 #ifndef _CAPEC_CSVFILE_H
 #define _CAPEC_CSVFILE_H
 
+#include <stdint.h>
+
 
 
 //! Default type for CSV column
 #define capeCSV_DEFAULT_TYPE "float64"
 
+//! Smallest amount of data (bytes) given to each thread
+#define capeCSV_CHUNKMIN (1 << 20)
+
+//! Number of bytes before saved offset checked by incremental reads
+#define capeCSV_TAILSIZE 64
+
+
+//! Location of a string entry within a line
+typedef struct {
+    const char *s;      //!< Start of entry
+    size_t n;           //!< Length of entry
+} capecCSVSpan;
+
+//! Kinds of errors while parsing a line
+enum capeCSV_ERR_TYPES {
+    capeCSV_ERR_READ = 1,   //!< Entry could not be converted
+    capeCSV_ERR_PAST,       //!< Too many entries on line
+    capeCSV_ERR_SEP,        //!< Missing comma (too few entries)
+    capeCSV_ERR_TYPE        //!< Data type not supported
+};
+
+//! Description of an error while parsing a line
+typedef struct {
+    int kind;           //!< Error type, see :c:type:`capeCSV_ERR_TYPES`
+    int dtype;          //!< Data type of entry, if relevant
+    int jcol;           //!< Column index, if relevant
+    char c;             //!< Character found instead of separator
+    size_t irow;        //!< Data row index
+} capecCSVErr;
+
+
+//! Saved position of an incremental (tail) read
+typedef struct {
+    size_t offset;      //!< Number of bytes already read (just after ``\n``)
+    size_t nrow;        //!< Number of data rows already read
+    uint64_t hash;      //!< Hash of :c:macro:`capeCSV_TAILSIZE` bytes before
+} capecCSVTail;
+
 
 //! \brief Count data lines remaining in CSV file
 //!
@@ -22,14 +62,109 @@ capec_CSVFileCountLines(
     FILE *fp //!< File handle
     );
 
-//! \brief Read next entry of file
+//! \brief Read next entry of a line
 //!
 //! \return Error indicator
 int capeCSV_ReadNext(
-    FILE *fp,           //!< File handle
+    char **s,           //!< Position in line (advanced past entry)
     void *coldata,      //!< Pointer to data (list or C array)
     int dtype,          //!< Column data type index
     size_t irow         //!< Row index to read data to
     );
 
-#endif
\ No newline at end of file
+//! \brief Read next numeric entry of a line without using Python API
+//!
+//! Safe to call without holding the GIL.
+//!
+//! \return Error indicator
+int capeCSV_ScanNext(
+    char **s,           //!< Position in line (advanced past entry)
+    void *coldata,      //!< Pointer to C array
+    int dtype,          //!< Column data type index (not string)
+    size_t irow         //!< Row index to read data to
+    );
+
+//! \brief Parse one line of CSV file without using Python API
+//!
+//! Numeric entries are saved to their columns; the locations of string
+//! entries are saved to *spans* (one per string column) for conversion
+//! later.  The line may end with either ``'\0'`` or ``'\n'``.  Safe to call
+//! without holding the GIL.
+//!
+//! \return -1 for blank/comment line, 0 for data row, else error indicator
+int capeCSV_ScanLine(
+    char *line,         //!< Text of line
+    void **coldata,     //!< Pointer to data (list or C array) by column
+    int *DTYPES,        //!< Data type index for each column
+    size_t ncol,        //!< Number of columns
+    size_t irow,        //!< Row index to save data to
+    capecCSVSpan *spans,    //!< Locations of string entries (output)
+    capecCSVErr *err    //!< Error description (output)
+    );
+
+//! \brief Set Python exception from description of parse error
+void capeCSV_SetError(
+    const capecCSVErr *err  //!< Error description
+    );
+
+//! \brief Split one line of CSV file and save each entry to its column
+//!
+//! \return -1 for blank/comment line, 0 for data row, else error indicator
+int capeCSV_ReadLine(
+    char *line,         //!< Text of line (null-terminated)
+    void **coldata,     //!< Pointer to data (list or C array) by column
+    int *DTYPES,        //!< Data type index for each column
+    size_t ncol,        //!< Number of columns
+    size_t irow         //!< Row index to save data to
+    );
+
+//! \brief Read data portion of CSV file using multiple threads
+//!
+//! The rest of the file is mapped into memory and split into newline-aligned
+//! chunks.  Rows in each chunk are counted and then parsed in parallel with
+//! the GIL released, writing directly into the final columns; strings are
+//! created afterwards in a serial pass.  Files smaller than two chunks of
+//! :c:macro:`capeCSV_CHUNKMIN` bytes are read serially.
+//!
+//! \return Error flag (0 for ok)
+int capeCSV_ReadDataThreads(
+    PyObject *db,       //!< Data file interface (``dict`` subclass)
+    PyObject *f,        //!< Python file object
+    int nthread         //!< Number of threads (0 for one per processor)
+    );
+
+//! \brief Hash of the bytes just before a position in a file's text
+//!
+//! \return FNV-1a hash of up to :c:macro:`capeCSV_TAILSIZE` bytes
+uint64_t capeCSV_TailHash(
+    const char *data,   //!< Start of file text
+    size_t offset       //!< Position just after the bytes to hash
+    );
+
+//! \brief Create incremental read state for a file that was just read
+//!
+//! \return 0 for ok, -1 if *offset* is not just after a newline, else error
+int capeCSV_TailState(
+    const char *fname,  //!< Name of CSV file
+    capecCSVTail *st    //!< State with *offset* and *nrow* set (hash output)
+    );
+
+//! \brief Read rows appended to CSV file since a previous read
+//!
+//! Checks that the file is still at least *st->offset* bytes long, that the
+//! bytes before that position are unchanged, and that each column of *db*
+//! still has *st->nrow* rows.  Then only the complete lines after the saved
+//! position are parsed and added to the existing columns using
+//! :c:func:`capeFILE_ExtendCols`.  A final line without a newline is left
+//! for the next call.  On success, *st* is updated.
+//!
+//! \return 0 for ok, -1 if file was truncated or rewritten or *db* was
+//! changed (no exception set, *db* not modified), else error flag (columns
+//! may have been partially extended)
+int capeCSV_ReadTail(
+    PyObject *db,       //!< Data file interface (``dict`` subclass)
+    const char *fname,  //!< Name of CSV file
+    capecCSVTail *st    //!< Saved position (updated)
+    );
+
+#endif
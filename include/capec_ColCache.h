@@ -0,0 +1,127 @@
+/*!
+  \file capec_ColCache.h
+  \brief Binary columnar cache of data files for CAPE C extension
+
+  This file contains functions to write and check a binary "sidecar" file
+  that holds the columns already parsed from a text data file.  The cache
+  starts with a fixed-size header recording the size, modification time,
+  and a hash of the source file, followed by a table with the name, data
+  type code (see :c:type:`capeDTYPE_ENUM`), and location of each column.
+  Numeric columns are stored as raw native-order blocks, each aligned to
+  :c:macro:`capeCOLCACHE_ALIGN` bytes so that they can be used directly
+  from a memory mapping.  Strings are stored as *nrow* + 1 offsets into a
+  block of UTF-8 text.  These functions do not use the Python API and may
+  be called with the GIL released.
+*/
+#ifndef _CAPEC_COLCACHE_H
+#define _CAPEC_COLCACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+//! First eight bytes of cache file
+#define capeCOLCACHE_MAGIC "CAPECOL1"
+
+//! Version of cache file layout
+#define capeCOLCACHE_VERSION 1
+
+//! Byte-order mark, as written in native order
+#define capeCOLCACHE_BOM 0x01020304
+
+//! Alignment of each block (bytes)
+#define capeCOLCACHE_ALIGN 64
+
+//! Number of bytes at start and end of source file that are hashed
+#define capeCOLCACHE_HASHSIZE (1 << 16)
+
+//! Status codes of cache functions
+enum capecCOLCACHE_STATUS {
+    capeCOLCACHE_OK,        //!< Cache is valid (or was written)
+    capeCOLCACHE_STALE,     //!< Cache is for a different source file
+    capeCOLCACHE_BAD,       //!< Cache is truncated or malformed
+    capeCOLCACHE_ERR_IO,    //!< Failed to read or write a file
+    capeCOLCACHE_ERR_MEM    //!< Failed to allocate buffer
+};
+
+
+//! Signature of source file
+typedef struct {
+    uint64_t size;          //!< Size of file (bytes)
+    int64_t mtime;          //!< Modification time (ns since epoch)
+    uint64_t hash;          //!< FNV-1a hash of first and last bytes
+} capecColCacheSrc;
+
+//! Header of cache file (64 bytes)
+typedef struct {
+    char magic[8];          //!< :c:macro:`capeCOLCACHE_MAGIC`
+    uint32_t version;       //!< :c:macro:`capeCOLCACHE_VERSION`
+    uint32_t bom;           //!< :c:macro:`capeCOLCACHE_BOM`
+    capecColCacheSrc src;   //!< Signature of source file
+    uint64_t nrow;          //!< Number of rows
+    uint64_t ncol;          //!< Number of columns
+    uint64_t reserved;      //!< Unused; zero
+} capecColCacheHead;
+
+//! Entry in column table of cache file (48 bytes)
+typedef struct {
+    int32_t dtype;          //!< Data type code
+    uint32_t nname;         //!< Length of column name (bytes)
+    uint64_t name;          //!< Offset of column name
+    uint64_t data;          //!< Offset of values, or string offsets
+    uint64_t ndata;         //!< Size of values, or string offsets (bytes)
+    uint64_t blob;          //!< Offset of string text (strings only)
+    uint64_t nblob;         //!< Size of string text (bytes)
+} capecColCacheCol;
+
+//! Column to write to cache file
+typedef struct {
+    int dtype;              //!< Data type code
+    const char *name;       //!< Column name (need not be terminated)
+    size_t nname;           //!< Length of column name
+    const void *data;       //!< Values, or string offsets (``uint64_t``)
+    size_t ndata;           //!< Size of *data* (bytes)
+    const void *blob;       //!< String text, or ``NULL``
+    size_t nblob;           //!< Size of *blob* (bytes)
+} capecColCacheItem;
+
+
+//! \brief Get signature of a source file
+//!
+//! \return Status code, see :c:type:`capecCOLCACHE_STATUS`
+int
+capec_ColCacheSource(
+    const char *fname,      //!< Name of source file
+    capecColCacheSrc *src   //!< Signature (output)
+    );
+
+//! \brief Check header and column table of a mapped cache file
+//!
+//! Checks that every column's blocks lie within the file and that each
+//! column's first block is aligned.  Data type codes and the number of
+//! bytes of each column are left for the caller to check.
+//!
+//! \return Status code, see :c:type:`capecCOLCACHE_STATUS`
+int
+capec_ColCacheCheck(
+    const char *data,       //!< Start of mapped cache file
+    size_t size,            //!< Size of cache file
+    const capecColCacheSrc *src //!< Signature of current source file
+    );
+
+//! \brief Write cache file
+//!
+//! The file is written to a temporary name in the same folder and then
+//! renamed, so other processes never see a partial cache.
+//!
+//! \return Status code, see :c:type:`capecCOLCACHE_STATUS`
+int
+capec_ColCacheWrite(
+    const char *fname,      //!< Name of cache file
+    const capecColCacheSrc *src, //!< Signature of source file
+    size_t nrow,            //!< Number of rows
+    const capecColCacheItem *cols, //!< Columns to write
+    size_t ncol             //!< Number of columns
+    );
+
+#endif  // _CAPEC_COLCACHE_H
@@ -0,0 +1,112 @@
+/*!
+  \file capec_Fmt.h
+  \brief Buffered text formatting utilities for CAPE C extension
+
+  This file contains a block-buffered output writer and fixed-format number
+  formatters used by the ASCII writers.  Rows are rendered directly into a
+  large memory buffer which is passed to the file with a single ``fwrite()``
+  each time it fills up.  The formatters produce the same bytes as the
+  corresponding ``printf()`` conversions.
+*/
+#ifndef _CAPEC_FMT_H
+#define _CAPEC_FMT_H
+
+#include <stdio.h>
+
+
+//! Default size of text output buffer (bytes)
+#define capeFMT_BUFSIZE (1 << 20)
+
+//! Largest number of characters written by one number formatter
+#define capeFMT_MAXNUM 336
+
+
+//! Block-buffered text output
+typedef struct {
+    FILE *fid;          //!< File handle
+    char *buf;          //!< Pointer to start of buffer
+    size_t n;           //!< Number of bytes currently in buffer
+    size_t size;        //!< Total size of buffer
+    int ierr;           //!< Sticky error flag
+} capecFmtBuf;
+
+
+//! \brief Initialize buffered writer for an open file
+//!
+//! \return Error flag (0 for ok)
+int
+capec_FmtBufInit(
+    capecFmtBuf *b,         //!< Buffer to initialize
+    FILE *fid               //!< File handle
+    );
+
+//! \brief Write contents of buffer to file and reset it
+//!
+//! \return Error flag (0 for ok)
+int
+capec_FmtBufFlush(
+    capecFmtBuf *b          //!< Text buffer
+    );
+
+//! \brief Flush buffer and release its memory
+//!
+//! \return Error flag (0 for ok)
+int
+capec_FmtBufClose(
+    capecFmtBuf *b          //!< Text buffer
+    );
+
+//! \brief Get pointer to write at least *n* more bytes, flushing if needed
+//!
+//! \return Pointer to first free byte of buffer, or ``NULL`` on failure
+char *
+capec_FmtBufReserve(
+    capecFmtBuf *b,         //!< Text buffer
+    size_t n                //!< Number of bytes needed
+    );
+
+//! \brief Mark *n* bytes after current position as used
+#define capec_FmtBufCommit(b, m) ((b)->n += (m))
+
+
+//! \brief Write double in ``%.<prec>E`` or ``%+.<prec>E`` format
+//!
+//! \return Number of characters written (no terminating ``'\0'``)
+size_t
+capec_FmtE(
+    char *s,                //!< Output string (at least capeFMT_MAXNUM)
+    double x,               //!< Value to write
+    int prec,               //!< Digits after decimal point
+    int plus                //!< Whether to always include sign
+    );
+
+//! \brief Write double in ``%.<prec>f`` format
+//!
+//! \return Number of characters written (no terminating ``'\0'``)
+size_t
+capec_FmtF(
+    char *s,                //!< Output string (at least capeFMT_MAXNUM)
+    double x,               //!< Value to write
+    int prec                //!< Digits after decimal point
+    );
+
+//! \brief Write integer in ``%i`` format
+//!
+//! \return Number of characters written (no terminating ``'\0'``)
+size_t
+capec_FmtI(
+    char *s,                //!< Output string (at least 21 chars)
+    long v                  //!< Value to write
+    );
+
+//! \brief Write integer in ``%<width>i`` format (right-justified)
+//!
+//! \return Number of characters written (no terminating ``'\0'``)
+size_t
+capec_FmtIW(
+    char *s,                //!< Output string
+    long v,                 //!< Value to write
+    int width               //!< Minimum field width
+    );
+
+#endif  // _CAPEC_FMT_H
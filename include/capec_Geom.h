@@ -0,0 +1,114 @@
+/*!
+  \file capec_Geom.h
+  \brief Triangulation geometry kernels for CAPE C extension
+
+  This file contains functions that compute per-tri centers, area vectors,
+  unit normals, areas, and edge lengths; area-weighted node normals; and
+  per-component sums, each in a single pass over the tris.  Tris are
+  processed in blocks whose vertex coordinates are gathered into small
+  structure-of-arrays buffers so that the cross products can use SIMD
+  (AVX2 when available), and large meshes are split among threads.  These
+  functions do not use the Python API and may be called with the GIL
+  released.  Node indices in *T* are 1-based, as in TRI files.
+*/
+#ifndef _CAPEC_GEOM_H
+#define _CAPEC_GEOM_H
+
+#include <stddef.h>
+
+
+//! Number of tris per block of the geometry kernels
+#define capeGEOM_BLOCK 256
+
+//! Smallest number of tris given to one thread
+#define capeGEOM_CHUNKMIN 65536
+
+//! Number of values per component in :c:func:`capec_TriCompSums`
+#define capeGEOM_NCOMPSUM 8
+
+//! Status codes of geometry kernels
+enum capecGEOM_STATUS {
+    capeGEOM_OK,            //!< Success
+    capeGEOM_ERR_INDEX,     //!< Node index or component ID out of range
+    capeGEOM_ERR_MEM        //!< Failed to allocate work space
+};
+
+//! Outputs of :c:func:`capec_TriGeom`; any of them may be ``NULL``
+typedef struct {
+    double *centers;        //!< Center of each tri (nTri x 3)
+    double *normals;        //!< Unit normal of each tri (nTri x 3)
+    double *areas;          //!< Area of each tri (nTri)
+    double *areavecs;       //!< Area vector of each tri (nTri x 3)
+    double *lengths;        //!< Lengths of edges 0-1, 1-2, 2-0 (nTri x 3)
+} capecTriGeom;
+
+
+//! \brief Select fastest available kernels for this CPU
+void
+capec_GeomInit(void);
+
+//! \brief Get name of kernel family currently in use
+//!
+//! \return ``"avx2"`` or ``"scalar"``
+const char *
+capec_GeomKernelName(void);
+
+//! \brief Check that each node index of each tri is in 1..*nNode*
+//!
+//! \return Status code, see :c:type:`capecGEOM_STATUS`
+int
+capec_TriCheck(
+    const int *T,           //!< Tri node indices (nTri x 3)
+    size_t nTri,            //!< Number of tris
+    size_t nNode            //!< Number of nodes
+    );
+
+//! \brief Compute geometry of each tri in one pass
+//!
+//! Degenerate tris are treated like the NumPy versions in
+//! :mod:`cape.trifile`: the length of the cross product is limited to
+//! ``1e-10`` before computing the unit normal and area.
+//!
+//! \return Status code, see :c:type:`capecGEOM_STATUS`
+int
+capec_TriGeom(
+    const double *P,        //!< Node coordinates (nNode x 3)
+    const int *T,           //!< Tri node indices (nTri x 3), checked
+    size_t nTri,            //!< Number of tris
+    capecTriGeom *g,        //!< Output arrays
+    int nthread             //!< Max number of threads (0 for all CPUs)
+    );
+
+//! \brief Compute area-weighted unit normal at each node
+//!
+//! \return Status code, see :c:type:`capecGEOM_STATUS`
+int
+capec_TriNodeNormals(
+    const double *P,        //!< Node coordinates (nNode x 3)
+    size_t nNode,           //!< Number of nodes
+    const int *T,           //!< Tri node indices (nTri x 3), checked
+    size_t nTri,            //!< Number of tris
+    double *N,              //!< Output node normals (nNode x 3)
+    int nthread             //!< Max number of threads (0 for all CPUs)
+    );
+
+//! \brief Sum area, area vector, and first moment of area by component
+//!
+//! Row *j* of *S* is for component ``cmin + j`` and contains the total
+//! area, the three components of the area vector, the three components
+//! of the area-weighted sum of tri centers, and the number of tris.
+//!
+//! \return Status code, see :c:type:`capecGEOM_STATUS`
+int
+capec_TriCompSums(
+    const double *P,        //!< Node coordinates (nNode x 3)
+    const int *T,           //!< Tri node indices (nTri x 3), checked
+    const int *C,           //!< Component ID of each tri (nTri)
+    size_t nTri,            //!< Number of tris
+    int cmin,               //!< Smallest component ID
+    size_t ncomp,           //!< Number of rows of *S*
+    double *S,              //!< Output sums (ncomp x capeGEOM_NCOMPSUM)
+    int nthread             //!< Max number of threads (0 for all CPUs)
+    );
+
+#endif  // _CAPEC_GEOM_H
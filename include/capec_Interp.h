@@ -0,0 +1,151 @@
+/*!
+  \file capec_Interp.h
+  \brief Batch interpolation kernels for :mod:`cape.dkit.rdb`
+
+  This file contains functions that evaluate the ``"multilinear"`` and
+  ``"rbf"`` response methods of :class:`cape.dkit.rdb.DataKit` at many
+  points in one call.  Query points are processed in blocks: the break
+  point brackets of every point in a block are found with a search that
+  starts from the bracket of the previous point, and the squared distances
+  from one point to a block of RBF centers are accumulated one dimension
+  at a time in a contiguous buffer so that they can use SIMD (AVX2 when
+  available).  Large batches are split among threads.  These functions do
+  not use the Python API and may be called with the GIL released.
+*/
+#ifndef _CAPEC_INTERP_H
+#define _CAPEC_INTERP_H
+
+#include <stddef.h>
+
+
+//! Number of query points or RBF centers per block
+#define capeINTERP_BLOCK 256
+
+//! Smallest amount of work (points times cost per point) given to a thread
+#define capeINTERP_CHUNKMIN 65536
+
+//! Largest number of args for multilinear interpolation
+#define capeINTERP_MAXARG 16
+
+//! Extrapolation options of :c:func:`capec_Multilinear`
+enum capeINTERP_EXTRAP {
+    capeINTERP_ERROR,       //!< Points outside break points are an error
+    capeINTERP_HOLD,        //!< Use value at nearest break point
+    capeINTERP_LINEAR       //!< Extend first or last interval
+};
+
+//! Status codes of interpolation kernels
+enum capecINTERP_STATUS {
+    capeINTERP_OK,          //!< Success
+    capeINTERP_ERR_RANGE    //!< Point outside break points (no extrapolation)
+};
+
+//! Radial basis functions, in order of ``RBF_FUNCS`` in :mod:`rdb`
+enum capeRBF_FUNC {
+    capeRBF_MULTIQUADRIC,   //!< ``sqrt((r/eps)**2 + 1)``
+    capeRBF_INVERSE,        //!< ``1 / sqrt((r/eps)**2 + 1)``
+    capeRBF_GAUSSIAN,       //!< ``exp(-(r/eps)**2)``
+    capeRBF_LINEAR,         //!< ``r``
+    capeRBF_CUBIC,          //!< ``r**3``
+    capeRBF_QUINTIC,        //!< ``r**5``
+    capeRBF_THIN_PLATE,     //!< ``r**2 * log(r)``
+    capeRBF_NFUNC           //!< Number of functions
+};
+
+//! Names of radial basis functions, as in :class:`scipy.interpolate.Rbf`
+extern const char *capeRBF_NAMES[capeRBF_NFUNC];
+
+
+//! Regular table for multilinear interpolation
+typedef struct {
+    int nk;                 //!< Number of args
+    const double *bkpts[capeINTERP_MAXARG];  //!< Ascending break points
+    size_t nb[capeINTERP_MAXARG];            //!< Number of break points
+    const double *V;        //!< Values; first arg varies most slowly
+    int extrap;             //!< See :c:type:`capeINTERP_EXTRAP`
+    double tol;             //!< Tolerance at ends, relative to range
+} capecInterpTable;
+
+//! Stored coefficients of one radial basis function
+typedef struct {
+    int nd;                 //!< Number of args
+    size_t n;               //!< Number of centers
+    const double *xi;       //!< Centers, one row per arg (*nd* x *n*)
+    const double *nodes;    //!< Weight of each center (*n*)
+    int func;               //!< See :c:type:`capeRBF_FUNC`
+    double eps;             //!< Scale factor
+} capecRBF;
+
+
+//! \brief Select fastest available kernels for this CPU
+void
+capec_InterpInit(void);
+
+//! \brief Get name of kernel family currently in use
+//!
+//! \return ``"avx2"`` or ``"scalar"``
+const char *
+capec_InterpKernelName(void);
+
+//! \brief Get index of radial basis function from its name
+//!
+//! Also accepts the aliases ``"inverse"`` and ``"thin-plate"``.
+//!
+//! \return Index (see :c:type:`capeRBF_FUNC`), or ``-1`` if unknown
+int
+capec_RBFFunc(
+    const char *name        //!< Name of function
+    );
+
+//! \brief Find break point interval of each value
+//!
+//! Follows :func:`DataKit._bkpt_index`: *I[j]* is ``-1`` if ``x[j]`` is
+//! below the first break point by more than *tol* times the range and
+//! ``n-1`` if it is above the last one; otherwise it is the start of the
+//! interval containing ``x[j]``.  *F[j]* is the progress fraction within
+//! the first, last, or containing interval, respectively.
+//!
+//! \return Status code, see :c:type:`capecINTERP_STATUS`
+int
+capec_BkptIndex(
+    const double *V,        //!< Ascending break points
+    size_t n,               //!< Number of break points (at least 2)
+    const double *x,        //!< Values to look up
+    size_t nx,              //!< Number of values
+    double tol,             //!< Tolerance at ends, relative to range
+    long *I,                //!< Interval index of each value (output)
+    double *F               //!< Progress fraction of each value (output)
+    );
+
+//! \brief Multilinear interpolation at each of *nx* points
+//!
+//! Matches :func:`DataKit._rcall_multilinear` for 1D columns.  If *t* does
+//! not allow extrapolation, the index of the first point outside the break
+//! points is saved to *ibad*.
+//!
+//! \return Status code, see :c:type:`capecINTERP_STATUS`
+int
+capec_Multilinear(
+    const capecInterpTable *t,  //!< Break points, values, and options
+    const double **X,       //!< Values of each arg (*nk* arrays of *nx*)
+    size_t nx,              //!< Number of points
+    double *Y,              //!< Interpolated values (output)
+    size_t *ibad,           //!< First point out of range (output)
+    int nthread             //!< Max number of threads (0 for all CPUs)
+    );
+
+//! \brief Evaluate a radial basis function at each of *nx* points
+//!
+//! Matches :class:`scipy.interpolate.Rbf` with the Euclidean norm.
+//!
+//! \return Status code, see :c:type:`capecINTERP_STATUS`
+int
+capec_RBFEval(
+    const capecRBF *r,      //!< Centers, weights, and function
+    const double **X,       //!< Values of each arg (*nd* arrays of *nx*)
+    size_t nx,              //!< Number of points
+    double *Y,              //!< Values of RBF (output)
+    int nthread             //!< Max number of threads (0 for all CPUs)
+    );
+
+#endif  // _CAPEC_INTERP_H
@@ -0,0 +1,55 @@
+/*!
+  \file capec_LineLoad.h
+  \brief Sectional loads of annotated triangulations
+
+  This file contains functions that cut the tris of a TRIQ file into
+  slabs between planes normal to an axis and add the forces and moments
+  on each piece to the sums for its slab and component ID.  The forces on
+  each tri are the same as in :c:func:`capec_TriqTriForces` and are split
+  between slabs in proportion to the area of each piece, which acts at
+  the centroid of that piece.  The force on each slab is therefore exact
+  for a traction that is constant on each tri, and adding up the slabs
+  gives the same result as :c:func:`capec_TriqForces`.  These functions
+  do not use the Python API and may be called with the GIL released.
+*/
+#ifndef _CAPEC_LINELOAD_H
+#define _CAPEC_LINELOAD_H
+
+#include <stddef.h>
+
+#include "capec_TriqFM.h"
+
+
+//! Smallest number of tris given to one thread
+#define capeLINELOAD_CHUNKMIN 8192
+
+
+//! \brief Add forces and moments on each tri to sums for each slab
+//!
+//! Slab *k* is the part of the surface where the coordinate along *a*
+//! is between ``X[k]`` and ``X[k+1]``; parts of tris outside of all slabs
+//! are skipped.  Row ``j*nslab + k`` of *S* is for component
+//! ``cmin + j`` and slab *k*, using the columns of
+//! :c:type:`capeTRIQFM_COL`; the last column is the number of tris in
+//! the slab, counting the fraction of each tri that is cut.
+//!
+//! \return ``0`` on success, ``1`` if a component ID is out of range
+int
+capec_TriqLineLoads(
+    const double *P,        //!< Node coordinates (nNode x 3)
+    const int *T,           //!< Tri node indices (nTri x 3), checked
+    const double *Q,        //!< States at each node (nNode x nq)
+    int nq,                 //!< Number of states
+    const int *C,           //!< Component ID of each tri (nTri)
+    size_t nTri,            //!< Number of tris
+    int cmin,               //!< Smallest component ID
+    size_t ncomp,           //!< Number of components in *S*
+    const double *a,        //!< Unit vector along axis of cuts (3)
+    const double *X,        //!< Increasing slab boundaries (nslab + 1)
+    size_t nslab,           //!< Number of slabs
+    const capecTriqFMOpts *opts,    //!< Freestream state
+    double *S,              //!< Output sums (ncomp*nslab x NSUM)
+    int nthread             //!< Max number of threads (0 for all CPUs)
+    );
+
+#endif  // _CAPEC_LINELOAD_H
@@ -0,0 +1,91 @@
+/*!
+  \file capec_Map.h
+  \brief Memory-mapped input files for CAPE C extension
+
+  This file contains functions to map a whole file into memory and create
+  NumPy arrays from regions of that mapping.  Arrays are normally copied out
+  of the mapping, with byte-swapping done in the same pass.  Readers may
+  instead ask for views of regions that are already in native byte order and
+  suitably aligned; the mapping then stays alive as long as any such array
+  does.  Views are only safe while the file keeps its size: pages past the end
+  of a truncated file can't be read, so if the file is rewritten in place
+  (such as writing a triangulation back to the file it was read from) any
+  access to a view raises ``SIGBUS`` and kills the process.  Compressed files
+  are decompressed into an ordinary buffer that is used the same way.
+*/
+#ifndef _CAPEC_MAP_H
+#define _CAPEC_MAP_H
+
+#include <stddef.h>
+
+
+//! Memory-mapped file
+typedef struct {
+    char *data;         //!< Pointer to start of mapping
+    size_t size;        //!< Size of file (bytes)
+    int heap;           //!< Whether *data* is from ``malloc()`` instead
+} capecMap;
+
+
+//! \brief Map an entire file into memory (copy-on-write)
+//!
+//! Files whose names end with ``.gz`` or ``.zst`` are decompressed into
+//! memory instead (see :func:`capec_ZipInflate`), so callers see the same
+//! contents either way.  Sets a Python exception on failure.
+//!
+//! \return Error flag (0 for ok)
+int
+capec_MapOpen(
+    capecMap *m,            //!< Mapping to initialize
+    const char *fname       //!< Name of file to map
+    );
+
+//! \brief Map an entire open file into memory (copy-on-write)
+//!
+//! The descriptor may be closed afterwards.  Sets a Python exception on
+//! failure.
+//!
+//! \return Error flag (0 for ok)
+int
+capec_MapOpenFD(
+    capecMap *m,            //!< Mapping to initialize
+    int fd                  //!< File descriptor, open for reading
+    );
+
+//! \brief Release a mapping
+void
+capec_MapClose(
+    capecMap *m             //!< Mapping to close
+    );
+
+//! \brief Transfer ownership of a mapping to a Python capsule
+//!
+//! The mapping is released when the capsule is destroyed.  On failure the
+//! mapping is released immediately and ``NULL`` is returned.
+//!
+//! \return New reference to capsule, or ``NULL``
+PyObject *
+capec_MapCapsule(
+    capecMap *m             //!< Mapping (cleared on return)
+    );
+
+//! \brief Create array from region of a mapping
+//!
+//! The result is a (writable, copy-on-write) view into the mapping if
+//! *base* is not ``NULL``, no swap is needed, and *data* is aligned for
+//! *typenum*; otherwise the region is copied into a new array.  Readers pass
+//! ``NULL`` unless their caller asked for views, which are invalid once the
+//! file is truncated (see above).
+//!
+//! \return New reference to array, or ``NULL``
+PyObject *
+capec_MapArray(
+    PyObject *base,         //!< Capsule owning the mapping, or ``NULL``
+    char *data,             //!< Pointer to start of region
+    int nd,                 //!< Number of dimensions
+    npy_intp *dims,         //!< Dimensions
+    int typenum,            //!< NumPy data type (4- or 8-byte numbers)
+    int swap                //!< Whether data must be byte-swapped
+    );
+
+#endif  // _CAPEC_MAP_H
@@ -1,6 +1,44 @@
+/*!
+  \file capec_Memory.h
+  \brief Memory allocation tools for CAPE C extension
+
+  In addition to simple wrappers for :func:`malloc`, this file provides
+  three tools for memory that is reused many times.  Aligned allocations
+  start on a :c:macro:`capeMEM_ALIGN`-byte boundary, which suits SIMD
+  loads and stores.  Each thread has a pool of large buffers that are kept
+  after :c:func:`capec_PoolDel` so that the next call (e.g. the next file
+  in a batch script) can reuse them without going back to the heap.  An
+  arena collects many per-call temporaries in pooled blocks using bump
+  allocation; they are all released at once by :c:func:`capec_ArenaDel`.
+  None of these use the Python API, so they may be called with the GIL
+  released.
+*/
 #ifndef _CAPEC_MEMORY_H
 #define _CAPEC_MEMORY_H
 
+#include <stddef.h>
+
+//! Alignment of aligned, pooled, and arena allocations (bytes)
+#define capeMEM_ALIGN 64
+
+//! Minimum size of a pooled buffer (bytes)
+#define capeMEM_BLOCKSIZE (1 << 16)
+
+//! Maximum number of bytes kept in each thread's pool
+#define capeMEM_POOLMAX (1 << 26)
+
+//! Maximum number of buffers kept in each thread's pool
+#define capeMEM_POOLNUM 16
+
+//! Arena of per-call temporaries; initialize with :c:macro:`capeARENA_INIT`
+typedef struct {
+    struct capecMemBlock *head;     //!< Most recent block
+    size_t blocksize;               //!< Minimum size of each block
+} capecArena;
+
+//! Initial value of an empty arena
+#define capeARENA_INIT {NULL, capeMEM_BLOCKSIZE}
+
 //! Allocate 1D array
 int
 capec_New1D(
@@ -25,6 +63,50 @@ capec_Del1D(void *A);
 void
 capec_Del2D(void **A);
 
+//! Allocate 1D array aligned to :c:macro:`capeMEM_ALIGN` bytes
+int
+capec_NewAligned(
+    void **A,             //!< Pointer to pointer to allocated array
+    size_t n,             //!< Length to allocate
+    size_t size           //!< Width (bytes) for each entry
+    );
+
+// Deallocate array from :c:func:`capec_NewAligned`
+void
+capec_DelAligned(void *A);
+
+//! \brief Get aligned buffer of at least *n* bytes from this thread's pool
+//!
+//! \return Pointer to buffer, or ``NULL`` on failure
+void *
+capec_PoolNew(size_t n);
+
+//! \brief Return buffer from :c:func:`capec_PoolNew` to this thread's pool
+//!
+//! The buffer may be returned from a different thread than the one that
+//! allocated it.
+void
+capec_PoolDel(void *A);
+
+// Free all buffers kept in this thread's pool
+void
+capec_PoolClear(void);
+
+//! \brief Allocate *n* entries of *size* bytes from an arena
+//!
+//! \return Aligned pointer valid until :c:func:`capec_ArenaDel`, or
+//! ``NULL`` on failure
+void *
+capec_ArenaNew(
+    capecArena *a,        //!< Arena
+    size_t n,             //!< Length to allocate
+    size_t size           //!< Width (bytes) for each entry
+    );
+
+// Release everything allocated from an arena at once
+void
+capec_ArenaDel(capecArena *a);
+
 
 // Specific types
 #define capec_New2DDouble(A, n1, n2) \
@@ -28,4 +28,29 @@
 #define np1i(X, i) *((int *)    PyArray_GETPTR1(X, i))
 #define np1s(X, i) *((short *)  PyArray_GETPTR1(X, i))
 
+// Read one float32/float64 entry as double
+static inline double
+capec_npd(PyArrayObject *X, const void *p)
+{
+    if (PyArray_TYPE(X) == NPY_FLOAT)
+        return (double) *((const float *) p);
+    return *((const double *) p);
+}
+
+// Read one int32/int64 entry as long long
+static inline long long
+capec_npi(PyArrayObject *X, const void *p)
+{
+    if (PyArray_ITEMSIZE(X) == 8)
+        return (long long) *((const npy_int64 *) p);
+    return (long long) *((const npy_int32 *) p);
+}
+
+// Macros to extract data from arrays pinned by capec_PinView(), which may
+// be float32 or float64 (int32 or int64) with any strides
+#define np2dv(X, i, j) capec_npd(X, PyArray_GETPTR2(X, i, j))
+#define np2iv(X, i, j) ((long) capec_npi(X, PyArray_GETPTR2(X, i, j)))
+#define np1dv(X, i) capec_npd(X, PyArray_GETPTR1(X, i))
+#define np1iv(X, i) ((long) capec_npi(X, PyArray_GETPTR1(X, i)))
+
 #endif // _CAPEC_NUMPY_H
@@ -0,0 +1,165 @@
+/*!
+  \file capec_P3D.h
+  \brief Find and write grids of multiple-grid PLOT3D files
+
+  This file contains functions that index binary PLOT3D grid (``x``),
+  function (``f``), and OVERFLOW solution (``q``) files in any of the
+  usual layouts (stream or Fortran records, either byte order, 4- or
+  8-byte floats, single- or multiple-grid, with or without IBLANK).  The
+  header is read once, and the offset of each grid's data is computed from
+  the dimensions, so files can be mapped into memory and individual grids
+  used without reading the others.  Except for :c:func:`capec_ParseP3D`,
+  these functions do not use the Python API and may be called with the GIL
+  released.
+*/
+#ifndef _CAPEC_P3D_H
+#define _CAPEC_P3D_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+
+//! Kinds of PLOT3D files
+enum capeP3D_KIND {
+    capeP3D_X,              //!< Grid file: x, y, z [, iblank] of each grid
+    capeP3D_F,              //!< Function file: *nvar* values at each point
+    capeP3D_Q,              //!< OVERFLOW ``q`` file with per-grid headers
+    capeP3D_NKIND           //!< Number of kinds
+};
+
+//! Names of kinds of files (``"x"``, ``"f"``, ``"q"``)
+extern const char *capeP3D_KINDS[capeP3D_NKIND];
+
+//! Number of values in OVERFLOW ``q`` header before *RGAS*, incl. *IGAMMA*
+#define capeP3D_NQHEAD 11
+
+//! Index of *IGAMMA* (an integer in the file) in OVERFLOW ``q`` header
+#define capeP3D_IGAMMA 7
+
+
+//! Layout of a PLOT3D file
+typedef struct {
+    int kind;               //!< Kind of file, see :c:type:`capeP3D_KIND`
+    int record;             //!< Whether file has Fortran record markers
+    int swap;               //!< Whether file is in foreign byte order
+    int nf;                 //!< Bytes per float (4 or 8)
+    int multi;              //!< Whether file starts with number of grids
+    int iblank;             //!< Whether grids have IBLANK (grid files)
+    int nq;                 //!< Number of states (OVERFLOW ``q`` files)
+    int nqc;                //!< Number of species (OVERFLOW ``q`` files)
+    long ngrid;             //!< Number of grids
+    int *dims;              //!< *J*, *K*, *L* [, *nvar*] of each grid
+    size_t *offset;         //!< Offset to data of each grid
+    size_t *hoffset;        //!< Offset to header of each grid (``q`` files)
+} capecP3D;
+
+
+//! \brief Set format of PLOT3D layout from name such as ``"lr8"``
+//!
+//! Accepts ``"[l]{b|r}{4|8}"``.
+//!
+//! \return Error flag (0 for ok)
+int
+capec_P3DFormat(
+    capecP3D *g,            //!< Layout to set format of
+    const char *fmt         //!< Name of format
+    );
+
+//! \brief Get name of format of PLOT3D layout
+void
+capec_P3DFormatName(
+    const capecP3D *g,      //!< Layout
+    char *fmt               //!< Name, at least 4 characters (output)
+    );
+
+//! \brief Number of dimensions of each grid in header (3 or 4)
+int
+capec_P3DNDim(
+    const capecP3D *g       //!< Layout
+    );
+
+//! \brief Number of points in a grid
+size_t
+capec_P3DNPoint(
+    const capecP3D *g,      //!< Layout with dimensions
+    long i                  //!< Grid index (0-based)
+    );
+
+//! \brief Number of values at each point of a grid
+//!
+//! \return ``3`` for grid files, *nvar* for function files, and
+//!     *nq* + *nqc* for OVERFLOW ``q`` files
+int
+capec_P3DNVar(
+    const capecP3D *g,      //!< Layout with dimensions
+    long i                  //!< Grid index (0-based)
+    );
+
+//! \brief Number of values in each OVERFLOW ``q`` grid header
+//!
+//! \return ``capeP3D_NQHEAD + 3 + max(2, nqc)``, or ``0`` for other files
+int
+capec_P3DNHead(
+    const capecP3D *g       //!< Layout
+    );
+
+//! \brief Allocate dimensions and offsets for *g->ngrid* grids
+//!
+//! \return Error flag (0 for ok)
+int
+capec_P3DAlloc(
+    capecP3D *g             //!< Layout with *ngrid* set
+    );
+
+//! \brief Release dimensions and offsets of a layout
+void
+capec_P3DFree(
+    capecP3D *g             //!< Layout
+    );
+
+//! \brief Find the grids of a binary PLOT3D file
+//!
+//! If *fmt* is ``NULL``, each binary format is tried in turn and the first
+//! whose grids exactly fill the file is used; if none match, *g->ngrid* is
+//! ``0``.  Whether the file has a number-of-grids header and IBLANK is
+//! always detected.  Record markers are checked for every grid.  Sets a
+//! Python exception on failure.
+//!
+//! \return Error flag (0 for ok)
+int
+capec_ParseP3D(
+    const char *data,       //!< Contents of file
+    size_t size,            //!< Size of file (bytes)
+    int kind,               //!< Kind of file, see :c:type:`capeP3D_KIND`
+    const char *fmt,        //!< Format name, or ``NULL`` to detect
+    capecP3D *g             //!< Layout (output; free with capec_P3DFree)
+    );
+
+//! \brief Convert OVERFLOW ``q`` header of one grid to doubles
+void
+capec_P3DQHeader(
+    const capecP3D *g,      //!< Layout of mapped file
+    const char *data,       //!< Contents of file
+    long i,                 //!< Grid index (0-based)
+    double *h               //!< Header values (output, see capec_P3DNHead)
+    );
+
+//! \brief Write PLOT3D file in format of *g*
+//!
+//! ``G[i]`` must be pinned as ``NPY_DOUBLE`` arrays with the values of grid
+//! *i* (variable slowest, then *L*, *K*, *J*), and, if *g->iblank* is set,
+//! ``B[i]`` as ``NPY_INT`` arrays with one value per point.  For OVERFLOW
+//! ``q`` files, *h* has :c:func:`capec_P3DNHead` values for each grid.
+//!
+//! \return Status code, see :c:type:`capecIO_STATUS`
+int
+capec_WriteP3D(
+    FILE *fid,              //!< File handle
+    const capecP3D *g,      //!< Layout and format
+    PyArrayObject **G,      //!< Array for each grid
+    PyArrayObject **B,      //!< IBLANK for each grid, or ``NULL``
+    const double *h,        //!< OVERFLOW ``q`` headers, or ``NULL``
+    long *i                 //!< Grid being written (output, -1 for header)
+    );
+
+#endif  // _CAPEC_P3D_H
@@ -0,0 +1,88 @@
+/*!
+  \file capec_Pipe.h
+  \brief Pipelined (double-buffered) file output for CAPE C extension
+
+  This file contains functions to open a C stream whose writes are copied
+  into a ring of large buffers and passed to a helper thread that writes
+  them to the file.  The writer that formats or byte-swaps the data can
+  then fill buffer *N* + 1 while buffer *N* is being written.  Closing the
+  stream waits for everything to be written and can then call ``fsync()``
+  or drop the new pages from the page cache.  These functions do not use
+  the Python API and may be called with the GIL released.
+*/
+#ifndef _CAPEC_PIPE_H
+#define _CAPEC_PIPE_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+
+//! Default number of rotating buffers
+#define capePIPE_NBUF 3
+
+//! Default size of each buffer (bytes)
+#define capePIPE_BUFSIZE (1 << 22)
+
+//! What to do with file after all output is written
+enum capePIPE_SYNC {
+    capePIPE_NOSYNC,        //!< Nothing; leave it to the OS
+    capePIPE_FSYNC,         //!< ``fsync()``
+    capePIPE_DONTNEED       //!< Write back, then drop pages from cache
+};
+
+//! Options for pipelined output
+typedef struct {
+    int nbuf;               //!< Number of buffers; less than 2 to disable
+    size_t bufsize;         //!< Size of each buffer (bytes)
+    int sync;               //!< See :c:type:`capePIPE_SYNC`
+} capecPipeOpts;
+
+//! Write function of a custom stream; returns *n*, or -1 on failure
+typedef ssize_t (*capecPipeWriteFunc)(void *cookie, const char *buf, size_t n);
+
+//! Position function of a custom stream for ``ftell()``
+typedef off_t (*capecPipeTellFunc)(void *cookie);
+
+//! Close function of a custom stream; returns error flag (0 for ok)
+typedef int (*capecPipeCloseFunc)(void *cookie);
+
+
+//! \brief Open pipelined stream writing to a file descriptor
+//!
+//! The stream owns *fd* and closes it on ``fclose()``, which fails if any
+//! write failed.  Only writing and ``ftell()`` are supported.
+//!
+//! \return Stream, or ``NULL`` (*fd* is left open) on failure or if
+//!     custom streams are not available on this platform
+FILE *
+capec_PipeOpen(
+    int fd,                 //!< File descriptor, open for writing
+    const capecPipeOpts *o  //!< Options
+    );
+
+//! \brief Open write-only stream that calls custom functions
+//!
+//! Uses ``fopencookie()`` or ``funopen()``.  Closing the stream calls *c*
+//! once, which should release *cookie*.
+//!
+//! \return Stream, or ``NULL`` (*cookie* is not closed) on failure or if
+//!     custom streams are not available on this platform
+FILE *
+capec_PipeCustomOpen(
+    void *cookie,           //!< State passed to each function
+    capecPipeWriteFunc w,   //!< Called for writes
+    capecPipeTellFunc t,    //!< Called for ``ftell()``; may be ``NULL``
+    capecPipeCloseFunc c    //!< Called on ``fclose()``
+    );
+
+//! \brief Sync file that has been completely written
+//!
+//! \return Error flag (0 for ok)
+int
+capec_PipeSync(
+    int fd,                 //!< File descriptor
+    int sync                //!< See :c:type:`capePIPE_SYNC`
+    );
+
+#endif  // _CAPEC_PIPE_H
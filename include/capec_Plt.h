@@ -0,0 +1,172 @@
+/*!
+  \file capec_Plt.h
+  \brief Read and write Tecplot binary ``.plt`` files
+
+  This file contains functions that scan the header and zone data sections
+  of Tecplot (version 112) binary files with finite-element zones, convert
+  each zone's variable blocks into a point-by-variable array, and write
+  zones with the min/max of each variable computed while the data is
+  converted.  Files are mapped into memory, and offsets of every block are
+  found in a single scan of the file.  Except for :c:func:`capec_ParsePlt`,
+  these functions do not use the Python API and may be called with the GIL
+  released.
+*/
+#ifndef _CAPEC_PLT_H
+#define _CAPEC_PLT_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+
+//! Tecplot zone types
+enum capePLT_ZONETYPE {
+    capePLT_ORDERED,            //!< Structured (not supported)
+    capePLT_FELINESEG,          //!< Line segments
+    capePLT_FETRIANGLE,         //!< Triangles
+    capePLT_FEQUADRILATERAL,    //!< Quads (often tris with repeated node)
+    capePLT_FETETRAHEDRON,      //!< Tetrahedra
+    capePLT_FEBRICK,            //!< Hexahedra (or degenerate hexs)
+    capePLT_FEPOLYGON,          //!< Polygons (not supported)
+    capePLT_FEPOLYHEDRON        //!< Polyhedra (not supported)
+};
+
+//! Tecplot variable data formats
+enum capePLT_FORMAT {
+    capePLT_FLOAT = 1,          //!< 4-byte float
+    capePLT_DOUBLE,             //!< 8-byte float
+    capePLT_LONGINT,            //!< 4-byte int
+    capePLT_SHORTINT,           //!< 2-byte int
+    capePLT_BYTE,               //!< 1-byte unsigned int
+    capePLT_BIT                 //!< Packed bits (not supported)
+};
+
+//! Header marker before each zone (and each zone's data)
+#define capePLT_ZONEMARKER 299.0f
+//! Header marker at end of header
+#define capePLT_EOHMARKER 357.0f
+//! Header marker before dataset auxiliary data
+#define capePLT_DATAAUXMARKER 799.0f
+//! Header marker before variable auxiliary data
+#define capePLT_VARAUXMARKER 899.0f
+
+
+//! Location of each part of one zone
+typedef struct {
+    size_t name;            //!< Offset of zone name
+    size_t aux;             //!< Offset of first aux name/value pair
+    int naux;               //!< Number of aux name/value pairs
+    int parent;             //!< Parent zone
+    int strand;             //!< Strand ID
+    double time;            //!< Solution time
+    int type;               //!< Zone type, see :c:type:`capePLT_ZONETYPE`
+    long npt;               //!< Number of points
+    long nelem;             //!< Number of elements
+    int zshare;             //!< Zone that connectivity is shared with, or -1
+    size_t conn;            //!< Offset of connectivity
+} capecPltZone;
+
+//! Layout of a Tecplot binary file
+typedef struct {
+    int swap;               //!< Whether file is in foreign byte order
+    int nvar;               //!< Number of variables
+    long nzone;             //!< Number of zones
+    size_t title;           //!< Offset of title
+    size_t vars;            //!< Offset of first variable name
+    capecPltZone *zones;    //!< Each zone
+    int *fmt;               //!< Format of each variable of each zone
+    int *share;             //!< Zone each variable is shared with, or -1
+    size_t *offset;         //!< Offset of each variable; 0 if passive
+    size_t *minmax;         //!< Offset of min/max of each variable, or 0
+} capecPlt;
+
+
+//! \brief Number of nodes of each element of a zone type
+//!
+//! \return Nodes per element, or ``0`` for unsupported types
+int
+capec_PltNodesPerElem(
+    int type                //!< Zone type
+    );
+
+//! \brief Number of bytes of each value of a data format
+//!
+//! \return Bytes per value, or ``0`` for unsupported formats
+int
+capec_PltFormatSize(
+    int fmt                 //!< Data format
+    );
+
+//! \brief Read a Tecplot string (one 4-byte int per character)
+//!
+//! \return Number of characters before terminating zero, or
+//!     ``(size_t) -1`` if the file ends first
+size_t
+capec_PltString(
+    const char *data,       //!< Contents of file
+    size_t size,            //!< Size of file (bytes)
+    size_t i,               //!< Offset of string
+    int swap,               //!< Whether to byte-swap characters
+    unsigned *s             //!< Characters (output), or ``NULL``
+    );
+
+//! \brief Find the header and the blocks of each zone of a ``.plt`` file
+//!
+//! Shared variables and connectivity are resolved to the offsets of the
+//! zone they are shared with.  Sets a Python exception on failure.
+//!
+//! \return Error flag (0 for ok)
+int
+capec_ParsePlt(
+    const char *data,       //!< Contents of file
+    size_t size,            //!< Size of file (bytes)
+    capecPlt *p             //!< Layout (output; free with capec_PltFree)
+    );
+
+//! \brief Release zones and offsets of a layout
+void
+capec_PltFree(
+    capecPlt *p             //!< Layout
+    );
+
+//! \brief Check whether any variable of a zone is stored as a double
+//!
+//! \return ``1`` if point values need doubles to be exact, else ``0``
+int
+capec_PltZoneIsDouble(
+    const capecPlt *p,      //!< Layout
+    long j                  //!< Zone index
+    );
+
+//! \brief Convert variable blocks of one zone to point-by-variable array
+//!
+//! Passive variables are set to zero.
+void
+capec_ReadPltZone(
+    const capecPlt *p,      //!< Layout
+    const char *data,       //!< Contents of file
+    long j,                 //!< Zone index
+    void *q,                //!< Values, *npt* x *nvar* (output)
+    int fdouble,            //!< Whether *q* is ``double`` (else ``float``)
+    double *qminmax         //!< Min and max of each variable (output)
+    );
+
+//! \brief Write data section of one zone
+//!
+//! Each variable is converted to its format (``capePLT_FLOAT`` or
+//! ``capePLT_DOUBLE``) in a staging buffer, computing its min and max in
+//! the same pass, and then the min/max pairs, the variable blocks, and the
+//! connectivity are written.
+//!
+//! \return Status code, see :c:type:`capecIO_STATUS`
+int
+capec_WritePltZone(
+    FILE *fid,              //!< File handle
+    const double *q,        //!< Values, *npt* x *nvar*
+    size_t npt,             //!< Number of points
+    int nvar,               //!< Number of variables
+    const int *fmt,         //!< Format of each variable
+    const int *conn,        //!< Node indices (0-based) of each element
+    size_t nconn            //!< Total number of node indices
+    );
+
+#endif  // _CAPEC_PLT_H
@@ -0,0 +1,130 @@
+/*!
+  \file capec_Scan.h
+  \brief Buffered text input and number parsing utilities for CAPE C extension
+
+  This file contains a block-buffered line reader and locale-independent
+  number parsers for the text file readers.  The file is read in large
+  chunks and each line is returned as a null-terminated string pointing
+  directly into the buffer, so no per-field library calls are needed.  Most
+  floating-point values are converted exactly using only the digits and a
+  power of ten; rare long or extreme values fall back to ``strtod()``.
+*/
+#ifndef _CAPEC_SCAN_H
+#define _CAPEC_SCAN_H
+
+#include <stdio.h>
+
+
+//! Default size of text input buffer (bytes)
+#define capeSCAN_BUFSIZE (1 << 20)
+
+//! Check for whitespace within a line
+#define capeSCAN_IsSpace(c) ((c) == ' ' || (c) == '\t' || (c) == '\r')
+
+
+//! Block-buffered text input
+typedef struct {
+    FILE *fid;          //!< File handle
+    char *buf;          //!< Pointer to start of buffer
+    size_t n;           //!< Number of bytes currently in buffer
+    size_t i;           //!< Index of first unread byte
+    size_t size;        //!< Total size of buffer
+    int eof;            //!< Whether end of file has been reached
+    int ierr;           //!< Sticky error flag
+} capecScanBuf;
+
+
+//! \brief Initialize buffered reader for an open file
+//!
+//! \return Error flag (0 for ok)
+int
+capec_ScanBufInit(
+    capecScanBuf *b,        //!< Buffer to initialize
+    FILE *fid               //!< File handle
+    );
+
+//! \brief Get next line of file
+//!
+//! The newline is replaced by ``'\0'``.  The pointer remains valid until
+//! the next call.  Check *b->ierr* to distinguish errors from end of file.
+//!
+//! \return Pointer to start of line, or ``NULL`` at end of file
+char *
+capec_ScanBufLine(
+    capecScanBuf *b         //!< Text buffer
+    );
+
+//! \brief Release memory of buffered reader (does not close file)
+void
+capec_ScanBufClose(
+    capecScanBuf *b         //!< Text buffer
+    );
+
+//! \brief Count data lines remaining in file
+//!
+//! Blank lines and lines whose first non-blank character is ``#`` are not
+//! counted.  The file is returned to its original position.
+//!
+//! \return Number of data lines
+size_t
+capec_ScanCountLines(
+    FILE *fp                //!< File handle
+    );
+
+//! \brief Count data lines completed within a block of text
+//!
+//! *state* carries partial-line information between consecutive blocks; it
+//! should start at 0, and if it is 1 after the last block, the final line
+//! (with no newline) also contains data.
+//!
+//! \return Number of data lines ended by a newline in this block
+size_t
+capec_ScanCountBuf(
+    const char *s,          //!< Start of block
+    size_t n,               //!< Number of bytes in block
+    int *state              //!< Line state (updated)
+    );
+
+//! \brief Parse a double starting at *s*
+//!
+//! \return Error flag (0 for ok)
+int
+capec_ScanF64(
+    const char *s,          //!< Start of text
+    char **end,             //!< First character not used (output)
+    double *v               //!< Value (output)
+    );
+
+//! \brief Parse a single-precision float starting at *s*
+//!
+//! \return Error flag (0 for ok)
+int
+capec_ScanF32(
+    const char *s,          //!< Start of text
+    char **end,             //!< First character not used (output)
+    float *v                //!< Value (output)
+    );
+
+//! \brief Parse a signed base-10 integer starting at *s*
+//!
+//! \return Error flag (0 for ok, 1 for no digits, 2 for overflow)
+int
+capec_ScanI64(
+    const char *s,          //!< Start of text
+    char **end,             //!< First character not used (output)
+    long long *v            //!< Value (output)
+    );
+
+//! \brief Parse an unsigned base-10 integer starting at *s*
+//!
+//! A leading ``-`` is not accepted.
+//!
+//! \return Error flag (0 for ok, 1 for no digits, 2 for overflow)
+int
+capec_ScanU64(
+    const char *s,          //!< Start of text
+    char **end,             //!< First character not used (output)
+    unsigned long long *v   //!< Value (output)
+    );
+
+#endif  // _CAPEC_SCAN_H
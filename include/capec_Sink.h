@@ -0,0 +1,169 @@
+/*!
+  \file capec_Sink.h
+  \brief Output targets for CAPE C extension writers
+
+  This file contains functions to get a C stream for the output argument of
+  a writer, which may be a file name, an open Python file, a file
+  descriptor, or an in-memory buffer.  Writers can then use ``fprintf()``
+  and ``fwrite()`` regardless of where the bytes end up.  Output going to
+  memory (or to a Python file with no descriptor) is collected with
+  ``open_memstream()`` and copied to the target when the sink is closed.
+  Output to files can optionally be pipelined through a helper thread (see
+  :func:`capec_PipeOpen`), and a whole write can be run in the background
+  as a :c:type:`capecSinkJob`.  File names ending with ``.gz`` or ``.zst``
+  are compressed as they are written (see :func:`capec_ZipOpen`).
+*/
+#ifndef _CAPEC_SINK_H
+#define _CAPEC_SINK_H
+
+#include <stdio.h>
+#include <pthread.h>
+
+// Local includes
+#include "capec_Pipe.h"
+#include "capec_Stats.h"
+
+//! Name of capsules holding background writes
+#define capeSINK_JOBCAPSULE "cape._cape.WriteHandle"
+
+//! Maximum number of arrays held by a background write
+#define capeSINK_JOBARRAYS 4
+
+
+//! Kinds of output targets
+enum capeSINK_KIND {
+    capeSINK_PATH,          //!< File name (or default file name)
+    capeSINK_FD,            //!< File descriptor (``int``)
+    capeSINK_PYFILE,        //!< Python file with a descriptor
+    capeSINK_WRITE,         //!< Python object with ``write()`` method
+    capeSINK_BYTEARRAY,     //!< ``bytearray``, appended to
+    capeSINK_BUFFER         //!< Writable buffer, filled from the start
+};
+
+//! Output target of a writer
+typedef struct {
+    FILE *fp;               //!< Stream to write to
+    int kind;               //!< Type of target, see :c:type:`capeSINK_KIND`
+    PyObject *target;       //!< Python target (borrowed reference)
+    PyObject *path;         //!< Encoded file name, if any
+    const char *name;       //!< Description of target for messages
+    char *buf;              //!< Collected output for in-memory targets
+    size_t size;            //!< Size of collected output
+    long pos;               //!< Position of Python file, -1 if unknown
+    Py_ssize_t nbytes;      //!< Number of bytes copied to a buffer target
+    int sync;               //!< Sync on close, see :c:type:`capePIPE_SYNC`
+    int piped;              //!< Whether *fp* is a pipelined stream
+    int zip;                //!< Whether *fp* compresses its output
+    long start;             //!< Position of *fp* when opened, -1 if unknown
+    capecStat *stat;        //!< Counters charged for output, see
+                            //!< :func:`capec_StatCurrent`
+} capecSink;
+
+//! States of a background write
+enum capeSINK_JOBSTATE {
+    capeSINK_JOBNEW,        //!< Not started
+    capeSINK_JOBRUNNING,    //!< Running in its own thread
+    capeSINK_JOBFINISHED,   //!< Finished, but output not yet delivered
+    capeSINK_JOBDONE        //!< Output delivered (or not, on error)
+};
+
+//! Writer run in the background
+typedef struct capecSinkJob {
+    capecSink sink;         //!< Opened output target
+    PyObject *target;       //!< Python target (owned reference)
+    PyObject *A[capeSINK_JOBARRAYS]; //!< Pinned arrays (owned references)
+    int (*run)(struct capecSinkJob *); //!< Writer; may not use Python API
+    const char *what;       //!< Part being written, for messages
+    int ierr;               //!< Status returned by *run*
+    int state;              //!< See :c:type:`capeSINK_JOBSTATE`
+    pthread_t thread;       //!< Thread running *run*
+} capecSinkJob;
+
+
+//! \brief Open an output target
+//!
+//! *target* may be ``None`` (use *fdefault*), a file name (``str``,
+//! ``bytes``, or path-like), a file descriptor, an open Python file, any
+//! object with a ``write()`` method, a ``bytearray`` (new output is
+//! appended), or a writable buffer such as ``memoryview`` (filled from its
+//! start).  Sets a Python exception on failure.
+//!
+//! \return Error flag (0 for ok)
+int
+capec_SinkOpen(
+    capecSink *s,           //!< Sink to initialize
+    PyObject *target,       //!< Output target, or ``NULL`` for default
+    const char *fdefault,   //!< Default file name
+    const char *mode        //!< Mode for file names, e.g. ``"wb"``
+    );
+
+//! \brief Close an output target, copying in-memory output to it
+//!
+//! If *ierr* is nonzero, the stream is just released (a Python exception
+//! should already be set).  Otherwise the output is flushed and delivered,
+//! and the Python file (if any) is moved to the end of the new output.
+//!
+//! \return Error flag (0 for ok)
+int
+capec_SinkClose(
+    capecSink *s,           //!< Sink to close
+    int ierr                //!< Error flag from writing
+    );
+
+//! \brief Python return value of a writer after closing its sink
+//!
+//! \return Number of bytes written for buffer targets, else ``None``
+PyObject *
+capec_SinkResult(
+    capecSink *s            //!< Closed sink
+    );
+
+//! \brief Set pipelining and sync options for later file targets
+//!
+//! Applies to file names, file descriptors, and Python files opened after
+//! this call.  In-memory targets are never pipelined.
+void
+capec_SinkSetPipe(
+    const capecPipeOpts *o  //!< Options; *nbuf* < 2 disables pipelining
+    );
+
+//! \brief Allocate a background write with no target or arrays
+//!
+//! Sets a Python exception on failure.
+//!
+//! \return New job, or ``NULL``
+capecSinkJob *
+capec_SinkJobNew(void);
+
+//! \brief Start a background write and wrap it in a capsule
+//!
+//! *j* must have an open sink and a writer.  If no thread can be created,
+//! the writer is run in the calling thread (with the GIL released).  The
+//! capsule owns *j*; discarding it waits for the writer to finish.  On
+//! failure *j* is freed and a Python exception is set.
+//!
+//! \return New capsule, or ``NULL``
+PyObject *
+capec_SinkJobStart(
+    capecSinkJob *j         //!< Job to start
+    );
+
+//! \brief Wait for background writer to finish (releases the GIL)
+void
+capec_SinkJobJoin(
+    capecSinkJob *j         //!< Started job
+    );
+
+//! \brief Release the arrays of a background write
+void
+capec_SinkJobRelease(
+    capecSinkJob *j         //!< Finished (or unstarted) job
+    );
+
+//! \brief Release arrays, close sink (discarding errors), and free job
+void
+capec_SinkJobFree(
+    capecSinkJob *j         //!< Finished (or unstarted) job
+    );
+
+#endif  // _CAPEC_SINK_H
@@ -0,0 +1,94 @@
+/*!
+  \file capec_Stats.h
+  \brief Call, byte, and time counters of CAPE C extension functions
+
+  This file contains functions to keep running totals of the number of
+  calls, bytes read or written, and elapsed time of each function of
+  :mod:`cape._cape`.  Each counted call is bracketed by
+  :func:`capec_StatEnter` and :func:`capec_StatLeave`, which add one call
+  and the elapsed time to the counters of that function and make them the
+  *current* counters of the calling thread while it runs.  The lowest-level
+  file readers and writers (:func:`capec_MapOpen`, :func:`capec_ScanBufFill`,
+  and :func:`capec_SinkClose`) add the number of bytes they handle to the
+  current counters, so each function is charged for its own I/O without any
+  changes to the functions themselves.  Counters are updated with atomic
+  additions and may be read or reset at any time.  These functions do not
+  use the Python API.
+*/
+#ifndef _CAPEC_STATS_H
+#define _CAPEC_STATS_H
+
+#include <stddef.h>
+
+
+//! Counters of one extension function
+typedef struct {
+    const char *name;       //!< Name of function
+    unsigned long long calls;   //!< Number of calls
+    unsigned long long bytes;   //!< Bytes read or written (uncompressed)
+    unsigned long long ns;      //!< Time spent in function (nanoseconds)
+} capecStat;
+
+
+//! \brief Allocate zeroed counters for *n* functions
+//!
+//! \return ``0`` on success, ``1`` if out of memory
+int
+capec_StatInit(
+    int n                   //!< Number of functions
+    );
+
+//! \brief Set name of function *i*
+void
+capec_StatName(
+    int i,                  //!< Index of function
+    const char *name        //!< Name (not copied)
+    );
+
+//! \brief Start counting a call to function *i* in this thread
+//!
+//! Makes counters of *i* current for this thread.
+//!
+//! \return Previous current counters, to pass to :func:`capec_StatLeave`
+capecStat *
+capec_StatEnter(
+    int i,                  //!< Index of function
+    unsigned long long *t0  //!< Start time (output)
+    );
+
+//! \brief Finish counting a call to function *i*
+void
+capec_StatLeave(
+    int i,                  //!< Index of function
+    capecStat *prev,        //!< Output of :func:`capec_StatEnter`
+    unsigned long long t0   //!< Start time from :func:`capec_StatEnter`
+    );
+
+//! \brief Get counters of function running in this thread
+//!
+//! \return Pointer to counters, or ``NULL`` if none
+capecStat *
+capec_StatCurrent(void);
+
+//! \brief Add bytes read or written to a set of counters
+//!
+//! Does nothing if *st* is ``NULL``; does not use the Python API.
+void
+capec_StatAddBytes(
+    capecStat *st,          //!< Counters, see :func:`capec_StatCurrent`
+    size_t n                //!< Number of bytes
+    );
+
+//! \brief Get number of counted functions
+int
+capec_StatCount(void);
+
+//! \brief Get a copy of counters of function *i*, optionally zeroing them
+void
+capec_StatGet(
+    int i,                  //!< Index of function
+    capecStat *st,          //!< Copy of counters (output)
+    int reset               //!< Whether to zero the counters
+    );
+
+#endif  // _CAPEC_STATS_H
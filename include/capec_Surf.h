@@ -0,0 +1,162 @@
+/*!
+  \file capec_Surf.h
+  \brief Read and write AFLR3 ``.surf`` surface grids
+
+  This file contains functions that find the sections of binary AFLR3
+  surface files (stream or Fortran records, either byte order, 4- or
+  8-byte floats), parse ASCII surface files, and write the binary formats.
+  A surface file has a header with the number of tris, quads, and nodes
+  (in that order), one row per node with the coordinates followed by the
+  optional initial boundary layer spacing (*blds*) and boundary layer
+  thickness (*bldel*), one row per tri (three node indices, component ID,
+  reconnection flag, and boundary condition), and one row per quad (four
+  node indices and the same three flags).  Binary files are mapped into
+  memory and the number of node columns is found from the size of the
+  file, so each section can be viewed in place.  Except for
+  :c:func:`capec_ParseSurf`, these functions do not use the Python API
+  and may be called with the GIL released.
+*/
+#ifndef _CAPEC_SURF_H
+#define _CAPEC_SURF_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#include "capec_Scan.h"
+
+
+//! Sections of a surface file, in the order they are written
+enum capeSURF_SECTION {
+    capeSURF_HEADER,        //!< Counts of tris, quads, and nodes
+    capeSURF_NODES,         //!< Nodes, *blds*, and *bldel* (*nNode* x *ncol*)
+    capeSURF_TRIS,          //!< Tri indices and flags (*nTri* x 6)
+    capeSURF_QUADS,         //!< Quad indices and flags (*nQuad* x 7)
+    capeSURF_NSECTION       //!< Number of sections
+};
+
+//! Names of sections for messages
+extern const char *capeSURF_NAMES[capeSURF_NSECTION];
+
+//! Values per row of tri and quad sections
+#define capeSURF_NTRICOL 6
+#define capeSURF_NQUADCOL 7
+
+//! Status codes of ASCII surface reader
+enum capeSURF_STATUS {
+    capeSURF_OK,            //!< Success
+    capeSURF_ERR_EOF,       //!< File ended within a section
+    capeSURF_ERR_VALUE,     //!< Invalid number or wrong number of values
+    capeSURF_ERR_READ       //!< Failed to read from file
+};
+
+
+//! Layout of a surface file
+typedef struct {
+    int ascii;              //!< Whether file is text
+    int record;             //!< Whether sections have Fortran markers
+    int swap;               //!< Whether file is in foreign byte order
+    int nf;                 //!< Bytes per float (4 or 8)
+    int ncol;               //!< Values per node (3, 4, or 5)
+    long nNode;             //!< Number of nodes
+    long nTri;              //!< Number of tris
+    long nQuad;             //!< Number of quads
+    int nsection;           //!< Section being read, or last one read
+    size_t offset[capeSURF_NSECTION];  //!< Offset to data (binary)
+} capecSurf;
+
+
+//! \brief Set format of surface layout from name such as ``"lb8"``
+//!
+//! Accepts the same names as :c:func:`capec_UGridFormat`.
+//!
+//! \return Error flag (0 for ok)
+int
+capec_SurfFormat(
+    capecSurf *s,           //!< Layout to set format of
+    const char *fmt         //!< Name of format
+    );
+
+//! \brief Find sections of a binary surface file
+//!
+//! If *fmt* is ``NULL``, each binary format is tried in turn and the first
+//! whose sections exactly fill the file is used; if none match, the file
+//! is marked as ASCII and only *s->ascii* is set.  Sets a Python exception
+//! on failure.
+//!
+//! \return Error flag (0 for ok)
+int
+capec_ParseSurf(
+    const char *data,       //!< Contents of file
+    size_t size,            //!< Size of file (bytes)
+    const char *fmt,        //!< Format name, or ``NULL`` to detect
+    capecSurf *s            //!< Layout (output)
+    );
+
+//! \brief Read header of ASCII surface file and count node columns
+//!
+//! The header has either three counts (tris, quads, nodes) or the seven
+//! counts of a UGRID file (nodes, tris, quads, ...).  The number of values
+//! on the first node line sets *s->ncol*.
+//!
+//! \return Status code, see :c:type:`capeSURF_STATUS`
+int
+capec_ReadSurfHeader(
+    capecScanBuf *b,        //!< Text buffer at start of file
+    char **p,               //!< Read position within current line (output)
+    capecSurf *s            //!< Layout; sets counts and *ncol*
+    );
+
+//! \brief Read nodes, tris, and quads of ASCII surface file
+//!
+//! \return Status code, see :c:type:`capeSURF_STATUS`
+int
+capec_ReadSurfText(
+    capecScanBuf *b,        //!< Text buffer after header
+    char **p,               //!< Read position within current line
+    capecSurf *s,           //!< Layout from header
+    double *X,              //!< Nodes (*nNode* x *ncol*)
+    int *T,                 //!< Tris (*nTri* x 6)
+    int *Q                  //!< Quads (*nQuad* x 7)
+    );
+
+//! \brief Interleave nodes, *blds*, and *bldel* into one row per node
+//!
+//! \return Status code, see :c:type:`capecIO_STATUS`
+int
+capec_PackSurfNodes(
+    double *X,              //!< Output (*nNode* x 5)
+    PyArrayObject *P,       //!< Node coordinates (*nNode* x 3)
+    PyArrayObject *blds,    //!< Initial BL spacing at each node
+    PyArrayObject *bldel    //!< BL thickness at each node
+    );
+
+//! \brief Combine tri or quad indices, component IDs, and BCs into rows
+//!
+//! The reconnection flag is written as ``0``, as in
+//! :c:func:`capec_WriteSurfTris`.
+//!
+//! \return Status code, see :c:type:`capecIO_STATUS`
+int
+capec_PackSurfFaces(
+    int *F,                 //!< Output (*n* x (*nv* + 3))
+    int nv,                 //!< Nodes per face (3 or 4)
+    PyArrayObject *T,       //!< Node indices (*n* x *nv*)
+    PyArrayObject *C,       //!< Component ID of each face
+    PyArrayObject *BC       //!< Boundary condition of each face
+    );
+
+//! \brief Write binary surface file in format of *s*
+//!
+//! ``A[0]``, ``A[1]``, and ``A[2]`` are the packed nodes, tris, and quads
+//! (see :c:func:`capec_PackSurfNodes`), each written as one record.
+//!
+//! \return Status code, see :c:type:`capecIO_STATUS`
+int
+capec_WriteSurfBin(
+    FILE *fid,              //!< File handle
+    const capecSurf *s,     //!< Layout and format
+    PyArrayObject **A,      //!< Packed nodes, tris, and quads
+    int *k                  //!< Section being written (output)
+    );
+
+#endif  // _CAPEC_SURF_H
@@ -0,0 +1,88 @@
+/*!
+  \file capec_Swap.h
+  \brief Bulk byte-swap and conversion kernels for CAPE C extension
+
+  This file contains functions that byte-swap or narrow entire blocks of
+  4- or 8-byte words at once.  SIMD versions (SSSE3/AVX2 on x86, NEON on
+  ARM) are selected at run time when available; otherwise plain C loops are
+  used.  Source and destination may be the same buffer for the swap kernels.
+  Single values are read and stored through integers with ``memcpy()``, so
+  a swapped word is never accessed as a float (which would break strict
+  aliasing) and never held in a floating-point variable.
+*/
+#ifndef _CAPEC_SWAP_H
+#define _CAPEC_SWAP_H
+
+#include <stddef.h>
+
+
+//! \brief Select fastest available kernels for this CPU
+void
+capec_SwapInit(void);
+
+//! \brief Get name of kernel family currently in use
+//!
+//! \return ``"avx2"``, ``"ssse3"``, ``"neon"``, or ``"scalar"``
+const char *
+capec_SwapKernelName(void);
+
+//! \brief Byte-swap *n* 4-byte words from *src* to *dst*
+void
+capec_Swap4(
+    void *dst,              //!< Output buffer (may equal *src*)
+    const void *src,        //!< Input buffer
+    size_t n                //!< Number of 4-byte words
+    );
+
+//! \brief Byte-swap *n* 8-byte words from *src* to *dst*
+void
+capec_Swap8(
+    void *dst,              //!< Output buffer (may equal *src*)
+    const void *src,        //!< Input buffer
+    size_t n                //!< Number of 8-byte words
+    );
+
+//! \brief Convert *n* doubles to singles, optionally byte-swapping
+void
+capec_NarrowF64(
+    float *dst,             //!< Output buffer
+    const double *src,      //!< Input buffer
+    size_t n,               //!< Number of values
+    int swap                //!< Whether to byte-swap outputs
+    );
+
+//! \brief Read one 4-byte float from *p*, optionally byte-swapping
+//!
+//! \return Value in native byte order
+float
+capec_GetF4(
+    const void *p,          //!< Pointer to value (any alignment)
+    int swap                //!< Whether to byte-swap
+    );
+
+//! \brief Read one 8-byte float from *p*, optionally byte-swapping
+//!
+//! \return Value in native byte order
+double
+capec_GetF8(
+    const void *p,          //!< Pointer to value (any alignment)
+    int swap                //!< Whether to byte-swap
+    );
+
+//! \brief Store one 4-byte float at *p*, optionally byte-swapping
+void
+capec_PutF4(
+    void *p,                //!< Output pointer (any alignment)
+    float f,                //!< Value in native byte order
+    int swap                //!< Whether to byte-swap
+    );
+
+//! \brief Store one 8-byte float at *p*, optionally byte-swapping
+void
+capec_PutF8(
+    void *p,                //!< Output pointer (any alignment)
+    double v,               //!< Value in native byte order
+    int swap                //!< Whether to byte-swap
+    );
+
+#endif  // _CAPEC_SWAP_H
@@ -0,0 +1,40 @@
+/*!
+  \file capec_TSVFile.h
+  \brief Whitespace-delimited file-reading utilities for CAPE C extension
+  
+  This file contains functions to read the data portion of TSV files, where
+  fields are separated by any run of spaces and/or tabs.  Each line is read
+  into memory at once and split in place, which is much faster than reading
+  field by field with ``fscanf()``.
+*/
+#ifndef _CAPEC_TSVFILE_H
+#define _CAPEC_TSVFILE_H
+
+
+//! \brief Count data lines remaining in TSV file
+//!
+//! Blank lines and lines whose first non-blank character is ``#`` are not
+//! counted.  The file is returned to its original position.
+//!
+//! \return Number of data lines
+size_t
+capec_TSVFileCountLines(
+    FILE *fp                //!< File handle
+    );
+
+//! \brief Split one line of TSV file and save each field to its column
+//!
+//! The line is modified in place.  A field starting with ``#`` begins a
+//! comment, and the rest of the line is ignored.
+//!
+//! \return -1 for blank/comment line, 0 for data row, else error indicator
+int
+capeTSV_ReadLine(
+    char *line,             //!< Text of line (null-terminated)
+    void **coldata,         //!< Pointer to data (list or C array) by column
+    int *DTYPES,            //!< Data type index for each column
+    size_t ncol,            //!< Number of columns
+    size_t irow             //!< Row index to save data to
+    );
+
+#endif  // _CAPEC_TSVFILE_H
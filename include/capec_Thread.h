@@ -0,0 +1,41 @@
+/*!
+  \file capec_Thread.h
+  \brief Simple fork-join threading for CAPE C extension
+
+  This file contains functions to run one function on each element of an
+  array of task structures using a set of POSIX threads.  The tasks must not
+  call the Python API; callers release the GIL around
+  :func:`capec_ThreadRun` so other Python threads can continue meanwhile.
+*/
+#ifndef _CAPEC_THREAD_H
+#define _CAPEC_THREAD_H
+
+#include <stddef.h>
+
+
+//! Maximum number of threads used by one call
+#define capeTHREAD_MAX 256
+
+//! Function applied to each task
+typedef void (*capecThreadFunc)(void *task);
+
+
+//! \brief Get number of processors available
+//!
+//! \return Number of online processors (at least 1)
+int
+capec_ThreadCount(void);
+
+//! \brief Run *func* on each of *ntask* tasks in parallel and wait for all
+//!
+//! Task *i* starts at ``(char *) tasks + i*size``.  Tasks that could not be
+//! given their own thread are run in the calling thread.
+void
+capec_ThreadRun(
+    capecThreadFunc func,   //!< Function to call on each task
+    void *tasks,            //!< Pointer to first task
+    size_t size,            //!< Size of each task structure (bytes)
+    int ntask               //!< Number of tasks
+    );
+
+#endif  // _CAPEC_THREAD_H
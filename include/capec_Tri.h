@@ -3,7 +3,9 @@
   \brief Key CAPE C extension functions for read/write Cart3D tri files
   
   This file contains functions that perform basic tasks of reading and writing
-  unstructured surface triangulation files
+  unstructured surface triangulation files.  The writers do not use the
+  Python API, so they may be called with the GIL released; arrays must be
+  pinned by the caller (see :c:func:`capec_PinArray`).
 */
 #ifndef _CAPEC_TRI_H
 #define _CAPEC_TRI_H
@@ -11,7 +13,7 @@
 
 //! \brief Write node coordinates to TRI file
 //!
-//! \return Status code
+//! \return Status code, see :c:type:`capecIO_STATUS`
 int
 capec_WriteTriNodes(
     FILE *fid,              //!< File handle
@@ -21,7 +23,7 @@ capec_WriteTriNodes(
 
 //! \brief Write node coordinates and BCs to SURF file
 //!
-//! \return Status code
+//! \return Status code, see :c:type:`capecIO_STATUS`
 int
 capec_WriteSurfNodes(
     FILE *fid,              //!< File handle
@@ -33,7 +35,7 @@ capec_WriteSurfNodes(
 
 //! \brief Write tri node numbers to TRI file
 //!
-//! \return Status code
+//! \return Status code, see :c:type:`capecIO_STATUS`
 int
 capec_WriteTriTris(
     FILE *fid,              //!< File handle
@@ -43,7 +45,7 @@ capec_WriteTriTris(
 
 //! \brief Write tris, compIDs, and BCs to SURF file
 //!
-//! \return Status code
+//! \return Status code, see :c:type:`capecIO_STATUS`
 int
 capec_WriteSurfTris(
     FILE *fid,              //!< File handle
@@ -55,7 +57,7 @@ capec_WriteSurfTris(
 
 //! \brief Write quads, compIDs, and BCs to SURF file
 //!
-//! \return Status code
+//! \return Status code, see :c:type:`capecIO_STATUS`
 int
 capec_WriteSurfQuads(
     FILE *fid,              //!< File handle
@@ -67,7 +69,7 @@ capec_WriteSurfQuads(
 
 //! \brief Write compIDs to TRI file
 //!
-//! \return Status code
+//! \return Status code, see :c:type:`capecIO_STATUS`
 int
 capec_WriteTriCompID(
     FILE *fid,              //!< File handle
@@ -78,11 +80,89 @@ capec_WriteTriCompID(
 // Function to write states
 //! \brief Write state variables to TRIQ file
 //!
-//! \return Status code
+//! \return Status code, see :c:type:`capecIO_STATUS`
 int
 capec_WriteTriState(
     FILE *fid,              //!< File handle
     PyArrayObject *Q        //!< Array of conditions (nTri x nq)
     );
 
-#endif
\ No newline at end of file
+
+//! \brief Write triangulation to binary STL file
+//!
+//! Writes the 80-byte header, the number of facets, and one 50-byte
+//! little-endian record per tri.  Facet normals are computed from the
+//! vertices unless *N* is given.  Tri node indices are 1-based and are
+//! checked before anything is written.
+//!
+//! \return Status code, see :c:type:`capecIO_STATUS`
+int
+capec_WriteTriSTLBin(
+    FILE *fid,              //!< File handle
+    PyArrayObject *P,       //!< Array of node coordinates (nNode x 3)
+    PyArrayObject *T,       //!< Array of tri node indices (nTri x 3)
+    PyArrayObject *N        //!< Facet normals (nTri x 3), or ``NULL``
+    );
+
+
+//! \brief Write triangulation to ASCII STL file
+//!
+//! Same as :c:func:`capec_WriteTriSTLBin` but writes text with nine
+//! significant digits per coordinate.
+//!
+//! \return Status code, see :c:type:`capecIO_STATUS`
+int
+capec_WriteTriSTL(
+    FILE *fid,              //!< File handle
+    PyArrayObject *P,       //!< Array of node coordinates (nNode x 3)
+    PyArrayObject *T,       //!< Array of tri node indices (nTri x 3)
+    PyArrayObject *N        //!< Facet normals (nTri x 3), or ``NULL``
+    );
+
+
+//! Layout of a binary (Fortran unformatted) TRI/TRIQ file
+typedef struct {
+    int swap;               //!< Whether file is in foreign byte order
+    int nf;                 //!< Bytes per float (4 or 8)
+    int ni;                 //!< Bytes per integer (4 or 8)
+    size_t nNode;           //!< Number of nodes
+    size_t nTri;            //!< Number of triangles
+    size_t nq;              //!< Number of states per node
+    size_t iNodes;          //!< Offset to nodal coordinates
+    size_t iTris;           //!< Offset to tri node indices
+    size_t iCompID;         //!< Offset to comp IDs (0 if not present)
+    size_t iq;              //!< Offset to states (0 if not present)
+} capecTriBin;
+
+
+//! \brief Check record markers and find data blocks of binary TRI file
+//!
+//! Byte order and precision are detected from the record markers, and
+//! 8-byte integers from the size of the header record.  Records split into
+//! gfortran sub-records are joined in place, so *data* must be writable
+//! (e.g. a copy-on-write mapping).  Sets a Python exception if the contents
+//! are not a valid TRI/TRIQ file.
+//!
+//! \return Status code
+int
+capec_ParseTriBin(
+    char *data,             //!< Contents of file
+    size_t size,            //!< Size of file
+    capecTriBin *t          //!< Layout (output)
+    );
+
+
+//! \brief Find data blocks of Fortran stream (no record marker) TRI file
+//!
+//! Byte order, integer size, precision, and header size are inferred from
+//! the header counts and the size of the file.
+//!
+//! \return Status code
+int
+capec_ParseTriStream(
+    char *data,             //!< Contents of file
+    size_t size,            //!< Size of file
+    capecTriBin *t          //!< Layout (output)
+    );
+
+#endif
@@ -0,0 +1,83 @@
+/*!
+  \file capec_TriClean.h
+  \brief In-place compaction of triangulations for CAPE C extension
+
+  This file contains functions to merge coincident nodes, remove unused
+  nodes, and collapse small tris of a triangulation.  Each one modifies
+  the node and tri arrays in place, keeping the remaining nodes and tris
+  in their original order at the start of each array, and uses one extra
+  array of ints per node.  These functions do not use the Python API and
+  may be called with the GIL released.
+*/
+#ifndef _CAPEC_TRICLEAN_H
+#define _CAPEC_TRICLEAN_H
+
+#include <stddef.h>
+
+
+//! Status codes of compaction functions
+enum capecCLEAN_STATUS {
+    capeCLEAN_OK,           //!< Success
+    capeCLEAN_ERR_INDEX,    //!< Node index out of range
+    capeCLEAN_ERR_SIZE,     //!< Too many nodes for 4-byte indices
+    capeCLEAN_ERR_MEM       //!< Failed to allocate work arrays
+};
+
+
+//! \brief Remove nodes not used by any tri
+//!
+//! On output, the first *nnode* rows of *X* are the nodes in use and
+//! ``J[i]`` is the original (0-based) index of new node *i*.
+//!
+//! \return Status code, see :c:type:`capecCLEAN_STATUS`
+int
+capec_TriRemoveUnusedNodes(
+    double *X,              //!< Node coordinates (*nnode* x 3)
+    size_t *nnode,          //!< Number of nodes (input and output)
+    int *T,                 //!< Node indices (1-based) of each tri
+    size_t ntri,            //!< Number of tris
+    int *J                  //!< Original index of each new node (*nnode*)
+    );
+
+//! \brief Merge nodes within a distance tolerance of each other
+//!
+//! Nodes are binned into a hash table of cubes of width *tol*, and each
+//! node is merged into the lowest-indexed earlier kept node within *tol*
+//! of it, if any.  If *tol* is zero, only nodes with exactly the same
+//! coordinates are merged.  Tris are renumbered but not removed, even if
+//! two of their nodes are merged.
+//!
+//! \return Status code, see :c:type:`capecCLEAN_STATUS`
+int
+capec_TriWeldNodes(
+    double *X,              //!< Node coordinates (*nnode* x 3)
+    size_t *nnode,          //!< Number of nodes (input and output)
+    int *T,                 //!< Node indices (1-based) of each tri
+    size_t ntri,            //!< Number of tris
+    double tol,             //!< Distance tolerance
+    int *J                  //!< Original index of each new node (*nnode*)
+    );
+
+//! \brief Collapse tris with small areas and remove unused nodes
+//!
+//! In each pass, the shortest edge of each tri with area no greater than
+//! *smalltri* is collapsed into its higher-indexed node; if no edge is
+//! longer than the square root of *smalltri*, the whole tri is
+//! collapsed.  Then the small tris and any other tris with repeated
+//! nodes are removed.  Passes are repeated until there are no small tris
+//! or *npass* passes (if positive) have been made.
+//!
+//! \return Status code, see :c:type:`capecCLEAN_STATUS`
+int
+capec_TriRemoveSmallTris(
+    double *X,              //!< Node coordinates (*nnode* x 3)
+    size_t *nnode,          //!< Number of nodes (input and output)
+    int *T,                 //!< Node indices (1-based) of each tri
+    int *C,                 //!< Component ID of each tri, or ``NULL``
+    size_t *ntri,           //!< Number of tris (input and output)
+    double smalltri,        //!< Maximum area of tris to collapse
+    int npass,              //!< Maximum number of passes (0 for no limit)
+    int *J                  //!< Original index of each new node (*nnode*)
+    );
+
+#endif  // _CAPEC_TRICLEAN_H
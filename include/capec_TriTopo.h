@@ -0,0 +1,66 @@
+/*!
+  \file capec_TriTopo.h
+  \brief Edges and adjacency of triangulations for CAPE C extension
+
+  This file contains a function to find the unique edges of a
+  triangulation and the node-to-tri, edge-to-tri, and tri-to-tri
+  adjacency in compressed sparse row (CSR) form.  Edges are found with a
+  hash table in one pass through the tris, which also counts the open
+  (one tri) and non-manifold (more than two tris) edges.  All indices are
+  0-based.  These functions do not use the Python API and may be called
+  with the GIL released.
+*/
+#ifndef _CAPEC_TRITOPO_H
+#define _CAPEC_TRITOPO_H
+
+#include <stddef.h>
+
+
+//! Status codes of topology functions
+enum capecTOPO_STATUS {
+    capeTOPO_OK,            //!< Success
+    capeTOPO_ERR_INDEX,     //!< Node index out of range
+    capeTOPO_ERR_SIZE,      //!< Too many tris for 4-byte indices
+    capeTOPO_ERR_MEM        //!< Failed to allocate arrays
+};
+
+//! Edges and adjacency of a triangulation
+typedef struct {
+    size_t nnode;           //!< Number of nodes
+    size_t ntri;            //!< Number of tris
+    size_t nedge;           //!< Number of unique edges
+    size_t nopen;           //!< Number of edges used by one tri
+    size_t nnonmanifold;    //!< Number of edges used by more than two tris
+    int *n2t_ptr;           //!< Start of each node's tris in *n2t*
+    int *n2t;               //!< Tris using each node (3 \* *ntri*)
+    int *edges;             //!< Nodes of each edge, lower first (*nedge* x 2)
+    int *tri_edges;         //!< Edge of each side of each tri (*ntri* x 3)
+    int *e2t_ptr;           //!< Start of each edge's tris in *e2t*
+    int *e2t;               //!< Tris using each edge (3 \* *ntri*)
+    int *t2t_ptr;           //!< Start of each tri's neighbors in *t2t*
+    int *t2t;               //!< Tris sharing an edge with each tri
+} capecTriTopo;
+
+
+//! \brief Find edges and adjacency of a triangulation
+//!
+//! Side *k* of tri *j* goes from node ``T[3*j+k]`` to node
+//! ``T[3*j+(k+1)%3]``.  Edges are numbered in order of first use.  Each
+//! tri's neighbors are listed once for each edge they share with it.
+//!
+//! \return Status code, see :c:type:`capecTOPO_STATUS`
+int
+capec_TriTopoBuild(
+    capecTriTopo *g,        //!< Topology (output; free with capec_TriTopoFree)
+    const int *T,           //!< Node indices (1-based) of each tri
+    size_t ntri,            //!< Number of tris
+    size_t nnode            //!< Number of nodes
+    );
+
+//! \brief Release arrays of a topology
+void
+capec_TriTopoFree(
+    capecTriTopo *g         //!< Topology
+    );
+
+#endif  // _CAPEC_TRITOPO_H
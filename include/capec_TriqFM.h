@@ -0,0 +1,105 @@
+/*!
+  \file capec_TriqFM.h
+  \brief Integrated forces and moments of annotated triangulations
+
+  This file contains functions that integrate pressure, vacuum, momentum,
+  and viscous forces over the tris of a TRIQ file and add them up by
+  component ID in one pass.  Along with each force, the sum of the moment
+  of that force about the origin is saved, so moments about any number of
+  moment reference points and totals of any group of components can be
+  computed from the sums afterwards.  The formulas are the same as in
+  :func:`cape.trifile.Triq.GetTriForces`.  These functions do not use the
+  Python API and may be called with the GIL released.
+*/
+#ifndef _CAPEC_TRIQFM_H
+#define _CAPEC_TRIQFM_H
+
+#include <stddef.h>
+
+
+//! Number of values per component in :c:func:`capec_TriqForces`
+#define capeTRIQFM_NSUM 28
+
+//! Smallest number of tris given to one thread
+#define capeTRIQFM_CHUNKMIN 16384
+
+//! Columns of sums for each component
+enum capeTRIQFM_COL {
+    capeTRIQFM_A = 0,       //!< Area vector (3)
+    capeTRIQFM_FP = 3,      //!< Pressure force (3)
+    capeTRIQFM_MP = 6,      //!< Moment of pressure force about origin (3)
+    capeTRIQFM_FVAC = 9,    //!< Vacuum force (3)
+    capeTRIQFM_MVAC = 12,   //!< Moment of vacuum force (3)
+    capeTRIQFM_FM = 15,     //!< Momentum force (3)
+    capeTRIQFM_MM = 18,     //!< Moment of momentum force (3)
+    capeTRIQFM_FV = 21,     //!< Viscous force (3)
+    capeTRIQFM_MV = 24,     //!< Moment of viscous force (3)
+    capeTRIQFM_N = 27       //!< Number of tris
+};
+
+//! Forces on one tri from :c:func:`capec_TriqTriForces`
+enum capeTRIQFM_FORCE {
+    capeTRIQFM_FP3 = 0,     //!< Pressure force (3)
+    capeTRIQFM_FVAC3 = 3,   //!< Vacuum force (3)
+    capeTRIQFM_FM3 = 6,     //!< Momentum force (3)
+    capeTRIQFM_FV3 = 9,     //!< Viscous force (3)
+    capeTRIQFM_NF = 12      //!< Number of values
+};
+
+//! Freestream state and options for :c:func:`capec_TriqForces`
+typedef struct {
+    double mach;            //!< Freestream Mach number
+    double rey;             //!< Reynolds number per grid unit
+    double gam;             //!< Ratio of specific heats
+    double smallvol;        //!< Smallest prism volume for viscous forces
+} capecTriqFMOpts;
+
+
+//! \brief Calculate area vector and each type of force on one tri
+//!
+//! Forces that are not available for *nq* states are set to zero.
+void
+capec_TriqTriForces(
+    const double *P,        //!< Node coordinates (nNode x 3)
+    const int *T,           //!< Tri node indices (nTri x 3), checked
+    const double *Q,        //!< States at each node (nNode x nq)
+    int nq,                 //!< Number of states
+    size_t i,               //!< Index of tri
+    const capecTriqFMOpts *opts,    //!< Freestream state
+    double *N,              //!< Output area vector (3)
+    double *F               //!< Output forces (capeTRIQFM_NF)
+    );
+
+//! \brief Add *f* times a force and its moment about origin to sums
+void
+capec_TriqAddForce(
+    double *s,              //!< Sums of force and moment (6)
+    const double *x,        //!< Point where force acts (3)
+    const double *F,        //!< Force (3)
+    double f                //!< Fraction of force to add
+    );
+
+//! \brief Add forces and moments on each tri to sums for its component
+//!
+//! Row *j* of *S* is for component ``cmin + j``; see
+//! :c:type:`capeTRIQFM_COL` for the columns.  Forces are not divided by
+//! reference area or dynamic pressure.  The states used depend on *nq* in
+//! the same way as :func:`cape.trifile.Triq.GetTriForces`.
+//!
+//! \return ``0`` on success, ``1`` if a component ID is out of range
+int
+capec_TriqForces(
+    const double *P,        //!< Node coordinates (nNode x 3)
+    const int *T,           //!< Tri node indices (nTri x 3), checked
+    const double *Q,        //!< States at each node (nNode x nq)
+    int nq,                 //!< Number of states
+    const int *C,           //!< Component ID of each tri (nTri)
+    size_t nTri,            //!< Number of tris
+    int cmin,               //!< Smallest component ID
+    size_t ncomp,           //!< Number of rows of *S*
+    const capecTriqFMOpts *opts,    //!< Freestream state
+    double *S,              //!< Output sums (ncomp x capeTRIQFM_NSUM)
+    int nthread             //!< Max number of threads (0 for all CPUs)
+    );
+
+#endif  // _CAPEC_TRIQFM_H
@@ -0,0 +1,158 @@
+/*!
+  \file capec_UGrid.h
+  \brief Read and write AFLR3 UGRID volume meshes
+
+  This file contains functions that find the sections of binary UGRID
+  files (stream or Fortran records, either byte order, 4- or 8-byte
+  floats), parse the sections of ASCII UGRID files, and write any of these
+  formats.  Binary files are mapped into memory, and the offset of each
+  section is computed from the header, so sections that are not wanted
+  are never read.  ASCII files have to be scanned in order, but sections
+  that are not wanted are skipped without converting their values, and
+  scanning stops after the last wanted section.  Except for
+  :c:func:`capec_ParseUGrid`, these functions do not use the Python API
+  and may be called with the GIL released.
+*/
+#ifndef _CAPEC_UGRID_H
+#define _CAPEC_UGRID_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#include "capec_Scan.h"
+
+
+//! Sections of a UGRID file, in the order they are written
+enum capeUGRID_SECTION {
+    capeUGRID_NODES,        //!< Node coordinates (nNode x 3)
+    capeUGRID_TRIS,         //!< Tri face node indices (nTri x 3)
+    capeUGRID_QUADS,        //!< Quad face node indices (nQuad x 4)
+    capeUGRID_SURFIDS,      //!< Surface IDs of tris, then quads
+    capeUGRID_TETS,         //!< Tetrahedron node indices (nTet x 4)
+    capeUGRID_PYRS,         //!< Pyramid node indices (nPyr x 5)
+    capeUGRID_PRIS,         //!< Prism node indices (nPri x 6)
+    capeUGRID_HEXS,         //!< Hexahedron node indices (nHex x 8)
+    capeUGRID_NTETBL,       //!< Number of tets in boundary layer (1)
+    capeUGRID_VOLIDS,       //!< Volume IDs of all cells
+    capeUGRID_SURFFLAGS,    //!< Reconnection flags of surface faces
+    capeUGRID_SURFBCS,      //!< Boundary conditions of surface faces
+    capeUGRID_BLDS,         //!< Initial normal spacing at each node
+    capeUGRID_BLDEL,        //!< Boundary layer thickness at each node
+    capeUGRID_NSECTION      //!< Number of sections
+};
+
+//! Number of sections every UGRID file has (through hexs)
+#define capeUGRID_NREQUIRED (capeUGRID_HEXS + 1)
+
+//! Names of sections, matching slots of :mod:`cape.gruvoc.ugridfile`
+extern const char *capeUGRID_NAMES[capeUGRID_NSECTION];
+
+
+//! Status codes of ASCII UGRID reader
+enum capeUGRID_STATUS {
+    capeUGRID_OK,           //!< Success
+    capeUGRID_ERR_EOF,      //!< File ended within a section
+    capeUGRID_ERR_VALUE,    //!< Invalid number
+    capeUGRID_ERR_READ      //!< Failed to read from file
+};
+
+
+//! Layout of a UGRID file
+typedef struct {
+    int ascii;              //!< Whether file is text
+    int record;             //!< Whether sections have Fortran markers
+    int swap;               //!< Whether file is in foreign byte order
+    int nf;                 //!< Bytes per float (4 or 8)
+    long n[7];              //!< Nodes, tris, quads, tets, pyrs, pris, hexs
+    int nsection;           //!< Number of sections present in file
+    size_t count[capeUGRID_NSECTION];   //!< Values in each section
+    size_t ncol[capeUGRID_NSECTION];    //!< Columns, 0 for 1-D sections
+    size_t offset[capeUGRID_NSECTION];  //!< Offset to data (binary)
+} capecUGrid;
+
+
+//! \brief Set format of UGRID layout from name such as ``"lr8"``
+//!
+//! Accepts ``"ascii"`` and ``"[l]{b|r}{4|8}"``.
+//!
+//! \return Error flag (0 for ok)
+int
+capec_UGridFormat(
+    capecUGrid *g,          //!< Layout to set format of
+    const char *fmt         //!< Name of format
+    );
+
+//! \brief Compute count and shape of each section from header counts
+void
+capec_UGridSizes(
+    capecUGrid *g           //!< Layout with *n* set
+    );
+
+//! \brief Check whether a section contains floats
+//!
+//! \return ``1`` for node coordinates and BL spacings, ``0`` for ints
+int
+capec_UGridIsFloat(
+    int k                   //!< Section index
+    );
+
+//! \brief Find sections of a binary UGRID file
+//!
+//! If *fmt* is ``NULL``, each binary format is tried in turn and the first
+//! whose sections exactly fill the file is used; if none match, the file
+//! is marked as ASCII and only *g->ascii* is set.  Record markers are
+//! checked for every section present.  Sets a Python exception on failure.
+//!
+//! \return Error flag (0 for ok)
+int
+capec_ParseUGrid(
+    const char *data,       //!< Contents of file
+    size_t size,            //!< Size of file (bytes)
+    const char *fmt,        //!< Format name, or ``NULL`` to detect
+    capecUGrid *g           //!< Layout (output)
+    );
+
+//! \brief Read header of ASCII UGRID file
+//!
+//! \return Status code, see :c:type:`capeUGRID_STATUS`
+int
+capec_ReadUGridHeader(
+    capecScanBuf *b,        //!< Text buffer at start of file
+    char **p,               //!< Read position within current line (output)
+    capecUGrid *g           //!< Layout; sets counts and sizes
+    );
+
+//! \brief Read sections of ASCII UGRID file after the header
+//!
+//! Sections are read in order into ``out[k]`` (``int`` or ``double``
+//! depending on :c:func:`capec_UGridIsFloat`); sections whose *out* is
+//! ``NULL`` are skipped.  Reading stops after the last section with an
+//! output or at the end of the file, and *g->nsection* is set to the
+//! number of sections reached.  On error, *g->nsection* is the section
+//! that failed.
+//!
+//! \return Status code, see :c:type:`capeUGRID_STATUS`
+int
+capec_ReadUGridText(
+    capecScanBuf *b,        //!< Text buffer after header
+    char **p,               //!< Read position within current line
+    capecUGrid *g,          //!< Layout from header
+    void **out              //!< Output for each section, or ``NULL``
+    );
+
+//! \brief Write UGRID file in format of *g*
+//!
+//! Writes the header and the first *g->nsection* sections from ``A[k]``,
+//! which must be pinned as ``NPY_INT`` or ``NPY_DOUBLE`` arrays with
+//! *g->count[k]* values (see :c:func:`capec_PinArray`).
+//!
+//! \return Status code, see :c:type:`capecIO_STATUS`
+int
+capec_WriteUGrid(
+    FILE *fid,              //!< File handle
+    const capecUGrid *g,    //!< Layout and format
+    PyArrayObject **A,      //!< Array for each section
+    int *k                  //!< Section being written (output)
+    );
+
+#endif  // _CAPEC_UGRID_H
@@ -0,0 +1,110 @@
+/*!
+  \file capec_UH3D.h
+  \brief Read and write UH3D surface triangulations
+
+  This file contains functions that parse and write the comma-separated
+  UH3D format: a title line, a line of counts, one line for each node
+  (index and coordinates), one line for each tri (index, node indices, and
+  component ID), and one line for each component label, ending with
+  ``99,99,99,99,99``.  The counts on the second line are used to allocate
+  the output before the nodes and tris are read in a single pass with the
+  buffered reader from :file:`capec_Scan.h`.  Except for
+  :c:func:`capec_WriteUH3DNodes` and :c:func:`capec_WriteUH3DTris`, which
+  take NumPy arrays, these functions do not use the Python API, and all of
+  them may be called with the GIL released.
+*/
+#ifndef _CAPEC_UH3D_H
+#define _CAPEC_UH3D_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#include "capec_Scan.h"
+
+
+//! Parts of a UH3D file, in the order they are written
+enum capeUH3D_SECTION {
+    capeUH3D_HEADER,        //!< Title and counts
+    capeUH3D_NODES,         //!< Node coordinates
+    capeUH3D_TRIS,          //!< Tri node indices and component IDs
+    capeUH3D_NSECTION       //!< Number of sections
+};
+
+//! Names of sections for messages
+extern const char *capeUH3D_NAMES[capeUH3D_NSECTION];
+
+//! Status codes of UH3D reader
+enum capeUH3D_STATUS {
+    capeUH3D_OK,            //!< Success
+    capeUH3D_ERR_EOF,       //!< File ended within a section
+    capeUH3D_ERR_VALUE,     //!< Invalid number or wrong number of fields
+    capeUH3D_ERR_READ       //!< Failed to read from file
+};
+
+
+//! Layout and read position of a UH3D file
+typedef struct {
+    long nNode;             //!< Number of nodes
+    long nTri;              //!< Number of tris
+    long nComp;             //!< Number of component labels in header
+    int nsection;           //!< Section being read, or last one read
+    size_t iline;           //!< Number of lines read (1-based line number)
+} capecUH3D;
+
+
+//! \brief Read title and counts of a UH3D file
+//!
+//! \return Status, see :c:type:`capeUH3D_STATUS`
+int
+capec_ReadUH3DHeader(
+    capecScanBuf *b,        //!< Text buffer at start of file
+    capecUH3D *u            //!< Layout; sets counts
+    );
+
+//! \brief Read nodes, tris, and component IDs of a UH3D file
+//!
+//! \return Status, see :c:type:`capeUH3D_STATUS`
+int
+capec_ReadUH3D(
+    capecScanBuf *b,        //!< Text buffer after header
+    capecUH3D *u,           //!< Layout from header
+    double *P,              //!< Node coordinates (*nNode* x 3)
+    int *T,                 //!< Tri node indices (*nTri* x 3)
+    int *C                  //!< Component ID of each tri (*nTri*)
+    );
+
+//! \brief Parse one component label line, like ``1, 'body'``
+//!
+//! The rules are the same as :func:`cape.trifile.Tri.ReadUH3DCompIDList`:
+//! the line must have exactly one comma, and the name has surrounding
+//! spaces and quotes removed.
+//!
+//! \return ``1`` if *line* is a label, else ``0``
+int
+capec_ParseUH3DLabel(
+    char *line,             //!< Line of text
+    long *cid,              //!< Component ID (output)
+    char **name,            //!< Start of name within *line* (output)
+    size_t *n               //!< Length of name (output)
+    );
+
+//! \brief Write nodes of a UH3D file, with 1-based indices
+//!
+//! \return Status code, see :c:type:`capecIO_STATUS`
+int
+capec_WriteUH3DNodes(
+    FILE *fid,              //!< Output stream
+    PyArrayObject *P        //!< Node coordinates (*nNode* x 3)
+    );
+
+//! \brief Write tris and component IDs of a UH3D file
+//!
+//! \return Status code, see :c:type:`capecIO_STATUS`
+int
+capec_WriteUH3DTris(
+    FILE *fid,              //!< Output stream
+    PyArrayObject *T,       //!< Tri node indices (*nTri* x 3)
+    PyArrayObject *C        //!< Component ID of each tri
+    );
+
+#endif  // _CAPEC_UH3D_H
@@ -0,0 +1,96 @@
+/*!
+  \file capec_Zip.h
+  \brief Streaming compression of files for CAPE C extension
+
+  This file contains functions to compress output as it is written and to
+  decompress whole input files into memory.  The format is selected by the
+  file extension: ``.gz`` for gzip (using zlib) and ``.zst`` for Zstandard.
+  Each library is only used if the extension is built with
+  ``-DcapeHAVE_ZLIB`` or ``-DcapeHAVE_ZSTD`` (and linked with ``-lz`` or
+  ``-lzstd``).  Zstandard compression uses one worker thread per processor
+  if the library supports it.  Concatenated gzip members and Zstandard
+  frames are read as one file, so appending to a compressed file works.
+  These functions do not use the Python API and may be called with the GIL
+  released.
+*/
+#ifndef _CAPEC_ZIP_H
+#define _CAPEC_ZIP_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+
+//! Size of compressed output buffer (bytes)
+#define capeZIP_BUFSIZE (1 << 18)
+
+//! Compression level for gzip
+#define capeZIP_GZIPLEVEL 6
+
+//! Compression level for Zstandard
+#define capeZIP_ZSTDLEVEL 3
+
+//! Compression formats
+enum capeZIP_CODEC {
+    capeZIP_NONE,           //!< Not compressed
+    capeZIP_GZIP,           //!< gzip (``.gz``)
+    capeZIP_ZSTD            //!< Zstandard (``.zst``)
+};
+
+//! Status codes of decompression
+enum capeZIP_STATUS {
+    capeZIP_OK,             //!< Success
+    capeZIP_ERR_CODEC,      //!< Format not available in this build
+    capeZIP_ERR_DATA,       //!< Corrupt or truncated input
+    capeZIP_ERR_MEM         //!< Failed to allocate output
+};
+
+
+//! \brief Get compression format from file name
+//!
+//! \return Format, see :c:type:`capeZIP_CODEC`
+int
+capec_ZipCodec(
+    const char *fname       //!< File name
+    );
+
+//! \brief Check if a compression format is available in this build
+//!
+//! \return ``1`` if available, else ``0``
+int
+capec_ZipAvailable(
+    int codec               //!< Format, see :c:type:`capeZIP_CODEC`
+    );
+
+//! \brief Name of a compression format for messages
+const char *
+capec_ZipName(
+    int codec               //!< Format, see :c:type:`capeZIP_CODEC`
+    );
+
+//! \brief Open stream that compresses its output into another stream
+//!
+//! The new stream owns *out* and closes it on ``fclose()`` after writing
+//! the end of the compressed data and syncing it (if *out* is an ordinary
+//! file stream).
+//!
+//! \return Stream, or ``NULL`` (*out* is left open) on failure
+FILE *
+capec_ZipOpen(
+    FILE *out,              //!< Stream for compressed output
+    int codec,              //!< Format, see :c:type:`capeZIP_CODEC`
+    int sync                //!< See :c:type:`capePIPE_SYNC`
+    );
+
+//! \brief Decompress a whole file from memory
+//!
+//! \return Status, see :c:type:`capeZIP_STATUS`
+int
+capec_ZipInflate(
+    const char *src,        //!< Compressed data
+    size_t n,               //!< Size of *src*
+    int codec,              //!< Format, see :c:type:`capeZIP_CODEC`
+    char **data,            //!< Decompressed data, from ``malloc()``
+    size_t *size            //!< Size of *data*
+    );
+
+#endif  // _CAPEC_ZIP_H
@@ -11,12 +11,24 @@
 int is_le(void);
 
 // Get total size of NumPy array
-int np_size(PyArrayObject *P);
+size_t np_size(PyArrayObject *P);
 
 // Byteswap functions for floats/doubles
 float  swap_single(const float f);
 double swap_double(const double f);      
 
+// Size of staging buffer for converted/byte-swapped records (bytes)
+#define capeIO_STAGESIZE (1 << 20)
+
+// Element types for record writers; input arrays may be int32/int64 for
+// integer outputs and float32/float64 for float outputs
+enum capecREC_TYPE {
+    capeREC_I4,         // integer -> 4-byte integer
+    capeREC_F4,         // float -> 4-byte float
+    capeREC_F8,         // float -> 8-byte float
+    capeREC_I8          // integer -> 8-byte integer
+};
+
 // Individual integers
 int capec_Write_b4_i(FILE *fid, int    v);
 int capec_Write_b4_f(FILE *fid, float  v);
@@ -25,6 +37,51 @@ int capec_Write_lb4_i(FILE *fid, int    v);
 int capec_Write_lb4_f(FILE *fid, float  v);
 int capec_Write_lb4_d(FILE *fid, double v);
 
+// Record markers
+int capec_WriteMarker(FILE *fid, int nb, int swap);
+
+// Header count as 4- or 8-byte integer (*ni*)
+int capec_WriteCount(FILE *fid, size_t v, int ni, int swap);
+
+// Largest Fortran sub-record (bytes); longer records are split into
+// sub-records the same way as gfortran, with a negative leading marker if
+// more follow and a negative trailing marker if others came before
+#ifndef capeIO_SUBRECMAX
+#define capeIO_SUBRECMAX 2147483639
+#endif
+
+// Status codes of writers; these don't use the Python API, so they may be
+// called with the GIL released once arrays are pinned
+enum capecIO_STATUS {
+    capeIO_OK,          // success
+    capeIO_ERR_WRITE,   // fwrite() or similar failed
+    capeIO_ERR_SHAPE,   // array has wrong dimensions or type
+    capeIO_ERR_MEM,     // failed to allocate buffer
+    capeIO_ERR_SIZE     // counts or values too large for 4-byte integers
+};
+
+// Get new reference to aligned, native, C-contiguous array (needs GIL)
+PyArrayObject *capec_PinArray(PyObject *P, int typenum, int ndim);
+
+// Check if writers can read array directly for NPY_DOUBLE or NPY_INT
+// output: aligned, native float32/float64 or int32/int64, any strides
+int capec_ViewOK(PyArrayObject *P, int typenum);
+
+// Get new reference to array that writers can read directly; this only
+// copies arrays that fail capec_ViewOK() (needs GIL)
+PyArrayObject *capec_PinView(PyObject *P, int typenum, int ndim);
+
+// Set Python exception for writer status code (needs GIL)
+void capec_IOSetError(int ierr, const char *what, const char *name);
+
+// Generic record writer (*P* pinned by capec_PinView())
+int capec_WriteRecord(FILE *fid, PyArrayObject *P, int ndim, int rtype,
+    int swap);
+
+// Generic stream writer (no record markers)
+int capec_WriteStream(FILE *fid, PyArrayObject *P, int ndim, int rtype,
+    int swap);
+
 // Big-endian single-precision writers
 int capec_WriteRecord_b4_f1(FILE *fid, PyArrayObject *P);
 int capec_WriteRecord_b4_f2(FILE *fid, PyArrayObject *P);
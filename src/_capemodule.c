@@ -13,22 +13,120 @@
 // Local includes
 #include "capec_NumPy.h"
 #include "capec_io.h"
+#include "capec_Swap.h"
+#include "capec_Geom.h"
+#include "capec_Interp.h"
 #include "capec_Tri.h"
 #include "cape_Tri.h"
+#include "cape_Geom.h"
+#include "cape_BVH.h"
+#include "cape_TriTopo.h"
+#include "cape_TriClean.h"
+#include "cape_TriqFM.h"
+#include "cape_LineLoad.h"
+#include "cape_UGrid.h"
+#include "cape_UH3D.h"
+#include "cape_Surf.h"
+#include "cape_Interp.h"
+#include "cape_P3D.h"
+#include "cape_Plt.h"
 #include "capec_BaseFile.h"
 #include "cape_CSVFile.h"
+#include "cape_TSVFile.h"
+#include "cape_ColCache.h"
+#include "cape_Sink.h"
+#include "cape_Stats.h"
 
 static PyMethodDef CapeMethods[] = {
     // pc_Tri methods
     {"WriteTri",     cape_WriteTri,     METH_VARARGS, doc_WriteTri},
     {"WriteCompID",  cape_WriteCompID,  METH_VARARGS, doc_WriteCompID},
     {"WriteTriQ",    cape_WriteTriQ,    METH_VARARGS, doc_WriteTriQ},
+    {
+        "WriteTriQAsync",
+        cape_WriteTriQAsync,
+        METH_VARARGS,
+        doc_WriteTriQAsync
+    },
     {"WriteSurf",    cape_WriteSurf,    METH_VARARGS, doc_WriteSurf},
     {"WriteTriSTL",  cape_WriteTriSTL,  METH_VARARGS, doc_WriteTriSTL},
+    {
+        "WriteTriSTLBin",
+        cape_WriteTriSTLBin,
+        METH_VARARGS,
+        doc_WriteTriSTLBin
+    },
     {"WriteTri_b4",  cape_WriteTri_b4,  METH_VARARGS, doc_WriteTri_b4},
     {"WriteTri_lb4", cape_WriteTri_lb4, METH_VARARGS, doc_WriteTri_lb4},
     {"WriteTri_b8",  cape_WriteTri_b8,  METH_VARARGS, doc_WriteTri_b8},
     {"WriteTri_lb8", cape_WriteTri_lb8, METH_VARARGS, doc_WriteTri_lb8},
+    {"WriteTri_r4",  cape_WriteTri_r4,  METH_VARARGS, doc_WriteTri_r4},
+    {"WriteTri_lr4", cape_WriteTri_lr4, METH_VARARGS, doc_WriteTri_lr4},
+    {"WriteTri_r8",  cape_WriteTri_r8,  METH_VARARGS, doc_WriteTri_r8},
+    {"WriteTri_lr8", cape_WriteTri_lr8, METH_VARARGS, doc_WriteTri_lr8},
+    {"ReadTri",      cape_ReadTri,      METH_VARARGS, doc_ReadTri},
+    {"ReadTriQ",     cape_ReadTriQ,     METH_VARARGS, doc_ReadTriQ},
+    {
+        "WriteTriStream",
+        cape_WriteTriStream,
+        METH_VARARGS,
+        doc_WriteTriStream
+    },
+    {
+        "ReadTriStream",
+        cape_ReadTriStream,
+        METH_VARARGS,
+        doc_ReadTriStream
+    },
+    {"ReadUH3D",     cape_ReadUH3D,     METH_VARARGS, doc_ReadUH3D},
+    {"WriteUH3D",    cape_WriteUH3D,    METH_VARARGS, doc_WriteUH3D},
+    {"ReadSurf",     cape_ReadSurf,     METH_VARARGS, doc_ReadSurf},
+    // Tri geometry
+    {"TriGeom",      cape_TriGeom,      METH_VARARGS, doc_TriGeom},
+    {
+        "TriNodeNormals",
+        cape_TriNodeNormals,
+        METH_VARARGS,
+        doc_TriNodeNormals
+    },
+    {"TriCompGeom",  cape_TriCompGeom,  METH_VARARGS, doc_TriCompGeom},
+    {"TriBVH",       cape_TriBVH,       METH_VARARGS, doc_TriBVH},
+    {
+        "TriBVHNearest",
+        cape_TriBVHNearest,
+        METH_VARARGS,
+        doc_TriBVHNearest
+    },
+    {"TriTopology",  cape_TriTopology,  METH_VARARGS, doc_TriTopology},
+    {
+        "TriRemoveUnusedNodes",
+        cape_TriRemoveUnusedNodes,
+        METH_VARARGS,
+        doc_TriRemoveUnusedNodes
+    },
+    {"TriWeldNodes", cape_TriWeldNodes, METH_VARARGS, doc_TriWeldNodes},
+    {
+        "TriRemoveSmallTris",
+        cape_TriRemoveSmallTris,
+        METH_VARARGS,
+        doc_TriRemoveSmallTris
+    },
+    {"TriqForces",   cape_TriqForces,   METH_VARARGS, doc_TriqForces},
+    {
+        "TriqLineLoads",
+        cape_TriqLineLoads,
+        METH_VARARGS,
+        doc_TriqLineLoads
+    },
+    // Volume mesh utilities
+    {"ReadUGrid",    cape_ReadUGrid,    METH_VARARGS, doc_ReadUGrid},
+    {"WriteUGrid",   cape_WriteUGrid,   METH_VARARGS, doc_WriteUGrid},
+    // PLOT3D grid and solution utilities
+    {"ReadP3D",      cape_ReadP3D,      METH_VARARGS, doc_ReadP3D},
+    {"WriteP3D",     cape_WriteP3D,     METH_VARARGS, doc_WriteP3D},
+    // Tecplot binary utilities
+    {"ReadPlt",      cape_ReadPlt,      METH_VARARGS, doc_ReadPlt},
+    {"WritePlt",     cape_WritePlt,     METH_VARARGS, doc_WritePlt},
     // CSV file utilities
     {
         "CSVFileCountLines",
@@ -42,6 +140,59 @@ static PyMethodDef CapeMethods[] = {
         METH_VARARGS,
         doc_CSVFileReadData
     },
+    {
+        "CSVFileTailState",
+        cape_CSVFileTailState,
+        METH_VARARGS,
+        doc_CSVFileTailState
+    },
+    {
+        "CSVFileReadTail",
+        cape_CSVFileReadTail,
+        METH_VARARGS,
+        doc_CSVFileReadTail
+    },
+    // TSV file utilities
+    {
+        "TSVFileCountLines",
+        cape_TSVFileCountLines,
+        METH_VARARGS,
+        doc_TSVFileCountLines
+    },
+    {
+        "TSVFileReadData",
+        cape_TSVFileReadData,
+        METH_VARARGS,
+        doc_TSVFileReadData
+    },
+    // Batch response evaluation for DataKit
+    {"BkptIndex",    cape_BkptIndex,    METH_VARARGS, doc_BkptIndex},
+    {
+        "MultilinearEval",
+        cape_MultilinearEval,
+        METH_VARARGS,
+        doc_MultilinearEval
+    },
+    {"RBFEval",      cape_RBFEval,      METH_VARARGS, doc_RBFEval},
+    // Binary cache of data file columns
+    {"ColCacheWrite", cape_ColCacheWrite, METH_VARARGS, doc_ColCacheWrite},
+    {"ColCacheRead",  cape_ColCacheRead,  METH_VARARGS, doc_ColCacheRead},
+    // Pipelined and background output
+    {
+        "SetWritePipeline",
+        cape_SetWritePipeline,
+        METH_VARARGS,
+        doc_SetWritePipeline
+    },
+    {"WriteWait",     cape_WriteWait,     METH_VARARGS, doc_WriteWait},
+    {"ZipCodecs",     cape_ZipCodecs,     METH_NOARGS,  doc_ZipCodecs},
+    // Counters of extension functions
+    {
+        "io_stats",
+        (PyCFunction) (void (*)(void)) cape_IOStats,
+        METH_VARARGS | METH_KEYWORDS,
+        doc_IOStats
+    },
     // Sentinel
     {NULL, NULL, 0, NULL}
 };
@@ -62,11 +213,22 @@ PyInit__cape(void)
 
         // This must be called before using the NumPy API
         import_array();
+        // Pick byte-swap kernels for this CPU
+        capec_SwapInit();
+        // Pick geometry kernels
+        capec_GeomInit();
+        // Pick interpolation kernels
+        capec_InterpInit();
         // Initialize module
         m = PyModule_Create(&capemodule);
         // Check for errors
         if (m == NULL)
             return;
+        // Count calls, bytes, and time of each function (but not io_stats)
+        if (cape_StatWrap(m, CapeMethods, "io_stats")) {
+            Py_DECREF(m);
+            return NULL;
+        }
 
         // Add attributes
         capec_AddDTypes(m);
@@ -14,6 +14,7 @@
 #include "capec_NumPy.h"
 #include "capec_BaseFile.h"
 #include "cape_CSVFile.h"
+#include "cape_TSVFile.h"
 
 // Declare each module function
 static PyMethodDef FTypesMethods[] = {
@@ -30,6 +31,31 @@ static PyMethodDef FTypesMethods[] = {
         METH_VARARGS,
         doc_CSVFileReadData
     },
+    {
+        "CSVFileTailState",
+        cape_CSVFileTailState,
+        METH_VARARGS,
+        doc_CSVFileTailState
+    },
+    {
+        "CSVFileReadTail",
+        cape_CSVFileReadTail,
+        METH_VARARGS,
+        doc_CSVFileReadTail
+    },
+    // TSV file utilities
+    {
+        "TSVFileCountLines",
+        cape_TSVFileCountLines,
+        METH_VARARGS,
+        doc_TSVFileCountLines
+    },
+    {
+        "TSVFileReadData",
+        cape_TSVFileReadData,
+        METH_VARARGS,
+        doc_TSVFileReadData
+    },
     // Sentinel
     {NULL, NULL, 0, NULL}
 };
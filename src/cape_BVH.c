@@ -0,0 +1,190 @@
+#include <Python.h>
+
+#if PY_MINOR_VERSION >= 10
+    #define NPY_NO_DEPRECATED_API NPY_2_0_API_VERSION
+#else
+    #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#endif
+#define PY_ARRAY_UNIQUE_SYMBOL _cape_ARRAY_API
+#define NO_IMPORT_ARRAY
+#include <numpy/arrayobject.h>
+#include <stdlib.h>
+
+// Local includes
+#include "capec_io.h"
+#include "capec_BVH.h"
+
+// Name of capsules holding trees
+#define capeBVH_CAPSULE "cape._cape.TriBVH"
+
+
+// Capsule destructor
+static void
+cape_BVHCapsuleDel(PyObject *cap)
+{
+    capecBVH *b;
+    
+    // Get tree
+    b = (capecBVH *) PyCapsule_GetPointer(cap, capeBVH_CAPSULE);
+    if (b == NULL) {
+        PyErr_Clear();
+        return;
+    }
+    // Release it
+    capec_BVHFree(b);
+    free(b);
+}
+
+
+// Function to build tree of tris
+PyObject *
+cape_TriBVH(PyObject *self, PyObject *args)
+{
+    int ierr;
+    capecBVH *b;
+    PyObject *oP, *oT, *oC;
+    PyArrayObject *P, *T, *C;
+    PyObject *cap;
+    
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "OOO", &oP, &oT, &oC)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.TriBVH`");
+        return NULL;
+    }
+    // Aligned, native arrays
+    P = capec_PinArray(oP, NPY_DOUBLE, 2);
+    T = (P == NULL) ? NULL : capec_PinArray(oT, NPY_INT, 2);
+    C = (T == NULL) ? NULL : capec_PinArray(oC, NPY_INT, 1);
+    if (C == NULL) {
+        Py_XDECREF(P);
+        Py_XDECREF(T);
+        return NULL;
+    }
+    // Check dimensions
+    if (PyArray_DIM(P, 1) != 3 || PyArray_DIM(T, 1) != 3 ||
+            PyArray_DIM(C, 0) != PyArray_DIM(T, 0)) {
+        PyErr_SetString(PyExc_ValueError, \
+            "Need Nx3 nodes, Mx3 tris, and M component IDs.");
+        Py_DECREF(P);
+        Py_DECREF(T);
+        Py_DECREF(C);
+        return NULL;
+    }
+    
+    // Allocate tree
+    b = (capecBVH *) malloc(sizeof(capecBVH));
+    if (b == NULL) {
+        Py_DECREF(P);
+        Py_DECREF(T);
+        Py_DECREF(C);
+        return PyErr_NoMemory();
+    }
+    // Build it without the GIL
+    Py_BEGIN_ALLOW_THREADS
+    ierr = capec_BVHBuild(b,
+        (const double *) PyArray_DATA(P), (size_t) PyArray_DIM(P, 0),
+        (const int *) PyArray_DATA(T),
+        (const int *) PyArray_DATA(C), (size_t) PyArray_DIM(T, 0));
+    Py_END_ALLOW_THREADS
+    // Release inputs; tree has its own copy
+    Py_DECREF(P);
+    Py_DECREF(T);
+    Py_DECREF(C);
+    // Check for errors
+    if (ierr == capeBVH_ERR_INDEX) {
+        free(b);
+        PyErr_SetString(PyExc_ValueError, "Tri node index out of range.");
+        return NULL;
+    } else if (ierr) {
+        free(b);
+        return PyErr_NoMemory();
+    }
+    
+    // Capsule owns tree from here on
+    cap = PyCapsule_New((void *) b, capeBVH_CAPSULE, cape_BVHCapsuleDel);
+    if (cap == NULL) {
+        capec_BVHFree(b);
+        free(b);
+    }
+    return cap;
+}
+
+
+// Function to find nearest tris to points
+PyObject *
+cape_TriBVHNearest(PyObject *self, PyObject *args)
+{
+    int ncomp = 1;
+    int nthread = 0;
+    npy_intp dims[2];
+    capecBVH *b;
+    capecBVHHits h;
+    PyObject *cap, *oX;
+    PyArrayObject *X;
+    PyObject *K, *C, *D, *Z, *T;
+    
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "OO|ii", &cap, &oX, &ncomp, &nthread)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.TriBVHNearest`");
+        return NULL;
+    }
+    // Get tree
+    b = (capecBVH *) PyCapsule_GetPointer(cap, capeBVH_CAPSULE);
+    if (b == NULL) {
+        return NULL;
+    }
+    // Check number of components
+    if (ncomp < 1 || ncomp > capeBVH_NCOMP) {
+        PyErr_Format(PyExc_ValueError, \
+            "Number of components must be 1 to %i", capeBVH_NCOMP);
+        return NULL;
+    }
+    // Aligned, native points
+    X = capec_PinArray(oX, NPY_DOUBLE, 2);
+    if (X == NULL) {
+        return NULL;
+    }
+    if (PyArray_DIM(X, 1) != 3) {
+        PyErr_SetString(PyExc_ValueError, "Points must be an Nx3 array.");
+        Py_DECREF(X);
+        return NULL;
+    }
+    
+    // Allocate outputs
+    dims[0] = PyArray_DIM(X, 0);
+    dims[1] = ncomp;
+    K = PyArray_SimpleNew(2, dims, NPY_INT);
+    C = PyArray_SimpleNew(2, dims, NPY_INT);
+    D = PyArray_SimpleNew(2, dims, NPY_DOUBLE);
+    Z = PyArray_SimpleNew(2, dims, NPY_DOUBLE);
+    T = PyArray_SimpleNew(2, dims, NPY_DOUBLE);
+    if (K == NULL || C == NULL || D == NULL || Z == NULL || T == NULL) {
+        Py_XDECREF(K);
+        Py_XDECREF(C);
+        Py_XDECREF(D);
+        Py_XDECREF(Z);
+        Py_XDECREF(T);
+        Py_DECREF(X);
+        return NULL;
+    }
+    h.K = (int *)    PyArray_DATA((PyArrayObject *) K);
+    h.C = (int *)    PyArray_DATA((PyArrayObject *) C);
+    h.D = (double *) PyArray_DATA((PyArrayObject *) D);
+    h.Z = (double *) PyArray_DATA((PyArrayObject *) Z);
+    h.T = (double *) PyArray_DATA((PyArrayObject *) T);
+    
+    // Search without the GIL; capsule reference keeps tree alive
+    Py_BEGIN_ALLOW_THREADS
+    capec_BVHNearest(b, (const double *) PyArray_DATA(X),
+        (size_t) PyArray_DIM(X, 0), ncomp, &h, nthread);
+    Py_END_ALLOW_THREADS
+    
+    // Release input
+    Py_DECREF(X);
+    // Output
+    return Py_BuildValue("NNNNN", K, C, D, Z, T);
+}
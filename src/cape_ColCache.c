@@ -0,0 +1,335 @@
+#include <Python.h>
+
+#if PY_MINOR_VERSION >= 10
+    #define NPY_NO_DEPRECATED_API NPY_2_0_API_VERSION
+#else
+    #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#endif
+#define PY_ARRAY_UNIQUE_SYMBOL _cape_ARRAY_API
+#define NO_IMPORT_ARRAY
+#include <numpy/arrayobject.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// Local includes
+#include "capec_BaseFile.h"
+#include "capec_Memory.h"
+#include "capec_Map.h"
+#include "capec_io.h"
+#include "capec_ColCache.h"
+
+
+// Pack list of strings as offsets and UTF-8 text
+static int
+cape_ColCachePackStr(PyObject *V, size_t nrow, uint64_t **offsets,
+    char **blob, size_t *nblob)
+{
+    size_t i, n;
+    Py_ssize_t m;
+    const char *s;
+    PyObject *v;
+    
+    // Initialize
+    *offsets = NULL;
+    *blob = NULL;
+    *nblob = 0;
+    if (!PyList_Check(V) || (size_t) PyList_GET_SIZE(V) != nrow) {
+        PyErr_SetString(PyExc_TypeError,
+            "String column must be a list with one entry for each row");
+        return 1;
+    }
+    // Offsets of each entry
+    *offsets = (uint64_t *) malloc((nrow + 1)*sizeof(uint64_t));
+    if (*offsets == NULL) {
+        PyErr_NoMemory();
+        return 1;
+    }
+    (*offsets)[0] = 0;
+    for (n=0, i=0; i<nrow; i++) {
+        v = PyList_GET_ITEM(V, i);
+        if (!PyUnicode_Check(v) ||
+                PyUnicode_AsUTF8AndSize(v, &m) == NULL) {
+            PyErr_Format(PyExc_TypeError,
+                "Entry %li of string column is not a str", (long) i);
+            return 1;
+        }
+        n += (size_t) m;
+        (*offsets)[i + 1] = (uint64_t) n;
+    }
+    // Text of all entries
+    *blob = (char *) malloc(n + 1);
+    if (*blob == NULL) {
+        PyErr_NoMemory();
+        return 1;
+    }
+    for (i=0; i<nrow; i++) {
+        s = PyUnicode_AsUTF8AndSize(PyList_GET_ITEM(V, i), &m);
+        memcpy(*blob + (*offsets)[i], s, (size_t) m);
+    }
+    *nblob = n;
+    return 0;
+}
+
+
+// Function to write binary cache of a data file's columns
+PyObject *
+cape_ColCacheWrite(PyObject *self, PyObject *args)
+{
+    int ierr;
+    int *DTYPES = NULL;
+    size_t j, nrow;
+    Py_ssize_t ncol, n;
+    char **bufs = NULL;
+    const char *fname, *fsrc;
+    PyObject *db, *cols, *col, *V;
+    PyArrayObject **A = NULL;
+    capecColCacheSrc src;
+    capecColCacheItem *items = NULL;
+    
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "Oss", &db, &fname, &fsrc)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.ColCacheWrite`");
+        return NULL;
+    }
+    // Get data types
+    if (capeFILE_GetDTypes(db, &ncol, &DTYPES))
+        return NULL;
+    cols = PyObject_GetAttrString(db, "cols");
+    if (cols == NULL) {
+        capec_Del1D(DTYPES);
+        return NULL;
+    }
+    // Work arrays
+    items = (capecColCacheItem *) calloc(ncol + 1, sizeof(*items));
+    A = (PyArrayObject **) calloc(ncol + 1, sizeof(*A));
+    bufs = (char **) calloc(2*ncol + 1, sizeof(*bufs));
+    ierr = (items == NULL || A == NULL || bufs == NULL);
+    if (ierr)
+        PyErr_NoMemory();
+    
+    // Get pointer to data of each column
+    nrow = 0;
+    for (j=0; j<(size_t) ncol && !ierr; j++) {
+        col = PyList_GET_ITEM(cols, j);
+        V = PyDict_GetItem(db, col);
+        if (V == NULL) {
+            PyErr_Format(PyExc_KeyError, "No data for column %i", (int) j);
+            ierr = 1;
+            break;
+        }
+        // Number of rows from first column
+        n = PyObject_Length(V);
+        if (j == 0 && n >= 0)
+            nrow = (size_t) n;
+        if (n < 0 || (size_t) n != nrow) {
+            PyErr_Format(PyExc_ValueError,
+                "Column %i does not have %li rows", (int) j, (long) nrow);
+            ierr = 1;
+            break;
+        }
+        // Name
+        items[j].dtype = DTYPES[j];
+        items[j].name = PyUnicode_AsUTF8AndSize(col, &n);
+        items[j].nname = (size_t) n;
+        if (items[j].name == NULL) {
+            ierr = 1;
+        } else if (DTYPES[j] == capeDTYPE_str) {
+            // Offsets and text of strings
+            ierr = cape_ColCachePackStr(V, nrow, (uint64_t **) &bufs[2*j],
+                &bufs[2*j + 1], &items[j].nblob);
+            items[j].data = bufs[2*j];
+            items[j].ndata = (nrow + 1)*sizeof(uint64_t);
+            items[j].blob = bufs[2*j + 1];
+        } else if (capeFILE_TypeNum(DTYPES[j]) < 0) {
+            PyErr_Format(PyExc_NotImplementedError,
+                "Caching DTYPE %i not implemented", DTYPES[j]);
+            ierr = 1;
+        } else {
+            // Contiguous native array
+            A[j] = capec_PinArray(V, capeFILE_TypeNum(DTYPES[j]), 1);
+            ierr = (A[j] == NULL);
+            if (!ierr) {
+                items[j].data = PyArray_DATA(A[j]);
+                items[j].ndata = (size_t) PyArray_NBYTES(A[j]);
+            }
+        }
+    }
+    // Signature of source file
+    if (!ierr && capec_ColCacheSource(fsrc, &src)) {
+        PyErr_Format(PyExc_IOError,
+            "Could not read source file '%s'", fsrc);
+        ierr = 1;
+    }
+    
+    // Write without the GIL
+    if (!ierr) {
+        Py_BEGIN_ALLOW_THREADS
+        ierr = capec_ColCacheWrite(fname, &src, nrow, items, (size_t) ncol);
+        Py_END_ALLOW_THREADS
+        if (ierr == capeCOLCACHE_ERR_MEM) {
+            PyErr_NoMemory();
+        } else if (ierr) {
+            PyErr_Format(PyExc_IOError,
+                "Could not write cache file '%s'", fname);
+        }
+    }
+    // Cleanup
+    for (j=0; A != NULL && j<(size_t) ncol; j++)
+        Py_XDECREF(A[j]);
+    for (j=0; bufs != NULL && j<2*(size_t) ncol; j++)
+        free(bufs[j]);
+    free(A);
+    free(bufs);
+    free(items);
+    Py_DECREF(cols);
+    capec_Del1D(DTYPES);
+    if (ierr)
+        return NULL;
+    Py_RETURN_NONE;
+}
+
+
+// Create one column from mapped cache
+static PyObject *
+cape_ColCacheColumn(PyObject *cap, const char *data, size_t nrow,
+    const capecColCacheCol *c)
+{
+    int typenum;
+    size_t i;
+    npy_intp dims[1];
+    uint64_t o0, o1;
+    const uint64_t *offsets;
+    PyObject *V, *v;
+    
+    // Strings
+    if (c->dtype == capeDTYPE_str) {
+        // Check offsets
+        offsets = (const uint64_t *) (data + c->data);
+        if (c->ndata != (nrow + 1)*sizeof(uint64_t) || offsets[0] != 0 ||
+                offsets[nrow] > c->nblob)
+            return NULL;
+        V = PyList_New((Py_ssize_t) nrow);
+        for (i=0; V != NULL && i<nrow; i++) {
+            o0 = offsets[i];
+            o1 = offsets[i + 1];
+            v = (o1 < o0 || o1 > c->nblob) ? NULL :
+                PyUnicode_DecodeUTF8(data + c->blob + o0,
+                    (Py_ssize_t) (o1 - o0), "strict");
+            if (v == NULL) {
+                Py_CLEAR(V);
+                break;
+            }
+            PyList_SET_ITEM(V, i, v);
+        }
+        return V;
+    }
+    // View into mapping; safe because caches are only ever replaced by
+    // renaming a new file over them, never rewritten in place
+    typenum = capeFILE_TypeNum(c->dtype);
+    if (typenum < 0)
+        return NULL;
+    dims[0] = (npy_intp) nrow;
+    V = PyArray_SimpleNewFromData(1, dims, typenum,
+        (void *) (data + c->data));
+    if (V == NULL)
+        return NULL;
+    // Check size and keep the mapping alive with the array
+    if ((size_t) PyArray_NBYTES((PyArrayObject *) V) != c->ndata) {
+        Py_DECREF(V);
+        return NULL;
+    }
+    Py_INCREF(cap);
+    if (PyArray_SetBaseObject((PyArrayObject *) V, cap)) {
+        Py_DECREF(V);
+        return NULL;
+    }
+    return V;
+}
+
+
+// Function to read columns from binary cache of a data file
+PyObject *
+cape_ColCacheRead(PyObject *self, PyObject *args)
+{
+    int ierr;
+    int *DTYPES = NULL;
+    size_t j, nrow;
+    Py_ssize_t ncol, n;
+    const char *fname, *fsrc, *name;
+    char *data;
+    PyObject *db, *cols, *vals, *cap, *V;
+    capecMap m;
+    capecColCacheSrc src;
+    capecColCacheHead h;
+    capecColCacheCol c;
+    
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "Oss", &db, &fname, &fsrc)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.ColCacheRead`");
+        return NULL;
+    }
+    // Get data types that header of source calls for
+    if (capeFILE_GetDTypes(db, &ncol, &DTYPES))
+        return NULL;
+    // Missing source or cache is not an error
+    if (capec_ColCacheSource(fsrc, &src) || capec_MapOpen(&m, fname)) {
+        PyErr_Clear();
+        capec_Del1D(DTYPES);
+        Py_RETURN_FALSE;
+    }
+    // Check header and table
+    ierr = capec_ColCacheCheck(m.data, m.size, &src);
+    if (!ierr) {
+        memcpy(&h, m.data, sizeof(h));
+        ierr = (h.ncol != (uint64_t) ncol) || (h.nrow > m.size);
+    }
+    data = m.data;
+    cap = ierr ? NULL : capec_MapCapsule(&m);
+    if (cap == NULL) {
+        PyErr_Clear();
+        capec_MapClose(&m);
+        capec_Del1D(DTYPES);
+        Py_RETURN_FALSE;
+    }
+    nrow = (size_t) h.nrow;
+    
+    // Create each column, checking names and types
+    cols = PyObject_GetAttrString(db, "cols");
+    vals = (cols == NULL) ? NULL : PyList_New(ncol);
+    for (j=0; vals != NULL && j<(size_t) ncol; j++) {
+        memcpy(&c, data + sizeof(h) + j*sizeof(c), sizeof(c));
+        name = PyUnicode_AsUTF8AndSize(PyList_GET_ITEM(cols, j), &n);
+        V = NULL;
+        if (name != NULL && c.dtype == DTYPES[j] &&
+                (size_t) n == c.nname && !memcmp(name, data + c.name, n))
+            V = cape_ColCacheColumn(cap, data, nrow, &c);
+        if (V == NULL) {
+            Py_CLEAR(vals);
+            break;
+        }
+        PyList_SET_ITEM(vals, j, V);
+    }
+    Py_DECREF(cap);
+    capec_Del1D(DTYPES);
+    // Cache doesn't match header of source
+    if (vals == NULL) {
+        Py_XDECREF(cols);
+        PyErr_Clear();
+        Py_RETURN_FALSE;
+    }
+    // Save columns
+    for (j=0, ierr=0; j<(size_t) ncol && !ierr; j++) {
+        ierr = PyDict_SetItem(db, PyList_GET_ITEM(cols, j),
+            PyList_GET_ITEM(vals, j));
+    }
+    Py_DECREF(vals);
+    Py_DECREF(cols);
+    if (ierr)
+        return NULL;
+    Py_RETURN_TRUE;
+}
@@ -0,0 +1,318 @@
+#include <Python.h>
+
+#if PY_MINOR_VERSION >= 10
+    #define NPY_NO_DEPRECATED_API NPY_2_0_API_VERSION
+#else
+    #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#endif
+#define PY_ARRAY_UNIQUE_SYMBOL _cape_ARRAY_API
+#define NO_IMPORT_ARRAY
+#include <numpy/arrayobject.h>
+#include <stdlib.h>
+
+// Local includes
+#include "capec_io.h"
+#include "capec_Geom.h"
+
+// Largest range of component IDs for dense sums
+#define capeGEOM_NCOMPMAX (1 << 24)
+
+
+// Pin nodes and tris, checking for Nx3 arrays
+static int
+cape_GeomPin(PyObject *oP, PyObject *oT, PyArrayObject **P,
+    PyArrayObject **T)
+{
+    // Aligned, native double nodes
+    *T = NULL;
+    *P = capec_PinArray(oP, NPY_DOUBLE, 2);
+    if (*P == NULL) {
+        return 1;
+    }
+    // Aligned, native int tris
+    *T = capec_PinArray(oT, NPY_INT, 2);
+    if (*T == NULL) {
+        Py_CLEAR(*P);
+        return 1;
+    }
+    // Check dimensions
+    if (PyArray_DIM(*P, 1) != 3 || PyArray_DIM(*T, 1) != 3) {
+        PyErr_SetString(PyExc_ValueError, \
+            "Nodes and tris must be Nx3 arrays.");
+        Py_CLEAR(*P);
+        Py_CLEAR(*T);
+        return 1;
+    }
+    return 0;
+}
+
+// Check tri node indices without the GIL
+static int
+cape_GeomCheck(PyArrayObject *P, PyArrayObject *T)
+{
+    int ierr;
+    
+    // Loop through indices
+    Py_BEGIN_ALLOW_THREADS
+    ierr = capec_TriCheck((const int *) PyArray_DATA(T),
+        (size_t) PyArray_DIM(T, 0), (size_t) PyArray_DIM(P, 0));
+    Py_END_ALLOW_THREADS
+    // Error message
+    if (ierr) {
+        PyErr_SetString(PyExc_ValueError, \
+            "Tri node index out of range.");
+    }
+    return ierr;
+}
+
+
+// Function to compute geometry of each tri
+PyObject *
+cape_TriGeom(PyObject *self, PyObject *args)
+{
+    int nthread = 0;
+    size_t nTri;
+    npy_intp dims[2];
+    capecTriGeom g;
+    PyObject *oP, *oT;
+    PyArrayObject *P, *T;
+    PyObject *X, *N, *A, *AV, *L;
+    
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "OO|i", &oP, &oT, &nthread)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.TriGeom`");
+        return NULL;
+    }
+    // Pin and check arrays
+    if (cape_GeomPin(oP, oT, &P, &T)) {
+        return NULL;
+    }
+    if (cape_GeomCheck(P, T)) {
+        Py_DECREF(P);
+        Py_DECREF(T);
+        return NULL;
+    }
+    
+    // Allocate outputs
+    nTri = (size_t) PyArray_DIM(T, 0);
+    dims[0] = (npy_intp) nTri;
+    dims[1] = 3;
+    X  = PyArray_SimpleNew(2, dims, NPY_DOUBLE);
+    N  = PyArray_SimpleNew(2, dims, NPY_DOUBLE);
+    A  = PyArray_SimpleNew(1, dims, NPY_DOUBLE);
+    AV = PyArray_SimpleNew(2, dims, NPY_DOUBLE);
+    L  = PyArray_SimpleNew(2, dims, NPY_DOUBLE);
+    if (X == NULL || N == NULL || A == NULL || AV == NULL || L == NULL) {
+        Py_XDECREF(X);
+        Py_XDECREF(N);
+        Py_XDECREF(A);
+        Py_XDECREF(AV);
+        Py_XDECREF(L);
+        Py_DECREF(P);
+        Py_DECREF(T);
+        return NULL;
+    }
+    g.centers  = (double *) PyArray_DATA((PyArrayObject *) X);
+    g.normals  = (double *) PyArray_DATA((PyArrayObject *) N);
+    g.areas    = (double *) PyArray_DATA((PyArrayObject *) A);
+    g.areavecs = (double *) PyArray_DATA((PyArrayObject *) AV);
+    g.lengths  = (double *) PyArray_DATA((PyArrayObject *) L);
+    
+    // Compute everything in one pass without the GIL
+    Py_BEGIN_ALLOW_THREADS
+    capec_TriGeom((const double *) PyArray_DATA(P),
+        (const int *) PyArray_DATA(T), nTri, &g, nthread);
+    Py_END_ALLOW_THREADS
+    
+    // Release inputs
+    Py_DECREF(P);
+    Py_DECREF(T);
+    // Output
+    return Py_BuildValue("NNNNN", X, N, A, AV, L);
+}
+
+
+// Function to compute normals at nodes
+PyObject *
+cape_TriNodeNormals(PyObject *self, PyObject *args)
+{
+    int nthread = 0;
+    npy_intp dims[2];
+    PyObject *oP, *oT;
+    PyArrayObject *P, *T;
+    PyObject *N;
+    
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "OO|i", &oP, &oT, &nthread)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.TriNodeNormals`");
+        return NULL;
+    }
+    // Pin and check arrays
+    if (cape_GeomPin(oP, oT, &P, &T)) {
+        return NULL;
+    }
+    if (cape_GeomCheck(P, T)) {
+        Py_DECREF(P);
+        Py_DECREF(T);
+        return NULL;
+    }
+    
+    // Allocate output
+    dims[0] = PyArray_DIM(P, 0);
+    dims[1] = 3;
+    N = PyArray_SimpleNew(2, dims, NPY_DOUBLE);
+    if (N == NULL) {
+        Py_DECREF(P);
+        Py_DECREF(T);
+        return NULL;
+    }
+    
+    // Add tri area vectors to nodes and normalize without the GIL
+    Py_BEGIN_ALLOW_THREADS
+    capec_TriNodeNormals((const double *) PyArray_DATA(P),
+        (size_t) PyArray_DIM(P, 0), (const int *) PyArray_DATA(T),
+        (size_t) PyArray_DIM(T, 0),
+        (double *) PyArray_DATA((PyArrayObject *) N), nthread);
+    Py_END_ALLOW_THREADS
+    
+    // Release inputs
+    Py_DECREF(P);
+    Py_DECREF(T);
+    // Output
+    return N;
+}
+
+
+// Function to compute area, area vector, and centroid of each component
+PyObject *
+cape_TriCompGeom(PyObject *self, PyObject *args)
+{
+    int nthread = 0;
+    int ierr;
+    int cmin, cmax;
+    size_t i, j, n, nTri, ncomp;
+    npy_intp dims[2];
+    const int *c;
+    double *S, *s;
+    int *vI;
+    double *vA, *vAV, *vX;
+    PyObject *oP, *oT, *oC;
+    PyArrayObject *P, *T, *C;
+    PyObject *I, *A, *AV, *X;
+    
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "OOO|i", &oP, &oT, &oC, &nthread)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.TriCompGeom`");
+        return NULL;
+    }
+    // Pin and check arrays
+    if (cape_GeomPin(oP, oT, &P, &T)) {
+        return NULL;
+    }
+    C = capec_PinArray(oC, NPY_INT, 1);
+    if (C == NULL || cape_GeomCheck(P, T)) {
+        Py_DECREF(P);
+        Py_DECREF(T);
+        Py_XDECREF(C);
+        return NULL;
+    }
+    // Number of tris
+    nTri = (size_t) PyArray_DIM(T, 0);
+    if ((size_t) PyArray_DIM(C, 0) != nTri) {
+        PyErr_SetString(PyExc_ValueError, \
+            "Component IDs must have one entry per tri.");
+        Py_DECREF(P);
+        Py_DECREF(T);
+        Py_DECREF(C);
+        return NULL;
+    }
+    
+    // Range of component IDs
+    c = (const int *) PyArray_DATA(C);
+    cmin = (nTri > 0) ? c[0] : 0;
+    cmax = cmin;
+    for (i=1; i<nTri; i++) {
+        if (c[i] < cmin) {cmin = c[i]; }
+        if (c[i] > cmax) {cmax = c[i]; }
+    }
+    ncomp = (nTri > 0) ? (size_t) ((long) cmax - (long) cmin) + 1 : 0;
+    // Allocate table of sums
+    S = NULL;
+    if (ncomp > capeGEOM_NCOMPMAX) {
+        PyErr_Format(PyExc_ValueError, \
+            "Range of component IDs (%i to %i) is too large", cmin, cmax);
+        ierr = 1;
+    } else {
+        S = (double *) malloc((ncomp + 1) * capeGEOM_NCOMPSUM *
+            sizeof(double));
+        ierr = (S == NULL);
+        if (ierr) {
+            PyErr_NoMemory();
+        }
+    }
+    
+    // Add each tri to its component without the GIL
+    if (!ierr) {
+        Py_BEGIN_ALLOW_THREADS
+        capec_TriCompSums((const double *) PyArray_DATA(P),
+            (const int *) PyArray_DATA(T), c, nTri, cmin, ncomp, S,
+            nthread);
+        Py_END_ALLOW_THREADS
+    }
+    // Release inputs
+    Py_DECREF(P);
+    Py_DECREF(T);
+    Py_DECREF(C);
+    if (ierr) {
+        return NULL;
+    }
+    
+    // Count components that have tris
+    for (j=0, n=0; j<ncomp; j++) {
+        if (S[capeGEOM_NCOMPSUM*j + 7] > 0) {n++; }
+    }
+    // Allocate outputs
+    dims[0] = (npy_intp) n;
+    dims[1] = 3;
+    I  = PyArray_SimpleNew(1, dims, NPY_INT);
+    A  = PyArray_SimpleNew(1, dims, NPY_DOUBLE);
+    AV = PyArray_SimpleNew(2, dims, NPY_DOUBLE);
+    X  = PyArray_SimpleNew(2, dims, NPY_DOUBLE);
+    if (I == NULL || A == NULL || AV == NULL || X == NULL) {
+        Py_XDECREF(I);
+        Py_XDECREF(A);
+        Py_XDECREF(AV);
+        Py_XDECREF(X);
+        free(S);
+        return NULL;
+    }
+    vI  = (int *)    PyArray_DATA((PyArrayObject *) I);
+    vA  = (double *) PyArray_DATA((PyArrayObject *) A);
+    vAV = (double *) PyArray_DATA((PyArrayObject *) AV);
+    vX  = (double *) PyArray_DATA((PyArrayObject *) X);
+    // Copy sums of present components
+    for (j=0, i=0; j<ncomp; j++) {
+        s = S + capeGEOM_NCOMPSUM*j;
+        if (s[7] <= 0) {continue; }
+        vI[i] = cmin + (int) j;
+        vA[i] = s[0];
+        vAV[3*i]     = s[1];
+        vAV[3*i + 1] = s[2];
+        vAV[3*i + 2] = s[3];
+        vX[3*i]     = s[4] / s[0];
+        vX[3*i + 1] = s[5] / s[0];
+        vX[3*i + 2] = s[6] / s[0];
+        i++;
+    }
+    
+    // Release table
+    free(S);
+    // Output
+    return Py_BuildValue("NNNN", I, A, AV, X);
+}
@@ -0,0 +1,348 @@
+#include <Python.h>
+
+#if PY_MINOR_VERSION >= 10
+    #define NPY_NO_DEPRECATED_API NPY_2_0_API_VERSION
+#else
+    #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#endif
+#define PY_ARRAY_UNIQUE_SYMBOL _cape_ARRAY_API
+#define NO_IMPORT_ARRAY
+#include <numpy/arrayobject.h>
+
+// Local includes
+#include "capec_io.h"
+#include "capec_Interp.h"
+
+
+// Pin a sequence of *n* 1D arrays of the same size
+static int
+cape_InterpPinArgs(PyObject *oX, Py_ssize_t n, PyArrayObject **A,
+    const double **X, size_t *nx)
+{
+    Py_ssize_t k;
+    PyObject *L;
+    
+    // Get sequence
+    L = PySequence_Fast(oX, "Query points must be a sequence of arrays.");
+    if (L == NULL) {
+        return 1;
+    }
+    if (PySequence_Fast_GET_SIZE(L) != n) {
+        PyErr_Format(PyExc_ValueError,
+            "Expected %li arrays of query points; got %li",
+            (long) n, (long) PySequence_Fast_GET_SIZE(L));
+        Py_DECREF(L);
+        return 1;
+    }
+    // Aligned, native double values of each arg
+    for (k=0; k<n; k++) {
+        A[k] = capec_PinArray(PySequence_Fast_GET_ITEM(L, k), NPY_DOUBLE, 1);
+        if (A[k] == NULL) {
+            break;
+        }
+        X[k] = (const double *) PyArray_DATA(A[k]);
+        // Check size
+        if (k == 0) {
+            *nx = (size_t) PyArray_DIM(A[0], 0);
+        } else if ((size_t) PyArray_DIM(A[k], 0) != *nx) {
+            PyErr_Format(PyExc_ValueError,
+                "Query arg %li has size %li; expected %li",
+                (long) k, (long) PyArray_DIM(A[k], 0), (long) *nx);
+            Py_DECREF(A[k]);
+            break;
+        }
+    }
+    Py_DECREF(L);
+    // Release pinned arrays on failure
+    if (k < n) {
+        while (k > 0) {
+            Py_DECREF(A[--k]);
+        }
+        return 1;
+    }
+    if (n == 0) {
+        *nx = 0;
+    }
+    return 0;
+}
+
+// Release *n* pinned arrays
+static void
+cape_InterpRelease(PyArrayObject **A, Py_ssize_t n)
+{
+    Py_ssize_t k;
+    
+    for (k=0; k<n; k++) {
+        Py_XDECREF(A[k]);
+    }
+}
+
+
+// Function to find break point interval of many values
+PyObject *
+cape_BkptIndex(PyObject *self, PyObject *args)
+{
+    double tol = 1e-5;
+    size_t n, nx;
+    npy_intp dims[1];
+    PyObject *oV, *ox;
+    PyArrayObject *V, *x;
+    PyObject *I, *F;
+    
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "OO|d", &oV, &ox, &tol)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.BkptIndex`");
+        return NULL;
+    }
+    // Pin break points and values
+    V = capec_PinArray(oV, NPY_DOUBLE, 1);
+    x = (V == NULL) ? NULL : capec_PinArray(ox, NPY_DOUBLE, 1);
+    if (x == NULL) {
+        Py_XDECREF(V);
+        return NULL;
+    }
+    n = (size_t) PyArray_DIM(V, 0);
+    nx = (size_t) PyArray_DIM(x, 0);
+    if (n < 2) {
+        PyErr_SetString(PyExc_ValueError, \
+            "Break points must have at least two entries.");
+        Py_DECREF(V);
+        Py_DECREF(x);
+        return NULL;
+    }
+    
+    // Allocate outputs
+    dims[0] = (npy_intp) nx;
+    I = PyArray_SimpleNew(1, dims, NPY_LONG);
+    F = PyArray_SimpleNew(1, dims, NPY_DOUBLE);
+    if (I == NULL || F == NULL) {
+        Py_XDECREF(I);
+        Py_XDECREF(F);
+        Py_DECREF(V);
+        Py_DECREF(x);
+        return NULL;
+    }
+    
+    // Search without the GIL
+    Py_BEGIN_ALLOW_THREADS
+    capec_BkptIndex((const double *) PyArray_DATA(V), n,
+        (const double *) PyArray_DATA(x), nx, tol,
+        (long *) PyArray_DATA((PyArrayObject *) I),
+        (double *) PyArray_DATA((PyArrayObject *) F));
+    Py_END_ALLOW_THREADS
+    
+    // Release inputs
+    Py_DECREF(V);
+    Py_DECREF(x);
+    // Output
+    return Py_BuildValue("NN", I, F);
+}
+
+
+// Function to evaluate multilinear interpolation at many points
+PyObject *
+cape_MultilinearEval(PyObject *self, PyObject *args)
+{
+    int a, ierr;
+    int extrap = capeINTERP_HOLD;
+    int nthread = 0;
+    double tol = 1e-5;
+    double v, dv;
+    size_t nx, nv, ibad;
+    Py_ssize_t nk;
+    npy_intp dims[1];
+    capecInterpTable t;
+    const double *X[capeINTERP_MAXARG];
+    PyObject *obkpts, *oV, *oX, *L, *Y;
+    PyArrayObject *V;
+    PyArrayObject *B[capeINTERP_MAXARG];
+    PyArrayObject *A[capeINTERP_MAXARG];
+    
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "OOO|idi",
+            &obkpts, &oV, &oX, &extrap, &tol, &nthread)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.MultilinearEval`");
+        return NULL;
+    }
+    // Check extrapolation option
+    if (extrap < capeINTERP_ERROR || extrap > capeINTERP_LINEAR) {
+        PyErr_Format(PyExc_ValueError,
+            "Invalid extrapolation option %i", extrap);
+        return NULL;
+    }
+    // Get list of break points
+    L = PySequence_Fast(obkpts, "Break points must be a sequence of arrays.");
+    if (L == NULL) {
+        return NULL;
+    }
+    nk = PySequence_Fast_GET_SIZE(L);
+    if (nk < 1 || nk > capeINTERP_MAXARG) {
+        PyErr_Format(PyExc_ValueError,
+            "Number of args must be from 1 to %i; got %li",
+            capeINTERP_MAXARG, (long) nk);
+        Py_DECREF(L);
+        return NULL;
+    }
+    // Pin break points of each arg
+    for (a=0, nv=1; a<nk; a++) {
+        B[a] = capec_PinArray(PySequence_Fast_GET_ITEM(L, a), NPY_DOUBLE, 1);
+        if (B[a] == NULL) {
+            break;
+        }
+        t.bkpts[a] = (const double *) PyArray_DATA(B[a]);
+        t.nb[a] = (size_t) PyArray_DIM(B[a], 0);
+        nv *= t.nb[a];
+        if (t.nb[a] < 2) {
+            PyErr_Format(PyExc_ValueError,
+                "Break points of arg %i must have at least two entries", a);
+            Py_DECREF(B[a]);
+            break;
+        }
+    }
+    Py_DECREF(L);
+    if (a < nk) {
+        cape_InterpRelease(B, a);
+        return NULL;
+    }
+    // Pin values
+    V = capec_PinArray(oV, NPY_DOUBLE, 1);
+    if (V == NULL) {
+        cape_InterpRelease(B, nk);
+        return NULL;
+    }
+    if ((size_t) PyArray_DIM(V, 0) != nv) {
+        PyErr_Format(PyExc_ValueError,
+            "Values have size %li, but break points have %li combinations",
+            (long) PyArray_DIM(V, 0), (long) nv);
+        Py_DECREF(V);
+        cape_InterpRelease(B, nk);
+        return NULL;
+    }
+    // Pin query points
+    if (cape_InterpPinArgs(oX, nk, A, X, &nx)) {
+        Py_DECREF(V);
+        cape_InterpRelease(B, nk);
+        return NULL;
+    }
+    // Finish table
+    t.nk = (int) nk;
+    t.V = (const double *) PyArray_DATA(V);
+    t.extrap = extrap;
+    t.tol = tol;
+    
+    // Allocate output
+    dims[0] = (npy_intp) nx;
+    Y = PyArray_SimpleNew(1, dims, NPY_DOUBLE);
+    ierr = (Y == NULL);
+    // Interpolate without the GIL
+    if (!ierr) {
+        Py_BEGIN_ALLOW_THREADS
+        ierr = capec_Multilinear(&t, X, nx,
+            (double *) PyArray_DATA((PyArrayObject *) Y), &ibad, nthread);
+        Py_END_ALLOW_THREADS
+        // Find which arg of bad point is out of range
+        for (a=0; ierr && a<nk; a++) {
+            v = X[a][ibad];
+            dv = tol * (t.bkpts[a][t.nb[a]-1] - t.bkpts[a][0]);
+            if (v < t.bkpts[a][0] - dv || v > t.bkpts[a][t.nb[a]-1] + dv) {
+                break;
+            }
+        }
+        if (ierr) {
+            PyErr_Format(PyExc_ValueError,
+                "Arg %i of point %li is outside break points",
+                a, (long) ibad);
+            Py_DECREF(Y);
+        }
+    }
+    // Release inputs
+    Py_DECREF(V);
+    cape_InterpRelease(B, nk);
+    cape_InterpRelease(A, nk);
+    if (ierr) {
+        return NULL;
+    }
+    // Output
+    return Y;
+}
+
+
+// Function to evaluate radial basis function at many points
+PyObject *
+cape_RBFEval(PyObject *self, PyObject *args)
+{
+    int nthread = 0;
+    size_t nx;
+    Py_ssize_t nd;
+    npy_intp dims[1];
+    const char *func;
+    capecRBF r;
+    const double *X[capeINTERP_MAXARG];
+    PyObject *oxi, *onodes, *oX, *Y;
+    PyArrayObject *xi, *w;
+    PyArrayObject *A[capeINTERP_MAXARG];
+    
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "OOsdO|i",
+            &oxi, &onodes, &func, &r.eps, &oX, &nthread)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.RBFEval`");
+        return NULL;
+    }
+    // Basis function
+    r.func = capec_RBFFunc(func);
+    if (r.func < 0) {
+        PyErr_Format(PyExc_ValueError,
+            "Unknown radial basis function '%s'", func);
+        return NULL;
+    }
+    // Pin centers and weights
+    xi = capec_PinArray(oxi, NPY_DOUBLE, 2);
+    w = (xi == NULL) ? NULL : capec_PinArray(onodes, NPY_DOUBLE, 1);
+    if (w == NULL) {
+        Py_XDECREF(xi);
+        return NULL;
+    }
+    nd = (Py_ssize_t) PyArray_DIM(xi, 0);
+    r.n = (size_t) PyArray_DIM(xi, 1);
+    if (nd < 1 || nd > capeINTERP_MAXARG ||
+            (size_t) PyArray_DIM(w, 0) != r.n) {
+        PyErr_Format(PyExc_ValueError,
+            "RBF centers must be (nd, n) with 1 <= nd <= %i and n weights",
+            capeINTERP_MAXARG);
+        Py_DECREF(xi);
+        Py_DECREF(w);
+        return NULL;
+    }
+    // Pin query points
+    if (cape_InterpPinArgs(oX, nd, A, X, &nx)) {
+        Py_DECREF(xi);
+        Py_DECREF(w);
+        return NULL;
+    }
+    r.nd = (int) nd;
+    r.xi = (const double *) PyArray_DATA(xi);
+    r.nodes = (const double *) PyArray_DATA(w);
+    
+    // Allocate output
+    dims[0] = (npy_intp) nx;
+    Y = PyArray_SimpleNew(1, dims, NPY_DOUBLE);
+    // Evaluate without the GIL
+    if (Y != NULL) {
+        Py_BEGIN_ALLOW_THREADS
+        capec_RBFEval(&r, X, nx,
+            (double *) PyArray_DATA((PyArrayObject *) Y), nthread);
+        Py_END_ALLOW_THREADS
+    }
+    // Release inputs
+    Py_DECREF(xi);
+    Py_DECREF(w);
+    cape_InterpRelease(A, nd);
+    // Output
+    return Y;
+}
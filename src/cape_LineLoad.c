@@ -0,0 +1,195 @@
+#include <Python.h>
+
+#if PY_MINOR_VERSION >= 10
+    #define NPY_NO_DEPRECATED_API NPY_2_0_API_VERSION
+#else
+    #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#endif
+#define PY_ARRAY_UNIQUE_SYMBOL _cape_ARRAY_API
+#define NO_IMPORT_ARRAY
+#include <numpy/arrayobject.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Local includes
+#include "capec_io.h"
+#include "capec_Geom.h"
+#include "capec_LineLoad.h"
+
+// Largest range of component IDs for dense sums
+#define capeLINELOAD_NCOMPMAX (1 << 20)
+
+
+// Function to add up sectional loads by slab and component
+PyObject *
+cape_TriqLineLoads(PyObject *self, PyObject *args)
+{
+    int ierr;
+    int nthread = 0;
+    int cmin, cmax;
+    size_t i, j, n, m, nTri, ncomp, nslab;
+    npy_intp dims[3];
+    double a[3], L;
+    capecTriqFMOpts opts;
+    const int *c;
+    const double *x, *va;
+    double *S, *vS;
+    int *vI;
+    PyObject *oP, *oT, *oQ, *oC, *oX, *oA;
+    PyArrayObject *P, *T, *Q, *C, *X, *A;
+    PyObject *I, *OS;
+    
+    // Default options
+    opts.smallvol = 1e-20;
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "OOOOOOddd|di", &oP, &oT, &oQ, &oC,
+            &oX, &oA, &opts.mach, &opts.rey, &opts.gam, &opts.smallvol,
+            &nthread)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.TriqLineLoads`");
+        return NULL;
+    }
+    // Aligned, native arrays
+    P = capec_PinArray(oP, NPY_DOUBLE, 2);
+    T = (P == NULL) ? NULL : capec_PinArray(oT, NPY_INT, 2);
+    Q = (T == NULL) ? NULL : capec_PinArray(oQ, NPY_DOUBLE, 2);
+    C = (Q == NULL) ? NULL : capec_PinArray(oC, NPY_INT, 1);
+    X = (C == NULL) ? NULL : capec_PinArray(oX, NPY_DOUBLE, 1);
+    A = (X == NULL) ? NULL : capec_PinArray(oA, NPY_DOUBLE, 1);
+    if (A == NULL) {
+        Py_XDECREF(P);
+        Py_XDECREF(T);
+        Py_XDECREF(Q);
+        Py_XDECREF(C);
+        Py_XDECREF(X);
+        return NULL;
+    }
+    // Check dimensions
+    nTri = (size_t) PyArray_DIM(T, 0);
+    nslab = (PyArray_DIM(X, 0) > 0) ? (size_t) PyArray_DIM(X, 0) - 1 : 0;
+    x = (const double *) PyArray_DATA(X);
+    ierr = 0;
+    if (PyArray_DIM(P, 1) != 3 || PyArray_DIM(T, 1) != 3 ||
+            PyArray_DIM(Q, 0) != PyArray_DIM(P, 0) ||
+            (size_t) PyArray_DIM(C, 0) != nTri) {
+        PyErr_SetString(PyExc_ValueError, \
+            "Need Nx3 nodes, Mx3 tris, N rows of states, and M comp IDs.");
+        ierr = 1;
+    } else if (PyArray_DIM(A, 0) != 3) {
+        PyErr_SetString(PyExc_ValueError, "Axis must have 3 components.");
+        ierr = 1;
+    } else if (nslab < 1) {
+        PyErr_SetString(PyExc_ValueError, \
+            "Need at least two slab boundaries.");
+        ierr = 1;
+    } else if (capec_TriCheck((const int *) PyArray_DATA(T), nTri,
+            (size_t) PyArray_DIM(P, 0))) {
+        PyErr_SetString(PyExc_ValueError, "Tri node index out of range.");
+        ierr = 1;
+    }
+    // Check slab boundaries
+    for (j=0; !ierr && j<nslab; j++) {
+        if (!(x[j] < x[j + 1])) {
+            PyErr_SetString(PyExc_ValueError, \
+                "Slab boundaries must be increasing.");
+            ierr = 1;
+        }
+    }
+    // Unit vector along axis
+    va = (const double *) PyArray_DATA(A);
+    L = sqrt(va[0]*va[0] + va[1]*va[1] + va[2]*va[2]);
+    if (!ierr && !(L > 0)) {
+        PyErr_SetString(PyExc_ValueError, "Axis must be nonzero.");
+        ierr = 1;
+    }
+    for (j=0; !ierr && j<3; j++) {
+        a[j] = va[j] / L;
+    }
+    
+    // Range of component IDs
+    c = (const int *) PyArray_DATA(C);
+    cmin = (nTri > 0) ? c[0] : 0;
+    cmax = cmin;
+    for (i=1; i<nTri; i++) {
+        if (c[i] < cmin) {cmin = c[i]; }
+        if (c[i] > cmax) {cmax = c[i]; }
+    }
+    ncomp = (nTri > 0) ? (size_t) ((long) cmax - (long) cmin) + 1 : 0;
+    // Allocate table of sums
+    S = NULL;
+    m = nslab * capeTRIQFM_NSUM;
+    if (ierr) {
+        // Already failed
+    } else if (ncomp > capeLINELOAD_NCOMPMAX) {
+        PyErr_Format(PyExc_ValueError, \
+            "Range of component IDs (%i to %i) is too large", cmin, cmax);
+        ierr = 1;
+    } else {
+        S = (double *) malloc((ncomp + 1) * m * sizeof(double));
+        ierr = (S == NULL);
+        if (ierr) {
+            PyErr_NoMemory();
+        }
+    }
+    
+    // Integrate sectional loads without the GIL
+    if (!ierr) {
+        Py_BEGIN_ALLOW_THREADS
+        capec_TriqLineLoads((const double *) PyArray_DATA(P),
+            (const int *) PyArray_DATA(T), (const double *) PyArray_DATA(Q),
+            (int) PyArray_DIM(Q, 1), c, nTri, cmin, ncomp, a, x, nslab,
+            &opts, S, nthread);
+        Py_END_ALLOW_THREADS
+    }
+    // Release inputs
+    Py_DECREF(P);
+    Py_DECREF(T);
+    Py_DECREF(Q);
+    Py_DECREF(C);
+    Py_DECREF(X);
+    Py_DECREF(A);
+    if (ierr) {
+        return NULL;
+    }
+    
+    // Count components that have tris
+    for (j=0, n=0; j<ncomp; j++) {
+        for (i=0; i<nslab; i++) {
+            if (S[m*j + capeTRIQFM_NSUM*i + capeTRIQFM_N] > 0) {
+                n++;
+                break;
+            }
+        }
+    }
+    // Allocate outputs
+    dims[0] = (npy_intp) n;
+    dims[1] = (npy_intp) nslab;
+    dims[2] = capeTRIQFM_NSUM;
+    I  = PyArray_SimpleNew(1, dims, NPY_INT);
+    OS = PyArray_SimpleNew(3, dims, NPY_DOUBLE);
+    if (I == NULL || OS == NULL) {
+        Py_XDECREF(I);
+        Py_XDECREF(OS);
+        free(S);
+        return NULL;
+    }
+    vI = (int *)    PyArray_DATA((PyArrayObject *) I);
+    vS = (double *) PyArray_DATA((PyArrayObject *) OS);
+    // Copy sums of present components
+    for (j=0, n=0; j<ncomp; j++) {
+        for (i=0; i<nslab; i++) {
+            if (S[m*j + capeTRIQFM_NSUM*i + capeTRIQFM_N] > 0) {break; }
+        }
+        if (i == nslab) {continue; }
+        vI[n] = cmin + (int) j;
+        memcpy(vS + m*n, S + m*j, m*sizeof(double));
+        n++;
+    }
+    
+    // Release table
+    free(S);
+    // Output
+    return Py_BuildValue("NN", I, OS);
+}
@@ -0,0 +1,464 @@
+#include <Python.h>
+
+#if PY_MINOR_VERSION >= 10
+    #define NPY_NO_DEPRECATED_API NPY_2_0_API_VERSION
+#else
+    #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#endif
+#define PY_ARRAY_UNIQUE_SYMBOL _cape_ARRAY_API
+#define NO_IMPORT_ARRAY
+#include <numpy/arrayobject.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+// Local includes
+#include "capec_io.h"
+#include "capec_Map.h"
+#include "capec_Sink.h"
+#include "capec_P3D.h"
+
+
+// Get kind of PLOT3D file from name
+static int
+cape_P3DKind(const char *kind)
+{
+    int k;
+    
+    for (k=0; k<capeP3D_NKIND; k++) {
+        if (strcmp(kind, capeP3D_KINDS[k]) == 0) {
+            return k;
+        }
+    }
+    PyErr_Format(PyExc_ValueError,
+        "Unknown PLOT3D file kind '%s'; options are 'x', 'f', 'q'", kind);
+    return -1;
+}
+
+// Get list of grids to read from Python sequence of indices
+static int
+cape_P3DGrids(PyObject *ogrid, long ngrid, char *want)
+{
+    long i;
+    PyObject *it, *o;
+    
+    // Read all grids by default
+    memset(want, ogrid == Py_None, (size_t) ngrid);
+    if (ogrid == Py_None) {
+        return 0;
+    }
+    // Loop through indices
+    it = PyObject_GetIter(ogrid);
+    if (it == NULL) {
+        return 1;
+    }
+    while ((o = PyIter_Next(it)) != NULL) {
+        i = PyLong_AsLong(o);
+        Py_DECREF(o);
+        if (i == -1 && PyErr_Occurred()) {break; }
+        // Allow indices from the end
+        if (i < 0) {i += ngrid; }
+        if (i < 0 || i >= ngrid) {
+            PyErr_Format(PyExc_IndexError,
+                "PLOT3D grid index out of range for %li grids", ngrid);
+            break;
+        }
+        want[i] = 1;
+    }
+    Py_DECREF(it);
+    return (PyErr_Occurred() != NULL);
+}
+
+// Header dictionary of PLOT3D file
+static PyObject *
+cape_P3DHeader(const capecP3D *g, const char *data)
+{
+    int ierr, ndim, nh;
+    long i;
+    char fmt[8];
+    npy_intp dims[2];
+    PyObject *H, *D, *A;
+    
+    // Format (text layouts are not indexed)
+    if (g->ngrid > 0) {
+        capec_P3DFormatName(g, fmt);
+    } else {
+        strcpy(fmt, "ascii");
+    }
+    H = Py_BuildValue("{s:s,s:s,s:O,s:O}",
+        "kind", capeP3D_KINDS[g->kind], "fmt", fmt,
+        "multi", g->multi ? Py_True : Py_False,
+        "iblank", g->iblank ? Py_True : Py_False);
+    if (H == NULL || g->ngrid == 0) {
+        return H;
+    }
+    // Copy of dimensions
+    ndim = capec_P3DNDim(g);
+    dims[0] = (npy_intp) g->ngrid;
+    dims[1] = ndim;
+    D = PyArray_SimpleNew(2, dims, NPY_INT);
+    ierr = (D == NULL);
+    if (!ierr) {
+        memcpy(PyArray_DATA((PyArrayObject *) D), g->dims,
+            g->ngrid * ndim * sizeof(int));
+        ierr = PyDict_SetItemString(H, "dims", D);
+        Py_DECREF(D);
+    }
+    // States and per-grid headers of OVERFLOW files
+    if (!ierr && g->kind == capeP3D_Q) {
+        nh = capec_P3DNHead(g);
+        dims[1] = nh;
+        A = PyArray_SimpleNew(2, dims, NPY_DOUBLE);
+        ierr = (A == NULL);
+        for (i=0; !ierr && i<g->ngrid; i++) {
+            capec_P3DQHeader(g, data, i,
+                (double *) PyArray_DATA((PyArrayObject *) A) + nh*i);
+        }
+        if (!ierr) {
+            ierr = PyDict_SetItemString(H, "header", A);
+            Py_DECREF(A);
+        }
+        D = ierr ? NULL : Py_BuildValue("i", g->nq);
+        ierr = ierr || D == NULL || PyDict_SetItemString(H, "nq", D);
+        Py_XDECREF(D);
+        D = ierr ? NULL : Py_BuildValue("i", g->nqc);
+        ierr = ierr || D == NULL || PyDict_SetItemString(H, "nqc", D);
+        Py_XDECREF(D);
+    }
+    if (ierr) {
+        Py_DECREF(H);
+        return NULL;
+    }
+    return H;
+}
+
+// Function to read PLOT3D file
+PyObject *
+cape_ReadP3D(PyObject *self, PyObject *args)
+{
+    int kind, ndim, tf;
+    int view = 0;
+    long i;
+    char *want;
+    npy_intp dims[4];
+    const char *fname;
+    const char *skind = "x";
+    const char *fmt = NULL;
+    const int *d;
+    char *data;
+    capecMap m;
+    capecP3D g;
+    PyObject *ogrid = Py_None;
+    PyObject *cap, *base, *A, *H, *G, *B;
+    
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "s|szOp", &fname, &skind, &fmt, &ogrid,
+            &view)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.ReadP3D`");
+        return NULL;
+    }
+    // Kind of file
+    kind = cape_P3DKind(skind);
+    if (kind < 0) {
+        return NULL;
+    }
+    
+    // Map the file
+    if (capec_MapOpen(&m, fname)) {
+        return NULL;
+    }
+    // Find and check grids
+    if (capec_ParseP3D(m.data, m.size, kind, fmt, &g)) {
+        capec_MapClose(&m);
+        return NULL;
+    }
+    // Header (and per-grid headers of q files) from mapping
+    H = cape_P3DHeader(&g, m.data);
+    // Text files are left to the caller
+    if (g.ngrid == 0) {
+        capec_MapClose(&m);
+        return (H == NULL) ? NULL : Py_BuildValue("N[][]", H);
+    }
+    // Grids to read
+    want = (H == NULL) ? NULL : (char *) malloc(g.ngrid);
+    if (want == NULL || cape_P3DGrids(ogrid, g.ngrid, want)) {
+        if (H != NULL && want == NULL) {PyErr_NoMemory(); }
+        Py_XDECREF(H);
+        free(want);
+        capec_P3DFree(&g);
+        capec_MapClose(&m);
+        return NULL;
+    }
+    // Capsule owns mapping from here on
+    data = m.data;
+    cap = capec_MapCapsule(&m);
+    if (cap == NULL) {
+        Py_DECREF(H);
+        free(want);
+        capec_P3DFree(&g);
+        return NULL;
+    }
+    // Arrays are copies unless caller asked for views (see capec_MapArray)
+    base = view ? cap : NULL;
+    // Float type
+    tf = (g.nf == 8) ? NPY_DOUBLE : NPY_FLOAT;
+    ndim = capec_P3DNDim(&g);
+    
+    // Create a copy (or view) of each requested grid
+    G = PyList_New(g.ngrid);
+    B = PyList_New(g.ngrid);
+    for (i=0; G != NULL && B != NULL && i<g.ngrid; i++) {
+        // Placeholders for grids not read
+        Py_INCREF(Py_None);
+        Py_INCREF(Py_None);
+        PyList_SET_ITEM(G, i, Py_None);
+        PyList_SET_ITEM(B, i, Py_None);
+        if (!want[i]) {continue; }
+        // Variable, then L, K, J, like Fortran q(j,k,l,n)
+        d = g.dims + ndim*i;
+        dims[0] = capec_P3DNVar(&g, i);
+        dims[1] = d[2];
+        dims[2] = d[1];
+        dims[3] = d[0];
+        A = capec_MapArray(base, data + g.offset[i], 4, dims, tf, g.swap);
+        if (A == NULL || PyList_SetItem(G, i, A)) {
+            Py_CLEAR(G);
+            break;
+        }
+        if (!g.iblank) {continue; }
+        // IBLANKs follow coordinates in the same record
+        A = capec_MapArray(base, data + g.offset[i] +
+            capec_P3DNPoint(&g, i) * 3 * g.nf, 3, dims + 1, NPY_INT32,
+            g.swap);
+        if (A == NULL || PyList_SetItem(B, i, A)) {
+            Py_CLEAR(B);
+        }
+    }
+    // Views hold their own references to mapping
+    Py_DECREF(cap);
+    free(want);
+    capec_P3DFree(&g);
+    if (G == NULL || B == NULL) {
+        Py_DECREF(H);
+        Py_XDECREF(G);
+        Py_XDECREF(B);
+        return NULL;
+    }
+    // Output
+    return Py_BuildValue("NNN", H, G, B);
+}
+
+
+// Get integer from header dictionary
+static int
+cape_P3DHeaderInt(PyObject *H, const char *key, int vdef, int *v)
+{
+    long i;
+    PyObject *o;
+    
+    o = PyDict_GetItemString(H, key);
+    if (o == NULL || o == Py_None) {
+        *v = vdef;
+        return 0;
+    }
+    i = PyLong_AsLong(o);
+    if (i == -1 && PyErr_Occurred()) {
+        return 1;
+    }
+    if (i < 0 || i > INT_MAX) {
+        PyErr_Format(PyExc_ValueError,
+            "Invalid value of '%s' for PLOT3D header", key);
+        return 1;
+    }
+    *v = (int) i;
+    return 0;
+}
+
+// Function to write PLOT3D file
+PyObject *
+cape_WriteP3D(PyObject *self, PyObject *args)
+{
+    int ierr, kind, ndim, nvar, nh;
+    long i, j, n;
+    npy_intp *d;
+    const char *fmt, *skind;
+    char what[32];
+    capecP3D g;
+    capecSink sink;
+    PyObject *target, *H, *oG, *oB = Py_None, *o;
+    PyArrayObject **G, **B, *A = NULL;
+    
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "OO!O|O", &target, &PyDict_Type, &H, &oG,
+            &oB)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.WriteP3D`");
+        return NULL;
+    }
+    // Kind and format of file
+    memset(&g, 0, sizeof(capecP3D));
+    o = PyDict_GetItemString(H, "kind");
+    skind = (o == NULL) ? "x" : PyUnicode_AsUTF8(o);
+    o = PyDict_GetItemString(H, "fmt");
+    fmt = (o == NULL) ? "lr8" : PyUnicode_AsUTF8(o);
+    if (skind == NULL || fmt == NULL) {
+        return NULL;
+    }
+    kind = cape_P3DKind(skind);
+    if (kind < 0) {
+        return NULL;
+    }
+    g.kind = kind;
+    if (capec_P3DFormat(&g, fmt)) {
+        PyErr_Format(PyExc_ValueError,
+            "Unrecognized PLOT3D format '%s'", fmt);
+        return NULL;
+    }
+    // Multiple-grid header and species
+    if (cape_P3DHeaderInt(H, "multi", 1, &g.multi) ||
+            cape_P3DHeaderInt(H, "nqc", 0, &g.nqc)) {
+        return NULL;
+    }
+    // Number of grids
+    if (!PySequence_Check(oG) || (n = PySequence_Size(oG)) < 1 ||
+            n > INT_MAX) {
+        PyErr_SetString(PyExc_ValueError, \
+            "PLOT3D grids must be a nonempty sequence of arrays");
+        return NULL;
+    }
+    if (n > 1 && !g.multi) {
+        PyErr_SetString(PyExc_ValueError, \
+            "Single-grid PLOT3D file cannot have more than one grid");
+        return NULL;
+    }
+    g.ngrid = n;
+    g.iblank = (kind == capeP3D_X) && (oB != Py_None);
+    if (g.iblank && (!PySequence_Check(oB) || PySequence_Size(oB) != n)) {
+        PyErr_SetString(PyExc_ValueError, \
+            "Need one IBLANK array for each PLOT3D grid");
+        return NULL;
+    }
+    // Allocate dimensions and pinned arrays
+    G = (PyArrayObject **) calloc(2*n, sizeof(PyArrayObject *));
+    B = G + n;
+    if (G == NULL || capec_P3DAlloc(&g)) {
+        free(G);
+        return PyErr_NoMemory();
+    }
+    ndim = capec_P3DNDim(&g);
+    
+    // Pin each grid and get dimensions from its shape
+    for (i=0, ierr=0; i<n && !ierr; i++) {
+        o = PySequence_GetItem(oG, i);
+        G[i] = (o == NULL) ? NULL : capec_PinView(o, NPY_DOUBLE, 4);
+        Py_XDECREF(o);
+        if (G[i] == NULL) {
+            ierr = 1;
+            break;
+        }
+        // Variable, then L, K, J
+        d = PyArray_DIMS(G[i]);
+        if (d[0] < 1 || d[1] < 1 || d[2] < 1 || d[3] < 1 ||
+                d[0] > INT_MAX || d[1] > INT_MAX || d[2] > INT_MAX ||
+                d[3] > INT_MAX) {
+            PyErr_Format(PyExc_ValueError,
+                "Invalid dimensions of PLOT3D grid %li", i + 1);
+            ierr = 1;
+            break;
+        }
+        for (j=0; j<3; j++) {
+            g.dims[ndim*i + j] = (int) d[3 - j];
+        }
+        // Number of variables
+        nvar = (int) d[0];
+        if (kind == capeP3D_F) {
+            g.dims[4*i + 3] = nvar;
+        } else if (kind == capeP3D_Q && i == 0) {
+            g.nq = nvar - g.nqc;
+        }
+        if ((kind == capeP3D_X && nvar != 3) ||
+                (kind == capeP3D_Q && (nvar != g.nq + g.nqc || g.nq < 1))) {
+            PyErr_Format(PyExc_ValueError,
+                "PLOT3D %s grid %li has %i variables", skind, i + 1, nvar);
+            ierr = 1;
+            break;
+        }
+        // IBLANKs, any shape
+        if (!g.iblank) {continue; }
+        o = PySequence_GetItem(oB, i);
+        if (o != NULL && PyArray_Check(o)) {
+            B[i] = capec_PinView(o, NPY_INT,
+                PyArray_NDIM((PyArrayObject *) o));
+        } else if (o != NULL) {
+            PyErr_SetString(PyExc_TypeError, \
+                "IBLANK must be a NumPy array.");
+        }
+        Py_XDECREF(o);
+        if (B[i] == NULL) {
+            ierr = 1;
+        } else if ((size_t) PyArray_SIZE(B[i]) != capec_P3DNPoint(&g, i)) {
+            PyErr_Format(PyExc_ValueError,
+                "IBLANK of PLOT3D grid %li has wrong size", i + 1);
+            ierr = 1;
+        }
+    }
+    // Per-grid headers of OVERFLOW files
+    nh = capec_P3DNHead(&g);
+    if (!ierr && kind == capeP3D_Q) {
+        o = PyDict_GetItemString(H, "header");
+        A = (o == NULL) ? NULL : capec_PinArray(o, NPY_DOUBLE, 2);
+        if (o == NULL) {
+            PyErr_SetString(PyExc_ValueError, \
+                "OVERFLOW q file needs 'header' for each grid");
+        }
+        if (A == NULL) {
+            ierr = 1;
+        } else if (PyArray_DIM(A, 0) != n || PyArray_DIM(A, 1) != nh) {
+            PyErr_Format(PyExc_ValueError,
+                "OVERFLOW q header should have shape (%li, %i)", n, nh);
+            ierr = 1;
+        }
+    }
+    // Open output for writing
+    if (!ierr) {
+        ierr = capec_SinkOpen(&sink, target, "grid.x", "wb");
+    }
+    
+    // Convert and write without the GIL
+    if (!ierr) {
+        Py_BEGIN_ALLOW_THREADS
+        ierr = capec_WriteP3D(sink.fp, &g, G, B,
+            (A == NULL) ? NULL : (const double *) PyArray_DATA(A), &i);
+        // Push everything to the target
+        if (!ierr && fflush(sink.fp)) {
+            ierr = capeIO_ERR_WRITE;
+        }
+        Py_END_ALLOW_THREADS
+        // Convert status to exception (GIL is held again here)
+        if (i >= 0 && i < n) {
+            snprintf(what, sizeof(what), "grid %li", i + 1);
+        } else {
+            strcpy(what, "header");
+        }
+        capec_IOSetError(ierr, what, sink.name);
+        // Close the output.
+        ierr = capec_SinkClose(&sink, ierr);
+    }
+    
+    // Release arrays
+    for (i=0; i<2*n; i++) {
+        Py_XDECREF(G[i]);
+    }
+    Py_XDECREF(A);
+    free(G);
+    capec_P3DFree(&g);
+    if (ierr) {
+        return NULL;
+    }
+    // Return None (or number of bytes for buffers).
+    return capec_SinkResult(&sink);
+}
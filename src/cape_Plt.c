@@ -0,0 +1,603 @@
+#include <Python.h>
+
+#if PY_MINOR_VERSION >= 10
+    #define NPY_NO_DEPRECATED_API NPY_2_0_API_VERSION
+#else
+    #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#endif
+#define PY_ARRAY_UNIQUE_SYMBOL _cape_ARRAY_API
+#define NO_IMPORT_ARRAY
+#include <numpy/arrayobject.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+// Local includes
+#include "capec_io.h"
+#include "capec_Map.h"
+#include "capec_Sink.h"
+#include "capec_Plt.h"
+
+
+// Convert Tecplot string in file to Python string
+static PyObject *
+cape_PltString(const char *data, size_t size, size_t i, int swap)
+{
+    size_t n;
+    unsigned *s;
+    PyObject *o;
+    
+    // Count and copy characters (string already checked)
+    n = capec_PltString(data, size, i, swap, NULL);
+    s = (unsigned *) malloc((n + 1)*sizeof(unsigned));
+    if (s == NULL) {
+        return PyErr_NoMemory();
+    }
+    capec_PltString(data, size, i, swap, s);
+    o = PyUnicode_FromKindAndData(PyUnicode_4BYTE_KIND, s, (Py_ssize_t) n);
+    free(s);
+    return o;
+}
+
+// Skip one Tecplot string in file
+static size_t
+cape_PltSkipString(const char *data, size_t size, size_t i, int swap)
+{
+    return i + 4*(capec_PltString(data, size, i, swap, NULL) + 1);
+}
+
+// Dictionary of aux name/value pairs of one zone
+static PyObject *
+cape_PltAux(const capecPlt *p, const char *data, size_t size, long j)
+{
+    int k;
+    size_t i = p->zones[j].aux + 4;
+    PyObject *A, *name, *val;
+    
+    A = PyDict_New();
+    for (k=0; A != NULL && k<p->zones[j].naux; k++) {
+        // Name, format (4-byte int), value, next flag
+        name = cape_PltString(data, size, i, p->swap);
+        i = cape_PltSkipString(data, size, i, p->swap) + 4;
+        val = cape_PltString(data, size, i, p->swap);
+        i = cape_PltSkipString(data, size, i, p->swap) + 4;
+        if (name == NULL || val == NULL ||
+                PyDict_SetItem(A, name, val)) {
+            Py_CLEAR(A);
+        }
+        Py_XDECREF(name);
+        Py_XDECREF(val);
+    }
+    return A;
+}
+
+// Header dictionary of Tecplot file
+static PyObject *
+cape_PltHeader(const capecPlt *p, const char *data, size_t size)
+{
+    int ierr, k;
+    long j;
+    size_t i;
+    npy_intp dims[2];
+    PyObject *D, *V, *Z, *A, *o;
+    PyArrayObject *P[4], *T;
+    const char *keys[4] = {"parent", "strand", "type", "npt"};
+    
+    // Title
+    o = cape_PltString(data, size, p->title, p->swap);
+    if (o == NULL) {
+        return NULL;
+    }
+    D = Py_BuildValue("{s:N}", "title", o);
+    if (D == NULL) {
+        return NULL;
+    }
+    // Variable names
+    V = PyList_New(p->nvar);
+    ierr = (V == NULL);
+    for (k=0, i=p->vars; !ierr && k<p->nvar; k++) {
+        o = cape_PltString(data, size, i, p->swap);
+        ierr = (o == NULL) || PyList_SetItem(V, k, o);
+        i = cape_PltSkipString(data, size, i, p->swap);
+    }
+    ierr = ierr || PyDict_SetItemString(D, "vars", V);
+    Py_XDECREF(V);
+    // Zone names and aux data
+    Z = ierr ? NULL : PyList_New(p->nzone);
+    A = ierr ? NULL : PyList_New(p->nzone);
+    ierr = (Z == NULL) || (A == NULL);
+    for (j=0; !ierr && j<p->nzone; j++) {
+        o = cape_PltString(data, size, p->zones[j].name, p->swap);
+        ierr = (o == NULL) || PyList_SetItem(Z, j, o);
+        o = ierr ? NULL : cape_PltAux(p, data, size, j);
+        ierr = ierr || (o == NULL) || PyList_SetItem(A, j, o);
+    }
+    ierr = ierr || PyDict_SetItemString(D, "zones", Z);
+    ierr = ierr || PyDict_SetItemString(D, "aux", A);
+    Py_XDECREF(Z);
+    Py_XDECREF(A);
+    // Integer properties of each zone
+    dims[0] = (npy_intp) p->nzone;
+    dims[1] = p->nvar;
+    memset(P, 0, sizeof(P));
+    for (k=0; !ierr && k<4; k++) {
+        P[k] = (PyArrayObject *) PyArray_SimpleNew(1, dims, NPY_INT);
+        ierr = (P[k] == NULL);
+    }
+    T = ierr ? NULL : (PyArrayObject *) PyArray_SimpleNew(1, dims,
+        NPY_DOUBLE);
+    ierr = ierr || (T == NULL);
+    for (j=0; !ierr && j<p->nzone; j++) {
+        ((int *) PyArray_DATA(P[0]))[j] = p->zones[j].parent;
+        ((int *) PyArray_DATA(P[1]))[j] = p->zones[j].strand;
+        ((int *) PyArray_DATA(P[2]))[j] = p->zones[j].type;
+        ((int *) PyArray_DATA(P[3]))[j] = (int) p->zones[j].npt;
+        ((double *) PyArray_DATA(T))[j] = p->zones[j].time;
+    }
+    for (k=0; k<4; k++) {
+        ierr = ierr || PyDict_SetItemString(D, keys[k], (PyObject *) P[k]);
+        Py_XDECREF(P[k]);
+    }
+    ierr = ierr || PyDict_SetItemString(D, "time", (PyObject *) T);
+    Py_XDECREF(T);
+    // Number of elements
+    P[0] = ierr ? NULL : (PyArrayObject *) PyArray_SimpleNew(1, dims,
+        NPY_INT);
+    ierr = ierr || (P[0] == NULL);
+    for (j=0; !ierr && j<p->nzone; j++) {
+        ((int *) PyArray_DATA(P[0]))[j] = (int) p->zones[j].nelem;
+    }
+    ierr = ierr || PyDict_SetItemString(D, "nelem", (PyObject *) P[0]);
+    Py_XDECREF(P[0]);
+    // Format of each variable
+    P[0] = ierr ? NULL : (PyArrayObject *) PyArray_SimpleNew(2, dims,
+        NPY_INT);
+    ierr = ierr || (P[0] == NULL);
+    if (!ierr) {
+        memcpy(PyArray_DATA(P[0]), p->fmt, p->nzone*p->nvar*sizeof(int));
+    }
+    ierr = ierr || PyDict_SetItemString(D, "fmt", (PyObject *) P[0]);
+    Py_XDECREF(P[0]);
+    if (ierr) {
+        Py_DECREF(D);
+        return NULL;
+    }
+    return D;
+}
+
+// Function to read Tecplot binary file
+PyObject *
+cape_ReadPlt(PyObject *self, PyObject *args)
+{
+    int ierr, k, nnode;
+    int view = 0;
+    long j;
+    npy_intp dims[2];
+    const char *fname;
+    char *data;
+    double *qminmax;
+    void **qdata;
+    int *qdouble;
+    capecMap m;
+    capecPlt p;
+    PyObject *cap, *base, *D, *Q, *E, *A;
+    PyArrayObject *QMIN, *QMAX;
+    
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "s|p", &fname, &view)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.ReadPlt`");
+        return NULL;
+    }
+    
+    // Map the file
+    if (capec_MapOpen(&m, fname)) {
+        return NULL;
+    }
+    // Find header and zone blocks
+    if (capec_ParsePlt(m.data, m.size, &p)) {
+        capec_MapClose(&m);
+        return NULL;
+    }
+    // Header from mapping
+    D = cape_PltHeader(&p, m.data, m.size);
+    // Scratch for min/max and data pointers of each zone
+    qminmax = (double *) malloc((2*p.nzone*p.nvar + 1)*sizeof(double));
+    qdata = (void **) malloc((p.nzone + 1)*sizeof(void *));
+    qdouble = (int *) malloc((p.nzone + 1)*sizeof(int));
+    if (D == NULL || !qminmax || !qdata || !qdouble) {
+        if (D != NULL) {PyErr_NoMemory(); }
+        Py_XDECREF(D);
+        free(qminmax);
+        free(qdata);
+        free(qdouble);
+        capec_PltFree(&p);
+        capec_MapClose(&m);
+        return NULL;
+    }
+    // Capsule owns mapping from here on
+    data = m.data;
+    cap = capec_MapCapsule(&m);
+    ierr = (cap == NULL);
+    // Arrays are copies unless caller asked for views (see capec_MapArray)
+    base = view ? cap : NULL;
+    
+    // Allocate point arrays and map connectivity of each zone
+    Q = ierr ? NULL : PyList_New(p.nzone);
+    E = ierr ? NULL : PyList_New(p.nzone);
+    ierr = (Q == NULL) || (E == NULL);
+    for (j=0; !ierr && j<p.nzone; j++) {
+        // Single precision unless some variable needs double
+        qdouble[j] = capec_PltZoneIsDouble(&p, j);
+        dims[0] = (npy_intp) p.zones[j].npt;
+        dims[1] = p.nvar;
+        A = PyArray_SimpleNew(2, dims,
+            qdouble[j] ? NPY_DOUBLE : NPY_FLOAT);
+        ierr = (A == NULL);
+        if (!ierr) {
+            qdata[j] = PyArray_DATA((PyArrayObject *) A);
+            ierr = PyList_SetItem(Q, j, A);
+        }
+        // Node indices (0-based), copied or viewed from mapping
+        nnode = capec_PltNodesPerElem(p.zones[j].type);
+        dims[0] = (npy_intp) p.zones[j].nelem;
+        dims[1] = nnode;
+        A = ierr ? NULL : capec_MapArray(base, data + p.zones[j].conn, 2,
+            dims, NPY_INT32, p.swap);
+        ierr = ierr || (A == NULL) || PyList_SetItem(E, j, A);
+    }
+    // Convert variable blocks without the GIL
+    if (!ierr) {
+        Py_BEGIN_ALLOW_THREADS
+        for (j=0; j<p.nzone; j++) {
+            capec_ReadPltZone(&p, data, j, qdata[j], qdouble[j],
+                qminmax + 2*p.nvar*j);
+        }
+        Py_END_ALLOW_THREADS
+    }
+    // Split min/max
+    dims[0] = (npy_intp) p.nzone;
+    dims[1] = p.nvar;
+    QMIN = ierr ? NULL : (PyArrayObject *) PyArray_SimpleNew(2, dims,
+        NPY_DOUBLE);
+    QMAX = ierr ? NULL : (PyArrayObject *) PyArray_SimpleNew(2, dims,
+        NPY_DOUBLE);
+    ierr = ierr || (QMIN == NULL) || (QMAX == NULL);
+    for (k=0; !ierr && k<p.nzone*p.nvar; k++) {
+        ((double *) PyArray_DATA(QMIN))[k] = qminmax[2*k];
+        ((double *) PyArray_DATA(QMAX))[k] = qminmax[2*k + 1];
+    }
+    ierr = ierr || PyDict_SetItemString(D, "qmin", (PyObject *) QMIN);
+    ierr = ierr || PyDict_SetItemString(D, "qmax", (PyObject *) QMAX);
+    ierr = ierr || PyDict_SetItemString(D, "q", Q);
+    ierr = ierr || PyDict_SetItemString(D, "elems", E);
+    // Cleanup; arrays hold their own references to mapping
+    Py_XDECREF(QMIN);
+    Py_XDECREF(QMAX);
+    Py_XDECREF(Q);
+    Py_XDECREF(E);
+    Py_XDECREF(cap);
+    free(qminmax);
+    free(qdata);
+    free(qdouble);
+    capec_PltFree(&p);
+    if (ierr) {
+        Py_DECREF(D);
+        return NULL;
+    }
+    // Output
+    return D;
+}
+
+
+// Write one 4-byte int
+static int
+cape_PltWriteInt(FILE *fid, int v)
+{
+    return fwrite(&v, 4, 1, fid) != 1;
+}
+
+// Write Python string as Tecplot string
+static int
+cape_PltWriteStr(FILE *fid, PyObject *o)
+{
+    int ierr;
+    Py_ssize_t n;
+    Py_UCS4 *s;
+    
+    // Check type
+    if (!PyUnicode_Check(o)) {
+        PyErr_SetString(PyExc_TypeError, \
+            "Tecplot title, names, and aux values must be strings");
+        return 1;
+    }
+    // Get 4-byte characters, including terminating zero
+    s = PyUnicode_AsUCS4Copy(o);
+    if (s == NULL) {
+        return 1;
+    }
+    n = PyUnicode_GetLength(o);
+    ierr = fwrite(s, 4, n + 1, fid) != (size_t) (n + 1);
+    PyMem_Free(s);
+    if (ierr) {
+        PyErr_SetString(PyExc_IOError, \
+            "Failed to write Tecplot header");
+    }
+    return ierr;
+}
+
+// Get optional integer or float for zone *j*
+static int
+cape_PltZoneValue(PyObject *D, const char *key, long j, double vdef,
+    double *v)
+{
+    PyObject *o, *oj;
+    
+    o = PyDict_GetItemString(D, key);
+    if (o == NULL || o == Py_None) {
+        *v = vdef;
+        return 0;
+    }
+    oj = PySequence_GetItem(o, j);
+    if (oj == NULL) {
+        return 1;
+    }
+    *v = PyFloat_AsDouble(oj);
+    Py_DECREF(oj);
+    return (*v == -1.0 && PyErr_Occurred());
+}
+
+// Write Tecplot header
+static int
+cape_PltWriteHeader(FILE *fid, PyObject *D, PyObject *V, long nzone,
+    PyArrayObject **Q, PyArrayObject **E, int *types)
+{
+    int ierr = 0;
+    long j;
+    double v[4];
+    float m;
+    char zname[32];
+    PyObject *o, *Z, *A, *key, *val;
+    Py_ssize_t k, pos;
+    
+    // Magic, byte order, file type (full)
+    if (fwrite("#!TDV112", 1, 8, fid) != 8 || cape_PltWriteInt(fid, 1) ||
+            cape_PltWriteInt(fid, 0)) {
+        PyErr_SetString(PyExc_IOError, "Failed to write Tecplot header");
+        return 1;
+    }
+    // Title
+    o = PyDict_GetItemString(D, "title");
+    if (o == NULL || o == Py_None) {
+        o = PyUnicode_FromString("untitled");
+    } else {
+        Py_INCREF(o);
+    }
+    ierr = (o == NULL) || cape_PltWriteStr(fid, o);
+    Py_XDECREF(o);
+    // Variable names
+    ierr = ierr || cape_PltWriteInt(fid, (int) PyList_GET_SIZE(V));
+    for (k=0; !ierr && k<PyList_GET_SIZE(V); k++) {
+        ierr = cape_PltWriteStr(fid, PyList_GET_ITEM(V, k));
+    }
+    // Zone headers
+    Z = PyDict_GetItemString(D, "zones");
+    A = PyDict_GetItemString(D, "aux");
+    m = capePLT_ZONEMARKER;
+    for (j=0; !ierr && j<nzone; j++) {
+        // Name
+        if (Z == NULL || Z == Py_None) {
+            snprintf(zname, sizeof(zname), "zone %li", j + 1);
+            o = PyUnicode_FromString(zname);
+        } else {
+            o = PySequence_GetItem(Z, j);
+        }
+        ierr = (o == NULL) || (fwrite(&m, 4, 1, fid) != 1) ||
+            cape_PltWriteStr(fid, o);
+        Py_XDECREF(o);
+        // Parent, strand, time, zone type
+        ierr = ierr ||
+            cape_PltZoneValue(D, "parent", j, -1.0, v) ||
+            cape_PltZoneValue(D, "strand", j, 1000.0 + j, v + 1) ||
+            cape_PltZoneValue(D, "time", j, 0.0, v + 2);
+        if (ierr) {break; }
+        ierr = cape_PltWriteInt(fid, (int) v[0]) ||
+            cape_PltWriteInt(fid, (int) v[1]) ||
+            (fwrite(v + 2, 8, 1, fid) != 1) ||
+            cape_PltWriteInt(fid, -1) ||
+            cape_PltWriteInt(fid, types[j]);
+        // Node-centered, no face neighbors, sizes, cell dims
+        ierr = ierr || cape_PltWriteInt(fid, 0) ||
+            cape_PltWriteInt(fid, 0) || cape_PltWriteInt(fid, 0) ||
+            cape_PltWriteInt(fid, (int) PyArray_DIM(Q[j], 0)) ||
+            cape_PltWriteInt(fid, (int) PyArray_DIM(E[j], 0)) ||
+            cape_PltWriteInt(fid, 0) || cape_PltWriteInt(fid, 0) ||
+            cape_PltWriteInt(fid, 0);
+        if (ierr) {
+            if (!PyErr_Occurred()) {
+                PyErr_SetString(PyExc_IOError, \
+                    "Failed to write Tecplot header");
+            }
+            break;
+        }
+        // Aux name/value pairs
+        o = (A == NULL || A == Py_None) ? NULL : PySequence_GetItem(A, j);
+        if (o != NULL && !PyDict_Check(o)) {
+            PyErr_SetString(PyExc_TypeError, \
+                "Tecplot zone aux data must be a dict");
+            ierr = 1;
+        }
+        pos = 0;
+        while (!ierr && o != NULL && PyDict_Next(o, &pos, &key, &val)) {
+            ierr = cape_PltWriteInt(fid, 1) || cape_PltWriteStr(fid, key) ||
+                cape_PltWriteInt(fid, 0) || cape_PltWriteStr(fid, val);
+        }
+        Py_XDECREF(o);
+        ierr = ierr || PyErr_Occurred() || cape_PltWriteInt(fid, 0);
+    }
+    // End of header
+    m = capePLT_EOHMARKER;
+    ierr = ierr || (fwrite(&m, 4, 1, fid) != 1);
+    if (ierr && !PyErr_Occurred()) {
+        PyErr_SetString(PyExc_IOError, "Failed to write Tecplot header");
+    }
+    return ierr;
+}
+
+// Function to write Tecplot binary file
+PyObject *
+cape_WritePlt(PyObject *self, PyObject *args)
+{
+    int ierr, nvar, nnode;
+    long j, n;
+    double v;
+    char what[32];
+    int *types, *fmt;
+    capecSink sink;
+    PyObject *target, *D, *V, *oQ, *oE, *oF, *o;
+    PyArrayObject **Q, **E, *F = NULL;
+    
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "OO!", &target, &PyDict_Type, &D)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.WritePlt`");
+        return NULL;
+    }
+    // Variables, values, and connectivity
+    V = PyDict_GetItemString(D, "vars");
+    oQ = PyDict_GetItemString(D, "q");
+    oE = PyDict_GetItemString(D, "elems");
+    if (V == NULL || !PyList_Check(V) || PyList_GET_SIZE(V) < 1 ||
+            PyList_GET_SIZE(V) > INT_MAX / 16) {
+        PyErr_SetString(PyExc_ValueError, \
+            "Tecplot 'vars' must be a nonempty list of names");
+        return NULL;
+    }
+    nvar = (int) PyList_GET_SIZE(V);
+    if (oQ == NULL || oE == NULL || !PySequence_Check(oQ) ||
+            !PySequence_Check(oE) ||
+            (n = PySequence_Size(oQ)) != PySequence_Size(oE) ||
+            n > INT_MAX) {
+        PyErr_SetString(PyExc_ValueError, \
+            "Tecplot 'q' and 'elems' must be sequences with one array "
+            "per zone");
+        return NULL;
+    }
+    // Allocate pinned arrays and zone types
+    Q = (PyArrayObject **) calloc(2*n + 1, sizeof(PyArrayObject *));
+    E = Q + n;
+    types = (int *) malloc((n + 1)*sizeof(int));
+    if (Q == NULL || types == NULL) {
+        free(Q);
+        free(types);
+        return PyErr_NoMemory();
+    }
+    
+    // Pin and check each zone
+    for (j=0, ierr=0; j<n && !ierr; j++) {
+        o = PySequence_GetItem(oQ, j);
+        Q[j] = (o == NULL) ? NULL : capec_PinArray(o, NPY_DOUBLE, 2);
+        Py_XDECREF(o);
+        o = (Q[j] == NULL) ? NULL : PySequence_GetItem(oE, j);
+        E[j] = (o == NULL) ? NULL : capec_PinArray(o, NPY_INT, 2);
+        Py_XDECREF(o);
+        ierr = (E[j] == NULL) ||
+            cape_PltZoneValue(D, "type", j, capePLT_FEQUADRILATERAL, &v);
+        if (ierr) {break; }
+        types[j] = (int) v;
+        nnode = capec_PltNodesPerElem(types[j]);
+        if (nnode == 0) {
+            PyErr_Format(PyExc_ValueError,
+                "Unsupported type %i of Tecplot zone %li", types[j], j + 1);
+            ierr = 1;
+        } else if (PyArray_DIM(Q[j], 1) != nvar ||
+                PyArray_DIM(Q[j], 0) > INT_MAX) {
+            PyErr_Format(PyExc_ValueError,
+                "Values of Tecplot zone %li should have shape (npt, %i)",
+                j + 1, nvar);
+            ierr = 1;
+        } else if (PyArray_DIM(E[j], 1) != nnode ||
+                PyArray_DIM(E[j], 0) > INT_MAX) {
+            PyErr_Format(PyExc_ValueError,
+                "Elements of Tecplot zone %li should have shape "
+                "(nelem, %i)", j + 1, nnode);
+            ierr = 1;
+        }
+    }
+    // Formats (float by default)
+    oF = PyDict_GetItemString(D, "fmt");
+    if (!ierr && oF != NULL && oF != Py_None) {
+        F = capec_PinArray(oF, NPY_INT, 2);
+        if (F == NULL) {
+            ierr = 1;
+        } else if (PyArray_DIM(F, 0) != n || PyArray_DIM(F, 1) != nvar) {
+            PyErr_Format(PyExc_ValueError,
+                "Tecplot 'fmt' should have shape (%li, %i)", n, nvar);
+            ierr = 1;
+        }
+        for (j=0; !ierr && j<n*nvar; j++) {
+            v = ((const int *) PyArray_DATA(F))[j];
+            if (v != capePLT_FLOAT && v != capePLT_DOUBLE) {
+                PyErr_SetString(PyExc_ValueError, \
+                    "Tecplot 'fmt' must be 1 (float) or 2 (double)");
+                ierr = 1;
+            }
+        }
+    }
+    fmt = ierr ? NULL : (int *) malloc(nvar*sizeof(int));
+    if (!ierr && fmt == NULL) {
+        PyErr_NoMemory();
+        ierr = 1;
+    }
+    // Open output and write header (needs Python strings)
+    if (!ierr) {
+        ierr = capec_SinkOpen(&sink, target, "tecplot.plt", "wb");
+        if (!ierr && cape_PltWriteHeader(sink.fp, D, V, n, Q, E, types)) {
+            capec_SinkClose(&sink, 1);
+            ierr = 1;
+        }
+    }
+    
+    // Convert and write zones without the GIL
+    if (!ierr) {
+        Py_BEGIN_ALLOW_THREADS
+        for (j=0; j<n && !ierr; j++) {
+            for (nnode=0; nnode<nvar; nnode++) {
+                fmt[nnode] = (F == NULL) ? capePLT_FLOAT :
+                    ((const int *) PyArray_DATA(F))[j*nvar + nnode];
+            }
+            ierr = capec_WritePltZone(sink.fp,
+                (const double *) PyArray_DATA(Q[j]),
+                (size_t) PyArray_DIM(Q[j], 0), nvar, fmt,
+                (const int *) PyArray_DATA(E[j]),
+                (size_t) PyArray_SIZE(E[j]));
+        }
+        // Push everything to the target
+        if (!ierr && fflush(sink.fp)) {
+            ierr = capeIO_ERR_WRITE;
+        }
+        Py_END_ALLOW_THREADS
+        // Convert status to exception (GIL is held again here)
+        snprintf(what, sizeof(what), "zone %li", j);
+        capec_IOSetError(ierr, what, sink.name);
+        // Close the output.
+        ierr = capec_SinkClose(&sink, ierr);
+    }
+    
+    // Release arrays
+    for (j=0; j<2*n; j++) {
+        Py_XDECREF(Q[j]);
+    }
+    Py_XDECREF(F);
+    free(Q);
+    free(types);
+    free(fmt);
+    if (ierr) {
+        return NULL;
+    }
+    // Return None (or number of bytes for buffers).
+    return capec_SinkResult(&sink);
+}
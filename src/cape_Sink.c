@@ -0,0 +1,123 @@
+#include <Python.h>
+
+#if PY_MINOR_VERSION >= 10
+    #define NPY_NO_DEPRECATED_API NPY_2_0_API_VERSION
+#else
+    #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#endif
+#define PY_ARRAY_UNIQUE_SYMBOL _cape_ARRAY_API
+#define NO_IMPORT_ARRAY
+#include <numpy/arrayobject.h>
+#include <string.h>
+
+// Local includes
+#include "capec_io.h"
+#include "capec_Pipe.h"
+#include "capec_Sink.h"
+#include "capec_Zip.h"
+
+
+// Function to set pipelined output options
+PyObject *
+cape_SetWritePipeline(PyObject *self, PyObject *args)
+{
+    int nbuf = 0;
+    Py_ssize_t bufsize = 0;
+    const char *sync = NULL;
+    capecPipeOpts o;
+    
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "|inz", &nbuf, &bufsize, &sync)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.SetWritePipeline`");
+        return NULL;
+    }
+    // Check sizes
+    if (nbuf < 0 || bufsize < 0) {
+        PyErr_SetString(PyExc_ValueError,
+            "Number and size of buffers must be nonnegative");
+        return NULL;
+    }
+    o.nbuf = nbuf;
+    o.bufsize = (bufsize == 0) ? capePIPE_BUFSIZE : (size_t) bufsize;
+    // What to do after writing
+    if (sync == NULL) {
+        o.sync = capePIPE_NOSYNC;
+    } else if (strcmp(sync, "fsync") == 0) {
+        o.sync = capePIPE_FSYNC;
+    } else if (strcmp(sync, "dontneed") == 0) {
+        o.sync = capePIPE_DONTNEED;
+    } else {
+        PyErr_Format(PyExc_ValueError,
+            "Unrecognized sync option '%s'; options are None, 'fsync', "
+            "and 'dontneed'", sync);
+        return NULL;
+    }
+    // Save for later writers
+    capec_SinkSetPipe(&o);
+    Py_RETURN_NONE;
+}
+
+
+// Function to wait for a background writer
+PyObject *
+cape_WriteWait(PyObject *self, PyObject *args)
+{
+    int ierr;
+    PyObject *cap;
+    capecSinkJob *j;
+    
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "O", &cap)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.WriteWait`");
+        return NULL;
+    }
+    // Get job
+    j = (capecSinkJob *) PyCapsule_GetPointer(cap, capeSINK_JOBCAPSULE);
+    if (j == NULL)
+        return NULL;
+    // Already delivered
+    if (j->state == capeSINK_JOBDONE)
+        return capec_SinkResult(&j->sink);
+    
+    // Wait for writer (without the GIL) and release its arrays
+    capec_SinkJobJoin(j);
+    capec_SinkJobRelease(j);
+    j->state = capeSINK_JOBDONE;
+    // Convert status to exception
+    ierr = j->ierr;
+    capec_IOSetError(ierr, j->what, j->sink.name);
+    // Close the output.
+    if (capec_SinkClose(&j->sink, ierr))
+        return NULL;
+    // Return None (or number of bytes for buffers).
+    return capec_SinkResult(&j->sink);
+}
+
+
+// Function to list available compression formats
+PyObject *
+cape_ZipCodecs(PyObject *self, PyObject *args)
+{
+    int codec;
+    PyObject *out, *v;
+    
+    // List of names
+    out = PyList_New(0);
+    for (codec=capeZIP_GZIP; out != NULL && codec<=capeZIP_ZSTD; codec++) {
+        // Skip formats not in this build
+        if (!capec_ZipAvailable(codec))
+            continue;
+        v = PyUnicode_FromString(capec_ZipName(codec));
+        if (v == NULL || PyList_Append(out, v)) {
+            Py_XDECREF(v);
+            Py_CLEAR(out);
+            break;
+        }
+        Py_DECREF(v);
+    }
+    return out;
+}
@@ -0,0 +1,136 @@
+#include <Python.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Local includes
+#include "capec_Stats.h"
+
+
+// Counted copy of method table and original function of each method
+static PyMethodDef *cape_StatDefs = NULL;
+static PyCFunction *cape_StatMeths = NULL;
+// Module passed as *self* to original functions (borrowed)
+static PyObject *cape_StatModule = NULL;
+
+
+// Counted copy of a method; *self* is index of original function
+static PyObject *
+cape_StatCall(PyObject *self, PyObject *args)
+{
+    long i;
+    unsigned long long t0;
+    capecStat *prev;
+    PyObject *out;
+    
+    // Call original function
+    i = PyLong_AsLong(self);
+    prev = capec_StatEnter((int) i, &t0);
+    out = cape_StatMeths[i](cape_StatModule, args);
+    capec_StatLeave((int) i, prev, t0);
+    return out;
+}
+
+// Replace functions of a module with counted copies
+int
+cape_StatWrap(PyObject *m, PyMethodDef *methods, const char *skip)
+{
+    int i, n;
+    PyObject *name;
+    PyObject *idx;
+    PyObject *f;
+    
+    // Count methods
+    for (n=0; methods[n].ml_name != NULL; n++);
+    // Allocate tables; they are used until the process exits
+    cape_StatDefs = (PyMethodDef *) calloc(n + 1, sizeof(PyMethodDef));
+    cape_StatMeths = (PyCFunction *) calloc(n + 1, sizeof(PyCFunction));
+    if (cape_StatDefs == NULL || cape_StatMeths == NULL ||
+            capec_StatInit(n)) {
+        PyErr_NoMemory();
+        return 1;
+    }
+    cape_StatModule = m;
+    // Name of module, for ``__module__`` of new functions
+    name = PyModule_GetNameObject(m);
+    if (name == NULL) {
+        return 1;
+    }
+    // Loop through methods
+    for (i=0; i<n; i++) {
+        // Save name and original function
+        capec_StatName(i, methods[i].ml_name);
+        cape_StatMeths[i] = methods[i].ml_meth;
+        // Leave uncounted function as is
+        if (skip != NULL && strcmp(methods[i].ml_name, skip) == 0) {
+            continue;
+        }
+        // Same name, flags, and docstring; arguments are passed through
+        cape_StatDefs[i] = methods[i];
+        cape_StatDefs[i].ml_meth = cape_StatCall;
+        // Create function with its index as *self*
+        idx = PyLong_FromLong((long) i);
+        if (idx == NULL) {
+            break;
+        }
+        f = PyCFunction_NewEx(cape_StatDefs + i, idx, name);
+        Py_DECREF(idx);
+        if (f == NULL) {
+            break;
+        }
+        // Replace original in module (steals *f* on success)
+        if (PyModule_AddObject(m, methods[i].ml_name, f)) {
+            Py_DECREF(f);
+            break;
+        }
+    }
+    Py_DECREF(name);
+    return i < n;
+}
+
+
+// Function to get counters of each extension function
+PyObject *
+cape_IOStats(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwlist[] = {"reset", NULL};
+    int i;
+    int reset = 0;
+    capecStat st;
+    PyObject *out;
+    PyObject *d;
+    
+    // Process the inputs.
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|p", kwlist, &reset)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.io_stats`");
+        return NULL;
+    }
+    // Initialize output
+    out = PyDict_New();
+    if (out == NULL) {
+        return NULL;
+    }
+    // Loop through functions
+    for (i=0; i<capec_StatCount(); i++) {
+        // Get (and reset) counters
+        capec_StatGet(i, &st, reset);
+        // Skip functions not called
+        if (st.calls == 0 && st.bytes == 0) {
+            continue;
+        }
+        // Add to output
+        d = Py_BuildValue("{sKsKsd}",
+            "calls", st.calls,
+            "bytes", st.bytes,
+            "time", 1e-9 * (double) st.ns);
+        if (d == NULL || PyDict_SetItemString(out, st.name, d)) {
+            Py_XDECREF(d);
+            Py_DECREF(out);
+            return NULL;
+        }
+        Py_DECREF(d);
+    }
+    // Output
+    return out;
+}
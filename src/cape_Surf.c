@@ -0,0 +1,177 @@
+#include <Python.h>
+
+#if PY_MINOR_VERSION >= 10
+    #define NPY_NO_DEPRECATED_API NPY_2_0_API_VERSION
+#else
+    #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#endif
+#define PY_ARRAY_UNIQUE_SYMBOL _cape_ARRAY_API
+#define NO_IMPORT_ARRAY
+#include <numpy/arrayobject.h>
+#include <stdio.h>
+#include <string.h>
+
+// Local includes
+#include "capec_Map.h"
+#include "capec_Scan.h"
+#include "capec_Surf.h"
+
+
+// Shape of section *k* of layout
+static void
+cape_SurfDims(const capecSurf *s, int k, npy_intp *dims)
+{
+    if (k == capeSURF_NODES) {
+        dims[0] = (npy_intp) s->nNode;
+        dims[1] = (npy_intp) s->ncol;
+    } else if (k == capeSURF_TRIS) {
+        dims[0] = (npy_intp) s->nTri;
+        dims[1] = capeSURF_NTRICOL;
+    } else {
+        dims[0] = (npy_intp) s->nQuad;
+        dims[1] = capeSURF_NQUADCOL;
+    }
+}
+
+// Read ASCII surface file from contents of mapping
+static PyObject *
+cape_ReadSurfText(const char *fname, capecMap *m, capecSurf *s)
+{
+    int k, ierr;
+    char *p;
+    npy_intp dims[2];
+    FILE *fp;
+    capecScanBuf b;
+    PyObject *A[3] = {NULL, NULL, NULL};
+    
+    // Read from memory; also works for decompressed files
+    if (m->size == 0) {
+        PyErr_Format(PyExc_ValueError, "Surf file '%s' is empty", fname);
+        return NULL;
+    }
+    fp = fmemopen(m->data, m->size, "rb");
+    if (fp == NULL) {
+        PyErr_SetFromErrnoWithFilename(PyExc_OSError, fname);
+        return NULL;
+    }
+    // Initialize buffer
+    if (capec_ScanBufInit(&b, fp)) {
+        fclose(fp);
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate read buffer");
+        return NULL;
+    }
+    // Read counts and number of node columns
+    Py_BEGIN_ALLOW_THREADS
+    ierr = capec_ReadSurfHeader(&b, &p, s);
+    Py_END_ALLOW_THREADS
+    // Allocate outputs from header counts
+    for (k=0; !ierr && k<3; k++) {
+        cape_SurfDims(s, k + capeSURF_NODES, dims);
+        A[k] = PyArray_SimpleNew(2, dims, k ? NPY_INT : NPY_DOUBLE);
+        if (A[k] == NULL) {
+            ierr = -1;
+        }
+    }
+    // Parse nodes, tris, and quads without the GIL
+    if (!ierr) {
+        Py_BEGIN_ALLOW_THREADS
+        ierr = capec_ReadSurfText(&b, &p, s,
+            (double *) PyArray_DATA((PyArrayObject *) A[0]),
+            (int *) PyArray_DATA((PyArrayObject *) A[1]),
+            (int *) PyArray_DATA((PyArrayObject *) A[2]));
+        Py_END_ALLOW_THREADS
+    }
+    // Convert status to exception
+    if (ierr == capeSURF_ERR_EOF) {
+        PyErr_Format(PyExc_ValueError,
+            "File '%s' ended before end of surf %s section",
+            fname, capeSURF_NAMES[s->nsection]);
+    } else if (ierr == capeSURF_ERR_VALUE) {
+        PyErr_Format(PyExc_ValueError,
+            "Invalid surf %s entry in '%s'",
+            capeSURF_NAMES[s->nsection], fname);
+    } else if (ierr == capeSURF_ERR_READ) {
+        PyErr_Format(PyExc_IOError,
+            "Failed to read surf %s section from '%s'",
+            capeSURF_NAMES[s->nsection], fname);
+    }
+    // Close file
+    capec_ScanBufClose(&b);
+    fclose(fp);
+    if (ierr) {
+        Py_XDECREF(A[0]);
+        Py_XDECREF(A[1]);
+        Py_XDECREF(A[2]);
+        return NULL;
+    }
+    // Output
+    return Py_BuildValue("NNN", A[0], A[1], A[2]);
+}
+
+// Function to read AFLR3 surface file
+PyObject *
+cape_ReadSurf(PyObject *self, PyObject *args)
+{
+    int k, tf;
+    int view = 0;
+    char *data;
+    const char *fname;
+    const char *fmt = NULL;
+    npy_intp dims[2];
+    capecMap m;
+    capecSurf s;
+    PyObject *cap, *base, *out;
+    PyObject *A[3] = {NULL, NULL, NULL};
+    
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "s|zp", &fname, &fmt, &view)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.ReadSurf`");
+        return NULL;
+    }
+    // Map the file (decompressing it if needed)
+    if (capec_MapOpen(&m, fname)) {
+        return NULL;
+    }
+    // Find and check sections
+    if (capec_ParseSurf(m.data, m.size, fmt, &s)) {
+        capec_MapClose(&m);
+        return NULL;
+    }
+    // Check for text file
+    if (s.ascii) {
+        out = cape_ReadSurfText(fname, &m, &s);
+        capec_MapClose(&m);
+        return out;
+    }
+    // Capsule owns mapping from here on
+    data = m.data;
+    cap = capec_MapCapsule(&m);
+    if (cap == NULL) {
+        return NULL;
+    }
+    // Arrays are copies unless caller asked for views (see capec_MapArray)
+    base = view ? cap : NULL;
+    // Float type
+    tf = (s.nf == 8) ? NPY_DOUBLE : NPY_FLOAT;
+    
+    // Create a copy (or view) of nodes, tris, and quads
+    for (k=0; k<3; k++) {
+        cape_SurfDims(&s, k + capeSURF_NODES, dims);
+        A[k] = capec_MapArray(base, data + s.offset[k + capeSURF_NODES],
+            2, dims, k ? NPY_INT32 : tf, s.swap);
+        if (A[k] == NULL) {
+            break;
+        }
+    }
+    // Views hold their own references to mapping
+    Py_DECREF(cap);
+    if (k < 3) {
+        Py_XDECREF(A[0]);
+        Py_XDECREF(A[1]);
+        return NULL;
+    }
+    // Output
+    return Py_BuildValue("NNN", A[0], A[1], A[2]);
+}
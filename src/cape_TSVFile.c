@@ -0,0 +1,74 @@
+#include <Python.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Local includes
+#include "capec_PyTypes.h"
+#include "capec_Memory.h"
+#include "capec_NumPy.h"
+#include "capec_BaseFile.h"
+#include "capec_TSVFile.h"
+
+
+// Read through file to count data lines
+PyObject *
+cape_TSVFileCountLines(PyObject *self, PyObject *args)
+{
+   // --- Declarations ---
+    // Line counts
+    size_t nline;
+    // File handle
+    PyObject *f;
+    FILE *fp;
+    off_t pos0;
+    
+   // --- Inputs ---
+    // Parse inputs
+    if (!PyArg_ParseTuple(args, "O", &f)) {
+        // Failed to read
+        PyErr_SetString(PyExc_ValueError, "Failed to parse inputs");
+        return NULL;
+    }
+    // Get C file handle
+    fp = capeFILE_FromPyFile(f, &pos0);
+    if (fp == NULL) {
+        return NULL;
+    }
+    
+   // --- Read ---
+    // Get line count
+    nline = capec_TSVFileCountLines(fp);
+    // Close our handle; leave *f* where it was
+    if (capeFILE_ClosePyFile(f, fp, pos0, 0)) {
+        return NULL;
+    }
+    
+    // Output
+    return capePyInt_FromLong((long) nline);
+}
+
+
+// Read TSV file
+PyObject *
+cape_TSVFileReadData(PyObject *self, PyObject *args)
+{
+    // Data file interface
+    PyObject *db;
+    // File handle
+    PyObject *f;
+    
+    // Parse inputs
+    if (!PyArg_ParseTuple(args, "OO", &db, &f)) {
+        // Failed to parse
+        PyErr_SetString(PyExc_ValueError, "Failed to parse inputs");
+        return NULL;
+    }
+    
+    // Read all data lines in one pass
+    if (capeFILE_ReadData(db, f, capeTSV_ReadLine)) {
+        return NULL;
+    }
+    
+    // Output
+    Py_RETURN_NONE;
+}
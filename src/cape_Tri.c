@@ -9,305 +9,377 @@
 #define NO_IMPORT_ARRAY
 #include <numpy/arrayobject.h>
 #include <stdio.h>
+#include <string.h>
 #include <byteswap.h>
 
 // Local includes
 #include "capec_io.h"
 #include "capec_NumPy.h"
 #include "capec_Tri.h"
+#include "capec_Map.h"
+#include "capec_Sink.h"
+#include "capec_Surf.h"
+
+
+// Pin one array for a writer, unless an earlier one already failed
+static int
+cape_TriPin(PyArrayObject **A, PyObject *P, int typenum, int ndim, int ierr)
+{
+    // Skip if an earlier array failed
+    if (ierr)
+        return ierr;
+    // Caller's array (any layout) unless its type needs converting
+    *A = capec_PinView(P, typenum, ndim);
+    return (*A == NULL);
+}
+
+// Set exception for writer status and deliver output
+static PyObject *
+cape_TriFinish(capecSink *sink, int ierr, const char *what)
+{
+    // Convert status to exception (GIL is held again here)
+    capec_IOSetError(ierr, what, sink->name);
+    // Close the output.
+    if (capec_SinkClose(sink, ierr))
+        return NULL;
+    // Return None (or number of bytes for buffers).
+    return capec_SinkResult(sink);
+}
 
 
 // Function to write Components.pyCart.tri file
 PyObject *
 cape_WriteTri(PyObject *self, PyObject *args)
 {
-    int i, ierr;
-    int nNode, nTri;
-    FILE *fid;
-    PyArrayObject *P;
-    PyArrayObject *T;
+    int ierr;
+    long nNode, nTri;
+    const char *what = "header";
+    capecSink sink;
+    PyObject *oP, *oT;
+    PyObject *oC = Py_None;
+    PyObject *target = Py_None;
+    PyArrayObject *P = NULL;
+    PyArrayObject *T = NULL;
+    PyArrayObject *C = NULL;
     
     // Process the inputs.
-    if (!PyArg_ParseTuple(args, "OO", &P, &T)) {
+    if (!PyArg_ParseTuple(args, "OO|OO", &oP, &oT, &oC, &target)) {
         // Check for failure.
         PyErr_SetString(PyExc_RuntimeError, \
             "Could not process inputs to :func:`pc.WriteTri`");
         return NULL;
     }
     
-    // Check for two-dimensional node array.
-    if (PyArray_NDIM(P) != 2) {
-        PyErr_SetString(PyExc_ValueError, \
-            "Nodal coordinates must be Nx3 or Nx2 array.");
-        return NULL;
+    // Pin nodes, tris, and (optional) CompIDs while holding the GIL
+    ierr = cape_TriPin(&P, oP, NPY_DOUBLE, 2, 0);
+    ierr = cape_TriPin(&T, oT, NPY_INT, 2, ierr);
+    if (oC != Py_None) {
+        ierr = cape_TriPin(&C, oC, NPY_INT, 1, ierr);
     }
-    // Read number of nodes.
-    nNode = (int) PyArray_DIM(P, 0);
-    
     // Check for two-dimensional Nx3 array.
-    if (PyArray_NDIM(T) != 2 || PyArray_DIM(T, 1) != 3) {
+    if (!ierr && PyArray_DIM(T, 1) != 3) {
         PyErr_SetString(PyExc_ValueError, \
             "Nodal indices must be Nx3 array.");
+        ierr = 1;
+    }
+    // Open output (wipe out if it exists.)
+    if (ierr || capec_SinkOpen(&sink, target, "Components.pyCart.tri", "w")) {
+        Py_XDECREF(P);
+        Py_XDECREF(T);
+        Py_XDECREF(C);
         return NULL;
     }
-    // Read number of triangles.
-    nTri = (int) PyArray_DIM(T, 0);
-    
-    // Open output file for writing (wipe out if it exists.)
-    fid = fopen("Components.pyCart.tri", "w");
+    // Read number of nodes and triangles.
+    nNode = (long) PyArray_DIM(P, 0);
+    nTri  = (long) PyArray_DIM(T, 0);
     
+    // Format and write without the GIL
+    Py_BEGIN_ALLOW_THREADS
     // Write the number of nodes and tris.
-    fprintf(fid, "%12i%12i\n", nNode, nTri);
-    
+    if (fprintf(sink.fp, "%12li%12li\n", nNode, nTri) < 0) {
+        ierr = capeIO_ERR_WRITE;
+    }
     // Write the nodes.
-    ierr = capec_WriteTriNodes(fid, P);
-    if (ierr) {
-        PyErr_SetString(PyExc_IOError, \
-            "Failure writing nodes to `Components.pyCart.tri'");
+    if (!ierr) {
+        what = "nodes";
+        ierr = capec_WriteTriNodes(sink.fp, P);
     }
     // Write the tris.
-    ierr = capec_WriteTriTris(fid, T);
-    if (ierr) {
-        PyErr_SetString(PyExc_IOError, \
-            "Failure writing tris to `Components.pyCart.tri'");
+    if (!ierr) {
+        what = "tris";
+        ierr = capec_WriteTriTris(sink.fp, T);
+    }
+    // Write the component IDs in the same pass
+    if (!ierr && C != NULL) {
+        what = "component IDs";
+        ierr = capec_WriteTriCompID(sink.fp, C);
+    }
+    // Push everything to the target
+    if (!ierr && fflush(sink.fp)) {
+        ierr = capeIO_ERR_WRITE;
+    }
+    Py_END_ALLOW_THREADS
+    
+    // Release arrays
+    Py_DECREF(P);
+    Py_DECREF(T);
+    Py_XDECREF(C);
+    // Error message, close, and output
+    return cape_TriFinish(&sink, ierr, what);
+}
+
+// Write binary tri, with or without Fortran record markers
+static PyObject *
+cape_WriteTriBin(PyObject *target, PyObject *oP, PyObject *oT,
+    PyObject *oC, PyObject *oQ, int rnode, int ni, int swap, int record)
+{
+    int ierr;
+    int nb, rint;
+    size_t nNode, nTri, nq;
+    const char *what = "header";
+    FILE *fid;
+    capecSink sink;
+    PyArrayObject *P = NULL;
+    PyArrayObject *T = NULL;
+    PyArrayObject *C = NULL;
+    PyArrayObject *Q = NULL;
+    int (*fwrite_a)(FILE *, PyArrayObject *, int, int, int);
+    
+    // Check for arrays
+    if (!PyArray_Check(oP) || !PyArray_Check(oT) ||
+            (oC != Py_None && !PyArray_Check(oC)) ||
+            (oQ != Py_None && !PyArray_Check(oQ))) {
+        PyErr_SetString(PyExc_TypeError, \
+            "Nodes, tris, component IDs, and states must be arrays.");
+        return NULL;
+    }
+    // Check for two-dimensional node array.
+    if (PyArray_NDIM((PyArrayObject *) oP) != 2 ||
+            PyArray_NDIM((PyArrayObject *) oT) != 2 ||
+            (oQ != Py_None && PyArray_NDIM((PyArrayObject *) oQ) != 2)) {
+        PyErr_SetString(PyExc_ValueError, \
+            "Nodes, tris, and states must be two-dimensional arrays.");
+        return NULL;
     }
     
-    // Close the file.
-    ierr = fclose(fid);
-    if (ierr) {
-        // Failure on close?
-        PyErr_SetString(PyExc_IOError, \
-            "Failure on closing file 'Components.pyCart.tri'");
+    // Pin arrays, converting unusual types, while holding the GIL
+    ierr = cape_TriPin(&P, oP, NPY_DOUBLE, 2, 0);
+    ierr = cape_TriPin(&T, oT, NPY_INT, 2, ierr);
+    if (oC != Py_None) {
+        ierr = cape_TriPin(&C, oC, NPY_INT, 1, ierr);
+    }
+    if (oQ != Py_None) {
+        ierr = cape_TriPin(&Q, oQ, NPY_DOUBLE, 2, ierr);
+    }
+    // Open output for writing
+    if (ierr || capec_SinkOpen(&sink, target, "Components.pyCart.tri", "wb")) {
+        Py_XDECREF(P);
+        Py_XDECREF(T);
+        Py_XDECREF(C);
+        Py_XDECREF(Q);
         return NULL;
     }
+    fid = sink.fp;
     
-    // Return None.
-    Py_INCREF(Py_None);
-    return Py_None;
+    // Read number of nodes and triangles
+    nNode = (size_t) PyArray_DIM(P, 0);
+    nTri  = (size_t) PyArray_DIM(T, 0);
+    nq = (Q == NULL) ? 0 : (size_t) PyArray_DIM(Q, 1);
+    // Number of bytes in header record
+    nb = (Q == NULL) ? 2*ni : 3*ni;
+    // Type for node indices and CompIDs
+    rint = (ni == 8) ? capeREC_I8 : capeREC_I4;
+    // Array writer
+    fwrite_a = record ? capec_WriteRecord : capec_WriteStream;
+    
+    // Convert and write without the GIL
+    Py_BEGIN_ALLOW_THREADS
+    // Write header; counts must fit in *ni* bytes
+    ierr = record && capec_WriteMarker(fid, nb, swap);
+    if (!ierr)
+        ierr = capec_WriteCount(fid, nNode, ni, swap);
+    if (!ierr)
+        ierr = capec_WriteCount(fid, nTri, ni, swap);
+    if (!ierr && Q != NULL)
+        ierr = capec_WriteCount(fid, nq, ni, swap);
+    if (!ierr && record)
+        ierr = capec_WriteMarker(fid, nb, swap);
+    // Write the nodes, tris, CompIDs, and states
+    if (!ierr) {
+        what = "nodes";
+        ierr = fwrite_a(fid, P, 2, rnode, swap);
+    }
+    if (!ierr) {
+        what = "tris";
+        ierr = fwrite_a(fid, T, 2, rint, swap);
+    }
+    if (!ierr && C != NULL) {
+        what = "component IDs";
+        ierr = fwrite_a(fid, C, 1, rint, swap);
+    }
+    if (!ierr && Q != NULL) {
+        what = "states";
+        ierr = fwrite_a(fid, Q, 2, rnode, swap);
+    }
+    // Push everything to the target
+    if (!ierr && fflush(fid)) {
+        ierr = capeIO_ERR_WRITE;
+    }
+    Py_END_ALLOW_THREADS
+    
+    // Release arrays
+    Py_DECREF(P);
+    Py_DECREF(T);
+    Py_XDECREF(C);
+    Py_XDECREF(Q);
+    // Error message, close, and output
+    return cape_TriFinish(&sink, ierr, what);
 }
 
-// Function to write binary tri, single-precision big-endian
-PyObject *
-cape_WriteTri_b4(PyObject *self, PyObject *args)
+// Check bytes per integer
+static int
+cape_TriIntSize(int ni)
 {
-    int i, ierr=1;
-    int nNode, nTri, nb;
-    FILE *fid;
-    PyArrayObject *P;
-    PyArrayObject *T;
-    PyArrayObject *C;
+    if (ni == 4 || ni == 8)
+        return 0;
+    PyErr_Format(PyExc_ValueError, \
+        "Integer byte count must be 4 or 8; got %i", ni);
+    return 1;
+}
+
+// Write binary tri with Fortran record markers
+static PyObject *
+cape_WriteTriRecords(PyObject *args, const char *func, int rnode, int swap)
+{
+    int ni = 4;
+    PyObject *P;
+    PyObject *T;
+    PyObject *C;
+    PyObject *target = Py_None;
+    PyObject *Q = Py_None;
     
     // Process the inputs.
-    if (!PyArg_ParseTuple(args, "OOO", &P, &T, &C)) {
+    if (!PyArg_ParseTuple(args, "OOO|OiO", &P, &T, &C, &target, &ni, &Q)) {
         // Check for failure.
-        PyErr_SetString(PyExc_RuntimeError, \
-            "Could not process inputs to :func:`pc.WriteTri_b4`");
+        PyErr_Format(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.%s`", func);
         return NULL;
     }
-    
-    // Read number of nodes and triangles
-    nNode = (int) PyArray_DIM(P, 0);
-    nTri  = (int) PyArray_DIM(T, 0);
-    // Number of bytes in header record
-    nb = 2*sizeof(int);
-    
-    // Open Output file for writing
-    fid = fopen("Components.pyCart.tri", "wb");
-    
-    // Write header record
-    capec_Write_b4_i(fid, nb);
-    capec_Write_b4_i(fid, nNode);
-    capec_Write_b4_i(fid, nTri);
-    capec_Write_b4_i(fid, nb);
-    
-    // Write the nodes, tris, and CompIDs
-    ierr = ierr & capec_WriteRecord_b4_f2(fid, P);
-    ierr = ierr & capec_WriteRecord_b4_i2(fid, T);
-    ierr = ierr & capec_WriteRecord_b4_i1(fid, C);
-    
-    // Check for errors; error message set elsewhere
-    if (ierr) {return NULL; }
-    
-    // Close the file.
-    ierr = fclose(fid);
-    // Check for errors.
-    if (ierr) {
-        PyErr_SetString(PyExc_IOError, \
-            "Failure on closing file 'Components.pyCart.tri'");
+    // Integer size
+    if (cape_TriIntSize(ni))
         return NULL;
-    }
     
-    // Return None.
-    Py_INCREF(Py_None);
-    return Py_None;
+    // Write
+    return cape_WriteTriBin(target, P, T, C, Q, rnode, ni, swap, 1);
+}
+
+// Function to write binary tri, single-precision big-endian
+PyObject *
+cape_WriteTri_b4(PyObject *self, PyObject *args)
+{
+    return cape_WriteTriRecords(args, "WriteTri_b4", capeREC_F4, is_le());
 }
 
 // Function to write binary tri, single-precision little-endian
 PyObject *
 cape_WriteTri_lb4(PyObject *self, PyObject *args)
 {
-    int i, ierr=1;
-    int nNode, nTri, nb;
-    FILE *fid;
-    PyArrayObject *P;
-    PyArrayObject *T;
-    PyArrayObject *C;
-    
-    // Process the inputs.
-    if (!PyArg_ParseTuple(args, "OOO", &P, &T, &C)) {
-        // Check for failure.
-        PyErr_SetString(PyExc_RuntimeError, \
-            "Could not process inputs to :func:`pc.WriteTri_b4`");
-        return NULL;
-    }
-    
-    // Read number of nodes and triangles
-    nNode = (int) PyArray_DIM(P, 0);
-    nTri  = (int) PyArray_DIM(T, 0);
-    // Number of bytes in header record
-    nb = 2*sizeof(int);
-    
-    // Open Output file for writing
-    fid = fopen("Components.pyCart.tri", "wb");
-    
-    // Write header record
-    capec_Write_lb4_i(fid, nb);
-    capec_Write_lb4_i(fid, nNode);
-    capec_Write_lb4_i(fid, nTri);
-    capec_Write_lb4_i(fid, nb);
-    
-    // Write the nodes, tris, and CompIDs
-    ierr = ierr & capec_WriteRecord_lb4_f2(fid, P);
-    ierr = ierr & capec_WriteRecord_lb4_i2(fid, T);
-    ierr = ierr & capec_WriteRecord_lb4_i1(fid, C);
-    
-    // Check for errors; error message set elsewhere
-    if (ierr) {return NULL; }
-    
-    // Close the file.
-    ierr = fclose(fid);
-    // Check for errors.
-    if (ierr) {
-        PyErr_SetString(PyExc_IOError, \
-            "Failure on closing file 'Components.pyCart.tri'");
-        return NULL;
-    }
-    
-    // Return None.
-    Py_INCREF(Py_None);
-    return Py_None;
+    return cape_WriteTriRecords(args, "WriteTri_lb4", capeREC_F4, !is_le());
 }
 
 // Function to write binary tri, double-precision big-endian
 PyObject *
 cape_WriteTri_b8(PyObject *self, PyObject *args)
 {
-    int i, ierr=1;
-    int nNode, nTri, nb;
-    FILE *fid;
-    PyArrayObject *P;
-    PyArrayObject *T;
-    PyArrayObject *C;
-    
-    // Process the inputs.
-    if (!PyArg_ParseTuple(args, "OOO", &P, &T, &C)) {
-        // Check for failure.
-        PyErr_SetString(PyExc_RuntimeError, \
-            "Could not process inputs to :func:`pc.WriteTri_b4`");
-        return NULL;
-    }
-    
-    // Read number of nodes and triangles
-    nNode = (int) PyArray_DIM(P, 0);
-    nTri  = (int) PyArray_DIM(T, 0);
-    // Number of bytes in header record
-    nb = 2*sizeof(int);
-    
-    // Open Output file for writing
-    fid = fopen("Components.pyCart.tri", "wb");
-    
-    // Write header record
-    capec_Write_b4_i(fid, nb);
-    capec_Write_b4_i(fid, nNode);
-    capec_Write_b4_i(fid, nTri);
-    capec_Write_b4_i(fid, nb);
-    
-    // Write the nodes, tris, and CompIDs
-    ierr = ierr & capec_WriteRecord_b8_f2(fid, P);
-    ierr = ierr & capec_WriteRecord_b4_i2(fid, T);
-    ierr = ierr & capec_WriteRecord_b4_i1(fid, C);
-    
-    // Check for errors; error message set elsewhere
-    if (ierr) {return NULL; }
-    
-    // Close the file.
-    ierr = fclose(fid);
-    // Check for errors.
-    if (ierr) {
-        PyErr_SetString(PyExc_IOError, \
-            "Failure on closing file 'Components.pyCart.tri'");
-        return NULL;
-    }
-    
-    // Return None.
-    Py_INCREF(Py_None);
-    return Py_None;
+    return cape_WriteTriRecords(args, "WriteTri_b8", capeREC_F8, is_le());
 }
 
 // Function to write binary tri, double-precision little-endian
 PyObject *
 cape_WriteTri_lb8(PyObject *self, PyObject *args)
 {
-    int i, ierr=1;
-    int nNode, nTri, nb;
-    FILE *fid;
-    PyArrayObject *P;
-    PyArrayObject *T;
-    PyArrayObject *C;
+    return cape_WriteTriRecords(args, "WriteTri_lb8", capeREC_F8, !is_le());
+}
+
+// Function to write Fortran record tri, single-precision big-endian
+PyObject *
+cape_WriteTri_r4(PyObject *self, PyObject *args)
+{
+    return cape_WriteTriRecords(args, "WriteTri_r4", capeREC_F4, is_le());
+}
+
+// Function to write Fortran record tri, single-precision little-endian
+PyObject *
+cape_WriteTri_lr4(PyObject *self, PyObject *args)
+{
+    return cape_WriteTriRecords(args, "WriteTri_lr4", capeREC_F4, !is_le());
+}
+
+// Function to write Fortran record tri, double-precision big-endian
+PyObject *
+cape_WriteTri_r8(PyObject *self, PyObject *args)
+{
+    return cape_WriteTriRecords(args, "WriteTri_r8", capeREC_F8, is_le());
+}
+
+// Function to write Fortran record tri, double-precision little-endian
+PyObject *
+cape_WriteTri_lr8(PyObject *self, PyObject *args)
+{
+    return cape_WriteTriRecords(args, "WriteTri_lr8", capeREC_F8, !is_le());
+}
+
+// Function to write Fortran stream tri/triq file
+PyObject *
+cape_WriteTriStream(PyObject *self, PyObject *args)
+{
+    int swap, rnode;
+    int nf = 4;
+    int ni = 4;
+    PyObject *target;
+    const char *bo = NULL;
+    PyObject *P;
+    PyObject *T;
+    PyObject *C;
+    PyObject *Q = Py_None;
     
     // Process the inputs.
-    if (!PyArg_ParseTuple(args, "OOO", &P, &T, &C)) {
+    if (!PyArg_ParseTuple(args, "OOOO|Ozii",
+            &target, &P, &T, &C, &Q, &bo, &nf, &ni)) {
         // Check for failure.
         PyErr_SetString(PyExc_RuntimeError, \
-            "Could not process inputs to :func:`pc.WriteTri_b4`");
+            "Could not process inputs to :func:`pc.WriteTriStream`");
         return NULL;
     }
     
-    // Read number of nodes and triangles
-    nNode = (int) PyArray_DIM(P, 0);
-    nTri  = (int) PyArray_DIM(T, 0);
-    // Number of bytes in header record
-    nb = 2*sizeof(int);
-    
-    // Open Output file for writing
-    fid = fopen("Components.pyCart.tri", "wb");
-    
-    // Write header record
-    capec_Write_lb4_i(fid, nb);
-    capec_Write_lb4_i(fid, nNode);
-    capec_Write_lb4_i(fid, nTri);
-    capec_Write_lb4_i(fid, nb);
-    
-    // Write the nodes, tris, and CompIDs
-    ierr = ierr & capec_WriteRecord_lb8_f2(fid, P);
-    ierr = ierr & capec_WriteRecord_lb4_i2(fid, T);
-    ierr = ierr & capec_WriteRecord_lb4_i1(fid, C);
-    
-    // Check for errors; error message set elsewhere
-    if (ierr) {return NULL; }
-    
-    // Close the file.
-    ierr = fclose(fid);
-    // Check for errors.
-    if (ierr) {
-        PyErr_SetString(PyExc_IOError, \
-            "Failure on closing file 'Components.pyCart.tri'");
+    // Byte order
+    if (bo == NULL) {
+        swap = 0;
+    } else if (strcmp(bo, "little") == 0) {
+        swap = !is_le();
+    } else if (strcmp(bo, "big") == 0) {
+        swap = is_le();
+    } else {
+        PyErr_Format(PyExc_ValueError, \
+            "Unrecognized byte order '%s'", bo);
+        return NULL;
+    }
+    // Precision
+    if (nf == 4) {
+        rnode = capeREC_F4;
+    } else if (nf == 8) {
+        rnode = capeREC_F8;
+    } else {
+        PyErr_Format(PyExc_ValueError, \
+            "Byte count must be 4 or 8; got %i", nf);
         return NULL;
     }
+    // Integer size
+    if (cape_TriIntSize(ni))
+        return NULL;
     
-    // Return None.
-    Py_INCREF(Py_None);
-    return Py_None;
+    // Write
+    return cape_WriteTriBin(target, P, T, C, Q, rnode, ni, swap, 0);
 }
 
 
@@ -316,138 +388,278 @@ cape_WriteTri_lb8(PyObject *self, PyObject *args)
 PyObject *
 cape_WriteSurf(PyObject *self, PyObject *args)
 {
-    int i, ierr;
-    int nNode, nTri, nQuad;
-    FILE *fid;
-    PyArrayObject *P;
-    PyArrayObject *T;
-    PyArrayObject *CT;
-    PyArrayObject *BCT;
-    PyArrayObject *Q;
-    PyArrayObject *CQ;
-    PyArrayObject *BCQ;
-    PyArrayObject *blds;
-    PyArrayObject *bldel;
+    int k, ierr;
+    long nNode, nTri, nQuad;
+    npy_intp dims[2];
+    const char *what = "header";
+    const char *fmt = "ascii";
+    capecSink sink;
+    capecSurf s;
+    PyObject *target = Py_None;
+    PyObject *oP, *oT, *oCT, *oBCT, *oQ, *oCQ, *oBCQ, *oblds, *obldel;
+    PyArrayObject *X[3] = {NULL, NULL, NULL};
+    PyArrayObject *P = NULL;
+    PyArrayObject *T = NULL;
+    PyArrayObject *CT = NULL;
+    PyArrayObject *BCT = NULL;
+    PyArrayObject *Q = NULL;
+    PyArrayObject *CQ = NULL;
+    PyArrayObject *BCQ = NULL;
+    PyArrayObject *blds = NULL;
+    PyArrayObject *bldel = NULL;
     
     // Process the inputs
-    if (!PyArg_ParseTuple(args, "OOOOOOOOO", &P, &blds, &bldel,
-        &T, &CT, &BCT, &Q, &CQ, &BCQ)){
+    if (!PyArg_ParseTuple(args, "OOOOOOOOO|Os", &oP, &oblds, &obldel,
+        &oT, &oCT, &oBCT, &oQ, &oCQ, &oBCQ, &target, &fmt)){
         // Check for failure.
         PyErr_SetString(PyExc_RuntimeError, \
             "Could not process inputs to :func:`pc.WriteSurf`");
         return NULL;
     }
-    // Check for two-dimensional node array.
-    if (PyArray_NDIM(P) != 2) {
-        PyErr_SetString(PyExc_ValueError, \
-            "Nodal coordinates must be Nx3 or Nx2 array.");
-        return NULL;
-    }
-    // Read number of nodes.
-    nNode = (int) PyArray_DIM(P, 0);
-    
-    // Check for two-dimensional Nx3 array.
-    if (PyArray_NDIM(T) != 2) {
-        PyErr_SetString(PyExc_ValueError, \
-            "Triangle nodes must be Nx3 array.");
+    // Output format
+    memset(&s, 0, sizeof(capecSurf));
+    if (capec_SurfFormat(&s, fmt)) {
+        PyErr_Format(PyExc_ValueError, "Unrecognized surf format '%s'", fmt);
         return NULL;
     }
-    // Read number of triangles.
-    nTri = (int) PyArray_DIM(T, 0);
     
-    // Check for two-dimensional Nx3 array.
-    if (PyArray_NDIM(Q) != 2) {
+    // Pin all arrays while holding the GIL
+    ierr = cape_TriPin(&P, oP, NPY_DOUBLE, 2, 0);
+    ierr = cape_TriPin(&blds, oblds, NPY_DOUBLE, 1, ierr);
+    ierr = cape_TriPin(&bldel, obldel, NPY_DOUBLE, 1, ierr);
+    ierr = cape_TriPin(&T, oT, NPY_INT, 2, ierr);
+    ierr = cape_TriPin(&CT, oCT, NPY_INT, 1, ierr);
+    ierr = cape_TriPin(&BCT, oBCT, NPY_INT, 1, ierr);
+    ierr = cape_TriPin(&Q, oQ, NPY_INT, 2, ierr);
+    ierr = cape_TriPin(&CQ, oCQ, NPY_INT, 1, ierr);
+    ierr = cape_TriPin(&BCQ, oBCQ, NPY_INT, 1, ierr);
+    // Check BL inputs
+    if (!ierr && (PyArray_DIM(blds, 0) != PyArray_DIM(P, 0) ||
+            PyArray_DIM(bldel, 0) != PyArray_DIM(P, 0))) {
         PyErr_SetString(PyExc_ValueError, \
-            "Quad nodes must be Nx4 array.");
-        return NULL;
-    }
-    // Read number of triangles.
-    nQuad = (int) PyArray_DIM(Q, 0);
-    
-    // Open output file for writing (wipe out if it exists.)
-    fid = fopen("Components.pyCart.surf", "w");
-    
-    // Write the number of nodes and tris.
-    fprintf(fid, "%12i%12i%12i\n", nTri, nQuad, nNode);
-    
-    // Write the nodes.
-    ierr = capec_WriteSurfNodes(fid, P, blds, bldel);
+            "BL spacing and depths must have one value per node.");
+        ierr = 1;
+    }
+    // Rows of binary sections, packed from the inputs
+    if (!ierr && !s.ascii) {
+        s.nNode = (long) PyArray_DIM(P, 0);
+        s.nTri  = (long) PyArray_DIM(T, 0);
+        s.nQuad = (long) PyArray_DIM(Q, 0);
+        s.ncol = 5;
+        dims[0] = (npy_intp) s.nNode;
+        dims[1] = 5;
+        X[0] = (PyArrayObject *) PyArray_SimpleNew(2, dims, NPY_DOUBLE);
+        dims[0] = (npy_intp) s.nTri;
+        dims[1] = capeSURF_NTRICOL;
+        X[1] = (PyArrayObject *) PyArray_SimpleNew(2, dims, NPY_INT);
+        dims[0] = (npy_intp) s.nQuad;
+        dims[1] = capeSURF_NQUADCOL;
+        X[2] = (PyArrayObject *) PyArray_SimpleNew(2, dims, NPY_INT);
+        ierr = (X[0] == NULL || X[1] == NULL || X[2] == NULL);
+    }
+    // Open output (wipe out if it exists.)
+    if (!ierr) {
+        ierr = capec_SinkOpen(&sink, target, "Components.pyCart.surf",
+            s.ascii ? "w" : "wb");
+    }
+    // Check for failures
     if (ierr) {
-        PyErr_SetString(PyExc_IOError, \
-            "Failure writing nodes to `Components.pyCart.surf'");
+        Py_XDECREF(X[0]);
+        Py_XDECREF(X[1]);
+        Py_XDECREF(X[2]);
+        Py_XDECREF(P);
+        Py_XDECREF(blds);
+        Py_XDECREF(bldel);
+        Py_XDECREF(T);
+        Py_XDECREF(CT);
+        Py_XDECREF(BCT);
+        Py_XDECREF(Q);
+        Py_XDECREF(CQ);
+        Py_XDECREF(BCQ);
+        return NULL;
     }
-    // Write the tris.
-    if (nTri > 0) {
-        ierr = capec_WriteSurfTris(fid, T, CT, BCT);
-        if (ierr) {
-            PyErr_SetString(PyExc_IOError, \
-                "Failure writing tris to `Components.pyCart.surf'");
+    // Read number of nodes, triangles, and quads.
+    nNode = (long) PyArray_DIM(P, 0);
+    nTri  = (long) PyArray_DIM(T, 0);
+    nQuad = (long) PyArray_DIM(Q, 0);
+    
+    // Format and write without the GIL
+    Py_BEGIN_ALLOW_THREADS
+    if (s.ascii) {
+        // Write the number of nodes and tris.
+        if (fprintf(sink.fp, "%12li%12li%12li\n", nTri, nQuad, nNode) < 0) {
+            ierr = capeIO_ERR_WRITE;
         }
-    }
-    // Write the quads.
-    if (nQuad > 0) {
-        ierr = capec_WriteSurfQuads(fid, Q, CQ, BCQ);
-        if (ierr) {
-            PyErr_SetString(PyExc_IOError, \
-                "Failure writing quads to `Components.pyCart.surf'");
+        // Write the nodes.
+        if (!ierr) {
+            what = "nodes";
+            ierr = capec_WriteSurfNodes(sink.fp, P, blds, bldel);
+        }
+        // Write the tris.
+        if (!ierr && nTri > 0) {
+            what = "tris";
+            ierr = capec_WriteSurfTris(sink.fp, T, CT, BCT);
+        }
+        // Write the quads.
+        if (!ierr && nQuad > 0) {
+            what = "quads";
+            ierr = capec_WriteSurfQuads(sink.fp, Q, CQ, BCQ);
+        }
+    } else {
+        // Pack rows of each section
+        what = "nodes";
+        ierr = capec_PackSurfNodes(
+            (double *) PyArray_DATA(X[0]), P, blds, bldel);
+        if (!ierr) {
+            what = "tris";
+            ierr = capec_PackSurfFaces(
+                (int *) PyArray_DATA(X[1]), 3, T, CT, BCT);
+        }
+        if (!ierr) {
+            what = "quads";
+            ierr = capec_PackSurfFaces(
+                (int *) PyArray_DATA(X[2]), 4, Q, CQ, BCQ);
+        }
+        // Write header and one record per section
+        if (!ierr) {
+            ierr = capec_WriteSurfBin(sink.fp, &s, X, &k);
+            what = ierr ? capeSURF_NAMES[k] : "quads";
         }
     }
-    
-    // Close the file.
-    ierr = fclose(fid);
-    if (ierr) {
-        // Failure on close?
-        PyErr_SetString(PyExc_IOError, \
-            "Failure on closing file 'Components.pyCart.tri'");
-        return NULL;
-    }
-    
-    // Return None.
-    Py_INCREF(Py_None);
-    return Py_None;
+    // Push everything to the target
+    if (!ierr && fflush(sink.fp)) {
+        ierr = capeIO_ERR_WRITE;
+    }
+    Py_END_ALLOW_THREADS
+    
+    // Release arrays
+    Py_XDECREF(X[0]);
+    Py_XDECREF(X[1]);
+    Py_XDECREF(X[2]);
+    Py_DECREF(P);
+    Py_DECREF(blds);
+    Py_DECREF(bldel);
+    Py_DECREF(T);
+    Py_DECREF(CT);
+    Py_DECREF(BCT);
+    Py_DECREF(Q);
+    Py_DECREF(CQ);
+    Py_DECREF(BCQ);
+    // Error message, close, and output
+    return cape_TriFinish(&sink, ierr, what);
 }
-    
+
 
 
 // Function to write the component IDs
 PyObject *
 cape_WriteCompID(PyObject *self, PyObject *args)
 {
-    int i, ierr;
-    int nTri;
-    FILE *fid;
-    PyArrayObject *C;
+    int ierr;
+    capecSink sink;
+    PyObject *target = Py_None;
+    PyObject *oC;
+    PyArrayObject *C = NULL;
     
     // Process the inputs.
-    if (!PyArg_ParseTuple(args, "O", &C)) {
+    if (!PyArg_ParseTuple(args, "O|O", &oC, &target)) {
         // Check for failure.
         PyErr_SetString(PyExc_RuntimeError, \
             "Could not process inputs to :func:`pc.WriteCompID`");
         return NULL;
     }
     
-    // Open output file for writing (wipe out if it exists.)
-    fid = fopen("Components.pyCart.tri", "a");
-    
-    // Write the nodes.
-    ierr = capec_WriteTriCompID(fid, C);
-    if (ierr) {
-        PyErr_SetString(PyExc_IOError, \
-            "Failure writing component IDs to `Components.pyCart.tri'");
+    // Pin CompIDs and open output for appending
+    ierr = cape_TriPin(&C, oC, NPY_INT, 1, 0);
+    if (ierr || capec_SinkOpen(&sink, target, "Components.pyCart.tri", "a")) {
+        Py_XDECREF(C);
+        return NULL;
     }
     
-    // Close the file.
-    ierr = fclose(fid);
-    if (ierr) {
-        // Failure on close?
-        PyErr_SetString(PyExc_IOError, \
-            "Failure on closing file 'Components.pyCart.tri'");
-        return NULL;
+    // Write the component IDs without the GIL
+    Py_BEGIN_ALLOW_THREADS
+    ierr = capec_WriteTriCompID(sink.fp, C);
+    if (!ierr && fflush(sink.fp)) {
+        ierr = capeIO_ERR_WRITE;
     }
+    Py_END_ALLOW_THREADS
     
-    // Return None.
-    Py_INCREF(Py_None);
-    return Py_None;
+    // Release array
+    Py_DECREF(C);
+    // Error message, close, and output
+    return cape_TriFinish(&sink, ierr, "component IDs");
+}
+
+
+// Pin arrays and open output of a ``.triq`` writer
+static int
+cape_TriQOpen(capecSinkJob *j, PyObject *oP, PyObject *oT, PyObject *oC,
+    PyObject *oQ, PyObject *target)
+{
+    int ierr;
+    PyArrayObject *A[4] = {NULL, NULL, NULL, NULL};
+    
+    // Pin nodes, tris, CompIDs, and states while holding the GIL
+    ierr = cape_TriPin(&A[0], oP, NPY_DOUBLE, 2, 0);
+    ierr = cape_TriPin(&A[1], oT, NPY_INT, 2, ierr);
+    ierr = cape_TriPin(&A[2], oC, NPY_INT, 1, ierr);
+    ierr = cape_TriPin(&A[3], oQ, NPY_DOUBLE, 2, ierr);
+    // Job owns the arrays from here on
+    memcpy(j->A, A, sizeof(A));
+    if (ierr)
+        return ierr;
+    // Check for two-dimensional triangle index array.
+    if (PyArray_DIM(A[1], 1) != 3) {
+        PyErr_SetString(PyExc_ValueError, \
+            "Nodal indices must be Nx3 array.");
+        return 1;
+    }
+    // Open output (wipe out if it exists.)
+    return capec_SinkOpen(&j->sink, target, "Components.pyCart.tri", "w");
+}
+
+// Format and write ``.triq`` file (no Python API)
+static int
+cape_TriQRun(capecSinkJob *j)
+{
+    int ierr = 0;
+    FILE *fp = j->sink.fp;
+    PyArrayObject *P = (PyArrayObject *) j->A[0];
+    PyArrayObject *T = (PyArrayObject *) j->A[1];
+    PyArrayObject *C = (PyArrayObject *) j->A[2];
+    PyArrayObject *Q = (PyArrayObject *) j->A[3];
+    
+    // Write the number of nodes, tris, and states.
+    j->what = "header";
+    if (fprintf(fp, "%12li%12li%4i\n", (long) PyArray_DIM(P, 0),
+            (long) PyArray_DIM(T, 0), (int) PyArray_DIM(Q, 1)) < 0) {
+        ierr = capeIO_ERR_WRITE;
+    }
+    // Write the nodes.
+    if (!ierr) {
+        j->what = "nodes";
+        ierr = capec_WriteTriNodes(fp, P);
+    }
+    // Write the tris.
+    if (!ierr) {
+        j->what = "tris";
+        ierr = capec_WriteTriTris(fp, T);
+    }
+    // Write the ComponentIDs.
+    if (!ierr) {
+        j->what = "CompIDs";
+        ierr = capec_WriteTriCompID(fp, C);
+    }
+    // Write the states.
+    if (!ierr) {
+        j->what = "state";
+        ierr = capec_WriteTriState(fp, Q);
+    }
+    // Push everything to the target
+    if (!ierr && fflush(fp)) {
+        ierr = capeIO_ERR_WRITE;
+    }
+    return ierr;
 }
 
 
@@ -455,183 +667,267 @@ cape_WriteCompID(PyObject *self, PyObject *args)
 PyObject *
 cape_WriteTriQ(PyObject *self, PyObject *args)
 {
-    int i, ierr;
-    int nNode, nTri, nq;
-    FILE *fid;
-    PyArrayObject *P;
-    PyArrayObject *T;
-    PyArrayObject *C;
-    PyArrayObject *Q;
+    int ierr;
+    capecSinkJob job;
+    PyObject *target = Py_None;
+    PyObject *oP, *oT, *oC, *oQ;
     
     // Process the inputs.
-    if (!PyArg_ParseTuple(args, "OOOO", &P, &T, &C, &Q)) {
+    if (!PyArg_ParseTuple(args, "OOOO|O", &oP, &oT, &oC, &oQ, &target)) {
         // Check for failure.
         PyErr_SetString(PyExc_RuntimeError, \
             "Could not process inputs to :func:`pc.WriteTri`");
         return NULL;
     }
     
-    // Check for two-dimensional node array.
-    if (PyArray_NDIM(P) != 2) {
-        PyErr_SetString(PyExc_ValueError, \
-            "Nodal coordinates must be Nx3 or Nx2 array.");
+    // Pin arrays and open output
+    memset(&job, 0, sizeof(job));
+    if (cape_TriQOpen(&job, oP, oT, oC, oQ, target)) {
+        capec_SinkJobRelease(&job);
+        capec_SinkClose(&job.sink, 1);
         return NULL;
     }
-    // Read number of nodes.
-    nNode = (int) PyArray_DIM(P, 0);
     
-    // Check for two-dimensional triangle index array.
-    if (PyArray_NDIM(T) != 2 || PyArray_DIM(T, 1) != 3) {
-        PyErr_SetString(PyExc_ValueError, \
-            "Nodal indices must be Nx3 array.");
+    // Format and write without the GIL
+    Py_BEGIN_ALLOW_THREADS
+    ierr = cape_TriQRun(&job);
+    Py_END_ALLOW_THREADS
+    
+    // Release arrays
+    capec_SinkJobRelease(&job);
+    // Error message, close, and output
+    return cape_TriFinish(&job.sink, ierr, job.what);
+}
+
+
+// Function to start writing Components.pyCart.tri file in background
+PyObject *
+cape_WriteTriQAsync(PyObject *self, PyObject *args)
+{
+    capecSinkJob *job;
+    PyObject *target = Py_None;
+    PyObject *oP, *oT, *oC, *oQ;
+    
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "OOOO|O", &oP, &oT, &oC, &oQ, &target)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.WriteTriQAsync`");
         return NULL;
     }
-    // Read number of triangles.
-    nTri = (int) PyArray_DIM(T, 0);
     
-    // Check for one-dimensional CompIDs
-    if (PyArray_NDIM(C) != 1) {
-        PyErr_SetString(PyExc_ValueError, \
-            "Component IDs must be one-dimensional array.");
+    // Pin arrays and open output
+    job = capec_SinkJobNew();
+    if (job == NULL)
+        return NULL;
+    if (cape_TriQOpen(job, oP, oT, oC, oQ, target)) {
+        capec_SinkJobFree(job);
         return NULL;
     }
+    // Start writer; handle owns the job
+    job->run = cape_TriQRun;
+    return capec_SinkJobStart(job);
+}
+
+
+// Write ASCII or binary STL file
+static PyObject *
+cape_WriteSTL(PyObject *args, const char *func, int binary)
+{
+    int ierr;
+    capecSink sink;
+    PyObject *target = Py_None;
+    PyObject *oP, *oT;
+    PyObject *oN = Py_None;
+    PyArrayObject *P = NULL;
+    PyArrayObject *T = NULL;
+    PyArrayObject *N = NULL;
     
-    // Check for two-dimensional q array
-    if (PyArray_NDIM(Q) != 2) {
-        PyErr_SetString(PyExc_ValueError, \
-            "State array must be two-dimensional.");
+    // Process the inputs
+    if (!PyArg_ParseTuple(args, "OO|OO", &oP, &oT, &oN, &target)) {
+        // Check for failure.
+        PyErr_Format(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.%s`", func);
         return NULL;
     }
-    // Read number of states.
-    nq = (int) PyArray_DIM(Q, 1);
     
-    // Open output file for writing (wipe out if it exists.)
-    fid = fopen("Components.pyCart.tri", "w");
-    
-    // Write the number of nodes and tris.
-    fprintf(fid, "%12i%12i%4i\n", nNode, nTri, nq);
-    
-    // Write the nodes.
-    ierr = capec_WriteTriNodes(fid, P);
-    if (ierr) {
-        PyErr_SetString(PyExc_IOError, \
-            "Failure writing nodes to `Components.pyCart.tri'");
+    // Pin nodes, tris, and (optional) normals while holding the GIL
+    ierr = cape_TriPin(&P, oP, NPY_DOUBLE, 2, 0);
+    ierr = cape_TriPin(&T, oT, NPY_INT, 2, ierr);
+    if (oN != Py_None) {
+        ierr = cape_TriPin(&N, oN, NPY_DOUBLE, 2, ierr);
     }
-    // Write the tris.
-    ierr = capec_WriteTriTris(fid, T);
-    if (ierr) {
-        PyErr_SetString(PyExc_IOError, \
-            "Failure writing tris to `Components.pyCart.tri'");
+    // Check for two-dimensional Nx3 arrays.
+    if (!ierr && PyArray_DIM(P, 1) != 3) {
+        PyErr_SetString(PyExc_ValueError, \
+            "Nodal coordinates must be Nx3 array.");
+        ierr = 1;
+    } else if (!ierr && PyArray_DIM(T, 1) != 3) {
+        PyErr_SetString(PyExc_ValueError, \
+            "Nodal indices must be Nx3 array.");
+        ierr = 1;
+    } else if (!ierr && N != NULL && (PyArray_DIM(N, 1) != 3 ||
+            PyArray_DIM(N, 0) != PyArray_DIM(T, 0))) {
+        PyErr_SetString(PyExc_ValueError, \
+            "Normal vectors must be Nx3 array with one row per tri.");
+        ierr = 1;
     }
-    // Write the ComponentIDs.
-    ierr = capec_WriteTriCompID(fid, C);
-    if (ierr) {
-        PyErr_SetString(PyExc_IOError, \
-            "Failure writing CompIDs to `Components.pyCart.tri'");
+    // Open output (wipe out if it exists.)
+    if (!ierr) {
+        ierr = capec_SinkOpen(&sink, target, "Components.pyCart.stl",
+            binary ? "wb" : "w");
     }
-    // Write the tris.
-    ierr = capec_WriteTriState(fid, Q);
+    // Check for failures
     if (ierr) {
-        PyErr_SetString(PyExc_IOError, \
-            "Failure writing state to `Components.pyCart.tri'");
+        Py_XDECREF(P);
+        Py_XDECREF(T);
+        Py_XDECREF(N);
+        return NULL;
     }
     
-    // Close the file.
-    ierr = fclose(fid);
-    if (ierr) {
-        // Failure on close?
-        PyErr_SetString(PyExc_IOError, \
-            "Failure on closing file 'Components.pyCart.tri'");
-        return NULL;
+    // Compute normals, format, and write without the GIL
+    Py_BEGIN_ALLOW_THREADS
+    if (binary) {
+        ierr = capec_WriteTriSTLBin(sink.fp, P, T, N);
+    } else {
+        ierr = capec_WriteTriSTL(sink.fp, P, T, N);
     }
+    // Push everything to the target
+    if (!ierr && fflush(sink.fp)) {
+        ierr = capeIO_ERR_WRITE;
+    }
+    Py_END_ALLOW_THREADS
     
-    // Return None.
-    Py_INCREF(Py_None);
-    return Py_None;
+    // Release arrays
+    Py_DECREF(P);
+    Py_DECREF(T);
+    Py_XDECREF(N);
+    // Error message, close, and output
+    return cape_TriFinish(&sink, ierr, "facets");
 }
 
-
-// Function to write Components.pyCart.stl file
+// Function to write ASCII Components.pyCart.stl file
 PyObject *
 cape_WriteTriSTL(PyObject *self, PyObject *args)
 {
-    int i, ierr;
-    int i0, i1, i2;
-    int nNode, nTri;
-    FILE *fid;
-    PyArrayObject *P, *T, *N;
+    return cape_WriteSTL(args, "WriteTriSTL", 0);
+}
+
+// Function to write binary Components.pyCart.stl file
+PyObject *
+cape_WriteTriSTLBin(PyObject *self, PyObject *args)
+{
+    return cape_WriteSTL(args, "WriteTriSTLBin", 1);
+}
+
+
+// Read binary tri/triq file into arrays
+static PyObject *
+cape_ReadTriBin(PyObject *args, const char *func, int readq,
+    int (*fparse)(char *, size_t, capecTriBin *))
+{
+    int ierr;
+    int tf, ti;
+    int view = 0;
+    npy_intp dims[2];
+    const char *fname;
+    char *data;
+    capecMap m;
+    capecTriBin t;
+    PyObject *cap, *base;
+    PyObject *P = NULL;
+    PyObject *T = NULL;
+    PyObject *C = NULL;
+    PyObject *Q = NULL;
     
-    // Process the inputs
-    if (!PyArg_ParseTuple(args, "OOO", &P, &T, &N)) {
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "s|p", &fname, &view)) {
         // Check for failure.
-        PyErr_SetString(PyExc_RuntimeError, \
-            "Could not process inputs to :func:`pc.WriteTriSTL`");
+        PyErr_Format(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.%s`", func);
         return NULL;
     }
     
-    // Check for two-dimensional node array.
-    if (PyArray_NDIM(P) != 2) {
-        PyErr_SetString(PyExc_ValueError, \
-            "Nodal coordinates must be Nx3 or Nx2 array.");
+    // Map the file
+    if (capec_MapOpen(&m, fname))
         return NULL;
-    }
-    // Read number of nodes.
-    nNode = (int) PyArray_DIM(P, 0);
-    
-    // Check for two-dimensional Nx3 array.
-    if (PyArray_NDIM(T) != 2 || PyArray_DIM(T, 1) != 3) {
-        PyErr_SetString(PyExc_ValueError, \
-            "Nodal indices must be Nx3 array.");
+    // Find and check records
+    ierr = fparse(m.data, m.size, &t);
+    if (ierr) {
+        capec_MapClose(&m);
         return NULL;
     }
-    // Read number of triangles.
-    nTri = (int) PyArray_DIM(T, 0);
-    
-    // Check for third two-dimensional Nx3 array.
-    if (PyArray_NDIM(T) != 2 || PyArray_DIM(T,1) != 3) {
-        PyErr_SetString(PyExc_ValueError, \
-            "Normal vectors must be Nx3 array.");
+    // Capsule owns mapping from here on
+    data = m.data;
+    cap = capec_MapCapsule(&m);
+    if (cap == NULL)
         return NULL;
-    }
-    
-    // Open output file for writing (wipe out if it exists.)
-    fid = fopen("Components.pyCart.stl", "w");
-    
-    // Write the header.
-    fprintf(fid, "solid\n");
-    
-    // Loop through the triangles
-    for (i=1; i<=nTri; i++) {
-        // Write a single triangle.
-        fprintf(fid, "   facet normal   %5.2f %5.2f %5.2f\n", \
-            np2d(N,i,0), np2d(N,i,1), np2d(N,i,2));
-        // Extract node numbers
-        i0 = np2i(T,i,0);
-        i1 = np2i(T,i,1);
-        i2 = np2i(T,i,2);
-        // Write the vertices
-        fprintf(fid, "      outer loop\n");
-        fprintf(fid, "         vertex   %5.2f %5.2f %5.2f\n", \
-            np2d(P,i0,0), np2d(P,i0,1), np2d(P,i0,2));
-        fprintf(fid, "         vertex   %5.2f %5.2f %5.2f\n", \
-            np2d(P,i1,0), np2d(P,i1,1), np2d(P,i1,2));
-        fprintf(fid, "         vertex   %5.2f %5.2f %5.2f\n", \
-            np2d(P,i2,0), np2d(P,i2,1), np2d(P,i2,2));
-        // Triangle footer
-        fprintf(fid, "      endloop\n");
-        fprintf(fid, "   endfacet\n");
-    }
-    
-    // Close the file.
-    ierr = fclose(fid);
-    if (ierr) {
-        // Failure on close?
-        PyErr_SetString(PyExc_IOError, \
-            "Failure on closing file 'Components.pyCart.stl'");
+    // Arrays are copies unless caller asked for views (see capec_MapArray)
+    base = view ? cap : NULL;
+    // Float and integer types
+    tf = (t.nf == 8) ? NPY_DOUBLE : NPY_FLOAT;
+    ti = (t.ni == 8) ? NPY_INT64 : NPY_INT32;
+    
+    // Nodes
+    dims[0] = (npy_intp) t.nNode;
+    dims[1] = 3;
+    P = capec_MapArray(base, data + t.iNodes, 2, dims, tf, t.swap);
+    // Tris
+    dims[0] = (npy_intp) t.nTri;
+    if (P != NULL) {
+        T = capec_MapArray(base, data + t.iTris, 2, dims, ti, t.swap);
+    }
+    // Component IDs
+    if (T != NULL && t.iCompID) {
+        C = capec_MapArray(base, data + t.iCompID, 1, dims, ti, t.swap);
+    } else if (T != NULL) {
+        Py_INCREF(Py_None);
+        C = Py_None;
+    }
+    // States
+    if (readq && C != NULL && t.iq) {
+        dims[0] = (npy_intp) t.nNode;
+        dims[1] = (npy_intp) t.nq;
+        Q = capec_MapArray(base, data + t.iq, 2, dims, tf, t.swap);
+    } else if (readq && C != NULL) {
+        Py_INCREF(Py_None);
+        Q = Py_None;
+    }
+    // Views hold their own references to mapping
+    Py_DECREF(cap);
+    
+    // Check for errors
+    if (C == NULL || (readq && Q == NULL)) {
+        Py_XDECREF(P);
+        Py_XDECREF(T);
+        Py_XDECREF(C);
         return NULL;
     }
-    
-    // Return None.
-    Py_INCREF(Py_None);
-    return Py_None;
+    // Output
+    if (readq) {
+        return Py_BuildValue("NNNN", P, T, C, Q);
+    } else {
+        return Py_BuildValue("NNN", P, T, C);
+    }
+}
+
+// Function to read binary tri file
+PyObject *
+cape_ReadTri(PyObject *self, PyObject *args)
+{
+    return cape_ReadTriBin(args, "ReadTri", 0, capec_ParseTriBin);
+}
+
+// Function to read binary triq file
+PyObject *
+cape_ReadTriQ(PyObject *self, PyObject *args)
+{
+    return cape_ReadTriBin(args, "ReadTriQ", 1, capec_ParseTriBin);
+}
+
+// Function to read Fortran stream tri/triq file
+PyObject *
+cape_ReadTriStream(PyObject *self, PyObject *args)
+{
+    return cape_ReadTriBin(args, "ReadTriStream", 1, capec_ParseTriStream);
 }
@@ -0,0 +1,206 @@
+#include <Python.h>
+
+#if PY_MINOR_VERSION >= 10
+    #define NPY_NO_DEPRECATED_API NPY_2_0_API_VERSION
+#else
+    #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#endif
+#define PY_ARRAY_UNIQUE_SYMBOL _cape_ARRAY_API
+#define NO_IMPORT_ARRAY
+#include <numpy/arrayobject.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Local includes
+#include "capec_TriClean.h"
+
+
+// Check that an array can be modified in place
+static PyArrayObject *
+cape_CleanArray(PyObject *P, int typenum, npy_intp ncol, const char *name)
+{
+    PyArrayObject *A;
+    
+    // Check type, shape, and flags without making a copy
+    A = (PyArrayObject *) P;
+    if (!PyArray_Check(P) || PyArray_TYPE(A) != typenum ||
+            PyArray_NDIM(A) != (ncol ? 2 : 1) ||
+            (ncol && PyArray_DIM(A, 1) != ncol) || !PyArray_ISCARRAY(A)) {
+        PyErr_Format(PyExc_TypeError,
+            "*%s* must be a writable, C-contiguous %s array", name,
+            (typenum == NPY_DOUBLE) ? "Nx3 float64" :
+            (ncol ? "Nx3 int32" : "1-D int32"));
+        return NULL;
+    }
+    return A;
+}
+
+// Allocate work array of new node indices
+static int *
+cape_CleanMap(PyArrayObject *P)
+{
+    int *J;
+    
+    J = (int *) malloc((PyArray_DIM(P, 0) + 1)*sizeof(int));
+    if (J == NULL) {
+        PyErr_NoMemory();
+    }
+    return J;
+}
+
+// Convert status and original index of each new node to output
+static PyObject *
+cape_CleanResult(int ierr, int *J, size_t n)
+{
+    npy_intp dims[1];
+    PyObject *A;
+    
+    // Check for errors
+    if (ierr == capeCLEAN_ERR_INDEX) {
+        PyErr_SetString(PyExc_ValueError, "Tri node index out of range.");
+    } else if (ierr == capeCLEAN_ERR_SIZE) {
+        PyErr_SetString(PyExc_ValueError, \
+            "Too many nodes for 4-byte node indices.");
+    } else if (ierr) {
+        PyErr_NoMemory();
+    }
+    if (ierr) {
+        free(J);
+        return NULL;
+    }
+    // Copy map
+    dims[0] = (npy_intp) n;
+    A = PyArray_SimpleNew(1, dims, NPY_INT32);
+    if (A != NULL && n > 0) {
+        memcpy(PyArray_DATA((PyArrayObject *) A), J, n*sizeof(int));
+    }
+    free(J);
+    return A;
+}
+
+
+// Function to remove unused nodes
+PyObject *
+cape_TriRemoveUnusedNodes(PyObject *self, PyObject *args)
+{
+    int ierr;
+    int *J;
+    size_t n;
+    PyObject *oP, *oT;
+    PyArrayObject *P, *T;
+    
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "OO", &oP, &oT)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.TriRemoveUnusedNodes`");
+        return NULL;
+    }
+    // Arrays to modify
+    P = cape_CleanArray(oP, NPY_DOUBLE, 3, "P");
+    T = P ? cape_CleanArray(oT, NPY_INT32, 3, "T") : NULL;
+    J = T ? cape_CleanMap(P) : NULL;
+    if (J == NULL) {
+        return NULL;
+    }
+    
+    // Compact without the GIL
+    n = (size_t) PyArray_DIM(P, 0);
+    Py_BEGIN_ALLOW_THREADS
+    ierr = capec_TriRemoveUnusedNodes((double *) PyArray_DATA(P), &n,
+        (int *) PyArray_DATA(T), (size_t) PyArray_DIM(T, 0), J);
+    Py_END_ALLOW_THREADS
+    return cape_CleanResult(ierr, J, n);
+}
+
+
+// Function to merge coincident nodes
+PyObject *
+cape_TriWeldNodes(PyObject *self, PyObject *args)
+{
+    int ierr;
+    int *J;
+    size_t n;
+    double tol;
+    PyObject *oP, *oT;
+    PyArrayObject *P, *T;
+    
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "OOd", &oP, &oT, &tol)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.TriWeldNodes`");
+        return NULL;
+    }
+    // Arrays to modify
+    P = cape_CleanArray(oP, NPY_DOUBLE, 3, "P");
+    T = P ? cape_CleanArray(oT, NPY_INT32, 3, "T") : NULL;
+    J = T ? cape_CleanMap(P) : NULL;
+    if (J == NULL) {
+        return NULL;
+    }
+    
+    // Compact without the GIL
+    n = (size_t) PyArray_DIM(P, 0);
+    Py_BEGIN_ALLOW_THREADS
+    ierr = capec_TriWeldNodes((double *) PyArray_DATA(P), &n,
+        (int *) PyArray_DATA(T), (size_t) PyArray_DIM(T, 0), tol, J);
+    Py_END_ALLOW_THREADS
+    return cape_CleanResult(ierr, J, n);
+}
+
+
+// Function to collapse small tris
+PyObject *
+cape_TriRemoveSmallTris(PyObject *self, PyObject *args)
+{
+    int ierr, npass;
+    int *J, *c;
+    size_t n, m;
+    double smalltri;
+    PyObject *oP, *oT, *oC, *oJ;
+    PyArrayObject *P, *T, *C;
+    
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "OOOdi",
+            &oP, &oT, &oC, &smalltri, &npass)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.TriRemoveSmallTris`");
+        return NULL;
+    }
+    // Arrays to modify
+    C = NULL;
+    P = cape_CleanArray(oP, NPY_DOUBLE, 3, "P");
+    T = P ? cape_CleanArray(oT, NPY_INT32, 3, "T") : NULL;
+    if (T != NULL && oC != Py_None) {
+        C = cape_CleanArray(oC, NPY_INT32, 0, "C");
+        if (C == NULL) {
+            return NULL;
+        }
+        // Check size
+        if (PyArray_DIM(C, 0) != PyArray_DIM(T, 0)) {
+            PyErr_SetString(PyExc_ValueError, \
+                "Need one component ID for each tri.");
+            return NULL;
+        }
+    }
+    J = T ? cape_CleanMap(P) : NULL;
+    if (J == NULL) {
+        return NULL;
+    }
+    
+    // Compact without the GIL
+    n = (size_t) PyArray_DIM(P, 0);
+    m = (size_t) PyArray_DIM(T, 0);
+    c = C ? (int *) PyArray_DATA(C) : NULL;
+    Py_BEGIN_ALLOW_THREADS
+    ierr = capec_TriRemoveSmallTris((double *) PyArray_DATA(P), &n,
+        (int *) PyArray_DATA(T), c, &m, smalltri, npass, J);
+    Py_END_ALLOW_THREADS
+    oJ = cape_CleanResult(ierr, J, n);
+    if (oJ == NULL) {
+        return NULL;
+    }
+    return Py_BuildValue("nN", (Py_ssize_t) m, oJ);
+}
@@ -0,0 +1,112 @@
+#include <Python.h>
+
+#if PY_MINOR_VERSION >= 10
+    #define NPY_NO_DEPRECATED_API NPY_2_0_API_VERSION
+#else
+    #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#endif
+#define PY_ARRAY_UNIQUE_SYMBOL _cape_ARRAY_API
+#define NO_IMPORT_ARRAY
+#include <numpy/arrayobject.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Local includes
+#include "capec_io.h"
+#include "capec_TriTopo.h"
+
+
+// Copy array of topology into dictionary
+static int
+cape_TriTopoSet(PyObject *D, const char *key, const int *v, npy_intp n,
+    npy_intp m)
+{
+    int ierr;
+    npy_intp dims[2];
+    PyObject *A;
+    
+    // Create array with *m* columns (1-D if *m* is 0)
+    dims[0] = n;
+    dims[1] = m;
+    A = PyArray_SimpleNew(m ? 2 : 1, dims, NPY_INT32);
+    if (A == NULL)
+        return 1;
+    // Copy
+    if (n > 0) {
+        memcpy(PyArray_DATA((PyArrayObject *) A), v,
+            n * (m ? m : 1) * sizeof(int));
+    }
+    ierr = PyDict_SetItemString(D, key, A);
+    Py_DECREF(A);
+    return ierr;
+}
+
+
+// Function to find edges and adjacency of triangulation
+PyObject *
+cape_TriTopology(PyObject *self, PyObject *args)
+{
+    int ierr;
+    long nnode;
+    capecTriTopo g;
+    PyObject *oT, *D;
+    PyArrayObject *T;
+    
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "Ol", &oT, &nnode)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.TriTopology`");
+        return NULL;
+    }
+    // Aligned, native array
+    T = capec_PinArray(oT, NPY_INT, 2);
+    if (T == NULL)
+        return NULL;
+    // Check dimensions
+    if (PyArray_DIM(T, 1) != 3 || nnode < 0) {
+        PyErr_SetString(PyExc_ValueError, \
+            "Need Mx3 tris and a nonnegative number of nodes.");
+        Py_DECREF(T);
+        return NULL;
+    }
+    
+    // Build it without the GIL
+    Py_BEGIN_ALLOW_THREADS
+    ierr = capec_TriTopoBuild(&g, (const int *) PyArray_DATA(T),
+        (size_t) PyArray_DIM(T, 0), (size_t) nnode);
+    Py_END_ALLOW_THREADS
+    Py_DECREF(T);
+    // Check for errors
+    if (ierr == capeTOPO_ERR_INDEX) {
+        PyErr_SetString(PyExc_ValueError, "Tri node index out of range.");
+        return NULL;
+    } else if (ierr == capeTOPO_ERR_SIZE) {
+        PyErr_SetString(PyExc_ValueError, \
+            "Too many tris for 4-byte adjacency indices.");
+        return NULL;
+    } else if (ierr) {
+        return PyErr_NoMemory();
+    }
+    
+    // Copy arrays to output
+    D = Py_BuildValue("{s:n,s:n,s:n}",
+        "nedge", (Py_ssize_t) g.nedge,
+        "nopen", (Py_ssize_t) g.nopen,
+        "nnonmanifold", (Py_ssize_t) g.nnonmanifold);
+    ierr = (D == NULL) ||
+        cape_TriTopoSet(D, "n2t_ptr", g.n2t_ptr, g.nnode + 1, 0) ||
+        cape_TriTopoSet(D, "n2t", g.n2t, 3*g.ntri, 0) ||
+        cape_TriTopoSet(D, "edges", g.edges, g.nedge, 2) ||
+        cape_TriTopoSet(D, "tri_edges", g.tri_edges, g.ntri, 3) ||
+        cape_TriTopoSet(D, "e2t_ptr", g.e2t_ptr, g.nedge + 1, 0) ||
+        cape_TriTopoSet(D, "e2t", g.e2t, 3*g.ntri, 0) ||
+        cape_TriTopoSet(D, "t2t_ptr", g.t2t_ptr, g.ntri + 1, 0) ||
+        cape_TriTopoSet(D, "t2t", g.t2t, g.t2t_ptr[g.ntri], 0);
+    capec_TriTopoFree(&g);
+    if (ierr) {
+        Py_XDECREF(D);
+        return NULL;
+    }
+    return D;
+}
@@ -0,0 +1,150 @@
+#include <Python.h>
+
+#if PY_MINOR_VERSION >= 10
+    #define NPY_NO_DEPRECATED_API NPY_2_0_API_VERSION
+#else
+    #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#endif
+#define PY_ARRAY_UNIQUE_SYMBOL _cape_ARRAY_API
+#define NO_IMPORT_ARRAY
+#include <numpy/arrayobject.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Local includes
+#include "capec_io.h"
+#include "capec_Geom.h"
+#include "capec_TriqFM.h"
+
+// Largest range of component IDs for dense sums
+#define capeTRIQFM_NCOMPMAX (1 << 20)
+
+
+// Function to add up forces and moments by component
+PyObject *
+cape_TriqForces(PyObject *self, PyObject *args)
+{
+    int ierr;
+    int nthread = 0;
+    int cmin, cmax;
+    size_t i, j, n, nTri, ncomp;
+    npy_intp dims[2];
+    capecTriqFMOpts opts;
+    const int *c;
+    double *S, *vS;
+    int *vI;
+    PyObject *oP, *oT, *oQ, *oC;
+    PyArrayObject *P, *T, *Q, *C;
+    PyObject *I, *OS;
+    
+    // Default options
+    opts.smallvol = 1e-20;
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "OOOOddd|di", &oP, &oT, &oQ, &oC,
+            &opts.mach, &opts.rey, &opts.gam, &opts.smallvol, &nthread)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.TriqForces`");
+        return NULL;
+    }
+    // Aligned, native arrays
+    P = capec_PinArray(oP, NPY_DOUBLE, 2);
+    T = (P == NULL) ? NULL : capec_PinArray(oT, NPY_INT, 2);
+    Q = (T == NULL) ? NULL : capec_PinArray(oQ, NPY_DOUBLE, 2);
+    C = (Q == NULL) ? NULL : capec_PinArray(oC, NPY_INT, 1);
+    if (C == NULL) {
+        Py_XDECREF(P);
+        Py_XDECREF(T);
+        Py_XDECREF(Q);
+        return NULL;
+    }
+    // Check dimensions
+    nTri = (size_t) PyArray_DIM(T, 0);
+    ierr = 0;
+    if (PyArray_DIM(P, 1) != 3 || PyArray_DIM(T, 1) != 3 ||
+            PyArray_DIM(Q, 0) != PyArray_DIM(P, 0) ||
+            (size_t) PyArray_DIM(C, 0) != nTri) {
+        PyErr_SetString(PyExc_ValueError, \
+            "Need Nx3 nodes, Mx3 tris, N rows of states, and M comp IDs.");
+        ierr = 1;
+    } else if (capec_TriCheck((const int *) PyArray_DATA(T), nTri,
+            (size_t) PyArray_DIM(P, 0))) {
+        PyErr_SetString(PyExc_ValueError, "Tri node index out of range.");
+        ierr = 1;
+    }
+    
+    // Range of component IDs
+    c = (const int *) PyArray_DATA(C);
+    cmin = (nTri > 0) ? c[0] : 0;
+    cmax = cmin;
+    for (i=1; i<nTri; i++) {
+        if (c[i] < cmin) {cmin = c[i]; }
+        if (c[i] > cmax) {cmax = c[i]; }
+    }
+    ncomp = (nTri > 0) ? (size_t) ((long) cmax - (long) cmin) + 1 : 0;
+    // Allocate table of sums
+    S = NULL;
+    if (ierr) {
+        // Already failed
+    } else if (ncomp > capeTRIQFM_NCOMPMAX) {
+        PyErr_Format(PyExc_ValueError, \
+            "Range of component IDs (%i to %i) is too large", cmin, cmax);
+        ierr = 1;
+    } else {
+        S = (double *) malloc((ncomp + 1) * capeTRIQFM_NSUM *
+            sizeof(double));
+        ierr = (S == NULL);
+        if (ierr) {
+            PyErr_NoMemory();
+        }
+    }
+    
+    // Integrate forces without the GIL
+    if (!ierr) {
+        Py_BEGIN_ALLOW_THREADS
+        capec_TriqForces((const double *) PyArray_DATA(P),
+            (const int *) PyArray_DATA(T), (const double *) PyArray_DATA(Q),
+            (int) PyArray_DIM(Q, 1), c, nTri, cmin, ncomp, &opts, S,
+            nthread);
+        Py_END_ALLOW_THREADS
+    }
+    // Release inputs
+    Py_DECREF(P);
+    Py_DECREF(T);
+    Py_DECREF(Q);
+    Py_DECREF(C);
+    if (ierr) {
+        return NULL;
+    }
+    
+    // Count components that have tris
+    for (j=0, n=0; j<ncomp; j++) {
+        if (S[capeTRIQFM_NSUM*j + capeTRIQFM_N] > 0) {n++; }
+    }
+    // Allocate outputs
+    dims[0] = (npy_intp) n;
+    dims[1] = capeTRIQFM_NSUM;
+    I  = PyArray_SimpleNew(1, dims, NPY_INT);
+    OS = PyArray_SimpleNew(2, dims, NPY_DOUBLE);
+    if (I == NULL || OS == NULL) {
+        Py_XDECREF(I);
+        Py_XDECREF(OS);
+        free(S);
+        return NULL;
+    }
+    vI = (int *)    PyArray_DATA((PyArrayObject *) I);
+    vS = (double *) PyArray_DATA((PyArrayObject *) OS);
+    // Copy sums of present components
+    for (j=0, i=0; j<ncomp; j++) {
+        if (S[capeTRIQFM_NSUM*j + capeTRIQFM_N] <= 0) {continue; }
+        vI[i] = cmin + (int) j;
+        memcpy(vS + capeTRIQFM_NSUM*i, S + capeTRIQFM_NSUM*j,
+            capeTRIQFM_NSUM*sizeof(double));
+        i++;
+    }
+    
+    // Release table
+    free(S);
+    // Output
+    return Py_BuildValue("NN", I, OS);
+}
@@ -0,0 +1,376 @@
+#include <Python.h>
+
+#if PY_MINOR_VERSION >= 10
+    #define NPY_NO_DEPRECATED_API NPY_2_0_API_VERSION
+#else
+    #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#endif
+#define PY_ARRAY_UNIQUE_SYMBOL _cape_ARRAY_API
+#define NO_IMPORT_ARRAY
+#include <numpy/arrayobject.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+
+// Local includes
+#include "capec_io.h"
+#include "capec_Map.h"
+#include "capec_Scan.h"
+#include "capec_Sink.h"
+#include "capec_UGrid.h"
+
+
+// Get list of sections to read from Python sequence of names
+static int
+cape_UGridSections(PyObject *osec, int *want)
+{
+    int k;
+    const char *name;
+    PyObject *it, *o;
+    
+    // Read all sections by default
+    for (k=0; k<capeUGRID_NSECTION; k++) {
+        want[k] = (osec == Py_None);
+    }
+    if (osec == Py_None) {
+        return 0;
+    }
+    // Loop through names
+    it = PyObject_GetIter(osec);
+    if (it == NULL) {
+        return 1;
+    }
+    while ((o = PyIter_Next(it)) != NULL) {
+        // Get name
+        name = PyUnicode_Check(o) ? PyUnicode_AsUTF8(o) : NULL;
+        if (name == NULL) {
+            PyErr_SetString(PyExc_TypeError,
+                "UGRID section names must be strings");
+            Py_DECREF(o);
+            break;
+        }
+        // Find it
+        for (k=0; k<capeUGRID_NSECTION; k++) {
+            if (strcmp(name, capeUGRID_NAMES[k]) == 0) {break; }
+        }
+        if (k == capeUGRID_NSECTION) {
+            PyErr_Format(PyExc_ValueError,
+                "Unknown UGRID section '%s'", name);
+            Py_DECREF(o);
+            break;
+        }
+        want[k] = 1;
+        Py_DECREF(o);
+    }
+    Py_DECREF(it);
+    return (PyErr_Occurred() != NULL);
+}
+
+// Shape and type of array for one section
+static int
+cape_UGridDims(const capecUGrid *g, int k, npy_intp *dims)
+{
+    // Check for 2-D section
+    if (g->ncol[k]) {
+        dims[0] = (npy_intp) (g->count[k] / g->ncol[k]);
+        dims[1] = (npy_intp) g->ncol[k];
+        return 2;
+    }
+    dims[0] = (npy_intp) g->count[k];
+    return 1;
+}
+
+// Header counts and dictionary of sections as output
+static PyObject *
+cape_UGridOutput(const capecUGrid *g, PyObject *D)
+{
+    return Py_BuildValue("(lllllll)N", g->n[0], g->n[1], g->n[2],
+        g->n[3], g->n[4], g->n[5], g->n[6], D);
+}
+
+// Read selected sections of ASCII UGRID file
+static PyObject *
+cape_ReadUGridText(const char *fname, capecUGrid *g, const int *want)
+{
+    int k, nd, ierr;
+    npy_intp dims[2];
+    char *p;
+    FILE *fp;
+    capecScanBuf b;
+    void *out[capeUGRID_NSECTION];
+    PyObject *A[capeUGRID_NSECTION];
+    PyObject *D;
+    
+    // Open file
+    fp = fopen(fname, "rb");
+    if (fp == NULL) {
+        PyErr_SetFromErrnoWithFilename(PyExc_OSError, fname);
+        return NULL;
+    }
+    // Initialize buffer
+    if (capec_ScanBufInit(&b, fp)) {
+        fclose(fp);
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate read buffer");
+        return NULL;
+    }
+    // Read header
+    Py_BEGIN_ALLOW_THREADS
+    ierr = capec_ReadUGridHeader(&b, &p, g);
+    Py_END_ALLOW_THREADS
+    if (ierr) {
+        capec_ScanBufClose(&b);
+        fclose(fp);
+        PyErr_Format(PyExc_ValueError,
+            "Failed to read 7 sizes from UGRID header of '%s'", fname);
+        return NULL;
+    }
+    
+    // Allocate requested sections
+    for (k=0, ierr=0; k<capeUGRID_NSECTION; k++) {
+        A[k] = NULL;
+        out[k] = NULL;
+        if (!want[k] || ierr) {continue; }
+        nd = cape_UGridDims(g, k, dims);
+        A[k] = PyArray_SimpleNew(nd, dims,
+            capec_UGridIsFloat(k) ? NPY_DOUBLE : NPY_INT);
+        ierr = (A[k] == NULL);
+        if (!ierr) {
+            out[k] = PyArray_DATA((PyArrayObject *) A[k]);
+        }
+    }
+    // Parse without the GIL
+    if (!ierr) {
+        Py_BEGIN_ALLOW_THREADS
+        ierr = capec_ReadUGridText(&b, &p, g, out);
+        Py_END_ALLOW_THREADS
+        // Convert status to exception
+        if (ierr == capeUGRID_ERR_EOF) {
+            PyErr_Format(PyExc_ValueError,
+                "File '%s' ended before end of UGRID %s section",
+                fname, capeUGRID_NAMES[g->nsection]);
+        } else if (ierr == capeUGRID_ERR_VALUE) {
+            PyErr_Format(PyExc_ValueError,
+                "Invalid value in UGRID %s section of '%s'",
+                capeUGRID_NAMES[g->nsection], fname);
+        } else if (ierr) {
+            PyErr_Format(PyExc_IOError,
+                "Failed to read UGRID %s section from '%s'",
+                capeUGRID_NAMES[g->nsection], fname);
+        }
+    }
+    // Close file
+    capec_ScanBufClose(&b);
+    fclose(fp);
+    
+    // Collect sections that were read
+    D = ierr ? NULL : PyDict_New();
+    for (k=0; k<capeUGRID_NSECTION; k++) {
+        if (A[k] == NULL) {continue; }
+        if (D != NULL && k < g->nsection &&
+                PyDict_SetItemString(D, capeUGRID_NAMES[k], A[k])) {
+            Py_CLEAR(D);
+        }
+        Py_DECREF(A[k]);
+    }
+    if (D == NULL) {
+        return NULL;
+    }
+    // Output
+    return cape_UGridOutput(g, D);
+}
+
+// Function to read UGRID file
+PyObject *
+cape_ReadUGrid(PyObject *self, PyObject *args)
+{
+    int k, nd, tf;
+    int view = 0;
+    int want[capeUGRID_NSECTION];
+    npy_intp dims[2];
+    const char *fname;
+    const char *fmt = NULL;
+    char *data;
+    capecMap m;
+    capecUGrid g;
+    PyObject *osec = Py_None;
+    PyObject *cap, *base, *A, *D;
+    
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "s|zOp", &fname, &fmt, &osec, &view)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.ReadUGrid`");
+        return NULL;
+    }
+    // Sections to read
+    if (cape_UGridSections(osec, want)) {
+        return NULL;
+    }
+    // Text files are not mapped
+    memset(&g, 0, sizeof(capecUGrid));
+    if (fmt != NULL && strcmp(fmt, "ascii") == 0) {
+        g.ascii = 1;
+        return cape_ReadUGridText(fname, &g, want);
+    }
+    
+    // Map the file
+    if (capec_MapOpen(&m, fname)) {
+        return NULL;
+    }
+    // Find and check sections
+    if (capec_ParseUGrid(m.data, m.size, fmt, &g)) {
+        capec_MapClose(&m);
+        return NULL;
+    }
+    // Check for text file
+    if (g.ascii) {
+        capec_MapClose(&m);
+        return cape_ReadUGridText(fname, &g, want);
+    }
+    // Capsule owns mapping from here on
+    data = m.data;
+    cap = capec_MapCapsule(&m);
+    if (cap == NULL) {
+        return NULL;
+    }
+    // Arrays are copies unless caller asked for views (see capec_MapArray)
+    base = view ? cap : NULL;
+    // Float type
+    tf = (g.nf == 8) ? NPY_DOUBLE : NPY_FLOAT;
+    
+    // Create a copy (or view) of each requested section
+    D = PyDict_New();
+    for (k=0; D != NULL && k<g.nsection; k++) {
+        if (!want[k]) {continue; }
+        nd = cape_UGridDims(&g, k, dims);
+        A = capec_MapArray(base, data + g.offset[k], nd, dims,
+            capec_UGridIsFloat(k) ? tf : NPY_INT32, g.swap);
+        if (A == NULL || PyDict_SetItemString(D, capeUGRID_NAMES[k], A)) {
+            Py_CLEAR(D);
+        }
+        Py_XDECREF(A);
+    }
+    // Views hold their own references to mapping
+    Py_DECREF(cap);
+    if (D == NULL) {
+        return NULL;
+    }
+    // Output
+    return cape_UGridOutput(&g, D);
+}
+
+
+// Function to write UGRID file
+PyObject *
+cape_WriteUGrid(PyObject *self, PyObject *args)
+{
+    int j, k, nd, ierr;
+    const char *fmt;
+    const char *what;
+    capecUGrid g;
+    capecSink sink;
+    npy_intp n;
+    PyObject *target, *D, *o;
+    PyArrayObject *A[capeUGRID_NSECTION];
+    // Sections with header counts
+    static const int KN[7] = {
+        capeUGRID_NODES, capeUGRID_TRIS, capeUGRID_QUADS, capeUGRID_TETS,
+        capeUGRID_PYRS, capeUGRID_PRIS, capeUGRID_HEXS
+    };
+    
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "OsO!", &target, &fmt, &PyDict_Type, &D)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.WriteUGrid`");
+        return NULL;
+    }
+    // Interpret format
+    memset(&g, 0, sizeof(capecUGrid));
+    if (capec_UGridFormat(&g, fmt)) {
+        PyErr_Format(PyExc_ValueError,
+            "Unrecognized UGRID format '%s'", fmt);
+        return NULL;
+    }
+    // Header counts from number of rows of nodes and cells
+    for (j=0; j<7; j++) {
+        o = PyDict_GetItemString(D, capeUGRID_NAMES[KN[j]]);
+        n = 0;
+        if (o != NULL && PyArray_Check(o) &&
+                PyArray_NDIM((PyArrayObject *) o) == 2) {
+            n = PyArray_DIM((PyArrayObject *) o, 0);
+        }
+        if (n > INT_MAX) {
+            PyErr_Format(PyExc_ValueError,
+                "Too many rows in UGRID %s section", capeUGRID_NAMES[KN[j]]);
+            return NULL;
+        }
+        g.n[j] = (long) n;
+    }
+    capec_UGridSizes(&g);
+    
+    // Pin each section up to the first one that's missing
+    for (k=0, ierr=0; k<capeUGRID_NSECTION; k++) {
+        o = PyDict_GetItemString(D, capeUGRID_NAMES[k]);
+        if (o == NULL || o == Py_None) {break; }
+        // Pin as integer or float without copying if possible
+        nd = g.ncol[k] ? 2 : 1;
+        A[k] = capec_PinView(o,
+            capec_UGridIsFloat(k) ? NPY_DOUBLE : NPY_INT, nd);
+        if (A[k] == NULL) {
+            ierr = 1;
+            break;
+        }
+        // Check size
+        if ((size_t) PyArray_SIZE(A[k]) != g.count[k] ||
+                (nd == 2 && (size_t) PyArray_DIM(A[k], 1) != g.ncol[k])) {
+            PyErr_Format(PyExc_ValueError,
+                "UGRID %s section should have %zu values",
+                capeUGRID_NAMES[k], g.count[k]);
+            Py_DECREF(A[k]);
+            ierr = 1;
+            break;
+        }
+    }
+    g.nsection = k;
+    // Need nodes and tris at least
+    if (!ierr && k < 2) {
+        PyErr_SetString(PyExc_ValueError, \
+            "UGRID file needs at least nodes and tris");
+        ierr = 1;
+    }
+    // Open output for writing
+    if (!ierr) {
+        ierr = capec_SinkOpen(&sink, target, "grid.ugrid",
+            g.ascii ? "w" : "wb");
+    }
+    if (ierr) {
+        for (j=0; j<g.nsection; j++) {
+            Py_DECREF(A[j]);
+        }
+        return NULL;
+    }
+    
+    // Convert and write without the GIL
+    Py_BEGIN_ALLOW_THREADS
+    ierr = capec_WriteUGrid(sink.fp, &g, A, &k);
+    // Push everything to the target
+    if (!ierr && fflush(sink.fp)) {
+        ierr = capeIO_ERR_WRITE;
+    }
+    Py_END_ALLOW_THREADS
+    
+    // Release arrays
+    for (j=0; j<g.nsection; j++) {
+        Py_DECREF(A[j]);
+    }
+    // Convert status to exception (GIL is held again here)
+    what = (k >= 0 && k < g.nsection) ? capeUGRID_NAMES[k] : "header";
+    capec_IOSetError(ierr, what, sink.name);
+    // Close the output.
+    if (capec_SinkClose(&sink, ierr)) {
+        return NULL;
+    }
+    // Return None (or number of bytes for buffers).
+    return capec_SinkResult(&sink);
+}
@@ -0,0 +1,351 @@
+#include <Python.h>
+
+#if PY_MINOR_VERSION >= 10
+    #define NPY_NO_DEPRECATED_API NPY_2_0_API_VERSION
+#else
+    #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#endif
+#define PY_ARRAY_UNIQUE_SYMBOL _cape_ARRAY_API
+#define NO_IMPORT_ARRAY
+#include <numpy/arrayobject.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Local includes
+#include "capec_io.h"
+#include "capec_Map.h"
+#include "capec_Scan.h"
+#include "capec_Sink.h"
+#include "capec_UH3D.h"
+#include "capec_Zip.h"
+
+
+// Add one label to dict of component names, like ReadUH3DCompIDList()
+static int
+cape_UH3DAddLabel(PyObject *conf, const char *name, size_t n, long cid)
+{
+    int ierr;
+    PyObject *key, *v, *old, *L;
+    
+    // Convert name and ID
+    key = PyUnicode_DecodeUTF8(name, (Py_ssize_t) n, "replace");
+    v = PyLong_FromLong(cid);
+    if (key == NULL || v == NULL) {
+        Py_XDECREF(key);
+        Py_XDECREF(v);
+        return 1;
+    }
+    // Names used more than once get a list of IDs
+    old = PyDict_GetItem(conf, key);
+    if (old == NULL) {
+        ierr = PyDict_SetItem(conf, key, v);
+    } else if (PyList_Check(old)) {
+        ierr = PyList_Append(old, v);
+    } else {
+        L = PyList_New(2);
+        ierr = (L == NULL);
+        if (!ierr) {
+            Py_INCREF(old);
+            Py_INCREF(v);
+            PyList_SET_ITEM(L, 0, old);
+            PyList_SET_ITEM(L, 1, v);
+            ierr = PyDict_SetItem(conf, key, L);
+        }
+        Py_XDECREF(L);
+    }
+    Py_DECREF(key);
+    Py_DECREF(v);
+    return ierr;
+}
+
+// Read component labels after tris, stopping at first other line
+static PyObject *
+cape_UH3DLabels(capecScanBuf *b)
+{
+    long cid;
+    size_t n;
+    char *line, *name;
+    PyObject *conf;
+    
+    // Initialize
+    conf = PyDict_New();
+    if (conf == NULL) {
+        return NULL;
+    }
+    // Loop through lines like "1, 'body'"
+    while ((line = capec_ScanBufLine(b)) != NULL) {
+        if (!capec_ParseUH3DLabel(line, &cid, &name, &n)) {
+            break;
+        }
+        if (cape_UH3DAddLabel(conf, name, n, cid)) {
+            Py_DECREF(conf);
+            return NULL;
+        }
+    }
+    return conf;
+}
+
+// Function to read UH3D file
+PyObject *
+cape_ReadUH3D(PyObject *self, PyObject *args)
+{
+    int ierr;
+    const char *fname;
+    npy_intp dims[2];
+    FILE *fp;
+    capecMap m;
+    capecScanBuf b;
+    capecUH3D u;
+    PyObject *P = NULL;
+    PyObject *T = NULL;
+    PyObject *C = NULL;
+    PyObject *conf = NULL;
+    
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "s", &fname)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.ReadUH3D`");
+        return NULL;
+    }
+    // Open file; compressed files are decompressed into memory first
+    m.data = NULL;
+    m.size = 0;
+    m.heap = 0;
+    if (capec_ZipCodec(fname) == capeZIP_NONE) {
+        fp = fopen(fname, "rb");
+        if (fp == NULL) {
+            PyErr_SetFromErrnoWithFilename(PyExc_OSError, fname);
+            return NULL;
+        }
+    } else {
+        if (capec_MapOpen(&m, fname)) {
+            return NULL;
+        }
+        fp = fmemopen(m.data, m.size, "rb");
+        if (fp == NULL) {
+            capec_MapClose(&m);
+            PyErr_SetFromErrnoWithFilename(PyExc_OSError, fname);
+            return NULL;
+        }
+    }
+    // Initialize buffer
+    if (capec_ScanBufInit(&b, fp)) {
+        fclose(fp);
+        capec_MapClose(&m);
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate read buffer");
+        return NULL;
+    }
+    // Read header
+    Py_BEGIN_ALLOW_THREADS
+    ierr = capec_ReadUH3DHeader(&b, &u);
+    Py_END_ALLOW_THREADS
+    if (ierr) {
+        capec_ScanBufClose(&b);
+        fclose(fp);
+        capec_MapClose(&m);
+        PyErr_Format(PyExc_ValueError,
+            "Failed to read counts from UH3D header of '%s'", fname);
+        return NULL;
+    }
+    
+    // Allocate outputs from header counts
+    dims[0] = (npy_intp) u.nNode;
+    dims[1] = 3;
+    P = PyArray_SimpleNew(2, dims, NPY_DOUBLE);
+    dims[0] = (npy_intp) u.nTri;
+    T = PyArray_SimpleNew(2, dims, NPY_INT);
+    C = PyArray_SimpleNew(1, dims, NPY_INT);
+    ierr = (P == NULL || T == NULL || C == NULL);
+    // Parse nodes and tris in one pass without the GIL
+    if (!ierr) {
+        Py_BEGIN_ALLOW_THREADS
+        ierr = capec_ReadUH3D(&b, &u,
+            (double *) PyArray_DATA((PyArrayObject *) P),
+            (int *) PyArray_DATA((PyArrayObject *) T),
+            (int *) PyArray_DATA((PyArrayObject *) C));
+        Py_END_ALLOW_THREADS
+        // Convert status to exception
+        if (ierr == capeUH3D_ERR_EOF) {
+            PyErr_Format(PyExc_ValueError,
+                "File '%s' ended before end of UH3D %s section",
+                fname, capeUH3D_NAMES[u.nsection]);
+        } else if (ierr == capeUH3D_ERR_VALUE) {
+            PyErr_Format(PyExc_ValueError,
+                "Invalid UH3D %s entry on line %zu of '%s'",
+                capeUH3D_NAMES[u.nsection], u.iline, fname);
+        } else if (ierr) {
+            PyErr_Format(PyExc_IOError,
+                "Failed to read UH3D %s section from '%s'",
+                capeUH3D_NAMES[u.nsection], fname);
+        }
+    }
+    // Component names (few lines, so keep the GIL)
+    if (!ierr) {
+        conf = cape_UH3DLabels(&b);
+        ierr = (conf == NULL);
+        if (!ierr && b.ierr) {
+            PyErr_Format(PyExc_IOError,
+                "Failed to read UH3D component names from '%s'", fname);
+            ierr = 1;
+        }
+    }
+    // Close file
+    capec_ScanBufClose(&b);
+    fclose(fp);
+    capec_MapClose(&m);
+    if (ierr) {
+        Py_XDECREF(P);
+        Py_XDECREF(T);
+        Py_XDECREF(C);
+        Py_XDECREF(conf);
+        return NULL;
+    }
+    // Output
+    return Py_BuildValue("NNNN", P, T, C, conf);
+}
+
+
+// Format component label lines and end of file
+static char *
+cape_UH3DLabelText(PyObject *labels, size_t *n)
+{
+    Py_ssize_t k, nlbl, m;
+    size_t size;
+    const char *name;
+    char *txt;
+    PyObject *L;
+    
+    // Get list of labels
+    L = PySequence_Fast(labels, "UH3D labels must be a sequence of str");
+    if (L == NULL) {
+        return NULL;
+    }
+    nlbl = PySequence_Fast_GET_SIZE(L);
+    // Size of output
+    size = 16;
+    for (k=0; k<nlbl; k++) {
+        name = PyUnicode_Check(PySequence_Fast_GET_ITEM(L, k)) ?
+            PyUnicode_AsUTF8AndSize(PySequence_Fast_GET_ITEM(L, k), &m) :
+            NULL;
+        if (name == NULL) {
+            if (!PyErr_Occurred()) {
+                PyErr_Format(PyExc_TypeError,
+                    "UH3D label %li is not a str", (long) k);
+            }
+            Py_DECREF(L);
+            return NULL;
+        }
+        size += (size_t) m + 28;
+    }
+    txt = (char *) malloc(size);
+    if (txt == NULL) {
+        Py_DECREF(L);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    // Lines like "1, 'body'"
+    for (*n=0, k=0; k<nlbl; k++) {
+        name = PyUnicode_AsUTF8AndSize(PySequence_Fast_GET_ITEM(L, k), &m);
+        *n += (size_t) sprintf(txt + *n, "%li, '", (long) k + 1);
+        memcpy(txt + *n, name, (size_t) m);
+        *n += (size_t) m;
+        *n += (size_t) sprintf(txt + *n, "'\n");
+    }
+    // Termination line
+    *n += (size_t) sprintf(txt + *n, "99,99,99,99,99\n");
+    Py_DECREF(L);
+    return txt;
+}
+
+// Function to write UH3D file
+PyObject *
+cape_WriteUH3D(PyObject *self, PyObject *args)
+{
+    int ierr;
+    long nNode, nTri, nID;
+    size_t n;
+    char *txt;
+    const char *what = "header";
+    capecSink sink;
+    PyObject *oP, *oT, *oC, *labels;
+    PyObject *target = Py_None;
+    PyArrayObject *P = NULL;
+    PyArrayObject *T = NULL;
+    PyArrayObject *C = NULL;
+    
+    // Process the inputs.
+    if (!PyArg_ParseTuple(args, "OOOO|O", &oP, &oT, &oC, &labels, &target)) {
+        // Check for failure.
+        PyErr_SetString(PyExc_RuntimeError, \
+            "Could not process inputs to :func:`pc.WriteUH3D`");
+        return NULL;
+    }
+    // Label lines (copied, so the list can't change during the write)
+    nID = (long) PyObject_Length(labels);
+    txt = (nID < 0) ? NULL : cape_UH3DLabelText(labels, &n);
+    if (txt == NULL) {
+        return NULL;
+    }
+    // Pin nodes, tris, and CompIDs while holding the GIL
+    P = capec_PinView(oP, NPY_DOUBLE, 2);
+    T = (P == NULL) ? NULL : capec_PinView(oT, NPY_INT, 2);
+    C = (T == NULL) ? NULL : capec_PinView(oC, NPY_INT, 1);
+    ierr = (C == NULL);
+    // Open output (wipe out if it exists.)
+    if (ierr || capec_SinkOpen(&sink, target, "Components.i.uh3d", "w")) {
+        Py_XDECREF(P);
+        Py_XDECREF(T);
+        Py_XDECREF(C);
+        free(txt);
+        return NULL;
+    }
+    // Read number of nodes and triangles.
+    nNode = (long) PyArray_DIM(P, 0);
+    nTri  = (long) PyArray_DIM(T, 0);
+    
+    // Format and write without the GIL
+    Py_BEGIN_ALLOW_THREADS
+    // Title and counts
+    if (fprintf(sink.fp, " file created by cape\n%li, %li, %li, %li, "
+            "%li, %li\n", nNode, nNode, nTri, nTri, nID, nID) < 0) {
+        ierr = capeIO_ERR_WRITE;
+    }
+    // Write the nodes.
+    if (!ierr) {
+        what = "nodes";
+        ierr = capec_WriteUH3DNodes(sink.fp, P);
+    }
+    // Write the tris and component IDs.
+    if (!ierr) {
+        what = "tris";
+        ierr = capec_WriteUH3DTris(sink.fp, T, C);
+    }
+    // Component names
+    if (!ierr) {
+        what = "component names";
+        if (fwrite(txt, 1, n, sink.fp) != n) {
+            ierr = capeIO_ERR_WRITE;
+        }
+    }
+    // Push everything to the target
+    if (!ierr && fflush(sink.fp)) {
+        ierr = capeIO_ERR_WRITE;
+    }
+    Py_END_ALLOW_THREADS
+    
+    // Release arrays
+    Py_DECREF(P);
+    Py_DECREF(T);
+    Py_DECREF(C);
+    free(txt);
+    // Convert status to exception (GIL is held again here)
+    capec_IOSetError(ierr, what, sink.name);
+    // Close the output.
+    if (capec_SinkClose(&sink, ierr)) {
+        return NULL;
+    }
+    // Return None (or number of bytes for buffers).
+    return capec_SinkResult(&sink);
+}
@@ -0,0 +1,540 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Local includes
+#include "capec_BVH.h"
+#include "capec_Thread.h"
+
+// Size of search stack; tree depth is at most about log2(nTri)
+#define capeBVH_STACK 256
+
+// Smallest length of cross product used to normalize (same as trifile.py)
+#define capeBVH_AMIN 1e-10
+
+
+// Work for one thread
+typedef struct {
+    const capecBVH *b;      // Tree
+    const double *X;        // Points
+    size_t i0;              // First point
+    size_t i1;              // End of points
+    int ncomp;              // Number of components for each point
+    capecBVHHits *h;        // Outputs
+} capecBVHTask;
+
+
+// ======================================================================
+// BUILD
+// ======================================================================
+
+// Partially sort tri indices so that entry *k* has its median center
+static void
+capec_BVHSelect(int *I, const double *cen, int axis, long lo, long hi,
+    long k)
+{
+    long i, j;
+    int tmp;
+    double v;
+    
+    // Hoare partitions of [lo, hi] until *k* is in place
+    while (lo < hi) {
+        v = cen[3*I[(lo + hi)/2] + axis];
+        i = lo;
+        j = hi;
+        while (i <= j) {
+            while (cen[3*I[i] + axis] < v) {i++; }
+            while (cen[3*I[j] + axis] > v) {j--; }
+            if (i <= j) {
+                tmp = I[i];
+                I[i] = I[j];
+                I[j] = tmp;
+                i++;
+                j--;
+            }
+        }
+        // Continue with the part that contains *k*
+        if (k <= j) {
+            hi = j;
+        } else if (k >= i) {
+            lo = i;
+        } else {
+            return;
+        }
+    }
+}
+
+// Compute box and components of tris [i0, i1) of tree
+static void
+capec_BVHFit(capecBVHNode *node, const double *X, const int *C,
+    size_t i0, size_t i1)
+{
+    int j;
+    size_t i;
+    const double *x;
+    
+    // Initialize
+    for (j=0; j<3; j++) {
+        node->lo[j] = HUGE_VAL;
+        node->hi[j] = -HUGE_VAL;
+    }
+    node->comp = C[i0];
+    node->mixed = 0;
+    // Loop through tris, then vertices
+    for (i=i0; i<i1; i++) {
+        x = X + 9*i;
+        for (j=0; j<9; j++) {
+            if (x[j] < node->lo[j % 3]) {node->lo[j % 3] = x[j]; }
+            if (x[j] > node->hi[j % 3]) {node->hi[j % 3] = x[j]; }
+        }
+        if (C[i] != node->comp) {node->mixed = 1; }
+    }
+}
+
+// Build tree
+int
+capec_BVHBuild(capecBVH *b, const double *P, size_t nNode, const int *T,
+    const int *C, size_t nTri)
+{
+    int j, axis;
+    int *I;
+    long m;
+    size_t i, k, n, i0, i1, nstack;
+    size_t stack[3*capeBVH_STACK];
+    double *cen;
+    double lo[3], hi[3];
+    const double *x;
+    capecBVHNode *node;
+    
+    // Initialize
+    memset(b, 0, sizeof(capecBVH));
+    // Check node indices
+    for (i=0; i<3*nTri; i++) {
+        if (T[i] < 1 || (size_t) T[i] > nNode) {
+            return capeBVH_ERR_INDEX;
+        }
+    }
+    // Nothing else to do for empty triangulation
+    if (nTri == 0) {
+        return capeBVH_OK;
+    }
+    // Allocate tree; a tree with leaves of at least one tri has < 2*nTri
+    b->nodes = (capecBVHNode *) malloc(2*nTri*sizeof(capecBVHNode));
+    b->X = (double *) malloc(9*nTri*sizeof(double));
+    b->C = (int *) malloc(nTri*sizeof(int));
+    b->K = (int *) malloc(nTri*sizeof(int));
+    cen = (double *) malloc(3*nTri*sizeof(double));
+    if (b->nodes == NULL || b->X == NULL || b->C == NULL || b->K == NULL ||
+            cen == NULL) {
+        free(cen);
+        capec_BVHFree(b);
+        return capeBVH_ERR_MEM;
+    }
+    b->ntri = nTri;
+    // Centers of tris
+    I = b->K;
+    for (i=0; i<nTri; i++) {
+        I[i] = (int) i;
+        for (j=0; j<3; j++) {
+            cen[3*i + j] = (P[3*(T[3*i] - 1) + j] + P[3*(T[3*i+1] - 1) + j] +
+                P[3*(T[3*i+2] - 1) + j]) / 3.0;
+        }
+    }
+    
+    // Split boxes, starting with the root
+    b->nnode = 1;
+    stack[0] = 0;
+    stack[1] = 0;
+    stack[2] = nTri;
+    nstack = 1;
+    while (nstack > 0) {
+        // Pop box and its range of tris
+        nstack--;
+        node = b->nodes + stack[3*nstack];
+        i0 = stack[3*nstack + 1];
+        i1 = stack[3*nstack + 2];
+        n = i1 - i0;
+        // Box of tri centers
+        for (j=0; j<3; j++) {
+            lo[j] = HUGE_VAL;
+            hi[j] = -HUGE_VAL;
+        }
+        for (i=i0; i<i1; i++) {
+            x = cen + 3*I[i];
+            for (j=0; j<3; j++) {
+                if (x[j] < lo[j]) {lo[j] = x[j]; }
+                if (x[j] > hi[j]) {hi[j] = x[j]; }
+            }
+        }
+        // Longest axis
+        axis = 0;
+        for (j=1; j<3; j++) {
+            if (hi[j] - lo[j] > hi[axis] - lo[axis]) {axis = j; }
+        }
+        // Check for leaf (or tris that can't be split)
+        if (n <= capeBVH_LEAF || !(hi[axis] > lo[axis]) ||
+                nstack + 2 > capeBVH_STACK) {
+            node->left = (int) i0;
+            node->count = (int) n;
+            continue;
+        }
+        // Split at median
+        m = (long) (i0 + n/2);
+        capec_BVHSelect(I, cen, axis, (long) i0, (long) i1 - 1, m);
+        // Create children
+        node->left = (int) b->nnode;
+        node->count = 0;
+        b->nnode += 2;
+        stack[3*nstack] = node->left;
+        stack[3*nstack + 1] = i0;
+        stack[3*nstack + 2] = (size_t) m;
+        nstack++;
+        stack[3*nstack] = node->left + 1;
+        stack[3*nstack + 1] = (size_t) m;
+        stack[3*nstack + 2] = i1;
+        nstack++;
+    }
+    free(cen);
+    
+    // Copy tris in tree order
+    for (i=0; i<nTri; i++) {
+        k = (size_t) I[i];
+        b->C[i] = C[k];
+        for (j=0; j<3; j++) {
+            memcpy(b->X + 9*i + 3*j, P + 3*(T[3*k + j] - 1),
+                3*sizeof(double));
+        }
+    }
+    // Fit boxes to tris
+    for (k=0; k<b->nnode; k++) {
+        node = b->nodes + k;
+        if (node->count > 0) {
+            capec_BVHFit(node, b->X, b->C, (size_t) node->left,
+                (size_t) (node->left + node->count));
+        }
+    }
+    // Children always come after parents, so fit branches in reverse
+    for (k=b->nnode; k-- > 0;) {
+        node = b->nodes + k;
+        if (node->count > 0) {
+            continue;
+        }
+        for (j=0; j<3; j++) {
+            node->lo[j] = fmin(b->nodes[node->left].lo[j],
+                b->nodes[node->left + 1].lo[j]);
+            node->hi[j] = fmax(b->nodes[node->left].hi[j],
+                b->nodes[node->left + 1].hi[j]);
+        }
+        node->comp = b->nodes[node->left].comp;
+        node->mixed = b->nodes[node->left].mixed ||
+            b->nodes[node->left + 1].mixed ||
+            b->nodes[node->left + 1].comp != node->comp;
+    }
+    return capeBVH_OK;
+}
+
+// Release tree
+void
+capec_BVHFree(capecBVH *b)
+{
+    free(b->nodes);
+    free(b->X);
+    free(b->C);
+    free(b->K);
+    memset(b, 0, sizeof(capecBVH));
+}
+
+
+// ======================================================================
+// QUERIES
+// ======================================================================
+
+// Squared distance from point to box
+static double
+capec_BVHBoxDist2(const capecBVHNode *node, const double *p)
+{
+    int j;
+    double d, s = 0.0;
+    
+    for (j=0; j<3; j++) {
+        if (p[j] < node->lo[j]) {
+            d = node->lo[j] - p[j];
+            s += d*d;
+        } else if (p[j] > node->hi[j]) {
+            d = p[j] - node->hi[j];
+            s += d*d;
+        }
+    }
+    return s;
+}
+
+// Closest point to *p* on segment from *a* to *b*
+static void
+capec_BVHSegment(const double *p, const double *a, const double *b,
+    double *q)
+{
+    int j;
+    double e[3], t, ee = 0.0, ep = 0.0;
+    
+    for (j=0; j<3; j++) {
+        e[j] = b[j] - a[j];
+        ee += e[j]*e[j];
+        ep += e[j]*(p[j] - a[j]);
+    }
+    t = (ee > 0) ? ep/ee : 0.0;
+    t = (t < 0) ? 0.0 : ((t > 1) ? 1.0 : t);
+    for (j=0; j<3; j++) {
+        q[j] = a[j] + t*e[j];
+    }
+}
+
+// Squared distance between two points
+static double
+capec_BVHDist2(const double *p, const double *q)
+{
+    return (p[0]-q[0])*(p[0]-q[0]) + (p[1]-q[1])*(p[1]-q[1]) +
+        (p[2]-q[2])*(p[2]-q[2]);
+}
+
+// Closest point to *p* on tri *x*; Ericson, Real-Time Collision Detection
+static double
+capec_BVHTriDist2(const double *p, const double *x, double *q)
+{
+    int j;
+    double ab[3], ac[3], ap[3], bp[3], cp[3];
+    double d1, d2, d3, d4, d5, d6, va, vb, vc, v, w, s;
+    double q1[3];
+    const double *a = x, *b = x + 3, *c = x + 6;
+    
+    for (j=0; j<3; j++) {
+        ab[j] = b[j] - a[j];
+        ac[j] = c[j] - a[j];
+        ap[j] = p[j] - a[j];
+        bp[j] = p[j] - b[j];
+        cp[j] = p[j] - c[j];
+    }
+    d1 = ab[0]*ap[0] + ab[1]*ap[1] + ab[2]*ap[2];
+    d2 = ac[0]*ap[0] + ac[1]*ap[1] + ac[2]*ap[2];
+    d3 = ab[0]*bp[0] + ab[1]*bp[1] + ab[2]*bp[2];
+    d4 = ac[0]*bp[0] + ac[1]*bp[1] + ac[2]*bp[2];
+    d5 = ab[0]*cp[0] + ab[1]*cp[1] + ab[2]*cp[2];
+    d6 = ac[0]*cp[0] + ac[1]*cp[1] + ac[2]*cp[2];
+    vc = d1*d4 - d3*d2;
+    vb = d5*d2 - d1*d6;
+    va = d3*d6 - d5*d4;
+    // Vertex and edge regions
+    if (d1 <= 0 && d2 <= 0) {
+        memcpy(q, a, 3*sizeof(double));
+    } else if (d3 >= 0 && d4 <= d3) {
+        memcpy(q, b, 3*sizeof(double));
+    } else if (d6 >= 0 && d5 <= d6) {
+        memcpy(q, c, 3*sizeof(double));
+    } else if (vc <= 0 && d1 >= 0 && d3 <= 0) {
+        v = d1 / (d1 - d3);
+        for (j=0; j<3; j++) {q[j] = a[j] + v*ab[j]; }
+    } else if (vb <= 0 && d2 >= 0 && d6 <= 0) {
+        w = d2 / (d2 - d6);
+        for (j=0; j<3; j++) {q[j] = a[j] + w*ac[j]; }
+    } else if (va <= 0 && d4 >= d3 && d5 >= d6) {
+        w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+        for (j=0; j<3; j++) {q[j] = b[j] + w*(c[j] - b[j]); }
+    } else if (va + vb + vc > 0) {
+        // Interior
+        s = 1.0 / (va + vb + vc);
+        v = vb * s;
+        w = vc * s;
+        for (j=0; j<3; j++) {q[j] = a[j] + v*ab[j] + w*ac[j]; }
+    } else {
+        // Degenerate tri; use nearest of the three edges
+        capec_BVHSegment(p, a, b, q);
+        capec_BVHSegment(p, b, c, q1);
+        if (capec_BVHDist2(p, q1) < capec_BVHDist2(p, q)) {
+            memcpy(q, q1, 3*sizeof(double));
+        }
+        capec_BVHSegment(p, c, a, q1);
+        if (capec_BVHDist2(p, q1) < capec_BVHDist2(p, q)) {
+            memcpy(q, q1, 3*sizeof(double));
+        }
+    }
+    return capec_BVHDist2(p, q);
+}
+
+// Check if component is in a list
+static int
+capec_BVHExcluded(int comp, const int *ex, int nex)
+{
+    int j;
+    
+    for (j=0; j<nex; j++) {
+        if (comp == ex[j]) {return 1; }
+    }
+    return 0;
+}
+
+// Find nearest tri not in excluded components; returns tree index or -1
+static long
+capec_BVHQuery(const capecBVH *b, const double *p, const int *ex, int nex,
+    double *dmin, double *qmin)
+{
+    int n, i;
+    int stack[capeBVH_STACK];
+    long kmin = -1;
+    double d, dl, dr;
+    double q[3];
+    const capecBVHNode *node, *l, *r;
+    
+    // Start at root
+    *dmin = HUGE_VAL;
+    n = 0;
+    if (b->nnode > 0) {
+        stack[n++] = 0;
+    }
+    while (n > 0) {
+        node = b->nodes + stack[--n];
+        // Skip boxes too far away or with only excluded tris
+        if (capec_BVHBoxDist2(node, p) > *dmin) {
+            continue;
+        }
+        if (!node->mixed && capec_BVHExcluded(node->comp, ex, nex)) {
+            continue;
+        }
+        // Check tris of leaves
+        if (node->count > 0) {
+            for (i=node->left; i<node->left + node->count; i++) {
+                if (capec_BVHExcluded(b->C[i], ex, nex)) {
+                    continue;
+                }
+                d = capec_BVHTriDist2(p, b->X + 9*i, q);
+                // Break ties using original tri index
+                if (d < *dmin ||
+                        (d == *dmin && kmin >= 0 && b->K[i] < b->K[kmin])) {
+                    *dmin = d;
+                    kmin = i;
+                    memcpy(qmin, q, 3*sizeof(double));
+                }
+            }
+            continue;
+        }
+        // Visit nearer child first
+        l = b->nodes + node->left;
+        r = l + 1;
+        dl = capec_BVHBoxDist2(l, p);
+        dr = capec_BVHBoxDist2(r, p);
+        if (dl <= dr) {
+            if (dr <= *dmin) {stack[n++] = node->left + 1; }
+            if (dl <= *dmin) {stack[n++] = node->left; }
+        } else {
+            if (dl <= *dmin) {stack[n++] = node->left; }
+            if (dr <= *dmin) {stack[n++] = node->left + 1; }
+        }
+    }
+    return kmin;
+}
+
+// Distances from point to plane of tri and within that plane
+static void
+capec_BVHSplitDist(const double *p, const double *x, const double *q,
+    double *z, double *t)
+{
+    int j;
+    double n[3], e1[3], e2[3], L, s;
+    double pq[3];
+    
+    // Normal of tri
+    for (j=0; j<3; j++) {
+        e1[j] = x[3 + j] - x[j];
+        e2[j] = x[6 + j] - x[j];
+    }
+    n[0] = e1[1]*e2[2] - e1[2]*e2[1];
+    n[1] = e1[2]*e2[0] - e1[0]*e2[2];
+    n[2] = e1[0]*e2[1] - e1[1]*e2[0];
+    L = sqrt(n[0]*n[0] + n[1]*n[1] + n[2]*n[2]);
+    L = (L > capeBVH_AMIN) ? L : capeBVH_AMIN;
+    // Projection distance to plane
+    s = ((p[0] - x[0])*n[0] + (p[1] - x[1])*n[1] + (p[2] - x[2])*n[2]) / L;
+    *z = fabs(s);
+    // Distance from projected point to nearest point
+    for (j=0; j<3; j++) {
+        pq[j] = p[j] - s*n[j]/L - q[j];
+    }
+    *t = sqrt(pq[0]*pq[0] + pq[1]*pq[1] + pq[2]*pq[2]);
+}
+
+// Search for each point of one task
+static void
+capec_BVHRun(void *task)
+{
+    int j;
+    int ex[capeBVH_NCOMP];
+    long k;
+    size_t i, m;
+    double d;
+    double q[3];
+    const double *p;
+    capecBVHTask *t = (capecBVHTask *) task;
+    const capecBVH *b = t->b;
+    capecBVHHits *h = t->h;
+    
+    // Loop through points
+    for (i=t->i0; i<t->i1; i++) {
+        p = t->X + 3*i;
+        for (j=0; j<t->ncomp; j++) {
+            m = i*(size_t) t->ncomp + (size_t) j;
+            // Nearest tri outside of components found so far
+            k = capec_BVHQuery(b, p, ex, j, &d, q);
+            if (k < 0) {
+                break;
+            }
+            ex[j] = b->C[k];
+            h->K[m] = b->K[k];
+            h->C[m] = b->C[k];
+            h->D[m] = sqrt(d);
+            capec_BVHSplitDist(p, b->X + 9*k, q, h->Z + m, h->T + m);
+        }
+        // No tris left in other components
+        for (; j<t->ncomp; j++) {
+            m = i*(size_t) t->ncomp + (size_t) j;
+            h->K[m] = -1;
+            h->C[m] = 0;
+            h->D[m] = NAN;
+            h->Z[m] = NAN;
+            h->T[m] = NAN;
+        }
+    }
+}
+
+// Find nearest tris to each point
+int
+capec_BVHNearest(const capecBVH *b, const double *X, size_t nPt, int ncomp,
+    capecBVHHits *h, int nthread)
+{
+    int k;
+    size_t nchunk;
+    capecBVHTask tasks[capeTHREAD_MAX];
+    
+    // Number of components
+    ncomp = (ncomp < 1) ? 1 : ncomp;
+    ncomp = (ncomp > capeBVH_NCOMP) ? capeBVH_NCOMP : ncomp;
+    // Number of threads
+    nchunk = nPt / capeBVH_CHUNKMIN;
+    if (nthread <= 0) {
+        nthread = capec_ThreadCount();
+    }
+    if ((size_t) nthread > nchunk) {
+        nthread = (int) nchunk;
+    }
+    nthread = (nthread > capeTHREAD_MAX) ? capeTHREAD_MAX : nthread;
+    nthread = (nthread < 1) ? 1 : nthread;
+    // Set up tasks
+    for (k=0; k<nthread; k++) {
+        tasks[k].b = b;
+        tasks[k].X = X;
+        tasks[k].i0 = (nPt * (size_t) k) / (size_t) nthread;
+        tasks[k].i1 = (nPt * (size_t) (k + 1)) / (size_t) nthread;
+        tasks[k].ncomp = ncomp;
+        tasks[k].h = h;
+    }
+    // Run them; outputs of tasks don't overlap
+    capec_ThreadRun(capec_BVHRun, tasks, sizeof(capecBVHTask), nthread);
+    return capeBVH_OK;
+}
@@ -1,11 +1,17 @@
 #include <Python.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <limits.h>
+#include <unistd.h>
 
 // Local includes
+#include "capec_Error.h"
+#include "capec_Memory.h"
 #include "capec_NumPy.h"
 #include "capec_PyTypes.h"
 #include "capec_BaseFile.h"
+#include "capec_Scan.h"
 
 // Read to end of line
 void
@@ -39,7 +45,7 @@ capcec_FileAdvanceWhiteSpace(FILE *fp)
     // Read white space (80 chars at a time)
     while (fscanf(fp, "%80[ \t\r]", buff) == 1)
     {
-        
+    
     }
 }
 
@@ -143,26 +149,55 @@ int capec_AddDTypes(PyObject *m)
     return PyModule_AddObject(m, "capeDTYPE_NAMES", dtypes);
 }
 
+// NumPy type number for data type code
+int
+capeFILE_TypeNum(int dtype)
+{
+    // Filter dtype
+    if (dtype == capeDTYPE_float64) {
+        return NPY_FLOAT64;
+    } else if (dtype == capeDTYPE_int32) {
+        return NPY_INT32;
+    } else if (dtype == capeDTYPE_float32) {
+        return NPY_FLOAT32;
+    } else if (dtype == capeDTYPE_float128) {
+        return NPY_FLOAT128;
+    } else if (dtype == capeDTYPE_int8) {
+        return NPY_INT8;
+    } else if (dtype == capeDTYPE_int16) {
+        return NPY_INT16;
+    } else if (dtype == capeDTYPE_int64) {
+        return NPY_INT64;
+    } else if (dtype == capeDTYPE_uint8) {
+        return NPY_UINT8;
+    } else if (dtype == capeDTYPE_uint16) {
+        return NPY_UINT16;
+    } else if (dtype == capeDTYPE_uint32) {
+        return NPY_UINT32;
+    } else if (dtype == capeDTYPE_uint64) {
+        return NPY_UINT64;
+    }
+    // No array type (strings, half-precision, or invalid)
+    return -1;
+}
+
 // New list or NumPy array by type
 PyObject *
 capeFILE_NewCol1D(int dtype, size_t n)
 {
     // Handle for array
     PyObject *V;
+    // Type of array
+    int typenum;
     // Dimensions handle
     npy_intp dims[1] = {(npy_intp) n};
     
-    
+    // Get NumPy type
+    typenum = capeFILE_TypeNum(dtype);
     // Filter dtype
     if (dtype < 0) {
         PyErr_SetString(PyExc_ValueError, "Negative DTYPE value");
         return NULL;
-    } else if (dtype == capeDTYPE_float64) {
-        // Create vector of doubles
-        V = PyArray_SimpleNew(1, dims, NPY_FLOAT64);
-    } else if (dtype == capeDTYPE_int32) {
-        // Create vector of ints (longs)
-        V = PyArray_SimpleNew(1, dims, NPY_INT32);
     } else if (dtype == capeDTYPE_str) {
         // Create a list
         V = PyList_New((Py_ssize_t) n);
@@ -171,33 +206,9 @@ capeFILE_NewCol1D(int dtype, size_t n)
         PyErr_Format(PyExc_NotImplementedError,
             "Reading DTYPE '%s' not implemented", capeDTYPE_NAMES[dtype]);
         return NULL;
-    } else if (dtype == capeDTYPE_float32) {
-        // Create vector of singles
-        V = PyArray_SimpleNew(1, dims, NPY_FLOAT32);
-    } else if (dtype == capeDTYPE_float128) {
-        // Create vector of long doubles
-        V = PyArray_SimpleNew(1, dims, NPY_FLOAT128);
-    } else if (dtype == capeDTYPE_int8) {
-        // Create vector of shorts
-        V = PyArray_SimpleNew(1, dims, NPY_INT8);
-    } else if (dtype == capeDTYPE_int16) {
-        // Create vector of ints (regular)
-        V = PyArray_SimpleNew(1, dims, NPY_INT16);
-    } else if (dtype == capeDTYPE_int64) {
-        // Create vector of long doubles
-        V = PyArray_SimpleNew(1, dims, NPY_INT64);
-    } else if (dtype == capeDTYPE_uint8) {
-        // Create vector of shorts
-        V = PyArray_SimpleNew(1, dims, NPY_UINT8);
-    } else if (dtype == capeDTYPE_uint16) {
-        // Create vector of shorts
-        V = PyArray_SimpleNew(1, dims, NPY_UINT16);
-    } else if (dtype == capeDTYPE_uint32) {
-        // Create vector of longs
-        V = PyArray_SimpleNew(1, dims, NPY_UINT32);
-    } else if (dtype == capeDTYPE_uint64) {
-        // Create vector of long longs
-        V = PyArray_SimpleNew(1, dims, NPY_UINT64);
+    } else if (typenum >= 0) {
+        // Create array
+        V = PyArray_SimpleNew(1, dims, typenum);
     } else {
         PyErr_Format(PyExc_ValueError, "Invalid DTYPE value '%i'", dtype);
         return NULL;
@@ -215,4 +226,637 @@ capeFILE_NewCol1D(int dtype, size_t n)
     return V;
 }
 
+
+// ======================================================================
+// SHARED READER SETUP
+// ======================================================================
+
+// Get C file handle at current position of Python file
+FILE *
+capeFILE_FromPyFile(PyObject *f, off_t *pos0)
+{
+    int fd;
+    long pos;
+    FILE *fp;
+    PyObject *t;
     
+    // Get file descriptor
+    #if PY_MAJOR_VERSION >= 3
+        fd = PyObject_AsFileDescriptor(f);
+    #else
+        fd = PyFile_Check(f) ? fileno(PyFile_AsFile(f)) : -1;
+    #endif
+    // Check success
+    if (fd == -1) {
+        PyErr_SetString(PyExc_TypeError, "Input is not a file handle");
+        return NULL;
+    }
+    // Save OS offset; Python's buffered reads may have moved it
+    *pos0 = lseek(fd, 0, SEEK_CUR);
+    // Get logical position
+    t = PyObject_CallMethod(f, "tell", NULL);
+    if (t == NULL) {
+        return NULL;
+    }
+    pos = PyLong_AsLong(t);
+    Py_DECREF(t);
+    if (pos < 0 && PyErr_Occurred()) {
+        return NULL;
+    }
+    // Use a copy of the descriptor so fclose() doesn't close *f*
+    fd = dup(fd);
+    if (fd == -1) {
+        PyErr_SetFromErrno(PyExc_IOError);
+        return NULL;
+    }
+    // Open it
+    fp = fdopen(fd, "r");
+    if (fp == NULL) {
+        close(fd);
+        PyErr_SetFromErrno(PyExc_IOError);
+        return NULL;
+    }
+    // Go to current position of Python file
+    if (fseek(fp, pos, SEEK_SET)) {
+        fclose(fp);
+        PyErr_SetFromErrno(PyExc_IOError);
+        return NULL;
+    }
+    // Output
+    return fp;
+}
+
+// Close C file handle and restore Python file state
+int
+capeFILE_ClosePyFile(PyObject *f, FILE *fp, off_t pos0, int atend)
+{
+    int fd;
+    int ierr = 0;
+    PyObject *t;
+    PyObject *etype, *evalue, *etb;
+    
+    // Close our copy
+    fclose(fp);
+    // Set aside any pending exception so *f* can be used
+    PyErr_Fetch(&etype, &evalue, &etb);
+    // Restore offset of shared descriptor
+    fd = PyObject_AsFileDescriptor(f);
+    if (fd == -1) {
+        ierr = capeERROR_TYPE;
+    } else if (pos0 >= 0 && lseek(fd, pos0, SEEK_SET) < 0) {
+        PyErr_SetFromErrno(PyExc_IOError);
+        ierr = 1;
+    } else if (atend) {
+        // Move Python file to end since data was consumed
+        t = PyObject_CallMethod(f, "seek", "ii", 0, 2);
+        if (t == NULL) {
+            ierr = 1;
+        } else {
+            Py_DECREF(t);
+        }
+    }
+    // Original exception takes precedence
+    if (etype != NULL) {
+        PyErr_Clear();
+        PyErr_Restore(etype, evalue, etb);
+    }
+    // Output
+    return ierr;
+}
+
+// Get data type codes from *db._c_dtypes*
+int
+capeFILE_GetDTypes(PyObject *db, Py_ssize_t *ncol, int **DTYPES)
+{
+    int ierr;
+    Py_ssize_t i;
+    PyObject *cols;
+    PyObject *col;
+    PyObject *dtypes;
+    PyObject *j;
+    
+    // Initialize
+    *ncol = 0;
+    *DTYPES = NULL;
+    // Check type of *db*: must be dict
+    if (!PyDict_Check(db)) {
+        PyErr_SetString(PyExc_TypeError,
+            "Data file object is not an instance of 'dict' class");
+        return capeERROR_TYPE;
+    }
+    
+    // Get columns
+    cols = PyObject_GetAttrString(db, "cols");
+    // Check *db.cols* for appropriate types
+    if (cols == NULL) {
+        PyErr_SetString(PyExc_AttributeError,
+            "Data file object has no 'cols' attribute");
+        return capeERROR_ATTR;
+    } else if (!PyList_Check(cols)) {
+        Py_DECREF(cols);
+        PyErr_SetString(PyExc_TypeError,
+            "Data file 'cols' attribute is not a list");
+        return capeERROR_ATTR_TYPE;
+    }
+    // Get number of columns
+    *ncol = PyList_GET_SIZE(cols);
+    // Check each column
+    for (i=0; i<*ncol; ++i) {
+        // Get column name
+        col = PyList_GET_ITEM(cols, i);
+        // Check type
+        if (!capePyString_Check(col)) {
+            Py_DECREF(cols);
+            PyErr_Format(PyExc_TypeError,
+                "Column %i is not a string", (int) i);
+            return capeERROR_TYPE;
+        }
+    }
+    Py_DECREF(cols);
+    
+    // Data types
+    dtypes = PyObject_GetAttrString(db, "_c_dtypes");
+    // Check *db._c_dtypes*
+    if (dtypes == NULL) {
+        PyErr_SetString(PyExc_AttributeError,
+            "Data file object has no '_c_dtypes' attribute; "
+            "call 'db.create_c_dtypes()' first.");
+        return capeERROR_ATTR;
+    } else if (!PyList_Check(dtypes) || PyList_GET_SIZE(dtypes) != *ncol) {
+        Py_DECREF(dtypes);
+        PyErr_Format(PyExc_ValueError,
+            "_c_dtypes must be a list with one entry for each of %i cols",
+            (int) *ncol);
+        return capeERROR_VALUE;
+    }
+    
+    // Allocate data types integer
+    ierr = capec_New1D((void **) DTYPES, (size_t) *ncol, sizeof(int));
+    if (ierr) {
+        Py_DECREF(dtypes);
+        PyErr_SetString(PyExc_MemoryError,
+            "Failed to allocate C DTYPES array");
+        return ierr;
+    }
+    // Loop through entries
+    for (i=0; i<*ncol; ++i) {
+        // Get type
+        j = PyList_GET_ITEM(dtypes, i);
+        // Check that it's an integer
+        if (!capePyInt_Check(j)) {
+            Py_DECREF(dtypes);
+            capec_Del1D(*DTYPES);
+            *DTYPES = NULL;
+            PyErr_Format(PyExc_TypeError,
+                "_c_dtypes[%i] is not an int", (int) i);
+            return capeERROR_TYPE;
+        }
+        // Save it
+        (*DTYPES)[i] = (int) capePyInt_AS_LONG(j);
+    }
+    Py_DECREF(dtypes);
+    // Normal output
+    return 0;
+}
+
+// Create each column of *db* and get pointers to their data
+int
+capeFILE_InitCols(PyObject *db, Py_ssize_t ncol, int *DTYPES, size_t nrow,
+    void **coldata)
+{
+    int ierr;
+    Py_ssize_t i;
+    PyObject *cols;
+    PyObject *col;
+    PyObject *V;
+    
+    // Get columns (already checked)
+    cols = PyObject_GetAttrString(db, "cols");
+    if (cols == NULL) {
+        return capeERROR_ATTR;
+    }
+    // Initialize each key
+    for (i=0; i<ncol; ++i) {
+        // Get column name
+        col = PyList_GET_ITEM(cols, i);
+        // Initialize the column
+        V = capeFILE_NewCol1D(DTYPES[i], nrow);
+        if (V == NULL) {
+            Py_DECREF(cols);
+            return capeERROR_MEM_ALLOC;
+        }
+        // Save it (replacing any existing column)
+        ierr = PyDict_SetItem(db, col, V);
+        Py_DECREF(V);
+        if (ierr) {
+            Py_DECREF(cols);
+            PyErr_Format(PyExc_KeyError, "Failed to set column '%s'",
+                capePyString_AsString(col));
+            return capeERROR_VALUE;
+        }
+        // Assign data to quick-access list
+        if (PyList_Check(V)) {
+            // Save pointer directly to Python list
+            coldata[i] = V;
+        } else {
+            // Save pointer to array's data
+            coldata[i] = PyArray_DATA((PyArrayObject *) V);
+        }
+    }
+    Py_DECREF(cols);
+    // Normal output
+    return 0;
+}
+
+
+// Change number of rows in each column of *db*
+int
+capeFILE_ResizeCols(PyObject *db, Py_ssize_t ncol, size_t nrow,
+    void **coldata)
+{
+    Py_ssize_t i, n0;
+    PyObject *cols;
+    PyObject *V;
+    PyObject *R;
+    npy_intp dims[1] = {(npy_intp) nrow};
+    PyArray_Dims shape = {dims, 1};
+    
+    // Get columns (already checked)
+    cols = PyObject_GetAttrString(db, "cols");
+    if (cols == NULL) {
+        return capeERROR_ATTR;
+    }
+    // Loop through columns
+    for (i=0; i<ncol; ++i) {
+        // Get column (borrowed reference)
+        V = PyDict_GetItem(db, PyList_GET_ITEM(cols, i));
+        if (V == NULL) {
+            Py_DECREF(cols);
+            PyErr_Format(PyExc_KeyError, "Failed to get column %i", (int) i);
+            return capeERROR_VALUE;
+        }
+        // Check type
+        if (PyList_Check(V)) {
+            // Current length
+            n0 = PyList_GET_SIZE(V);
+            // Add placeholders or remove trailing entries
+            while (n0 < (Py_ssize_t) nrow) {
+                if (PyList_Append(V, Py_None)) {
+                    Py_DECREF(cols);
+                    return capeERROR_MEM_ALLOC;
+                }
+                n0++;
+            }
+            if (n0 > (Py_ssize_t) nrow &&
+                    PyList_SetSlice(V, (Py_ssize_t) nrow, n0, NULL)) {
+                Py_DECREF(cols);
+                return capeERROR_MEM_ALLOC;
+            }
+        } else {
+            // Reallocate array data (no other references to it yet)
+            R = PyArray_Resize((PyArrayObject *) V, &shape, 0, NPY_CORDER);
+            if (R == NULL) {
+                Py_DECREF(cols);
+                return capeERROR_MEM_ALLOC;
+            }
+            Py_DECREF(R);
+            // Data may have moved
+            coldata[i] = PyArray_DATA((PyArrayObject *) V);
+        }
+    }
+    Py_DECREF(cols);
+    // Normal output
+    return 0;
+}
+
+
+// Check that a column can be extended by capeFILE_ExtendCols()
+static int
+capeFILE_CheckCol(PyObject *V, int dtype, size_t nrow0)
+{
+    int typenum;
+    
+    // String columns must be a list of current length
+    if (dtype == capeDTYPE_str) {
+        return (V != NULL && PyList_Check(V) &&
+            PyList_GET_SIZE(V) == (Py_ssize_t) nrow0);
+    }
+    // Others must be 1D contiguous array of right type and length
+    typenum = capeFILE_TypeNum(dtype);
+    return (V != NULL && typenum >= 0 && PyArray_Check(V) &&
+        PyArray_NDIM((PyArrayObject *) V) == 1 &&
+        PyArray_TYPE((PyArrayObject *) V) == typenum &&
+        PyArray_DIM((PyArrayObject *) V, 0) == (npy_intp) nrow0 &&
+        PyArray_IS_C_CONTIGUOUS((PyArrayObject *) V));
+}
+
+// Add rows to end of existing columns of *db*
+int
+capeFILE_ExtendCols(PyObject *db, Py_ssize_t ncol, int *DTYPES,
+    size_t nrow0, size_t nrow, void **coldata)
+{
+    int ierr = 0;
+    int typenum;
+    Py_ssize_t i;
+    size_t n;
+    npy_intp cap;
+    npy_intp dims[1];
+    PyObject *cols;
+    PyObject *col;
+    PyObject *V;
+    PyObject *B;
+    PyObject *W;
+    
+    // Get columns (already checked)
+    cols = PyObject_GetAttrString(db, "cols");
+    if (cols == NULL) {
+        return capeERROR_ATTR;
+    }
+    // Check all columns before modifying any (borrowed references)
+    for (i=0; i<ncol; ++i) {
+        V = PyDict_GetItem(db, PyList_GET_ITEM(cols, i));
+        if (!capeFILE_CheckCol(V, DTYPES[i], nrow0)) {
+            Py_DECREF(cols);
+            return -1;
+        }
+    }
+    // Loop through columns
+    for (i=0; i<ncol && !ierr; ++i) {
+        // Get column (borrowed reference)
+        col = PyList_GET_ITEM(cols, i);
+        V = PyDict_GetItem(db, col);
+        // Check type
+        if (DTYPES[i] == capeDTYPE_str) {
+            // Add placeholders
+            for (n=nrow0; n<nrow && !ierr; n++) {
+                if (PyList_Append(V, Py_None)) {
+                    ierr = capeERROR_MEM_ALLOC;
+                }
+            }
+            coldata[i] = V;
+            continue;
+        }
+        typenum = capeFILE_TypeNum(DTYPES[i]);
+        // Check for spare capacity from a previous extension
+        B = PyArray_BASE((PyArrayObject *) V);
+        if (B != NULL && PyArray_Check(B) &&
+                PyArray_NDIM((PyArrayObject *) B) == 1 &&
+                PyArray_TYPE((PyArrayObject *) B) == typenum &&
+                PyArray_IS_C_CONTIGUOUS((PyArrayObject *) B) &&
+                PyArray_DATA((PyArrayObject *) B) ==
+                    PyArray_DATA((PyArrayObject *) V) &&
+                PyArray_DIM((PyArrayObject *) B, 0) >= (npy_intp) nrow) {
+            // Reuse it
+            Py_INCREF(B);
+        } else {
+            // Grow geometrically
+            cap = 2 * (npy_intp) nrow0;
+            if (cap < (npy_intp) nrow) cap = (npy_intp) nrow;
+            if (cap < capeFILE_NROW0) cap = capeFILE_NROW0;
+            dims[0] = cap;
+            B = PyArray_SimpleNew(1, dims, typenum);
+            if (B == NULL) {
+                ierr = capeERROR_MEM_ALLOC;
+                break;
+            }
+            // Copy existing rows
+            memcpy(PyArray_DATA((PyArrayObject *) B),
+                PyArray_DATA((PyArrayObject *) V),
+                nrow0 * PyArray_ITEMSIZE((PyArrayObject *) V));
+        }
+        // Create view of first *nrow* rows
+        dims[0] = (npy_intp) nrow;
+        W = PyArray_SimpleNewFromData(1, dims, typenum,
+            PyArray_DATA((PyArrayObject *) B));
+        if (W == NULL) {
+            Py_DECREF(B);
+            ierr = capeERROR_MEM_ALLOC;
+            break;
+        }
+        // View keeps buffer alive (steals reference)
+        if (PyArray_SetBaseObject((PyArrayObject *) W, B)) {
+            Py_DECREF(W);
+            ierr = capeERROR_MEM_ALLOC;
+            break;
+        }
+        // Replace column
+        coldata[i] = PyArray_DATA((PyArrayObject *) W);
+        if (PyDict_SetItem(db, col, W)) {
+            ierr = capeERROR_VALUE;
+        }
+        Py_DECREF(W);
+    }
+    Py_DECREF(cols);
+    // Output
+    return ierr;
+}
+
+// Read data portion of file in one pass
+int
+capeFILE_ReadData(PyObject *db, PyObject *f, capeFILE_LineReader readline)
+{
+    // Error flag
+    int ierr;
+    // Number of rows
+    size_t irow;
+    size_t nrow;
+    // Column attributes
+    Py_ssize_t ncol;
+    int *DTYPES;
+    // Local pointer to all data
+    void **coldata = NULL;
+    // File handles
+    FILE *fp;
+    off_t pos0;
+    capecScanBuf b;
+    char *line;
+    
+   // --- Setup ---
+    // Get columns and data types
+    ierr = capeFILE_GetDTypes(db, &ncol, &DTYPES);
+    if (ierr) {
+        return ierr;
+    }
+    // Get C file handle
+    fp = capeFILE_FromPyFile(f, &pos0);
+    if (fp == NULL) {
+        capec_Del1D(DTYPES);
+        return capeERROR_TYPE;
+    }
+    // Initialize buffer
+    if (capec_ScanBufInit(&b, fp)) {
+        capeFILE_ClosePyFile(f, fp, pos0, 0);
+        capec_Del1D(DTYPES);
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate read buffer");
+        return capeERROR_MEM_ALLOC;
+    }
+    
+   // --- Initialization ---
+    // Initial size of each column
+    nrow = capeFILE_NROW0;
+    // Allocate column data
+    ierr = capec_New1D((void **) &coldata, (size_t) ncol, sizeof(void *));
+    if (ierr) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate column list");
+    } else {
+        // Create each column
+        ierr = capeFILE_InitCols(db, ncol, DTYPES, nrow, coldata);
+    }
+    
+   // --- Read ---
+    // Initialize number of rows actually read
+    irow = 0;
+    // Loop through lines
+    while (!ierr && (line = capec_ScanBufLine(&b)) != NULL) {
+        // Grow columns if full
+        if (irow == nrow) {
+            nrow *= 2;
+            ierr = capeFILE_ResizeCols(db, ncol, nrow, coldata);
+            if (ierr) {
+                break;
+            }
+        }
+        // Split line and save fields
+        ierr = readline(line, coldata, DTYPES, (size_t) ncol, irow);
+        // Check for blank line
+        if (ierr == -1) {
+            ierr = 0;
+        } else if (!ierr) {
+            // Increase row counter
+            irow += 1;
+        }
+    }
+    // Check for read errors
+    if (!ierr && b.ierr) {
+        PyErr_SetString(PyExc_IOError, "Failed to read data from file");
+        ierr = 1;
+    }
+    // Trim columns to final size
+    if (!ierr) {
+        ierr = capeFILE_ResizeCols(db, ncol, irow, coldata);
+    }
+    
+   // --- Cleanup ---
+    // Release buffer
+    capec_ScanBufClose(&b);
+    // Close our copy of the file; *f* is left at the end if successful
+    if (capeFILE_ClosePyFile(f, fp, pos0, !ierr) && !ierr) {
+        ierr = 1;
+    }
+    // Release memory
+    capec_Del1D(coldata);
+    capec_Del1D(DTYPES);
+    // Output
+    return ierr;
+}
+
+
+// ======================================================================
+// TEXT CONVERSION
+// ======================================================================
+
+// Convert one text field according to data type
+int
+capeFILE_FromText(const char *s, void *coldata, int dtype, size_t irow)
+{
+    char *e;
+    int ierr = 0;
+    long long vl = 0;
+    unsigned long long vu = 0;
+    long long vmin = 0;
+    long long vmax = 0;
+    unsigned long long umax = 0;
+    PyObject *v;
+    
+    // Check dtype for what to read
+    if (dtype == capeDTYPE_float64) {
+        ierr = capec_ScanF64(s, &e, (double *) coldata + irow);
+    } else if (dtype == capeDTYPE_str) {
+        // Convert to Python string
+        v = capePyString_FromString(s);
+        if (v == NULL) {
+            return capeERROR_VALUE;
+        }
+        // Save it (steals reference)
+        if (PyList_SetItem((PyObject *) coldata, (Py_ssize_t) irow, v)) {
+            return capeERROR_VALUE;
+        }
+        return 0;
+    } else if (dtype == capeDTYPE_float32) {
+        ierr = capec_ScanF32(s, &e, (float *) coldata + irow);
+    } else if (dtype == capeDTYPE_float128) {
+        ((long double *) coldata)[irow] = strtold(s, &e);
+    } else if (dtype >= capeDTYPE_int8 && dtype <= capeDTYPE_int64) {
+        // Signed integer
+        ierr = capec_ScanI64(s, &e, &vl);
+        // Range for each size
+        if (dtype == capeDTYPE_int8) {
+            vmin = SCHAR_MIN; vmax = SCHAR_MAX;
+        } else if (dtype == capeDTYPE_int16) {
+            vmin = SHRT_MIN; vmax = SHRT_MAX;
+        } else if (dtype == capeDTYPE_int32) {
+            vmin = INT_MIN; vmax = INT_MAX;
+        } else {
+            vmin = LONG_MIN; vmax = LONG_MAX;
+        }
+        if (ierr == 0 && (vl < vmin || vl > vmax)) {
+            ierr = 2;
+        }
+    } else if (dtype >= capeDTYPE_uint8 && dtype <= capeDTYPE_uint64) {
+        // Unsigned integer
+        ierr = capec_ScanU64(s, &e, &vu);
+        // Range for each size
+        if (dtype == capeDTYPE_uint8) {
+            umax = UCHAR_MAX;
+        } else if (dtype == capeDTYPE_uint16) {
+            umax = USHRT_MAX;
+        } else if (dtype == capeDTYPE_uint32) {
+            umax = UINT_MAX;
+        } else {
+            umax = ULONG_MAX;
+        }
+        if (ierr == 0 && vu > umax) {
+            ierr = 2;
+        }
+    } else {
+        PyErr_Format(PyExc_NotImplementedError,
+            "Reading DTYPE '%s' not implemented", capeDTYPE_NAMES[dtype]);
+        return capeERROR_NOT_IMPLEMENTED;
+    }
+    
+    // Check that whole field was used
+    if (ierr == 1 || e == s || *e != '\0') {
+        PyErr_Format(PyExc_ValueError,
+            "Failed to read %s from '%s' in data row %li",
+            capeDTYPE_NAMES[dtype], s, (long) irow);
+        return capeERROR_VALUE;
+    }
+    // Check range of integers (underflow of floats is ok)
+    if (ierr == 2) {
+        PyErr_Format(PyExc_ValueError,
+            "Value '%s' out of range for %s in data row %li",
+            s, capeDTYPE_NAMES[dtype], (long) irow);
+        return capeERROR_VALUE;
+    }
+    
+    // Save integers
+    if (dtype == capeDTYPE_int8) {
+        ((signed char *) coldata)[irow] = (signed char) vl;
+    } else if (dtype == capeDTYPE_int16) {
+        ((short *) coldata)[irow] = (short) vl;
+    } else if (dtype == capeDTYPE_int32) {
+        ((int *) coldata)[irow] = (int) vl;
+    } else if (dtype == capeDTYPE_int64) {
+        ((long *) coldata)[irow] = (long) vl;
+    } else if (dtype == capeDTYPE_uint8) {
+        ((unsigned char *) coldata)[irow] = (unsigned char) vu;
+    } else if (dtype == capeDTYPE_uint16) {
+        ((unsigned short *) coldata)[irow] = (unsigned short) vu;
+    } else if (dtype == capeDTYPE_uint32) {
+        ((unsigned *) coldata)[irow] = (unsigned) vu;
+    } else if (dtype == capeDTYPE_uint64) {
+        ((unsigned long *) coldata)[irow] = (unsigned long) vu;
+    }
+    // Nominal exit
+    return 0;
+}
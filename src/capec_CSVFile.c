@@ -1,360 +1,779 @@
 #include <Python.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <math.h>
+#include <limits.h>
 
 // Local includes
 #include "capec_Error.h"
 #include "capec_PyTypes.h"
+#include "capec_Memory.h"
+#include "capec_NumPy.h"
 #include "capec_BaseFile.h"
+#include "capec_Map.h"
+#include "capec_Scan.h"
+#include "capec_Thread.h"
 #include "capec_CSVFile.h"
 
+// Number of string spans kept on the stack for serial reads
+#define capeCSV_NSPAN 64
+
+// Check for end of line within mapped text
+#define capeCSV_IsEOL(c) ((c) == '\0' || (c) == '\n')
+
+
+// Names of data types used in error messages
+static const char *capeCSV_DTYPE_DESC[capeDTYPE_Last] = {
+    "float16",
+    "float32",
+    "float64",
+    "float128",
+    "int8",
+    "int16",
+    "int",
+    "long int",
+    "int8",
+    "int16",
+    "unsigned int",
+    "long unsigned",
+    "string"
+};
+
 
 // Count data lines in open file
 size_t capec_CSVFileCountLines(FILE *fp)
 {
-    // Line counts
-    size_t nline = 0;
-    // File position
-    long pos;
-    // Strings
-    char c;
-    
-    // Remember current location
-    pos = ftell(fp);
-    
-    // Read lines
-    while (!feof(fp)) {
-        // Read spaces
-        capcec_FileAdvanceWhiteSpace(fp);
-        // Get next character
-        c = getc(fp);
-        // Check it
-        if (c == '\n') {
-            // Empty line
-            continue;
-        } else if (feof(fp)) {
-            // Last line
-            break;
-        }
-        // Read to end of line (comment or not)
-        capec_FileAdvanceEOL(fp);
-        // Check if it was a comment
-        if (c != '#') {
-            // Increase line count
-            nline += 1;
-        }
-    }
-    
-    // Return to original location
-    fseek(fp, pos, SEEK_SET);
-    
-    // Output
-    return nline;
+    // Same rules as any other text file
+    return capec_ScanCountLines(fp);
 }
 
 
-// Read next entry as a string
-int capeCSV_ReadSTR(FILE *fp, PyObject *coldata, size_t irow)
+// ======================================================================
+// ENTRIES
+// ======================================================================
+
+// Read next entry as a signed integer in a given range
+static int capeCSV_ScanInt(char **s, long long *v, long long vmin,
+    long long vmax)
 {
-    int ierr;
-    int nscan;
-    char buff[80];
-    PyObject *v;
-    
-    // Attempt to read next entry as a string
-    nscan = fscanf(fp, "%80[^,\n\r\t]", buff);
-    // Check for empty string (otherwise we'll get "  " in Python)
-    if (nscan == 0) {
-        buff[0] = '\0';
-    }
-    // Convert to Python string
-    v = capePyString_FromString((const char *) buff);
-    // Check for errors
-    if (v == NULL) {
-        PyErr_Format(PyExc_ValueError,
-            "Failed to read string in data row %li", (long) irow);
+    // Attempt to read next entry as an integer
+    if (capec_ScanI64(*s, s, v) || *v < vmin || *v > vmax) {
         return capeERROR_VALUE;
     }
-    
-    // Save it
-    ierr = PyList_SetItem(coldata, (Py_ssize_t) irow, v);
-    // Pass along error indicator
-    return ierr;
-    
+    // Nominal exit
+    return 0;
 }
 
-
-// Read next entry as a double
-int capeCSV_ReadFLOAT32(FILE *fp, float *coldata, size_t irow)
+// Read next entry as an unsigned integer in a given range
+static int capeCSV_ScanUInt(char **s, unsigned long long *v,
+    unsigned long long vmax)
 {
-    int nscan;
-    float v;
-    
-    // Attempt to read next entry as a double
-    nscan = fscanf(fp, "%f", &v);
-    // Error checks
-    if (nscan != 1) {
-        PyErr_Format(PyExc_ValueError,
-            "Failed to read float32 in data row %li", (long) irow);
+    // Attempt to read next entry as an integer
+    if (capec_ScanU64(*s, s, v) || *v > vmax) {
         return capeERROR_VALUE;
     }
-    
-    // Save it
-    coldata[irow] = v;
     // Nominal exit
     return 0;
 }
 
-// Read next entry as a double
-int capeCSV_ReadFLOAT64(FILE *fp, double *coldata, size_t irow)
+// Read next numeric entry without using Python API
+int capeCSV_ScanNext(char **s, void *coldata, int dtype, size_t irow)
 {
-    int nscan;
-    double v;
+    // Error flag
+    int ierr = 0;
+    // Values
+    long long vl;
+    unsigned long long vu;
+    char *p;
     
-    // Attempt to read next entry as a double
-    nscan = fscanf(fp, "%lf", &v);
-    // Error checks
-    if (nscan != 1) {
-        PyErr_Format(PyExc_ValueError,
-            "Failed to read float64 in data row %li", (long) irow);
-        return capeERROR_VALUE;
+    // Check dtype for what to read next
+    if (dtype == capeDTYPE_float64) {
+        if (capec_ScanF64(*s, s, (double *) coldata + irow))
+            ierr = capeERROR_VALUE;
+    } else if (dtype == capeDTYPE_int32) {
+        ierr = capeCSV_ScanInt(s, &vl, INT_MIN, INT_MAX);
+        ((int *) coldata)[irow] = (int) vl;
+    } else if (dtype == capeDTYPE_float32) {
+        if (capec_ScanF32(*s, s, (float *) coldata + irow))
+            ierr = capeERROR_VALUE;
+    } else if (dtype == capeDTYPE_float128) {
+        ((long double *) coldata)[irow] = strtold(*s, &p);
+        if (p == *s)
+            ierr = capeERROR_VALUE;
+        *s = p;
+    } else if (dtype == capeDTYPE_int8) {
+        ierr = capeCSV_ScanInt(s, &vl, SCHAR_MIN, SCHAR_MAX);
+        ((signed char *) coldata)[irow] = (signed char) vl;
+    } else if (dtype == capeDTYPE_int16) {
+        ierr = capeCSV_ScanInt(s, &vl, SHRT_MIN, SHRT_MAX);
+        ((short *) coldata)[irow] = (short) vl;
+    } else if (dtype == capeDTYPE_int64) {
+        ierr = capeCSV_ScanInt(s, &vl, LONG_MIN, LONG_MAX);
+        ((long *) coldata)[irow] = (long) vl;
+    } else if (dtype == capeDTYPE_uint8) {
+        ierr = capeCSV_ScanUInt(s, &vu, UCHAR_MAX);
+        ((unsigned char *) coldata)[irow] = (unsigned char) vu;
+    } else if (dtype == capeDTYPE_uint16) {
+        ierr = capeCSV_ScanUInt(s, &vu, USHRT_MAX);
+        ((short unsigned *) coldata)[irow] = (short unsigned) vu;
+    } else if (dtype == capeDTYPE_uint32) {
+        ierr = capeCSV_ScanUInt(s, &vu, UINT_MAX);
+        ((unsigned *) coldata)[irow] = (unsigned) vu;
+    } else if (dtype == capeDTYPE_uint64) {
+        ierr = capeCSV_ScanUInt(s, &vu, ULONG_MAX);
+        ((long unsigned *) coldata)[irow] = (long unsigned) vu;
+    } else {
+        // Strings and half-precision floats need Python
+        return capeERROR_NOT_IMPLEMENTED;
     }
     
-    // Save it
-    coldata[irow] = v;
-    // Nominal exit
-    return 0;
+    // Pass along error indicator
+    return ierr;
 }
 
-// Read next entry as a long double
-int capeCSV_ReadFLOAT128(FILE *fp, long double *coldata, size_t irow)
+// Find extent of next string entry
+static void capeCSV_ScanSTR(char **s, capecCSVSpan *span)
 {
-    int nscan;
-    long double v;
+    char *p;
     
-    // Attempt to read next entry as a double
-    nscan = fscanf(fp, "%Lf", &v);
-    // Error checks
-    if (nscan != 1) {
-        PyErr_Format(PyExc_ValueError,
-            "Failed to read float128 in data row %li", (long) irow);
-        return capeERROR_VALUE;
+    // Find end of entry
+    p = *s;
+    while (*p != ',' && *p != '\r' && *p != '\t' && !capeCSV_IsEOL(*p)) {
+        p++;
     }
-    
-    // Save it
-    coldata[irow] = v;
-    // Nominal exit
-    return 0;
+    // Save location
+    span->s = *s;
+    span->n = (size_t) (p - *s);
+    // Advance
+    *s = p;
 }
 
-
-// Read next entry as an int8
-int capeCSV_ReadINT8(FILE *fp, signed char *coldata, size_t irow)
+// Save a string entry to a list column
+static int capeCSV_SaveSTR(const capecCSVSpan *span, PyObject *coldata,
+    size_t irow)
 {
-    int nscan;
-    signed char v;
+    PyObject *v;
     
-    // Attempt to read next entry as a double
-    nscan = fscanf(fp, "%hhi", &v);
-    // Error checks
-    if (nscan != 1) {
+    // Convert to Python string
+    v = capePyString_FromStringAndSize(span->s, (Py_ssize_t) span->n);
+    // Check for errors
+    if (v == NULL) {
         PyErr_Format(PyExc_ValueError,
-            "Failed to read int8 in data row %li", (long) irow);
+            "Failed to read string in data row %li", (long) irow);
         return capeERROR_VALUE;
     }
-    
-    // Save it
-    coldata[irow] = v;
-    // Nominal exit
+    // Save it (steals reference)
+    if (PyList_SetItem(coldata, (Py_ssize_t) irow, v)) {
+        return capeERROR_VALUE;
+    }
+    // Normal output
     return 0;
 }
 
-// Read next entry as an int16
-int capeCSV_ReadINT16(FILE *fp, short *coldata, size_t irow)
+// Set Python exception from parse error description
+void capeCSV_SetError(const capecCSVErr *err)
 {
-    int nscan;
-    short v;
-    
-    // Attempt to read next entry as a double
-    nscan = fscanf(fp, "%hi", &v);
-    // Error checks
-    if (nscan != 1) {
+    // Check error type
+    if (err->kind == capeCSV_ERR_READ) {
         PyErr_Format(PyExc_ValueError,
-            "Failed to read int16 in data row %li", (long) irow);
-        return capeERROR_VALUE;
+            "Failed to read %s in data row %li",
+            capeCSV_DTYPE_DESC[err->dtype], (long) err->irow);
+    } else if (err->kind == capeCSV_ERR_PAST) {
+        PyErr_Format(PyExc_ValueError,
+            "Data row %li extends past %i columns",
+            (long) err->irow, err->jcol);
+    } else if (err->kind == capeCSV_ERR_SEP) {
+        PyErr_Format(PyExc_ValueError,
+            "After col %i on data row %li: expected ',', not '%c'",
+            err->jcol + 1, (long) err->irow, err->c);
+    } else {
+        PyErr_Format(PyExc_NotImplementedError,
+            "Reading DTYPE '%s' not implemented",
+            capeDTYPE_NAMES[err->dtype]);
     }
+}
+
+// Read next data column
+int capeCSV_ReadNext(char **s, void *coldata, int dtype, size_t irow)
+{
+    // Error flag
+    int ierr;
+    // String location
+    capecCSVSpan span;
+    // Error description
+    capecCSVErr err;
     
-    // Save it
-    coldata[irow] = v;
-    // Nominal exit
-    return 0;
+    // Check for string
+    if (dtype == capeDTYPE_str) {
+        capeCSV_ScanSTR(s, &span);
+        return capeCSV_SaveSTR(&span, (PyObject *) coldata, irow);
+    }
+    // Numeric types
+    ierr = capeCSV_ScanNext(s, coldata, dtype, irow);
+    // Check for errors
+    if (ierr) {
+        err.kind = (ierr == capeERROR_VALUE) ?
+            capeCSV_ERR_READ : capeCSV_ERR_TYPE;
+        err.dtype = dtype;
+        err.irow = irow;
+        capeCSV_SetError(&err);
+    }
+    // Pass long error indicator
+    return ierr;
 }
 
-// Read next entry as an int32
-int capeCSV_ReadINT32(FILE *fp, int *coldata, size_t irow)
+
+// ======================================================================
+// LINES
+// ======================================================================
+
+// Parse one line of CSV file without using Python API
+int capeCSV_ScanLine(char *line, void **coldata, int *DTYPES, size_t ncol,
+    size_t irow, capecCSVSpan *spans, capecCSVErr *err)
 {
-    int nscan;
-    int v;
+    // Error flag
+    int ierr;
+    // Column index
+    size_t jcol;
+    // String column index
+    size_t kstr = 0;
+    // Position in line
+    char *p;
+    char c;
     
-    // Attempt to read next entry as a double
-    nscan = fscanf(fp, "%i", &v);
-    // Error checks
-    if (nscan != 1) {
-        PyErr_Format(PyExc_ValueError,
-            "Failed to read int in data row %li", (long) irow);
-        return capeERROR_VALUE;
+    // Skip leading white space
+    p = line;
+    while (capeSCAN_IsSpace(*p)) p++;
+    // Check for empty or comment line
+    if (capeCSV_IsEOL(*p) || *p == '#') {
+        return -1;
     }
     
-    // Save it
-    coldata[irow] = v;
-    // Nominal exit
+    // Loop through columns
+    for (jcol=0; jcol<ncol; jcol++)
+    {
+        // Read next entry
+        if (DTYPES[jcol] == capeDTYPE_str) {
+            // Just find it for now
+            capeCSV_ScanSTR(&p, spans + kstr);
+            kstr++;
+        } else {
+            // Convert number
+            ierr = capeCSV_ScanNext(&p, coldata[jcol], DTYPES[jcol], irow);
+            if (ierr) {
+                err->kind = (ierr == capeERROR_VALUE) ?
+                    capeCSV_ERR_READ : capeCSV_ERR_TYPE;
+                err->dtype = DTYPES[jcol];
+                err->irow = irow;
+                return ierr;
+            }
+        }
+        // Read next white space
+        while (capeSCAN_IsSpace(*p)) p++;
+        // Next character (end of line shows as newline in messages)
+        c = capeCSV_IsEOL(*p) ? '\n' : *p;
+        // Check if we're in the last column
+        if (jcol + 1 == ncol) {
+            // Character should be newline or start of comment
+            if (c != '\n' && c != '#') {
+                // Line should be over
+                err->kind = capeCSV_ERR_PAST;
+                err->irow = irow;
+                err->jcol = (int) jcol;
+                return capeERROR_VALUE;
+            }
+        } else {
+            // Filter character
+            if (c != ',') {
+                // Early EOL
+                err->kind = capeCSV_ERR_SEP;
+                err->irow = irow;
+                err->jcol = (int) jcol;
+                err->c = c;
+                return capeERROR_VALUE;
+            }
+            // Advance past comma and white space again
+            p++;
+            while (capeSCAN_IsSpace(*p)) p++;
+        }
+    }
+    
+    // Normal output
     return 0;
 }
 
-// Read next entry as an int64
-int capeCSV_ReadINT64(FILE *fp, long *coldata, size_t irow)
+// Read one line of CSV file
+int capeCSV_ReadLine(char *line, void **coldata, int *DTYPES, size_t ncol,
+    size_t irow)
 {
-    int nscan;
-    long v;
+    // Error flag
+    int ierr;
+    // Column indices
+    size_t jcol, kstr;
+    // Locations of strings
+    capecCSVSpan spanbuf[capeCSV_NSPAN];
+    capecCSVSpan *spans = spanbuf;
+    // Error description
+    capecCSVErr err;
     
-    // Attempt to read next entry as a double
-    nscan = fscanf(fp, "%li", &v);
-    // Error checks
-    if (nscan != 1) {
-        PyErr_Format(PyExc_ValueError,
-            "Failed to read long int in data row %li", (long) irow);
-        return capeERROR_VALUE;
+    // Count string columns
+    for (jcol=0, kstr=0; jcol<ncol; jcol++) {
+        if (DTYPES[jcol] == capeDTYPE_str) kstr++;
+    }
+    // Use heap if many string columns
+    if (kstr > capeCSV_NSPAN) {
+        spans = (capecCSVSpan *) malloc(kstr * sizeof(capecCSVSpan));
+        if (spans == NULL) {
+            PyErr_NoMemory();
+            return capeERROR_MEM_ALLOC;
+        }
     }
     
-    // Save it
-    coldata[irow] = v;
-    // Nominal exit
-    return 0;
+    // Parse the line
+    ierr = capeCSV_ScanLine(line, coldata, DTYPES, ncol, irow, spans, &err);
+    // Check for errors
+    if (ierr > 0) {
+        capeCSV_SetError(&err);
+    } else if (ierr == 0) {
+        // Save strings
+        for (jcol=0, kstr=0; jcol<ncol && !ierr; jcol++) {
+            if (DTYPES[jcol] != capeDTYPE_str) continue;
+            ierr = capeCSV_SaveSTR(spans + kstr, coldata[jcol], irow);
+            kstr++;
+        }
+    }
+    
+    // Release span list
+    if (spans != spanbuf) {
+        free(spans);
+    }
+    // Output
+    return ierr;
 }
 
 
-// Read next entry as an int8
-int capeCSV_ReadUINT8(FILE *fp, unsigned char *coldata, size_t irow)
+// ======================================================================
+// PARALLEL READER
+// ======================================================================
+
+// Work description for one chunk of file
+typedef struct {
+    char *a;                //!< Start of chunk
+    char *b;                //!< End of chunk
+    size_t nrow;            //!< Number of data rows in chunk
+    size_t irow0;           //!< Index of first row of chunk
+    size_t nread;           //!< Number of data rows actually parsed
+    void **coldata;         //!< Data pointer for each column
+    int *DTYPES;            //!< Data type of each column
+    size_t ncol;            //!< Number of columns
+    size_t nstr;            //!< Number of string columns
+    capecCSVSpan *spans;    //!< String locations for all rows
+    char *last;             //!< Copy of last line if not newline-terminated
+    int ierr;               //!< Error flag
+    capecCSVErr err;        //!< Error description
+} capecCSVTask;
+
+
+// Count data rows in a chunk
+static void
+capeCSV_CountTask(void *arg)
 {
-    int nscan;
-    unsigned char v;
+    capecCSVTask *t = (capecCSVTask *) arg;
+    int state = 0;
     
-    // Attempt to read next entry as a double
-    nscan = fscanf(fp, "%hhu", &v);
-    // Error checks
-    if (nscan != 1) {
-        PyErr_Format(PyExc_ValueError,
-            "Failed to read int8 in data row %li", (long) irow);
-        return capeERROR_VALUE;
+    // Count lines ended by newline
+    t->nrow = capec_ScanCountBuf(t->a, (size_t) (t->b - t->a), &state);
+    // Final line without newline
+    if (state == 1) {
+        t->nrow += 1;
     }
-    
-    // Save it
-    coldata[irow] = v;
-    // Nominal exit
-    return 0;
 }
 
-// Read next entry as a uint16
-int capeCSV_ReadUINT16(FILE *fp, short unsigned *coldata, size_t irow)
+// Parse data rows of a chunk
+static void
+capeCSV_ParseTask(void *arg)
 {
-    int nscan;
-    short unsigned v;
+    capecCSVTask *t = (capecCSVTask *) arg;
+    int ierr;
+    size_t irow, n;
+    capecCSVSpan *spans;
+    char *p, *q;
     
-    // Attempt to read next entry as a double
-    nscan = fscanf(fp, "%hu", &v);
-    // Error checks
-    if (nscan != 1) {
-        PyErr_Format(PyExc_ValueError,
-            "Failed to read int16 in data row %li", (long) irow);
-        return capeERROR_VALUE;
+    // Start of chunk
+    p = t->a;
+    irow = t->irow0;
+    // Loop through lines
+    while (p < t->b) {
+        // Find end of line
+        q = (char *) memchr(p, '\n', (size_t) (t->b - p));
+        // Copy last line of file if not terminated
+        if (q == NULL) {
+            n = (size_t) (t->b - p);
+            t->last = (char *) malloc(n + 1);
+            if (t->last == NULL) {
+                t->ierr = capeERROR_MEM_ALLOC;
+                return;
+            }
+            memcpy(t->last, p, n);
+            t->last[n] = '\0';
+            p = t->last;
+            q = t->last + n;
+        }
+        // Locations for this row's strings
+        spans = t->spans + (irow * t->nstr);
+        // Parse
+        ierr = capeCSV_ScanLine(p, t->coldata, t->DTYPES, t->ncol, irow,
+            spans, &t->err);
+        // Check for errors
+        if (ierr > 0) {
+            t->ierr = ierr;
+            return;
+        } else if (ierr == 0) {
+            irow += 1;
+            // Don't overrun row count from first pass
+            if (irow - t->irow0 > t->nrow) {
+                t->nread = irow - t->irow0;
+                t->ierr = capeERROR_VALUE;
+                return;
+            }
+        }
+        // Move to next line
+        if (t->last != NULL) {
+            break;
+        }
+        p = q + 1;
     }
-    
-    // Save it
-    coldata[irow] = v;
-    // Nominal exit
-    return 0;
+    // Save count
+    t->nread = irow - t->irow0;
 }
 
-// Read next entry as a uint32
-int capeCSV_ReadUINT32(FILE *fp, unsigned *coldata, size_t irow)
+// Read data portion of CSV file using multiple threads
+int capeCSV_ReadDataThreads(PyObject *db, PyObject *f, int nthread)
 {
-    int nscan;
-    unsigned v;
+    // Error flag
+    int ierr = 0;
+    // Iterators
+    int i;
+    size_t irow, jcol, kstr;
+    // Number of rows and columns
+    size_t nrow;
+    Py_ssize_t ncol;
+    size_t nstr;
+    int *DTYPES;
+    // Local pointer to all data
+    void **coldata = NULL;
+    // String locations
+    capecCSVSpan *spans = NULL;
+    // Per-call temporaries
+    capecArena arena = capeARENA_INIT;
+    // Tasks
+    capecCSVTask tasks[capeTHREAD_MAX];
+    size_t nchunk;
+    // File handles
+    FILE *fp;
+    off_t pos0;
+    long pos;
+    capecMap m;
+    // Bounds of data section
+    char *a, *b, *p;
     
-    // Attempt to read next entry as a double
-    nscan = fscanf(fp, "%u", &v);
-    // Error checks
-    if (nscan != 1) {
-        PyErr_Format(PyExc_ValueError,
-            "Failed to read unsigned int in data row %li", (long) irow);
-        return capeERROR_VALUE;
+   // --- File ---
+    // Get C file handle
+    fp = capeFILE_FromPyFile(f, &pos0);
+    if (fp == NULL) {
+        return capeERROR_TYPE;
+    }
+    // Logical position of start of data
+    pos = ftell(fp);
+    // Map whole file
+    if (pos < 0 || capec_MapOpenFD(&m, fileno(fp))) {
+        capeFILE_ClosePyFile(f, fp, pos0, 0);
+        return 1;
+    }
+    // Size of data section
+    nchunk = (pos < (long) m.size) ? (m.size - (size_t) pos) : 0;
+    nchunk /= capeCSV_CHUNKMIN;
+    // Pick number of threads
+    if (nthread <= 0) {
+        nthread = capec_ThreadCount();
+    }
+    if ((size_t) nthread > nchunk) {
+        nthread = (int) nchunk;
+    }
+    if (nthread > capeTHREAD_MAX) {
+        nthread = capeTHREAD_MAX;
+    }
+    // Use serial reader for small files
+    if (nthread <= 1) {
+        capec_MapClose(&m);
+        if (capeFILE_ClosePyFile(f, fp, pos0, 0)) {
+            return 1;
+        }
+        return capeFILE_ReadData(db, f, capeCSV_ReadLine);
     }
     
-    // Save it
-    coldata[irow] = v;
-    // Nominal exit
-    return 0;
+   // --- Columns ---
+    // Get columns and data types
+    ierr = capeFILE_GetDTypes(db, &ncol, &DTYPES);
+    if (ierr) {
+        capec_MapClose(&m);
+        capeFILE_ClosePyFile(f, fp, pos0, 0);
+        return ierr;
+    }
+    // Count string columns
+    for (jcol=0, nstr=0; jcol<(size_t) ncol; jcol++) {
+        if (DTYPES[jcol] == capeDTYPE_str) nstr++;
+    }
+    
+   // --- Chunks ---
+    // Bounds of data
+    a = m.data + pos;
+    b = m.data + m.size;
+    // Split into ranges ending just after a newline
+    for (i=0; i<nthread; i++) {
+        // Nominal end of chunk
+        if (i + 1 == nthread) {
+            p = b;
+        } else {
+            p = a + (size_t) (b - a) / (size_t) (nthread - i);
+            p = (char *) memchr(p, '\n', (size_t) (b - p));
+            p = (p == NULL) ? b : p + 1;
+        }
+        // Initialize task
+        memset(tasks + i, 0, sizeof(capecCSVTask));
+        tasks[i].a = a;
+        tasks[i].b = p;
+        tasks[i].ncol = (size_t) ncol;
+        tasks[i].nstr = nstr;
+        tasks[i].DTYPES = DTYPES;
+        // Next chunk
+        a = p;
+    }
+    
+    // Count rows of each chunk in parallel
+    Py_BEGIN_ALLOW_THREADS
+    capec_ThreadRun(capeCSV_CountTask, tasks, sizeof(capecCSVTask), nthread);
+    Py_END_ALLOW_THREADS
+    // Index of first row of each chunk
+    for (i=0, nrow=0; i<nthread; i++) {
+        tasks[i].irow0 = nrow;
+        nrow += tasks[i].nrow;
+    }
+    
+   // --- Initialization ---
+    // Allocate column data
+    coldata = (void **) capec_ArenaNew(&arena, (size_t) ncol, sizeof(void *));
+    if (coldata == NULL) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate column list");
+        ierr = capeERROR_MEM_ALLOC;
+    } else {
+        // Create each column
+        ierr = capeFILE_InitCols(db, ncol, DTYPES, nrow, coldata);
+    }
+    // Allocate string locations
+    if (!ierr && nstr > 0) {
+        spans = (capecCSVSpan *) capec_ArenaNew(&arena, nrow * nstr,
+            sizeof(capecCSVSpan));
+        if (spans == NULL) {
+            PyErr_NoMemory();
+            ierr = capeERROR_MEM_ALLOC;
+        }
+    }
+    
+   // --- Read ---
+    if (!ierr) {
+        // Finish tasks
+        for (i=0; i<nthread; i++) {
+            tasks[i].coldata = coldata;
+            tasks[i].spans = spans;
+        }
+        // Parse chunks in parallel
+        Py_BEGIN_ALLOW_THREADS
+        capec_ThreadRun(capeCSV_ParseTask, tasks, sizeof(capecCSVTask),
+            nthread);
+        Py_END_ALLOW_THREADS
+        // Find first error
+        for (i=0; i<nthread && !ierr; i++) {
+            if (tasks[i].ierr == capeERROR_MEM_ALLOC) {
+                PyErr_NoMemory();
+                ierr = capeERROR_MEM_ALLOC;
+            } else if (tasks[i].ierr && tasks[i].nread <= tasks[i].nrow) {
+                // Parse error
+                capeCSV_SetError(&tasks[i].err);
+                ierr = tasks[i].ierr;
+            } else if (tasks[i].ierr || tasks[i].nread != tasks[i].nrow) {
+                // Mismatch between passes
+                PyErr_Format(PyExc_ValueError,
+                    "Inconsistent number of data rows after row %li",
+                    (long) tasks[i].irow0);
+                ierr = capeERROR_VALUE;
+            }
+        }
+    }
+    
+    // Create strings (needs Python, so serial)
+    if (!ierr && nstr > 0) {
+        for (jcol=0, kstr=0; jcol<(size_t) ncol && !ierr; jcol++) {
+            // Skip numeric columns
+            if (DTYPES[jcol] != capeDTYPE_str) continue;
+            // Loop through rows
+            for (irow=0; irow<nrow && !ierr; irow++) {
+                ierr = capeCSV_SaveSTR(spans + (irow*nstr + kstr),
+                    (PyObject *) coldata[jcol], irow);
+            }
+            kstr++;
+        }
+    }
+    
+   // --- Cleanup ---
+    // Release copies of last lines
+    for (i=0; i<nthread; i++) {
+        free(tasks[i].last);
+    }
+    capec_ArenaDel(&arena);
+    capec_Del1D(DTYPES);
+    capec_MapClose(&m);
+    // Close our copy of the file; *f* is left at the end if successful
+    if (capeFILE_ClosePyFile(f, fp, pos0, !ierr) && !ierr) {
+        ierr = 1;
+    }
+    // Output
+    return ierr;
 }
 
-// Read next entry as a uint64
-int capeCSV_ReadUINT64(FILE *fp, long unsigned *coldata, size_t irow)
+
+// ======================================================================
+// INCREMENTAL READER
+// ======================================================================
+
+// Hash of the bytes just before a position in a file's text
+uint64_t capeCSV_TailHash(const char *data, size_t offset)
 {
-    int nscan;
-    long v;
+    size_t i, i0;
+    uint64_t h = 14695981039346656037ULL;
     
-    // Attempt to read next entry as a double
-    nscan = fscanf(fp, "%lu", &v);
-    // Error checks
-    if (nscan != 1) {
-        PyErr_Format(PyExc_ValueError,
-            "Failed to read long unsigned in data row %li", (long) irow);
-        return capeERROR_VALUE;
+    // Start of region
+    i0 = (offset > capeCSV_TAILSIZE) ? offset - capeCSV_TAILSIZE : 0;
+    // FNV-1a
+    for (i=i0; i<offset; i++) {
+        h ^= (uint64_t) (unsigned char) data[i];
+        h *= 1099511628211ULL;
     }
-    
-    // Save it
-    coldata[irow] = v;
-    // Nominal exit
-    return 0;
+    return h;
 }
 
+// Create incremental read state for a file that was just read
+int capeCSV_TailState(const char *fname, capecCSVTail *st)
+{
+    int ierr = 0;
+    capecMap m;
+    
+    // Map file
+    if (capec_MapOpen(&m, fname)) {
+        return 1;
+    }
+    // Saved position must be just after a complete line
+    if (st->offset == 0 || st->offset > m.size ||
+            m.data[st->offset - 1] != '\n') {
+        ierr = -1;
+    } else {
+        st->hash = capeCSV_TailHash(m.data, st->offset);
+    }
+    capec_MapClose(&m);
+    return ierr;
+}
 
-// Read next data column
-int capeCSV_ReadNext(FILE *fp, void *coldata, int dtype, size_t irow)
+// Read rows appended to CSV file since a previous read
+int capeCSV_ReadTail(PyObject *db, const char *fname, capecCSVTail *st)
 {
     // Error flag
-    int ierr;
+    int ierr = 0;
+    // Line count state
+    int state = 0;
+    // Number of rows and columns
+    size_t irow, nrow;
+    Py_ssize_t ncol;
+    int *DTYPES;
+    // Local pointer to all data
+    void **coldata = NULL;
+    // Mapped file
+    capecMap m;
+    // Bounds of new text
+    char *a, *b, *p;
     
-    // Check dtype for what to read next
-    if (dtype == capeDTYPE_float64) {
-        ierr = capeCSV_ReadFLOAT64(fp, (double *) coldata, irow);
-    } else if (dtype == capeDTYPE_int32) {
-        ierr = capeCSV_ReadINT32(fp, (int *) coldata, irow);
-    } else if (dtype == capeDTYPE_str) {
-        ierr = capeCSV_ReadSTR(fp, (PyObject *) coldata, irow);
-    } else if (dtype == capeDTYPE_float32) {
-        ierr = capeCSV_ReadFLOAT32(fp, (float *) coldata, irow);
-    } else if (dtype == capeDTYPE_float128) {
-        ierr = capeCSV_ReadFLOAT128(fp, (long double *) coldata, irow);
-    } else if (dtype == capeDTYPE_int8) {
-        ierr = capeCSV_ReadINT8(fp, (signed char *) coldata, irow);
-    } else if (dtype == capeDTYPE_int16) {
-        ierr = capeCSV_ReadINT16(fp, (short *) coldata, irow);
-    } else if (dtype == capeDTYPE_int64) {
-        ierr = capeCSV_ReadINT64(fp, (long *) coldata, irow);
-    } else if (dtype == capeDTYPE_uint8) {
-        ierr = capeCSV_ReadUINT8(fp, (unsigned char *) coldata, irow);
-    } else if (dtype == capeDTYPE_uint16) {
-        ierr = capeCSV_ReadUINT16(fp, (short unsigned *) coldata, irow);
-    } else if (dtype == capeDTYPE_uint32) {
-        ierr = capeCSV_ReadUINT32(fp, (unsigned *) coldata, irow);
-    } else if (dtype == capeDTYPE_uint64) {
-        ierr = capeCSV_ReadUINT64(fp, (long unsigned *) coldata, irow);
+    // Map file
+    if (capec_MapOpen(&m, fname)) {
+        return 1;
+    }
+    // Check that previously read text is unchanged
+    if (st->offset == 0 || st->offset > m.size ||
+            m.data[st->offset - 1] != '\n' ||
+            capeCSV_TailHash(m.data, st->offset) != st->hash) {
+        capec_MapClose(&m);
+        return -1;
+    }
+    // New text, through last newline
+    a = m.data + st->offset;
+    b = m.data + m.size;
+    while (b > a && b[-1] != '\n') {
+        b--;
+    }
+    // Check for no new lines
+    if (b == a) {
+        capec_MapClose(&m);
+        return 0;
+    }
+    // Count new rows
+    nrow = capec_ScanCountBuf(a, (size_t) (b - a), &state);
+    
+    // Get columns and data types
+    ierr = capeFILE_GetDTypes(db, &ncol, &DTYPES);
+    if (ierr) {
+        capec_MapClose(&m);
+        return ierr;
+    }
+    // Allocate column data
+    ierr = capec_New1D((void **) &coldata, (size_t) ncol, sizeof(void *));
+    if (ierr) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to allocate column list");
     } else {
-        PyErr_Format(PyExc_NotImplementedError,
-            "Reading DTYPE '%s' not implemented", capeDTYPE_NAMES[dtype]);
-        return capeERROR_NOT_IMPLEMENTED;
+        // Add room for new rows
+        ierr = capeFILE_ExtendCols(db, ncol, DTYPES,
+            st->nrow, st->nrow + nrow, coldata);
     }
     
-    // Pass long error indicator
+    // Parse each new line
+    irow = st->nrow;
+    for (p=a; p<b && !ierr; p++) {
+        // Parse line
+        ierr = capeCSV_ReadLine(p, coldata, DTYPES, (size_t) ncol, irow);
+        // Count data rows; -1 is a blank or comment line
+        if (ierr == 0) {
+            irow++;
+        } else if (ierr < 0) {
+            ierr = 0;
+        }
+        // Move to end of line
+        p = (char *) memchr(p, '\n', (size_t) (b - p));
+    }
+    // Check for consistent count
+    if (!ierr && irow != st->nrow + nrow) {
+        PyErr_Format(PyExc_ValueError,
+            "Inconsistent number of data rows after row %li", (long) irow);
+        ierr = capeERROR_VALUE;
+    }
+    // Save new state
+    if (!ierr) {
+        st->offset = (size_t) (b - m.data);
+        st->nrow = irow;
+        st->hash = capeCSV_TailHash(m.data, st->offset);
+    }
+    
+    // Cleanup
+    capec_Del1D(coldata);
+    capec_Del1D(DTYPES);
+    capec_MapClose(&m);
+    // Output
     return ierr;
 }
@@ -0,0 +1,254 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+// Local includes
+#include "capec_ColCache.h"
+#include "capec_Stats.h"
+
+
+// ======================================================================
+// SOURCE SIGNATURE
+// ======================================================================
+
+// Add bytes to FNV-1a hash
+static uint64_t
+capec_ColCacheHash(uint64_t h, const unsigned char *buf, size_t n)
+{
+    size_t i;
+    
+    for (i=0; i<n; i++) {
+        h ^= (uint64_t) buf[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// Read up to *n* bytes at *offset* and add them to hash
+static int
+capec_ColCacheHashRegion(int fd, off_t offset, size_t n, unsigned char *buf,
+    uint64_t *h)
+{
+    ssize_t m;
+    
+    m = pread(fd, buf, n, offset);
+    if (m < 0 || (size_t) m != n)
+        return 1;
+    *h = capec_ColCacheHash(*h, buf, n);
+    return 0;
+}
+
+// Get size, time, and hash of source file
+int
+capec_ColCacheSource(const char *fname, capecColCacheSrc *src)
+{
+    int fd, ierr;
+    size_t n, size;
+    struct stat st;
+    unsigned char *buf;
+    
+    // Open file
+    fd = open(fname, O_RDONLY);
+    if (fd < 0)
+        return capeCOLCACHE_ERR_IO;
+    if (fstat(fd, &st)) {
+        close(fd);
+        return capeCOLCACHE_ERR_IO;
+    }
+    size = (size_t) st.st_size;
+    src->size = (uint64_t) size;
+#if defined(__APPLE__)
+    src->mtime = (int64_t) st.st_mtimespec.tv_sec * 1000000000LL +
+        st.st_mtimespec.tv_nsec;
+#else
+    src->mtime = (int64_t) st.st_mtim.tv_sec * 1000000000LL +
+        st.st_mtim.tv_nsec;
+#endif
+    // Hash first and last bytes, which catches most rewrites that keep
+    // the size and time without reading the whole file
+    src->hash = 14695981039346656037ULL;
+    n = (size < capeCOLCACHE_HASHSIZE) ? size : capeCOLCACHE_HASHSIZE;
+    buf = (unsigned char *) malloc(n + 1);
+    if (buf == NULL) {
+        close(fd);
+        return capeCOLCACHE_ERR_MEM;
+    }
+    ierr = capec_ColCacheHashRegion(fd, 0, n, buf, &src->hash);
+    if (!ierr && size > n) {
+        ierr = capec_ColCacheHashRegion(fd, (off_t) (size - n), n, buf,
+            &src->hash);
+    }
+    free(buf);
+    close(fd);
+    return ierr ? capeCOLCACHE_ERR_IO : capeCOLCACHE_OK;
+}
+
+
+// ======================================================================
+// CHECK
+// ======================================================================
+
+// Check that region is within a file of *size* bytes
+static int
+capec_ColCacheInFile(uint64_t offset, uint64_t n, size_t size)
+{
+    return offset <= (uint64_t) size && n <= (uint64_t) size - offset;
+}
+
+// Check header and column table
+int
+capec_ColCacheCheck(const char *data, size_t size,
+    const capecColCacheSrc *src)
+{
+    size_t j;
+    capecColCacheHead h;
+    capecColCacheCol c;
+    
+    // Header
+    if (size < sizeof(capecColCacheHead))
+        return capeCOLCACHE_BAD;
+    memcpy(&h, data, sizeof(capecColCacheHead));
+    if (memcmp(h.magic, capeCOLCACHE_MAGIC, 8) ||
+            h.version != capeCOLCACHE_VERSION || h.bom != capeCOLCACHE_BOM)
+        return capeCOLCACHE_BAD;
+    // Source file
+    if (h.src.size != src->size || h.src.mtime != src->mtime ||
+            h.src.hash != src->hash)
+        return capeCOLCACHE_STALE;
+    // Column table
+    if (h.ncol > (size - sizeof(capecColCacheHead)) / sizeof(c))
+        return capeCOLCACHE_BAD;
+    for (j=0; j<h.ncol; j++) {
+        memcpy(&c, data + sizeof(h) + j*sizeof(c), sizeof(c));
+        if (c.dtype < 0 ||
+                !capec_ColCacheInFile(c.name, c.nname, size) ||
+                !capec_ColCacheInFile(c.data, c.ndata, size) ||
+                !capec_ColCacheInFile(c.blob, c.nblob, size) ||
+                c.data % capeCOLCACHE_ALIGN)
+            return capeCOLCACHE_BAD;
+    }
+    return capeCOLCACHE_OK;
+}
+
+
+// ======================================================================
+// WRITE
+// ======================================================================
+
+// Round up to alignment of blocks
+static uint64_t
+capec_ColCacheAlign(uint64_t offset)
+{
+    return (offset + capeCOLCACHE_ALIGN - 1) / capeCOLCACHE_ALIGN *
+        capeCOLCACHE_ALIGN;
+}
+
+// Write *n* bytes, padding with zeros to *offset*
+static int
+capec_ColCachePut(FILE *fp, const void *buf, size_t n, uint64_t *pos,
+    uint64_t offset)
+{
+    static const char zeros[capeCOLCACHE_ALIGN] = {0};
+    
+    // Padding
+    if (offset < *pos || offset - *pos > capeCOLCACHE_ALIGN)
+        return 1;
+    if (fwrite(zeros, 1, (size_t) (offset - *pos), fp) !=
+            (size_t) (offset - *pos))
+        return 1;
+    // Contents
+    if (n > 0 && fwrite(buf, 1, n, fp) != n)
+        return 1;
+    *pos = offset + n;
+    return 0;
+}
+
+// Write cache file
+int
+capec_ColCacheWrite(const char *fname, const capecColCacheSrc *src,
+    size_t nrow, const capecColCacheItem *cols, size_t ncol)
+{
+    int ierr;
+    size_t j, ntmp;
+    uint64_t pos, offset;
+    char *ftmp;
+    FILE *fp;
+    capecColCacheHead h;
+    capecColCacheCol *C;
+    
+    // Header
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, capeCOLCACHE_MAGIC, 8);
+    h.version = capeCOLCACHE_VERSION;
+    h.bom = capeCOLCACHE_BOM;
+    h.src = *src;
+    h.nrow = (uint64_t) nrow;
+    h.ncol = (uint64_t) ncol;
+    // Column table: names first, then one aligned block for each column
+    C = (capecColCacheCol *) calloc(ncol + 1, sizeof(capecColCacheCol));
+    if (C == NULL)
+        return capeCOLCACHE_ERR_MEM;
+    offset = sizeof(h) + ncol*sizeof(capecColCacheCol);
+    for (j=0; j<ncol; j++) {
+        C[j].dtype = (int32_t) cols[j].dtype;
+        C[j].nname = (uint32_t) cols[j].nname;
+        C[j].name = offset;
+        offset += cols[j].nname;
+    }
+    for (j=0; j<ncol; j++) {
+        C[j].data = capec_ColCacheAlign(offset);
+        C[j].ndata = cols[j].ndata;
+        offset = C[j].data + C[j].ndata;
+        if (cols[j].blob != NULL) {
+            C[j].blob = capec_ColCacheAlign(offset);
+            C[j].nblob = cols[j].nblob;
+            offset = C[j].blob + C[j].nblob;
+        }
+    }
+    
+    // Temporary file in same folder
+    ntmp = strlen(fname) + 32;
+    ftmp = (char *) malloc(ntmp);
+    if (ftmp == NULL) {
+        free(C);
+        return capeCOLCACHE_ERR_MEM;
+    }
+    snprintf(ftmp, ntmp, "%s.%ld.tmp", fname, (long) getpid());
+    fp = fopen(ftmp, "wb");
+    if (fp == NULL) {
+        free(ftmp);
+        free(C);
+        return capeCOLCACHE_ERR_IO;
+    }
+    // Write header, table, and names
+    pos = 0;
+    ierr = capec_ColCachePut(fp, &h, sizeof(h), &pos, 0);
+    ierr = ierr || capec_ColCachePut(fp, C, ncol*sizeof(capecColCacheCol),
+        &pos, pos);
+    for (j=0; j<ncol && !ierr; j++)
+        ierr = capec_ColCachePut(fp, cols[j].name, cols[j].nname, &pos, pos);
+    // Write blocks
+    for (j=0; j<ncol && !ierr; j++) {
+        ierr = capec_ColCachePut(fp, cols[j].data, cols[j].ndata, &pos,
+            C[j].data);
+        if (!ierr && cols[j].blob != NULL) {
+            ierr = capec_ColCachePut(fp, cols[j].blob, cols[j].nblob, &pos,
+                C[j].blob);
+        }
+    }
+    free(C);
+    // Close and move into place
+    ierr = fclose(fp) || ierr;
+    if (!ierr)
+        ierr = rename(ftmp, fname);
+    if (!ierr)
+        capec_StatAddBytes(capec_StatCurrent(), (size_t) pos);
+    if (ierr)
+        unlink(ftmp);
+    free(ftmp);
+    return ierr ? capeCOLCACHE_ERR_IO : capeCOLCACHE_OK;
+}
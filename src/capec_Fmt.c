@@ -0,0 +1,401 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Local includes
+#include "capec_Memory.h"
+#include "capec_Fmt.h"
+
+
+// Exact powers of ten representable as doubles
+static const double capeFMT_P10[23] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+    1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+    1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// Powers of ten as integers
+static const unsigned long long capeFMT_U10[20] = {
+    1ULL,
+    10ULL,
+    100ULL,
+    1000ULL,
+    10000ULL,
+    100000ULL,
+    1000000ULL,
+    10000000ULL,
+    100000000ULL,
+    1000000000ULL,
+    10000000000ULL,
+    100000000000ULL,
+    1000000000000ULL,
+    10000000000000ULL,
+    100000000000000ULL,
+    1000000000000000ULL,
+    10000000000000000ULL,
+    100000000000000000ULL,
+    1000000000000000000ULL,
+    10000000000000000000ULL
+};
+
+// Pairs of digits for integer conversion
+static const char capeFMT_DIGITS2[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+
+// ======================================================================
+// BUFFER
+// ======================================================================
+
+// Initialize buffer
+int
+capec_FmtBufInit(capecFmtBuf *b, FILE *fid)
+{
+    // Save file handle
+    b->fid = fid;
+    b->n = 0;
+    b->ierr = 0;
+    // Allocate buffer
+    b->buf = (char *) capec_PoolNew(capeFMT_BUFSIZE);
+    // Check for errors
+    if (b->buf == NULL) {
+        b->size = 0;
+        b->ierr = 1;
+        return 1;
+    }
+    // Save size
+    b->size = capeFMT_BUFSIZE;
+    // Normal output
+    return 0;
+}
+
+// Write buffer to file
+int
+capec_FmtBufFlush(capecFmtBuf *b)
+{
+    size_t n;
+    
+    // Check for empty buffer
+    if (b->n == 0)
+        return b->ierr;
+    // Write entire buffer at once
+    n = fwrite(b->buf, 1, b->n, b->fid);
+    // Check for errors
+    if (n != b->n)
+        b->ierr = 1;
+    // Reset
+    b->n = 0;
+    // Output
+    return b->ierr;
+}
+
+// Flush and free buffer
+int
+capec_FmtBufClose(capecFmtBuf *b)
+{
+    int ierr;
+    
+    // Write anything left over
+    ierr = capec_FmtBufFlush(b);
+    // Return buffer to pool
+    capec_PoolDel(b->buf);
+    b->buf = NULL;
+    b->size = 0;
+    // Output
+    return ierr;
+}
+
+// Ensure space for *n* more bytes
+char *
+capec_FmtBufReserve(capecFmtBuf *b, size_t n)
+{
+    // Check if current buffer has room
+    if (b->n + n > b->size) {
+        // Write current contents
+        if (capec_FmtBufFlush(b))
+            return NULL;
+        // Check for extremely long request
+        if (n > b->size)
+            return NULL;
+    }
+    // Pointer to first free byte
+    return b->buf + b->n;
+}
+
+
+// ======================================================================
+// INTEGERS
+// ======================================================================
+
+// Write digits of unsigned integer; return number of chars
+static size_t
+capec_FmtU(char *s, unsigned long long u)
+{
+    char tmp[24];
+    char *p = tmp + sizeof(tmp);
+    size_t n;
+    unsigned r;
+    
+    // Two digits at a time
+    while (u >= 100) {
+        r = (unsigned) (u % 100);
+        u /= 100;
+        p -= 2;
+        memcpy(p, capeFMT_DIGITS2 + 2*r, 2);
+    }
+    // Last one or two digits
+    if (u >= 10) {
+        p -= 2;
+        memcpy(p, capeFMT_DIGITS2 + 2*u, 2);
+    } else {
+        *(--p) = (char) ('0' + u);
+    }
+    // Copy to output
+    n = (size_t) (tmp + sizeof(tmp) - p);
+    memcpy(s, p, n);
+    return n;
+}
+
+// Write digits of integer padded with zeros to width *w*
+static void
+capec_FmtUZ(char *s, unsigned long long u, int w)
+{
+    int i;
+    unsigned r;
+    
+    // Fill from the right
+    i = w;
+    while (i >= 2) {
+        r = (unsigned) (u % 100);
+        u /= 100;
+        i -= 2;
+        memcpy(s + i, capeFMT_DIGITS2 + 2*r, 2);
+    }
+    if (i == 1) {
+        s[0] = (char) ('0' + u % 10);
+    }
+}
+
+// Write integer in "%i" format
+size_t
+capec_FmtI(char *s, long v)
+{
+    // Check sign
+    if (v < 0) {
+        s[0] = '-';
+        return 1 + capec_FmtU(s + 1, 0ULL - (unsigned long long) v);
+    }
+    // Nonnegative
+    return capec_FmtU(s, (unsigned long long) v);
+}
+
+// Write integer in "%<w>i" format
+size_t
+capec_FmtIW(char *s, long v, int width)
+{
+    char tmp[24];
+    size_t n, w;
+    
+    // Convert
+    n = capec_FmtI(tmp, v);
+    w = (size_t) width;
+    // Check for padding
+    if (n >= w) {
+        memcpy(s, tmp, n);
+        return n;
+    }
+    // Pad with spaces on the left
+    memset(s, ' ', w - n);
+    memcpy(s + (w - n), tmp, n);
+    return w;
+}
+
+
+// ======================================================================
+// FLOATS
+// ======================================================================
+
+// Multiply by 10^k using as few roundings as possible
+static double
+capec_FmtScale10(double x, int k)
+{
+    // Large positive powers
+    while (k > 22) {
+        x *= 1e22;
+        k -= 22;
+    }
+    // Large negative powers
+    while (k < -22) {
+        x /= 1e22;
+        k += 22;
+    }
+    // Final scaling
+    if (k >= 0) {
+        return x * capeFMT_P10[k];
+    } else {
+        return x / capeFMT_P10[-k];
+    }
+}
+
+// Write double using "%.<prec>E" format
+size_t
+capec_FmtE(char *s, double x, int prec, int plus)
+{
+    double ax, m, f, tol;
+    unsigned long long r, umin, umax;
+    int e, k, n;
+    char *p;
+    
+    // Absolute value
+    ax = fabs(x);
+    // Cases that go to printf():  inf, nan, tiny, huge, long precision
+    if (!isfinite(x) || prec < 0 || prec > 9 ||
+            (ax != 0.0 && (ax < 1e-290 || ax > 1e290))) {
+        if (plus) {
+            return (size_t) snprintf(s, capeFMT_MAXNUM, "%+.*E", prec, x);
+        } else {
+            return (size_t) snprintf(s, capeFMT_MAXNUM, "%.*E", prec, x);
+        }
+    }
+    // Range of digits
+    umin = capeFMT_U10[prec];
+    umax = capeFMT_U10[prec + 1];
+    // Check for zero
+    if (ax == 0.0) {
+        r = 0;
+        e = 0;
+    } else {
+        // Initial guess of decimal exponent from binary exponent
+        frexp(ax, &e);
+        e = (int) floor((e - 1) * 0.30102999566398120);
+        // Scale so that value has (prec+1) digits before decimal point
+        k = prec - e;
+        m = capec_FmtScale10(ax, k);
+        // Correct estimate near exact powers of ten
+        if (m < (double) umin) {
+            e -= 1;
+            m = capec_FmtScale10(ax, k + 1);
+        } else if (m >= (double) umax) {
+            e += 1;
+            m = capec_FmtScale10(ax, k - 1);
+        }
+        // Integer portion and remainder
+        f = floor(m);
+        r = (unsigned long long) f;
+        f = m - f;
+        // Tolerance for rounding error in scaling steps
+        tol = m * 1e-14;
+        // Ambiguous cases go to printf() for exact behavior
+        if (fabs(f - 0.5) <= tol || r < umin || r >= umax) {
+            if (plus) {
+                return (size_t) snprintf(s, capeFMT_MAXNUM,
+                    "%+.*E", prec, x);
+            } else {
+                return (size_t) snprintf(s, capeFMT_MAXNUM,
+                    "%.*E", prec, x);
+            }
+        }
+        // Round
+        if (f > 0.5) {
+            r += 1;
+            // Check for carry, e.g. 9.99...9 -> 10.00...0
+            if (r >= umax) {
+                r /= 10;
+                e += 1;
+            }
+        }
+    }
+    // Start writing
+    p = s;
+    // Sign
+    if (signbit(x)) {
+        *(p++) = '-';
+    } else if (plus) {
+        *(p++) = '+';
+    }
+    // Leading digit
+    *(p++) = (char) ('0' + (r / umin));
+    // Decimal digits
+    if (prec > 0) {
+        *(p++) = '.';
+        capec_FmtUZ(p, r % umin, prec);
+        p += prec;
+    }
+    // Exponent
+    *(p++) = 'E';
+    if (e < 0) {
+        *(p++) = '-';
+        e = -e;
+    } else {
+        *(p++) = '+';
+    }
+    // Exponent always has at least two digits
+    if (e >= 100) {
+        n = (int) capec_FmtU(p, (unsigned long long) e);
+        p += n;
+    } else {
+        memcpy(p, capeFMT_DIGITS2 + 2*e, 2);
+        p += 2;
+    }
+    // Output
+    return (size_t) (p - s);
+}
+
+// Write double using "%.<prec>f" format
+size_t
+capec_FmtF(char *s, double x, int prec)
+{
+    double ax, m, f, tol;
+    unsigned long long r, u;
+    char *p;
+    
+    // Absolute value
+    ax = fabs(x);
+    // Cases that go to printf(): inf, nan, large, long precision
+    if (!isfinite(x) || prec < 0 || prec > 9 || ax >= 1e6) {
+        return (size_t) snprintf(s, capeFMT_MAXNUM, "%.*f", prec, x);
+    }
+    // Scale
+    m = ax * capeFMT_P10[prec];
+    // Integer portion and remainder
+    f = floor(m);
+    r = (unsigned long long) f;
+    f = m - f;
+    // Tolerance for rounding in scaling step
+    tol = m * 1e-15;
+    // Ambiguous cases go to printf() for exact behavior
+    if (fabs(f - 0.5) <= tol) {
+        return (size_t) snprintf(s, capeFMT_MAXNUM, "%.*f", prec, x);
+    }
+    // Round
+    if (f > 0.5) {
+        r += 1;
+    }
+    // Start writing
+    p = s;
+    // Sign (printf() writes "-0.000000" for small negative numbers)
+    if (signbit(x)) {
+        *(p++) = '-';
+    }
+    // Integer portion
+    u = capeFMT_U10[prec];
+    p += capec_FmtU(p, r / u);
+    // Decimal portion
+    if (prec > 0) {
+        *(p++) = '.';
+        capec_FmtUZ(p, r % u, prec);
+        p += prec;
+    }
+    // Output
+    return (size_t) (p - s);
+}
@@ -0,0 +1,557 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Local includes
+#include "capec_Geom.h"
+#include "capec_Thread.h"
+
+// SIMD instruction sets
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define capeGEOM_X86
+    #include <immintrin.h>
+#endif
+
+// Smallest length of cross product used to normalize (same as trifile.py)
+#define capeGEOM_AMIN 1e-10
+
+// Kinds of work done on each block
+enum capeGEOM_MODE {
+    capeGEOM_TRI,           // Store per-tri outputs
+    capeGEOM_NODE,          // Add area vectors to nodes
+    capeGEOM_NODESUM,       // Combine and normalize node sums
+    capeGEOM_COMP           // Add to component sums
+};
+
+
+// Coordinates and cross products of one block of tris
+typedef struct {
+    double x0[capeGEOM_BLOCK];
+    double y0[capeGEOM_BLOCK];
+    double z0[capeGEOM_BLOCK];
+    double x1[capeGEOM_BLOCK];
+    double y1[capeGEOM_BLOCK];
+    double z1[capeGEOM_BLOCK];
+    double x2[capeGEOM_BLOCK];
+    double y2[capeGEOM_BLOCK];
+    double z2[capeGEOM_BLOCK];
+    double nx[capeGEOM_BLOCK];
+    double ny[capeGEOM_BLOCK];
+    double nz[capeGEOM_BLOCK];
+    double a[capeGEOM_BLOCK];
+    double l01[capeGEOM_BLOCK];
+    double l12[capeGEOM_BLOCK];
+    double l20[capeGEOM_BLOCK];
+} capecGeomBlock;
+
+// Work for one thread
+typedef struct {
+    int mode;               // See capeGEOM_MODE
+    const double *P;        // Node coordinates
+    const int *T;           // Tri node indices
+    const int *C;           // Component IDs
+    size_t i0;              // First tri (or node for capeGEOM_NODESUM)
+    size_t i1;              // End of tris (or nodes)
+    capecTriGeom *g;        // Per-tri outputs
+    double *acc;            // Node or component sums for this thread
+    double **accs;          // All node sums (capeGEOM_NODESUM)
+    int nacc;               // Number of node sums
+    int cmin;               // Smallest component ID
+} capecGeomTask;
+
+// Kernel function type
+typedef void (*capecGeomCrossFunc)(capecGeomBlock *, size_t, size_t, int);
+
+
+// ======================================================================
+// CROSS PRODUCT KERNELS
+// ======================================================================
+
+// Cross products, their lengths, and edge lengths one tri at a time
+static void
+capec_GeomCross_scalar(capecGeomBlock *b, size_t j0, size_t k, int lengths)
+{
+    size_t j;
+    double ax, ay, az, bx, by, bz, cx, cy, cz, nx, ny, nz;
+    
+    // Loop through tris
+    for (j=j0; j<k; j++) {
+        // Edges from first vertex
+        ax = b->x1[j] - b->x0[j];
+        ay = b->y1[j] - b->y0[j];
+        az = b->z1[j] - b->z0[j];
+        bx = b->x2[j] - b->x0[j];
+        by = b->y2[j] - b->y0[j];
+        bz = b->z2[j] - b->z0[j];
+        // Cross product
+        nx = ay*bz - az*by;
+        ny = az*bx - ax*bz;
+        nz = ax*by - ay*bx;
+        b->nx[j] = nx;
+        b->ny[j] = ny;
+        b->nz[j] = nz;
+        b->a[j] = sqrt(nx*nx + ny*ny + nz*nz);
+        // Edge lengths
+        if (lengths) {
+            cx = b->x2[j] - b->x1[j];
+            cy = b->y2[j] - b->y1[j];
+            cz = b->z2[j] - b->z1[j];
+            b->l01[j] = sqrt(ax*ax + ay*ay + az*az);
+            b->l12[j] = sqrt(cx*cx + cy*cy + cz*cz);
+            b->l20[j] = sqrt(bx*bx + by*by + bz*bz);
+        }
+    }
+}
+
+#ifdef capeGEOM_X86
+
+// Length of 4 vectors
+#define capeGEOM_NORM4(x, y, z) _mm256_sqrt_pd(_mm256_add_pd(_mm256_add_pd( \
+    _mm256_mul_pd(x, x), _mm256_mul_pd(y, y)), _mm256_mul_pd(z, z)))
+
+// Cross products, 4 tris at a time (no FMA, so results match scalar)
+__attribute__((target("avx2")))
+static void
+capec_GeomCross_avx2(capecGeomBlock *b, size_t j0, size_t k, int lengths)
+{
+    size_t j;
+    __m256d x0, y0, z0, ax, ay, az, bx, by, bz, cx, cy, cz, nx, ny, nz;
+    
+    // Loop through groups of 4 tris
+    for (j=j0; j+4<=k; j+=4) {
+        // First vertex
+        x0 = _mm256_loadu_pd(b->x0 + j);
+        y0 = _mm256_loadu_pd(b->y0 + j);
+        z0 = _mm256_loadu_pd(b->z0 + j);
+        // Edges from first vertex
+        ax = _mm256_sub_pd(_mm256_loadu_pd(b->x1 + j), x0);
+        ay = _mm256_sub_pd(_mm256_loadu_pd(b->y1 + j), y0);
+        az = _mm256_sub_pd(_mm256_loadu_pd(b->z1 + j), z0);
+        bx = _mm256_sub_pd(_mm256_loadu_pd(b->x2 + j), x0);
+        by = _mm256_sub_pd(_mm256_loadu_pd(b->y2 + j), y0);
+        bz = _mm256_sub_pd(_mm256_loadu_pd(b->z2 + j), z0);
+        // Cross product
+        nx = _mm256_sub_pd(_mm256_mul_pd(ay, bz), _mm256_mul_pd(az, by));
+        ny = _mm256_sub_pd(_mm256_mul_pd(az, bx), _mm256_mul_pd(ax, bz));
+        nz = _mm256_sub_pd(_mm256_mul_pd(ax, by), _mm256_mul_pd(ay, bx));
+        _mm256_storeu_pd(b->nx + j, nx);
+        _mm256_storeu_pd(b->ny + j, ny);
+        _mm256_storeu_pd(b->nz + j, nz);
+        _mm256_storeu_pd(b->a + j, capeGEOM_NORM4(nx, ny, nz));
+        // Edge lengths
+        if (lengths) {
+            cx = _mm256_sub_pd(_mm256_loadu_pd(b->x2 + j),
+                _mm256_loadu_pd(b->x1 + j));
+            cy = _mm256_sub_pd(_mm256_loadu_pd(b->y2 + j),
+                _mm256_loadu_pd(b->y1 + j));
+            cz = _mm256_sub_pd(_mm256_loadu_pd(b->z2 + j),
+                _mm256_loadu_pd(b->z1 + j));
+            _mm256_storeu_pd(b->l01 + j, capeGEOM_NORM4(ax, ay, az));
+            _mm256_storeu_pd(b->l12 + j, capeGEOM_NORM4(cx, cy, cz));
+            _mm256_storeu_pd(b->l20 + j, capeGEOM_NORM4(bx, by, bz));
+        }
+    }
+    // Remainder
+    capec_GeomCross_scalar(b, j, k, lengths);
+}
+
+#endif  // capeGEOM_X86
+
+
+// ======================================================================
+// KERNEL SELECTION
+// ======================================================================
+
+// Selected kernel (scalar until capec_GeomInit() is called)
+static capecGeomCrossFunc capec_GeomCross_best = capec_GeomCross_scalar;
+static const char        *capec_GeomKernel = "scalar";
+
+// Pick kernels according to CPU features
+void
+capec_GeomInit(void)
+{
+#ifdef capeGEOM_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        capec_GeomCross_best = capec_GeomCross_avx2;
+        capec_GeomKernel = "avx2";
+    }
+#endif
+}
+
+// Name of selected kernels
+const char *
+capec_GeomKernelName(void)
+{
+    return capec_GeomKernel;
+}
+
+
+// ======================================================================
+// BLOCK OPERATIONS
+// ======================================================================
+
+// Copy vertex coordinates of *k* tris into block
+static void
+capec_GeomGather(capecGeomBlock *b, const double *P, const int *T, size_t k)
+{
+    size_t j;
+    const double *p;
+    
+    // Loop through tris
+    for (j=0; j<k; j++) {
+        p = P + 3*(size_t) (T[3*j] - 1);
+        b->x0[j] = p[0];
+        b->y0[j] = p[1];
+        b->z0[j] = p[2];
+        p = P + 3*(size_t) (T[3*j + 1] - 1);
+        b->x1[j] = p[0];
+        b->y1[j] = p[1];
+        b->z1[j] = p[2];
+        p = P + 3*(size_t) (T[3*j + 2] - 1);
+        b->x2[j] = p[0];
+        b->y2[j] = p[1];
+        b->z2[j] = p[2];
+    }
+}
+
+// Save per-tri outputs of a block starting at tri *i0*
+static void
+capec_GeomStoreTri(capecGeomBlock *b, capecTriGeom *g, size_t i0, size_t k)
+{
+    size_t j, i;
+    double a;
+    
+    // Loop through tris
+    for (j=0, i=i0; j<k; j++, i++) {
+        // Centers
+        if (g->centers != NULL) {
+            g->centers[3*i]     = (b->x0[j] + b->x1[j] + b->x2[j]) / 3.0;
+            g->centers[3*i + 1] = (b->y0[j] + b->y1[j] + b->y2[j]) / 3.0;
+            g->centers[3*i + 2] = (b->z0[j] + b->z1[j] + b->z2[j]) / 3.0;
+        }
+        // Area vectors (half of cross product)
+        if (g->areavecs != NULL) {
+            g->areavecs[3*i]     = 0.5 * b->nx[j];
+            g->areavecs[3*i + 1] = 0.5 * b->ny[j];
+            g->areavecs[3*i + 2] = 0.5 * b->nz[j];
+        }
+        // Limited length of cross product
+        a = (b->a[j] > capeGEOM_AMIN) ? b->a[j] : capeGEOM_AMIN;
+        // Unit normals
+        if (g->normals != NULL) {
+            g->normals[3*i]     = b->nx[j] / a;
+            g->normals[3*i + 1] = b->ny[j] / a;
+            g->normals[3*i + 2] = b->nz[j] / a;
+        }
+        // Areas
+        if (g->areas != NULL) {
+            g->areas[i] = a / 2;
+        }
+        // Edge lengths
+        if (g->lengths != NULL) {
+            g->lengths[3*i]     = b->l01[j];
+            g->lengths[3*i + 1] = b->l12[j];
+            g->lengths[3*i + 2] = b->l20[j];
+        }
+    }
+}
+
+// Add area vectors of a block to each of its nodes
+static void
+capec_GeomAddNodes(capecGeomBlock *b, double *N, const int *T, size_t k)
+{
+    size_t j;
+    int v;
+    double *q;
+    double ax, ay, az;
+    
+    // Loop through tris
+    for (j=0; j<k; j++) {
+        // Area vector
+        ax = 0.5 * b->nx[j];
+        ay = 0.5 * b->ny[j];
+        az = 0.5 * b->nz[j];
+        // Add to each vertex
+        for (v=0; v<3; v++) {
+            q = N + 3*(size_t) (T[3*j + v] - 1);
+            q[0] += ax;
+            q[1] += ay;
+            q[2] += az;
+        }
+    }
+}
+
+// Add area, area vector, and area-weighted center to component sums
+static void
+capec_GeomAddComps(capecGeomBlock *b, double *S, const int *C, int cmin,
+    size_t k)
+{
+    size_t j;
+    double a;
+    double *s;
+    
+    // Loop through tris
+    for (j=0; j<k; j++) {
+        // Row for this component
+        s = S + capeGEOM_NCOMPSUM*(size_t) (C[j] - cmin);
+        // Area, limited as in capec_GeomStoreTri()
+        a = (b->a[j] > capeGEOM_AMIN) ? b->a[j] : capeGEOM_AMIN;
+        a /= 2;
+        // Add
+        s[0] += a;
+        s[1] += 0.5 * b->nx[j];
+        s[2] += 0.5 * b->ny[j];
+        s[3] += 0.5 * b->nz[j];
+        s[4] += a * (b->x0[j] + b->x1[j] + b->x2[j]) / 3.0;
+        s[5] += a * (b->y0[j] + b->y1[j] + b->y2[j]) / 3.0;
+        s[6] += a * (b->z0[j] + b->z1[j] + b->z2[j]) / 3.0;
+        s[7] += 1.0;
+    }
+}
+
+// Combine node sums from each thread and normalize
+static void
+capec_GeomNodeSum(capecGeomTask *t)
+{
+    size_t i;
+    int k;
+    double L;
+    double *q;
+    
+    // Loop through nodes of this task
+    for (i=t->i0; i<t->i1; i++) {
+        q = t->acc + 3*i;
+        // Add sums from other threads
+        for (k=0; k<t->nacc; k++) {
+            q[0] += t->accs[k][3*i];
+            q[1] += t->accs[k][3*i + 1];
+            q[2] += t->accs[k][3*i + 2];
+        }
+        // Normalize
+        L = sqrt(q[0]*q[0] + q[1]*q[1] + q[2]*q[2]);
+        L = (L > capeGEOM_AMIN) ? L : capeGEOM_AMIN;
+        q[0] /= L;
+        q[1] /= L;
+        q[2] /= L;
+    }
+}
+
+// Process tris of one task
+static void
+capec_GeomRun(void *task)
+{
+    size_t i, k;
+    capecGeomBlock b;
+    capecGeomTask *t = (capecGeomTask *) task;
+    
+    // Second stage of node normals
+    if (t->mode == capeGEOM_NODESUM) {
+        capec_GeomNodeSum(t);
+        return;
+    }
+    // Loop through blocks
+    for (i=t->i0; i<t->i1; i+=capeGEOM_BLOCK) {
+        // Size of block
+        k = (t->i1 - i < capeGEOM_BLOCK) ? t->i1 - i : capeGEOM_BLOCK;
+        // Coordinates and cross products
+        capec_GeomGather(&b, t->P, t->T + 3*i, k);
+        capec_GeomCross_best(&b, 0, k,
+            t->mode == capeGEOM_TRI && t->g->lengths != NULL);
+        // Save or add results
+        if (t->mode == capeGEOM_TRI) {
+            capec_GeomStoreTri(&b, t->g, i, k);
+        } else if (t->mode == capeGEOM_NODE) {
+            capec_GeomAddNodes(&b, t->acc, t->T + 3*i, k);
+        } else {
+            capec_GeomAddComps(&b, t->acc, t->C + i, t->cmin, k);
+        }
+    }
+}
+
+
+// ======================================================================
+// DRIVERS
+// ======================================================================
+
+// Get number of threads to use for *n* tris
+static int
+capec_GeomNThread(size_t n, int nthread)
+{
+    size_t nchunk;
+    
+    // Number of chunks that are worth a thread
+    nchunk = n / capeGEOM_CHUNKMIN;
+    // Default: all CPUs
+    if (nthread <= 0) {
+        nthread = capec_ThreadCount();
+    }
+    if ((size_t) nthread > nchunk) {
+        nthread = (int) nchunk;
+    }
+    if (nthread > capeTHREAD_MAX) {
+        nthread = capeTHREAD_MAX;
+    }
+    return (nthread < 1) ? 1 : nthread;
+}
+
+// Split *n* items among tasks
+static void
+capec_GeomSplit(capecGeomTask *tasks, int ntask, size_t n)
+{
+    int k;
+    
+    // Contiguous ranges as equal as possible
+    for (k=0; k<ntask; k++) {
+        tasks[k].i0 = (n * (size_t) k) / (size_t) ntask;
+        tasks[k].i1 = (n * (size_t) (k + 1)) / (size_t) ntask;
+    }
+}
+
+// Check node indices
+int
+capec_TriCheck(const int *T, size_t nTri, size_t nNode)
+{
+    size_t i;
+    
+    // Loop through indices
+    for (i=0; i<3*nTri; i++) {
+        if (T[i] < 1 || (size_t) T[i] > nNode) {
+            return capeGEOM_ERR_INDEX;
+        }
+    }
+    return capeGEOM_OK;
+}
+
+// Compute geometry of each tri
+int
+capec_TriGeom(const double *P, const int *T, size_t nTri, capecTriGeom *g,
+    int nthread)
+{
+    int k;
+    capecGeomTask tasks[capeTHREAD_MAX];
+    
+    // Number of threads
+    nthread = capec_GeomNThread(nTri, nthread);
+    // Set up tasks
+    memset(tasks, 0, nthread*sizeof(capecGeomTask));
+    for (k=0; k<nthread; k++) {
+        tasks[k].mode = capeGEOM_TRI;
+        tasks[k].P = P;
+        tasks[k].T = T;
+        tasks[k].g = g;
+    }
+    capec_GeomSplit(tasks, nthread, nTri);
+    // Run them; outputs of tasks don't overlap
+    capec_ThreadRun(capec_GeomRun, tasks, sizeof(capecGeomTask), nthread);
+    return capeGEOM_OK;
+}
+
+// Compute area-weighted unit normals at nodes
+int
+capec_TriNodeNormals(const double *P, size_t nNode, const int *T,
+    size_t nTri, double *N, int nthread)
+{
+    int k;
+    double *accs[capeTHREAD_MAX];
+    capecGeomTask tasks[capeTHREAD_MAX];
+    
+    // Number of threads
+    nthread = capec_GeomNThread(nTri, nthread);
+    // First thread adds directly to output
+    memset(N, 0, 3*nNode*sizeof(double));
+    // Others need their own sums; use fewer threads if memory is short
+    for (k=1; k<nthread; k++) {
+        accs[k] = (double *) calloc(3*nNode, sizeof(double));
+        if (accs[k] == NULL) {
+            nthread = k;
+        }
+    }
+    accs[0] = N;
+    
+    // Set up tasks
+    memset(tasks, 0, nthread*sizeof(capecGeomTask));
+    for (k=0; k<nthread; k++) {
+        tasks[k].mode = capeGEOM_NODE;
+        tasks[k].P = P;
+        tasks[k].T = T;
+        tasks[k].acc = accs[k];
+    }
+    capec_GeomSplit(tasks, nthread, nTri);
+    // Add area vectors of each tri to its nodes
+    capec_ThreadRun(capec_GeomRun, tasks, sizeof(capecGeomTask), nthread);
+    
+    // Combine and normalize, splitting up nodes this time
+    for (k=0; k<nthread; k++) {
+        tasks[k].mode = capeGEOM_NODESUM;
+        tasks[k].acc = N;
+        tasks[k].accs = accs + 1;
+        tasks[k].nacc = nthread - 1;
+    }
+    capec_GeomSplit(tasks, nthread, nNode);
+    capec_ThreadRun(capec_GeomRun, tasks, sizeof(capecGeomTask), nthread);
+    
+    // Release work space
+    for (k=1; k<nthread; k++) {
+        free(accs[k]);
+    }
+    return capeGEOM_OK;
+}
+
+// Sum areas, area vectors, and centers by component
+int
+capec_TriCompSums(const double *P, const int *T, const int *C, size_t nTri,
+    int cmin, size_t ncomp, double *S, int nthread)
+{
+    int k;
+    size_t i, n;
+    double *accs[capeTHREAD_MAX];
+    capecGeomTask tasks[capeTHREAD_MAX];
+    
+    // Check component IDs
+    for (i=0; i<nTri; i++) {
+        if (C[i] < cmin || (size_t) (C[i] - cmin) >= ncomp) {
+            return capeGEOM_ERR_INDEX;
+        }
+    }
+    // Number of threads
+    nthread = capec_GeomNThread(nTri, nthread);
+    // Size of each table of sums
+    n = ncomp * capeGEOM_NCOMPSUM;
+    // Use at most as many sums as there are tris in total
+    if (nthread > 1 && n * (size_t) nthread > 4*nTri) {
+        nthread = 1;
+    }
+    // First thread adds directly to output
+    memset(S, 0, n*sizeof(double));
+    for (k=1; k<nthread; k++) {
+        accs[k] = (double *) calloc(n, sizeof(double));
+        if (accs[k] == NULL) {
+            nthread = k;
+        }
+    }
+    accs[0] = S;
+    
+    // Set up tasks
+    memset(tasks, 0, nthread*sizeof(capecGeomTask));
+    for (k=0; k<nthread; k++) {
+        tasks[k].mode = capeGEOM_COMP;
+        tasks[k].P = P;
+        tasks[k].T = T;
+        tasks[k].C = C;
+        tasks[k].cmin = cmin;
+        tasks[k].acc = accs[k];
+    }
+    capec_GeomSplit(tasks, nthread, nTri);
+    // Add each tri to its component
+    capec_ThreadRun(capec_GeomRun, tasks, sizeof(capecGeomTask), nthread);
+    
+    // Combine sums from each thread
+    for (k=1; k<nthread; k++) {
+        for (i=0; i<n; i++) {
+            S[i] += accs[k][i];
+        }
+        free(accs[k]);
+    }
+    return capeGEOM_OK;
+}
@@ -0,0 +1,500 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Local includes
+#include "capec_Interp.h"
+#include "capec_Thread.h"
+
+// SIMD instruction sets
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define capeINTERP_X86
+    #include <immintrin.h>
+#endif
+
+// Kinds of work done by each task
+enum capeINTERP_MODE {
+    capeINTERP_MULTILINEAR, // Multilinear interpolation
+    capeINTERP_RBF          // Radial basis function
+};
+
+// Names of radial basis functions
+const char *capeRBF_NAMES[capeRBF_NFUNC] = {
+    "multiquadric",
+    "inverse_multiquadric",
+    "gaussian",
+    "linear",
+    "cubic",
+    "quintic",
+    "thin_plate"
+};
+
+
+// Work for one thread
+typedef struct {
+    int mode;               // See capeINTERP_MODE
+    const capecInterpTable *t;  // Multilinear table
+    const capecRBF *r;      // Radial basis function
+    const double **X;       // Values of each arg
+    double *Y;              // Output values
+    size_t i0;              // First point
+    size_t i1;              // End of points
+    size_t ibad;            // First point out of range
+    int ierr;               // Status of this task
+} capecInterpTask;
+
+// Distance kernel function type
+typedef void (*capecInterpDistFunc)(
+    const double *, size_t, int, const double *, size_t, size_t, double *);
+
+
+// ======================================================================
+// DISTANCE KERNELS
+// ======================================================================
+
+// Distances from *x* to centers *j0* to *k* of block, one at a time
+static void
+capec_InterpDist_scalar(const double *xi, size_t n, int nd, const double *x,
+    size_t j0, size_t k, double *r)
+{
+    size_t j;
+    int d;
+    double t, r2;
+    
+    // Loop through centers
+    for (j=j0; j<k; j++) {
+        // Sum of squares, one arg at a time (same order as SciPy)
+        r2 = 0.0;
+        for (d=0; d<nd; d++) {
+            t = x[d] - xi[d*n + j];
+            r2 += t*t;
+        }
+        r[j] = sqrt(r2);
+    }
+}
+
+#ifdef capeINTERP_X86
+
+// Distances to 4 centers at a time (no FMA, so results match scalar)
+__attribute__((target("avx2")))
+static void
+capec_InterpDist_avx2(const double *xi, size_t n, int nd, const double *x,
+    size_t j0, size_t k, double *r)
+{
+    size_t j;
+    int d;
+    __m256d t, r2;
+    
+    // Loop through groups of 4 centers
+    for (j=j0; j+4<=k; j+=4) {
+        r2 = _mm256_setzero_pd();
+        for (d=0; d<nd; d++) {
+            t = _mm256_sub_pd(_mm256_set1_pd(x[d]),
+                _mm256_loadu_pd(xi + d*n + j));
+            r2 = _mm256_add_pd(r2, _mm256_mul_pd(t, t));
+        }
+        _mm256_storeu_pd(r + j, _mm256_sqrt_pd(r2));
+    }
+    // Remainder
+    capec_InterpDist_scalar(xi, n, nd, x, j, k, r);
+}
+
+#endif  // capeINTERP_X86
+
+
+// ======================================================================
+// KERNEL SELECTION
+// ======================================================================
+
+// Selected kernel (scalar until capec_InterpInit() is called)
+static capecInterpDistFunc capec_InterpDist_best = capec_InterpDist_scalar;
+static const char         *capec_InterpKernel = "scalar";
+
+// Pick kernels according to CPU features
+void
+capec_InterpInit(void)
+{
+#ifdef capeINTERP_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        capec_InterpDist_best = capec_InterpDist_avx2;
+        capec_InterpKernel = "avx2";
+    }
+#endif
+}
+
+// Name of selected kernels
+const char *
+capec_InterpKernelName(void)
+{
+    return capec_InterpKernel;
+}
+
+// Index of radial basis function
+int
+capec_RBFFunc(const char *name)
+{
+    int k;
+    
+    // Aliases accepted by SciPy
+    if (strcmp(name, "inverse") == 0)
+        return capeRBF_INVERSE;
+    if (strcmp(name, "thin-plate") == 0)
+        return capeRBF_THIN_PLATE;
+    // Search list
+    for (k=0; k<capeRBF_NFUNC; k++) {
+        if (strcmp(name, capeRBF_NAMES[k]) == 0)
+            return k;
+    }
+    return -1;
+}
+
+
+// ======================================================================
+// BREAK POINTS
+// ======================================================================
+
+// Last interval start *i* (0 <= i <= n-2) with V[i] <= v, trying *h* first
+static size_t
+capec_InterpFind(const double *V, size_t n, double v, size_t h)
+{
+    size_t lo, hi, mid;
+    
+    // Answer is in [lo, hi), or 0 if empty
+    lo = 0;
+    hi = n - 1;
+    if (V[h] <= v) {
+        // Same interval as previous point?
+        if (h + 1 >= hi || v < V[h + 1])
+            return h;
+        lo = h + 1;
+    } else {
+        hi = h;
+    }
+    // Bisection
+    while (hi - lo > 1) {
+        mid = lo + (hi - lo)/2;
+        if (V[mid] <= v) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// Find interval and fraction of *v*; -1 if below, 1 if above, else 0
+static int
+capec_InterpBracket(const double *V, size_t n, double tol, double v,
+    size_t *h, size_t *i, double *f)
+{
+    double dv;
+    
+    // Tolerance at ends
+    dv = tol * (V[n-1] - V[0]);
+    // Check for extrapolation cases
+    if (v < V[0] - dv) {
+        *i = 0;
+        *f = (v - V[0]) / (V[1] - V[0]);
+        return -1;
+    }
+    if (v > V[n-1] + dv) {
+        *i = n - 2;
+        *f = (v - V[n-2]) / (V[n-1] - V[n-2]);
+        return 1;
+    }
+    // Search, starting from interval of previous point
+    *i = capec_InterpFind(V, n, v, *h);
+    *h = *i;
+    *f = (v - V[*i]) / (V[*i + 1] - V[*i]);
+    return 0;
+}
+
+// Find interval of each value
+int
+capec_BkptIndex(const double *V, size_t n, const double *x, size_t nx,
+    double tol, long *I, double *F)
+{
+    size_t j, i;
+    size_t h = 0;
+    int side;
+    
+    // Loop through values
+    for (j=0; j<nx; j++) {
+        side = capec_InterpBracket(V, n, tol, x[j], &h, &i, F + j);
+        if (side < 0) {
+            I[j] = -1;
+        } else if (side > 0) {
+            I[j] = (long) n - 1;
+        } else {
+            I[j] = (long) i;
+        }
+    }
+    return capeINTERP_OK;
+}
+
+
+// ======================================================================
+// BLOCK OPERATIONS
+// ======================================================================
+
+// Multilinear interpolation of points of one task
+static void
+capec_InterpRunLinear(capecInterpTask *t)
+{
+    int a, c, nk, nc, side;
+    size_t i, j, k, q, off;
+    size_t h[capeINTERP_MAXARG];
+    size_t stride[capeINTERP_MAXARG];
+    size_t base[capeINTERP_BLOCK];
+    double F[capeINTERP_MAXARG][capeINTERP_BLOCK];
+    double w, y, fq;
+    const capecInterpTable *tab = t->t;
+    
+    // Number of args and corners
+    nk = tab->nk;
+    nc = 1 << nk;
+    // Size of remaining block for each arg
+    for (a=nk-1, off=1; a>=0; a--) {
+        stride[a] = off;
+        off *= tab->nb[a];
+        h[a] = 0;
+    }
+    // Loop through blocks
+    for (i=t->i0; i<t->i1; i+=capeINTERP_BLOCK) {
+        // Size of block
+        k = (t->i1 - i < capeINTERP_BLOCK) ? t->i1 - i : capeINTERP_BLOCK;
+        memset(base, 0, k*sizeof(size_t));
+        // Brackets of each point, one arg at a time
+        for (a=0; a<nk; a++) {
+            for (j=0; j<k; j++) {
+                side = capec_InterpBracket(tab->bkpts[a], tab->nb[a],
+                    tab->tol, t->X[a][i + j], h + a, &q, F[a] + j);
+                // Check for extrapolation
+                if (side && tab->extrap == capeINTERP_ERROR) {
+                    t->ierr = capeINTERP_ERR_RANGE;
+                    t->ibad = i + j;
+                    return;
+                } else if (side && tab->extrap == capeINTERP_HOLD) {
+                    F[a][j] = (side < 0) ? 0.0 : 1.0;
+                }
+                base[j] += q * stride[a];
+            }
+        }
+        // Weighted sum of corners, as in _rcall_multilinear()
+        for (j=0; j<k; j++) {
+            y = 0.0;
+            for (c=0; c<nc; c++) {
+                off = base[j];
+                w = 1.0;
+                for (a=0; a<nk; a++) {
+                    fq = F[a][j];
+                    if ((c >> (nk - 1 - a)) & 1) {
+                        off += stride[a];
+                        w *= fq;
+                    } else {
+                        w *= 1 - fq;
+                    }
+                }
+                y += w * tab->V[off];
+            }
+            t->Y[i + j] = y;
+        }
+    }
+}
+
+// Apply basis function to distances and sum with weights
+static double
+capec_InterpRBFSum(const capecRBF *r, double *R, const double *w, size_t k)
+{
+    size_t j;
+    double s, e, y;
+    
+    // Inverse of scale factor (same order of operations as SciPy)
+    e = 1.0 / r->eps;
+    // Basis function, in place
+    switch (r->func) {
+        case capeRBF_MULTIQUADRIC:
+            for (j=0; j<k; j++) {
+                s = e * R[j];
+                R[j] = sqrt(s*s + 1);
+            }
+            break;
+        case capeRBF_INVERSE:
+            for (j=0; j<k; j++) {
+                s = e * R[j];
+                R[j] = 1.0 / sqrt(s*s + 1);
+            }
+            break;
+        case capeRBF_GAUSSIAN:
+            for (j=0; j<k; j++) {
+                s = e * R[j];
+                R[j] = exp(-(s*s));
+            }
+            break;
+        case capeRBF_CUBIC:
+            for (j=0; j<k; j++) {
+                s = R[j];
+                R[j] = s*s*s;
+            }
+            break;
+        case capeRBF_QUINTIC:
+            for (j=0; j<k; j++) {
+                s = R[j]*R[j];
+                R[j] = s*s*R[j];
+            }
+            break;
+        case capeRBF_THIN_PLATE:
+            for (j=0; j<k; j++) {
+                s = R[j];
+                R[j] = (s == 0.0) ? 0.0 : s*s * log(s);
+            }
+            break;
+        default:
+            break;
+    }
+    // Weighted sum
+    for (y=0.0, j=0; j<k; j++) {
+        y += R[j] * w[j];
+    }
+    return y;
+}
+
+// Evaluate radial basis function at points of one task
+static void
+capec_InterpRunRBF(capecInterpTask *t)
+{
+    int d;
+    size_t i, j, k;
+    double y;
+    double x[capeINTERP_MAXARG];
+    double R[capeINTERP_BLOCK];
+    const capecRBF *r = t->r;
+    
+    // Loop through points
+    for (i=t->i0; i<t->i1; i++) {
+        // Coordinates of this point
+        for (d=0; d<r->nd; d++) {
+            x[d] = t->X[d][i];
+        }
+        // Loop through blocks of centers
+        for (y=0.0, j=0; j<r->n; j+=capeINTERP_BLOCK) {
+            // Size of block
+            k = (r->n - j < capeINTERP_BLOCK) ? r->n - j : capeINTERP_BLOCK;
+            // Distances to each center, then basis functions
+            capec_InterpDist_best(r->xi + j, r->n, r->nd, x, 0, k, R);
+            y += capec_InterpRBFSum(r, R, r->nodes + j, k);
+        }
+        t->Y[i] = y;
+    }
+}
+
+// Process points of one task
+static void
+capec_InterpRun(void *task)
+{
+    capecInterpTask *t = (capecInterpTask *) task;
+    
+    // Check mode
+    if (t->mode == capeINTERP_MULTILINEAR) {
+        capec_InterpRunLinear(t);
+    } else {
+        capec_InterpRunRBF(t);
+    }
+}
+
+
+// ======================================================================
+// DRIVERS
+// ======================================================================
+
+// Get number of threads for *n* points with *cost* each
+static int
+capec_InterpNThread(size_t n, size_t cost, int nthread)
+{
+    size_t nchunk;
+    
+    // Number of chunks that are worth a thread
+    nchunk = (n * cost) / capeINTERP_CHUNKMIN;
+    if (nchunk > n) {
+        nchunk = n;
+    }
+    // Default: all CPUs
+    if (nthread <= 0) {
+        nthread = capec_ThreadCount();
+    }
+    if ((size_t) nthread > nchunk) {
+        nthread = (int) nchunk;
+    }
+    if (nthread > capeTHREAD_MAX) {
+        nthread = capeTHREAD_MAX;
+    }
+    return (nthread < 1) ? 1 : nthread;
+}
+
+// Split *n* points among tasks and run them
+static int
+capec_InterpRunAll(capecInterpTask *tasks, int ntask, size_t n,
+    size_t *ibad)
+{
+    int k;
+    
+    // Contiguous ranges as equal as possible
+    for (k=0; k<ntask; k++) {
+        tasks[k].i0 = (n * (size_t) k) / (size_t) ntask;
+        tasks[k].i1 = (n * (size_t) (k + 1)) / (size_t) ntask;
+    }
+    // Outputs of tasks don't overlap
+    capec_ThreadRun(capec_InterpRun, tasks, sizeof(capecInterpTask), ntask);
+    // First task with an error has the first bad point
+    for (k=0; k<ntask; k++) {
+        if (tasks[k].ierr) {
+            if (ibad != NULL)
+                *ibad = tasks[k].ibad;
+            return tasks[k].ierr;
+        }
+    }
+    return capeINTERP_OK;
+}
+
+// Multilinear interpolation at many points
+int
+capec_Multilinear(const capecInterpTable *t, const double **X, size_t nx,
+    double *Y, size_t *ibad, int nthread)
+{
+    int k;
+    capecInterpTask tasks[capeTHREAD_MAX];
+    
+    // Number of threads; cost is number of corners times number of args
+    nthread = capec_InterpNThread(nx, (size_t) t->nk << t->nk, nthread);
+    // Set up tasks
+    memset(tasks, 0, nthread*sizeof(capecInterpTask));
+    for (k=0; k<nthread; k++) {
+        tasks[k].mode = capeINTERP_MULTILINEAR;
+        tasks[k].t = t;
+        tasks[k].X = X;
+        tasks[k].Y = Y;
+    }
+    return capec_InterpRunAll(tasks, nthread, nx, ibad);
+}
+
+// Evaluate radial basis function at many points
+int
+capec_RBFEval(const capecRBF *r, const double **X, size_t nx, double *Y,
+    int nthread)
+{
+    int k;
+    capecInterpTask tasks[capeTHREAD_MAX];
+    
+    // Number of threads; cost is number of centers times number of args
+    nthread = capec_InterpNThread(nx, r->n * (size_t) r->nd, nthread);
+    // Set up tasks
+    memset(tasks, 0, nthread*sizeof(capecInterpTask));
+    for (k=0; k<nthread; k++) {
+        tasks[k].mode = capeINTERP_RBF;
+        tasks[k].r = r;
+        tasks[k].X = X;
+        tasks[k].Y = Y;
+    }
+    return capec_InterpRunAll(tasks, nthread, nx, NULL);
+}
@@ -0,0 +1,239 @@
+#include <stdlib.h>
+#include <string.h>
+
+// Local includes
+#include "capec_LineLoad.h"
+#include "capec_Thread.h"
+
+
+// Work for one thread
+typedef struct {
+    const double *P;        // Node coordinates
+    const int *T;           // Tri node indices
+    const double *Q;        // Node states
+    int nq;                 // Number of states
+    const int *C;           // Component IDs
+    size_t i0;              // First tri
+    size_t i1;              // End of tris
+    int cmin;               // Smallest component ID
+    const double *a;        // Axis of cuts
+    const double *X;        // Slab boundaries
+    size_t nslab;           // Number of slabs
+    const capecTriqFMOpts *opts;    // Freestream state
+    double *S;              // Sums for this thread
+} capecLineLoadTask;
+
+
+// ======================================================================
+// CUTS
+// ======================================================================
+
+// Fraction of tri area below level *b* and its first moment
+static double
+capec_LineLoadBelow(const double **v, const double *s, const double *xc,
+    double b, double *m)
+{
+    int j;
+    double t1, t2, f;
+    
+    // Check for trivial cases
+    if (b <= s[0]) {
+        m[0] = m[1] = m[2] = 0.0;
+        return 0.0;
+    } else if (b >= s[2]) {
+        memcpy(m, xc, 3*sizeof(double));
+        return 1.0;
+    }
+    // Check which edge the cut crosses
+    if (b <= s[1]) {
+        // Triangle at lowest vertex is below
+        t1 = (b - s[0]) / (s[1] - s[0]);
+        t2 = (b - s[0]) / (s[2] - s[0]);
+        f = t1*t2;
+        for (j=0; j<3; j++) {
+            m[j] = f/3 * (3*v[0][j] + t1*(v[1][j] - v[0][j]) +
+                t2*(v[2][j] - v[0][j]));
+        }
+        return f;
+    }
+    // Triangle at highest vertex is above
+    t1 = (s[2] - b) / (s[2] - s[1]);
+    t2 = (s[2] - b) / (s[2] - s[0]);
+    f = t1*t2;
+    for (j=0; j<3; j++) {
+        m[j] = xc[j] - f/3 * (3*v[2][j] + t1*(v[1][j] - v[2][j]) +
+            t2*(v[0][j] - v[2][j]));
+    }
+    return 1.0 - f;
+}
+
+// Integrate sectional forces on tris of one task
+static void
+capec_LineLoadRun(void *task)
+{
+    int j;
+    size_t i, k, klo, khi;
+    double N[3], xc[3], x[3], F[capeTRIQFM_NF];
+    double s[3], mlo[3], mhi[3];
+    double flo, fhi, f, tmp;
+    const double *v[3], *ptmp;
+    double *S;
+    capecLineLoadTask *t = (capecLineLoadTask *) task;
+    
+    // Loop through tris
+    for (i=t->i0; i<t->i1; i++) {
+        // Vertices and their coordinates along axis
+        for (j=0; j<3; j++) {
+            v[j] = t->P + 3*(t->T[3*i + j] - 1);
+            s[j] = t->a[0]*v[j][0] + t->a[1]*v[j][1] + t->a[2]*v[j][2];
+        }
+        // Sort vertices by coordinate
+        if (s[0] > s[1]) {
+            tmp = s[0]; s[0] = s[1]; s[1] = tmp;
+            ptmp = v[0]; v[0] = v[1]; v[1] = ptmp;
+        }
+        if (s[1] > s[2]) {
+            tmp = s[1]; s[1] = s[2]; s[2] = tmp;
+            ptmp = v[1]; v[1] = v[2]; v[2] = ptmp;
+        }
+        if (s[0] > s[1]) {
+            tmp = s[0]; s[0] = s[1]; s[1] = tmp;
+            ptmp = v[0]; v[0] = v[1]; v[1] = ptmp;
+        }
+        // Skip tris outside all slabs
+        if (s[2] < t->X[0] || s[0] >= t->X[t->nslab]) {
+            continue;
+        }
+        // Find last slab boundary at or below lowest vertex
+        klo = 0;
+        khi = t->nslab;
+        while (khi - klo > 1) {
+            k = (klo + khi) / 2;
+            if (t->X[k] <= s[0]) {
+                klo = k;
+            } else {
+                khi = k;
+            }
+        }
+        // Area vector and forces
+        capec_TriqTriForces(t->P, t->T, t->Q, t->nq, i, t->opts, N, F);
+        // Tri center
+        for (j=0; j<3; j++) {
+            xc[j] = (v[0][j] + v[1][j] + v[2][j]) / 3;
+        }
+        // Sums for this component
+        S = t->S + capeTRIQFM_NSUM*t->nslab*(size_t) (t->C[i] - t->cmin);
+        // Part of tri below first slab
+        flo = capec_LineLoadBelow(v, s, xc, t->X[klo], mlo);
+        // Loop through slabs that might contain part of this tri
+        for (k=klo; k<t->nslab; k++) {
+            // Part of tri below top of slab
+            fhi = capec_LineLoadBelow(v, s, xc, t->X[k + 1], mhi);
+            f = fhi - flo;
+            // Add piece in this slab
+            if (f > 0) {
+                // Centroid of piece
+                for (j=0; j<3; j++) {
+                    x[j] = (mhi[j] - mlo[j]) / f;
+                    S[capeTRIQFM_NSUM*k + capeTRIQFM_A + j] += f*N[j];
+                }
+                S[capeTRIQFM_NSUM*k + capeTRIQFM_N] += f;
+                // Add each type of force
+                capec_TriqAddForce(S + capeTRIQFM_NSUM*k + capeTRIQFM_FP,
+                    x, F + capeTRIQFM_FP3, f);
+                capec_TriqAddForce(S + capeTRIQFM_NSUM*k + capeTRIQFM_FVAC,
+                    x, F + capeTRIQFM_FVAC3, f);
+                capec_TriqAddForce(S + capeTRIQFM_NSUM*k + capeTRIQFM_FM,
+                    x, F + capeTRIQFM_FM3, f);
+                capec_TriqAddForce(S + capeTRIQFM_NSUM*k + capeTRIQFM_FV,
+                    x, F + capeTRIQFM_FV3, f);
+            }
+            // Check if rest of tri is above this slab
+            if (fhi >= 1.0) {
+                break;
+            }
+            // Move to next slab
+            flo = fhi;
+            memcpy(mlo, mhi, 3*sizeof(double));
+        }
+    }
+}
+
+
+// ======================================================================
+// DRIVER
+// ======================================================================
+
+// Add up sectional forces and moments by slab and component
+int
+capec_TriqLineLoads(const double *P, const int *T, const double *Q, int nq,
+    const int *C, size_t nTri, int cmin, size_t ncomp, const double *a,
+    const double *X, size_t nslab, const capecTriqFMOpts *opts, double *S,
+    int nthread)
+{
+    int k;
+    size_t i, n, nchunk;
+    double *sums[capeTHREAD_MAX];
+    capecLineLoadTask tasks[capeTHREAD_MAX];
+    
+    // Check component IDs
+    for (i=0; i<nTri; i++) {
+        if (C[i] < cmin || (size_t) (C[i] - cmin) >= ncomp) {
+            return 1;
+        }
+    }
+    // Number of threads
+    nchunk = nTri / capeLINELOAD_CHUNKMIN;
+    if (nthread <= 0) {
+        nthread = capec_ThreadCount();
+    }
+    if ((size_t) nthread > nchunk) {
+        nthread = (int) nchunk;
+    }
+    nthread = (nthread > capeTHREAD_MAX) ? capeTHREAD_MAX : nthread;
+    nthread = (nthread < 1) ? 1 : nthread;
+    // Size of each table of sums
+    n = ncomp * nslab * capeTRIQFM_NSUM;
+    // Use at most as many sums as there are tris in total
+    if (nthread > 1 && n * (size_t) nthread > 4*nTri) {
+        nthread = 1;
+    }
+    // First thread adds directly to output
+    memset(S, 0, n*sizeof(double));
+    sums[0] = S;
+    for (k=1; k<nthread; k++) {
+        sums[k] = (double *) calloc(n, sizeof(double));
+        if (sums[k] == NULL) {
+            nthread = k;
+        }
+    }
+    
+    // Set up tasks
+    for (k=0; k<nthread; k++) {
+        tasks[k].P = P;
+        tasks[k].T = T;
+        tasks[k].Q = Q;
+        tasks[k].nq = nq;
+        tasks[k].C = C;
+        tasks[k].i0 = (nTri * (size_t) k) / (size_t) nthread;
+        tasks[k].i1 = (nTri * (size_t) (k + 1)) / (size_t) nthread;
+        tasks[k].cmin = cmin;
+        tasks[k].a = a;
+        tasks[k].X = X;
+        tasks[k].nslab = nslab;
+        tasks[k].opts = opts;
+        tasks[k].S = sums[k];
+    }
+    // Integrate each range of tris
+    capec_ThreadRun(capec_LineLoadRun, tasks, sizeof(capecLineLoadTask),
+        nthread);
+    
+    // Combine sums from each thread
+    for (k=1; k<nthread; k++) {
+        for (i=0; i<n; i++) {
+            S[i] += sums[k][i];
+        }
+        free(sums[k]);
+    }
+    return 0;
+}
@@ -0,0 +1,261 @@
+#include <Python.h>
+
+#if PY_MINOR_VERSION >= 10
+    #define NPY_NO_DEPRECATED_API NPY_2_0_API_VERSION
+#else
+    #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#endif
+#define PY_ARRAY_UNIQUE_SYMBOL _cape_ARRAY_API
+#define NO_IMPORT_ARRAY
+#include <numpy/arrayobject.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Local includes
+#include "capec_Map.h"
+#include "capec_Stats.h"
+#include "capec_Swap.h"
+#include "capec_Zip.h"
+
+// Name of capsules holding mappings
+#define capeMAP_CAPSULE "cape._cape.Map"
+
+
+// Decompress a mapped file, replacing the mapping with a buffer
+static int
+capec_MapInflate(capecMap *m, int codec, const char *fname)
+{
+    int ierr;
+    char *data;
+    size_t size;
+    
+    // Decompress without the GIL
+    Py_BEGIN_ALLOW_THREADS
+    ierr = capec_ZipInflate(m->data, m->size, codec, &data, &size);
+    Py_END_ALLOW_THREADS
+    // Compressed data no longer needed
+    capec_MapClose(m);
+    if (ierr == capeZIP_ERR_MEM) {
+        PyErr_NoMemory();
+        return 1;
+    } else if (ierr) {
+        PyErr_Format(PyExc_IOError,
+            "Could not decompress %s file '%s'", capec_ZipName(codec), fname);
+        return 1;
+    }
+    // Use buffer as if it were a mapping
+    m->data = data;
+    m->size = size;
+    m->heap = 1;
+    return 0;
+}
+
+// Map an open file without counting it
+static int
+capec_MapFD(capecMap *m, int fd)
+{
+    struct stat st;
+    void *p;
+    
+    // Initialize
+    m->data = NULL;
+    m->size = 0;
+    m->heap = 0;
+    // Get size
+    if (fstat(fd, &st)) {
+        PyErr_SetString(PyExc_IOError, "Could not get size of file");
+        return 1;
+    }
+    // Empty files can't be mapped (and have no content anyway)
+    if (st.st_size == 0) {
+        return 0;
+    }
+    // Map entire file; private so arrays may be modified in memory
+    p = mmap(NULL, (size_t) st.st_size, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE, fd, 0);
+    // Check for errors
+    if (p == MAP_FAILED) {
+        PyErr_SetString(PyExc_IOError, "Could not map file");
+        return 1;
+    }
+    // Whole file is going to be read in order
+    madvise(p, (size_t) st.st_size, MADV_SEQUENTIAL);
+    // Save
+    m->data = (char *) p;
+    m->size = (size_t) st.st_size;
+    return 0;
+}
+
+// Map a file
+int
+capec_MapOpen(capecMap *m, const char *fname)
+{
+    int fd;
+    int ierr;
+    int codec;
+    
+    // Initialize
+    m->data = NULL;
+    m->size = 0;
+    m->heap = 0;
+    // Check for compressed file
+    codec = capec_ZipCodec(fname);
+    if (!capec_ZipAvailable(codec)) {
+        PyErr_Format(PyExc_NotImplementedError,
+            "Cannot read '%s'; %s compression is not available in this "
+            "build", fname, capec_ZipName(codec));
+        return 1;
+    }
+    // Open file
+    fd = open(fname, O_RDONLY);
+    if (fd < 0) {
+        PyErr_Format(PyExc_IOError,
+            "Could not open file '%s' for reading", fname);
+        return 1;
+    }
+    // Map it
+    ierr = capec_MapFD(m, fd);
+    // File descriptor no longer needed
+    close(fd);
+    // Add file name to message
+    if (ierr) {
+        PyErr_Format(PyExc_IOError, "Could not map file '%s'", fname);
+    } else if (codec != capeZIP_NONE) {
+        ierr = capec_MapInflate(m, codec, fname);
+    }
+    // Count (uncompressed) bytes read
+    if (!ierr) {
+        capec_StatAddBytes(capec_StatCurrent(), m->size);
+    }
+    return ierr;
+}
+
+// Map an open file
+int
+capec_MapOpenFD(capecMap *m, int fd)
+{
+    int ierr;
+    
+    ierr = capec_MapFD(m, fd);
+    // Count bytes read
+    if (!ierr) {
+        capec_StatAddBytes(capec_StatCurrent(), m->size);
+    }
+    return ierr;
+}
+
+// Unmap a file
+void
+capec_MapClose(capecMap *m)
+{
+    // Check for mapping (or buffer)
+    if (m->heap) {
+        free(m->data);
+    } else if (m->data != NULL) {
+        munmap(m->data, m->size);
+    }
+    // Reset
+    m->data = NULL;
+    m->size = 0;
+    m->heap = 0;
+}
+
+// Capsule destructor
+static void
+capec_MapCapsuleDel(PyObject *cap)
+{
+    capecMap *m;
+    
+    // Get mapping
+    m = (capecMap *) PyCapsule_GetPointer(cap, capeMAP_CAPSULE);
+    if (m == NULL) {
+        PyErr_Clear();
+        return;
+    }
+    // Release it
+    capec_MapClose(m);
+    free(m);
+}
+
+// Transfer mapping to capsule
+PyObject *
+capec_MapCapsule(capecMap *m)
+{
+    capecMap *mc;
+    PyObject *cap;
+    
+    // Allocate persistent copy of mapping info
+    mc = (capecMap *) malloc(sizeof(capecMap));
+    if (mc == NULL) {
+        capec_MapClose(m);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    *mc = *m;
+    // Clear input; capsule is now the owner
+    m->data = NULL;
+    m->size = 0;
+    m->heap = 0;
+    // Create capsule
+    cap = PyCapsule_New((void *) mc, capeMAP_CAPSULE, capec_MapCapsuleDel);
+    if (cap == NULL) {
+        capec_MapClose(mc);
+        free(mc);
+        return NULL;
+    }
+    return cap;
+}
+
+// Create array from region of mapping
+PyObject *
+capec_MapArray(PyObject *base, char *data, int nd, npy_intp *dims,
+    int typenum, int swap)
+{
+    int i;
+    size_t n, wsize;
+    PyObject *A;
+    
+    // Word size
+    wsize = (typenum == NPY_DOUBLE || typenum == NPY_INT64) ? 8 : 4;
+    // Total number of elements
+    n = 1;
+    for (i=0; i<nd; i++) {
+        n *= (size_t) dims[i];
+    }
+    
+    // Check if a view is possible
+    if (!swap && base != NULL && ((uintptr_t) data) % wsize == 0) {
+        // Create view into mapping
+        A = PyArray_SimpleNewFromData(nd, dims, typenum, (void *) data);
+        if (A == NULL) {
+            return NULL;
+        }
+        // Keep the mapping alive with the array
+        Py_INCREF(base);
+        if (PyArray_SetBaseObject((PyArrayObject *) A, base)) {
+            Py_DECREF(A);
+            return NULL;
+        }
+        return A;
+    }
+    
+    // Allocate new array
+    A = PyArray_SimpleNew(nd, dims, typenum);
+    if (A == NULL) {
+        return NULL;
+    }
+    // Copy, swapping if needed
+    if (!swap) {
+        memcpy(PyArray_DATA((PyArrayObject *) A), data, n*wsize);
+    } else if (wsize == 4) {
+        capec_Swap4(PyArray_DATA((PyArrayObject *) A), data, n);
+    } else {
+        capec_Swap8(PyArray_DATA((PyArrayObject *) A), data, n);
+    }
+    return A;
+}
@@ -1,6 +1,8 @@
 // Standard library
 #include <Python.h>
 #include <stdio.h>
+#include <stdint.h>
+#include <pthread.h>
 
 // Local includes
 #include "capec_Error.h"
@@ -75,8 +77,10 @@ capec_New2D(void ***A, size_t n1, size_t n2, size_t size)
     // Initialize array (pointers to rows)
     (*A) = (void **) malloc(n1*sizeof(char *));
     // Check for errors
-    if (*A == NULL)
+    if (*A == NULL) {
+        free(temp);
         return capeERROR_MEM_ALLOC;
+    }
     
     // Allocate each row
     for(i = 0; i<n1; i++)
@@ -101,7 +105,7 @@ capec_Del1D(void *A)
 
 // Deallocate 2D array
 void
-vgc_Del2D(void **A)
+capec_Del2D(void **A)
 {
     // Check already freed
     if (A == NULL)
@@ -111,3 +115,274 @@ vgc_Del2D(void **A)
     free((void **) A);
 }
 
+
+
+// ======================================================================
+// ALIGNED
+// ======================================================================
+
+// Allocate 1D array aligned to capeMEM_ALIGN bytes
+int
+capec_NewAligned(void **A, size_t n, size_t size)
+{
+    char *raw;
+    uintptr_t p;
+    
+    // Initialize in case something already pointed to.
+    (*A) = NULL;
+    // Check for null allocation
+    if (n == 0 || size == 0)
+        return 0;
+    // Check for overflow, including room for alignment
+    if (n > (SIZE_MAX - capeMEM_ALIGN - sizeof(void *)) / size)
+        return capeERROR_MEM_OVERFLOW;
+    // Allocate extra to align and save original pointer
+    raw = (char *) malloc(n*size + capeMEM_ALIGN + sizeof(void *));
+    if (raw == NULL)
+        return capeERROR_MEM_ALLOC;
+    // Round up to alignment
+    p = (uintptr_t) (raw + sizeof(void *));
+    p = (p + capeMEM_ALIGN - 1) & ~((uintptr_t) capeMEM_ALIGN - 1);
+    // Save original pointer just before array
+    ((void **) p)[-1] = raw;
+    (*A) = (void *) p;
+    // Normal output
+    return 0;
+}
+
+// Deallocate aligned array
+void
+capec_DelAligned(void *A)
+{
+    // Check already freed
+    if (A == NULL)
+        return;
+    // Free original pointer
+    free(((void **) A)[-1]);
+}
+
+
+// ======================================================================
+// POOL
+// ======================================================================
+
+// Header at start of each pooled buffer (padded to alignment)
+typedef struct capecMemBlock {
+    struct capecMemBlock *next;     // Next block in pool or arena
+    size_t size;                    // Usable bytes after header
+    size_t used;                    // Bytes used by arena
+} capecMemBlock;
+
+// Buffers kept by one thread
+typedef struct {
+    capecMemBlock *head;            // Most recently returned block
+    size_t nbyte;                   // Total size of kept blocks
+    int nblock;                     // Number of kept blocks
+} capecMemPool;
+
+// Key for pool of each thread
+static pthread_key_t capec_PoolKey;
+static pthread_once_t capec_PoolOnce = PTHREAD_ONCE_INIT;
+static int capec_PoolKeyErr = 0;
+
+// Location of data after block header
+#define capec_BlockData(b) ((char *) (b) + capeMEM_ALIGN)
+
+// Free pool when its thread exits
+static void
+capec_PoolFree(void *P)
+{
+    capecMemBlock *b, *next;
+    
+    // Free each block
+    for (b=((capecMemPool *) P)->head; b!=NULL; b=next) {
+        next = b->next;
+        capec_DelAligned(b);
+    }
+    free(P);
+}
+
+// Create key once per process
+static void
+capec_PoolKeyInit(void)
+{
+    capec_PoolKeyErr = pthread_key_create(&capec_PoolKey, capec_PoolFree);
+}
+
+// Get pool of calling thread, creating it if needed
+static capecMemPool *
+capec_PoolGet(void)
+{
+    capecMemPool *P;
+    
+    // Create key
+    if (pthread_once(&capec_PoolOnce, capec_PoolKeyInit) ||
+            capec_PoolKeyErr)
+        return NULL;
+    // Check for existing pool
+    P = (capecMemPool *) pthread_getspecific(capec_PoolKey);
+    if (P != NULL)
+        return P;
+    // New empty pool
+    P = (capecMemPool *) calloc(1, sizeof(capecMemPool));
+    if (P != NULL && pthread_setspecific(capec_PoolKey, P)) {
+        free(P);
+        P = NULL;
+    }
+    return P;
+}
+
+// Get block with at least *n* usable bytes
+static capecMemBlock *
+capec_BlockNew(size_t n)
+{
+    size_t size;
+    capecMemBlock *b, **pb, **pbest;
+    capecMemPool *P;
+    
+    // Best fit among kept blocks
+    P = capec_PoolGet();
+    pbest = NULL;
+    for (pb=(P ? &P->head : NULL); pb!=NULL && *pb!=NULL; pb=&(*pb)->next) {
+        if ((*pb)->size < n)
+            continue;
+        if (pbest == NULL || (*pb)->size < (*pbest)->size)
+            pbest = pb;
+    }
+    if (pbest != NULL) {
+        // Remove from pool
+        b = *pbest;
+        *pbest = b->next;
+        P->nbyte -= b->size;
+        P->nblock--;
+    } else {
+        // Round up to power of two so that blocks are easy to reuse
+        for (size=capeMEM_BLOCKSIZE; size < n && size <= SIZE_MAX/2; )
+            size *= 2;
+        if (size < n)
+            size = n;
+        if (size > SIZE_MAX - capeMEM_ALIGN ||
+                capec_NewAligned((void **) &b, size + capeMEM_ALIGN, 1))
+            return NULL;
+        b->size = size;
+    }
+    b->next = NULL;
+    b->used = 0;
+    return b;
+}
+
+// Return block to pool of calling thread
+static void
+capec_BlockDel(capecMemBlock *b)
+{
+    capecMemBlock **pb, **plast;
+    capecMemPool *P;
+    
+    // Free blocks that are too large to keep
+    P = capec_PoolGet();
+    if (P == NULL || b->size > capeMEM_POOLMAX) {
+        capec_DelAligned(b);
+        return;
+    }
+    // Add to front of pool
+    b->next = P->head;
+    P->head = b;
+    P->nbyte += b->size;
+    P->nblock++;
+    // Free least recently returned blocks to stay within limits
+    while (P->nblock > capeMEM_POOLNUM || P->nbyte > capeMEM_POOLMAX) {
+        for (pb=&P->head, plast=pb; *pb!=NULL; pb=&(*pb)->next)
+            plast = pb;
+        b = *plast;
+        *plast = NULL;
+        P->nbyte -= b->size;
+        P->nblock--;
+        capec_DelAligned(b);
+    }
+}
+
+// Get buffer from pool
+void *
+capec_PoolNew(size_t n)
+{
+    capecMemBlock *b;
+    
+    b = capec_BlockNew(n);
+    return (b == NULL) ? NULL : (void *) capec_BlockData(b);
+}
+
+// Return buffer to pool
+void
+capec_PoolDel(void *A)
+{
+    // Check already freed
+    if (A == NULL)
+        return;
+    capec_BlockDel((capecMemBlock *) ((char *) A - capeMEM_ALIGN));
+}
+
+// Free buffers kept by calling thread
+void
+capec_PoolClear(void)
+{
+    capecMemBlock *b, *next;
+    capecMemPool *P;
+    
+    P = capec_PoolGet();
+    if (P == NULL)
+        return;
+    for (b=P->head; b!=NULL; b=next) {
+        next = b->next;
+        capec_DelAligned(b);
+    }
+    P->head = NULL;
+    P->nbyte = 0;
+    P->nblock = 0;
+}
+
+
+// ======================================================================
+// ARENA
+// ======================================================================
+
+// Allocate from arena
+void *
+capec_ArenaNew(capecArena *a, size_t n, size_t size)
+{
+    size_t nb;
+    char *p;
+    capecMemBlock *b;
+    
+    // Check for overflow
+    if (size > 0 && n > (SIZE_MAX - capeMEM_ALIGN) / size)
+        return NULL;
+    // Round up so next allocation stays aligned (at least one byte)
+    nb = (n*size + capeMEM_ALIGN - 1) / capeMEM_ALIGN * capeMEM_ALIGN;
+    nb = (nb == 0) ? capeMEM_ALIGN : nb;
+    // Start new block if current one is full
+    b = a->head;
+    if (b == NULL || b->size - b->used < nb) {
+        b = capec_BlockNew((nb > a->blocksize) ? nb : a->blocksize);
+        if (b == NULL)
+            return NULL;
+        b->next = a->head;
+        a->head = b;
+    }
+    // Bump allocation
+    p = capec_BlockData(b) + b->used;
+    b->used += nb;
+    return (void *) p;
+}
+
+// Release all arena allocations
+void
+capec_ArenaDel(capecArena *a)
+{
+    capecMemBlock *b, *next;
+    
+    for (b=a->head; b!=NULL; b=next) {
+        next = b->next;
+        capec_BlockDel(b);
+    }
+    a->head = NULL;
+}
@@ -0,0 +1,562 @@
+#include <Python.h>
+
+#if PY_MINOR_VERSION >= 10
+    #define NPY_NO_DEPRECATED_API NPY_2_0_API_VERSION
+#else
+    #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#endif
+#define PY_ARRAY_UNIQUE_SYMBOL _cape_ARRAY_API
+#define NO_IMPORT_ARRAY
+#include <numpy/arrayobject.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <byteswap.h>
+
+// Local includes
+#include "capec_io.h"
+#include "capec_Swap.h"
+#include "capec_P3D.h"
+
+// Status codes for finding grids of binary files
+enum capeP3D_WALK {
+    capeP3D_WALK_OK,        // grids exactly fill file
+    capeP3D_WALK_EXTRA,     // all grids present, then extra bytes
+    capeP3D_WALK_HEADER,    // invalid header
+    capeP3D_WALK_EOF,       // file ended within a grid
+    capeP3D_WALK_MARKER,    // invalid record marker
+    capeP3D_WALK_MEM        // failed to allocate offsets
+};
+
+// Names of kinds of files
+const char *capeP3D_KINDS[capeP3D_NKIND] = {
+    "x",
+    "f",
+    "q"
+};
+
+// Descriptions of kinds of files for messages
+static const char *capeP3D_TITLES[capeP3D_NKIND] = {
+    "grid",
+    "function",
+    "OVERFLOW q"
+};
+
+// Binary formats tried when detecting layout, most checkable first
+static const char *capeP3D_FORMATS[] = {
+    "lr8", "lr4", "r8", "r4", "lb8", "lb4", "b8", "b4"
+};
+#define capeP3D_NFORMAT 8
+
+// Largest number of states or species in OVERFLOW q files
+#define capeP3D_NVARMAX (INT_MAX / 16)
+
+
+// ======================================================================
+// LAYOUT
+// ======================================================================
+
+// Set format from name
+int
+capec_P3DFormat(capecP3D *g, const char *fmt)
+{
+    int little = 0;
+    const char *p = fmt;
+    
+    // Defaults
+    g->record = 0;
+    g->swap = 0;
+    g->nf = 8;
+    // Byte order
+    if (*p == 'l') {
+        little = 1;
+        p++;
+    }
+    // Record markers or stream
+    if (*p == 'r') {
+        g->record = 1;
+    } else if (*p != 'b') {
+        return 1;
+    }
+    p++;
+    // Precision
+    if (*p == '4' || *p == '8') {
+        g->nf = *p - '0';
+    } else {
+        return 1;
+    }
+    // Check for extra characters
+    if (*(++p) != '\0') {
+        return 1;
+    }
+    // Swap if byte order is not native
+    g->swap = little ? !is_le() : is_le();
+    return 0;
+}
+
+// Get name of format
+void
+capec_P3DFormatName(const capecP3D *g, char *fmt)
+{
+    char *p = fmt;
+    
+    // Little-endian files are swapped on big-endian hosts and vice versa
+    if (g->swap != is_le()) {*(p++) = 'l'; }
+    *(p++) = g->record ? 'r' : 'b';
+    *(p++) = (char) ('0' + g->nf);
+    *p = '\0';
+}
+
+// Dimensions per grid
+int
+capec_P3DNDim(const capecP3D *g)
+{
+    return (g->kind == capeP3D_F) ? 4 : 3;
+}
+
+// Points in one grid
+size_t
+capec_P3DNPoint(const capecP3D *g, long i)
+{
+    const int *d = g->dims + capec_P3DNDim(g)*i;
+    
+    return (size_t) d[0] * (size_t) d[1] * (size_t) d[2];
+}
+
+// Values at each point
+int
+capec_P3DNVar(const capecP3D *g, long i)
+{
+    if (g->kind == capeP3D_F) {
+        return g->dims[4*i + 3];
+    } else if (g->kind == capeP3D_Q) {
+        return g->nq + g->nqc;
+    }
+    return 3;
+}
+
+// Values in OVERFLOW q header
+int
+capec_P3DNHead(const capecP3D *g)
+{
+    if (g->kind != capeP3D_Q) {
+        return 0;
+    }
+    return capeP3D_NQHEAD + 3 + ((g->nqc > 2) ? g->nqc : 2);
+}
+
+// Allocate dimensions and offsets
+int
+capec_P3DAlloc(capecP3D *g)
+{
+    size_t n = (size_t) g->ngrid;
+    
+    g->dims = (int *) malloc(n * capec_P3DNDim(g) * sizeof(int));
+    g->offset = (size_t *) malloc(n * sizeof(size_t));
+    g->hoffset = (size_t *) calloc(n, sizeof(size_t));
+    if (g->dims == NULL || g->offset == NULL || g->hoffset == NULL) {
+        capec_P3DFree(g);
+        return 1;
+    }
+    return 0;
+}
+
+// Release dimensions and offsets
+void
+capec_P3DFree(capecP3D *g)
+{
+    free(g->dims);
+    free(g->offset);
+    free(g->hoffset);
+    g->dims = NULL;
+    g->offset = NULL;
+    g->hoffset = NULL;
+}
+
+
+// ======================================================================
+// BINARY
+// ======================================================================
+
+// Read one 4-byte int from file; -1 if past end
+static long
+capec_P3DInt(const char *data, size_t size, size_t i, int swap)
+{
+    unsigned u;
+    
+    // Check for room
+    if (i + 4 > size) {
+        return -1;
+    }
+    // Read and swap
+    memcpy(&u, data + i, 4);
+    if (swap) {u = __bswap_32(u); }
+    return (long) u;
+}
+
+// Check leading and trailing markers of record of *nb* bytes at *i*
+static int
+capec_P3DMarkers(const char *data, size_t size, size_t i, size_t nb,
+    int swap)
+{
+    long r;
+    
+    r = capec_P3DInt(data, size, i, swap);
+    if (r < 0 || (size_t) r != nb) {
+        return 1;
+    }
+    r = capec_P3DInt(data, size, i + 4 + nb, swap);
+    return (r < 0 || (size_t) r != nb);
+}
+
+// Find offset of each grid for format already set in *g*
+static int
+capec_P3DWalk(const char *data, size_t size, capecP3D *g, long *kerr)
+{
+    int ndim, nvar;
+    long j, k, nd, r;
+    size_t i, nb, nm, npt;
+    
+    // Bytes for leading marker
+    nm = g->record ? 4 : 0;
+    *kerr = -1;
+    i = 0;
+    // Number of grids
+    g->ngrid = 1;
+    if (g->multi) {
+        if (g->record && capec_P3DMarkers(data, size, 0, 4, g->swap)) {
+            return capeP3D_WALK_HEADER;
+        }
+        r = capec_P3DInt(data, size, nm, g->swap);
+        if (r < 1 || r > INT_MAX) {
+            return capeP3D_WALK_HEADER;
+        }
+        g->ngrid = r;
+        i = 4 + 2*nm;
+    }
+    // Number of values in dimensions record
+    ndim = capec_P3DNDim(g);
+    nd = ndim*g->ngrid + ((g->kind == capeP3D_Q) ? 2 : 0);
+    // Check for room (also limits *ngrid* by file size)
+    if ((size_t) g->ngrid > size / 4 || i + 4*nd + 2*nm > size) {
+        return capeP3D_WALK_HEADER;
+    }
+    if (g->record && capec_P3DMarkers(data, size, i, 4*nd, g->swap)) {
+        return capeP3D_WALK_HEADER;
+    }
+    i += nm;
+    // Save dimensions
+    if (capec_P3DAlloc(g)) {
+        return capeP3D_WALK_MEM;
+    }
+    for (j=0; j<ndim*g->ngrid; j++) {
+        r = capec_P3DInt(data, size, i + 4*j, g->swap);
+        if (r < 1 || r > INT_MAX) {
+            return capeP3D_WALK_HEADER;
+        }
+        g->dims[j] = (int) r;
+    }
+    // Number of states and species of OVERFLOW files
+    if (g->kind == capeP3D_Q) {
+        r = capec_P3DInt(data, size, i + 4*j, g->swap);
+        if (r < 1 || r > capeP3D_NVARMAX) {
+            return capeP3D_WALK_HEADER;
+        }
+        g->nq = (int) r;
+        r = capec_P3DInt(data, size, i + 4*j + 4, g->swap);
+        if (r < 0 || r > capeP3D_NVARMAX) {
+            return capeP3D_WALK_HEADER;
+        }
+        g->nqc = (int) r;
+    }
+    i += 4*nd + nm;
+    
+    // Loop through grids
+    for (k=0; k<g->ngrid; k++) {
+        *kerr = k;
+        // Per-grid header of OVERFLOW files (one of the values is an int)
+        if (g->kind == capeP3D_Q) {
+            nb = (size_t) (capec_P3DNHead(g) - 1) * g->nf + 4;
+            if (i + nb + 2*nm > size) {
+                return capeP3D_WALK_EOF;
+            }
+            if (g->record && capec_P3DMarkers(data, size, i, nb, g->swap)) {
+                return capeP3D_WALK_MARKER;
+            }
+            g->hoffset[k] = i + nm;
+            i += nb + 2*nm;
+        }
+        // Points and values per point, checking size before multiplying
+        nvar = capec_P3DNVar(g, k);
+        npt = (size_t) g->dims[ndim*k] * (size_t) g->dims[ndim*k + 1];
+        if (npt > size || (size_t) g->dims[ndim*k + 2] > size / npt) {
+            return capeP3D_WALK_EOF;
+        }
+        npt *= (size_t) g->dims[ndim*k + 2];
+        if (npt > size / nvar) {
+            return capeP3D_WALK_EOF;
+        }
+        nb = npt * ((size_t) nvar * g->nf + (g->iblank ? 4 : 0));
+        // Check for room
+        if (nb > size || i + nb + 2*nm > size) {
+            return capeP3D_WALK_EOF;
+        }
+        // Check record markers
+        if (g->record && capec_P3DMarkers(data, size, i, nb, g->swap)) {
+            return capeP3D_WALK_MARKER;
+        }
+        // Save start of data
+        g->offset[k] = i + nm;
+        i += nb + 2*nm;
+    }
+    // Check for data after last grid
+    return (i == size) ? capeP3D_WALK_OK : capeP3D_WALK_EXTRA;
+}
+
+// Try single/multiple-grid and IBLANK layouts for one format
+static int
+capec_P3DWalkAll(const char *data, size_t size, capecP3D *g, long *kerr)
+{
+    int ierr, ierr0, multi0, iblank0;
+    long k;
+    
+    // Result to report if no layout exactly fills the file
+    ierr0 = capeP3D_WALK_HEADER;
+    multi0 = 1;
+    iblank0 = 0;
+    *kerr = -1;
+    for (g->multi=1; g->multi>=0; g->multi--) {
+        for (g->iblank=0; g->iblank<=(g->kind == capeP3D_X); g->iblank++) {
+            ierr = capec_P3DWalk(data, size, g, &k);
+            if (ierr == capeP3D_WALK_OK) {
+                return ierr;
+            }
+            capec_P3DFree(g);
+            if (ierr == capeP3D_WALK_MEM) {
+                return ierr;
+            }
+            // Prefer layouts with extra bytes, then any past the header
+            if ((ierr == capeP3D_WALK_EXTRA && ierr0 != ierr) ||
+                    (ierr != capeP3D_WALK_HEADER &&
+                    ierr0 == capeP3D_WALK_HEADER)) {
+                ierr0 = ierr;
+                multi0 = g->multi;
+                iblank0 = g->iblank;
+                *kerr = k;
+            }
+        }
+    }
+    // Find grids again for layout with extra bytes at end
+    g->multi = multi0;
+    g->iblank = iblank0;
+    if (ierr0 == capeP3D_WALK_EXTRA) {
+        return capec_P3DWalk(data, size, g, kerr);
+    }
+    return ierr0;
+}
+
+// Find grids of binary PLOT3D file
+int
+capec_ParseP3D(const char *data, size_t size, int kind, const char *fmt,
+    capecP3D *g)
+{
+    int j, ierr;
+    long k;
+    const char *title = capeP3D_TITLES[kind];
+    
+    // Initialize
+    memset(g, 0, sizeof(capecP3D));
+    g->kind = kind;
+    // Try each binary format if not specified
+    if (fmt == NULL) {
+        for (j=0; j<capeP3D_NFORMAT; j++) {
+            capec_P3DFormat(g, capeP3D_FORMATS[j]);
+            ierr = capec_P3DWalkAll(data, size, g, &k);
+            if (ierr == capeP3D_WALK_OK) {
+                return 0;
+            }
+            capec_P3DFree(g);
+            if (ierr == capeP3D_WALK_MEM) {
+                PyErr_NoMemory();
+                return 1;
+            }
+        }
+        // No binary layout (probably text)
+        memset(g, 0, sizeof(capecP3D));
+        g->kind = kind;
+        return 0;
+    }
+    // Interpret format
+    if (capec_P3DFormat(g, fmt)) {
+        PyErr_Format(PyExc_ValueError,
+            "Unrecognized PLOT3D format '%s'", fmt);
+        return 1;
+    }
+    // Find grids
+    ierr = capec_P3DWalkAll(data, size, g, &k);
+    if (ierr == capeP3D_WALK_OK || ierr == capeP3D_WALK_EXTRA) {
+        return 0;
+    } else if (ierr == capeP3D_WALK_HEADER) {
+        PyErr_Format(PyExc_ValueError,
+            "File does not start with a valid '%s' header for PLOT3D %s file",
+            fmt, title);
+    } else if (ierr == capeP3D_WALK_EOF) {
+        PyErr_Format(PyExc_ValueError,
+            "File ended before end of grid %li of PLOT3D %s file",
+            k + 1, title);
+    } else if (ierr == capeP3D_WALK_MARKER) {
+        PyErr_Format(PyExc_ValueError,
+            "Invalid record markers for grid %li of PLOT3D %s file",
+            k + 1, title);
+    } else {
+        PyErr_NoMemory();
+    }
+    capec_P3DFree(g);
+    return 1;
+}
+
+// Read one float from file
+static double
+capec_P3DFloat(const char *p, int nf, int swap)
+{
+    if (nf == 4) {
+        return (double) capec_GetF4(p, swap);
+    }
+    return capec_GetF8(p, swap);
+}
+
+// Convert OVERFLOW q header of one grid
+void
+capec_P3DQHeader(const capecP3D *g, const char *data, long i, double *h)
+{
+    int j, nh;
+    const char *p = data + g->hoffset[i];
+    
+    // Number of values
+    nh = capec_P3DNHead(g);
+    for (j=0; j<nh; j++) {
+        if (j == capeP3D_IGAMMA) {
+            // The only integer
+            h[j] = (double) (int) capec_P3DInt(p, 4, 0, g->swap);
+            p += 4;
+        } else {
+            h[j] = capec_P3DFloat(p, g->nf, g->swap);
+            p += g->nf;
+        }
+    }
+}
+
+
+// ======================================================================
+// WRITERS
+// ======================================================================
+
+// Write one float in format of layout
+static int
+capec_P3DWriteFloat(FILE *fid, double v, int nf, int swap)
+{
+    char b[8];
+    
+    if (nf == 4) {
+        capec_PutF4(b, (float) v, swap);
+        return fwrite(b, 4, 1, fid) != 1;
+    }
+    capec_PutF8(b, v, swap);
+    return fwrite(b, 8, 1, fid) != 1;
+}
+
+// Write OVERFLOW q header of one grid
+static int
+capec_P3DWriteQHeader(FILE *fid, const capecP3D *g, const double *h)
+{
+    int j, nh, nb, ierr;
+    
+    // Size of record
+    nh = capec_P3DNHead(g);
+    nb = (nh - 1)*g->nf + 4;
+    ierr = g->record && capec_WriteMarker(fid, nb, g->swap);
+    for (j=0; j<nh && !ierr; j++) {
+        if (j == capeP3D_IGAMMA) {
+            ierr = capec_WriteMarker(fid, (int) h[j], g->swap);
+        } else {
+            ierr = capec_P3DWriteFloat(fid, h[j], g->nf, g->swap);
+        }
+    }
+    return ierr || (g->record && capec_WriteMarker(fid, nb, g->swap));
+}
+
+// Write PLOT3D file
+int
+capec_WriteP3D(FILE *fid, const capecP3D *g, PyArrayObject **G,
+    PyArrayObject **B, const double *h, long *i)
+{
+    int ierr, ndim, nh, rtype;
+    long j, nd;
+    size_t npt, nb;
+    
+    // Header
+    *i = -1;
+    ndim = capec_P3DNDim(g);
+    nd = ndim*g->ngrid + ((g->kind == capeP3D_Q) ? 2 : 0);
+    ierr = 0;
+    if (g->multi) {
+        ierr = g->record && capec_WriteMarker(fid, 4, g->swap);
+        ierr = ierr || capec_WriteMarker(fid, (int) g->ngrid, g->swap);
+        ierr = ierr || (g->record && capec_WriteMarker(fid, 4, g->swap));
+    }
+    ierr = ierr || (g->record && capec_WriteMarker(fid, 4*nd, g->swap));
+    for (j=0; j<ndim*g->ngrid && !ierr; j++) {
+        ierr = capec_WriteMarker(fid, g->dims[j], g->swap);
+    }
+    if (g->kind == capeP3D_Q) {
+        ierr = ierr || capec_WriteMarker(fid, g->nq, g->swap);
+        ierr = ierr || capec_WriteMarker(fid, g->nqc, g->swap);
+    }
+    ierr = ierr || (g->record && capec_WriteMarker(fid, 4*nd, g->swap));
+    if (ierr) {
+        return capeIO_ERR_WRITE;
+    }
+    // Output type
+    rtype = (g->nf == 4) ? capeREC_F4 : capeREC_F8;
+    nh = capec_P3DNHead(g);
+    
+    // Loop through grids
+    for (*i=0; *i<g->ngrid; (*i)++) {
+        // OVERFLOW header
+        if (g->kind == capeP3D_Q &&
+                capec_P3DWriteQHeader(fid, g, h + nh*(*i))) {
+            return capeIO_ERR_WRITE;
+        }
+        // Check size
+        npt = capec_P3DNPoint(g, *i);
+        if ((size_t) PyArray_SIZE(G[*i]) != npt*capec_P3DNVar(g, *i) ||
+                (g->iblank && (size_t) PyArray_SIZE(B[*i]) != npt)) {
+            return capeIO_ERR_SHAPE;
+        }
+        // Size of record
+        nb = npt * ((size_t) capec_P3DNVar(g, *i)*g->nf +
+            (g->iblank ? 4 : 0));
+        if (g->record && nb > INT_MAX) {
+            return capeIO_ERR_SHAPE;
+        }
+        // Write values, then IBLANKs, all in one record
+        ierr = g->record && capec_WriteMarker(fid, (int) nb, g->swap);
+        if (ierr) {
+            return capeIO_ERR_WRITE;
+        }
+        ierr = capec_WriteStream(fid, G[*i], PyArray_NDIM(G[*i]), rtype,
+            g->swap);
+        if (!ierr && g->iblank) {
+            ierr = capec_WriteStream(fid, B[*i], PyArray_NDIM(B[*i]),
+                capeREC_I4, g->swap);
+        }
+        if (ierr) {
+            return ierr;
+        }
+        if (g->record && capec_WriteMarker(fid, (int) nb, g->swap)) {
+            return capeIO_ERR_WRITE;
+        }
+    }
+    return capeIO_OK;
+}
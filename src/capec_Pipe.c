@@ -0,0 +1,410 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/types.h>
+
+// Local includes
+#include "capec_Pipe.h"
+
+
+// State of pipelined stream
+typedef struct {
+    int fd;                 // file descriptor (owned)
+    int sync;               // what to do after last write
+    int nbuf;               // number of buffers in ring
+    size_t bufsize;         // size of each buffer
+    char **buf;             // buffers
+    size_t *nb;             // bytes in each full buffer
+    int ifill;              // buffer being filled by caller
+    size_t fill;            // bytes in that buffer
+    int iwrite;             // next buffer for helper thread to write
+    int nfull;              // buffers waiting for (or being) written
+    int closing;            // whether caller has finished
+    int ierr;               // sticky error flag of helper thread
+    off_t base;             // file offset when stream was opened
+    size_t total;           // bytes accepted from caller
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    pthread_t thread;
+} capecPipe;
+
+
+// ======================================================================
+// HELPER THREAD
+// ======================================================================
+
+// Write whole buffer to descriptor, retrying partial writes
+static int
+capec_PipeWriteFD(int fd, const char *buf, size_t n)
+{
+    ssize_t k;
+    
+    while (n > 0) {
+        k = write(fd, buf, n);
+        if (k < 0 && errno == EINTR) {
+            continue;
+        }
+        if (k <= 0) {
+            return 1;
+        }
+        buf += k;
+        n -= (size_t) k;
+    }
+    return 0;
+}
+
+// Write each full buffer in order until caller closes stream
+static void *
+capec_PipeMain(void *arg)
+{
+    int i, ierr;
+    capecPipe *p = (capecPipe *) arg;
+    
+    pthread_mutex_lock(&p->lock);
+    for (;;) {
+        // Wait for a full buffer
+        while (p->nfull == 0 && !p->closing) {
+            pthread_cond_wait(&p->cond, &p->lock);
+        }
+        if (p->nfull == 0) {
+            break;
+        }
+        // Write it without holding the lock (skip after first failure)
+        i = p->iwrite;
+        ierr = p->ierr;
+        pthread_mutex_unlock(&p->lock);
+        if (!ierr) {
+            ierr = capec_PipeWriteFD(p->fd, p->buf[i], p->nb[i]);
+        }
+        pthread_mutex_lock(&p->lock);
+        // Give buffer back to caller
+        p->ierr = ierr;
+        p->iwrite = (i + 1) % p->nbuf;
+        p->nfull--;
+        pthread_cond_broadcast(&p->cond);
+    }
+    pthread_mutex_unlock(&p->lock);
+    return NULL;
+}
+
+
+// ======================================================================
+// STREAM FUNCTIONS
+// ======================================================================
+
+// Pass current buffer to helper thread and wait for a free one
+static int
+capec_PipePush(capecPipe *p)
+{
+    int ierr;
+    
+    pthread_mutex_lock(&p->lock);
+    p->nb[p->ifill] = p->fill;
+    p->nfull++;
+    pthread_cond_broadcast(&p->cond);
+    // Next buffer in ring; wait until it has been written
+    p->ifill = (p->ifill + 1) % p->nbuf;
+    p->fill = 0;
+    while (p->nfull == p->nbuf) {
+        pthread_cond_wait(&p->cond, &p->lock);
+    }
+    ierr = p->ierr;
+    pthread_mutex_unlock(&p->lock);
+    return ierr;
+}
+
+// Copy output into buffers
+static ssize_t
+capec_PipeWrite(void *cookie, const char *data, size_t n)
+{
+    size_t k, m;
+    capecPipe *p = (capecPipe *) cookie;
+    
+    // Loop until all of *data* has been taken
+    for (m=n; m>0; ) {
+        k = p->bufsize - p->fill;
+        k = (m < k) ? m : k;
+        memcpy(p->buf[p->ifill] + p->fill, data, k);
+        p->fill += k;
+        data += k;
+        m -= k;
+        // Hand off full buffer
+        if (p->fill == p->bufsize && capec_PipePush(p)) {
+            return -1;
+        }
+    }
+    p->total += n;
+    return (ssize_t) n;
+}
+
+// Report position
+static off_t
+capec_PipeTell(void *cookie)
+{
+    capecPipe *p = (capecPipe *) cookie;
+    
+    return p->base + (off_t) p->total;
+}
+
+// Release buffers and state
+static void
+capec_PipeFree(capecPipe *p)
+{
+    int i;
+    
+    for (i=0; p->buf != NULL && i<p->nbuf; i++) {
+        free(p->buf[i]);
+    }
+    free(p->buf);
+    free(p->nb);
+    free(p);
+}
+
+// Write last buffer, wait for helper thread, sync, and close file
+static int
+capec_PipeClose(void *cookie)
+{
+    int ierr;
+    capecPipe *p = (capecPipe *) cookie;
+    
+    // Partial buffer
+    pthread_mutex_lock(&p->lock);
+    if (p->fill > 0) {
+        p->nb[p->ifill] = p->fill;
+        p->nfull++;
+    }
+    p->closing = 1;
+    pthread_cond_broadcast(&p->cond);
+    pthread_mutex_unlock(&p->lock);
+    // Wait for everything to be written
+    pthread_join(p->thread, NULL);
+    pthread_mutex_destroy(&p->lock);
+    pthread_cond_destroy(&p->cond);
+    ierr = p->ierr;
+    // Sync and close
+    ierr = ierr || capec_PipeSync(p->fd, p->sync);
+    ierr = close(p->fd) || ierr;
+    capec_PipeFree(p);
+    return ierr;
+}
+
+
+// ======================================================================
+// CUSTOM STREAMS
+// ======================================================================
+
+// Functions of a custom stream
+typedef struct {
+    void *cookie;
+    capecPipeWriteFunc write;
+    capecPipeTellFunc tell;
+    capecPipeCloseFunc close;
+} capecPipeCustom;
+
+// Write to custom stream
+static ssize_t
+capec_PipeCustomWrite(void *arg, const char *data, size_t n)
+{
+    capecPipeCustom *c = (capecPipeCustom *) arg;
+    
+    return c->write(c->cookie, data, n);
+}
+
+// Report position of custom stream (only for ftell())
+static int
+capec_PipeCustomSeek(void *arg, off_t *offset, int whence)
+{
+    capecPipeCustom *c = (capecPipeCustom *) arg;
+    
+    if (c->tell == NULL || whence != SEEK_CUR || *offset != 0) {
+        return -1;
+    }
+    *offset = c->tell(c->cookie);
+    return (*offset < 0) ? -1 : 0;
+}
+
+// Close custom stream
+static int
+capec_PipeCustomClose(void *arg)
+{
+    int ierr;
+    capecPipeCustom *c = (capecPipeCustom *) arg;
+    
+    ierr = c->close(c->cookie);
+    free(c);
+    return ierr ? EOF : 0;
+}
+
+#if defined(__APPLE__)
+// Wrappers for funopen()
+static int
+capec_PipeWriteBSD(void *arg, const char *data, int n)
+{
+    return (int) capec_PipeCustomWrite(arg, data, (size_t) n);
+}
+
+static fpos_t
+capec_PipeSeekBSD(void *arg, fpos_t offset, int whence)
+{
+    off_t o = (off_t) offset;
+    
+    if (capec_PipeCustomSeek(arg, &o, whence)) {
+        return -1;
+    }
+    return (fpos_t) o;
+}
+#elif defined(__GLIBC__)
+// Wrapper for fopencookie()
+static int
+capec_PipeSeekGNU(void *arg, off64_t *offset, int whence)
+{
+    int ierr;
+    off_t o = (off_t) *offset;
+    
+    ierr = capec_PipeCustomSeek(arg, &o, whence);
+    *offset = (off64_t) o;
+    return ierr ? -1 : 0;
+}
+#endif
+
+// Open write-only stream that calls custom functions
+FILE *
+capec_PipeCustomOpen(void *cookie, capecPipeWriteFunc w,
+    capecPipeTellFunc t, capecPipeCloseFunc c)
+{
+    FILE *fp = NULL;
+    capecPipeCustom *f;
+    
+    // Save functions
+    f = (capecPipeCustom *) malloc(sizeof(capecPipeCustom));
+    if (f == NULL) {
+        return NULL;
+    }
+    f->cookie = cookie;
+    f->write = w;
+    f->tell = t;
+    f->close = c;
+    // Create stream
+#if defined(__APPLE__)
+    fp = funopen(f, NULL, capec_PipeWriteBSD, capec_PipeSeekBSD,
+        capec_PipeCustomClose);
+#elif defined(__GLIBC__)
+    {
+        cookie_io_functions_t g;
+    
+        g.read = NULL;
+        g.write = capec_PipeCustomWrite;
+        g.seek = capec_PipeSeekGNU;
+        g.close = capec_PipeCustomClose;
+        fp = fopencookie(f, "w", g);
+    }
+#endif
+    if (fp == NULL) {
+        free(f);
+    }
+    return fp;
+}
+
+
+// ======================================================================
+// OPEN AND SYNC
+// ======================================================================
+
+// Open pipelined stream writing to a file descriptor
+FILE *
+capec_PipeOpen(int fd, const capecPipeOpts *o)
+{
+    int i;
+    FILE *fp;
+    capecPipe *p;
+    
+    // Check options
+    if (o->nbuf < 2 || o->bufsize == 0) {
+        return NULL;
+    }
+    // Allocate state and buffers
+    p = (capecPipe *) calloc(1, sizeof(capecPipe));
+    if (p == NULL) {
+        return NULL;
+    }
+    p->fd = fd;
+    p->sync = o->sync;
+    p->nbuf = o->nbuf;
+    p->bufsize = o->bufsize;
+    p->buf = (char **) calloc(p->nbuf, sizeof(char *));
+    p->nb = (size_t *) calloc(p->nbuf, sizeof(size_t));
+    for (i=0; p->buf != NULL && i<p->nbuf; i++) {
+        p->buf[i] = (char *) malloc(p->bufsize);
+        if (p->buf[i] == NULL) {
+            break;
+        }
+    }
+    if (p->nb == NULL || p->buf == NULL || i < p->nbuf) {
+        capec_PipeFree(p);
+        return NULL;
+    }
+    // Offset for ftell(); not available for pipes
+    p->base = lseek(fd, 0, SEEK_CUR);
+    if (p->base < 0) {
+        p->base = 0;
+    }
+    // Start helper thread
+    pthread_mutex_init(&p->lock, NULL);
+    pthread_cond_init(&p->cond, NULL);
+    if (pthread_create(&p->thread, NULL, capec_PipeMain, p)) {
+        pthread_mutex_destroy(&p->lock);
+        pthread_cond_destroy(&p->cond);
+        capec_PipeFree(p);
+        return NULL;
+    }
+    // Create stream; buffering is done by the ring
+    fp = capec_PipeCustomOpen(p, capec_PipeWrite, capec_PipeTell,
+        capec_PipeClose);
+    if (fp == NULL) {
+        // Stop helper thread without closing *fd*
+        pthread_mutex_lock(&p->lock);
+        p->closing = 1;
+        pthread_cond_broadcast(&p->cond);
+        pthread_mutex_unlock(&p->lock);
+        pthread_join(p->thread, NULL);
+        pthread_mutex_destroy(&p->lock);
+        pthread_cond_destroy(&p->cond);
+        capec_PipeFree(p);
+        return NULL;
+    }
+    setvbuf(fp, NULL, _IONBF, 0);
+    return fp;
+}
+
+// Sync file that has been completely written
+int
+capec_PipeSync(int fd, int sync)
+{
+    int ierr;
+    
+    // Check option
+    if (sync != capePIPE_FSYNC && sync != capePIPE_DONTNEED) {
+        return 0;
+    }
+    // Write back; pages must be clean before they can be dropped
+#if defined(__APPLE__)
+    ierr = fsync(fd);
+#else
+    ierr = (sync == capePIPE_FSYNC) ? fsync(fd) : fdatasync(fd);
+#endif
+    // Pipes and sockets can't be synced, which is not an error
+    if (ierr && errno != EINVAL && errno != EROFS) {
+        return 1;
+    }
+#ifdef POSIX_FADV_DONTNEED
+    if (sync == capePIPE_DONTNEED) {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    }
+#endif
+    return 0;
+}
@@ -0,0 +1,704 @@
+#include <Python.h>
+
+#if PY_MINOR_VERSION >= 10
+    #define NPY_NO_DEPRECATED_API NPY_2_0_API_VERSION
+#else
+    #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#endif
+#define PY_ARRAY_UNIQUE_SYMBOL _cape_ARRAY_API
+#define NO_IMPORT_ARRAY
+#include <numpy/arrayobject.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <byteswap.h>
+
+// Local includes
+#include "capec_io.h"
+#include "capec_Swap.h"
+#include "capec_Plt.h"
+
+// Number of points converted at a time between blocks and point arrays
+#define capePLT_CHUNK 512
+
+// Largest number of variables
+#define capePLT_NVARMAX (INT_MAX / 16)
+
+// Position while scanning a file
+typedef struct {
+    const char *data;       // contents of file
+    size_t size;            // size of file
+    size_t i;               // current offset
+    int swap;               // whether to byte-swap
+    int eof;                // whether a read went past end of file
+} capecPltCursor;
+
+
+// ======================================================================
+// SIZES
+// ======================================================================
+
+// Nodes per element
+int
+capec_PltNodesPerElem(int type)
+{
+    switch (type) {
+        case capePLT_FELINESEG:
+            return 2;
+        case capePLT_FETRIANGLE:
+            return 3;
+        case capePLT_FEQUADRILATERAL:
+        case capePLT_FETETRAHEDRON:
+            return 4;
+        case capePLT_FEBRICK:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+// Bytes per value
+int
+capec_PltFormatSize(int fmt)
+{
+    switch (fmt) {
+        case capePLT_FLOAT:
+        case capePLT_LONGINT:
+            return 4;
+        case capePLT_DOUBLE:
+            return 8;
+        case capePLT_SHORTINT:
+            return 2;
+        case capePLT_BYTE:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+
+// ======================================================================
+// SCANNING
+// ======================================================================
+
+// Read string (one 4-byte int per character)
+size_t
+capec_PltString(const char *data, size_t size, size_t i, int swap,
+    unsigned *s)
+{
+    unsigned u;
+    size_t n = 0;
+    
+    // Loop through characters until terminating zero
+    for (; i + 4 <= size; i += 4) {
+        memcpy(&u, data + i, 4);
+        if (swap) {u = __bswap_32(u); }
+        if (u == 0) {
+            return n;
+        }
+        if (s != NULL) {
+            s[n] = u;
+        }
+        n++;
+    }
+    // File ended first
+    return (size_t) -1;
+}
+
+// Read one 4-byte int
+static int
+capec_PltInt(capecPltCursor *c)
+{
+    unsigned u;
+    
+    // Check for room
+    if (c->i + 4 > c->size) {
+        c->eof = 1;
+        return 0;
+    }
+    // Read and swap
+    memcpy(&u, c->data + c->i, 4);
+    if (c->swap) {u = __bswap_32(u); }
+    c->i += 4;
+    return (int) u;
+}
+
+// Read one 4-byte float
+static float
+capec_PltFloat(capecPltCursor *c)
+{
+    float f;
+    
+    // Check for room
+    if (c->i + 4 > c->size) {
+        c->eof = 1;
+        return 0.0f;
+    }
+    // Read and swap
+    f = capec_GetF4(c->data + c->i, c->swap);
+    c->i += 4;
+    return f;
+}
+
+// Read one 8-byte float
+static double
+capec_PltDouble(capecPltCursor *c)
+{
+    double v;
+    
+    // Check for room
+    if (c->i + 8 > c->size) {
+        c->eof = 1;
+        return 0.0;
+    }
+    // Read and swap
+    v = capec_GetF8(c->data + c->i, c->swap);
+    c->i += 8;
+    return v;
+}
+
+// Skip string; return its offset
+static size_t
+capec_PltSkipString(capecPltCursor *c)
+{
+    size_t i0 = c->i;
+    size_t n;
+    
+    // Count characters
+    n = capec_PltString(c->data, c->size, c->i, c->swap, NULL);
+    if (n == (size_t) -1) {
+        c->eof = 1;
+        c->i = c->size;
+    } else {
+        c->i += 4*(n + 1);
+    }
+    return i0;
+}
+
+// Skip block of *n* items of *nb* bytes; return its offset
+static size_t
+capec_PltSkip(capecPltCursor *c, size_t n, size_t nb)
+{
+    size_t i0 = c->i;
+    
+    // Check for room without overflow
+    if (c->i > c->size || (nb > 0 && n > (c->size - c->i) / nb)) {
+        c->eof = 1;
+        c->i = c->size;
+    } else {
+        c->i += n*nb;
+    }
+    return i0;
+}
+
+// Read header of one zone (after marker)
+static int
+capec_PltZoneHeader(capecPltCursor *c, int nvar, long j, capecPltZone *z)
+{
+    int k, npt, nelem;
+    
+    // Name
+    memset(z, 0, sizeof(capecPltZone));
+    z->name = capec_PltSkipString(c);
+    z->parent = capec_PltInt(c);
+    z->strand = capec_PltInt(c);
+    z->time = capec_PltDouble(c);
+    // Unused (-1), then zone type
+    capec_PltInt(c);
+    z->type = capec_PltInt(c);
+    if (c->eof) {
+        return 0;
+    }
+    if (capec_PltNodesPerElem(z->type) == 0) {
+        PyErr_Format(PyExc_ValueError,
+            "Unsupported type %i of Tecplot zone %li; "
+            "only finite-element zones with fixed element size supported",
+            z->type, j + 1);
+        return 1;
+    }
+    // Variable locations
+    if (capec_PltInt(c)) {
+        for (k=0; k<nvar; k++) {
+            if (capec_PltInt(c) && !c->eof) {
+                PyErr_Format(PyExc_ValueError,
+                    "Cell-centered variable %i of Tecplot zone %li "
+                    "not supported", k + 1, j + 1);
+                return 1;
+            }
+        }
+    }
+    // Raw local face neighbors, then user-defined face neighbors
+    capec_PltInt(c);
+    if (capec_PltInt(c) && !c->eof) {
+        PyErr_Format(PyExc_ValueError,
+            "Face neighbor connections of Tecplot zone %li not supported",
+            j + 1);
+        return 1;
+    }
+    // Sizes
+    npt = capec_PltInt(c);
+    nelem = capec_PltInt(c);
+    if (!c->eof && (npt < 0 || nelem < 0)) {
+        PyErr_Format(PyExc_ValueError,
+            "Invalid size of Tecplot zone %li", j + 1);
+        return 1;
+    }
+    z->npt = npt;
+    z->nelem = nelem;
+    // Cell dimensions (unused)
+    for (k=0; k<3; k++) {
+        capec_PltInt(c);
+    }
+    // Auxiliary name/value pairs
+    z->aux = c->i;
+    while (capec_PltInt(c) && !c->eof) {
+        capec_PltSkipString(c);
+        capec_PltInt(c);
+        capec_PltSkipString(c);
+        z->naux++;
+    }
+    return 0;
+}
+
+// Find blocks of data section of one zone (after marker)
+static int
+capec_PltZoneData(capecPltCursor *c, capecPlt *p, long j)
+{
+    int k, s, nvar = p->nvar;
+    int *fmt = p->fmt + j*nvar;
+    int *share = p->share + j*nvar;
+    size_t *offset = p->offset + j*nvar;
+    size_t *minmax = p->minmax + j*nvar;
+    capecPltZone *z = p->zones + j;
+    
+    // Format of each variable
+    for (k=0; k<nvar; k++) {
+        fmt[k] = capec_PltInt(c);
+        if (!c->eof && capec_PltFormatSize(fmt[k]) == 0) {
+            PyErr_Format(PyExc_ValueError,
+                "Unsupported format %i of variable %i of Tecplot zone %li",
+                fmt[k], k + 1, j + 1);
+            return 1;
+        }
+    }
+    // Passive variables (marked with -2 until blocks are found)
+    for (k=0; k<nvar; k++) {
+        share[k] = -1;
+    }
+    if (capec_PltInt(c)) {
+        for (k=0; k<nvar; k++) {
+            if (capec_PltInt(c)) {
+                share[k] = -2;
+            }
+        }
+    }
+    // Shared variables
+    if (capec_PltInt(c)) {
+        for (k=0; k<nvar; k++) {
+            s = capec_PltInt(c);
+            if (share[k] == -2 || s == -1 || c->eof) {
+                continue;
+            }
+            if (s < 0 || s >= j || p->zones[s].npt != z->npt) {
+                PyErr_Format(PyExc_ValueError,
+                    "Variable %i of Tecplot zone %li shared with "
+                    "invalid zone %i", k + 1, j + 1, s + 1);
+                return 1;
+            }
+            share[k] = s;
+        }
+    }
+    // Shared connectivity
+    z->zshare = capec_PltInt(c);
+    if (c->eof) {
+        return 0;
+    }
+    if (z->zshare != -1 && (z->zshare < 0 || z->zshare >= j ||
+            p->zones[z->zshare].type != z->type ||
+            p->zones[z->zshare].nelem != z->nelem)) {
+        PyErr_Format(PyExc_ValueError,
+            "Connectivity of Tecplot zone %li shared with invalid zone %i",
+            j + 1, z->zshare + 1);
+        return 1;
+    }
+    // Min/max of each variable with its own block
+    for (k=0; k<nvar; k++) {
+        if (share[k] == -1) {
+            minmax[k] = capec_PltSkip(c, 2, 8);
+        }
+    }
+    // Variable blocks
+    for (k=0; k<nvar; k++) {
+        s = share[k];
+        if (s == -2) {
+            // Passive
+            share[k] = -1;
+        } else if (s >= 0) {
+            // Resolve to block of earlier zone
+            fmt[k] = p->fmt[s*nvar + k];
+            offset[k] = p->offset[s*nvar + k];
+            minmax[k] = p->minmax[s*nvar + k];
+        } else {
+            offset[k] = capec_PltSkip(c, z->npt, capec_PltFormatSize(fmt[k]));
+        }
+    }
+    // Connectivity
+    if (z->zshare >= 0) {
+        z->conn = p->zones[z->zshare].conn;
+    } else {
+        z->conn = capec_PltSkip(c,
+            (size_t) z->nelem * capec_PltNodesPerElem(z->type), 4);
+    }
+    return 0;
+}
+
+// Find header and blocks of each zone
+int
+capec_ParsePlt(const char *data, size_t size, capecPlt *p)
+{
+    int nvar;
+    unsigned u;
+    long j, nmax = 0;
+    float m;
+    void *tmp;
+    capecPltCursor c;
+    
+    // Initialize
+    memset(p, 0, sizeof(capecPlt));
+    memset(&c, 0, sizeof(capecPltCursor));
+    c.data = data;
+    c.size = size;
+    // Magic string
+    if (size < 12 || memcmp(data, "#!TDV112", 8)) {
+        PyErr_SetString(PyExc_ValueError,
+            "File does not start with Tecplot '#!TDV112' header");
+        return 1;
+    }
+    // Byte order from integer 1
+    memcpy(&u, data + 8, 4);
+    if (u == 1) {
+        p->swap = 0;
+    } else if (__bswap_32(u) == 1) {
+        p->swap = 1;
+    } else {
+        PyErr_SetString(PyExc_ValueError,
+            "Invalid byte order check in Tecplot header");
+        return 1;
+    }
+    c.swap = p->swap;
+    c.i = 12;
+    // File type, title, and variable names
+    capec_PltInt(&c);
+    p->title = capec_PltSkipString(&c);
+    nvar = capec_PltInt(&c);
+    if (!c.eof && (nvar < 1 || nvar > capePLT_NVARMAX)) {
+        PyErr_Format(PyExc_ValueError,
+            "Invalid number of variables (%i) in Tecplot header", nvar);
+        return 1;
+    }
+    p->nvar = nvar;
+    p->vars = c.i;
+    for (j=0; j<nvar && !c.eof; j++) {
+        capec_PltSkipString(&c);
+    }
+    // Zone headers and auxiliary data
+    while (!c.eof) {
+        m = capec_PltFloat(&c);
+        if (c.eof) {
+            break;
+        } else if (m == capePLT_EOHMARKER) {
+            break;
+        } else if (m == capePLT_ZONEMARKER) {
+            // Grow list of zones
+            if (p->nzone == nmax) {
+                nmax = nmax ? 2*nmax : 16;
+                tmp = realloc(p->zones, nmax*sizeof(capecPltZone));
+                if (tmp == NULL) {
+                    capec_PltFree(p);
+                    PyErr_NoMemory();
+                    return 1;
+                }
+                p->zones = (capecPltZone *) tmp;
+            }
+            if (capec_PltZoneHeader(&c, nvar, p->nzone,
+                    p->zones + p->nzone)) {
+                capec_PltFree(p);
+                return 1;
+            }
+            p->nzone++;
+        } else if (m == capePLT_DATAAUXMARKER) {
+            // Name, format, value
+            capec_PltSkipString(&c);
+            capec_PltInt(&c);
+            capec_PltSkipString(&c);
+        } else if (m == capePLT_VARAUXMARKER) {
+            // Variable, name, format, value
+            capec_PltInt(&c);
+            capec_PltSkipString(&c);
+            capec_PltInt(&c);
+            capec_PltSkipString(&c);
+        } else {
+            PyErr_Format(PyExc_ValueError,
+                "Unsupported Tecplot header marker %.1f", (double) m);
+            capec_PltFree(p);
+            return 1;
+        }
+    }
+    if (c.eof) {
+        PyErr_SetString(PyExc_ValueError,
+            "File ended before end of Tecplot header");
+        capec_PltFree(p);
+        return 1;
+    }
+    // Allocate formats and offsets
+    if (p->nzone > 0) {
+        p->fmt = (int *) calloc(p->nzone*nvar, sizeof(int));
+        p->share = (int *) calloc(p->nzone*nvar, sizeof(int));
+        p->offset = (size_t *) calloc(p->nzone*nvar, sizeof(size_t));
+        p->minmax = (size_t *) calloc(p->nzone*nvar, sizeof(size_t));
+        if (!p->fmt || !p->share || !p->offset || !p->minmax) {
+            capec_PltFree(p);
+            PyErr_NoMemory();
+            return 1;
+        }
+    }
+    // Data section of each zone
+    for (j=0; j<p->nzone; j++) {
+        m = capec_PltFloat(&c);
+        if (!c.eof && m != capePLT_ZONEMARKER) {
+            PyErr_Format(PyExc_ValueError,
+                "Missing marker before data of Tecplot zone %li", j + 1);
+            capec_PltFree(p);
+            return 1;
+        }
+        if (capec_PltZoneData(&c, p, j)) {
+            capec_PltFree(p);
+            return 1;
+        }
+        if (c.eof) {
+            PyErr_Format(PyExc_ValueError,
+                "File ended before end of data of Tecplot zone %li", j + 1);
+            capec_PltFree(p);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Release zones and offsets
+void
+capec_PltFree(capecPlt *p)
+{
+    free(p->zones);
+    free(p->fmt);
+    free(p->share);
+    free(p->offset);
+    free(p->minmax);
+    p->zones = NULL;
+    p->fmt = NULL;
+    p->share = NULL;
+    p->offset = NULL;
+    p->minmax = NULL;
+    p->nzone = 0;
+}
+
+
+// ======================================================================
+// READ
+// ======================================================================
+
+// Check for any double variables in zone
+int
+capec_PltZoneIsDouble(const capecPlt *p, long j)
+{
+    int k;
+    
+    // Integer formats are exact as floats except for 4-byte ints
+    for (k=0; k<p->nvar; k++) {
+        if (p->offset[j*p->nvar + k] == 0) {
+            continue;
+        }
+        if (p->fmt[j*p->nvar + k] == capePLT_DOUBLE ||
+                p->fmt[j*p->nvar + k] == capePLT_LONGINT) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Convert *n* values of one variable block to doubles
+static void
+capec_PltConvert(const char *b, int fmt, int swap, int n, double *v)
+{
+    int i;
+    int l;
+    short h;
+    
+    switch (fmt) {
+        case capePLT_FLOAT:
+            for (i=0; i<n; i++) {
+                v[i] = capec_GetF4(b + 4*i, swap);
+            }
+            break;
+        case capePLT_DOUBLE:
+            for (i=0; i<n; i++) {
+                v[i] = capec_GetF8(b + 8*i, swap);
+            }
+            break;
+        case capePLT_LONGINT:
+            for (i=0; i<n; i++) {
+                memcpy(&l, b + 4*i, 4);
+                if (swap) {l = (int) __bswap_32((unsigned) l); }
+                v[i] = l;
+            }
+            break;
+        case capePLT_SHORTINT:
+            for (i=0; i<n; i++) {
+                memcpy(&h, b + 2*i, 2);
+                if (swap) {h = (short) __bswap_16((unsigned short) h); }
+                v[i] = h;
+            }
+            break;
+        default:
+            for (i=0; i<n; i++) {
+                v[i] = (unsigned char) b[i];
+            }
+            break;
+    }
+}
+
+// Convert variable blocks of one zone to point-by-variable array
+void
+capec_ReadPltZone(const capecPlt *p, const char *data, long j, void *q,
+    int fdouble, double *qminmax)
+{
+    int k, n, ii, nvar = p->nvar;
+    size_t i0, off, nb, npt = p->zones[j].npt;
+    double v[capePLT_CHUNK];
+    double *qd = (double *) q;
+    float *qf = (float *) q;
+    capecPltCursor c;
+    
+    // Min/max of each variable
+    memset(&c, 0, sizeof(capecPltCursor));
+    c.data = data;
+    c.size = (size_t) -1;
+    c.swap = p->swap;
+    for (k=0; k<nvar; k++) {
+        c.i = p->minmax[j*nvar + k];
+        if (c.i == 0) {
+            qminmax[2*k] = 0.0;
+            qminmax[2*k + 1] = 0.0;
+        } else {
+            qminmax[2*k] = capec_PltDouble(&c);
+            qminmax[2*k + 1] = capec_PltDouble(&c);
+        }
+    }
+    // Convert a chunk of points at a time so writes to *q* stay in cache
+    for (i0=0; i0<npt; i0 += capePLT_CHUNK) {
+        n = (npt - i0 < capePLT_CHUNK) ? (int) (npt - i0) : capePLT_CHUNK;
+        for (k=0; k<nvar; k++) {
+            off = p->offset[j*nvar + k];
+            if (off == 0) {
+                memset(v, 0, n*sizeof(double));
+            } else {
+                nb = capec_PltFormatSize(p->fmt[j*nvar + k]);
+                capec_PltConvert(data + off + i0*nb,
+                    p->fmt[j*nvar + k], p->swap, n, v);
+            }
+            // Scatter into rows of *q*
+            if (fdouble) {
+                for (ii=0; ii<n; ii++) {
+                    qd[(i0 + ii)*nvar + k] = v[ii];
+                }
+            } else {
+                for (ii=0; ii<n; ii++) {
+                    qf[(i0 + ii)*nvar + k] = (float) v[ii];
+                }
+            }
+        }
+    }
+}
+
+
+// ======================================================================
+// WRITE
+// ======================================================================
+
+// Write data section of one zone
+int
+capec_WritePltZone(FILE *fid, const double *q, size_t npt, int nvar,
+    const int *fmt, const int *conn, size_t nconn)
+{
+    int k, ierr;
+    int flags[3] = {0, 0, -1};
+    float m = capePLT_ZONEMARKER;
+    size_t i, i0, i1, nb = 0;
+    size_t *voff;
+    char *stage, *b;
+    double v, *qminmax;
+    float f;
+    
+    // Offset of each variable block in staging buffer
+    voff = (size_t *) malloc(nvar*sizeof(size_t));
+    qminmax = (double *) malloc(2*nvar*sizeof(double));
+    if (voff == NULL || qminmax == NULL) {
+        free(voff);
+        free(qminmax);
+        return capeIO_ERR_MEM;
+    }
+    for (k=0; k<nvar; k++) {
+        if (fmt[k] != capePLT_FLOAT && fmt[k] != capePLT_DOUBLE) {
+            free(voff);
+            free(qminmax);
+            return capeIO_ERR_SHAPE;
+        }
+        voff[k] = nb;
+        nb += npt*capec_PltFormatSize(fmt[k]);
+    }
+    stage = (char *) malloc(nb > 0 ? nb : 1);
+    if (stage == NULL) {
+        free(voff);
+        free(qminmax);
+        return capeIO_ERR_MEM;
+    }
+    // Initialize min/max
+    for (k=0; k<nvar; k++) {
+        qminmax[2*k] = (npt > 0) ? q[k] : 0.0;
+        qminmax[2*k + 1] = qminmax[2*k];
+    }
+    // Convert chunks of points, updating min/max in same pass
+    for (i0=0; i0<npt; i0 += capePLT_CHUNK) {
+        i1 = (npt - i0 < capePLT_CHUNK) ? npt : i0 + capePLT_CHUNK;
+        for (k=0; k<nvar; k++) {
+            b = stage + voff[k];
+            for (i=i0; i<i1; i++) {
+                v = q[i*nvar + k];
+                if (v < qminmax[2*k]) {qminmax[2*k] = v; }
+                if (v > qminmax[2*k + 1]) {qminmax[2*k + 1] = v; }
+                if (fmt[k] == capePLT_DOUBLE) {
+                    memcpy(b + 8*i, &v, 8);
+                } else {
+                    f = (float) v;
+                    memcpy(b + 4*i, &f, 4);
+                }
+            }
+        }
+    }
+    // Write marker, formats, sharing flags, min/max, data, connectivity
+    ierr = capeIO_OK;
+    if (fwrite(&m, 4, 1, fid) != 1 ||
+            fwrite(fmt, 4, nvar, fid) != (size_t) nvar ||
+            fwrite(flags, 4, 3, fid) != 3 ||
+            fwrite(qminmax, 8, 2*nvar, fid) != (size_t) 2*nvar ||
+            fwrite(stage, 1, nb, fid) != nb ||
+            fwrite(conn, 4, nconn, fid) != nconn) {
+        ierr = capeIO_ERR_WRITE;
+    }
+    // Cleanup
+    free(voff);
+    free(qminmax);
+    free(stage);
+    return ierr;
+}
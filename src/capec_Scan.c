@@ -0,0 +1,414 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Local includes
+#include "capec_Memory.h"
+#include "capec_Scan.h"
+#include "capec_Stats.h"
+
+
+// Exact powers of ten representable as doubles
+static const double capeSCAN_P10[23] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+    1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+    1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// Exact powers of ten representable as singles
+static const float capeSCAN_P10F[11] = {
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+};
+
+// Largest integers that convert exactly
+#define capeSCAN_MAXEXACT   (1ULL << 53)
+#define capeSCAN_MAXEXACTF  (1ULL << 24)
+
+
+// ======================================================================
+// BUFFER
+// ======================================================================
+
+// Initialize buffer
+int
+capec_ScanBufInit(capecScanBuf *b, FILE *fid)
+{
+    // Save file handle
+    b->fid = fid;
+    b->n = 0;
+    b->i = 0;
+    b->eof = 0;
+    b->ierr = 0;
+    // Allocate buffer
+    b->buf = (char *) capec_PoolNew(capeSCAN_BUFSIZE);
+    // Check for errors
+    if (b->buf == NULL) {
+        b->size = 0;
+        b->ierr = 1;
+        return 1;
+    }
+    // Save size
+    b->size = capeSCAN_BUFSIZE;
+    // Normal output
+    return 0;
+}
+
+// Read more of the file, keeping unread bytes
+static int
+capec_ScanBufFill(capecScanBuf *b)
+{
+    size_t m;
+    char *buf;
+    
+    // Move unread portion to start of buffer
+    if (b->i > 0) {
+        memmove(b->buf, b->buf + b->i, b->n - b->i);
+        b->n -= b->i;
+        b->i = 0;
+    }
+    // Grow buffer if it's full (one line longer than buffer)
+    if (b->n + 1 >= b->size) {
+        buf = (char *) capec_PoolNew(2*b->size);
+        if (buf == NULL) {
+            b->ierr = 1;
+            return 1;
+        }
+        memcpy(buf, b->buf, b->n);
+        capec_PoolDel(b->buf);
+        b->buf = buf;
+        b->size *= 2;
+    }
+    // Read as much as will fit, leaving room for a terminator
+    m = fread(b->buf + b->n, 1, b->size - b->n - 1, b->fid);
+    b->n += m;
+    capec_StatAddBytes(capec_StatCurrent(), m);
+    // Check for end of file
+    if (m == 0) {
+        b->eof = 1;
+        if (ferror(b->fid)) {
+            b->ierr = 1;
+            return 1;
+        }
+    }
+    // Normal output
+    return 0;
+}
+
+// Get next line
+char *
+capec_ScanBufLine(capecScanBuf *b)
+{
+    char *line;
+    char *q;
+    
+    // Loop until a full line is available
+    while (b->ierr == 0) {
+        // Start of line
+        line = b->buf + b->i;
+        // Search for end of line
+        q = (char *) memchr(line, '\n', b->n - b->i);
+        // Check for complete line
+        if (q != NULL) {
+            *q = '\0';
+            b->i = (size_t) (q - b->buf) + 1;
+            return line;
+        }
+        // Check for end of file
+        if (b->eof) {
+            // Check for last line without newline
+            if (b->i < b->n) {
+                b->buf[b->n] = '\0';
+                b->i = b->n;
+                return line;
+            }
+            return NULL;
+        }
+        // Read more of the file
+        capec_ScanBufFill(b);
+    }
+    // Error occurred
+    return NULL;
+}
+
+// Free buffer
+void
+capec_ScanBufClose(capecScanBuf *b)
+{
+    // Return buffer to pool
+    capec_PoolDel(b->buf);
+    b->buf = NULL;
+    b->size = 0;
+    b->n = 0;
+    b->i = 0;
+}
+
+// Count data lines in block of text
+size_t
+capec_ScanCountBuf(const char *s, size_t n, int *state)
+{
+    size_t i;
+    size_t nline = 0;
+    int st = *state;
+    char c;
+    
+    // Loop through characters
+    for (i=0; i<n; i++) {
+        c = s[i];
+        // Check character
+        if (c == '\n') {
+            // Count line if it had data
+            if (st == 1) {
+                nline += 1;
+            }
+            st = 0;
+        } else if (st == 0 && !capeSCAN_IsSpace(c)) {
+            // First non-blank character
+            st = (c == '#') ? 2 : 1;
+        }
+    }
+    // Save state for next block
+    *state = st;
+    return nline;
+}
+
+// Count data lines in open file
+size_t
+capec_ScanCountLines(FILE *fp)
+{
+    // Line counts
+    size_t nline = 0;
+    // File position
+    long pos;
+    // Buffer
+    char buff[1 << 16];
+    size_t n;
+    // Line state: 0 for nothing yet, 1 for data, 2 for comment
+    int state = 0;
+    
+    // Remember current location
+    pos = ftell(fp);
+    
+    // Read blocks
+    while ((n = fread(buff, 1, sizeof(buff), fp)) > 0) {
+        nline += capec_ScanCountBuf(buff, n, &state);
+        capec_StatAddBytes(capec_StatCurrent(), n);
+    }
+    // Last line without newline
+    if (state == 1) {
+        nline += 1;
+    }
+    
+    // Return to original location
+    clearerr(fp);
+    fseek(fp, pos, SEEK_SET);
+    
+    // Output
+    return nline;
+}
+
+
+// ======================================================================
+// NUMBERS
+// ======================================================================
+
+// Split decimal number into digits and power of ten
+static int
+capec_ScanDecimal(const char *s, char **end, int *neg,
+    unsigned long long *u, int *e10, int *exact)
+{
+    const char *p = s;
+    const char *q;
+    int nd = 0;
+    int any = 0;
+    int ex, eneg;
+    unsigned d;
+    
+    // Initialize
+    *neg = 0;
+    *u = 0;
+    *e10 = 0;
+    *exact = 1;
+    // Sign
+    if (*p == '-') {
+        *neg = 1;
+        p++;
+    } else if (*p == '+') {
+        p++;
+    }
+    // Integer digits
+    while ((d = (unsigned) (*p - '0')) < 10) {
+        any = 1;
+        if (nd < 19) {
+            // Save digit (leading zeros are not significant)
+            *u = 10*(*u) + d;
+            if (*u) nd++;
+        } else {
+            // Too many digits to hold; keep magnitude
+            *e10 += 1;
+            if (d) *exact = 0;
+        }
+        p++;
+    }
+    // Fractional digits
+    if (*p == '.') {
+        p++;
+        while ((d = (unsigned) (*p - '0')) < 10) {
+            any = 1;
+            if (nd < 19) {
+                *u = 10*(*u) + d;
+                *e10 -= 1;
+                if (*u) nd++;
+            } else if (d) {
+                *exact = 0;
+            }
+            p++;
+        }
+    }
+    // Check for any digits (inf, nan, etc. handled elsewhere)
+    if (!any) {
+        *end = (char *) s;
+        return 1;
+    }
+    // Exponent
+    if (*p == 'e' || *p == 'E') {
+        q = p + 1;
+        eneg = 0;
+        if (*q == '-') {
+            eneg = 1;
+            q++;
+        } else if (*q == '+') {
+            q++;
+        }
+        // Must have at least one digit to be part of the number
+        if ((unsigned) (*q - '0') < 10) {
+            ex = 0;
+            while ((d = (unsigned) (*q - '0')) < 10) {
+                if (ex < 100000) ex = 10*ex + (int) d;
+                q++;
+            }
+            *e10 += eneg ? -ex : ex;
+            p = q;
+        }
+    }
+    // Output
+    *end = (char *) p;
+    return 0;
+}
+
+// Parse double
+int
+capec_ScanF64(const char *s, char **end, double *v)
+{
+    unsigned long long u;
+    int neg, e10, exact;
+    double x;
+    
+    // Split into digits and exponent
+    if (capec_ScanDecimal(s, end, &neg, &u, &e10, &exact) == 0 &&
+            exact && u <= capeSCAN_MAXEXACT && e10 >= -22 && e10 <= 22) {
+        // Single rounding, so same result as strtod()
+        x = (double) u;
+        x = (e10 < 0) ? x / capeSCAN_P10[-e10] : x * capeSCAN_P10[e10];
+        *v = neg ? -x : x;
+        return 0;
+    }
+    // Long, extreme, or special values
+    *v = strtod(s, end);
+    return (*end == s);
+}
+
+// Parse single
+int
+capec_ScanF32(const char *s, char **end, float *v)
+{
+    unsigned long long u;
+    int neg, e10, exact;
+    float x;
+    
+    // Split into digits and exponent
+    if (capec_ScanDecimal(s, end, &neg, &u, &e10, &exact) == 0 &&
+            exact && u <= capeSCAN_MAXEXACTF && e10 >= -10 && e10 <= 10) {
+        // Single rounding in single precision
+        x = (float) u;
+        x = (e10 < 0) ? x / capeSCAN_P10F[-e10] : x * capeSCAN_P10F[e10];
+        *v = neg ? -x : x;
+        return 0;
+    }
+    // Other values
+    *v = strtof(s, end);
+    return (*end == s);
+}
+
+// Parse unsigned digits
+static int
+capec_ScanDigits(const char *s, char **end, unsigned long long *v)
+{
+    const char *p = s;
+    unsigned long long u = 0;
+    unsigned d;
+    int ierr = 0;
+    
+    // Loop through digits
+    while ((d = (unsigned) (*p - '0')) < 10) {
+        // Check for overflow
+        if (u > (~0ULL - d) / 10) {
+            ierr = 2;
+        }
+        u = 10*u + d;
+        p++;
+    }
+    // Output
+    *end = (char *) p;
+    *v = u;
+    return (p == s) ? 1 : ierr;
+}
+
+// Parse signed integer
+int
+capec_ScanI64(const char *s, char **end, long long *v)
+{
+    const char *p = s;
+    unsigned long long u;
+    int neg = 0;
+    int ierr;
+    
+    // Sign
+    if (*p == '-') {
+        neg = 1;
+        p++;
+    } else if (*p == '+') {
+        p++;
+    }
+    // Digits
+    ierr = capec_ScanDigits(p, end, &u);
+    if (ierr == 1) {
+        *end = (char *) s;
+        return 1;
+    }
+    // Check range
+    if (u > (neg ? (1ULL << 63) : (1ULL << 63) - 1)) {
+        ierr = 2;
+    }
+    // Output
+    *v = neg ? (long long) (0ULL - u) : (long long) u;
+    return ierr;
+}
+
+// Parse unsigned integer
+int
+capec_ScanU64(const char *s, char **end, unsigned long long *v)
+{
+    const char *p = s;
+    int ierr;
+    
+    // Optional plus sign
+    if (*p == '+') {
+        p++;
+    }
+    // Digits
+    ierr = capec_ScanDigits(p, end, v);
+    if (ierr == 1) {
+        *end = (char *) s;
+    }
+    return ierr;
+}
@@ -0,0 +1,464 @@
+#include <Python.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+// Local includes
+#include "capec_Sink.h"
+#include "capec_Stats.h"
+#include "capec_Zip.h"
+
+
+// Pipelining options for file targets
+static capecPipeOpts capec_SinkPipe = {0, capePIPE_BUFSIZE, capePIPE_NOSYNC};
+
+// Set pipelining and sync options for later file targets
+void
+capec_SinkSetPipe(const capecPipeOpts *o)
+{
+    capec_SinkPipe = *o;
+}
+
+// Open stream on a file descriptor, pipelined if requested
+static FILE *
+capec_SinkStream(capecSink *s, int fd, const char *mode)
+{
+    FILE *fp = NULL;
+    
+    // What to do on close
+    s->sync = capec_SinkPipe.sync;
+    // Try pipelined stream first
+    if (capec_SinkPipe.nbuf >= 2)
+        fp = capec_PipeOpen(fd, &capec_SinkPipe);
+    if (fp != NULL) {
+        s->piped = 1;
+        return fp;
+    }
+    // Ordinary stream
+    return fdopen(fd, mode);
+}
+
+// Open stream on a copy of a file descriptor
+static int
+capec_SinkOpenFD(capecSink *s, int fd)
+{
+    // Use a copy of the descriptor so fclose() doesn't close the original
+    fd = dup(fd);
+    if (fd == -1) {
+        PyErr_SetFromErrno(PyExc_IOError);
+        return 1;
+    }
+    // Go to current position of Python file
+    if (s->pos >= 0 && lseek(fd, (off_t) s->pos, SEEK_SET) < 0) {
+        close(fd);
+        PyErr_SetFromErrno(PyExc_IOError);
+        return 1;
+    }
+    // Open it
+    s->fp = capec_SinkStream(s, fd, "wb");
+    if (s->fp == NULL) {
+        close(fd);
+        PyErr_SetFromErrno(PyExc_IOError);
+        return 1;
+    }
+    return 0;
+}
+
+// Open stream that collects output in memory
+static int
+capec_SinkOpenMem(capecSink *s)
+{
+    // Growing buffer managed by C library
+    s->fp = open_memstream(&s->buf, &s->size);
+    if (s->fp == NULL) {
+        PyErr_NoMemory();
+        return 1;
+    }
+    return 0;
+}
+
+// Open stream for a file name
+static int
+capec_SinkOpenPath(capecSink *s, const char *fname, const char *mode)
+{
+    int fd;
+    int codec;
+    FILE *fp;
+    
+    // Save name for messages
+    s->kind = capeSINK_PATH;
+    s->name = fname;
+    // Check for compressed output
+    codec = capec_ZipCodec(fname);
+    if (!capec_ZipAvailable(codec)) {
+        PyErr_Format(PyExc_NotImplementedError,
+            "Cannot write '%s'; %s compression is not available in this "
+            "build", fname, capec_ZipName(codec));
+        return 1;
+    }
+    // Open file
+    if (capec_SinkPipe.nbuf >= 2 || capec_SinkPipe.sync) {
+        // Descriptor with same meaning as *mode*
+        fd = open(fname, O_WRONLY | O_CREAT |
+            ((mode[0] == 'a') ? O_APPEND : O_TRUNC), 0666);
+        s->fp = (fd < 0) ? NULL : capec_SinkStream(s, fd, mode);
+        if (fd >= 0 && s->fp == NULL)
+            close(fd);
+    } else {
+        s->fp = fopen(fname, mode);
+    }
+    if (s->fp == NULL) {
+        PyErr_Format(PyExc_IOError,
+            "Could not open file '%s' for writing", fname);
+        return 1;
+    }
+    // Compress on the way to the file (appending adds a new member)
+    if (codec != capeZIP_NONE) {
+        fp = capec_ZipOpen(s->fp, codec, s->piped ? capePIPE_NOSYNC :
+            s->sync);
+        if (fp == NULL) {
+            fclose(s->fp);
+            s->fp = NULL;
+            PyErr_Format(PyExc_IOError,
+                "Could not start %s compression for '%s'",
+                capec_ZipName(codec), fname);
+            return 1;
+        }
+        s->fp = fp;
+        s->zip = 1;
+    }
+    return 0;
+}
+
+// Open stream for any kind of output target
+static int
+capec_SinkOpenTarget(capecSink *s, PyObject *target, const char *fdefault,
+    const char *mode)
+{
+    int fd;
+    PyObject *t;
+    
+    // Initialize
+    memset(s, 0, sizeof(capecSink));
+    s->target = target;
+    s->pos = -1;
+    // Default file name
+    if (target == NULL || target == Py_None) {
+        return capec_SinkOpenPath(s, fdefault, mode);
+    }
+    // File names
+    if (PyUnicode_Check(target) || PyBytes_Check(target) ||
+            PyObject_HasAttrString(target, "__fspath__")) {
+        // Convert to file system encoding
+        if (!PyUnicode_FSConverter(target, &s->path)) {
+            return 1;
+        }
+        return capec_SinkOpenPath(s, PyBytes_AS_STRING(s->path), mode);
+    }
+    // File descriptor
+    if (PyLong_Check(target)) {
+        s->kind = capeSINK_FD;
+        s->name = "file descriptor";
+        fd = PyObject_AsFileDescriptor(target);
+        if (fd == -1) {
+            return 1;
+        }
+        return capec_SinkOpenFD(s, fd);
+    }
+    // In-memory targets
+    if (PyByteArray_Check(target)) {
+        s->kind = capeSINK_BYTEARRAY;
+        s->name = "bytearray";
+        return capec_SinkOpenMem(s);
+    } else if (PyObject_CheckBuffer(target)) {
+        s->kind = capeSINK_BUFFER;
+        s->name = "buffer";
+        return capec_SinkOpenMem(s);
+    }
+    // Python file with a descriptor
+    if (PyObject_HasAttrString(target, "fileno")) {
+        // Write anything Python has buffered
+        t = PyObject_CallMethod(target, "flush", NULL);
+        if (t == NULL) {
+            return 1;
+        }
+        Py_DECREF(t);
+        // Get descriptor (fails for io.BytesIO, for example)
+        fd = PyObject_AsFileDescriptor(target);
+        if (fd >= 0) {
+            s->kind = capeSINK_PYFILE;
+            s->name = "output file";
+            // Get logical position; not available for pipes
+            t = PyObject_CallMethod(target, "tell", NULL);
+            if (t == NULL) {
+                PyErr_Clear();
+            } else {
+                s->pos = PyLong_AsLong(t);
+                Py_DECREF(t);
+                if (s->pos < 0) {
+                    PyErr_Clear();
+                    s->pos = -1;
+                }
+            }
+            // Open stream at that position
+            return capec_SinkOpenFD(s, fd);
+        }
+        PyErr_Clear();
+    }
+    // Any other object with write() method
+    if (PyObject_HasAttrString(target, "write")) {
+        s->kind = capeSINK_WRITE;
+        s->name = "output file";
+        return capec_SinkOpenMem(s);
+    }
+    // Unrecognized target
+    PyErr_SetString(PyExc_TypeError,
+        "Output must be a file name, file, file descriptor, or "
+        "writable buffer");
+    return 1;
+}
+
+// Open an output target
+int
+capec_SinkOpen(capecSink *s, PyObject *target, const char *fdefault,
+    const char *mode)
+{
+    int ierr;
+    
+    ierr = capec_SinkOpenTarget(s, target, fdefault, mode);
+    // Charge output to current function, even if written in background
+    s->stat = capec_StatCurrent();
+    s->start = (ierr || s->fp == NULL) ? -1 : ftell(s->fp);
+    return ierr;
+}
+
+// Close an output target, copying in-memory output to it
+int
+capec_SinkClose(capecSink *s, int ierr)
+{
+    int ierr1, ierr2;
+    long pos = -1;
+    Py_ssize_t n0;
+    Py_buffer view;
+    PyObject *t;
+    PyObject *r;
+    
+    // Check for stream
+    if (s->fp != NULL) {
+        // Write everything; pipelined streams finish on fclose()
+        Py_BEGIN_ALLOW_THREADS
+        ierr1 = !ierr && fflush(s->fp);
+        // Final position (not available for pipes)
+        pos = ierr ? -1 : ftell(s->fp);
+        if (!ierr1 && pos >= 0 && s->start >= 0 && pos >= s->start) {
+            capec_StatAddBytes(s->stat, (size_t) (pos - s->start));
+        }
+        // Sync ordinary streams here
+        if (!ierr && !ierr1 && !s->piped && !s->zip) {
+            ierr1 = capec_PipeSync(fileno(s->fp), s->sync);
+        }
+        // Close the stream
+        ierr2 = fclose(s->fp);
+        Py_END_ALLOW_THREADS
+        s->fp = NULL;
+        // Check for errors
+        if (ierr1) {
+            PyErr_Format(PyExc_IOError,
+                "Failure writing to '%s'", s->name);
+            ierr = 1;
+        } else if (ierr2 && !ierr) {
+            PyErr_Format(PyExc_IOError,
+                "Failure on closing file '%s'", s->name);
+            ierr = 1;
+        }
+    }
+    
+    // Deliver output
+    if (!ierr && s->kind == capeSINK_PYFILE && s->pos >= 0 && pos >= 0) {
+        // Move Python file past new output
+        t = PyObject_CallMethod(s->target, "seek", "l", pos);
+        if (t == NULL) {
+            ierr = 1;
+        } else {
+            Py_DECREF(t);
+        }
+    } else if (!ierr && s->kind == capeSINK_WRITE) {
+        // Pass bytes to write() method
+        t = PyBytes_FromStringAndSize(s->buf, (Py_ssize_t) s->size);
+        if (t == NULL) {
+            ierr = 1;
+        } else {
+            r = PyObject_CallMethod(s->target, "write", "O", t);
+            Py_DECREF(t);
+            if (r == NULL) {
+                ierr = 1;
+            } else {
+                Py_DECREF(r);
+            }
+        }
+    } else if (!ierr && s->kind == capeSINK_BYTEARRAY) {
+        // Append to end
+        n0 = PyByteArray_GET_SIZE(s->target);
+        if (PyByteArray_Resize(s->target, n0 + (Py_ssize_t) s->size)) {
+            ierr = 1;
+        } else if (s->size > 0) {
+            memcpy(PyByteArray_AS_STRING(s->target) + n0, s->buf, s->size);
+        }
+        s->nbytes = (Py_ssize_t) s->size;
+    } else if (!ierr && s->kind == capeSINK_BUFFER) {
+        // Get contiguous writable view
+        if (PyObject_GetBuffer(s->target, &view, PyBUF_CONTIG)) {
+            ierr = 1;
+        } else {
+            // Check size
+            if ((Py_ssize_t) s->size > view.len) {
+                PyErr_Format(PyExc_ValueError,
+                    "Output (%zd bytes) does not fit in buffer (%zd bytes)",
+                    (Py_ssize_t) s->size, view.len);
+                ierr = 1;
+            } else if (s->size > 0) {
+                memcpy(view.buf, s->buf, s->size);
+            }
+            PyBuffer_Release(&view);
+        }
+        s->nbytes = (Py_ssize_t) s->size;
+    }
+    
+    // Release memory
+    free(s->buf);
+    s->buf = NULL;
+    s->size = 0;
+    Py_CLEAR(s->path);
+    // Output
+    return ierr;
+}
+
+// Python return value of a writer after closing its sink
+PyObject *
+capec_SinkResult(capecSink *s)
+{
+    // Number of bytes for fixed-size buffers
+    if (s->kind == capeSINK_BUFFER) {
+        return PyLong_FromSsize_t(s->nbytes);
+    }
+    // Otherwise nothing
+    Py_RETURN_NONE;
+}
+
+
+// Allocate a background write with no target or arrays
+capecSinkJob *
+capec_SinkJobNew(void)
+{
+    capecSinkJob *j;
+    
+    // Zeros leave sink and arrays empty
+    j = (capecSinkJob *) calloc(1, sizeof(capecSinkJob));
+    if (j == NULL) {
+        PyErr_NoMemory();
+    }
+    return j;
+}
+
+// Thread of a background write
+static void *
+capec_SinkJobMain(void *arg)
+{
+    capecSinkJob *j = (capecSinkJob *) arg;
+    
+    // Run the writer
+    j->ierr = j->run(j);
+    return NULL;
+}
+
+// Capsule destructor
+static void
+capec_SinkJobDel(PyObject *cap)
+{
+    capecSinkJob *j;
+    
+    // Get job
+    j = (capecSinkJob *) PyCapsule_GetPointer(cap, capeSINK_JOBCAPSULE);
+    if (j == NULL) {
+        PyErr_Clear();
+        return;
+    }
+    // Wait for writer, then release everything
+    capec_SinkJobJoin(j);
+    capec_SinkJobFree(j);
+}
+
+// Start a background write and wrap it in a capsule
+PyObject *
+capec_SinkJobStart(capecSinkJob *j)
+{
+    PyObject *cap;
+    
+    // Capsule owns job from here on (created first so it can't fail later)
+    cap = PyCapsule_New((void *) j, capeSINK_JOBCAPSULE, capec_SinkJobDel);
+    if (cap == NULL) {
+        capec_SinkJobFree(j);
+        return NULL;
+    }
+    // Keep target alive until output is delivered
+    j->target = j->sink.target;
+    Py_XINCREF(j->target);
+    // Start writer in its own thread
+    if (!pthread_create(&j->thread, NULL, capec_SinkJobMain, j)) {
+        j->state = capeSINK_JOBRUNNING;
+        return cap;
+    }
+    // Otherwise run it here
+    Py_BEGIN_ALLOW_THREADS
+    capec_SinkJobMain(j);
+    Py_END_ALLOW_THREADS
+    j->state = capeSINK_JOBFINISHED;
+    return cap;
+}
+
+// Wait for background writer to finish
+void
+capec_SinkJobJoin(capecSinkJob *j)
+{
+    // Check for running thread
+    if (j->state != capeSINK_JOBRUNNING)
+        return;
+    // Wait without the GIL (writer doesn't need it)
+    Py_BEGIN_ALLOW_THREADS
+    pthread_join(j->thread, NULL);
+    Py_END_ALLOW_THREADS
+    j->state = capeSINK_JOBFINISHED;
+}
+
+// Release the arrays of a background write
+void
+capec_SinkJobRelease(capecSinkJob *j)
+{
+    int i;
+    
+    for (i=0; i<capeSINK_JOBARRAYS; i++) {
+        Py_CLEAR(j->A[i]);
+    }
+}
+
+// Release arrays, close sink (discarding errors), and free job
+void
+capec_SinkJobFree(capecSinkJob *j)
+{
+    PyObject *t, *v, *tb;
+    
+    // Keep any exception that is already set
+    PyErr_Fetch(&t, &v, &tb);
+    capec_SinkJobRelease(j);
+    // Deliver output of a finished writer that nobody waited for
+    if (j->state != capeSINK_JOBDONE) {
+        capec_SinkClose(&j->sink, j->state != capeSINK_JOBFINISHED ||
+            j->ierr);
+    }
+    Py_CLEAR(j->target);
+    PyErr_Clear();
+    PyErr_Restore(t, v, tb);
+    free(j);
+}
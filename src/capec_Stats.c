@@ -0,0 +1,112 @@
+#include <stdlib.h>
+#include <time.h>
+
+// Local includes
+#include "capec_Stats.h"
+
+
+// Counters of each function
+static int capec_StatN = 0;
+static capecStat *capec_Stats = NULL;
+
+// Counters of function running in each thread
+static __thread capecStat *capec_StatNow = NULL;
+
+
+// Current time in nanoseconds
+static unsigned long long
+capec_StatClock(void)
+{
+    struct timespec t;
+    
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (unsigned long long) t.tv_sec * 1000000000ULL +
+        (unsigned long long) t.tv_nsec;
+}
+
+// Allocate counters
+int
+capec_StatInit(int n)
+{
+    // Used until the process exits
+    capec_Stats = (capecStat *) calloc(n + 1, sizeof(capecStat));
+    if (capec_Stats == NULL) {
+        return 1;
+    }
+    capec_StatN = n;
+    return 0;
+}
+
+// Set name of a function
+void
+capec_StatName(int i, const char *name)
+{
+    capec_Stats[i].name = name;
+}
+
+// Start counting a call
+capecStat *
+capec_StatEnter(int i, unsigned long long *t0)
+{
+    capecStat *prev;
+    
+    // Charge I/O in this thread to this function (calls may be nested)
+    prev = capec_StatNow;
+    capec_StatNow = capec_Stats + i;
+    *t0 = capec_StatClock();
+    return prev;
+}
+
+// Finish counting a call
+void
+capec_StatLeave(int i, capecStat *prev, unsigned long long t0)
+{
+    capecStat *st = capec_Stats + i;
+    
+    __atomic_fetch_add(&st->ns, capec_StatClock() - t0, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&st->calls, 1ULL, __ATOMIC_RELAXED);
+    // Restore caller's counters
+    capec_StatNow = prev;
+}
+
+// Get counters of function running in this thread
+capecStat *
+capec_StatCurrent(void)
+{
+    return capec_StatNow;
+}
+
+// Add to byte counter
+void
+capec_StatAddBytes(capecStat *st, size_t n)
+{
+    if (st != NULL) {
+        __atomic_fetch_add(&st->bytes, (unsigned long long) n,
+            __ATOMIC_RELAXED);
+    }
+}
+
+// Get number of counted functions
+int
+capec_StatCount(void)
+{
+    return capec_StatN;
+}
+
+// Get (and optionally reset) counters of one function
+void
+capec_StatGet(int i, capecStat *st, int reset)
+{
+    capecStat *s = capec_Stats + i;
+    
+    st->name = s->name;
+    if (reset) {
+        st->calls = __atomic_exchange_n(&s->calls, 0ULL, __ATOMIC_RELAXED);
+        st->bytes = __atomic_exchange_n(&s->bytes, 0ULL, __ATOMIC_RELAXED);
+        st->ns = __atomic_exchange_n(&s->ns, 0ULL, __ATOMIC_RELAXED);
+    } else {
+        st->calls = __atomic_load_n(&s->calls, __ATOMIC_RELAXED);
+        st->bytes = __atomic_load_n(&s->bytes, __ATOMIC_RELAXED);
+        st->ns = __atomic_load_n(&s->ns, __ATOMIC_RELAXED);
+    }
+}
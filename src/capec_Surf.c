@@ -0,0 +1,507 @@
+#include <Python.h>
+
+#if PY_MINOR_VERSION >= 10
+    #define NPY_NO_DEPRECATED_API NPY_2_0_API_VERSION
+#else
+    #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#endif
+#define PY_ARRAY_UNIQUE_SYMBOL _cape_ARRAY_API
+#define NO_IMPORT_ARRAY
+#include <numpy/arrayobject.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <byteswap.h>
+
+// Local includes
+#include "capec_io.h"
+#include "capec_NumPy.h"
+#include "capec_Scan.h"
+#include "capec_UGrid.h"
+#include "capec_Surf.h"
+
+// Status codes for finding sections of binary files
+enum capeSURF_WALK {
+    capeSURF_WALK_OK,       // sections exactly fill file
+    capeSURF_WALK_EXTRA,    // all sections present, then extra bytes
+    capeSURF_WALK_HEADER,   // invalid header
+    capeSURF_WALK_SIZE,     // file too small, or nodes don't fit
+    capeSURF_WALK_MARKER    // invalid record marker
+};
+
+// Names of sections
+const char *capeSURF_NAMES[capeSURF_NSECTION] = {
+    "header", "nodes", "tris", "quads"
+};
+
+// Binary formats tried when detecting layout, most checkable first
+static const char *capeSURF_FORMATS[] = {
+    "lr4", "lr8", "r4", "r8", "lb4", "lb8", "b4", "b8"
+};
+#define capeSURF_NFORMAT 8
+
+
+// ======================================================================
+// LAYOUT
+// ======================================================================
+
+// Set format from name
+int
+capec_SurfFormat(capecSurf *s, const char *fmt)
+{
+    capecUGrid g;
+    
+    // Same names as UGRID files
+    if (capec_UGridFormat(&g, fmt)) {
+        return 1;
+    }
+    s->ascii = g.ascii;
+    s->record = g.record;
+    s->swap = g.swap;
+    s->nf = g.nf;
+    return 0;
+}
+
+// Read one 4-byte int from file; -1 if past end
+static long
+capec_SurfInt(const char *data, size_t size, size_t i, int swap)
+{
+    unsigned u;
+    
+    // Check for room
+    if (i + 4 > size) {
+        return -1;
+    }
+    // Read and swap
+    memcpy(&u, data + i, 4);
+    if (swap) {u = __bswap_32(u); }
+    return (long) u;
+}
+
+// Number of bytes in section *k* of layout with counts set
+static size_t
+capec_SurfBytes(const capecSurf *s, int k)
+{
+    switch (k) {
+        case capeSURF_NODES:
+            return (size_t) s->nNode * s->ncol * s->nf;
+        case capeSURF_TRIS:
+            return (size_t) s->nTri * capeSURF_NTRICOL * 4;
+        case capeSURF_QUADS:
+            return (size_t) s->nQuad * capeSURF_NQUADCOL * 4;
+    }
+    return 12;
+}
+
+// Find offset of each section for format already set in *s*
+static int
+capec_SurfWalk(const char *data, size_t size, capecSurf *s)
+{
+    int j, k;
+    long r, n[3];
+    size_t i, nb, nm, nv;
+    
+    // Bytes for leading marker
+    nm = s->record ? 4 : 0;
+    // Header record
+    s->nsection = capeSURF_HEADER;
+    if (s->record && capec_SurfInt(data, size, 0, s->swap) != 12) {
+        return capeSURF_WALK_HEADER;
+    }
+    if (s->record && capec_SurfInt(data, size, 16, s->swap) != 12) {
+        return capeSURF_WALK_HEADER;
+    }
+    // Counts of tris, quads, and nodes
+    for (j=0; j<3; j++) {
+        r = capec_SurfInt(data, size, nm + 4*j, s->swap);
+        if (r < 0 || r > INT_MAX) {
+            return capeSURF_WALK_HEADER;
+        }
+        n[j] = r;
+    }
+    s->nTri = n[0];
+    s->nQuad = n[1];
+    s->nNode = n[2];
+    s->offset[capeSURF_HEADER] = nm;
+    i = 12 + 2*nm;
+    
+    // Size of nodes (from marker or from rest of file) gives columns
+    s->nsection = capeSURF_NODES;
+    if (s->record) {
+        r = capec_SurfInt(data, size, i, s->swap);
+        if (r < 0) {
+            return capeSURF_WALK_MARKER;
+        }
+        nb = (size_t) r;
+    } else {
+        nb = capec_SurfBytes(s, capeSURF_TRIS) +
+            capec_SurfBytes(s, capeSURF_QUADS) + i;
+        if (nb > size) {
+            return capeSURF_WALK_SIZE;
+        }
+        nb = size - nb;
+    }
+    nv = (size_t) s->nNode * s->nf;
+    if (nv == 0) {
+        s->ncol = 5;
+    } else {
+        s->ncol = (int) (nb / nv);
+    }
+    if ((nv == 0 && nb != 0) || (nv && nb % nv) || s->ncol < 3 ||
+            s->ncol > 5) {
+        return s->record ? capeSURF_WALK_MARKER : capeSURF_WALK_SIZE;
+    }
+    
+    // Loop through sections
+    for (k=capeSURF_NODES; k<capeSURF_NSECTION; k++) {
+        s->nsection = k;
+        nb = capec_SurfBytes(s, k);
+        // Check for room
+        if (i + nb + 2*nm > size) {
+            return capeSURF_WALK_SIZE;
+        }
+        // Check record markers
+        if (s->record) {
+            r = capec_SurfInt(data, size, i, s->swap);
+            if (r < 0 || (size_t) r != nb) {
+                return capeSURF_WALK_MARKER;
+            }
+            r = capec_SurfInt(data, size, i + nm + nb, s->swap);
+            if (r < 0 || (size_t) r != nb) {
+                return capeSURF_WALK_MARKER;
+            }
+        }
+        // Save start of data
+        s->offset[k] = i + nm;
+        i += nb + 2*nm;
+    }
+    // Check for data after last section
+    return (i == size) ? capeSURF_WALK_OK : capeSURF_WALK_EXTRA;
+}
+
+// Find sections of binary surface file
+int
+capec_ParseSurf(const char *data, size_t size, const char *fmt,
+    capecSurf *s)
+{
+    int j, ierr;
+    
+    // Initialize
+    memset(s, 0, sizeof(capecSurf));
+    // Try each binary format if not specified
+    if (fmt == NULL) {
+        for (j=0; j<capeSURF_NFORMAT; j++) {
+            capec_SurfFormat(s, capeSURF_FORMATS[j]);
+            if (capec_SurfWalk(data, size, s) == capeSURF_WALK_OK) {
+                return 0;
+            }
+        }
+        // Assume anything else is text
+        memset(s, 0, sizeof(capecSurf));
+        s->ascii = 1;
+        return 0;
+    }
+    // Interpret format
+    if (capec_SurfFormat(s, fmt)) {
+        PyErr_Format(PyExc_ValueError,
+            "Unrecognized surf format '%s'", fmt);
+        return 1;
+    }
+    // Nothing to find for text files
+    if (s->ascii) {
+        return 0;
+    }
+    // Find sections
+    ierr = capec_SurfWalk(data, size, s);
+    if (ierr == capeSURF_WALK_HEADER) {
+        PyErr_Format(PyExc_ValueError,
+            "File does not start with a valid '%s' surf header", fmt);
+    } else if (ierr == capeSURF_WALK_SIZE) {
+        PyErr_Format(PyExc_ValueError,
+            "Size of file does not match surf header at %s section",
+            capeSURF_NAMES[s->nsection]);
+    } else if (ierr == capeSURF_WALK_MARKER) {
+        PyErr_Format(PyExc_ValueError,
+            "Invalid record markers for surf %s section",
+            capeSURF_NAMES[s->nsection]);
+    } else {
+        // Extra bytes after all sections are ignored
+        return 0;
+    }
+    return 1;
+}
+
+
+// ======================================================================
+// ASCII
+// ======================================================================
+
+// Check that a number ends at a blank or end of line
+#define capec_SurfEnd(e) (capeSCAN_IsSpace(*(e)) || *(e) == '\0')
+
+// Get next line that isn't blank, skipping leading spaces
+static char *
+capec_SurfLine(capecScanBuf *b)
+{
+    char *s;
+    
+    while ((s = capec_ScanBufLine(b)) != NULL) {
+        while (capeSCAN_IsSpace(*s)) {s++; }
+        if (*s != '\0') {break; }
+    }
+    return s;
+}
+
+// Get start of next token of text file, reading more lines as needed
+static char *
+capec_SurfToken(capecScanBuf *b, char **p)
+{
+    char *s = *p;
+    
+    // Loop until a nonblank character is found
+    while (1) {
+        // Skip blanks
+        while (capeSCAN_IsSpace(*s)) {s++; }
+        // Check for token
+        if (*s != '\0') {
+            *p = s;
+            return s;
+        }
+        // Go to next line
+        s = capec_ScanBufLine(b);
+        if (s == NULL) {
+            *p = (char *) "";
+            return NULL;
+        }
+    }
+}
+
+// Read header of ASCII file
+int
+capec_ReadSurfHeader(capecScanBuf *b, char **p, capecSurf *s)
+{
+    int j;
+    long long x;
+    long n[7];
+    char *e;
+    
+    // Initialize
+    *p = (char *) "";
+    s->nsection = capeSURF_HEADER;
+    // First line with 3 or 7 counts
+    e = capec_SurfLine(b);
+    if (e == NULL) {
+        return b->ierr ? capeSURF_ERR_READ : capeSURF_ERR_EOF;
+    }
+    for (j=0; *e != '\0'; j++) {
+        if (j >= 7 || capec_ScanI64(e, &e, &x) || !capec_SurfEnd(e) ||
+                x < 0 || x > INT_MAX) {
+            return capeSURF_ERR_VALUE;
+        }
+        n[j] = (long) x;
+        while (capeSCAN_IsSpace(*e)) {e++; }
+    }
+    if (j == 3) {
+        // Surface file order
+        s->nTri = n[0];
+        s->nQuad = n[1];
+        s->nNode = n[2];
+    } else if (j == 7) {
+        // Order of full UGRID file
+        s->nNode = n[0];
+        s->nTri = n[1];
+        s->nQuad = n[2];
+    } else {
+        return capeSURF_ERR_VALUE;
+    }
+    // First node line sets number of columns
+    s->nsection = capeSURF_NODES;
+    s->ncol = 5;
+    if (s->nNode == 0) {
+        return capeSURF_OK;
+    }
+    e = capec_SurfLine(b);
+    if (e == NULL) {
+        return b->ierr ? capeSURF_ERR_READ : capeSURF_ERR_EOF;
+    }
+    *p = e;
+    for (j=0; *e != '\0'; j++) {
+        while (!capec_SurfEnd(e)) {e++; }
+        while (capeSCAN_IsSpace(*e)) {e++; }
+    }
+    if (j < 3 || j > 5) {
+        return capeSURF_ERR_VALUE;
+    }
+    s->ncol = j;
+    return capeSURF_OK;
+}
+
+// Read one section of ints or floats
+static int
+capec_SurfTextSection(capecScanBuf *b, char **p, size_t n, double *x,
+    int *v)
+{
+    size_t i;
+    long long u;
+    char *t, *e;
+    
+    // Loop through values
+    for (i=0; i<n; i++) {
+        // Find next value
+        t = capec_SurfToken(b, p);
+        if (t == NULL) {
+            return b->ierr ? capeSURF_ERR_READ : capeSURF_ERR_EOF;
+        }
+        // Convert it
+        if (x != NULL) {
+            if (capec_ScanF64(t, &e, x + i) || !capec_SurfEnd(e)) {
+                return capeSURF_ERR_VALUE;
+            }
+        } else {
+            if (capec_ScanI64(t, &e, &u) || !capec_SurfEnd(e) ||
+                    u < INT_MIN || u > INT_MAX) {
+                return capeSURF_ERR_VALUE;
+            }
+            v[i] = (int) u;
+        }
+        *p = e;
+    }
+    return capeSURF_OK;
+}
+
+// Read sections of ASCII file
+int
+capec_ReadSurfText(capecScanBuf *b, char **p, capecSurf *s, double *X,
+    int *T, int *Q)
+{
+    int ierr;
+    
+    // Nodes
+    s->nsection = capeSURF_NODES;
+    ierr = capec_SurfTextSection(b, p, (size_t) s->nNode * s->ncol,
+        X, NULL);
+    if (ierr) {
+        return ierr;
+    }
+    // Tris
+    s->nsection = capeSURF_TRIS;
+    ierr = capec_SurfTextSection(b, p,
+        (size_t) s->nTri * capeSURF_NTRICOL, NULL, T);
+    if (ierr) {
+        return ierr;
+    }
+    // Quads
+    s->nsection = capeSURF_QUADS;
+    return capec_SurfTextSection(b, p,
+        (size_t) s->nQuad * capeSURF_NQUADCOL, NULL, Q);
+}
+
+
+// ======================================================================
+// WRITERS
+// ======================================================================
+
+// Interleave nodes and BL parameters
+int
+capec_PackSurfNodes(double *X, PyArrayObject *P, PyArrayObject *blds,
+    PyArrayObject *bldel)
+{
+    int j;
+    size_t i, nNode;
+    
+    // Check for nNode x 3 nodes and one BL value per node
+    if (PyArray_NDIM(P) != 2 || PyArray_DIM(P, 1) < 3 ||
+            PyArray_NDIM(blds) != 1 || PyArray_NDIM(bldel) != 1 ||
+            PyArray_DIM(blds, 0) != PyArray_DIM(P, 0) ||
+            PyArray_DIM(bldel, 0) != PyArray_DIM(P, 0)) {
+        return capeIO_ERR_SHAPE;
+    }
+    // Check for arrays pinned by capec_PinView()
+    if (!capec_ViewOK(P, NPY_DOUBLE) ||
+            !capec_ViewOK(blds, NPY_DOUBLE) ||
+            !capec_ViewOK(bldel, NPY_DOUBLE)) {
+        return capeIO_ERR_SHAPE;
+    }
+    nNode = (size_t) PyArray_DIM(P, 0);
+    // Loop through nodes
+    for (i=0; i<nNode; i++, X+=5) {
+        for (j=0; j<3; j++) {
+            X[j] = np2dv(P, i, j);
+        }
+        X[3] = np1dv(blds, i);
+        X[4] = np1dv(bldel, i);
+    }
+    return capeIO_OK;
+}
+
+// Combine face indices and flags
+int
+capec_PackSurfFaces(int *F, int nv, PyArrayObject *T, PyArrayObject *C,
+    PyArrayObject *BC)
+{
+    int j;
+    size_t i, n;
+    
+    // Check for n x nv faces and one ID and BC per face
+    if (PyArray_NDIM(T) != 2 || PyArray_DIM(T, 1) != nv ||
+            PyArray_NDIM(C) != 1 ||
+            PyArray_NDIM(BC) != 1 ||
+            PyArray_DIM(C, 0) != PyArray_DIM(T, 0) ||
+            PyArray_DIM(BC, 0) != PyArray_DIM(T, 0)) {
+        return capeIO_ERR_SHAPE;
+    }
+    // Check for arrays pinned by capec_PinView()
+    if (!capec_ViewOK(T, NPY_INT) ||
+            !capec_ViewOK(C, NPY_INT) ||
+            !capec_ViewOK(BC, NPY_INT)) {
+        return capeIO_ERR_SHAPE;
+    }
+    n = (size_t) PyArray_DIM(T, 0);
+    // Loop through faces: indices, ID, flag, BC
+    for (i=0; i<n; i++) {
+        for (j=0; j<nv; j++) {
+            *(F++) = (int) np2iv(T, i, j);
+        }
+        *(F++) = (int) np1iv(C, i);
+        *(F++) = 0;
+        *(F++) = (int) np1iv(BC, i);
+    }
+    return capeIO_OK;
+}
+
+// Write binary surface file
+int
+capec_WriteSurfBin(FILE *fid, const capecSurf *s, PyArrayObject **A, int *k)
+{
+    int ierr, rtype;
+    int (*fwrite_a)(FILE *, PyArrayObject *, int, int, int);
+    
+    // Header: tris, quads, nodes
+    *k = capeSURF_HEADER;
+    ierr = s->record && capec_WriteMarker(fid, 12, s->swap);
+    ierr = ierr || capec_WriteCount(fid, (size_t) s->nTri, 4, s->swap);
+    ierr = ierr || capec_WriteCount(fid, (size_t) s->nQuad, 4, s->swap);
+    ierr = ierr || capec_WriteCount(fid, (size_t) s->nNode, 4, s->swap);
+    ierr = ierr || (s->record && capec_WriteMarker(fid, 12, s->swap));
+    if (ierr) {
+        return (s->nTri > INT_MAX || s->nQuad > INT_MAX ||
+            s->nNode > INT_MAX) ? capeIO_ERR_SIZE : capeIO_ERR_WRITE;
+    }
+    // Array writer
+    fwrite_a = s->record ? capec_WriteRecord : capec_WriteStream;
+    // Loop through sections
+    for (*k=capeSURF_NODES; *k<capeSURF_NSECTION; (*k)++) {
+        // Output type
+        if (*k != capeSURF_NODES) {
+            rtype = capeREC_I4;
+        } else {
+            rtype = (s->nf == 4) ? capeREC_F4 : capeREC_F8;
+        }
+        // Write it
+        ierr = fwrite_a(fid, A[*k - capeSURF_NODES], 2, rtype, s->swap);
+        if (ierr) {
+            return ierr;
+        }
+    }
+    return capeIO_OK;
+}
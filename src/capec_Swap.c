@@ -0,0 +1,428 @@
+#include <stdint.h>
+#include <string.h>
+
+// Local includes
+#include "capec_Swap.h"
+
+// SIMD instruction sets
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define capeSWAP_X86
+    #include <immintrin.h>
+#elif defined(__aarch64__) || defined(__ARM_NEON)
+    #define capeSWAP_NEON
+    #include <arm_neon.h>
+#endif
+
+
+// Kernel function types
+typedef void (*capecSwapFunc)(void *, const void *, size_t);
+typedef void (*capecNarrowFunc)(float *, const double *, size_t, int);
+
+
+// ======================================================================
+// SCALAR KERNELS
+// ======================================================================
+
+// Swap 4-byte words one at a time
+static void
+capec_Swap4_scalar(void *dst, const void *src, size_t n)
+{
+    size_t i;
+    uint32_t u;
+    const char *s = (const char *) src;
+    char *d = (char *) dst;
+    
+    // Loop through words; memcpy() avoids alignment assumptions
+    for (i=0; i<n; i++) {
+        memcpy(&u, s + 4*i, 4);
+        u = __builtin_bswap32(u);
+        memcpy(d + 4*i, &u, 4);
+    }
+}
+
+// Swap 8-byte words one at a time
+static void
+capec_Swap8_scalar(void *dst, const void *src, size_t n)
+{
+    size_t i;
+    uint64_t u;
+    const char *s = (const char *) src;
+    char *d = (char *) dst;
+    
+    // Loop through words
+    for (i=0; i<n; i++) {
+        memcpy(&u, s + 8*i, 8);
+        u = __builtin_bswap64(u);
+        memcpy(d + 8*i, &u, 8);
+    }
+}
+
+// Convert doubles to singles one at a time
+static void
+capec_NarrowF64_scalar(float *dst, const double *src, size_t n, int swap)
+{
+    size_t i;
+    
+    // Convert
+    for (i=0; i<n; i++) {
+        dst[i] = (float) src[i];
+    }
+    // Swap in place
+    if (swap) {
+        capec_Swap4_scalar(dst, dst, n);
+    }
+}
+
+
+// ======================================================================
+// X86 KERNELS
+// ======================================================================
+#ifdef capeSWAP_X86
+
+// Shuffle masks to reverse bytes within each word
+#define capeSWAP_MASK4 \
+    3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12
+#define capeSWAP_MASK8 \
+    7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8
+
+// Swap 4-byte words, 16 bytes at a time
+__attribute__((target("ssse3")))
+static void
+capec_Swap4_ssse3(void *dst, const void *src, size_t n)
+{
+    size_t i, m;
+    __m128i v, mask;
+    const char *s = (const char *) src;
+    char *d = (char *) dst;
+    
+    // Byte order mask
+    mask = _mm_setr_epi8(capeSWAP_MASK4);
+    // Number of full vectors
+    m = n / 4;
+    for (i=0; i<m; i++) {
+        v = _mm_loadu_si128((const __m128i *) (s + 16*i));
+        v = _mm_shuffle_epi8(v, mask);
+        _mm_storeu_si128((__m128i *) (d + 16*i), v);
+    }
+    // Remainder
+    capec_Swap4_scalar(d + 16*m, s + 16*m, n - 4*m);
+}
+
+// Swap 8-byte words, 16 bytes at a time
+__attribute__((target("ssse3")))
+static void
+capec_Swap8_ssse3(void *dst, const void *src, size_t n)
+{
+    size_t i, m;
+    __m128i v, mask;
+    const char *s = (const char *) src;
+    char *d = (char *) dst;
+    
+    // Byte order mask
+    mask = _mm_setr_epi8(capeSWAP_MASK8);
+    // Number of full vectors
+    m = n / 2;
+    for (i=0; i<m; i++) {
+        v = _mm_loadu_si128((const __m128i *) (s + 16*i));
+        v = _mm_shuffle_epi8(v, mask);
+        _mm_storeu_si128((__m128i *) (d + 16*i), v);
+    }
+    // Remainder
+    capec_Swap8_scalar(d + 16*m, s + 16*m, n - 2*m);
+}
+
+// Convert doubles to singles, 4 at a time
+__attribute__((target("ssse3")))
+static void
+capec_NarrowF64_ssse3(float *dst, const double *src, size_t n, int swap)
+{
+    size_t i, m;
+    __m128 lo, hi;
+    __m128i v, mask;
+    
+    // Byte order mask
+    mask = _mm_setr_epi8(capeSWAP_MASK4);
+    // Number of full vectors
+    m = n / 4;
+    for (i=0; i<m; i++) {
+        // Two doubles to two singles, twice
+        lo = _mm_cvtpd_ps(_mm_loadu_pd(src + 4*i));
+        hi = _mm_cvtpd_ps(_mm_loadu_pd(src + 4*i + 2));
+        // Combine low halves
+        v = _mm_castps_si128(_mm_movelh_ps(lo, hi));
+        // Swap
+        if (swap) {v = _mm_shuffle_epi8(v, mask); }
+        _mm_storeu_si128((__m128i *) (dst + 4*i), v);
+    }
+    // Remainder
+    capec_NarrowF64_scalar(dst + 4*m, src + 4*m, n - 4*m, swap);
+}
+
+// Swap 4-byte words, 32 bytes at a time
+__attribute__((target("avx2")))
+static void
+capec_Swap4_avx2(void *dst, const void *src, size_t n)
+{
+    size_t i, m;
+    __m256i v, mask;
+    const char *s = (const char *) src;
+    char *d = (char *) dst;
+    
+    // Byte order mask (same in each 128-bit lane)
+    mask = _mm256_setr_epi8(capeSWAP_MASK4, capeSWAP_MASK4);
+    // Number of full vectors
+    m = n / 8;
+    for (i=0; i<m; i++) {
+        v = _mm256_loadu_si256((const __m256i *) (s + 32*i));
+        v = _mm256_shuffle_epi8(v, mask);
+        _mm256_storeu_si256((__m256i *) (d + 32*i), v);
+    }
+    // Remainder
+    capec_Swap4_ssse3(d + 32*m, s + 32*m, n - 8*m);
+}
+
+// Swap 8-byte words, 32 bytes at a time
+__attribute__((target("avx2")))
+static void
+capec_Swap8_avx2(void *dst, const void *src, size_t n)
+{
+    size_t i, m;
+    __m256i v, mask;
+    const char *s = (const char *) src;
+    char *d = (char *) dst;
+    
+    // Byte order mask (same in each 128-bit lane)
+    mask = _mm256_setr_epi8(capeSWAP_MASK8, capeSWAP_MASK8);
+    // Number of full vectors
+    m = n / 4;
+    for (i=0; i<m; i++) {
+        v = _mm256_loadu_si256((const __m256i *) (s + 32*i));
+        v = _mm256_shuffle_epi8(v, mask);
+        _mm256_storeu_si256((__m256i *) (d + 32*i), v);
+    }
+    // Remainder
+    capec_Swap8_ssse3(d + 32*m, s + 32*m, n - 4*m);
+}
+
+// Convert doubles to singles, 8 at a time
+__attribute__((target("avx2")))
+static void
+capec_NarrowF64_avx2(float *dst, const double *src, size_t n, int swap)
+{
+    size_t i, m;
+    __m128 lo, hi;
+    __m256i v, mask;
+    
+    // Byte order mask
+    mask = _mm256_setr_epi8(capeSWAP_MASK4, capeSWAP_MASK4);
+    // Number of full vectors
+    m = n / 8;
+    for (i=0; i<m; i++) {
+        // Four doubles to four singles, twice
+        lo = _mm256_cvtpd_ps(_mm256_loadu_pd(src + 8*i));
+        hi = _mm256_cvtpd_ps(_mm256_loadu_pd(src + 8*i + 4));
+        // Combine
+        v = _mm256_castps_si256(
+            _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1));
+        // Swap
+        if (swap) {v = _mm256_shuffle_epi8(v, mask); }
+        _mm256_storeu_si256((__m256i *) (dst + 8*i), v);
+    }
+    // Remainder
+    capec_NarrowF64_ssse3(dst + 8*m, src + 8*m, n - 8*m, swap);
+}
+
+#endif  // capeSWAP_X86
+
+
+// ======================================================================
+// ARM KERNELS
+// ======================================================================
+#ifdef capeSWAP_NEON
+
+// Swap 4-byte words, 16 bytes at a time
+static void
+capec_Swap4_neon(void *dst, const void *src, size_t n)
+{
+    size_t i, m;
+    uint8x16_t v;
+    const uint8_t *s = (const uint8_t *) src;
+    uint8_t *d = (uint8_t *) dst;
+    
+    // Number of full vectors
+    m = n / 4;
+    for (i=0; i<m; i++) {
+        v = vld1q_u8(s + 16*i);
+        vst1q_u8(d + 16*i, vrev32q_u8(v));
+    }
+    // Remainder
+    capec_Swap4_scalar(d + 16*m, s + 16*m, n - 4*m);
+}
+
+// Swap 8-byte words, 16 bytes at a time
+static void
+capec_Swap8_neon(void *dst, const void *src, size_t n)
+{
+    size_t i, m;
+    uint8x16_t v;
+    const uint8_t *s = (const uint8_t *) src;
+    uint8_t *d = (uint8_t *) dst;
+    
+    // Number of full vectors
+    m = n / 2;
+    for (i=0; i<m; i++) {
+        v = vld1q_u8(s + 16*i);
+        vst1q_u8(d + 16*i, vrev64q_u8(v));
+    }
+    // Remainder
+    capec_Swap8_scalar(d + 16*m, s + 16*m, n - 2*m);
+}
+
+#ifdef __aarch64__
+// Convert doubles to singles, 4 at a time
+static void
+capec_NarrowF64_neon(float *dst, const double *src, size_t n, int swap)
+{
+    size_t i, m;
+    float32x4_t v;
+    
+    // Number of full vectors
+    m = n / 4;
+    for (i=0; i<m; i++) {
+        // Two doubles to two singles, twice
+        v = vcombine_f32(
+            vcvt_f32_f64(vld1q_f64(src + 4*i)),
+            vcvt_f32_f64(vld1q_f64(src + 4*i + 2)));
+        // Swap
+        if (swap) {
+            v = vreinterpretq_f32_u8(vrev32q_u8(vreinterpretq_u8_f32(v)));
+        }
+        vst1q_f32(dst + 4*i, v);
+    }
+    // Remainder
+    capec_NarrowF64_scalar(dst + 4*m, src + 4*m, n - 4*m, swap);
+}
+#endif  // __aarch64__
+
+#endif  // capeSWAP_NEON
+
+
+// ======================================================================
+// DISPATCH
+// ======================================================================
+
+// Selected kernels (scalar until capec_SwapInit() is called)
+static capecSwapFunc   capec_Swap4_best = capec_Swap4_scalar;
+static capecSwapFunc   capec_Swap8_best = capec_Swap8_scalar;
+static capecNarrowFunc capec_NarrowF64_best = capec_NarrowF64_scalar;
+static const char     *capec_SwapKernel = "scalar";
+
+// Pick kernels according to CPU features
+void
+capec_SwapInit(void)
+{
+#if defined(capeSWAP_X86)
+    __builtin_cpu_init();
+    // Check for AVX2, else SSSE3
+    if (__builtin_cpu_supports("avx2")) {
+        capec_Swap4_best = capec_Swap4_avx2;
+        capec_Swap8_best = capec_Swap8_avx2;
+        capec_NarrowF64_best = capec_NarrowF64_avx2;
+        capec_SwapKernel = "avx2";
+    } else if (__builtin_cpu_supports("ssse3")) {
+        capec_Swap4_best = capec_Swap4_ssse3;
+        capec_Swap8_best = capec_Swap8_ssse3;
+        capec_NarrowF64_best = capec_NarrowF64_ssse3;
+        capec_SwapKernel = "ssse3";
+    }
+#elif defined(capeSWAP_NEON)
+    // NEON is always present on these targets
+    capec_Swap4_best = capec_Swap4_neon;
+    capec_Swap8_best = capec_Swap8_neon;
+#ifdef __aarch64__
+    capec_NarrowF64_best = capec_NarrowF64_neon;
+#endif
+    capec_SwapKernel = "neon";
+#endif
+}
+
+// Name of selected kernels
+const char *
+capec_SwapKernelName(void)
+{
+    return capec_SwapKernel;
+}
+
+// Swap 4-byte words
+void
+capec_Swap4(void *dst, const void *src, size_t n)
+{
+    capec_Swap4_best(dst, src, n);
+}
+
+// Swap 8-byte words
+void
+capec_Swap8(void *dst, const void *src, size_t n)
+{
+    capec_Swap8_best(dst, src, n);
+}
+
+// Narrow doubles to singles
+void
+capec_NarrowF64(float *dst, const double *src, size_t n, int swap)
+{
+    capec_NarrowF64_best(dst, src, n, swap);
+}
+
+
+// ======================================================================
+// SINGLE VALUES
+// ======================================================================
+
+// Read one 4-byte float, swapping bytes as an integer
+float
+capec_GetF4(const void *p, int swap)
+{
+    float f;
+    uint32_t u;
+    
+    memcpy(&u, p, 4);
+    if (swap) {u = __builtin_bswap32(u); }
+    memcpy(&f, &u, 4);
+    return f;
+}
+
+// Read one 8-byte float, swapping bytes as an integer
+double
+capec_GetF8(const void *p, int swap)
+{
+    double v;
+    uint64_t u;
+    
+    memcpy(&u, p, 8);
+    if (swap) {u = __builtin_bswap64(u); }
+    memcpy(&v, &u, 8);
+    return v;
+}
+
+// Store one 4-byte float, swapping bytes as an integer
+void
+capec_PutF4(void *p, float f, int swap)
+{
+    uint32_t u;
+    
+    memcpy(&u, &f, 4);
+    if (swap) {u = __builtin_bswap32(u); }
+    memcpy(p, &u, 4);
+}
+
+// Store one 8-byte float, swapping bytes as an integer
+void
+capec_PutF8(void *p, double v, int swap)
+{
+    uint64_t u;
+    
+    memcpy(&u, &v, 8);
+    if (swap) {u = __builtin_bswap64(u); }
+    memcpy(p, &u, 8);
+}
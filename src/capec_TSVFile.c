@@ -0,0 +1,81 @@
+#include <Python.h>
+#include <stdio.h>
+#include <string.h>
+
+// Local includes
+#include "capec_Error.h"
+#include "capec_PyTypes.h"
+#include "capec_BaseFile.h"
+#include "capec_Scan.h"
+#include "capec_TSVFile.h"
+
+// Check for field delimiter
+#define capeTSV_IsSpace(c) capeSCAN_IsSpace(c)
+
+
+// Count data lines in open file
+size_t
+capec_TSVFileCountLines(FILE *fp)
+{
+    // Same rules as any other text file
+    return capec_ScanCountLines(fp);
+}
+
+
+// Split line and save fields
+int
+capeTSV_ReadLine(char *line, void **coldata, int *DTYPES, size_t ncol,
+    size_t irow)
+{
+    int ierr, eol;
+    size_t jcol;
+    char *p, *q;
+    
+    // Start of line
+    p = line;
+    // Loop through columns
+    for (jcol=0; jcol<=ncol; jcol++) {
+        // Skip white space
+        while (capeTSV_IsSpace(*p)) {
+            p++;
+        }
+        // Check for end of line or comment
+        if (*p == '\0' || *p == '\n' || *p == '#') {
+            // Check for blank line
+            if (jcol == 0) {
+                return -1;
+            } else if (jcol < ncol) {
+                PyErr_Format(PyExc_ValueError,
+                    "Data row %li has only %i of %i columns",
+                    (long) irow, (int) jcol, (int) ncol);
+                return capeERROR_VALUE;
+            }
+            // Normal end of row
+            return 0;
+        }
+        // Check for too many entries
+        if (jcol == ncol) {
+            PyErr_Format(PyExc_ValueError,
+                "Data row %li extends past %i columns",
+                (long) irow, (int) ncol);
+            return capeERROR_VALUE;
+        }
+        // Find end of field
+        q = p;
+        while (*q != '\0' && *q != '\n' && !capeTSV_IsSpace(*q)) {
+            q++;
+        }
+        // Check if field ends the line
+        eol = (*q != '\0' && capeTSV_IsSpace(*q)) ? 0 : 1;
+        // Terminate field and convert it
+        *q = '\0';
+        ierr = capeFILE_FromText(p, coldata[jcol], DTYPES[jcol], irow);
+        if (ierr) {
+            return ierr;
+        }
+        // Move to next field (or terminator)
+        p = eol ? q : q + 1;
+    }
+    // Not reached
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+
+// Local includes
+#include "capec_Thread.h"
+
+
+// Arguments passed to each thread
+typedef struct {
+    capecThreadFunc func;
+    void *task;
+} capecThreadArg;
+
+
+// Thread entry point
+static void *
+capec_ThreadMain(void *arg)
+{
+    capecThreadArg *a = (capecThreadArg *) arg;
+    
+    // Run the task
+    a->func(a->task);
+    return NULL;
+}
+
+// Get number of processors
+int
+capec_ThreadCount(void)
+{
+    long n;
+    
+    // Ask the OS
+    n = sysconf(_SC_NPROCESSORS_ONLN);
+    // Filter
+    if (n < 1) {
+        return 1;
+    } else if (n > capeTHREAD_MAX) {
+        return capeTHREAD_MAX;
+    }
+    return (int) n;
+}
+
+// Run tasks in parallel
+void
+capec_ThreadRun(capecThreadFunc func, void *tasks, size_t size, int ntask)
+{
+    int i;
+    int nstart = 0;
+    pthread_t threads[capeTHREAD_MAX];
+    capecThreadArg args[capeTHREAD_MAX];
+    char *t = (char *) tasks;
+    
+    // Start a thread for each task but the first
+    for (i=1; i<ntask && i<capeTHREAD_MAX; i++) {
+        args[i].func = func;
+        args[i].task = t + i*size;
+        if (pthread_create(&threads[i], NULL, capec_ThreadMain, &args[i])) {
+            break;
+        }
+        nstart = i;
+    }
+    // Run first task and any that didn't get a thread here
+    if (ntask > 0) {
+        func(t);
+    }
+    for (i=nstart+1; i<ntask; i++) {
+        func(t + i*size);
+    }
+    // Wait for the others
+    for (i=1; i<=nstart; i++) {
+        pthread_join(threads[i], NULL);
+    }
+}
@@ -9,58 +9,81 @@
 #define NO_IMPORT_ARRAY
 #include <numpy/arrayobject.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <math.h>
 #include <byteswap.h>
 
 // Local includes
 #include "capec_io.h"
+#include "capec_Memory.h"
 #include "capec_NumPy.h"
+#include "capec_Fmt.h"
+#include "capec_Swap.h"
+#include "capec_Tri.h"
 
 
 // Function to write nodes
 int
 capec_WriteTriNodes(FILE *fid, PyArrayObject *P)
 {
-    int i;
-    int n, nNode, nd;
+    int j, nd;
+    size_t i, n, nNode;
+    char *p0, *p;
+    capecFmtBuf b;
     
     // Number of values written.
     n = 0;
     
     // Check for two-dimensional Mx3 array.
     if (PyArray_NDIM(P) != 2) {
-        PyErr_SetString(PyExc_ValueError, \
-            "Nodal coordinates must be two-dimensional array.");
-        return 2;
+        return capeIO_ERR_SHAPE;
     }
     // Read number of nodes and dimensionality
-    nNode = (int) PyArray_DIM(P, 0);
+    nNode = (size_t) PyArray_DIM(P, 0);
     nd = (int) PyArray_DIM(P, 1);
+    // Write two or three coordinates per node
+    if (nd != 2) {nd = 3; }
+    
+    // Check for arrays pinned by capec_PinView()
+    if (!capec_ViewOK(P, NPY_DOUBLE)) {
+        return capeIO_ERR_SHAPE;
+    }
+    
+    // Create text buffer
+    if (capec_FmtBufInit(&b, fid)) {
+        return capeIO_ERR_MEM;
+    }
     
     // Loop through nodal indices.
-    if (nd == 2) {
-        // Two-dimensional nodes
-        for (i=0; i<nNode; i++) {
-            // Write a single node.
-            fprintf(fid, "%+15.8E %+15.8E\n", \
-                np2d(P,i,0), np2d(P,i,1));
-            // Increase the count.
-            n += 1;
+    for (i=0; i<nNode; i++) {
+        // Get room for one row
+        p0 = capec_FmtBufReserve(&b, 3*(capeFMT_MAXNUM + 1));
+        if (p0 == NULL) {break; }
+        // Write a single node: "%+15.8E %+15.8E %+15.8E\n"
+        p = p0;
+        p += capec_FmtE(p, np2dv(P,i,0), 8, 1);
+        for (j=1; j<nd; j++) {
+            *(p++) = ' ';
+            p += capec_FmtE(p, np2dv(P,i,j), 8, 1);
         }
+        *(p++) = '\n';
+        // Save the row
+        capec_FmtBufCommit(&b, p - p0);
+        // Increase the count.
+        n += 1;
     }
-    else {
-        // Three-dimensional nodes
-        for (i=0; i<nNode; i++) {
-            // Write a single node.
-            fprintf(fid, "%+15.8E %+15.8E %+15.8E\n", \
-                np2d(P,i,0), np2d(P,i,1), np2d(P,i,2));
-            // Increase the count.
-            n += 1;
-        }
+    
+    // Write remaining text
+    if (capec_FmtBufClose(&b)) {
+        return capeIO_ERR_WRITE;
     }
     
     // Check count.
     if (n != nNode) {
-        return 1;
+        return capeIO_ERR_WRITE;
     }
     
     // Good output
@@ -73,60 +96,72 @@ int
 capec_WriteSurfNodes(FILE *fid, PyArrayObject *P, \
     PyArrayObject *blds, PyArrayObject *bldel)
 {
-    int i;
-    int n, nNode, nd;
+    int j, nd;
+    size_t i, n, nNode;
+    char *p0, *p;
+    capecFmtBuf b;
     
     // Number of values written
     n = 0;
     
     // Check for two-dimensional nNode x 3 array
     if (PyArray_NDIM(P) != 2) {
-        PyErr_SetString(PyExc_ValueError, \
-            "Nodal coordinates must be two-dimensional array.");
-        return 2;
+        return capeIO_ERR_SHAPE;
     }
-    // Read number of nodes 
-    nNode = (int) PyArray_DIM(P, 0);
+    // Read number of nodes
+    nNode = (size_t) PyArray_DIM(P, 0);
     nd = (int) PyArray_DIM(P, 1);
     // Check the other inputs
     if (PyArray_NDIM(bldel) != 1 || PyArray_DIM(bldel,0) != nNode) {
-        PyErr_SetString(PyExc_ValueError, \
-            "BL depths must be 1D array with one value per node.");
-        return 2;
+        return capeIO_ERR_SHAPE;
     }
     if (PyArray_NDIM(blds) != 1 || PyArray_DIM(blds,0) != nNode) {
-        PyErr_SetString(PyExc_ValueError, \
-            "BL spacing must be 1D array with one value per node.");
-        return 2;
+        return capeIO_ERR_SHAPE;
+    }
+    // Write two or three coordinates per node
+    if (nd != 2) {nd = 3; }
+    
+    // Check for arrays pinned by capec_PinView()
+    if (!capec_ViewOK(P, NPY_DOUBLE) ||
+            !capec_ViewOK(blds, NPY_DOUBLE) ||
+            !capec_ViewOK(bldel, NPY_DOUBLE)) {
+        return capeIO_ERR_SHAPE;
+    }
+    
+    // Create text buffer
+    if (capec_FmtBufInit(&b, fid)) {
+        return capeIO_ERR_MEM;
     }
     
     // Loop through nodal indices
-    if (nd == 2) {
-        // Two-dimensional nodes
-        for (i=0; i<nNode; i++) {
-            // Write a single node
-            fprintf(fid, "%+15.8E %+15.8E %.4E %.4E\n", \
-                np2d(P,i,0), np2d(P,i,1), \
-                np1d(blds,i), np1d(bldel,i));
-            // Increase the count.
-            n += 1;
+    for (i=0; i<nNode; i++) {
+        // Get room for one row
+        p0 = capec_FmtBufReserve(&b, 5*(capeFMT_MAXNUM + 1));
+        if (p0 == NULL) {break; }
+        // Write a single node: "%+15.8E %+15.8E %+15.8E %.4E %.4E\n"
+        p = p0;
+        for (j=0; j<nd; j++) {
+            p += capec_FmtE(p, np2dv(P,i,j), 8, 1);
+            *(p++) = ' ';
         }
+        p += capec_FmtE(p, np1dv(blds,i), 4, 0);
+        *(p++) = ' ';
+        p += capec_FmtE(p, np1dv(bldel,i), 4, 0);
+        *(p++) = '\n';
+        // Save the row
+        capec_FmtBufCommit(&b, p - p0);
+        // Increase the count.
+        n += 1;
     }
-    else {
-        // Three-dimensional nodes
-        for (i=0; i<nNode; i++) {
-            // Write a single node
-            fprintf(fid, "%+15.8E %+15.8E %+15.8E %.4E %.4E\n", \
-                np2d(P,i,0), np2d(P,i,1), np2d(P,i,2), \
-                np1d(blds,i), np1d(bldel,i));
-            // Increase the count.
-            n += 1;
-        }
+    
+    // Write remaining text
+    if (capec_FmtBufClose(&b)) {
+        return capeIO_ERR_WRITE;
     }
     
     // Check count.
     if (n != nNode) {
-        return 1;
+        return capeIO_ERR_WRITE;
     }
     
     // Good output
@@ -138,33 +173,57 @@ capec_WriteSurfNodes(FILE *fid, PyArrayObject *P, \
 int
 capec_WriteTriTris(FILE *fid, PyArrayObject *T)
 {
-    int i;
-    int n, nTri;
+    size_t i, n, nTri;
+    char *p0, *p;
+    capecFmtBuf b;
     
     // Number of values written.
     n = 0;
     
     // Check for two-dimensional Nx3 array.
     if (PyArray_NDIM(T) != 2 || PyArray_DIM(T, 1) != 3) {
-        PyErr_SetString(PyExc_ValueError, \
-            "Nodal indices must be Nx3 array.");
-        return 2;
+        return capeIO_ERR_SHAPE;
     }
     // Read number of triangles.
-    nTri = (int) PyArray_DIM(T, 0);
+    nTri = (size_t) PyArray_DIM(T, 0);
+    
+    // Check for arrays pinned by capec_PinView()
+    if (!capec_ViewOK(T, NPY_INT)) {
+        return capeIO_ERR_SHAPE;
+    }
+    
+    // Create text buffer
+    if (capec_FmtBufInit(&b, fid)) {
+        return capeIO_ERR_MEM;
+    }
     
     // Loop through triangles.
     for (i=0; i<nTri; i++) {
-        // Write a single triangle.
-        fprintf(fid, "%i %i %i\n", \
-            np2i(T,i,0), np2i(T,i,1), np2i(T,i,2));
+        // Get room for one row
+        p0 = capec_FmtBufReserve(&b, 3*24);
+        if (p0 == NULL) {break; }
+        // Write a single triangle: "%i %i %i\n"
+        p = p0;
+        p += capec_FmtI(p, np2iv(T,i,0));
+        *(p++) = ' ';
+        p += capec_FmtI(p, np2iv(T,i,1));
+        *(p++) = ' ';
+        p += capec_FmtI(p, np2iv(T,i,2));
+        *(p++) = '\n';
+        // Save the row
+        capec_FmtBufCommit(&b, p - p0);
         // Increase the count.
         n += 1;
     }
     
+    // Write remaining text
+    if (capec_FmtBufClose(&b)) {
+        return capeIO_ERR_WRITE;
+    }
+    
     // Check count.
     if (n != nTri) {
-        return 1;
+        return capeIO_ERR_WRITE;
     }
     
     // Good output
@@ -177,46 +236,73 @@ int
 capec_WriteSurfTris(FILE *fid, PyArrayObject *T,
     PyArrayObject *C, PyArrayObject *BC)
 {
-    int i;
-    int n, nTri;
+    size_t i, n, nTri;
+    char *p0, *p;
+    capecFmtBuf b;
     
     // Number of values written.
     n = 0;
     
     // Check for two-dimensional Nx3 array.
     if (PyArray_NDIM(T) != 2 || PyArray_DIM(T, 1) != 3) {
-        PyErr_SetString(PyExc_ValueError, \
-            "Triangle nodes must be Nx3 array.");
-        return 2;
+        return capeIO_ERR_SHAPE;
     }
     // Read number of triangles.
-    nTri = (int) PyArray_DIM(T, 0);
+    nTri = (size_t) PyArray_DIM(T, 0);
     // Check for one-dimensional Mx1 array.
     if (PyArray_NDIM(C) != 1 || PyArray_DIM(C,0) != nTri) {
-        PyErr_SetString(PyExc_ValueError, \
-            "Face labels must be 1D array with one per tri.");
-        return 2;
+        return capeIO_ERR_SHAPE;
     }
     // Check for one-dimensional Mx1 array.
     if (PyArray_NDIM(BC) != 1 || PyArray_DIM(BC,0) != nTri) {
-        PyErr_SetString(PyExc_ValueError, \
-            "Boundary condition tags must be 1D array with one per tri.");
-        return 2;
+        return capeIO_ERR_SHAPE;
+    }
+    
+    // Check for arrays pinned by capec_PinView()
+    if (!capec_ViewOK(T, NPY_INT) ||
+            !capec_ViewOK(C, NPY_INT) ||
+            !capec_ViewOK(BC, NPY_INT)) {
+        return capeIO_ERR_SHAPE;
+    }
+    
+    // Create text buffer
+    if (capec_FmtBufInit(&b, fid)) {
+        return capeIO_ERR_MEM;
     }
     
     // Loop through triangles
     for (i=0; i<nTri; i++) {
-        // Write triangle nodes
-        fprintf(fid, "%i %i %i ", np2i(T,i,0), np2i(T,i,1), np2i(T,i,2));
-        // Write component ID, reconnect flag (0), and BC
-        fprintf(fid, "%i 0 %i\n", np1i(C,i), np1i(BC,i));
+        // Get room for one row
+        p0 = capec_FmtBufReserve(&b, 6*24);
+        if (p0 == NULL) {break; }
+        // Write triangle nodes: "%i %i %i "
+        p = p0;
+        p += capec_FmtI(p, np2iv(T,i,0));
+        *(p++) = ' ';
+        p += capec_FmtI(p, np2iv(T,i,1));
+        *(p++) = ' ';
+        p += capec_FmtI(p, np2iv(T,i,2));
+        *(p++) = ' ';
+        // Write component ID, reconnect flag (0), and BC: "%i 0 %i\n"
+        p += capec_FmtI(p, np1iv(C,i));
+        memcpy(p, " 0 ", 3);
+        p += 3;
+        p += capec_FmtI(p, np1iv(BC,i));
+        *(p++) = '\n';
+        // Save the row
+        capec_FmtBufCommit(&b, p - p0);
         // Increase count.
         n += 1;
     }
     
+    // Write remaining text
+    if (capec_FmtBufClose(&b)) {
+        return capeIO_ERR_WRITE;
+    }
+    
     // Check count.
     if (n != nTri) {
-        return 1;
+        return capeIO_ERR_WRITE;
     }
     
     // Good output
@@ -228,47 +314,75 @@ int
 capec_WriteSurfQuads(FILE *fid, PyArrayObject *Q,
     PyArrayObject *C, PyArrayObject *BC)
 {
-    int i;
-    int n, nQuad;
+    size_t i, n, nQuad;
+    char *p0, *p;
+    capecFmtBuf b;
     
     // Number of values written.
     n = 0;
     
     // Check for two-dimensional Nx3 array.
     if (PyArray_NDIM(Q) != 2 || PyArray_DIM(Q, 1) != 4) {
-        PyErr_SetString(PyExc_ValueError, \
-            "Quad nodes must be Nx4 array.");
-        return 2;
+        return capeIO_ERR_SHAPE;
     }
     // Read number of triangles.
-    nQuad = (int) PyArray_DIM(Q, 0);
+    nQuad = (size_t) PyArray_DIM(Q, 0);
     // Check for one-dimensional Mx1 array.
     if (PyArray_NDIM(C) != 1 || PyArray_DIM(C,0) != nQuad) {
-        PyErr_SetString(PyExc_ValueError, \
-            "Face labels must be 1D array with one per tri.");
-        return 2;
+        return capeIO_ERR_SHAPE;
     }
     // Check for one-dimensional Mx1 array.
     if (PyArray_NDIM(BC) != 1 || PyArray_DIM(BC,0) != nQuad) {
-        PyErr_SetString(PyExc_ValueError, \
-            "Boundary condition tags must be 1D array with one per tri.");
-        return 2;
+        return capeIO_ERR_SHAPE;
+    }
+    
+    // Check for arrays pinned by capec_PinView()
+    if (!capec_ViewOK(Q, NPY_INT) ||
+            !capec_ViewOK(C, NPY_INT) ||
+            !capec_ViewOK(BC, NPY_INT)) {
+        return capeIO_ERR_SHAPE;
+    }
+    
+    // Create text buffer
+    if (capec_FmtBufInit(&b, fid)) {
+        return capeIO_ERR_MEM;
     }
     
     // Loop through triangles
     for (i=0; i<nQuad; i++) {
-        // Write triangle nodes
-        fprintf(fid, "%i %i %i %i ",
-            np2i(Q,i,0), np2i(Q,i,1), np2i(Q,i,2), np2i(Q,i,3));
-        // Write component ID, reconnect flag (0), and BC
-        fprintf(fid, "%i 0 %i\n", np1i(C,i), np1i(BC,i));
+        // Get room for one row
+        p0 = capec_FmtBufReserve(&b, 7*24);
+        if (p0 == NULL) {break; }
+        // Write quad nodes: "%i %i %i %i "
+        p = p0;
+        p += capec_FmtI(p, np2iv(Q,i,0));
+        *(p++) = ' ';
+        p += capec_FmtI(p, np2iv(Q,i,1));
+        *(p++) = ' ';
+        p += capec_FmtI(p, np2iv(Q,i,2));
+        *(p++) = ' ';
+        p += capec_FmtI(p, np2iv(Q,i,3));
+        *(p++) = ' ';
+        // Write component ID, reconnect flag (0), and BC: "%i 0 %i\n"
+        p += capec_FmtI(p, np1iv(C,i));
+        memcpy(p, " 0 ", 3);
+        p += 3;
+        p += capec_FmtI(p, np1iv(BC,i));
+        *(p++) = '\n';
+        // Save the row
+        capec_FmtBufCommit(&b, p - p0);
         // Increase count.
         n += 1;
     }
     
+    // Write remaining text
+    if (capec_FmtBufClose(&b)) {
+        return capeIO_ERR_WRITE;
+    }
+    
     // Check count.
     if (n != nQuad) {
-        return 1;
+        return capeIO_ERR_WRITE;
     }
     
     // Good output
@@ -280,32 +394,53 @@ capec_WriteSurfQuads(FILE *fid, PyArrayObject *Q,
 int
 capec_WriteTriCompID(FILE *fid, PyArrayObject *C)
 {
-    int i;
-    int n, nTri;
+    size_t i, n, nTri;
+    char *p0, *p;
+    capecFmtBuf b;
     
     // Number of values written.
     n = 0;
     
     // Check for two-dimensional Mx1 array.
     if (PyArray_NDIM(C) != 1) {
-        PyErr_SetString(PyExc_ValueError, \
-            "Nodal coordinates must be one-dimensional array.");
-        return 2;
+        return capeIO_ERR_SHAPE;
     }
     // Read number of triangles.
-    nTri = (int) PyArray_DIM(C, 0);
+    nTri = (size_t) PyArray_DIM(C, 0);
+    
+    // Check for arrays pinned by capec_PinView()
+    if (!capec_ViewOK(C, NPY_INT)) {
+        return capeIO_ERR_SHAPE;
+    }
+    
+    // Create text buffer
+    if (capec_FmtBufInit(&b, fid)) {
+        return capeIO_ERR_MEM;
+    }
     
     // Loop through triangles.
     for (i=0; i<nTri; i++) {
-        // Write a single triangle.
-        fprintf(fid, "%i\n", np1i(C,i));
+        // Get room for one row
+        p0 = capec_FmtBufReserve(&b, 24);
+        if (p0 == NULL) {break; }
+        // Write a single triangle: "%i\n"
+        p = p0;
+        p += capec_FmtI(p, np1iv(C,i));
+        *(p++) = '\n';
+        // Save the row
+        capec_FmtBufCommit(&b, p - p0);
         // Increase count.
         n += 1;
     }
     
+    // Write remaining text
+    if (capec_FmtBufClose(&b)) {
+        return capeIO_ERR_WRITE;
+    }
+    
     // Check count.
     if (n != nTri) {
-        return 1;
+        return capeIO_ERR_WRITE;
     }
     
     // Good output
@@ -317,43 +452,630 @@ capec_WriteTriCompID(FILE *fid, PyArrayObject *C)
 int
 capec_WriteTriState(FILE *fid, PyArrayObject *Q)
 {
-    int i, j;
-    int n, nNode, nq;
+    int j, nq;
+    size_t i, n, nNode;
+    char *p0, *p;
+    capecFmtBuf b;
     
     // Number of values written.
     n = 0;
     
     // Check for two-dimensional Nx3 array.
     if (PyArray_NDIM(Q) != 2) {
-        PyErr_SetString(PyExc_ValueError, \
-            "State must be a two-dimensional array.");
-        return 2;
+        return capeIO_ERR_SHAPE;
     }
     // Read number of triangles.
-    nNode = (int) PyArray_DIM(Q, 0);
+    nNode = (size_t) PyArray_DIM(Q, 0);
     // Read number of states.
     nq = (int) PyArray_DIM(Q, 1);
     
+    // Check for arrays pinned by capec_PinView()
+    if (!capec_ViewOK(Q, NPY_DOUBLE)) {
+        return capeIO_ERR_SHAPE;
+    }
+    
+    // Create text buffer
+    if (capec_FmtBufInit(&b, fid)) {
+        return capeIO_ERR_MEM;
+    }
+    
     // Loop through triangles.
-    for (i=0; i<nNode; i++) {
-        // Write a the first entry (Cp).
-        fprintf(fid, "%.6f\n", np2d(Q,i,0));
-        // Loop through remaining state variables.
+    for (i=0; i<nNode && !b.ierr; i++) {
+        // Get room for the first entry; rows of wide *Q* can exceed buffer
+        p0 = capec_FmtBufReserve(&b, capeFMT_MAXNUM + 2);
+        if (p0 == NULL) {break; }
+        // Write a the first entry (Cp): "%.6f\n"
+        p = p0;
+        p += capec_FmtF(p, np2dv(Q,i,0), 6);
+        *(p++) = '\n';
+        capec_FmtBufCommit(&b, p - p0);
+        // Loop through remaining state variables: " %.6f"
         for (j=1; j<nq; j++) {
-            // Write the value.
-            fprintf(fid, " %.6f", np2d(Q,i,j));
+            // Get room for one entry
+            p0 = capec_FmtBufReserve(&b, capeFMT_MAXNUM + 1);
+            if (p0 == NULL) {break; }
+            p = p0;
+            *(p++) = ' ';
+            p += capec_FmtF(p, np2dv(Q,i,j), 6);
+            capec_FmtBufCommit(&b, p - p0);
         }
         // End the line.
-        fprintf(fid, "\n");
+        p0 = capec_FmtBufReserve(&b, 1);
+        if (p0 == NULL) {break; }
+        *p0 = '\n';
+        capec_FmtBufCommit(&b, 1);
         // Increase the count.
         n += 1;
     }
     
+    // Write remaining text
+    if (capec_FmtBufClose(&b)) {
+        return capeIO_ERR_WRITE;
+    }
+    
     // Check count.
     if (n != nNode) {
-        return 1;
+        return capeIO_ERR_WRITE;
     }
     
     // Good output
     return 0;
 }
+
+
+// Number of facets per block of STL output
+#define capeSTL_BLOCK 4096
+
+// Check node indices of each tri before writing anything
+static int
+capec_STLCheck(PyArrayObject *P, PyArrayObject *T, PyArrayObject *N)
+{
+    int j;
+    long t, nNode;
+    size_t i, n;
+    
+    // Check for pinned Nx3 arrays
+    if (PyArray_NDIM(P) != 2 || PyArray_DIM(P, 1) != 3 ||
+            PyArray_NDIM(T) != 2 || PyArray_DIM(T, 1) != 3 ||
+            !capec_ViewOK(P, NPY_DOUBLE) || !capec_ViewOK(T, NPY_INT)) {
+        return capeIO_ERR_SHAPE;
+    }
+    // Check normals, if any
+    if (N != NULL && (PyArray_NDIM(N) != 2 || PyArray_DIM(N, 1) != 3 ||
+            PyArray_DIM(N, 0) != PyArray_DIM(T, 0) ||
+            !capec_ViewOK(N, NPY_DOUBLE))) {
+        return capeIO_ERR_SHAPE;
+    }
+    // Number of tris and nodes
+    nNode = (long) PyArray_DIM(P, 0);
+    n = (size_t) PyArray_DIM(T, 0);
+    // Check each index (1-based)
+    for (i=0; i<n; i++) {
+        for (j=0; j<3; j++) {
+            t = np2iv(T, i, j);
+            if (t < 1 || t > nNode) {
+                return capeIO_ERR_SHAPE;
+            }
+        }
+    }
+    return 0;
+}
+
+// Get normal and vertices of *k* facets starting from *i0*
+static void
+capec_STLGather(double *D, PyArrayObject *P, PyArrayObject *T,
+    PyArrayObject *N, size_t i0, size_t k)
+{
+    size_t j;
+    int m, v;
+    long t;
+    double ax, ay, az, bx, by, bz, nx, ny, nz, a;
+    double *d;
+    
+    // Copy vertices; 12 values per facet (normal, then three vertices)
+    for (j=0; j<k; j++) {
+        d = D + 12*j;
+        for (v=0; v<3; v++) {
+            t = np2iv(T, i0 + j, v) - 1;
+            for (m=0; m<3; m++) {
+                d[3 + 3*v + m] = np2dv(P, t, m);
+            }
+        }
+    }
+    // Use normals from caller if given
+    if (N != NULL) {
+        for (j=0; j<k; j++) {
+            for (m=0; m<3; m++) {
+                D[12*j + m] = np2dv(N, i0 + j, m);
+            }
+        }
+        return;
+    }
+    // Unit normals from cross product of two edges
+    for (j=0; j<k; j++) {
+        d = D + 12*j;
+        // Edges from first vertex
+        ax = d[6] - d[3];
+        ay = d[7] - d[4];
+        az = d[8] - d[5];
+        bx = d[9]  - d[3];
+        by = d[10] - d[4];
+        bz = d[11] - d[5];
+        // Cross product
+        nx = ay*bz - az*by;
+        ny = az*bx - ax*bz;
+        nz = ax*by - ay*bx;
+        // Normalize (degenerate tris get zero normal)
+        a = sqrt(nx*nx + ny*ny + nz*nz);
+        a = (a > 0.0) ? 1.0/a : 0.0;
+        d[0] = nx*a;
+        d[1] = ny*a;
+        d[2] = nz*a;
+    }
+}
+
+// Function to write binary STL
+int
+capec_WriteTriSTLBin(FILE *fid, PyArrayObject *P, PyArrayObject *T,
+    PyArrayObject *N)
+{
+    int ierr;
+    size_t i, j, k, nTri;
+    unsigned int n;
+    char header[80];
+    char *stage;
+    double *D;
+    float *F;
+    capecArena a = capeARENA_INIT;
+    
+    // Check inputs
+    ierr = capec_STLCheck(P, T, N);
+    if (ierr) {
+        return ierr;
+    }
+    // Number of facets
+    nTri = (size_t) PyArray_DIM(T, 0);
+    if (nTri > UINT_MAX) {
+        return capeIO_ERR_SHAPE;
+    }
+    
+    // Header, which must not start with "solid"
+    memset(header, 0, 80);
+    strcpy(header, "CAPE binary STL");
+    n = (unsigned int) nTri;
+    if (!is_le()) {n = __bswap_32(n); }
+    // Write header and number of facets
+    if (fwrite(header, 1, 80, fid) != 80 || fwrite(&n, 4, 1, fid) != 1) {
+        return capeIO_ERR_WRITE;
+    }
+    
+    // Allocate work space for one block
+    D = (double *) capec_ArenaNew(&a, capeSTL_BLOCK * 12, sizeof(double));
+    F = (float *) capec_ArenaNew(&a, capeSTL_BLOCK * 12, sizeof(float));
+    stage = (char *) capec_ArenaNew(&a, capeSTL_BLOCK, 50);
+    if (D == NULL || F == NULL || stage == NULL) {
+        ierr = capeIO_ERR_MEM;
+    }
+    
+    // Loop through blocks of facets
+    for (i=0; i<nTri && !ierr; i+=capeSTL_BLOCK) {
+        // Size of this block
+        k = (nTri - i < capeSTL_BLOCK) ? nTri - i : capeSTL_BLOCK;
+        // Normals and vertices
+        capec_STLGather(D, P, T, N, i, k);
+        // Convert to little-endian singles all at once
+        capec_NarrowF64(F, D, 12*k, !is_le());
+        // Pack 50-byte records: 12 floats and 2-byte attribute
+        for (j=0; j<k; j++) {
+            memcpy(stage + 50*j, F + 12*j, 48);
+            stage[50*j + 48] = 0;
+            stage[50*j + 49] = 0;
+        }
+        // Write block
+        if (fwrite(stage, 50, k, fid) != k) {
+            ierr = capeIO_ERR_WRITE;
+        }
+    }
+    
+    // Release work space
+    capec_ArenaDel(&a);
+    return ierr;
+}
+
+// Append "%+.8E" for three values, separated by spaces, and newline
+static char *
+capec_STLVec(char *p, const double *x)
+{
+    p += capec_FmtE(p, x[0], 8, 1);
+    *(p++) = ' ';
+    p += capec_FmtE(p, x[1], 8, 1);
+    *(p++) = ' ';
+    p += capec_FmtE(p, x[2], 8, 1);
+    *(p++) = '\n';
+    return p;
+}
+
+// Function to write ASCII STL
+int
+capec_WriteTriSTL(FILE *fid, PyArrayObject *P, PyArrayObject *T,
+    PyArrayObject *N)
+{
+    int ierr;
+    size_t i, j, k, nTri;
+    char *p0, *p;
+    double *D, *d;
+    capecFmtBuf b;
+    
+    // Check inputs
+    ierr = capec_STLCheck(P, T, N);
+    if (ierr) {
+        return ierr;
+    }
+    // Number of facets
+    nTri = (size_t) PyArray_DIM(T, 0);
+    
+    // Allocate work space for one block
+    D = (double *) capec_PoolNew(capeSTL_BLOCK * 12 * sizeof(double));
+    if (D == NULL) {
+        return capeIO_ERR_MEM;
+    }
+    // Create text buffer
+    if (capec_FmtBufInit(&b, fid)) {
+        capec_PoolDel(D);
+        return capeIO_ERR_MEM;
+    }
+    
+    // Header
+    p0 = capec_FmtBufReserve(&b, 6);
+    if (p0 != NULL) {
+        memcpy(p0, "solid\n", 6);
+        capec_FmtBufCommit(&b, 6);
+    }
+    // Loop through blocks of facets
+    for (i=0; i<nTri && !b.ierr; i+=capeSTL_BLOCK) {
+        // Size of this block
+        k = (nTri - i < capeSTL_BLOCK) ? nTri - i : capeSTL_BLOCK;
+        // Normals and vertices
+        capec_STLGather(D, P, T, N, i, k);
+        // Loop through facets in block
+        for (j=0; j<k; j++) {
+            d = D + 12*j;
+            // Get room for one facet
+            p0 = capec_FmtBufReserve(&b, 4*(3*capeFMT_MAXNUM + 24) + 64);
+            if (p0 == NULL) {break; }
+            p = p0;
+            // Normal
+            memcpy(p, "   facet normal   ", 18);
+            p = capec_STLVec(p + 18, d);
+            memcpy(p, "      outer loop\n", 17);
+            p += 17;
+            // Vertices
+            memcpy(p, "         vertex   ", 18);
+            p = capec_STLVec(p + 18, d + 3);
+            memcpy(p, "         vertex   ", 18);
+            p = capec_STLVec(p + 18, d + 6);
+            memcpy(p, "         vertex   ", 18);
+            p = capec_STLVec(p + 18, d + 9);
+            // Facet footer
+            memcpy(p, "      endloop\n   endfacet\n", 26);
+            p += 26;
+            // Save the facet
+            capec_FmtBufCommit(&b, p - p0);
+        }
+    }
+    // Footer
+    p0 = capec_FmtBufReserve(&b, 9);
+    if (p0 != NULL) {
+        memcpy(p0, "endsolid\n", 9);
+        capec_FmtBufCommit(&b, 9);
+    }
+    
+    // Release work space
+    capec_PoolDel(D);
+    // Write remaining text; error flag is sticky
+    if (capec_FmtBufClose(&b)) {
+        return capeIO_ERR_WRITE;
+    }
+    return 0;
+}
+
+
+// Read a record marker, or -1 if no room left in file
+static long
+capec_TriBinMarker(const char *data, size_t size, size_t i, int swap)
+{
+    unsigned u;
+    
+    // Check for room
+    if (i + 4 > size)
+        return -1;
+    // Read and swap
+    memcpy(&u, data + i, 4);
+    if (swap) {u = __bswap_32(u); }
+    return (long) u;
+}
+
+// Read a 4- or 8-byte header count, or -1 if no room or negative
+static long long
+capec_TriBinCount(const char *data, size_t size, size_t i, int ni, int swap)
+{
+    long r;
+    int64_t u;
+    
+    // Four-byte integer
+    if (ni == 4) {
+        r = capec_TriBinMarker(data, size, i, swap);
+        return (r > INT_MAX) ? -1 : (long long) r;
+    }
+    // Check for room
+    if (i + 8 > size)
+        return -1;
+    // Read and swap
+    memcpy(&u, data + i, 8);
+    if (swap) {u = __bswap_64(u); }
+    return (u < 0) ? -1 : (long long) u;
+}
+
+// Read leading marker of a sub-record; negative if more sub-records follow
+static int
+capec_TriBinSub(const char *data, size_t size, size_t i, int swap,
+    size_t *len, int *more)
+{
+    long r;
+    
+    // Read marker as unsigned
+    r = capec_TriBinMarker(data, size, i, swap);
+    if (r < 0)
+        return 1;
+    // Interpret as signed 4-byte integer
+    *more = (r > INT_MAX);
+    *len = (size_t) (*more ? 0x100000000L - r : r);
+    return 0;
+}
+
+// Total length of record, including any later sub-records, or -1
+static long long
+capec_TriBinLength(const char *data, size_t size, size_t i, int swap)
+{
+    int more = 1;
+    size_t len, nb = 0;
+    
+    // Follow leading markers of each sub-record
+    while (more) {
+        if (capec_TriBinSub(data, size, i, swap, &len, &more))
+            return -1;
+        nb += len;
+        i += len + 8;
+    }
+    return (long long) nb;
+}
+
+// Find start of record with expected size; return offset of data
+//  Records split into sub-records (as gfortran writes records over 2 GiB)
+//  are joined in place by moving each payload forward, so the data of the
+//  record starts right after the first marker either way.
+static int
+capec_TriBinRecord(char *data, size_t size, size_t *i, int swap,
+    size_t nb, const char *name)
+{
+    int first, more;
+    long r;
+    long long m;
+    size_t j, n, len;
+    
+    // Leading marker
+    if (capec_TriBinMarker(data, size, *i, swap) < 0) {
+        PyErr_Format(PyExc_ValueError,
+            "File ended before start of %s record", name);
+        return 2;
+    }
+    // Total size of sub-records
+    m = capec_TriBinLength(data, size, *i, swap);
+    if (m < 0) {
+        PyErr_Format(PyExc_ValueError,
+            "File ended within %s record", name);
+        return 2;
+    }
+    // Check it
+    if ((size_t) m != nb) {
+        PyErr_Format(PyExc_ValueError,
+            "Expected %zu bytes in %s record but marker indicates %lli",
+            nb, name, m);
+        return 2;
+    }
+    // Loop through sub-records
+    for (j=*i, n=0, first=1, more=1; more; first=0) {
+        // Leading marker of sub-record
+        if (capec_TriBinSub(data, size, j, swap, &len, &more)) {
+            PyErr_Format(PyExc_ValueError,
+                "File ended within %s record", name);
+            return 2;
+        }
+        // Trailing marker; negative after first sub-record
+        r = capec_TriBinMarker(data, size, j + 4 + len, swap);
+        if (r < 0 || (size_t) (first ? r : 0x100000000L - r) != len) {
+            PyErr_Format(PyExc_ValueError,
+                "Missing or invalid end-of-record marker for %s", name);
+            return 2;
+        }
+        // Join to previous sub-records (mapping is copy-on-write)
+        if (!first)
+            memmove(data + *i + 4 + n, data + j + 4, len);
+        n += len;
+        j += len + 8;
+    }
+    // Move to next record
+    *i = j;
+    return 0;
+}
+
+// Check size of header record: two or three 4- or 8-byte ints
+static int
+capec_TriBinHeader(long r)
+{
+    return r == 8 || r == 12 || r == 16 || r == 24;
+}
+
+// Parse layout of binary tri file
+int
+capec_ParseTriBin(char *data, size_t size, capecTriBin *t)
+{
+    int j;
+    int nh;
+    long r;
+    long long m;
+    long long hdr[3];
+    size_t i, nb;
+    
+    // Initialize
+    memset(t, 0, sizeof(capecTriBin));
+    // Interpret first marker in native byte order
+    r = capec_TriBinMarker(data, size, 0, 0);
+    // Check for 2 or 3 ints; otherwise try other byte order
+    if (!capec_TriBinHeader(r)) {
+        t->swap = 1;
+        r = capec_TriBinMarker(data, size, 0, 1);
+    }
+    // Check header size
+    if (!capec_TriBinHeader(r)) {
+        PyErr_SetString(PyExc_ValueError,
+            "File does not start with binary TRI header record");
+        return 2;
+    }
+    // Integer size and number of counts
+    t->ni = (r > 12) ? 8 : 4;
+    nh = (int) (r / t->ni);
+    // Check header record
+    i = 0;
+    if (capec_TriBinRecord(data, size, &i, t->swap, (size_t) r, "header"))
+        return 2;
+    // Read header
+    hdr[2] = 0;
+    for (j=0; j<nh; j++) {
+        hdr[j] = capec_TriBinCount(data, size, 4 + t->ni*j, t->ni, t->swap);
+    }
+    // Check values
+    if (hdr[0] < 0 || hdr[1] < 0 || hdr[2] < 0) {
+        PyErr_SetString(PyExc_ValueError,
+            "Negative size in binary TRI header");
+        return 2;
+    }
+    if ((size_t) hdr[0] > size || (size_t) hdr[1] > size ||
+            (size_t) hdr[2] > size) {
+        PyErr_SetString(PyExc_ValueError,
+            "Counts in binary TRI header exceed size of file");
+        return 2;
+    }
+    t->nNode = (size_t) hdr[0];
+    t->nTri  = (size_t) hdr[1];
+    t->nq    = (size_t) hdr[2];
+    
+    // Precision from total size of node record
+    m = capec_TriBinLength(data, size, i, t->swap);
+    if (m >= 0 && (size_t) m == 24 * t->nNode) {
+        t->nf = 8;
+    } else {
+        t->nf = 4;
+    }
+    // Nodes
+    nb = 3 * (size_t) t->nf * t->nNode;
+    t->iNodes = i + 4;
+    if (capec_TriBinRecord(data, size, &i, t->swap, nb, "nodes"))
+        return 2;
+    // Tris
+    nb = 3 * (size_t) t->ni * t->nTri;
+    t->iTris = i + 4;
+    if (capec_TriBinRecord(data, size, &i, t->swap, nb, "tris"))
+        return 2;
+    // Component IDs are optional
+    if (i >= size)
+        return 0;
+    nb = (size_t) t->ni * t->nTri;
+    t->iCompID = i + 4;
+    if (capec_TriBinRecord(data, size, &i, t->swap, nb, "compID"))
+        return 2;
+    // States are optional
+    if (i >= size || t->nq == 0)
+        return 0;
+    nb = (size_t) t->nf * t->nNode * t->nq;
+    t->iq = i + 4;
+    if (capec_TriBinRecord(data, size, &i, t->swap, nb, "state"))
+        return 2;
+    // Output
+    return 0;
+}
+
+// Check whether stream tri layout matches size of file
+static int
+capec_TriStreamSize(capecTriBin *t, int nh, size_t size)
+{
+    size_t i;
+    
+    // Counts can't exceed size of file (avoids overflow below)
+    if (t->nNode > size || t->nTri > size || t->nq > size)
+        return 0;
+    // Offsets to nodes and tris
+    t->iNodes = (size_t) t->ni * (size_t) nh;
+    t->iTris = t->iNodes + 3 * (size_t) t->nf * t->nNode;
+    // File with nodes and tris only
+    i = t->iTris + 3 * (size_t) t->ni * t->nTri;
+    t->iCompID = 0;
+    t->iq = 0;
+    if (i == size)
+        return 1;
+    // File with compIDs
+    t->iCompID = i;
+    i += (size_t) t->ni * t->nTri;
+    if (i == size)
+        return 1;
+    // File with states
+    t->iq = i;
+    i += (size_t) t->nf * t->nNode * t->nq;
+    return (t->nq > 0 && i == size);
+}
+
+// Parse layout of Fortran stream tri file (no record markers)
+int
+capec_ParseTriStream(char *data, size_t size, capecTriBin *t)
+{
+    int j, nh, swap, nf, ni;
+    long long hdr[3];
+    
+    // Initialize
+    memset(t, 0, sizeof(capecTriBin));
+    // Try each byte order, integer size, header size, and precision
+    for (swap=0; swap<2; swap++) {
+        for (ni=4; ni<=8; ni+=4) {
+            // Read header
+            for (j=0; j<3; j++) {
+                hdr[j] = capec_TriBinCount(data, size, ni*j, ni, swap);
+            }
+            // Check for valid counts
+            if (hdr[0] < 0 || hdr[1] < 0)
+                continue;
+            // Try three-int header (triq) first
+            for (nh=3; nh>=2; nh--) {
+                // Check *nq*
+                if (nh == 3 && hdr[2] < 0)
+                    continue;
+                for (nf=4; nf<=8; nf+=4) {
+                    // Save layout
+                    t->swap = swap;
+                    t->nf = nf;
+                    t->ni = ni;
+                    t->nNode = (size_t) hdr[0];
+                    t->nTri = (size_t) hdr[1];
+                    t->nq = (nh == 3) ? (size_t) hdr[2] : 0;
+                    // Check total size
+                    if (capec_TriStreamSize(t, nh, size))
+                        return 0;
+                }
+            }
+        }
+    }
+    // No match
+    memset(t, 0, sizeof(capecTriBin));
+    PyErr_SetString(PyExc_ValueError,
+        "File size does not match any stream TRI layout");
+    return 2;
+}
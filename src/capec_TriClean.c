@@ -0,0 +1,337 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <math.h>
+
+// Local includes
+#include "capec_TriClean.h"
+
+// Multiplier for hashing cells (Fibonacci hashing)
+#define capeCLEAN_HASH 0x9E3779B97F4A7C15ULL
+
+
+// ======================================================================
+// UTILITIES
+// ======================================================================
+
+// Check node indices of tris
+static int
+capec_CleanCheck(const int *T, size_t ntri, size_t nnode)
+{
+    size_t i;
+    
+    // Node indices must fit in 4-byte ints
+    if (nnode > INT_MAX) {
+        return capeCLEAN_ERR_SIZE;
+    }
+    // Check each node index
+    for (i=0; i<3*ntri; i++) {
+        if (T[i] < 1 || (size_t) T[i] > nnode) {
+            return capeCLEAN_ERR_INDEX;
+        }
+    }
+    return capeCLEAN_OK;
+}
+
+// Renumber tris and move nodes forward using map from old to new index
+//  J[i] is new index of node i, or -1 if it is removed; new indices must
+//  first appear in increasing order.  On output J[i] is the old index of
+//  new node i.
+static size_t
+capec_CleanApplyMap(double *X, size_t nnode, int *T, size_t ntri, int *J)
+{
+    int j;
+    size_t i, n;
+    
+    // Renumber tris
+    for (i=0; i<3*ntri; i++) {
+        T[i] = J[T[i] - 1] + 1;
+    }
+    // Move the first node with each new index
+    for (n=0, i=0; i<nnode; i++) {
+        j = J[i];
+        if (j < 0 || (size_t) j != n) {
+            continue;
+        }
+        if (n < i) {
+            X[3*n] = X[3*i];
+            X[3*n + 1] = X[3*i + 1];
+            X[3*n + 2] = X[3*i + 2];
+        }
+        // Entries up to *i* have already been used
+        J[n++] = (int) i;
+    }
+    return n;
+}
+
+
+// ======================================================================
+// UNUSED NODES
+// ======================================================================
+
+// Remove nodes not used by any tri
+int
+capec_TriRemoveUnusedNodes(double *X, size_t *nnode, int *T, size_t ntri,
+    int *J)
+{
+    int ierr, n;
+    size_t i;
+    
+    // Check inputs
+    ierr = capec_CleanCheck(T, ntri, *nnode);
+    if (ierr) {
+        return ierr;
+    }
+    // Mark nodes in use
+    for (i=0; i<*nnode; i++) {
+        J[i] = -1;
+    }
+    for (i=0; i<3*ntri; i++) {
+        J[T[i] - 1] = 0;
+    }
+    // Number them in order
+    for (n=0, i=0; i<*nnode; i++) {
+        if (J[i] == 0) {
+            J[i] = n++;
+        }
+    }
+    // Renumber and move nodes
+    *nnode = capec_CleanApplyMap(X, *nnode, T, ntri, J);
+    return capeCLEAN_OK;
+}
+
+
+// ======================================================================
+// WELD
+// ======================================================================
+
+// Cell index of one coordinate
+static int64_t
+capec_WeldCell(double x, double tol)
+{
+    int64_t b;
+    double y;
+    
+    // Exact matches: use bits of coordinate (folding -0.0 into 0.0)
+    if (tol <= 0) {
+        x += 0.0;
+        memcpy(&b, &x, sizeof(int64_t));
+        return b;
+    }
+    // Cube of width *tol*; far-away (or NaN) nodes share an outer cell
+    y = floor(x / tol);
+    if (!(fabs(y) < 1e18)) {
+        return INT64_C(1) << 62;
+    }
+    return (int64_t) y;
+}
+
+// Slot of hash table for cell (a, b, c)
+static size_t
+capec_WeldHash(int64_t a, int64_t b, int64_t c, int bits)
+{
+    uint64_t key;
+    
+    key = (uint64_t) a * 73856093ULL;
+    key ^= (uint64_t) b * 19349663ULL;
+    key ^= (uint64_t) c * 83492791ULL;
+    return (size_t) ((key * capeCLEAN_HASH) >> (64 - bits));
+}
+
+// Merge nodes within *tol* of each other
+int
+capec_TriWeldNodes(double *X, size_t *nnode, int *T, size_t ntri,
+    double tol, int *J)
+{
+    int ierr, r, da, db, dc, bits, n, k, kbest;
+    int *head, *next;
+    int64_t c[3];
+    size_t i, s, nslot;
+    double tol2, dx, dy, dz;
+    const double *x;
+    
+    // Check inputs
+    ierr = capec_CleanCheck(T, ntri, *nnode);
+    if (ierr) {
+        return ierr;
+    }
+    // Hash table with at least twice as many slots as nodes
+    for (bits=4, nslot=16; nslot < 2*(*nnode); bits++) {
+        nslot *= 2;
+    }
+    head = (int *) malloc(nslot*sizeof(int));
+    next = (int *) malloc((*nnode + 1)*sizeof(int));
+    if (head == NULL || next == NULL) {
+        free(head);
+        free(next);
+        return capeCLEAN_ERR_MEM;
+    }
+    memset(head, -1, nslot*sizeof(int));
+    // Search neighboring cells unless matches must be exact
+    r = (tol > 0);
+    tol2 = tol*tol;
+    
+    // Loop through nodes
+    for (n=0, i=0; i<*nnode; i++) {
+        x = X + 3*i;
+        c[0] = capec_WeldCell(x[0], tol);
+        c[1] = capec_WeldCell(x[1], tol);
+        c[2] = capec_WeldCell(x[2], tol);
+        // Find lowest-indexed kept node within tolerance
+        kbest = -1;
+        for (da=-r; da<=r; da++) {
+            for (db=-r; db<=r; db++) {
+                for (dc=-r; dc<=r; dc++) {
+                    s = capec_WeldHash(c[0] + da, c[1] + db, c[2] + dc, bits);
+                    for (k=head[s]; k>=0; k=next[k]) {
+                        if (kbest >= 0 && k >= kbest) {
+                            continue;
+                        }
+                        dx = X[3*k] - x[0];
+                        dy = X[3*k + 1] - x[1];
+                        dz = X[3*k + 2] - x[2];
+                        if (dx*dx + dy*dy + dz*dz <= tol2) {
+                            kbest = k;
+                        }
+                    }
+                }
+            }
+        }
+        // Merge into that node
+        if (kbest >= 0) {
+            J[i] = J[kbest];
+            continue;
+        }
+        // Keep this node and add it to its cell
+        J[i] = n++;
+        s = capec_WeldHash(c[0], c[1], c[2], bits);
+        next[i] = head[s];
+        head[s] = (int) i;
+    }
+    free(head);
+    free(next);
+    // Renumber and move nodes
+    *nnode = capec_CleanApplyMap(X, *nnode, T, ntri, J);
+    return capeCLEAN_OK;
+}
+
+
+// ======================================================================
+// SMALL TRIS
+// ======================================================================
+
+// Find root of node in disjoint-set forest (with path halving)
+static int
+capec_CleanRoot(int *P, int i)
+{
+    while (P[i] != i) {
+        P[i] = P[P[i]];
+        i = P[i];
+    }
+    return i;
+}
+
+// Merge two nodes, keeping the higher index
+static void
+capec_CleanJoin(int *P, int a, int b)
+{
+    a = capec_CleanRoot(P, a);
+    b = capec_CleanRoot(P, b);
+    if (a < b) {
+        P[a] = b;
+    } else if (b < a) {
+        P[b] = a;
+    }
+}
+
+// Length squared of edge from node *a* to node *b*
+static double
+capec_CleanLen2(const double *X, int a, int b)
+{
+    double dx, dy, dz;
+    
+    dx = X[3*b] - X[3*a];
+    dy = X[3*b + 1] - X[3*a + 1];
+    dz = X[3*b + 2] - X[3*a + 2];
+    return dx*dx + dy*dy + dz*dz;
+}
+
+// Collapse small tris and remove unused nodes
+int
+capec_TriRemoveSmallTris(double *X, size_t *nnode, int *T, int *C,
+    size_t *ntri, double smalltri, int npass, int *J)
+{
+    int ierr, ipass, k, a, b, c, I[3];
+    size_t i, j, m, nsmall;
+    double u[3], v[3], w[3], L[3], A2;
+    
+    // Check inputs
+    ierr = capec_CleanCheck(T, *ntri, *nnode);
+    if (ierr) {
+        return ierr;
+    }
+    // Passes until no small tris are left
+    for (ipass=0; npass <= 0 || ipass < npass; ipass++) {
+        // Each node starts in its own set
+        for (i=0; i<*nnode; i++) {
+            J[i] = (int) i;
+        }
+        // Collapse edges of small tris
+        for (nsmall=0, j=0; j<*ntri; j++) {
+            I[0] = T[3*j] - 1;
+            I[1] = T[3*j + 1] - 1;
+            I[2] = T[3*j + 2] - 1;
+            // Twice the area
+            for (k=0; k<3; k++) {
+                u[k] = X[3*I[1] + k] - X[3*I[0] + k];
+                v[k] = X[3*I[2] + k] - X[3*I[0] + k];
+            }
+            w[0] = u[1]*v[2] - u[2]*v[1];
+            w[1] = u[2]*v[0] - u[0]*v[2];
+            w[2] = u[0]*v[1] - u[1]*v[0];
+            A2 = sqrt(w[0]*w[0] + w[1]*w[1] + w[2]*w[2]);
+            if (!(0.5*A2 <= smalltri)) {
+                continue;
+            }
+            nsmall++;
+            // Edge lengths (squared)
+            L[0] = capec_CleanLen2(X, I[0], I[1]);
+            L[1] = capec_CleanLen2(X, I[1], I[2]);
+            L[2] = capec_CleanLen2(X, I[2], I[0]);
+            // Collapse whole tri if all edges are short
+            if (L[0] <= smalltri && L[1] <= smalltri && L[2] <= smalltri) {
+                capec_CleanJoin(J, I[0], I[1]);
+                capec_CleanJoin(J, I[0], I[2]);
+                continue;
+            }
+            // Otherwise collapse shortest edge
+            k = (L[1] < L[0]) ? 1 : 0;
+            k = (L[2] < L[k]) ? 2 : k;
+            capec_CleanJoin(J, I[k], I[(k + 1) % 3]);
+        }
+        // Check for nothing to do
+        if (nsmall == 0) {
+            break;
+        }
+        // Renumber tris and remove ones with repeated nodes
+        for (m=0, j=0; j<*ntri; j++) {
+            a = capec_CleanRoot(J, T[3*j] - 1);
+            b = capec_CleanRoot(J, T[3*j + 1] - 1);
+            c = capec_CleanRoot(J, T[3*j + 2] - 1);
+            if (a == b || b == c || c == a) {
+                continue;
+            }
+            T[3*m] = a + 1;
+            T[3*m + 1] = b + 1;
+            T[3*m + 2] = c + 1;
+            if (C != NULL) {
+                C[m] = C[j];
+            }
+            m++;
+        }
+        *ntri = m;
+    }
+    // Remove nodes that were collapsed
+    return capec_TriRemoveUnusedNodes(X, nnode, T, *ntri, J);
+}
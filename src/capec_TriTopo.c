@@ -0,0 +1,187 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+
+// Local includes
+#include "capec_TriTopo.h"
+
+// Multiplier for hashing edges (Fibonacci hashing)
+#define capeTOPO_HASH 0x9E3779B97F4A7C15ULL
+
+
+// ======================================================================
+// BUILD
+// ======================================================================
+
+// Slot of hash table for edge from *a* to *b* (a <= b)
+static size_t
+capec_TopoHash(int a, int b, int bits)
+{
+    uint64_t key = ((uint64_t) (unsigned) a << 32) | (unsigned) b;
+    return (size_t) ((key * capeTOPO_HASH) >> (64 - bits));
+}
+
+// Find edges and adjacency
+int
+capec_TriTopoBuild(capecTriTopo *g, const int *T, size_t ntri,
+    size_t nnode)
+{
+    int a, b, e, k, tk, bits;
+    int *slots, *cnt;
+    size_t i, j, s, mask, nslot, m, n;
+    
+    // Initialize
+    memset(g, 0, sizeof(capecTriTopo));
+    g->nnode = nnode;
+    g->ntri = ntri;
+    // Check sizes (CSR offsets are 4-byte ints)
+    if (ntri > INT_MAX / 3 || nnode > INT_MAX)
+        return capeTOPO_ERR_SIZE;
+    m = 3*ntri;
+    // Check node indices
+    for (i=0; i<m; i++) {
+        if (T[i] < 1 || (size_t) T[i] > nnode)
+            return capeTOPO_ERR_INDEX;
+    }
+    // Hash table with at least twice as many slots as sides
+    for (bits=4, nslot=16; nslot < 2*m; bits++)
+        nslot *= 2;
+    mask = nslot - 1;
+    // Allocate
+    g->n2t_ptr = (int *) calloc(nnode + 1, sizeof(int));
+    g->n2t = (int *) malloc((m + 1)*sizeof(int));
+    g->edges = (int *) malloc((2*m + 1)*sizeof(int));
+    g->tri_edges = (int *) malloc((m + 1)*sizeof(int));
+    g->e2t = (int *) malloc((m + 1)*sizeof(int));
+    g->t2t_ptr = (int *) calloc(ntri + 1, sizeof(int));
+    slots = (int *) malloc(nslot*sizeof(int));
+    cnt = (int *) calloc(m + 1, sizeof(int));
+    if (!g->n2t_ptr || !g->n2t || !g->edges || !g->tri_edges || !g->e2t ||
+            !g->t2t_ptr || !slots || !cnt) {
+        free(slots);
+        free(cnt);
+        capec_TriTopoFree(g);
+        return capeTOPO_ERR_MEM;
+    }
+    
+    // Node-to-tri: count, offsets, then fill (counting sort)
+    for (i=0; i<m; i++)
+        g->n2t_ptr[T[i]]++;
+    for (i=0; i<nnode; i++)
+        g->n2t_ptr[i + 1] += g->n2t_ptr[i];
+    for (j=0; j<ntri; j++) {
+        for (k=0; k<3; k++)
+            g->n2t[g->n2t_ptr[T[3*j + k] - 1]++] = (int) j;
+    }
+    // Fill moved each offset to the start of the next node
+    for (i=nnode; i>0; i--)
+        g->n2t_ptr[i] = g->n2t_ptr[i - 1];
+    g->n2t_ptr[0] = 0;
+    
+    // Unique edges from hash table, counting tris of each edge
+    memset(slots, -1, nslot*sizeof(int));
+    for (j=0; j<ntri; j++) {
+        for (k=0; k<3; k++) {
+            a = T[3*j + k] - 1;
+            b = T[3*j + (k + 1) % 3] - 1;
+            if (a > b) {
+                tk = a;
+                a = b;
+                b = tk;
+            }
+            // Probe until edge or empty slot is found
+            s = capec_TopoHash(a, b, bits);
+            while ((e = slots[s]) >= 0) {
+                if (g->edges[2*e] == a && g->edges[2*e + 1] == b)
+                    break;
+                s = (s + 1) & mask;
+            }
+            // New edge
+            if (e < 0) {
+                e = (int) g->nedge++;
+                slots[s] = e;
+                g->edges[2*e] = a;
+                g->edges[2*e + 1] = b;
+            }
+            g->tri_edges[3*j + k] = e;
+            cnt[e]++;
+        }
+    }
+    free(slots);
+    // Open and non-manifold edges
+    for (i=0; i<g->nedge; i++) {
+        if (cnt[i] == 1) {
+            g->nopen++;
+        } else if (cnt[i] > 2) {
+            g->nnonmanifold++;
+        }
+    }
+    
+    // Edge-to-tri: offsets from counts, then fill
+    g->e2t_ptr = (int *) malloc((g->nedge + 1)*sizeof(int));
+    if (g->e2t_ptr == NULL) {
+        free(cnt);
+        capec_TriTopoFree(g);
+        return capeTOPO_ERR_MEM;
+    }
+    g->e2t_ptr[0] = 0;
+    for (i=0; i<g->nedge; i++) {
+        g->e2t_ptr[i + 1] = g->e2t_ptr[i] + cnt[i];
+        cnt[i] = g->e2t_ptr[i];
+    }
+    for (i=0; i<m; i++)
+        g->e2t[cnt[g->tri_edges[i]]++] = (int) (i / 3);
+    free(cnt);
+    
+    // Tri-to-tri: count other tris on each side, then fill
+    for (n=0, j=0; j<ntri; j++) {
+        for (k=0; k<3; k++) {
+            e = g->tri_edges[3*j + k];
+            for (a=g->e2t_ptr[e]; a<g->e2t_ptr[e + 1]; a++)
+                n += (g->e2t[a] != (int) j);
+        }
+        if (n > INT_MAX) {
+            capec_TriTopoFree(g);
+            return capeTOPO_ERR_SIZE;
+        }
+        g->t2t_ptr[j + 1] = (int) n;
+    }
+    g->t2t = (int *) malloc((n + 1)*sizeof(int));
+    if (g->t2t == NULL) {
+        capec_TriTopoFree(g);
+        return capeTOPO_ERR_MEM;
+    }
+    for (n=0, j=0; j<ntri; j++) {
+        for (k=0; k<3; k++) {
+            e = g->tri_edges[3*j + k];
+            for (a=g->e2t_ptr[e]; a<g->e2t_ptr[e + 1]; a++) {
+                if (g->e2t[a] != (int) j)
+                    g->t2t[n++] = g->e2t[a];
+            }
+        }
+    }
+    return capeTOPO_OK;
+}
+
+// Release arrays
+void
+capec_TriTopoFree(capecTriTopo *g)
+{
+    free(g->n2t_ptr);
+    free(g->n2t);
+    free(g->edges);
+    free(g->tri_edges);
+    free(g->e2t_ptr);
+    free(g->e2t);
+    free(g->t2t_ptr);
+    free(g->t2t);
+    g->n2t_ptr = NULL;
+    g->n2t = NULL;
+    g->edges = NULL;
+    g->tri_edges = NULL;
+    g->e2t_ptr = NULL;
+    g->e2t = NULL;
+    g->t2t_ptr = NULL;
+    g->t2t = NULL;
+}
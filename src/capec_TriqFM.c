@@ -0,0 +1,306 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Local includes
+#include "capec_TriqFM.h"
+#include "capec_Thread.h"
+
+
+// Work for one thread
+typedef struct {
+    const double *P;        // Node coordinates
+    const int *T;           // Tri node indices
+    const double *Q;        // Node states
+    int nq;                 // Number of states
+    const int *C;           // Component IDs
+    size_t i0;              // First tri
+    size_t i1;              // End of tris
+    int cmin;               // Smallest component ID
+    const capecTriqFMOpts *opts;    // Freestream state
+    double *S;              // Sums for this thread
+} capecTriqFMTask;
+
+
+// ======================================================================
+// VOLUMES
+// ======================================================================
+
+// Volume of pyramid with apex *p* and base *a*, *b*, *c*, *d*
+static double
+capec_TriqVolPym(const double *p, const double *a, const double *b,
+    const double *c, const double *d)
+{
+    double xac, yac, zac, xbd, ybd, zbd;
+    
+    // Diagonals of base
+    xac = a[0] - c[0];
+    yac = a[1] - c[1];
+    zac = a[2] - c[2];
+    xbd = b[0] - d[0];
+    ybd = b[1] - d[1];
+    zbd = b[2] - d[2];
+    // Same as VOLPYM() in cape.cfdx.volcomp
+    return (1.0/6.0) * (
+        (p[0] - 0.25*(a[0] + b[0] + c[0] + d[0]))*(yac*zbd - zac*ybd) +
+        (p[1] - 0.25*(a[1] + b[1] + c[1] + d[1]))*(zac*xbd - xac*zbd) +
+        (p[2] - 0.25*(a[2] + b[2] + c[2] + d[2]))*(xac*ybd - yac*xbd));
+}
+
+// Volume of tetrahedron
+static double
+capec_TriqVolTet(const double *a, const double *b, const double *c,
+    const double *d)
+{
+    double xbd, ybd, zbd, xcd, ycd, zcd;
+    
+    xbd = b[0] - d[0];
+    ybd = b[1] - d[1];
+    zbd = b[2] - d[2];
+    xcd = c[0] - d[0];
+    ycd = c[1] - d[1];
+    zcd = c[2] - d[2];
+    // Same as VOLTET() in cape.cfdx.volcomp
+    return (1.0/6.0) * (
+        (a[0] - d[0])*(ybd*zcd - zbd*ycd) +
+        (a[1] - d[1])*(zbd*xcd - xbd*zcd) +
+        (a[2] - d[2])*(xbd*ycd - ybd*xcd));
+}
+
+// Volume of prism with base 1,2,3 and top 4,5,6; see VolTriPrism()
+static double
+capec_TriqVolPrism(const double *x1, const double *x2, const double *x3,
+    const double *x4, const double *x5, const double *x6)
+{
+    int j;
+    double x7[3];
+    
+    // Middle of the prism
+    for (j=0; j<3; j++) {
+        x7[j] = (1.0/6.0)*(x1[j] + x2[j] + x3[j] + x4[j] + x5[j] + x6[j]);
+    }
+    // Three pyramids and two tetrahedra
+    return capec_TriqVolPym(x7, x1, x4, x5, x2) +
+        capec_TriqVolPym(x7, x1, x3, x6, x4) +
+        capec_TriqVolPym(x7, x2, x5, x6, x3) +
+        capec_TriqVolTet(x7, x1, x2, x3) +
+        capec_TriqVolTet(x7, x6, x5, x4);
+}
+
+
+// ======================================================================
+// FORCES
+// ======================================================================
+
+// Area vector and forces on one tri
+void
+capec_TriqTriForces(const double *P, const int *T, const double *Q, int nq,
+    size_t i, const capecTriqFMOpts *opts, double *N, double *F)
+{
+    int j;
+    double A, cp, rho, U, V, W, phi, kvac;
+    double vol, mu, ul, vl, wl, ftmuj, zuvw;
+    double txx, tyy, tzz, txy, tyz, txz;
+    double y0[3], y1[3], y2[3];
+    const double *x0, *x1, *x2, *q0, *q1, *q2;
+    
+    // Vertices and states
+    x0 = P + 3*(T[3*i] - 1);
+    x1 = P + 3*(T[3*i + 1] - 1);
+    x2 = P + 3*(T[3*i + 2] - 1);
+    q0 = Q + (size_t) nq*(T[3*i] - 1);
+    q1 = Q + (size_t) nq*(T[3*i + 1] - 1);
+    q2 = Q + (size_t) nq*(T[3*i + 2] - 1);
+    // Area vector
+    N[0] = 0.5*((x1[1]-x0[1])*(x2[2]-x0[2]) - (x1[2]-x0[2])*(x2[1]-x0[1]));
+    N[1] = 0.5*((x1[2]-x0[2])*(x2[0]-x0[0]) - (x1[0]-x0[0])*(x2[2]-x0[2]));
+    N[2] = 0.5*((x1[0]-x0[0])*(x2[1]-x0[1]) - (x1[1]-x0[1])*(x2[0]-x0[0]));
+    A = sqrt(N[0]*N[0] + N[1]*N[1] + N[2]*N[2]);
+    // Initialize momentum and viscous forces
+    memset(F + capeTRIQFM_FM3, 0, 6*sizeof(double));
+    // Pressure force (inward normal)
+    cp = (q0[0] + q1[0] + q2[0]) / 3;
+    // Vacuum force
+    kvac = -2.0 / (opts->gam * opts->mach * opts->mach);
+    for (j=0; j<3; j++) {
+        F[capeTRIQFM_FP3 + j] = -cp*N[j];
+        F[capeTRIQFM_FVAC3 + j] = kvac*N[j];
+    }
+    // Momentum force
+    if (nq == 6) {
+        // Cart3D style: u/a_inf
+        rho = (q0[1] + q1[1] + q2[1]) / 3;
+        U = (q0[2] + q1[2] + q2[2]) / 3;
+        V = (q0[3] + q1[3] + q2[3]) / 3;
+        W = (q0[4] + q1[4] + q2[4]) / 3;
+        phi = -rho*(U*N[0] + V*N[1] + W*N[2]);
+        F[capeTRIQFM_FM3]     = phi*U;
+        F[capeTRIQFM_FM3 + 1] = phi*V;
+        F[capeTRIQFM_FM3 + 2] = phi*W;
+    } else if (nq >= 5) {
+        // Conventional: rho*u/(rho_inf*a_inf)
+        U = (q0[2]/q0[1] + q1[2]/q1[1] + q2[2]/q2[1]) / 3;
+        V = (q0[3]/q0[1] + q1[3]/q1[1] + q2[3]/q2[1]) / 3;
+        W = (q0[4]/q0[1] + q1[4]/q1[1] + q2[4]/q2[1]) / 3;
+        phi = -(U*N[0] + V*N[1] + W*N[2]);
+        F[capeTRIQFM_FM3]     = phi*(q0[2] + q1[2] + q2[2]) / 3;
+        F[capeTRIQFM_FM3 + 1] = phi*(q0[3] + q1[3] + q2[3]) / 3;
+        F[capeTRIQFM_FM3 + 2] = phi*(q0[4] + q1[4] + q2[4]) / 3;
+    }
+    // Viscous force
+    if (nq == 9) {
+        // Viscous stresses given directly
+        for (j=0; j<3; j++) {
+            F[capeTRIQFM_FV3 + j] = (q0[6 + j] + q1[6 + j] + q2[6 + j])/3 * A;
+        }
+    } else if (nq >= 13) {
+        // Points at L=2 from overset grid
+        for (j=0; j<3; j++) {
+            y0[j] = x0[j] + q0[10 + j];
+            y1[j] = x1[j] + q1[10 + j];
+            y2[j] = x2[j] + q2[10 + j];
+        }
+        vol = capec_TriqVolPrism(x0, x1, x2, y0, y1, y2);
+        // Skip small prisms
+        if (!(vol > opts->smallvol)) {
+            return;
+        }
+        // Dynamic viscosity and velocity derivatives
+        mu = (q0[6] + q1[6] + q2[6]) / 3;
+        ul = (q0[7] + q1[7] + q2[7]) / 3;
+        vl = (q0[8] + q1[8] + q2[8]) / 3;
+        wl = (q0[9] + q1[9] + q2[9]) / 3;
+        // Stress tensor
+        ftmuj = mu*(opts->mach / opts->rey)/vol;
+        zuvw = (1.0/3.0) * (N[0]*ul + N[1]*vl + N[2]*wl);
+        txx = 2.0*ftmuj * (ul*N[0] - zuvw);
+        tyy = 2.0*ftmuj * (vl*N[1] - zuvw);
+        tzz = 2.0*ftmuj * (wl*N[2] - zuvw);
+        txy = ftmuj * (vl*N[0] + ul*N[1]);
+        tyz = ftmuj * (wl*N[1] + vl*N[2]);
+        txz = ftmuj * (ul*N[2] + wl*N[0]);
+        F[capeTRIQFM_FV3]     = txx*N[0] + txy*N[1] + txz*N[2];
+        F[capeTRIQFM_FV3 + 1] = txy*N[0] + tyy*N[1] + tyz*N[2];
+        F[capeTRIQFM_FV3 + 2] = txz*N[0] + tyz*N[1] + tzz*N[2];
+    }
+}
+
+// Add force and its moment about origin to sums
+void
+capec_TriqAddForce(double *s, const double *x, const double *F, double f)
+{
+    s[0] += f*F[0];
+    s[1] += f*F[1];
+    s[2] += f*F[2];
+    s[3] += f*(x[1]*F[2] - x[2]*F[1]);
+    s[4] += f*(x[2]*F[0] - x[0]*F[2]);
+    s[5] += f*(x[0]*F[1] - x[1]*F[0]);
+}
+
+// Integrate forces on tris of one task
+static void
+capec_TriqFMRun(void *task)
+{
+    int j;
+    size_t i;
+    double N[3], xc[3], F[capeTRIQFM_NF];
+    const double *x0, *x1, *x2;
+    double *s;
+    capecTriqFMTask *t = (capecTriqFMTask *) task;
+    
+    // Loop through tris
+    for (i=t->i0; i<t->i1; i++) {
+        // Area vector and forces
+        capec_TriqTriForces(t->P, t->T, t->Q, t->nq, i, t->opts, N, F);
+        // Sums for this component
+        s = t->S + capeTRIQFM_NSUM*(size_t) (t->C[i] - t->cmin);
+        // Tri center
+        x0 = t->P + 3*(t->T[3*i] - 1);
+        x1 = t->P + 3*(t->T[3*i + 1] - 1);
+        x2 = t->P + 3*(t->T[3*i + 2] - 1);
+        for (j=0; j<3; j++) {
+            xc[j] = (x0[j] + x1[j] + x2[j]) / 3;
+            s[capeTRIQFM_A + j] += N[j];
+        }
+        s[capeTRIQFM_N] += 1.0;
+        // Add each type of force
+        capec_TriqAddForce(s + capeTRIQFM_FP, xc, F + capeTRIQFM_FP3, 1.0);
+        capec_TriqAddForce(s + capeTRIQFM_FVAC, xc, F + capeTRIQFM_FVAC3, 1.0);
+        capec_TriqAddForce(s + capeTRIQFM_FM, xc, F + capeTRIQFM_FM3, 1.0);
+        capec_TriqAddForce(s + capeTRIQFM_FV, xc, F + capeTRIQFM_FV3, 1.0);
+    }
+}
+
+
+// ======================================================================
+// DRIVER
+// ======================================================================
+
+// Add up forces and moments by component
+int
+capec_TriqForces(const double *P, const int *T, const double *Q, int nq,
+    const int *C, size_t nTri, int cmin, size_t ncomp,
+    const capecTriqFMOpts *opts, double *S, int nthread)
+{
+    int k;
+    size_t i, n, nchunk;
+    double *sums[capeTHREAD_MAX];
+    capecTriqFMTask tasks[capeTHREAD_MAX];
+    
+    // Check component IDs
+    for (i=0; i<nTri; i++) {
+        if (C[i] < cmin || (size_t) (C[i] - cmin) >= ncomp) {
+            return 1;
+        }
+    }
+    // Number of threads
+    nchunk = nTri / capeTRIQFM_CHUNKMIN;
+    if (nthread <= 0) {
+        nthread = capec_ThreadCount();
+    }
+    if ((size_t) nthread > nchunk) {
+        nthread = (int) nchunk;
+    }
+    nthread = (nthread > capeTHREAD_MAX) ? capeTHREAD_MAX : nthread;
+    nthread = (nthread < 1) ? 1 : nthread;
+    // Size of each table of sums
+    n = ncomp * capeTRIQFM_NSUM;
+    // Use at most as many sums as there are tris in total
+    if (nthread > 1 && n * (size_t) nthread > 4*nTri) {
+        nthread = 1;
+    }
+    // First thread adds directly to output
+    memset(S, 0, n*sizeof(double));
+    sums[0] = S;
+    for (k=1; k<nthread; k++) {
+        sums[k] = (double *) calloc(n, sizeof(double));
+        if (sums[k] == NULL) {
+            nthread = k;
+        }
+    }
+    
+    // Set up tasks
+    for (k=0; k<nthread; k++) {
+        tasks[k].P = P;
+        tasks[k].T = T;
+        tasks[k].Q = Q;
+        tasks[k].nq = nq;
+        tasks[k].C = C;
+        tasks[k].i0 = (nTri * (size_t) k) / (size_t) nthread;
+        tasks[k].i1 = (nTri * (size_t) (k + 1)) / (size_t) nthread;
+        tasks[k].cmin = cmin;
+        tasks[k].opts = opts;
+        tasks[k].S = sums[k];
+    }
+    // Integrate each range of tris
+    capec_ThreadRun(capec_TriqFMRun, tasks, sizeof(capecTriqFMTask), nthread);
+    
+    // Combine sums from each thread
+    for (k=1; k<nthread; k++) {
+        for (i=0; i<n; i++) {
+            S[i] += sums[k][i];
+        }
+        free(sums[k]);
+    }
+    return 0;
+}
@@ -0,0 +1,525 @@
+#include <Python.h>
+
+#if PY_MINOR_VERSION >= 10
+    #define NPY_NO_DEPRECATED_API NPY_2_0_API_VERSION
+#else
+    #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#endif
+#define PY_ARRAY_UNIQUE_SYMBOL _cape_ARRAY_API
+#define NO_IMPORT_ARRAY
+#include <numpy/arrayobject.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <byteswap.h>
+
+// Local includes
+#include "capec_io.h"
+#include "capec_NumPy.h"
+#include "capec_Fmt.h"
+#include "capec_Scan.h"
+#include "capec_UGrid.h"
+
+// Status codes for finding sections of binary files
+enum capeUGRID_WALK {
+    capeUGRID_WALK_OK,      // sections exactly fill file
+    capeUGRID_WALK_EXTRA,   // all sections present, then extra bytes
+    capeUGRID_WALK_HEADER,  // invalid header
+    capeUGRID_WALK_EOF,     // file ended within a section
+    capeUGRID_WALK_MARKER   // invalid record marker
+};
+
+// Names of sections
+const char *capeUGRID_NAMES[capeUGRID_NSECTION] = {
+    "nodes",
+    "tris",
+    "quads",
+    "surf_ids",
+    "tets",
+    "pyrs",
+    "pris",
+    "hexs",
+    "ntet_bl",
+    "vol_ids",
+    "surf_flags",
+    "surf_bcs",
+    "blds",
+    "bldel"
+};
+
+// Binary formats tried when detecting layout, most checkable first
+static const char *capeUGRID_FORMATS[] = {
+    "lr4", "lr8", "r4", "r8", "lb4", "lb8", "b4", "b8"
+};
+#define capeUGRID_NFORMAT 8
+
+// Values per row of each section (0 for 1-D sections)
+static const size_t capeUGRID_NCOL[capeUGRID_NSECTION] = {
+    3, 3, 4, 0, 4, 5, 6, 8, 0, 0, 0, 0, 0, 0
+};
+
+
+// ======================================================================
+// LAYOUT
+// ======================================================================
+
+// Set format from name
+int
+capec_UGridFormat(capecUGrid *g, const char *fmt)
+{
+    int little = 0;
+    const char *p = fmt;
+    
+    // Defaults
+    g->ascii = 0;
+    g->record = 0;
+    g->swap = 0;
+    g->nf = 8;
+    // Check for text
+    if (strcmp(fmt, "ascii") == 0) {
+        g->ascii = 1;
+        return 0;
+    }
+    // Byte order
+    if (*p == 'l') {
+        little = 1;
+        p++;
+    }
+    // Record markers or stream
+    if (*p == 'r') {
+        g->record = 1;
+    } else if (*p != 'b') {
+        return 1;
+    }
+    p++;
+    // Precision
+    if (*p == '4' || *p == '8') {
+        g->nf = *p - '0';
+    } else {
+        return 1;
+    }
+    // Check for extra characters
+    if (*(++p) != '\0') {
+        return 1;
+    }
+    // Swap if byte order is not native
+    g->swap = little ? !is_le() : is_le();
+    return 0;
+}
+
+// Count values in each section
+void
+capec_UGridSizes(capecUGrid *g)
+{
+    int k;
+    size_t nsurf, nvol;
+    
+    // Total surface faces and volume cells
+    nsurf = (size_t) g->n[1] + (size_t) g->n[2];
+    nvol = (size_t) g->n[3] + (size_t) g->n[4] + (size_t) g->n[5] +
+        (size_t) g->n[6];
+    // Values in each section
+    g->count[capeUGRID_NODES] = 3 * (size_t) g->n[0];
+    g->count[capeUGRID_TRIS] = 3 * (size_t) g->n[1];
+    g->count[capeUGRID_QUADS] = 4 * (size_t) g->n[2];
+    g->count[capeUGRID_SURFIDS] = nsurf;
+    g->count[capeUGRID_TETS] = 4 * (size_t) g->n[3];
+    g->count[capeUGRID_PYRS] = 5 * (size_t) g->n[4];
+    g->count[capeUGRID_PRIS] = 6 * (size_t) g->n[5];
+    g->count[capeUGRID_HEXS] = 8 * (size_t) g->n[6];
+    g->count[capeUGRID_NTETBL] = 1;
+    g->count[capeUGRID_VOLIDS] = nvol;
+    g->count[capeUGRID_SURFFLAGS] = nsurf;
+    g->count[capeUGRID_SURFBCS] = nsurf;
+    g->count[capeUGRID_BLDS] = (size_t) g->n[0];
+    g->count[capeUGRID_BLDEL] = (size_t) g->n[0];
+    // Shapes
+    for (k=0; k<capeUGRID_NSECTION; k++) {
+        g->ncol[k] = capeUGRID_NCOL[k];
+        g->offset[k] = 0;
+    }
+}
+
+// Check for float section
+int
+capec_UGridIsFloat(int k)
+{
+    return (k == capeUGRID_NODES || k == capeUGRID_BLDS ||
+        k == capeUGRID_BLDEL);
+}
+
+
+// ======================================================================
+// BINARY
+// ======================================================================
+
+// Read one 4-byte int from file; -1 if past end
+static long
+capec_UGridInt(const char *data, size_t size, size_t i, int swap)
+{
+    unsigned u;
+    
+    // Check for room
+    if (i + 4 > size) {
+        return -1;
+    }
+    // Read and swap
+    memcpy(&u, data + i, 4);
+    if (swap) {u = __bswap_32(u); }
+    return (long) u;
+}
+
+// Find offset of each section for format already set in *g*
+static int
+capec_UGridWalk(const char *data, size_t size, capecUGrid *g, int *kerr)
+{
+    int j, k;
+    long r;
+    size_t i, nb, nm;
+    
+    // Bytes for leading marker
+    nm = g->record ? 4 : 0;
+    // Header record
+    *kerr = -1;
+    if (g->record && capec_UGridInt(data, size, 0, g->swap) != 28) {
+        return capeUGRID_WALK_HEADER;
+    }
+    if (g->record && capec_UGridInt(data, size, 32, g->swap) != 28) {
+        return capeUGRID_WALK_HEADER;
+    }
+    // Header counts
+    for (j=0; j<7; j++) {
+        r = capec_UGridInt(data, size, nm + 4*j, g->swap);
+        if (r < 0 || r > INT_MAX) {
+            return capeUGRID_WALK_HEADER;
+        }
+        g->n[j] = r;
+    }
+    i = 28 + 2*nm;
+    capec_UGridSizes(g);
+    
+    // Loop through sections
+    for (k=0; k<capeUGRID_NSECTION; k++) {
+        *kerr = k;
+        // Size of section
+        nb = g->count[k] * (capec_UGridIsFloat(k) ? (size_t) g->nf : 4);
+        // Optional sections may be left off the end
+        if (k >= capeUGRID_NREQUIRED && i >= size && (nb > 0 || g->record)) {
+            break;
+        }
+        // Check for room
+        if (i + nb + 2*nm > size) {
+            return capeUGRID_WALK_EOF;
+        }
+        // Check record markers
+        if (g->record) {
+            r = capec_UGridInt(data, size, i, g->swap);
+            if (r < 0 || (size_t) r != nb) {
+                return capeUGRID_WALK_MARKER;
+            }
+            r = capec_UGridInt(data, size, i + nm + nb, g->swap);
+            if (r < 0 || (size_t) r != nb) {
+                return capeUGRID_WALK_MARKER;
+            }
+        }
+        // Save start of data
+        g->offset[k] = i + nm;
+        i += nb + 2*nm;
+    }
+    // Number of sections found
+    g->nsection = k;
+    // Check for data after last section
+    return (i == size) ? capeUGRID_WALK_OK : capeUGRID_WALK_EXTRA;
+}
+
+// Find sections of binary UGRID file
+int
+capec_ParseUGrid(const char *data, size_t size, const char *fmt,
+    capecUGrid *g)
+{
+    int j, k, ierr;
+    
+    // Initialize
+    memset(g, 0, sizeof(capecUGrid));
+    // Try each binary format if not specified
+    if (fmt == NULL) {
+        for (j=0; j<capeUGRID_NFORMAT; j++) {
+            capec_UGridFormat(g, capeUGRID_FORMATS[j]);
+            if (capec_UGridWalk(data, size, g, &k) == capeUGRID_WALK_OK) {
+                return 0;
+            }
+        }
+        // Assume anything else is text
+        memset(g, 0, sizeof(capecUGrid));
+        g->ascii = 1;
+        return 0;
+    }
+    // Interpret format
+    if (capec_UGridFormat(g, fmt)) {
+        PyErr_Format(PyExc_ValueError,
+            "Unrecognized UGRID format '%s'", fmt);
+        return 1;
+    }
+    // Nothing to find for text files
+    if (g->ascii) {
+        return 0;
+    }
+    // Find sections
+    ierr = capec_UGridWalk(data, size, g, &k);
+    if (ierr == capeUGRID_WALK_HEADER) {
+        PyErr_Format(PyExc_ValueError,
+            "File does not start with a valid '%s' UGRID header", fmt);
+    } else if (ierr == capeUGRID_WALK_EOF) {
+        PyErr_Format(PyExc_ValueError,
+            "File ended before end of UGRID %s section", capeUGRID_NAMES[k]);
+    } else if (ierr == capeUGRID_WALK_MARKER) {
+        PyErr_Format(PyExc_ValueError,
+            "Invalid record markers for UGRID %s section",
+            capeUGRID_NAMES[k]);
+    } else {
+        // Extra bytes after all sections are ignored
+        return 0;
+    }
+    return 1;
+}
+
+
+// ======================================================================
+// ASCII
+// ======================================================================
+
+// Get start of next token of text file, reading more lines as needed
+static char *
+capec_UGridToken(capecScanBuf *b, char **p)
+{
+    char *s = *p;
+    
+    // Loop until a nonblank character is found
+    while (1) {
+        // Skip blanks
+        while (capeSCAN_IsSpace(*s)) {s++; }
+        // Check for token
+        if (*s != '\0') {
+            *p = s;
+            return s;
+        }
+        // Go to next line
+        s = capec_ScanBufLine(b);
+        if (s == NULL) {
+            *p = (char *) "";
+            return NULL;
+        }
+    }
+}
+
+// Check that a number ends at a blank or end of line
+#define capec_UGridEnd(e) (capeSCAN_IsSpace(*(e)) || *(e) == '\0')
+
+// Read one integer
+static int
+capec_UGridTextInt(capecScanBuf *b, char **p, long *v)
+{
+    char *s, *e;
+    long long u;
+    
+    // Find token
+    s = capec_UGridToken(b, p);
+    if (s == NULL) {
+        return b->ierr ? capeUGRID_ERR_READ : capeUGRID_ERR_EOF;
+    }
+    // Convert
+    if (capec_ScanI64(s, &e, &u) || !capec_UGridEnd(e) ||
+            u < INT_MIN || u > INT_MAX) {
+        return capeUGRID_ERR_VALUE;
+    }
+    *v = (long) u;
+    *p = e;
+    return capeUGRID_OK;
+}
+
+// Read header of ASCII file
+int
+capec_ReadUGridHeader(capecScanBuf *b, char **p, capecUGrid *g)
+{
+    int j, ierr;
+    
+    // Start before first line
+    *p = (char *) "";
+    // Read seven counts
+    for (j=0; j<7; j++) {
+        ierr = capec_UGridTextInt(b, p, g->n + j);
+        if (ierr) {
+            return ierr;
+        }
+        if (g->n[j] < 0) {
+            return capeUGRID_ERR_VALUE;
+        }
+    }
+    // Sizes of each section
+    capec_UGridSizes(g);
+    return capeUGRID_OK;
+}
+
+// Read sections of ASCII file
+int
+capec_ReadUGridText(capecScanBuf *b, char **p, capecUGrid *g, void **out)
+{
+    int k, last, isf;
+    size_t i;
+    long long v;
+    double x;
+    char *s, *e;
+    
+    // Last section to read
+    for (k=0, last=-1; k<capeUGRID_NSECTION; k++) {
+        if (out[k] != NULL) {last = k; }
+    }
+    // Loop through sections
+    for (k=0; k<=last; k++) {
+        g->nsection = k;
+        isf = capec_UGridIsFloat(k);
+        // Loop through values
+        for (i=0; i<g->count[k]; i++) {
+            // Find next value
+            s = capec_UGridToken(b, p);
+            if (s == NULL && b->ierr) {
+                return capeUGRID_ERR_READ;
+            } else if (s == NULL) {
+                // Optional sections may be left off the end
+                if (i == 0 && k >= capeUGRID_NREQUIRED) {
+                    return capeUGRID_OK;
+                }
+                return capeUGRID_ERR_EOF;
+            }
+            // Skip or convert it
+            if (out[k] == NULL) {
+                for (e=s; !capec_UGridEnd(e); e++) {}
+            } else if (isf) {
+                if (capec_ScanF64(s, &e, &x) || !capec_UGridEnd(e)) {
+                    return capeUGRID_ERR_VALUE;
+                }
+                ((double *) out[k])[i] = x;
+            } else {
+                if (capec_ScanI64(s, &e, &v) || !capec_UGridEnd(e) ||
+                        v < INT_MIN || v > INT_MAX) {
+                    return capeUGRID_ERR_VALUE;
+                }
+                ((int *) out[k])[i] = (int) v;
+            }
+            *p = e;
+        }
+    }
+    // All requested sections read
+    g->nsection = k;
+    return capeUGRID_OK;
+}
+
+
+// ======================================================================
+// WRITERS
+// ======================================================================
+
+// Write UGRID sections as text
+static int
+capec_WriteUGridText(FILE *fid, const capecUGrid *g, PyArrayObject **A,
+    int *k)
+{
+    int j, isf;
+    size_t i, m, ncol;
+    char *p, *p0;
+    const char *q;
+    capecFmtBuf b;
+    
+    // Create text buffer
+    if (capec_FmtBufInit(&b, fid)) {
+        return capeIO_ERR_MEM;
+    }
+    // Header
+    *k = -1;
+    p = p0 = capec_FmtBufReserve(&b, 7*24);
+    if (p0 != NULL) {
+        for (j=0; j<7; j++) {
+            p += capec_FmtI(p, g->n[j]);
+            *(p++) = (j < 6) ? ' ' : '\n';
+        }
+        capec_FmtBufCommit(&b, p - p0);
+    }
+    // Loop through sections
+    for (*k=0; *k<g->nsection && !b.ierr; (*k)++) {
+        // Check for arrays pinned by capec_PinView()
+        isf = capec_UGridIsFloat(*k);
+        if (!capec_ViewOK(A[*k], isf ? NPY_DOUBLE : NPY_INT)) {
+            capec_FmtBufClose(&b);
+            return capeIO_ERR_SHAPE;
+        }
+        // One row per line, or one value per line for 1-D sections
+        ncol = g->ncol[*k] ? g->ncol[*k] : 1;
+        for (i=0; i<g->count[*k]; i+=ncol) {
+            // Get room for one row
+            p0 = capec_FmtBufReserve(&b, ncol*(capeFMT_MAXNUM + 1));
+            if (p0 == NULL) {break; }
+            p = p0;
+            for (m=0; m<ncol; m++) {
+                // Entry in row *i/ncol*, any strides
+                q = PyArray_BYTES(A[*k]) +
+                    (npy_intp) (i/ncol)*PyArray_STRIDE(A[*k], 0);
+                if (g->ncol[*k]) {
+                    q += (npy_intp) m*PyArray_STRIDE(A[*k], 1);
+                }
+                if (isf) {
+                    p += capec_FmtE(p, capec_npd(A[*k], q), 16, 0);
+                } else {
+                    p += capec_FmtI(p, (int) capec_npi(A[*k], q));
+                }
+                *(p++) = (m + 1 < ncol) ? ' ' : '\n';
+            }
+            capec_FmtBufCommit(&b, p - p0);
+        }
+    }
+    // Write remaining text
+    if (capec_FmtBufClose(&b)) {
+        return capeIO_ERR_WRITE;
+    }
+    return capeIO_OK;
+}
+
+// Write UGRID file
+int
+capec_WriteUGrid(FILE *fid, const capecUGrid *g, PyArrayObject **A, int *k)
+{
+    int j, ierr, rtype;
+    int (*fwrite_a)(FILE *, PyArrayObject *, int, int, int);
+    
+    // Check for text
+    if (g->ascii) {
+        return capec_WriteUGridText(fid, g, A, k);
+    }
+    // Header
+    *k = -1;
+    ierr = g->record && capec_WriteMarker(fid, 28, g->swap);
+    for (j=0; j<7; j++) {
+        ierr = ierr || capec_WriteMarker(fid, (int) g->n[j], g->swap);
+    }
+    ierr = ierr || (g->record && capec_WriteMarker(fid, 28, g->swap));
+    if (ierr) {
+        return capeIO_ERR_WRITE;
+    }
+    // Array writer
+    fwrite_a = g->record ? capec_WriteRecord : capec_WriteStream;
+    // Loop through sections
+    for (*k=0; *k<g->nsection; (*k)++) {
+        // Output type
+        if (!capec_UGridIsFloat(*k)) {
+            rtype = capeREC_I4;
+        } else {
+            rtype = (g->nf == 4) ? capeREC_F4 : capeREC_F8;
+        }
+        // Write it
+        ierr = fwrite_a(fid, A[*k], g->ncol[*k] ? 2 : 1, rtype, g->swap);
+        if (ierr) {
+            return ierr;
+        }
+    }
+    return capeIO_OK;
+}
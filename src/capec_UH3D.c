@@ -0,0 +1,313 @@
+#include <Python.h>
+
+#if PY_MINOR_VERSION >= 10
+    #define NPY_NO_DEPRECATED_API NPY_2_0_API_VERSION
+#else
+    #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#endif
+#define PY_ARRAY_UNIQUE_SYMBOL _cape_ARRAY_API
+#define NO_IMPORT_ARRAY
+#include <numpy/arrayobject.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+
+// Local includes
+#include "capec_io.h"
+#include "capec_NumPy.h"
+#include "capec_Fmt.h"
+#include "capec_Scan.h"
+#include "capec_UH3D.h"
+
+
+// Names of sections
+const char *capeUH3D_NAMES[capeUH3D_NSECTION] = {
+    "header", "nodes", "tris"
+};
+
+
+// ======================================================================
+// READERS
+// ======================================================================
+
+// Get next line that isn't blank, skipping leading spaces
+static char *
+capec_UH3DLine(capecScanBuf *b, capecUH3D *u)
+{
+    char *s;
+    
+    while ((s = capec_ScanBufLine(b)) != NULL) {
+        u->iline++;
+        while (capeSCAN_IsSpace(*s)) {s++; }
+        if (*s != '\0') {break; }
+    }
+    return s;
+}
+
+// Move past separator after a field; NULL if it's not a valid separator
+static char *
+capec_UH3DNext(char *e, int last)
+{
+    while (capeSCAN_IsSpace(*e)) {e++; }
+    // Fields are separated by commas
+    if (!last) {
+        return (*e == ',') ? e + 1 : NULL;
+    }
+    // Nothing but an optional comma after last field
+    if (*e == ',') {e++; }
+    while (capeSCAN_IsSpace(*e)) {e++; }
+    return (*e == '\0') ? e : NULL;
+}
+
+// Parse integer field that fits in an int
+static int
+capec_UH3DInt(char **s, int last, int *v)
+{
+    long long x;
+    char *e;
+    
+    while (capeSCAN_IsSpace(**s)) {(*s)++; }
+    if (capec_ScanI64(*s, &e, &x) || x < INT_MIN || x > INT_MAX) {
+        return 1;
+    }
+    *s = capec_UH3DNext(e, last);
+    *v = (int) x;
+    return (*s == NULL);
+}
+
+// Parse floating-point field
+static int
+capec_UH3DFloat(char **s, int last, double *v)
+{
+    char *e;
+    
+    while (capeSCAN_IsSpace(**s)) {(*s)++; }
+    if (capec_ScanF64(*s, &e, v)) {
+        return 1;
+    }
+    *s = capec_UH3DNext(e, last);
+    return (*s == NULL);
+}
+
+// Read title and counts
+int
+capec_ReadUH3DHeader(capecScanBuf *b, capecUH3D *u)
+{
+    int j;
+    long long x;
+    long n[6];
+    char *s, *e;
+    
+    // Initialize
+    u->nNode = 0;
+    u->nTri = 0;
+    u->nComp = 0;
+    u->iline = 0;
+    u->nsection = capeUH3D_HEADER;
+    // Title line is not used
+    if (capec_ScanBufLine(b) == NULL) {
+        return b->ierr ? capeUH3D_ERR_READ : capeUH3D_ERR_EOF;
+    }
+    u->iline++;
+    // Counts: nNode, nNode, nTri, nTri, nComp, nComp (last two optional)
+    s = capec_UH3DLine(b, u);
+    if (s == NULL) {
+        return b->ierr ? capeUH3D_ERR_READ : capeUH3D_ERR_EOF;
+    }
+    for (j=0; j<6 && *s != '\0'; j++) {
+        while (capeSCAN_IsSpace(*s)) {s++; }
+        if (capec_ScanI64(s, &e, &x) || x < 0 || x > INT_MAX) {
+            return capeUH3D_ERR_VALUE;
+        }
+        n[j] = (long) x;
+        // Comma or end of line
+        while (capeSCAN_IsSpace(*e)) {e++; }
+        if (*e == ',') {
+            e++;
+        } else if (*e != '\0') {
+            return capeUH3D_ERR_VALUE;
+        }
+        s = e;
+    }
+    if (j < 3) {
+        return capeUH3D_ERR_VALUE;
+    }
+    // Save counts
+    u->nNode = n[0];
+    u->nTri = n[2];
+    u->nComp = (j > 4) ? n[4] : 0;
+    return capeUH3D_OK;
+}
+
+// Read nodes, tris, and component IDs
+int
+capec_ReadUH3D(capecScanBuf *b, capecUH3D *u, double *P, int *T, int *C)
+{
+    int j, k;
+    long i;
+    char *s;
+    
+    // Nodes: "i, x, y, z"
+    u->nsection = capeUH3D_NODES;
+    for (i=0; i<u->nNode; i++) {
+        s = capec_UH3DLine(b, u);
+        if (s == NULL) {
+            return b->ierr ? capeUH3D_ERR_READ : capeUH3D_ERR_EOF;
+        }
+        // Index is not used
+        if (capec_UH3DInt(&s, 0, &k)) {
+            return capeUH3D_ERR_VALUE;
+        }
+        for (j=0; j<3; j++) {
+            if (capec_UH3DFloat(&s, j == 2, P + 3*i + j)) {
+                return capeUH3D_ERR_VALUE;
+            }
+        }
+    }
+    // Tris: "k, i0, i1, i2, compID"
+    u->nsection = capeUH3D_TRIS;
+    for (i=0; i<u->nTri; i++) {
+        s = capec_UH3DLine(b, u);
+        if (s == NULL) {
+            return b->ierr ? capeUH3D_ERR_READ : capeUH3D_ERR_EOF;
+        }
+        if (capec_UH3DInt(&s, 0, &k)) {
+            return capeUH3D_ERR_VALUE;
+        }
+        for (j=0; j<3; j++) {
+            if (capec_UH3DInt(&s, 0, T + 3*i + j)) {
+                return capeUH3D_ERR_VALUE;
+            }
+        }
+        if (capec_UH3DInt(&s, 1, C + i)) {
+            return capeUH3D_ERR_VALUE;
+        }
+    }
+    return capeUH3D_OK;
+}
+
+// Parse component label line
+int
+capec_ParseUH3DLabel(char *line, long *cid, char **name, size_t *n)
+{
+    long long x;
+    char *c, *e, *q;
+    
+    // Exactly one comma
+    c = strchr(line, ',');
+    if (c == NULL || strchr(c + 1, ',') != NULL) {
+        return 0;
+    }
+    // Integer before comma
+    while (capeSCAN_IsSpace(*line)) {line++; }
+    if (capec_ScanI64(line, &e, &x) || x < LONG_MIN || x > LONG_MAX) {
+        return 0;
+    }
+    while (capeSCAN_IsSpace(*e)) {e++; }
+    if (e != c) {
+        return 0;
+    }
+    // Name with spaces, then quotes, removed from both ends
+    e = c + 1;
+    q = e + strlen(e);
+    while (e < q && capeSCAN_IsSpace(*e)) {e++; }
+    while (q > e && capeSCAN_IsSpace(q[-1])) {q--; }
+    while (e < q && *e == '\'') {e++; }
+    while (q > e && q[-1] == '\'') {q--; }
+    // Output
+    *cid = (long) x;
+    *name = e;
+    *n = (size_t) (q - e);
+    return 1;
+}
+
+
+// ======================================================================
+// WRITERS
+// ======================================================================
+
+// Write nodes: "%i, %.12f, %.12f, %.12f\n"
+int
+capec_WriteUH3DNodes(FILE *fid, PyArrayObject *P)
+{
+    int j;
+    size_t i, nNode;
+    char *p0, *p;
+    capecFmtBuf b;
+    
+    // Check for two-dimensional Nx3 array pinned by capec_PinView()
+    if (PyArray_NDIM(P) != 2 || PyArray_DIM(P, 1) != 3 ||
+            !capec_ViewOK(P, NPY_DOUBLE)) {
+        return capeIO_ERR_SHAPE;
+    }
+    nNode = (size_t) PyArray_DIM(P, 0);
+    // Create text buffer
+    if (capec_FmtBufInit(&b, fid)) {
+        return capeIO_ERR_MEM;
+    }
+    // Loop through nodes
+    for (i=0; i<nNode; i++) {
+        // Get room for one row
+        p0 = capec_FmtBufReserve(&b, 24 + 3*(capeFMT_MAXNUM + 2));
+        if (p0 == NULL) {break; }
+        p = p0;
+        p += capec_FmtI(p, (long) i + 1);
+        for (j=0; j<3; j++) {
+            *(p++) = ',';
+            *(p++) = ' ';
+            p += capec_FmtF(p, np2dv(P,i,j), 12);
+        }
+        *(p++) = '\n';
+        capec_FmtBufCommit(&b, p - p0);
+    }
+    // Write remaining text
+    if (capec_FmtBufClose(&b) || i != nNode) {
+        return capeIO_ERR_WRITE;
+    }
+    return 0;
+}
+
+// Write tris: "%i, %i, %i, %i, %i\n"
+int
+capec_WriteUH3DTris(FILE *fid, PyArrayObject *T, PyArrayObject *C)
+{
+    int j;
+    size_t i, nTri;
+    char *p0, *p;
+    capecFmtBuf b;
+    
+    // Check for Nx3 tris and N component IDs pinned by capec_PinView()
+    if (PyArray_NDIM(T) != 2 || PyArray_DIM(T, 1) != 3 ||
+            PyArray_NDIM(C) != 1 || PyArray_DIM(C, 0) != PyArray_DIM(T, 0) ||
+            !capec_ViewOK(T, NPY_INT) || !capec_ViewOK(C, NPY_INT)) {
+        return capeIO_ERR_SHAPE;
+    }
+    nTri = (size_t) PyArray_DIM(T, 0);
+    // Create text buffer
+    if (capec_FmtBufInit(&b, fid)) {
+        return capeIO_ERR_MEM;
+    }
+    // Loop through tris
+    for (i=0; i<nTri; i++) {
+        // Get room for one row
+        p0 = capec_FmtBufReserve(&b, 5*24);
+        if (p0 == NULL) {break; }
+        p = p0;
+        p += capec_FmtI(p, (long) i + 1);
+        for (j=0; j<3; j++) {
+            *(p++) = ',';
+            *(p++) = ' ';
+            p += capec_FmtI(p, np2iv(T,i,j));
+        }
+        *(p++) = ',';
+        *(p++) = ' ';
+        p += capec_FmtI(p, np1iv(C,i));
+        *(p++) = '\n';
+        capec_FmtBufCommit(&b, p - p0);
+    }
+    // Write remaining text
+    if (capec_FmtBufClose(&b) || i != nTri) {
+        return capeIO_ERR_WRITE;
+    }
+    return 0;
+}
@@ -0,0 +1,470 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#ifdef capeHAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef capeHAVE_ZSTD
+#include <zstd.h>
+#endif
+#if defined(capeHAVE_ZLIB) || defined(capeHAVE_ZSTD)
+#define capeZIP_ANY
+#endif
+
+// Local includes
+#include "capec_Pipe.h"
+#include "capec_Thread.h"
+#include "capec_Zip.h"
+
+// Largest amount of input passed to zlib at once
+#define capeZIP_CHUNK (1 << 30)
+
+
+// State of compressing stream
+typedef struct {
+    int codec;              // compression format
+    int sync;               // what to do after last write
+    FILE *out;              // stream for compressed output (owned)
+    char *buf;              // compressed output buffer
+    off_t nin;              // uncompressed bytes written by caller
+#ifdef capeHAVE_ZLIB
+    z_stream z;
+#endif
+#ifdef capeHAVE_ZSTD
+    ZSTD_CCtx *zc;
+#endif
+} capecZip;
+
+
+// ======================================================================
+// FORMATS
+// ======================================================================
+
+// Check if file name ends with a suffix
+static int
+capec_ZipEndsWith(const char *fname, const char *ext)
+{
+    size_t n, m;
+    
+    n = strlen(fname);
+    m = strlen(ext);
+    return n > m && strcmp(fname + n - m, ext) == 0;
+}
+
+// Get compression format from file name
+int
+capec_ZipCodec(const char *fname)
+{
+    if (capec_ZipEndsWith(fname, ".gz")) {
+        return capeZIP_GZIP;
+    }
+    if (capec_ZipEndsWith(fname, ".zst")) {
+        return capeZIP_ZSTD;
+    }
+    return capeZIP_NONE;
+}
+
+// Check if a compression format is available in this build
+int
+capec_ZipAvailable(int codec)
+{
+    switch (codec) {
+        case capeZIP_NONE:
+            return 1;
+#ifdef capeHAVE_ZLIB
+        case capeZIP_GZIP:
+            return 1;
+#endif
+#ifdef capeHAVE_ZSTD
+        case capeZIP_ZSTD:
+            return 1;
+#endif
+        default:
+            return 0;
+    }
+}
+
+// Name of a compression format for messages
+const char *
+capec_ZipName(int codec)
+{
+    switch (codec) {
+        case capeZIP_GZIP:
+            return "gzip";
+        case capeZIP_ZSTD:
+            return "zstd";
+        default:
+            return "no";
+    }
+}
+
+
+// ======================================================================
+// COMPRESSION
+// ======================================================================
+
+// Compress *n* bytes (and finish the data if *end*) into output stream
+static int
+capec_ZipDeflate(capecZip *z, const char *data, size_t n, int end)
+{
+#ifdef capeHAVE_ZLIB
+    int ierr, flush;
+    size_t k, nout;
+#endif
+#ifdef capeHAVE_ZSTD
+    size_t left, mout;
+    ZSTD_inBuffer in;
+    ZSTD_outBuffer out;
+#endif
+    
+#ifdef capeHAVE_ZLIB
+    if (z->codec == capeZIP_GZIP) {
+        // Loop through chunks that fit in zlib's counters
+        do {
+            k = (n < capeZIP_CHUNK) ? n : capeZIP_CHUNK;
+            z->z.next_in = (Bytef *) data;
+            z->z.avail_in = (uInt) k;
+            data += k;
+            n -= k;
+            flush = (end && n == 0) ? Z_FINISH : Z_NO_FLUSH;
+            // Compress until zlib has room left in the output buffer
+            do {
+                z->z.next_out = (Bytef *) z->buf;
+                z->z.avail_out = capeZIP_BUFSIZE;
+                ierr = deflate(&z->z, flush);
+                if (ierr == Z_STREAM_ERROR) {
+                    return 1;
+                }
+                nout = capeZIP_BUFSIZE - z->z.avail_out;
+                if (nout > 0 && fwrite(z->buf, 1, nout, z->out) != nout) {
+                    return 1;
+                }
+            } while (z->z.avail_out == 0 ||
+                (flush == Z_FINISH && ierr != Z_STREAM_END));
+        } while (n > 0);
+        return 0;
+    }
+#endif
+#ifdef capeHAVE_ZSTD
+    if (z->codec == capeZIP_ZSTD) {
+        // Compress until all input is taken (and flushed, at the end)
+        in.src = data;
+        in.size = n;
+        in.pos = 0;
+        do {
+            out.dst = z->buf;
+            out.size = capeZIP_BUFSIZE;
+            out.pos = 0;
+            left = ZSTD_compressStream2(z->zc, &out, &in,
+                end ? ZSTD_e_end : ZSTD_e_continue);
+            if (ZSTD_isError(left)) {
+                return 1;
+            }
+            mout = out.pos;
+            if (mout > 0 && fwrite(z->buf, 1, mout, z->out) != mout) {
+                return 1;
+            }
+        } while (in.pos < in.size || (end && left > 0));
+        return 0;
+    }
+#endif
+    // Not available
+    return 1;
+}
+
+// Compress output of caller
+static ssize_t
+capec_ZipWrite(void *cookie, const char *data, size_t n)
+{
+    capecZip *z = (capecZip *) cookie;
+    
+    if (capec_ZipDeflate(z, data, n, 0)) {
+        return -1;
+    }
+    z->nin += (off_t) n;
+    return (ssize_t) n;
+}
+
+// Report uncompressed size so far (for ``ftell()``)
+static off_t
+capec_ZipTell(void *cookie)
+{
+    return ((capecZip *) cookie)->nin;
+}
+
+// Release compressor
+static void
+capec_ZipFree(capecZip *z)
+{
+#ifdef capeHAVE_ZLIB
+    if (z->codec == capeZIP_GZIP) {
+        deflateEnd(&z->z);
+    }
+#endif
+#ifdef capeHAVE_ZSTD
+    if (z->codec == capeZIP_ZSTD) {
+        ZSTD_freeCCtx(z->zc);
+    }
+#endif
+    free(z->buf);
+    free(z);
+}
+
+// Finish compressed data, then sync and close output
+static int
+capec_ZipClose(void *cookie)
+{
+    int ierr;
+    int fd;
+    capecZip *z = (capecZip *) cookie;
+    
+    // Write end of compressed data
+    ierr = capec_ZipDeflate(z, NULL, 0, 1);
+    ierr = ierr || fflush(z->out);
+    // Sync ordinary files; custom (e.g. pipelined) streams sync themselves
+    fd = fileno(z->out);
+    if (!ierr && fd >= 0) {
+        ierr = capec_PipeSync(fd, z->sync);
+    }
+    ierr = fclose(z->out) || ierr;
+    capec_ZipFree(z);
+    return ierr;
+}
+
+// Open stream that compresses its output into another stream
+FILE *
+capec_ZipOpen(FILE *out, int codec, int sync)
+{
+    int ierr = 1;
+    FILE *fp;
+    capecZip *z;
+    
+    // Check format
+    if (codec == capeZIP_NONE || !capec_ZipAvailable(codec)) {
+        return NULL;
+    }
+    // Allocate state
+    z = (capecZip *) calloc(1, sizeof(capecZip));
+    if (z == NULL) {
+        return NULL;
+    }
+    z->codec = codec;
+    z->sync = sync;
+    z->out = out;
+    z->buf = (char *) malloc(capeZIP_BUFSIZE);
+    if (z->buf == NULL) {
+        free(z);
+        return NULL;
+    }
+#ifdef capeHAVE_ZLIB
+    if (codec == capeZIP_GZIP) {
+        // Window bits + 16 for gzip header and trailer
+        ierr = deflateInit2(&z->z, capeZIP_GZIPLEVEL, Z_DEFLATED, 15 + 16,
+            8, Z_DEFAULT_STRATEGY) != Z_OK;
+    }
+#endif
+#ifdef capeHAVE_ZSTD
+    if (codec == capeZIP_ZSTD) {
+        z->zc = ZSTD_createCCtx();
+        ierr = (z->zc == NULL);
+        if (!ierr) {
+            ZSTD_CCtx_setParameter(z->zc, ZSTD_c_compressionLevel,
+                capeZIP_ZSTDLEVEL);
+            // Fails (and is ignored) if library has no thread support
+            ZSTD_CCtx_setParameter(z->zc, ZSTD_c_nbWorkers,
+                capec_ThreadCount());
+        }
+    }
+#endif
+    if (ierr) {
+        free(z->buf);
+        free(z);
+        return NULL;
+    }
+    // Create stream; large buffer so compressor gets big pieces
+    fp = capec_PipeCustomOpen(z, capec_ZipWrite, capec_ZipTell,
+        capec_ZipClose);
+    if (fp == NULL) {
+        capec_ZipFree(z);
+        return NULL;
+    }
+    setvbuf(fp, NULL, _IOFBF, capeZIP_BUFSIZE);
+    return fp;
+}
+
+
+// ======================================================================
+// DECOMPRESSION
+// ======================================================================
+
+#ifdef capeZIP_ANY
+// Grow output buffer
+static int
+capec_ZipGrow(char **data, size_t *cap, size_t need)
+{
+    char *p;
+    size_t m;
+    
+    // Check if already big enough
+    if (need <= *cap) {
+        return 0;
+    }
+    // Double until big enough
+    m = *cap;
+    while (m < need) {
+        m *= 2;
+    }
+    p = (char *) realloc(*data, m);
+    if (p == NULL) {
+        return 1;
+    }
+    *data = p;
+    *cap = m;
+    return 0;
+}
+#endif
+
+// Decompress a whole file from memory
+int
+capec_ZipInflate(const char *src, size_t n, int codec, char **data,
+    size_t *size)
+{
+    int ierr = capeZIP_ERR_CODEC;
+    size_t nout;
+#ifdef capeZIP_ANY
+    size_t cap;
+#endif
+#ifdef capeHAVE_ZLIB
+    int zerr;
+    unsigned int isize;
+    size_t k, m;
+    z_stream z;
+#endif
+#ifdef capeHAVE_ZSTD
+    size_t left;
+    unsigned long long nframe;
+    ZSTD_DCtx *zd;
+    ZSTD_inBuffer in;
+    ZSTD_outBuffer out;
+#endif
+    
+    // Initialize
+    *data = NULL;
+    *size = 0;
+    if (!capec_ZipAvailable(codec) || codec == capeZIP_NONE) {
+        return capeZIP_ERR_CODEC;
+    }
+#ifdef capeZIP_ANY
+    cap = 2*n + 4096;
+#endif
+    nout = 0;
+#ifdef capeHAVE_ZLIB
+    if (codec == capeZIP_GZIP) {
+        // Last member's size (mod 2^32) is in last four bytes
+        if (n >= 4) {
+            isize = (unsigned int) ((unsigned char) src[n-4]) |
+                ((unsigned int) ((unsigned char) src[n-3]) << 8) |
+                ((unsigned int) ((unsigned char) src[n-2]) << 16) |
+                ((unsigned int) ((unsigned char) src[n-1]) << 24);
+            cap = (isize + (size_t) 1 > cap) ? isize + (size_t) 1 : cap;
+        }
+        // Window bits + 32 to detect gzip or zlib header
+        memset(&z, 0, sizeof(z));
+        if (inflateInit2(&z, 15 + 32) != Z_OK) {
+            return capeZIP_ERR_MEM;
+        }
+        *data = (char *) malloc(cap);
+        ierr = (*data == NULL) ? capeZIP_ERR_MEM : capeZIP_OK;
+        while (!ierr) {
+            // Make room
+            if (cap - nout < capeZIP_BUFSIZE &&
+                    capec_ZipGrow(data, &cap, cap + capeZIP_BUFSIZE)) {
+                ierr = capeZIP_ERR_MEM;
+                break;
+            }
+            // Pieces that fit in zlib's counters
+            k = (n < capeZIP_CHUNK) ? n : capeZIP_CHUNK;
+            m = cap - nout;
+            m = (m < capeZIP_CHUNK) ? m : capeZIP_CHUNK;
+            z.next_in = (Bytef *) src;
+            z.avail_in = (uInt) k;
+            z.next_out = (Bytef *) (*data + nout);
+            z.avail_out = (uInt) m;
+            zerr = inflate(&z, Z_NO_FLUSH);
+            // Count input used and output made
+            src += k - z.avail_in;
+            n -= k - z.avail_in;
+            nout += m - z.avail_out;
+            if (zerr == Z_STREAM_END) {
+                // Another member may follow
+                if (n == 0) {
+                    break;
+                }
+                if (inflateReset(&z) != Z_OK) {
+                    ierr = capeZIP_ERR_DATA;
+                }
+            } else if (zerr == Z_MEM_ERROR) {
+                ierr = capeZIP_ERR_MEM;
+            } else if (zerr != Z_OK && zerr != Z_BUF_ERROR) {
+                ierr = capeZIP_ERR_DATA;
+            } else if (n == 0 && z.avail_out > 0) {
+                // Input ended in the middle of a member
+                ierr = capeZIP_ERR_DATA;
+            }
+        }
+        inflateEnd(&z);
+    }
+#endif
+#ifdef capeHAVE_ZSTD
+    if (codec == capeZIP_ZSTD) {
+        // Size of first frame, if recorded
+        nframe = ZSTD_getFrameContentSize(src, n);
+        if (nframe != ZSTD_CONTENTSIZE_UNKNOWN &&
+                nframe != ZSTD_CONTENTSIZE_ERROR && nframe + 1 > cap &&
+                nframe < (unsigned long long) (SIZE_MAX / 2)) {
+            cap = (size_t) nframe + 1;
+        }
+        zd = ZSTD_createDCtx();
+        if (zd == NULL) {
+            return capeZIP_ERR_MEM;
+        }
+        *data = (char *) malloc(cap);
+        ierr = (*data == NULL) ? capeZIP_ERR_MEM : capeZIP_OK;
+        in.src = src;
+        in.size = n;
+        in.pos = 0;
+        left = 1;
+        // Frames are decoded one after another
+        while (!ierr && (in.pos < in.size || left > 0)) {
+            if (cap - nout < capeZIP_BUFSIZE &&
+                    capec_ZipGrow(data, &cap, cap + capeZIP_BUFSIZE)) {
+                ierr = capeZIP_ERR_MEM;
+                break;
+            }
+            out.dst = *data;
+            out.size = cap;
+            out.pos = nout;
+            left = ZSTD_decompressStream(zd, &out, &in);
+            if (ZSTD_isError(left)) {
+                ierr = capeZIP_ERR_DATA;
+            } else if (left > 0 && in.pos == in.size && out.pos < cap) {
+                // Needs more input than there is
+                ierr = capeZIP_ERR_DATA;
+            }
+            nout = out.pos;
+        }
+        ZSTD_freeDCtx(zd);
+    }
+#endif
+    // Output
+    if (ierr) {
+        free(*data);
+        *data = NULL;
+        return ierr;
+    }
+    *size = nout;
+    return capeZIP_OK;
+}
@@ -9,14 +9,15 @@
 #define NO_IMPORT_ARRAY
 #include <numpy/arrayobject.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
 #include <byteswap.h>
 
 // Local includes
 #include "capec_NumPy.h"
-
-// Byteswap macros
-#define bs32(x) (*(unsigned *)&(x) = __bswap_32(*(unsigned *)&(x)))
-#define bs64(x) (*(unsigned long *)&(x) = __bswap_64(*(unsigned long *)&(x)))
+#include "capec_Memory.h"
+#include "capec_io.h"
+#include "capec_Swap.h"
 
 // Function to test if system is little-endian
 int is_le(void)
@@ -26,17 +27,17 @@ int is_le(void)
 }
 
 // Function get size of array (PyArray_SIZE has some issues)
-int np_size(PyArrayObject *P)
+size_t np_size(PyArrayObject *P)
 {
-    int j, m, nj;
-    int n = 1;
+    int j, m;
+    size_t n = 1;
     
     // Get number of dimensions
     m = (int) PyArray_NDIM(P);
     // Loop through dimensions
     for (j=0; j<m; j++) {
         // Multiply the total size
-        n *= (int) PyArray_DIM(P, j);
+        n *= (size_t) PyArray_DIM(P, j);
     }
     
     // Output
@@ -175,914 +176,516 @@ int capec_Write_lb4_f(FILE *fid, float v)
 // INDIVIDUAL DOUBLES
 // ======================================================================
 
-// Write big-endian double
+// Write big-endian double as single-precision float
 int capec_Write_b4_d(FILE *fid, double v)
 {
-    int n;
-    
-    // Byte swap if necessary
-    if (is_le()) {bs64(v); }
-    // Write.
-    n = fwrite(&v, sizeof(int), 1, fid);
-    
-    if (n == 1) {
-        return 0;
-    } else {
-        return 1;
-    }
+    return capec_Write_b4_f(fid, (float) v);
 }
 
-// Write little-endian double
+// Write little-endian double as single-precision float
 int capec_Write_lb4_d(FILE *fid, double v)
 {
-    int n;
-    
-    // Byte swap if necessary
-    if (!is_le()) {bs64(v); }
-    // Write.
-    n = fwrite(&v, sizeof(int), 1, fid);
-    
-    if (n == 1) {
-        return 0;
-    } else {
-        return 1;
-    }
+    return capec_Write_lb4_f(fid, (float) v);
 }
 
 
 // ======================================================================
-// 1D INTEGER RECORDS
+// RECORD CORE
 // ======================================================================
 
-// Write native, single-precision integer record from 1D array
-int capec_WriteRecord_ne4_i1(FILE *fid, PyArrayObject *P)
+// Write one Fortran record marker
+int capec_WriteMarker(FILE *fid, int nb, int swap)
 {
-    int i;
-    int v;
-    int n, nb;
-    
-    // Check dims
-    if (PyArray_NDIM(P) != 1) {
-        PyErr_SetString(PyExc_ValueError, "Object must be a 1-D array.");
-        return 2;
-    }
-    // Number of points
-    n = (int) PyArray_DIM(P, 0);
-    
-    // Number of bytes for record marker
-    nb = n * sizeof(int);
-    // Record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    
-    // Loop through elements
-    for (i=0; i<n; i++) {
-        // Get value
-        v = np1i(P,i);
-        fwrite(&v, sizeof(int), 1, fid);
+    // Byte-swap if necessary
+    if (swap) {nb = __bswap_32(nb); }
+    // Write
+    if (fwrite(&nb, sizeof(int), 1, fid) != 1) {
+        return 1;
     }
-    // End-of-record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    // Success
     return 0;
 }
 
-// Write byte-swapped, single-precision integer record from 1D array
-int capec_WriteRecord_bs4_i1(FILE *fid, PyArrayObject *P)
+// Write one header count as a 4- or 8-byte integer
+int capec_WriteCount(FILE *fid, size_t v, int ni, int swap)
 {
-    int i;
-    int v;
-    int n, nb;
-    
-    // Check dims
-    if (PyArray_NDIM(P) != 1) {
-        PyErr_SetString(PyExc_ValueError, "Object must be a 1-D array.");
-        return 2;
-    }
-    // Number of points
-    n = (int) PyArray_DIM(P, 0);
-    
-    // Number of bytes for record marker
-    nb = __bswap_32(n * sizeof(int));
-    // Record marker
-    fwrite(&nb, sizeof(int), 1, fid);
+    int32_t u4;
+    int64_t u8;
     
-    // Loop through elements
-    for (i=0; i<n; i++) {
-        // Get value
-        v = __bswap_32(np1i(P,i));
-        fwrite(&v, sizeof(int), 1, fid);
-    }
-    // End-of-record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    // Success
-    return 0;
-}
-
-// Write big-endian, single-precision integer record from 1D array
-int capec_WriteRecord_b4_i1(FILE *fid, PyArrayObject *P)
-{
-    if (is_le()) {
-        return capec_WriteRecord_bs4_i1(fid, P);
-    } else {
-        return capec_WriteRecord_ne4_i1(fid, P);
+    // Eight-byte integer
+    if (ni == 8) {
+        u8 = (int64_t) v;
+        if (swap) {u8 = __bswap_64(u8); }
+        return fwrite(&u8, 8, 1, fid) != 1;
     }
+    // Check that count fits
+    if (v > INT32_MAX)
+        return capeIO_ERR_SIZE;
+    u4 = (int32_t) v;
+    if (swap) {u4 = __bswap_32(u4); }
+    return fwrite(&u4, 4, 1, fid) != 1;
 }
 
-// Write little-endian, single-precision integer record from 1D array
-int capec_WriteRecord_lb4_i1(FILE *fid, PyArrayObject *P)
-{
-    if (is_le()) {
-        return capec_WriteRecord_ne4_i1(fid, P);
-    } else {
-        return capec_WriteRecord_bs4_i1(fid, P);
-    }
-}
-
-
-// ======================================================================
-// 2D INTEGER RECORDS
-// ======================================================================
-
-// Write native, single-precision integer record from 2D array
-int capec_WriteRecord_ne4_i2(FILE *fid, PyArrayObject *P)
+// Get aligned, native, C-contiguous array of one type
+PyArrayObject *capec_PinArray(PyObject *P, int typenum, int ndim)
 {
-    int i, j;
-    int v;
-    int m, n, nb;
+    PyArrayObject *A;
     
-    // Check dims
-    if (PyArray_NDIM(P) != 2) {
-        PyErr_SetString(PyExc_ValueError, "Object must be a 2-D array.");
-        return 2;
-    }
-    // Number of points
-    m = (int) PyArray_DIM(P, 0);
-    n = (int) PyArray_DIM(P, 1);
-    
-    // Number of bytes for record marker
-    nb = m * n * sizeof(int);
-    // Record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    
-    // Loop through rows as outer loop
-    for (i=0; i<m; i++) {
-        // Loop through columns as inner loop
-        for (j=0; j<n; j++) {
-            // Get value
-            v = np2i(P,i,j);
-            fwrite(&v, sizeof(int), 1, fid);
-        }
+    // Check type
+    if (!PyArray_Check(P)) {
+        PyErr_SetString(PyExc_TypeError, "Object must be a NumPy array.");
+        return NULL;
     }
-    // End-of-record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    // Success
-    return 0;
-}
-
-// Write byte-swapped, single-precision integer record from 2D array
-int capec_WriteRecord_bs4_i2(FILE *fid, PyArrayObject *P)
-{
-    int i, j;
-    int v;
-    int m, n, nb;
-    
     // Check dims
-    if (PyArray_NDIM(P) != 2) {
-        PyErr_SetString(PyExc_ValueError, "Object must be a 2-D array.");
-        return 2;
+    if (PyArray_NDIM((PyArrayObject *) P) != ndim) {
+        PyErr_Format(PyExc_ValueError,
+            "Object must be a %i-D array.", ndim);
+        return NULL;
     }
-    // Number of points
-    m = (int) PyArray_DIM(P, 0);
-    n = (int) PyArray_DIM(P, 1);
-    
-    // Number of bytes for record marker
-    nb = __bswap_32(m * n * sizeof(int));
-    // Record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    
-    // Loop through rows as outer loop
-    for (i=0; i<m; i++) {
-        // Loop through columns as inner loop
-        for (j=0; j<n; j++) {
-            // Get value
-            v = __bswap_32(np2i(P,i,j));
-            fwrite(&v, sizeof(int), 1, fid);
-        }
-    }
-    // End-of-record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    // Success
-    return 0;
+    // New reference; no copy if already so
+    A = (PyArrayObject *) PyArray_FROM_OTF(P, typenum, NPY_ARRAY_IN_ARRAY);
+    return A;
 }
 
-// Write big-endian, single-precision integer record from 2D array
-int capec_WriteRecord_b4_i2(FILE *fid, PyArrayObject *P)
+// Check if writers can read array directly
+int capec_ViewOK(PyArrayObject *P, int typenum)
 {
-    if (is_le()) {
-        return capec_WriteRecord_bs4_i2(fid, P);
-    } else {
-        return capec_WriteRecord_ne4_i2(fid, P);
-    }
+    // Byte order and alignment
+    if (!PyArray_ISALIGNED(P) || !PyArray_ISNOTSWAPPED(P))
+        return 0;
+    // Floats
+    if (typenum == NPY_DOUBLE)
+        return PyArray_TYPE(P) == NPY_FLOAT || PyArray_TYPE(P) == NPY_DOUBLE;
+    // Signed integers with 4 or 8 bytes
+    return PyArray_ISSIGNED(P) &&
+        (PyArray_ITEMSIZE(P) == 4 || PyArray_ITEMSIZE(P) == 8);
 }
 
-// Write little-endian, single-precision integer record from 2D array
-int capec_WriteRecord_lb4_i2(FILE *fid, PyArrayObject *P)
+// Get array that writers can read directly, converting only if needed
+PyArrayObject *capec_PinView(PyObject *P, int typenum, int ndim)
 {
-    if (is_le()) {
-        return capec_WriteRecord_ne4_i2(fid, P);
-    } else {
-        return capec_WriteRecord_bs4_i2(fid, P);
+    // Check type
+    if (!PyArray_Check(P)) {
+        PyErr_SetString(PyExc_TypeError, "Object must be a NumPy array.");
+        return NULL;
     }
-}
-
-
-// ======================================================================
-// 3D FLOAT RECORDS
-// ======================================================================
-
-// Write native, single-precision integer record from 3D array
-int capec_WriteRecord_ne4_i3(FILE *fid, PyArrayObject *P)
-{
-    int j, k, l;
-    int v;
-    int nj, nk, nl, nb;
-    
     // Check dims
-    if (PyArray_NDIM(P) != 3) {
-        PyErr_SetString(PyExc_ValueError, "Object must be a 3-D array.");
-        return 2;
-    }
-    // Number of points
-    nj = (int) PyArray_DIM(P, 0);
-    nk = (int) PyArray_DIM(P, 1);
-    nl = (int) PyArray_DIM(P, 2);
-    
-    // Number of bytes for record marker
-    nb = nj * nk * nl * sizeof(int);
-    // Record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    
-    // Loop through rows as outer loop
-    for (j=0; j<nj; j++) {
-        // Loop through columns as inner loop
-        for (k=0; k<nk; k++) {
-            // Loop through third dimension
-            for (l=0; l<nl; l++) {
-                // Get value
-                v = np3i(P,j,k,l);
-                fwrite(&v, sizeof(int), 1, fid);
-            }
+    if (PyArray_NDIM((PyArrayObject *) P) != ndim) {
+        PyErr_Format(PyExc_ValueError,
+            "Object must be a %i-D array.", ndim);
+        return NULL;
+    }
+    // Use caller's array, including strided views, if possible
+    if (capec_ViewOK((PyArrayObject *) P, typenum)) {
+        Py_INCREF(P);
+        return (PyArrayObject *) P;
+    }
+    // Otherwise convert (e.g. float16, uint8, or byte-swapped)
+    return (PyArrayObject *) PyArray_FROM_OTF(P, typenum,
+        NPY_ARRAY_IN_ARRAY);
+}
+
+// Set Python exception for status of writer
+void capec_IOSetError(int ierr, const char *what, const char *name)
+{
+    // Exception already set, e.g. while opening file
+    if (PyErr_Occurred())
+        return;
+    // Check status
+    if (ierr == capeIO_ERR_SHAPE) {
+        PyErr_Format(PyExc_ValueError,
+            "Invalid array for %s written to '%s'", what, name);
+    } else if (ierr == capeIO_ERR_SIZE) {
+        PyErr_Format(PyExc_ValueError,
+            "Size or values of %s too large for 4-byte integers in '%s'; "
+            "use 8-byte integers", what, name);
+    } else if (ierr == capeIO_ERR_MEM) {
+        PyErr_Format(PyExc_MemoryError,
+            "Failed to allocate buffer for %s", what);
+    } else if (ierr) {
+        PyErr_Format(PyExc_IOError,
+            "Failure writing %s to '%s'", what, name);
+    }
+}
+
+// Element kind of an array that passes capec_ViewOK()
+static int capec_ViewKind(PyArrayObject *P)
+{
+    if (PyArray_TYPE(P) == NPY_FLOAT)
+        return capeREC_F4;
+    if (PyArray_TYPE(P) == NPY_DOUBLE)
+        return capeREC_F8;
+    return (PyArray_ITEMSIZE(P) == 8) ? capeREC_I8 : capeREC_I4;
+}
+
+// Convert *m* entries with stride *s* from type *TS* to *TD*
+#define capeIO_CONVERT(TS, TD) { \
+    TD *d = (TD *) dst; \
+    if (s == (ptrdiff_t) sizeof(TS)) { \
+        for (i=0; i<m; i++) d[i] = (TD) ((const TS *) src)[i]; \
+    } else { \
+        for (i=0; i<m; i++, src+=s) d[i] = (TD) *((const TS *) src); \
+    } \
+    break; \
+}
+
+// Narrow *m* int64 entries with stride *s* to int32, checking range
+static int capec_NarrowI64(npy_int32 *d, const char *src, ptrdiff_t s,
+    size_t m)
+{
+    size_t i;
+    npy_int64 v;
+    
+    for (i=0; i<m; i++, src+=s) {
+        v = *((const npy_int64 *) src);
+        if (v < INT32_MIN || v > INT32_MAX) {
+            return capeIO_ERR_SIZE;
         }
-    }
-    // End-of-record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    // Success
-    return 0;
-}
-
-// Write byte-swapped, single-precision integer record from 3D array
-int capec_WriteRecord_bs4_i3(FILE *fid, PyArrayObject *P)
-{
-    int j, k, l;
-    int v;
-    int nj, nk, nl, nb;
-    
-    // Check dims
-    if (PyArray_NDIM(P) != 3) {
-        PyErr_SetString(PyExc_ValueError, "Object must be a 3-D array.");
-        return 2;
-    }
-    // Number of points
-    nj = (int) PyArray_DIM(P, 0);
-    nk = (int) PyArray_DIM(P, 1);
-    nl = (int) PyArray_DIM(P, 2);
-    
-    // Number of bytes for record marker
-    nb = __bswap_32(nj*nk*nl * sizeof(int));
-    // Record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    
-    // Loop through rows as outer loop
-    for (j=0; j<nj; j++) {
-        // Loop through columns as inner loop
-        for (k=0; k<nk; k++) {
-            // Loop through third dimension
-            for (l=0; l<nl; l++) {
-                // Get value
-                v = __bswap_32(np3i(P,j,k,l));
-                fwrite(&v, sizeof(int), 1, fid);
+        d[i] = (npy_int32) v;
+    }
+    return capeIO_OK;
+}
+
+// Convert one run of entries to output kind (no byte swap)
+static int capec_ConvertRun(void *dst, int rtype, const char *src,
+    int kind, ptrdiff_t s, size_t m)
+{
+    size_t i;
+    
+    // Specialized loop for each pair of input and output kinds
+    switch (4*kind + rtype) {
+        case 4*capeREC_I4 + capeREC_I4: capeIO_CONVERT(npy_int32, npy_int32)
+        case 4*capeREC_I4 + capeREC_I8: capeIO_CONVERT(npy_int32, npy_int64)
+        case 4*capeREC_I8 + capeREC_I4:
+            // Only narrowing integer conversion; values may not fit
+            return capec_NarrowI64((npy_int32 *) dst, src, s, m);
+        case 4*capeREC_I8 + capeREC_I8: capeIO_CONVERT(npy_int64, npy_int64)
+        case 4*capeREC_F4 + capeREC_F4: capeIO_CONVERT(float, float)
+        case 4*capeREC_F4 + capeREC_F8: capeIO_CONVERT(float, double)
+        case 4*capeREC_F8 + capeREC_F4: capeIO_CONVERT(double, float)
+        case 4*capeREC_F8 + capeREC_F8: capeIO_CONVERT(double, double)
+    }
+    return capeIO_OK;
+}
+
+// Gather *k* entries starting at run *r*, offset *c* into staging buffer
+//  Each run is the whole array if it is C-contiguous, else one row along
+//  the last axis with its own (possibly negative) stride.  Fortran-ordered
+//  and other strided arrays, including 1-D views such as ``a[::2]``, are
+//  read in C order directly from the caller's memory.  Returns
+//  ``capeIO_ERR_SIZE`` if an int64 entry doesn't fit in a 4-byte integer.
+static int capec_GatherRuns(char *stage, int rtype, size_t wsize,
+    PyArrayObject *P, int ndim, int contig, size_t *r, size_t *c, size_t k)
+{
+    int j, kind;
+    size_t q, m, ncol;
+    ptrdiff_t s;
+    const char *src;
+    
+    // Input kind, stride, and length of each run
+    kind = capec_ViewKind(P);
+    if (contig) {
+        s = (ptrdiff_t) PyArray_ITEMSIZE(P);
+        ncol = (size_t) PyArray_SIZE(P);
+    } else {
+        s = (ptrdiff_t) PyArray_STRIDE(P, ndim - 1);
+        ncol = (size_t) PyArray_DIM(P, ndim - 1);
+    }
+    // Fill buffer run by run
+    while (k > 0) {
+        // Start of run *r* (unravel over leading axes)
+        src = PyArray_BYTES(P);
+        if (!contig) {
+            for (q=*r, j=ndim-2; j>=0; j--) {
+                src += (q % (size_t) PyArray_DIM(P, j))*PyArray_STRIDE(P, j);
+                q /= (size_t) PyArray_DIM(P, j);
             }
         }
+        // Convert as much of this run as fits
+        m = (ncol - *c < k) ? ncol - *c : k;
+        if (capec_ConvertRun(stage, rtype, src + (ptrdiff_t) *c*s,
+                kind, s, m)) {
+            return capeIO_ERR_SIZE;
+        }
+        stage += m*wsize;
+        k -= m;
+        *c += m;
+        if (*c == ncol) {
+            *c = 0;
+            (*r)++;
+        }
     }
-    // End-of-record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    // Success
-    return 0;
-}
-
-// Write big-endian, single-precision float record from 3D array
-int capec_WriteRecord_b4_i3(FILE *fid, PyArrayObject *P)
-{
-    if (is_le()) {
-        return capec_WriteRecord_bs4_i3(fid, P);
-    } else {
-        return capec_WriteRecord_ne4_i3(fid, P);
-    }
-}
-
-// Write little-endian, single-precision float record from 3D array
-int capec_WriteRecord_lb4_i3(FILE *fid, PyArrayObject *P)
-{
-    if (is_le()) {
-        return capec_WriteRecord_ne4_i3(fid, P);
-    } else {
-        return capec_WriteRecord_bs4_i3(fid, P);
-    }
+    return capeIO_OK;
+}
+
+// Record being written, possibly split into sub-records
+typedef struct {
+    FILE *fid;          // file handle
+    int swap;           // whether markers are byte-swapped
+    int record;         // whether to write record markers at all
+    int first;          // whether current sub-record is the first one
+    size_t left;        // bytes of record not yet written
+    size_t sub;         // bytes left in current sub-record
+    size_t len;         // length of current sub-record
+} capecRecOut;
+
+// Start next sub-record of up to capeIO_SUBRECMAX bytes
+static int capec_RecHead(capecRecOut *o)
+{
+    o->len = (o->left < capeIO_SUBRECMAX) ? o->left : capeIO_SUBRECMAX;
+    o->sub = o->len;
+    // Leading marker is negative if more sub-records follow
+    return capec_WriteMarker(o->fid,
+        (o->left > o->len) ? -(int) o->len : (int) o->len, o->swap);
+}
+
+// Finish current sub-record
+static int capec_RecTail(capecRecOut *o)
+{
+    int ierr;
+    
+    // Trailing marker is negative if sub-records came before
+    ierr = capec_WriteMarker(o->fid,
+        o->first ? (int) o->len : -(int) o->len, o->swap);
+    o->first = 0;
+    // Start next one
+    if (!ierr && o->left > 0)
+        ierr = capec_RecHead(o);
+    return ierr;
+}
+
+// Start record of *nb* bytes
+static int capec_RecBegin(capecRecOut *o, FILE *fid, size_t nb, int swap,
+    int record)
+{
+    o->fid = fid;
+    o->swap = swap;
+    o->record = record;
+    o->first = 1;
+    o->left = nb;
+    o->sub = nb;
+    o->len = nb;
+    // No markers for stream output
+    if (!record)
+        return 0;
+    // Empty record has both markers right away
+    if (capec_RecHead(o))
+        return 1;
+    return (nb == 0) && capec_WriteMarker(fid, 0, swap);
 }
 
-
-// ======================================================================
-// 1D FLOAT RECORDS
-// ======================================================================
-
-// Write native, single-precision float record from 1D array
-int capec_WriteRecord_ne4_f1(FILE *fid, PyArrayObject *P)
+// Write *nb* bytes of record, adding sub-record markers as needed
+static int capec_RecPut(capecRecOut *o, const char *buf, size_t nb)
 {
-    int i;
-    float v;
-    int n, nb;
+    size_t k;
     
-    // Check dims
-    if (PyArray_NDIM(P) != 1) {
-        PyErr_SetString(PyExc_ValueError, "Object must be a 1-D array.");
-        return 2;
+    while (nb > 0) {
+        // Stay within current sub-record
+        k = (nb < o->sub) ? nb : o->sub;
+        if (fwrite(buf, 1, k, o->fid) != k)
+            return 1;
+        buf += k;
+        nb -= k;
+        o->sub -= k;
+        o->left -= k;
+        // Check for end of sub-record
+        if (o->record && o->sub == 0 && capec_RecTail(o))
+            return 1;
     }
-    // Number of points
-    n = (int) PyArray_DIM(P, 0);
-    
-    // Number of bytes for record marker
-    nb = n * sizeof(float);
-    // Record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    
-    // Loop through elements
-    for (i=0; i<n; i++) {
-        // Get value
-        v = np1d(P,i);
-        fwrite(&v, sizeof(float), 1, fid);
-    }
-    // End-of-record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    // Success
     return 0;
 }
 
-// Write byte-swapped, single-precision float record from 1D array
-int capec_WriteRecord_bs4_f1(FILE *fid, PyArrayObject *P)
+// Write contents of array, with or without Fortran record markers
+static int capec_WriteArray(FILE *fid, PyArrayObject *P, int ndim, int rtype,
+    int swap, int record)
 {
-    int i;
-    float v;
-    int n, nb;
-    
-    // Check dims
-    if (PyArray_NDIM(P) != 1) {
-        PyErr_SetString(PyExc_ValueError, "Object must be a 1-D array.");
-        return 2;
-    }
-    // Number of points
-    n = (int) PyArray_DIM(P, 0);
-    
-    // Number of bytes for record marker
-    nb = __bswap_32(n * sizeof(float));
-    // Record marker
-    fwrite(&nb, sizeof(int), 1, fid);
+    int ierr = 0;
+    int typenum;
+    int kind;
+    int contig;
+    size_t i, n, m, k, wsize, r, c;
+    char *data;
+    char *stage;
+    capecRecOut o;
     
-    // Loop through elements
-    for (i=0; i<n; i++) {
-        // Get value
-        v = (float) np1d(P,i); bs32(v);
-        fwrite(&v, sizeof(float), 1, fid);
-    }
-    // End-of-record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    // Success
-    return 0;
-}
-
-// Write big-endian, single-precision float record from 1D array
-int capec_WriteRecord_b4_f1(FILE *fid, PyArrayObject *P)
-{
-    if (is_le()) {
-        return capec_WriteRecord_bs4_f1(fid, P);
+    // Input type and output word size
+    if (rtype == capeREC_I4 || rtype == capeREC_I8) {
+        typenum = NPY_INT;
     } else {
-        return capec_WriteRecord_ne4_f1(fid, P);
+        typenum = NPY_DOUBLE;
     }
-}
-
-// Write little-endian, single-precision float record from 1D array
-int capec_WriteRecord_lb4_f1(FILE *fid, PyArrayObject *P)
-{
-    if (is_le()) {
-        return capec_WriteRecord_ne4_f1(fid, P);
-    } else {
-        return capec_WriteRecord_bs4_f1(fid, P);
+    wsize = (rtype == capeREC_I4 || rtype == capeREC_F4) ? 4 : 8;
+    // Check for array that can be read directly
+    if (PyArray_NDIM(P) != ndim || ndim < 1 || !capec_ViewOK(P, typenum)) {
+        return capeIO_ERR_SHAPE;
     }
-}
-
-
-// ======================================================================
-// 2D FLOAT RECORDS
-// ======================================================================
-
-// Write native, single-precision float record from 2D array
-int capec_WriteRecord_ne4_f2(FILE *fid, PyArrayObject *P)
-{
-    int i, j;
-    float v;
-    int m, n, nb;
+    // Number of elements and pointer to first one
+    n = (size_t) PyArray_SIZE(P);
+    data = PyArray_BYTES(P);
+    kind = capec_ViewKind(P);
+    contig = PyArray_IS_C_CONTIGUOUS(P);
     
-    // Check dims
-    if (PyArray_NDIM(P) != 2) {
-        PyErr_SetString(PyExc_ValueError, "Object must be a 2-D array.");
-        return 2;
+    // Leading record marker (split into sub-records if needed)
+    if (capec_RecBegin(&o, fid, n*wsize, swap, record)) {
+        return capeIO_ERR_WRITE;
     }
-    // Number of points
-    m = (int) PyArray_DIM(P, 0);
-    n = (int) PyArray_DIM(P, 1);
     
-    // Number of bytes for record marker
-    nb = m * n * sizeof(float);
-    // Record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    
-    // Loop through rows as outer loop
-    for (i=0; i<m; i++) {
-        // Loop through columns as inner loop
-        for (j=0; j<n; j++) {
-            // Get value
-            v = np2d(P,i,j);
-            fwrite(&v, sizeof(int), 1, fid);
+    // Check if any conversion is needed
+    if (contig && kind == rtype && !swap) {
+        // Write entire record at once
+        if (capec_RecPut(&o, data, n*wsize)) {
+            ierr = capeIO_ERR_WRITE;
         }
-    }
-    // End-of-record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    // Success
-    return 0;
-}
-
-// Write byte-swapped, single-precision float record from 2D array
-int capec_WriteRecord_bs4_f2(FILE *fid, PyArrayObject *P)
-{
-    int i, j;
-    float v;
-    int m, n, nb;
-    
-    // Check dims
-    if (PyArray_NDIM(P) != 2) {
-        PyErr_SetString(PyExc_ValueError, "Object must be a 2-D array.");
-        return 2;
-    }
-    // Number of points
-    m = (int) PyArray_DIM(P, 0);
-    n = (int) PyArray_DIM(P, 1);
-    
-    // Number of bytes for record marker
-    nb = __bswap_32(m * n * sizeof(float));
-    // Record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    
-    // Loop through rows as outer loop
-    for (i=0; i<m; i++) {
-        // Loop through columns as inner loop
-        for (j=0; j<n; j++) {
-            // Get value
-            v = (float) np2d(P,i,j);
-            bs32(v);
-            fwrite(&v, sizeof(float), 1, fid);
+    } else if (n > 0) {
+        // Allocate staging buffer
+        stage = (char *) capec_PoolNew(capeIO_STAGESIZE);
+        if (stage == NULL) {
+            return capeIO_ERR_MEM;
+        }
+        // Number of output words per block
+        m = capeIO_STAGESIZE / wsize;
+        // Position in runs of entries (see capec_GatherRuns)
+        r = 0;
+        c = 0;
+        // Loop through blocks
+        for (i=0; i<n; i+=m) {
+            // Size of this block
+            k = (n - i < m) ? n - i : m;
+            // Convert and/or swap block; direct loops need C order
+            if (contig && kind == capeREC_F8 && rtype == capeREC_F4) {
+                capec_NarrowF64((float *) stage,
+                    ((double *) data) + i, k, swap);
+            } else if (contig && kind == rtype) {
+                // Only reached if *swap* (see above)
+                if (wsize == 4) {
+                    capec_Swap4(stage, data + 4*i, k);
+                } else {
+                    capec_Swap8(stage, data + 8*i, k);
+                }
+            } else {
+                // Gather in C order, converting type, then swap in place
+                ierr = capec_GatherRuns(stage, rtype, wsize, P, ndim,
+                    contig, &r, &c, k);
+                if (ierr) {
+                    break;
+                }
+                if (swap && wsize == 4) {
+                    capec_Swap4(stage, stage, k);
+                } else if (swap) {
+                    capec_Swap8(stage, stage, k);
+                }
+            }
+            // Write block
+            if (capec_RecPut(&o, stage, k*wsize)) {
+                ierr = capeIO_ERR_WRITE;
+                break;
+            }
         }
+        // Return staging buffer to pool
+        capec_PoolDel(stage);
     }
-    // End-of-record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    // Success
-    return 0;
+    // Output
+    return ierr;
 }
 
-// Write big-endian, single-precision float record from 2D array
-int capec_WriteRecord_b4_f2(FILE *fid, PyArrayObject *P)
+// Write contents of array as a Fortran record
+int capec_WriteRecord(FILE *fid, PyArrayObject *P, int ndim, int rtype,
+    int swap)
 {
-    if (is_le()) {
-        return capec_WriteRecord_bs4_f2(fid, P);
-    } else {
-        return capec_WriteRecord_ne4_f2(fid, P);
-    }
+    return capec_WriteArray(fid, P, ndim, rtype, swap, 1);
 }
 
-// Write little-endian, single-precision float record from 2D array
-int capec_WriteRecord_lb4_f2(FILE *fid, PyArrayObject *P)
+// Write contents of array without record markers (Fortran stream)
+int capec_WriteStream(FILE *fid, PyArrayObject *P, int ndim, int rtype,
+    int swap)
 {
-    if (is_le()) {
-        return capec_WriteRecord_ne4_f2(fid, P);
-    } else {
-        return capec_WriteRecord_bs4_f2(fid, P);
-    }
+    return capec_WriteArray(fid, P, ndim, rtype, swap, 0);
 }
 
 
 // ======================================================================
-// 3D FLOAT RECORDS
+// TYPED RECORD WRITERS
 // ======================================================================
 
-// Write native, single-precision float record from 3D array
-int capec_WriteRecord_ne4_f3(FILE *fid, PyArrayObject *P)
+// Big-endian, single-precision integer records
+int capec_WriteRecord_b4_i1(FILE *fid, PyArrayObject *P)
 {
-    int j, k, l;
-    float v;
-    int nj, nk, nl, nb;
-    
-    // Check dims
-    if (PyArray_NDIM(P) != 3) {
-        PyErr_SetString(PyExc_ValueError, "Object must be a 3-D array.");
-        return 2;
-    }
-    // Number of points
-    nj = (int) PyArray_DIM(P, 0);
-    nk = (int) PyArray_DIM(P, 1);
-    nl = (int) PyArray_DIM(P, 2);
-    
-    // Number of bytes for record marker
-    nb = nj * nk * nl * sizeof(float);
-    // Record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    
-    // Loop through rows as outer loop
-    for (j=0; j<nj; j++) {
-        // Loop through columns as inner loop
-        for (k=0; k<nk; k++) {
-            // Loop through third dimension
-            for (l=0; l<nl; l++) {
-                // Get value
-                v = np3d(P,j,k,l);
-                fwrite(&v, sizeof(float), 1, fid);
-            }
-        }
-    }
-    // End-of-record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    // Success
-    return 0;
+    return capec_WriteRecord(fid, P, 1, capeREC_I4, is_le());
 }
-
-// Write byte-swapped, single-precision float record from 3D array
-int capec_WriteRecord_bs4_f3(FILE *fid, PyArrayObject *P)
+int capec_WriteRecord_b4_i2(FILE *fid, PyArrayObject *P)
 {
-    int j, k, l;
-    float v;
-    int nj, nk, nl, nb;
-    
-    // Check dims
-    if (PyArray_NDIM(P) != 3) {
-        PyErr_SetString(PyExc_ValueError, "Object must be a 3-D array.");
-        return 2;
-    }
-    // Number of points
-    nj = (int) PyArray_DIM(P, 0);
-    nk = (int) PyArray_DIM(P, 1);
-    nl = (int) PyArray_DIM(P, 2);
-    
-    // Number of bytes for record marker
-    nb = __bswap_32(nj*nk*nl * sizeof(float));
-    // Record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    
-    // Loop through rows as outer loop
-    for (j=0; j<nj; j++) {
-        // Loop through columns as inner loop
-        for (k=0; k<nk; k++) {
-            // Loop through third dimension
-            for (l=0; l<nl; l++) {
-                // Get value
-                v = (float) np3d(P,j,k,l); bs32(v);
-                fwrite(&v, sizeof(float), 1, fid);
-            }
-        }
-    }
-    // End-of-record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    // Success
-    return 0;
+    return capec_WriteRecord(fid, P, 2, capeREC_I4, is_le());
 }
-
-// Write big-endian, single-precision float record from 3D array
-int capec_WriteRecord_b4_f3(FILE *fid, PyArrayObject *P)
+int capec_WriteRecord_b4_i3(FILE *fid, PyArrayObject *P)
 {
-    if (is_le()) {
-        return capec_WriteRecord_bs4_f3(fid, P);
-    } else {
-        return capec_WriteRecord_ne4_f3(fid, P);
-    }
+    return capec_WriteRecord(fid, P, 3, capeREC_I4, is_le());
 }
 
-// Write little-endian, single-precision float record from 3D array
-int capec_WriteRecord_lb4_f3(FILE *fid, PyArrayObject *P)
+// Little-endian, single-precision integer records
+int capec_WriteRecord_lb4_i1(FILE *fid, PyArrayObject *P)
 {
-    if (is_le()) {
-        return capec_WriteRecord_ne4_f3(fid, P);
-    } else {
-        return capec_WriteRecord_bs4_f3(fid, P);
-    }
+    return capec_WriteRecord(fid, P, 1, capeREC_I4, !is_le());
 }
-
-
-// ======================================================================
-// 1D DOUBLE RECORDS
-// ======================================================================
-
-// Write native, single-precision float record from 1D array
-int capec_WriteRecord_ne8_f1(FILE *fid, PyArrayObject *P)
+int capec_WriteRecord_lb4_i2(FILE *fid, PyArrayObject *P)
 {
-    int i;
-    double v;
-    int n, nb;
-    
-    // Check dims
-    if (PyArray_NDIM(P) != 1) {
-        PyErr_SetString(PyExc_ValueError, "Object must be a 1-D array.");
-        return 2;
-    }
-    // Number of points
-    n = (int) PyArray_DIM(P, 0);
-    
-    // Number of bytes for record marker
-    nb = n * sizeof(double);
-    // Record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    
-    // Loop through elements
-    for (i=0; i<n; i++) {
-        // Get value
-        v = np1d(P,i);
-        fwrite(&v, sizeof(double), 1, fid);
-    }
-    // End-of-record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    // Success
-    return 0;
+    return capec_WriteRecord(fid, P, 2, capeREC_I4, !is_le());
 }
-
-// Write byte-swapped, single-precision float record from 1D array
-int capec_WriteRecord_bs8_f1(FILE *fid, PyArrayObject *P)
+int capec_WriteRecord_lb4_i3(FILE *fid, PyArrayObject *P)
 {
-    int i;
-    double v;
-    int n, nb;
-    
-    // Check dims
-    if (PyArray_NDIM(P) != 1) {
-        PyErr_SetString(PyExc_ValueError, "Object must be a 1-D array.");
-        return 2;
-    }
-    // Number of points
-    n = (int) PyArray_DIM(P, 0);
-    
-    // Number of bytes for record marker
-    nb = __bswap_32(n * sizeof(double));
-    // Record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    
-    // Loop through elements
-    for (i=0; i<n; i++) {
-        // Get value
-        v = np1d(P,i);
-        bs64(v);
-        fwrite(&v, sizeof(double), 1, fid);
-    }
-    // End-of-record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    // Success
-    return 0;
+    return capec_WriteRecord(fid, P, 3, capeREC_I4, !is_le());
 }
 
-// Write big-endian, single-precision float record from 1D array
-int capec_WriteRecord_b8_f1(FILE *fid, PyArrayObject *P)
+// Big-endian, single-precision float records
+int capec_WriteRecord_b4_f1(FILE *fid, PyArrayObject *P)
 {
-    if (is_le()) {
-        return capec_WriteRecord_bs8_f1(fid, P);
-    } else {
-        return capec_WriteRecord_ne8_f1(fid, P);
-    }
+    return capec_WriteRecord(fid, P, 1, capeREC_F4, is_le());
 }
-
-// Write little-endian, single-precision float record from 1D array
-int capec_WriteRecord_lb8_f1(FILE *fid, PyArrayObject *P)
+int capec_WriteRecord_b4_f2(FILE *fid, PyArrayObject *P)
 {
-    if (is_le()) {
-        return capec_WriteRecord_ne8_f1(fid, P);
-    } else {
-        return capec_WriteRecord_bs8_f1(fid, P);
-    }
+    return capec_WriteRecord(fid, P, 2, capeREC_F4, is_le());
 }
-
-
-// ======================================================================
-// 2D DOUBLE RECORDS
-// ======================================================================
-
-// Write native, double-precision float record from 2D array
-int capec_WriteRecord_ne8_f2(FILE *fid, PyArrayObject *P)
+int capec_WriteRecord_b4_f3(FILE *fid, PyArrayObject *P)
 {
-    int i, j;
-    double v;
-    int m, n, nb;
-    
-    // Check dims
-    if (PyArray_NDIM(P) != 2) {
-        PyErr_SetString(PyExc_ValueError, "Object must be a 2-D array.");
-        return 2;
-    }
-    // Number of points
-    m = (int) PyArray_DIM(P, 0);
-    n = (int) PyArray_DIM(P, 1);
-    
-    // Number of bytes for record marker
-    nb = m * n * sizeof(double);
-    // Record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    
-    // Loop through rows as outer loop
-    for (i=0; i<m; i++) {
-        // Loop through columns as inner loop
-        for (j=0; j<n; j++) {
-            // Get value
-            v = np2d(P,i,j);
-            fwrite(&v, sizeof(double), 1, fid);
-        }
-    }
-    // End-of-record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    // Success
-    return 0;
+    return capec_WriteRecord(fid, P, 3, capeREC_F4, is_le());
 }
 
-// Write byte-swapped, double-precision float record from 2D array
-int capec_WriteRecord_bs8_f2(FILE *fid, PyArrayObject *P)
+// Little-endian, single-precision float records
+int capec_WriteRecord_lb4_f1(FILE *fid, PyArrayObject *P)
 {
-    int i, j;
-    double v;
-    int m, n, nb;
-    
-    // Check dims
-    if (PyArray_NDIM(P) != 2) {
-        PyErr_SetString(PyExc_ValueError, "Object must be a 2-D array.");
-        return 2;
-    }
-    // Number of points
-    m = (int) PyArray_DIM(P, 0);
-    n = (int) PyArray_DIM(P, 1);
-    
-    // Number of bytes for record marker
-    nb = __bswap_32(m * n * sizeof(double));
-    // Record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    
-    // Loop through rows as outer loop
-    for (i=0; i<m; i++) {
-        // Loop through columns as inner loop
-        for (j=0; j<n; j++) {
-            // Get value
-            v = np2d(P,i,j);
-            bs64(v);
-            fwrite(&v, sizeof(double), 1, fid);
-        }
-    }
-    // End-of-record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    // Success
-    return 0;
+    return capec_WriteRecord(fid, P, 1, capeREC_F4, !is_le());
 }
-
-// Write big-endian, double-precision float record from 2D array
-int capec_WriteRecord_b8_f2(FILE *fid, PyArrayObject *P)
+int capec_WriteRecord_lb4_f2(FILE *fid, PyArrayObject *P)
 {
-    if (is_le()) {
-        return capec_WriteRecord_bs8_f2(fid, P);
-    } else {
-        return capec_WriteRecord_ne8_f2(fid, P);
-    }
+    return capec_WriteRecord(fid, P, 2, capeREC_F4, !is_le());
 }
-
-// Write little-endian, double-precision float record from 2D array
-int capec_WriteRecord_lb8_f2(FILE *fid, PyArrayObject *P)
+int capec_WriteRecord_lb4_f3(FILE *fid, PyArrayObject *P)
 {
-    if (is_le()) {
-        return capec_WriteRecord_ne8_f2(fid, P);
-    } else {
-        return capec_WriteRecord_bs8_f2(fid, P);
-    }
+    return capec_WriteRecord(fid, P, 3, capeREC_F4, !is_le());
 }
 
-
-// ======================================================================
-// 3D DOUBLE RECORDS
-// ======================================================================
-
-// Write native, single-precision float record from 3D array
-int capec_WriteRecord_ne8_f3(FILE *fid, PyArrayObject *P)
+// Big-endian, double-precision float records
+int capec_WriteRecord_b8_f1(FILE *fid, PyArrayObject *P)
 {
-    int j, k, l;
-    double v;
-    int nj, nk, nl, nb;
-    
-    // Check dims
-    if (PyArray_NDIM(P) != 3) {
-        PyErr_SetString(PyExc_ValueError, "Object must be a 3-D array.");
-        return 2;
-    }
-    // Number of points
-    nj = (int) PyArray_DIM(P, 0);
-    nk = (int) PyArray_DIM(P, 1);
-    nl = (int) PyArray_DIM(P, 2);
-    
-    // Number of bytes for record marker
-    nb = nj * nk * nl * sizeof(double);
-    // Record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    
-    // Loop through rows as outer loop
-    for (j=0; j<nj; j++) {
-        // Loop through columns as inner loop
-        for (k=0; k<nk; k++) {
-            // Loop through third dimension
-            for (l=0; l<nl; l++) {
-                // Get value
-                v = np3d(P,j,k,l);
-                fwrite(&v, sizeof(double), 1, fid);
-            }
-        }
-    }
-    // End-of-record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    // Success
-    return 0;
+    return capec_WriteRecord(fid, P, 1, capeREC_F8, is_le());
 }
-
-// Write byte-swapped, single-precision float record from 3D array
-int capec_WriteRecord_bs8_f3(FILE *fid, PyArrayObject *P)
+int capec_WriteRecord_b8_f2(FILE *fid, PyArrayObject *P)
 {
-    int j, k, l;
-    double v;
-    int nj, nk, nl, nb;
-    
-    // Check dims
-    if (PyArray_NDIM(P) != 3) {
-        PyErr_SetString(PyExc_ValueError, "Object must be a 3-D array.");
-        return 2;
-    }
-    // Number of points
-    nj = (int) PyArray_DIM(P, 0);
-    nk = (int) PyArray_DIM(P, 1);
-    nl = (int) PyArray_DIM(P, 2);
-    
-    // Number of bytes for record marker
-    nb = __bswap_32(nj*nk*nl * sizeof(double));
-    // Record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    
-    // Loop through rows as outer loop
-    for (j=0; j<nj; j++) {
-        // Loop through columns as inner loop
-        for (k=0; k<nk; k++) {
-            // Loop through third dimension
-            for (l=0; l<nl; l++) {
-                // Get value
-                v = np3d(P,j,k,l); bs64(v);
-                fwrite(&v, sizeof(double), 1, fid);
-            }
-        }
-    }
-    // End-of-record marker
-    fwrite(&nb, sizeof(int), 1, fid);
-    // Success
-    return 0;
+    return capec_WriteRecord(fid, P, 2, capeREC_F8, is_le());
 }
-
-// Write big-endian, single-precision float record from 3D array
 int capec_WriteRecord_b8_f3(FILE *fid, PyArrayObject *P)
 {
-    if (is_le()) {
-        return capec_WriteRecord_bs4_f3(fid, P);
-    } else {
-        return capec_WriteRecord_ne4_f3(fid, P);
-    }
+    return capec_WriteRecord(fid, P, 3, capeREC_F8, is_le());
 }
 
-// Write little-endian, single-precision float record from 3D array
+// Little-endian, double-precision float records
+int capec_WriteRecord_lb8_f1(FILE *fid, PyArrayObject *P)
+{
+    return capec_WriteRecord(fid, P, 1, capeREC_F8, !is_le());
+}
+int capec_WriteRecord_lb8_f2(FILE *fid, PyArrayObject *P)
+{
+    return capec_WriteRecord(fid, P, 2, capeREC_F8, !is_le());
+}
 int capec_WriteRecord_lb8_f3(FILE *fid, PyArrayObject *P)
 {
-    if (is_le()) {
-        return capec_WriteRecord_ne4_f3(fid, P);
-    } else {
-        return capec_WriteRecord_bs4_f3(fid, P);
-    }
+    return capec_WriteRecord(fid, P, 3, capeREC_F8, !is_le());
 }
-
-    
@@ -0,0 +1,82 @@
+# Standard library
+import contextlib
+
+# Third-party
+import numpy as np
+import pytest
+import testutils
+
+# Local imports
+from cape import pltfile as pltfile
+
+
+# Compiled reader and writer
+pytestmark = pytest.mark.skipif(
+    pltfile._cape is None, reason="compiled module not available")
+
+# Name of file written by compiled writer
+PLTFILE = "two.plt"
+
+
+# One tri zone stored in doubles, one quad zone stored in floats
+def make_plt():
+    p0 = pltfile.Plt()
+    p0.title = "two zones"
+    p0.Vars = ["x", "y", "z", "cp"]
+    p0.nVar = 4
+    p0.nZone = 2
+    p0.Zones = ["wing", "tail"]
+    p0.ZoneType = [pltfile.FETRIANGLE, pltfile.FEQUADRILATERAL]
+    p0.fmt = np.array([[2, 2, 2, 2], [1, 1, 1, 1]])
+    p0.q = [
+        np.arange(16, dtype="float").reshape((4, 4)) / 3.0,
+        np.arange(20, dtype="float").reshape((5, 4)) - 5.5,
+    ]
+    p0.Tris = [
+        np.array([[0, 1, 2], [0, 2, 3]], dtype="int32"),
+        np.array([[0, 1, 2, 3], [1, 4, 2, 2]], dtype="int32"),
+    ]
+    return p0
+
+
+# Read with Python reader
+@contextlib.contextmanager
+def python_reader():
+    mod = pltfile._cape
+    pltfile._cape = None
+    try:
+        yield
+    finally:
+        pltfile._cape = mod
+
+
+# Write two zones and read them back
+@testutils.run_sandbox(__file__)
+def test_pltbin01():
+    p0 = make_plt()
+    p0.Write(PLTFILE)
+    p1 = pltfile.Plt(PLTFILE)
+    assert p1.Vars == p0.Vars
+    assert p1.Zones == p0.Zones
+    assert np.all(p1.nPt == [4, 5])
+    assert np.all(p1.nElem == [2, 2])
+    assert p1.q[0].dtype == np.float64
+    assert np.all(p1.q[0] == p0.q[0])
+    assert np.all(p1.q[1] == p0.q[1])
+    assert np.all(p1.Tris[1] == p0.Tris[1])
+    # Min/max computed by writer
+    assert np.all(p1.qmin[1] == p0.q[1].min(axis=0))
+    assert np.all(p1.qmax[0] == p0.q[0].max(axis=0))
+
+
+# Subset of variables and zones, read by Python reader
+@testutils.run_sandbox(__file__)
+def test_pltbin02():
+    p0 = make_plt()
+    p0.Write(PLTFILE)
+    p1 = pltfile.Plt(PLTFILE)
+    p1.Write("cp.plt", Vars=["x", "cp"], CompID=[1])
+    with python_reader():
+        p2 = pltfile.Plt("cp.plt")
+    assert p2.Zones == ["tail"]
+    assert np.allclose(p2.q[0], p0.q[1][:, [0, 3]])
@@ -2,6 +2,7 @@
 
 # Third-party
 import numpy as np
+import pytest
 import testutils
 
 # Local imports
@@ -88,3 +89,31 @@ def test_03_readplt():
     ]
 
 
+
+
+# Compare compiled and Python UH3D readers and writers
+@testutils.run_sandbox(__file__, SOURCE)
+def test_04_fast():
+    # Check for compiled module
+    if trifile._cape is None:
+        pytest.skip("compiled module not available")
+    # Read each way
+    tri1 = trifile.Tri()
+    tri1.ReadUH3DFast(SOURCE)
+    tri2 = trifile.Tri()
+    tri2.ReadUH3DSlow(SOURCE)
+    # Compare
+    assert tri1.nNode == tri2.nNode
+    assert tri1.nTri == tri2.nTri
+    assert np.all(tri1.Nodes == tri2.Nodes)
+    assert np.all(tri1.Tris == tri2.Tris)
+    assert np.all(tri1.CompID == tri2.CompID)
+    assert tri1.Conf == tri2.Conf
+    # Write each way
+    lbls = {v: k for k, v in tri2.Conf.items()}
+    tri1.WriteUH3DFast("fast.uh3d", lbls)
+    tri2.WriteUH3DSlow("slow.uh3d", lbls)
+    with open("fast.uh3d") as fp:
+        txt1 = fp.read()
+    with open("slow.uh3d") as fp:
+        assert fp.read() == txt1
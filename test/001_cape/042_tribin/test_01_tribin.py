@@ -0,0 +1,103 @@
+# -*- coding: utf-8 -*-
+
+# Standard library
+import sys
+
+# Third-party
+import numpy as np
+import pytest
+import testutils
+
+# Local imports
+import cape.trifile as trifile
+
+
+# Fast reader is in compiled module
+pytestmark = pytest.mark.skipif(
+    trifile._cape is None, reason="compiled module not available")
+
+# Binary formats to test
+FORMATS = ("b4", "lb4", "b8", "lb8", "r4", "lr4", "r8", "lr8")
+
+
+# Create a small triangulation
+def make_tri():
+    # Nodes on a grid
+    x, y = np.meshgrid(np.arange(5.0), np.arange(4.0))
+    nodes = np.vstack((x.ravel(), 0.5*y.ravel(), np.zeros(x.size))).T
+    # Two tris per cell
+    tris = []
+    for j in range(3):
+        for i in range(4):
+            n = 5*j + i + 1
+            tris.append([n, n + 1, n + 6])
+            tris.append([n, n + 6, n + 5])
+    tris = np.array(tris)
+    # Component IDs
+    compid = np.arange(tris.shape[0]) // 8 + 1
+    # Output
+    return trifile.Tri(Nodes=nodes, Tris=tris, CompID=compid)
+
+
+# Read each format using compiled and Python readers
+@testutils.run_sandbox(__file__)
+def test_01_readbin():
+    # Create source triangulation
+    tri = make_tri()
+    # Loop through formats
+    for fmt in FORMATS:
+        # Write it using Python
+        fname = "grid.%s.tri" % fmt
+        getattr(tri, "WriteSlow_%s" % fmt)(fname)
+        # Read using C
+        tri1 = trifile.Tri()
+        tri1.ReadTriBinFast(fname)
+        # Read using Python
+        tri2 = trifile.Tri()
+        tri2.GetTriFileType(fname)
+        tri2.ReadTriBinSlow(fname)
+        # Compare
+        assert tri1.nNode == tri.nNode
+        assert tri1.nTri == tri.nTri
+        assert np.allclose(tri1.Nodes, tri2.Nodes)
+        assert np.all(tri1.Tris == tri2.Tris)
+        assert np.all(tri1.CompID == tri.CompID)
+
+
+# Read truncated file
+@testutils.run_sandbox(__file__)
+def test_02_truncated():
+    # Write a valid file
+    tri = make_tri()
+    tri.WriteSlow_lb8("grid.tri")
+    # Chop off the end of the tris record
+    with open("grid.tri", "rb") as fp:
+        data = fp.read()
+    with open("trunc.tri", "wb") as fp:
+        fp.write(data[:-(4*tri.nTri + 16)])
+    # Read it
+    with pytest.raises(ValueError):
+        trifile._cape.ReadTri("trunc.tri")
+
+
+# Write a triangulation back to the file it was read from
+@testutils.run_sandbox(__file__)
+def test_03_rewrite():
+    # Write a file in native byte order
+    fmt = "lb4" if sys.byteorder == "little" else "b4"
+    tri = make_tri()
+    tri.Write("grid.tri", fmt=fmt)
+    # Read it back; arrays are copies by default
+    tri1 = trifile.Tri()
+    tri1.ReadTriBinFast("grid.tri")
+    assert tri1.Tris.base is None
+    # Overwrite the file with the arrays just read
+    tri1.Write("grid.tri", fmt=fmt)
+    tri2 = trifile.Tri("grid.tri")
+    assert np.all(tri2.Tris == tri.Tris)
+    assert np.all(tri2.CompID == tri.CompID)
+    # Views into the mapping only if requested
+    tri3 = trifile.Tri()
+    tri3.ReadTriBinFast("grid.tri", view=True)
+    assert tri3.Tris.base is not None
+    assert np.all(tri3.Tris == tri.Tris)
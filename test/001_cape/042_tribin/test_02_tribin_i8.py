@@ -0,0 +1,89 @@
+# -*- coding: utf-8 -*-
+
+# Third-party
+import numpy as np
+import pytest
+import testutils
+
+# Local imports
+import cape.trifile as trifile
+
+
+# Files with 8-byte ints are read by compiled module
+pytestmark = pytest.mark.skipif(
+    trifile._cape is None, reason="compiled module not available")
+
+# Binary formats to test
+FORMATS = ("b4", "lb4", "b8", "lb8", "r4", "lr4", "r8", "lr8")
+
+# Corners of unit cube and its faces, one component each
+CUBE_NODES = [
+    [0, 0, 0], [1, 0, 0], [1, 1, 0], [0, 1, 0],
+    [0, 0, 1], [1, 0, 1], [1, 1, 1], [0, 1, 1]]
+CUBE_FACES = [
+    [1, 4, 3, 2], [5, 6, 7, 8], [1, 2, 6, 5],
+    [2, 3, 7, 6], [3, 4, 8, 7], [4, 1, 5, 8]]
+
+
+# Surface of unit cube with two states at each node
+def make_cube():
+    nodes = np.array(CUBE_NODES, dtype="f8")
+    tris = np.array([
+        tri for a, b, c, d in CUBE_FACES for tri in ([a, b, c], [a, c, d])])
+    compid = np.repeat(np.arange(1, 7), 2)
+    tri = trifile.Tri(Nodes=nodes, Tris=tris, CompID=compid)
+    tri.q = np.arange(16.0).reshape((8, 2)) / 4.0
+    tri.nq = 2
+    return tri
+
+
+# Write files with 8-byte ints and read them back
+@testutils.run_sandbox(__file__)
+def test_01_records():
+    tri = make_cube()
+    for fmt in FORMATS:
+        fname = "cube.%s.tri" % fmt
+        tri.Write(fname, fmt=fmt, i8=True)
+        # Header record holds two 8-byte ints
+        with open(fname, "rb") as fp:
+            r = np.fromfile(fp, count=1, dtype="i4")[0]
+        assert r in (16, 16 << 24)
+        # Read using C
+        tri1 = trifile.Tri()
+        tri1.ReadTriBinFast(fname)
+        assert tri1.Tris.dtype.itemsize == 8
+        assert np.all(tri1.Tris == tri.Tris)
+        assert np.all(tri1.CompID == tri.CompID)
+        assert np.all(tri1.Nodes == tri.Nodes)
+        # Write it again with 4-byte ints
+        tri1.Write("a.tri", fmt=fmt)
+        tri.Write("b.tri", fmt=fmt)
+        with open("a.tri", "rb") as fp:
+            data1 = fp.read()
+        with open("b.tri", "rb") as fp:
+            data2 = fp.read()
+        assert data1 == data2, fmt
+
+
+# Triq with records
+@testutils.run_sandbox(__file__)
+def test_02_triq():
+    tri = make_cube()
+    tri.WriteTriI8("cube.i8.triq", "lb8", q=True)
+    tri1 = trifile.Tri()
+    tri1.ReadTriBinFast("cube.i8.triq")
+    assert tri1.nq == 2
+    assert tri1.Tris.dtype.itemsize == 8
+    assert np.all(tri1.q == tri.q)
+
+
+# Fortran stream file
+@testutils.run_sandbox(__file__)
+def test_03_stream():
+    tri = make_cube()
+    tri.WriteTriStream("cube.i8.stream", "big", 8, 8)
+    tri1 = trifile.Tri()
+    tri1.ReadTriStream("cube.i8.stream")
+    assert tri1.Tris.dtype.itemsize == 8
+    assert np.all(tri1.Tris == tri.Tris)
+    assert np.all(tri1.q == tri.q)
@@ -0,0 +1,57 @@
+# -*- coding: utf-8 -*-
+
+# Third-party
+import numpy as np
+import pytest
+import testutils
+
+# Local imports
+import cape.trifile as trifile
+
+
+# Codecs are in compiled module
+pytestmark = pytest.mark.skipif(
+    trifile._cape is None, reason="compiled module not available")
+
+# Extension for each codec
+EXTS = {"gzip": ".gz", "zstd": ".zst"}
+
+
+# Repetitive grid with states, which compresses well
+def make_triq(nx=30, ny=20):
+    x, y = np.meshgrid(np.arange(nx + 1.0), np.arange(ny + 1.0))
+    nodes = np.vstack((x.ravel(), y.ravel(), np.zeros(x.size))).T
+    # Lower-left node of each cell
+    n = (np.arange(ny)[:, None]*(nx + 1) + np.arange(nx) + 1).ravel()
+    tris = np.vstack((
+        np.array([n, n + 1, n + nx + 2]).T,
+        np.array([n, n + nx + 2, n + nx + 1]).T))
+    compid = np.tile(np.repeat(np.arange(1, ny + 1), nx), 2)
+    tri = trifile.Tri(Nodes=nodes, Tris=tris, CompID=compid)
+    tri.q = np.vstack((0.1*x.ravel(), np.ones(x.size))).T
+    tri.nq = 2
+    return tri
+
+
+# Write and read compressed files with each codec in this build
+@testutils.run_sandbox(__file__)
+def test_01_zip():
+    tri = make_triq()
+    # Uncompressed reference
+    tri.WriteTriq("grid.triq", fmt="lb4")
+    with open("grid.triq", "rb") as fp:
+        data1 = fp.read()
+    # Loop through codecs
+    for codec in trifile._cape.ZipCodecs():
+        fname = "grid.triq" + EXTS[codec]
+        tri.WriteTriq(fname, fmt="lb4")
+        with open(fname, "rb") as fp:
+            assert fp.read() != data1
+        # Read it back
+        tri1 = trifile.Tri()
+        tri1.Read(fname)
+        assert tri1.nNode == tri.nNode
+        assert tri1.nTri == tri.nTri
+        assert np.all(tri1.Tris == tri.Tris)
+        assert np.all(tri1.CompID == tri.CompID)
+        assert np.max(np.abs(tri1.q - tri.q)) < 1e-6
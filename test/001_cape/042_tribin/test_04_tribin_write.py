@@ -0,0 +1,70 @@
+# -*- coding: utf-8 -*-
+
+# Third-party
+import numpy as np
+import pytest
+import testutils
+
+# Local imports
+import cape.trifile as trifile
+
+
+# Fast writers are in compiled module
+pytestmark = pytest.mark.skipif(
+    trifile._cape is None, reason="compiled module not available")
+
+# Binary formats to test
+FORMATS = ("b4", "lb4", "b8", "lb8", "r4", "lr4", "r8", "lr8")
+
+
+# Open 3x2 grid with noninteger nodes; one component per row
+def make_grid():
+    x, y = np.meshgrid(0.25*np.arange(4.0), 1.0/3.0*np.arange(3.0))
+    nodes = np.vstack((x.ravel(), y.ravel(), x.ravel()*y.ravel())).T
+    # Lower-left node of each cell, then two tris per cell
+    n = (np.arange(2)[:, None]*4 + np.arange(3) + 1).ravel()
+    tris = np.stack((
+        np.array([n, n + 1, n + 5]).T,
+        np.array([n, n + 5, n + 4]).T), axis=1).reshape((-1, 3))
+    compid = np.repeat([1, 2], 6)
+    return trifile.Tri(Nodes=nodes, Tris=tris, CompID=compid)
+
+
+# Compiled and Python record writers give the same file
+@testutils.run_sandbox(__file__)
+def test_01_writefast():
+    tri = make_grid()
+    for fmt in FORMATS:
+        # Write using both versions
+        getattr(tri, "WriteFast_%s" % fmt)("fast.tri")
+        getattr(tri, "WriteSlow_%s" % fmt)("slow.tri")
+        # Compare bytes
+        with open("fast.tri", "rb") as fp:
+            data1 = fp.read()
+        with open("slow.tri", "rb") as fp:
+            data2 = fp.read()
+        assert data1 == data2, fmt
+
+
+# Write and read Fortran stream files
+@testutils.run_sandbox(__file__)
+def test_02_stream():
+    tri = make_grid()
+    # Loop through byte orders and precisions
+    for bo in ("big", "little"):
+        for nb in (4, 8):
+            # Write using both versions
+            tri.WriteStreamFast("fast.tri", bo, nb)
+            tri.WriteStreamSlow("slow.tri", bo, nb)
+            # Compare bytes
+            with open("fast.tri", "rb") as fp:
+                data1 = fp.read()
+            with open("slow.tri", "rb") as fp:
+                data2 = fp.read()
+            assert data1 == data2, (bo, nb)
+            # Read it back
+            tri1 = trifile.Tri()
+            tri1.ReadTriStream("fast.tri")
+            assert np.allclose(tri1.Nodes, tri.Nodes)
+            assert np.all(tri1.Tris == tri.Tris)
+            assert np.all(tri1.CompID == tri.CompID)
@@ -0,0 +1,61 @@
+# -*- coding: utf-8 -*-
+
+# Third-party
+import numpy as np
+import pytest
+import testutils
+
+# Local imports
+import cape.trifile as trifile
+
+
+# Writers are compiled functions
+pytestmark = pytest.mark.skipif(
+    trifile._cape is None, reason="compiled module not available")
+
+# Surface of a tetrahedron
+NODES = np.array([
+    [0.0, 0.0, 0.0],
+    [1.0, 0.0, 0.0],
+    [0.0, 1.0, 0.0],
+    [0.0, 0.0, 1.0]])
+TRIS = np.array([[1, 3, 2], [1, 2, 4], [2, 3, 4], [1, 4, 3]], dtype="i4")
+COMPID = np.array([1, 1, 2, 3], dtype="i4")
+
+
+# Write the reference file by name
+def write_ref(fname="ref.tri"):
+    trifile._cape.WriteTri_lb8(NODES, TRIS, COMPID, fname)
+    with open(fname, "rb") as fp:
+        return fp.read()
+
+
+# Write to an open file after some other content
+@testutils.run_sandbox(__file__)
+def test_01_file():
+    data = write_ref()
+    with open("file.tri", "wb") as fp:
+        fp.write(b"abc")
+        trifile._cape.WriteTri_lb8(NODES, TRIS, COMPID, fp)
+        fp.write(b"xyz")
+    with open("file.tri", "rb") as fp:
+        assert fp.read() == b"abc" + data + b"xyz"
+
+
+# Write to in-memory buffers
+@testutils.run_sandbox(__file__)
+def test_02_buffers():
+    data = write_ref()
+    # Append to bytearray
+    buf = bytearray(b"abc")
+    trifile._cape.WriteTri_lb8(NODES, TRIS, COMPID, buf)
+    assert bytes(buf) == b"abc" + data
+    # Fill fixed-size buffer
+    buf = bytearray(len(data) + 10)
+    n = trifile._cape.WriteTri_lb8(NODES, TRIS, COMPID, memoryview(buf))
+    assert n == len(data)
+    assert bytes(buf[:n]) == data
+    # Buffer too small
+    with pytest.raises(ValueError):
+        trifile._cape.WriteTri_lb8(
+            NODES, TRIS, COMPID, memoryview(bytearray(10)))
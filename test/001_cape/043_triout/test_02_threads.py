@@ -0,0 +1,61 @@
+# -*- coding: utf-8 -*-
+
+# Standard library
+from concurrent.futures import ThreadPoolExecutor
+
+# Third-party
+import numpy as np
+import pytest
+
+# Local imports
+import cape.trifile as trifile
+
+
+# Writers release the GIL only in compiled module
+pytestmark = pytest.mark.skipif(
+    trifile._cape is None, reason="compiled module not available")
+
+# Cells in each direction
+NX = 60
+NY = 40
+
+
+# Grid large enough to keep several writers busy; int64 tris
+def make_grid(nx, ny):
+    x, y = np.meshgrid(np.arange(nx + 1.0), np.arange(ny + 1.0))
+    nodes = np.vstack((x.ravel(), y.ravel(), np.zeros(x.size))).T
+    # Lower-left node of each cell
+    n = (np.arange(ny)[:, None]*(nx + 1) + np.arange(nx) + 1).ravel()
+    tris = np.vstack((
+        np.array([n, n + 1, n + nx + 2]).T,
+        np.array([n, n + nx + 2, n + nx + 1]).T))
+    compid = np.arange(tris.shape[0], dtype="i4") % 7 + 1
+    return nodes, tris.astype("i8"), compid
+
+
+# Write several buffers at once from different threads
+def test_01_threads():
+    args = make_grid(NX, NY)
+    # Reference outputs from one thread
+    ref_a = bytearray()
+    ref_b = bytearray()
+    trifile._cape.WriteTri(*args, ref_a)
+    trifile._cape.WriteTri_lr4(*args, ref_b)
+    # ASCII output must have correct node numbers
+    nnode = (NX + 1)*(NY + 1)
+    lines = ref_a.split(b"\n")
+    assert lines[0].split() == [b"%i" % nnode, b"%i" % (2*NX*NY)]
+    assert lines[nnode + 1].split() == [b"1", b"2", b"%i" % (NX + 2)]
+
+    # Writer for one job
+    def write(i):
+        buf = bytearray()
+        if i % 2:
+            trifile._cape.WriteTri(*args, buf)
+            return buf == ref_a
+        else:
+            trifile._cape.WriteTri_lr4(*args, buf)
+            return buf == ref_b
+    # Run them concurrently
+    with ThreadPoolExecutor(4) as pool:
+        assert all(pool.map(write, range(16)))
@@ -0,0 +1,104 @@
+# -*- coding: utf-8 -*-
+
+# Third-party
+import numpy as np
+import pytest
+import testutils
+
+# Local imports
+import cape.trifile as trifile
+
+
+# Writers read arrays of any layout only in compiled module
+pytestmark = pytest.mark.skipif(
+    trifile._cape is None, reason="compiled module not available")
+
+# Binary formats to test
+FORMATS = ("b4", "lb4", "b8", "lb8", "r4", "lr4", "r8", "lr8")
+# Writers to compare
+WRITERS = ["WriteFast", "WriteTriqFast", "WriteSTLBin"] + [
+    "WriteFast_%s" % fmt for fmt in FORMATS]
+
+# Surface of a tetrahedron, float64 nodes and int32 tris
+NODES = np.array([
+    [0.0, 0.0, 0.0],
+    [1.0, 0.0, 0.0],
+    [0.0, 1.0, 0.0],
+    [0.0, 0.0, 1.0]])
+TRIS = np.array([[1, 3, 2], [1, 2, 4], [2, 3, 4], [1, 4, 3]], dtype="i4")
+COMPID = np.array([1, 2, 2, 3], dtype="i4")
+
+
+# Create triangulation from arrays, which are not copied
+def make_triq(nodes, tris, compid, q):
+    tri = trifile.Tri(Nodes=nodes, Tris=tris, CompID=compid)
+    tri.q = q
+    tri.nq = q.shape[1]
+    return tri
+
+
+# Check that two triangulations give the same files from each writer
+def compare_writers(tri, tri1):
+    for w in WRITERS:
+        getattr(tri, w)("a.dat")
+        getattr(tri1, w)("b.dat")
+        with open("a.dat", "rb") as fp:
+            data1 = fp.read()
+        with open("b.dat", "rb") as fp:
+            data2 = fp.read()
+        assert data1 == data2, w
+
+
+# Fortran float32 nodes, strided int64 tris, and strided states
+@testutils.run_sandbox(__file__)
+def test_01_types():
+    q = np.arange(20.0).reshape((4, 5))
+    tri = make_triq(NODES, TRIS, COMPID, q)
+    # Same values, other types and layouts
+    tri1 = make_triq(
+        np.asfortranarray(NODES, dtype="f4"),
+        np.repeat(TRIS, 2, axis=1).astype("i8")[:, ::2],
+        COMPID.astype("i8"),
+        np.hstack((q, q))[:, :5])
+    assert not tri1.Tris.flags.contiguous
+    assert not tri1.q.flags.contiguous
+    compare_writers(tri, tri1)
+
+
+# Strided 1-D component IDs and one column of a wider state array
+@testutils.run_sandbox(__file__)
+def test_02_strided():
+    q = np.arange(4.0).reshape((4, 1))
+    tri = make_triq(NODES, TRIS, COMPID, q)
+    # Forward and backward, int32 and int64
+    compids = (
+        np.repeat(COMPID, 2)[::2],
+        COMPID[::-1].copy()[::-1],
+        np.repeat(COMPID, 2).astype("i8")[::2],
+    )
+    for compid in compids:
+        assert not compid.flags.contiguous
+        tri1 = make_triq(NODES, TRIS, compid, np.hstack((q, -q))[:, :1])
+        assert not tri1.q.flags.contiguous
+        compare_writers(tri, tri1)
+
+
+# Component IDs too large for 4-byte records
+@testutils.run_sandbox(__file__)
+def test_03_range():
+    compid = COMPID.astype("i8")
+    compid[2] = 2**31
+    tri = make_triq(NODES, TRIS, compid, np.zeros((4, 1)))
+    # Every binary writer reports it instead of wrapping around
+    for fmt in FORMATS:
+        with pytest.raises(ValueError):
+            getattr(tri, "WriteFast_%s" % fmt)("a.tri")
+    # Negative IDs, from strided tris
+    tri.CompID = COMPID
+    tri.Tris = np.repeat(TRIS, 2, axis=1).astype("i8")[:, ::2]
+    tri.Tris[0, 0] = -2**31 - 1
+    with pytest.raises(ValueError):
+        tri.WriteFast_lb4("a.tri")
+    # Fine with 8-byte ints
+    tri.Tris[0, 0] = 2**40
+    tri.Write("a.tri", fmt="lb8", i8=True)
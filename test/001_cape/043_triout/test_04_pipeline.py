@@ -0,0 +1,63 @@
+# -*- coding: utf-8 -*-
+
+# Third-party
+import numpy as np
+import pytest
+import testutils
+
+# Local imports
+import cape.trifile as trifile
+
+
+# Background writes are only in compiled module
+pytestmark = pytest.mark.skipif(
+    trifile._cape is None, reason="compiled module not available")
+
+# Reference file
+TRIQFILE = "ref.triq"
+
+
+# Grid with states, large enough for many pipeline buffers
+def make_triq(nx=20, ny=10):
+    x, y = np.meshgrid(np.arange(nx + 1.0), np.arange(ny + 1.0))
+    nodes = np.vstack((x.ravel(), y.ravel(), np.zeros(x.size))).T
+    # Lower-left node of each cell
+    n = (np.arange(ny)[:, None]*(nx + 1) + np.arange(nx) + 1).ravel()
+    tris = np.vstack((
+        np.array([n, n + 1, n + nx + 2]).T,
+        np.array([n, n + nx + 2, n + nx + 1]).T))
+    tri = trifile.Tri(
+        Nodes=nodes, Tris=tris, CompID=np.ones(len(tris), "i4"))
+    tri.q = np.vstack((x.ravel(), -y.ravel())).T
+    tri.nq = 2
+    # Write reference file in the foreground
+    tri.WriteTriqFast(TRIQFILE)
+    with open(TRIQFILE, "rb") as fp:
+        return tri, fp.read()
+
+
+# Background write
+@testutils.run_sandbox(__file__)
+def test_01_async():
+    tri, data = make_triq()
+    h = tri.WriteTriqAsync("b.triq")
+    trifile._cape.WriteWait(h)
+    with open("b.triq", "rb") as fp:
+        assert fp.read() == data
+
+
+# Pipelined writes with tiny buffers
+@testutils.run_sandbox(__file__)
+def test_02_pipeline():
+    tri, data = make_triq()
+    try:
+        for sync in (None, "fsync", "dontneed"):
+            trifile._cape.SetWritePipeline(3, 7, sync)
+            tri.WriteTriqFast("c.triq")
+            h = tri.WriteTriqAsync("d.triq")
+            trifile._cape.WriteWait(h)
+            for fname in ("c.triq", "d.triq"):
+                with open(fname, "rb") as fp:
+                    assert fp.read() == data, (fname, sync)
+    finally:
+        trifile._cape.SetWritePipeline()
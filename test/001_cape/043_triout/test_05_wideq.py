@@ -0,0 +1,34 @@
+# -*- coding: utf-8 -*-
+
+# Third-party
+import numpy as np
+import pytest
+import testutils
+
+# Local imports
+import cape.trifile as trifile
+
+
+# Block-formatting ASCII writer is in compiled module
+pytestmark = pytest.mark.skipif(
+    trifile._cape is None, reason="compiled module not available")
+
+# Single tri
+NODES = np.array([[0.0, 0.0, 0.0], [1.0, 0.0, 0.0], [0.0, 1.0, 0.0]])
+TRIS = np.array([[1, 2, 3]], dtype="i4")
+COMPID = np.array([1], dtype="i4")
+
+
+# Write ASCII TRIQ file with rows wider than the output buffer
+@testutils.run_sandbox(__file__)
+def test_01_wideq():
+    # Many large states at each node
+    nq = 5000
+    q = np.linspace(-1e30, 1e30, 3*nq).reshape((3, nq))
+    trifile._cape.WriteTriQ(NODES, TRIS, COMPID, q, "wide.triq")
+    # Read it back
+    tri = trifile.Tri()
+    tri.ReadASCII("wide.triq")
+    assert tri.nNode == 3
+    assert tri.nq == nq
+    assert np.allclose(tri.q, q, rtol=1e-12, atol=1e-6)
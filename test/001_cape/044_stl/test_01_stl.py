@@ -0,0 +1,70 @@
+# -*- coding: utf-8 -*-
+
+# Third-party
+import numpy as np
+import pytest
+import testutils
+
+# Local imports
+import cape.trifile as trifile
+
+
+# Compiled writers are compared to Python writers
+pytestmark = pytest.mark.skipif(
+    trifile._cape is None, reason="compiled module not available")
+
+
+# Closed tetrahedron, so no two facets share a normal
+def make_tet():
+    nodes = np.array([
+        [0.0, 0.0, 0.0],
+        [2.0, 0.0, 0.0],
+        [0.0, 1.0, 0.0],
+        [0.3, 0.4, 1.5]])
+    tris = np.array([[1, 3, 2], [1, 2, 4], [2, 3, 4], [1, 4, 3]])
+    return trifile.Tri(Nodes=nodes, Tris=tris, CompID=np.ones(4, "i4"))
+
+
+# Read facets of binary STL file
+def read_facets(fname):
+    with open(fname, "rb") as fp:
+        data = fp.read()
+    v = np.frombuffer(data[84:], "u1").reshape(-1, 50)[:, :48]
+    return data[:84], v.copy().view("<f4")
+
+
+# Binary STL with normals computed in C
+@testutils.run_sandbox(__file__)
+def test_01_binary():
+    tri = make_tet()
+    tri.WriteSTLFast("fast.stl", binary=True)
+    # Python version, using normals from numpy
+    tri.WriteSTLSlow("slow.stl", binary=True)
+    hdr1, f1 = read_facets("fast.stl")
+    hdr2, f2 = read_facets("slow.stl")
+    # Header, count, and one row per facet
+    assert hdr1 == hdr2
+    assert f1.shape == (tri.nTri, 12)
+    assert np.allclose(f1, f2, atol=1e-6)
+    # Outward unit normal of slanted facet
+    n = np.cross(
+        tri.Nodes[2] - tri.Nodes[1], tri.Nodes[3] - tri.Nodes[1])
+    assert np.allclose(f1[2, :3], n / np.sqrt(np.sum(n*n)), atol=1e-6)
+    # Last vertex of last facet
+    assert np.allclose(f1[-1, 9:], tri.Nodes[tri.Tris[-1, 2] - 1])
+
+
+# ASCII STL using the same normals
+@testutils.run_sandbox(__file__)
+def test_02_ascii():
+    tri = make_tet()
+    tri.GetNormals()
+    tri.WriteSTLFast("fast.stl")
+    tri.WriteSTLSlow("slow.stl")
+    with open("fast.stl") as fp:
+        txt1 = fp.read()
+    with open("slow.stl") as fp:
+        txt2 = fp.read()
+    assert txt1 == txt2
+    assert txt1.count("endfacet") == tri.nTri
+    assert txt1.endswith("endsolid\n")
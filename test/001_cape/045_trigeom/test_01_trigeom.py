@@ -0,0 +1,80 @@
+# -*- coding: utf-8 -*-
+
+# Third-party
+import numpy as np
+import pytest
+
+# Local imports
+import cape.trifile as trifile
+
+
+# Compiled kernels are compared to NumPy
+pytestmark = pytest.mark.skipif(
+    trifile._cape is None, reason="compiled module not available")
+
+
+# Curved surface z = sin(x)*y with one component per row of cells
+def make_bump(nx=6, ny=4):
+    x, y = np.meshgrid(np.linspace(0, 3, nx + 1), np.linspace(0, 2, ny + 1))
+    nodes = np.vstack((x.ravel(), y.ravel(), np.sin(x.ravel())*y.ravel())).T
+    # Lower-left node of each cell
+    n = (np.arange(ny)[:, None]*(nx + 1) + np.arange(nx) + 1).ravel()
+    tris = np.vstack((
+        np.array([n, n + 1, n + nx + 2]).T,
+        np.array([n, n + nx + 2, n + nx + 1]).T))
+    compid = np.tile(np.repeat(np.arange(1, ny + 1), nx), 2)
+    return trifile.Tri(Nodes=nodes, Tris=tris, CompID=compid)
+
+
+# Centers, normals, areas, and edge lengths of each tri
+def test_01_geom():
+    tri = make_bump()
+    # Nodes of each tri
+    x0 = tri.Nodes[tri.Tris[:, 0] - 1]
+    x1 = tri.Nodes[tri.Tris[:, 1] - 1]
+    x2 = tri.Nodes[tri.Tris[:, 2] - 1]
+    # Expected geometry
+    n = np.cross(x1 - x0, x2 - x0)
+    a = np.sqrt(np.sum(n*n, axis=1))
+    # Compiled versions
+    X, N, A, AV, L = trifile._cape.TriGeom(tri.Nodes, tri.Tris)
+    assert np.allclose(X, (x0 + x1 + x2) / 3)
+    assert np.allclose(N, n / a[:, None])
+    assert np.allclose(A, 0.5*a)
+    assert np.allclose(AV, 0.5*n)
+    assert np.allclose(L[:, 1], np.sqrt(np.sum((x2 - x1)**2, axis=1)))
+    # Bad node index
+    tris = tri.Tris.copy()
+    tris[0, 0] = tri.nNode + 1
+    with pytest.raises(ValueError):
+        trifile._cape.TriGeom(tri.Nodes, tris)
+
+
+# Area-weighted node normals
+def test_02_nodenormals():
+    tri = make_bump()
+    # Sum of area vectors of tris using each node
+    x0 = tri.Nodes[tri.Tris[:, 0] - 1]
+    n = np.cross(
+        tri.Nodes[tri.Tris[:, 1] - 1] - x0,
+        tri.Nodes[tri.Tris[:, 2] - 1] - x0)
+    NN = np.zeros_like(tri.Nodes)
+    for j in range(3):
+        np.add.at(NN, tri.Tris[:, j] - 1, n)
+    NN /= np.sqrt(np.sum(NN*NN, axis=1))[:, None]
+    assert np.allclose(trifile._cape.TriNodeNormals(tri.Nodes, tri.Tris), NN)
+
+
+# Sums by component
+def test_03_compgeom():
+    tri = make_bump()
+    X, _, A, AV, _ = trifile._cape.TriGeom(tri.Nodes, tri.Tris)
+    I, CA, CAV, CX = trifile._cape.TriCompGeom(
+        tri.Nodes, tri.Tris, tri.CompID)
+    assert np.all(I == np.unique(tri.CompID))
+    for i, comp in enumerate(I):
+        k = tri.CompID == comp
+        assert np.isclose(CA[i], np.sum(A[k]))
+        assert np.allclose(CAV[i], np.sum(AV[k], axis=0))
+        assert np.allclose(
+            CX[i], np.sum(A[k, None]*X[k], axis=0) / np.sum(A[k]))
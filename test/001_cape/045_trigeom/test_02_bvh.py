@@ -0,0 +1,77 @@
+# -*- coding: utf-8 -*-
+
+# Third-party
+import numpy as np
+import pytest
+
+# Local imports
+import cape.trifile as trifile
+
+
+# Tree search is only in compiled module
+pytestmark = pytest.mark.skipif(
+    trifile._cape is None, reason="compiled module not available")
+
+
+# Flat plate of 4x3 cells, one component (8 tris) per row
+def make_plate():
+    x, y = np.meshgrid(np.arange(5.0), np.arange(4.0))
+    nodes = np.vstack((x.ravel(), 0.5*y.ravel(), np.zeros(x.size))).T
+    # Lower-left node of each cell
+    n = (np.arange(3)[:, None]*5 + np.arange(4) + 1).ravel()
+    # Two tris per cell
+    tris = np.stack((
+        np.array([n, n + 1, n + 6]).T,
+        np.array([n, n + 6, n + 5]).T), axis=1).reshape((-1, 3))
+    compid = np.repeat([1, 2, 3], 8)
+    tri = trifile.Tri(Nodes=nodes, Tris=tris, CompID=compid)
+    tri.GetCenters()
+    tri.GetNormals()
+    return tri
+
+
+# Nearest tri and nearest tri of each other component
+def test_01_nearest():
+    tri = make_plate()
+    # Points just above center of each tri
+    X = tri.Centers + 0.1*tri.Normals
+    T = tri.GetNearestTris(X, n=2)
+    assert np.all(T["k1"] == np.arange(tri.nTri))
+    assert np.all(T["c1"] == tri.CompID)
+    assert np.allclose(T["d1"], 0.1)
+    assert np.allclose(T["z1"], 0.1)
+    assert np.allclose(T["t1"], 0.0)
+    # Second component
+    assert np.all(T["c2"] != T["c1"])
+    assert np.all(T["d2"] >= T["d1"])
+    assert np.allclose(T["d2"]**2, T["z2"]**2 + T["t2"]**2)
+    # Single point
+    T1 = tri.GetNearestTri(X[5], n=2)
+    assert T1["k1"] == 5
+    assert T1["k2"] == T["k2"][5]
+    # Only three components; no fourth match
+    T = tri.GetNearestTris(X[:2], n=4)
+    assert np.all(T["k4"] == -1)
+
+
+# Map component IDs from one triangulation to another
+def test_02_mapcompid():
+    tri = make_plate()
+    # Mapping to itself shifts component IDs already in use
+    tri1 = make_plate()
+    tri1.MapTriCompID(tri)
+    assert np.all(tri1.CompID == tri.CompID + 3)
+
+
+# Tree is rebuilt after in-place edits of component IDs
+def test_03_editcompid():
+    tri = make_plate()
+    X = tri.Centers + 0.1*tri.Normals
+    T1 = tri.GetNearestTri(X[5], n=2)
+    assert T1["c1"] == 1
+    # Edit component IDs in place
+    tri.CompID[5] = 7
+    T1 = tri.GetNearestTri(X[5], n=2)
+    assert T1["k1"] == 5
+    assert T1["c1"] == 7
+    assert T1["c2"] == 1
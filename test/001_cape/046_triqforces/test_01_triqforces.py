@@ -0,0 +1,63 @@
+# -*- coding: utf-8 -*-
+
+# Third-party
+import numpy as np
+import pytest
+
+# Local imports
+import cape.trifile as trifile
+
+
+# Compiled sums are compared to Python integration
+pytestmark = pytest.mark.skipif(
+    trifile._cape is None, reason="compiled module not available")
+
+# Flow conditions and reference values
+CONDITIONS = dict(mach=0.8, Re=1e4, Lref=2.0, incm=True)
+
+
+# Curved plate with pressure and viscous states; one component per row
+def make_triq(nx=5, ny=3):
+    x, y = np.meshgrid(np.arange(nx + 1.0), 0.5*np.arange(ny + 1.0))
+    x = x.ravel()
+    y = y.ravel()
+    nodes = np.vstack((x, y, 0.1*x*y)).T
+    # Lower-left node of each cell
+    n = (np.arange(ny)[:, None]*(nx + 1) + np.arange(nx) + 1).ravel()
+    tris = np.vstack((
+        np.array([n, n + 1, n + nx + 2]).T,
+        np.array([n, n + nx + 2, n + nx + 1]).T))
+    compid = np.tile(np.repeat(np.arange(1, ny + 1), nx), 2)
+    # Cp, rho, velocity, pressure, and skin friction
+    q = np.zeros((x.size, 9))
+    q[:, 0] = 0.2*x - 0.1*y
+    q[:, 1] = 1.0
+    q[:, 2] = 0.5 + 0.1*y
+    q[:, 4] = -0.1*x
+    q[:, 5] = 1.0
+    q[:, 6] = 0.01*y
+    q[:, 8] = 0.02*x
+    return trifile.Triq(Nodes=nodes, Tris=tris, CompID=compid, q=q)
+
+
+# Forces and moments on one or more components
+def test_01_triforces():
+    triq = make_triq()
+    MRP = [1.0, 0.5, 0.2]
+    for comp in (1, [2, 3], None):
+        FM0 = triq.GetTriForces(comp, save=True, MRP=MRP, **CONDITIONS)
+        FM1 = triq.GetTriForces(comp, MRP=MRP, **CONDITIONS)
+        for k, v in FM0.items():
+            assert np.allclose(FM1[k], v, atol=1e-12)
+
+
+# Several components and MRPs at once
+def test_02_compforces():
+    triq = make_triq()
+    MRPs = [[0.0, 0.0, 0.0], [2.0, 1.0, 0.0]]
+    FM = triq.GetCompTriForces([1, 3], MRPs=MRPs, **CONDITIONS)
+    for comp, FMc in zip([1, 3], FM):
+        for mrp, FMj in zip(MRPs, FMc):
+            FM0 = triq.GetTriForces(comp, save=True, MRP=mrp, **CONDITIONS)
+            for k, v in FM0.items():
+                assert np.allclose(FMj[k], v, atol=1e-12)
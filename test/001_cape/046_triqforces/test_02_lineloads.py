@@ -0,0 +1,57 @@
+# -*- coding: utf-8 -*-
+
+# Third-party
+import numpy as np
+import pytest
+
+# Local imports
+import cape.trifile as trifile
+
+
+# Line loads are integrated in compiled module
+pytestmark = pytest.mark.skipif(
+    trifile._cape is None, reason="compiled module not available")
+
+# Conditions and cuts: one station every half cell
+CONDITIONS = dict(mach=0.8, MRP=[1.0, 0.0, 0.0], nCut=8)
+
+
+# Flat 4 x 1.5 plate with uniform pressure; one component per row
+def make_plate(cp=0.5):
+    x, y = np.meshgrid(np.arange(5.0), 0.5*np.arange(4.0))
+    nodes = np.vstack((x.ravel(), y.ravel(), np.zeros(x.size))).T
+    # Lower-left node of each cell
+    n = (np.arange(3)[:, None]*5 + np.arange(4) + 1).ravel()
+    tris = np.vstack((
+        np.array([n, n + 1, n + 6]).T,
+        np.array([n, n + 6, n + 5]).T))
+    compid = np.tile(np.repeat([1, 2, 3], 4), 2)
+    q = np.full((x.size, 1), cp)
+    return trifile.Triq(Nodes=nodes, Tris=tris, CompID=compid, q=q)
+
+
+# Line loads on whole plate
+def test_01_lineloads():
+    triq = make_plate(0.5)
+    LL = triq.GetLineLoads(**CONDITIONS)
+    # Stations at ends of each grid cell and in between
+    assert np.allclose(LL["x"], np.linspace(0.0, 4.0, 9))
+    # Load per unit length is pressure times width of plate
+    assert np.allclose(LL["CN"][1:-1], -0.5*1.5)
+    assert np.allclose(LL["CN"][[0, -1]], -0.5*0.75)
+
+
+# Sectional and cumulative loads add up to integrated loads
+def test_02_integrated():
+    triq = make_plate(0.5)
+    FM = triq.GetTriForces(**CONDITIONS)
+    for sec in ("slds", "clds"):
+        LL = triq.GetLineLoads(sec=sec, **CONDITIONS)
+        for k in ("CN", "CLM", "CLL", "CA"):
+            v = LL[k][-1] if sec == "clds" else np.sum(LL[k])
+            assert np.isclose(v, FM[k])
+    # Single component
+    LL = triq.GetLineLoads(2, sec="slds", **CONDITIONS)
+    FM = triq.GetTriForces(2, **CONDITIONS)
+    assert np.isclose(np.sum(LL["CN"]), FM["CN"])
+    assert np.isclose(np.sum(LL["CLM"]), FM["CLM"])
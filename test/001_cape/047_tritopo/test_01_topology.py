@@ -0,0 +1,81 @@
+# -*- coding: utf-8 -*-
+
+# Third-party
+import numpy as np
+import pytest
+
+# Local imports
+import cape.trifile as trifile
+
+
+# Compiled edge tables are compared to Python versions
+pytestmark = pytest.mark.skipif(
+    trifile._cape is None, reason="compiled module not available")
+
+
+# Open 4x3 grid of 1 x 0.5 cells split into tris; one component per row
+def make_grid():
+    x, y = np.meshgrid(np.arange(5.0), 0.5*np.arange(4.0))
+    nodes = np.vstack((x.ravel(), y.ravel(), np.zeros(x.size))).T
+    # Lower-left node of each cell, then two tris per cell
+    n = (np.arange(3)[:, None]*5 + np.arange(4) + 1).ravel()
+    tris = np.stack((
+        np.array([n, n + 1, n + 6]).T,
+        np.array([n, n + 6, n + 5]).T), axis=1).reshape((-1, 3))
+    compid = np.repeat([1, 2, 3], 8)
+    return trifile.Tri(Nodes=nodes, Tris=tris, CompID=compid)
+
+
+# Edge counts and saved topology
+def test_01_topology():
+    tri = make_grid()
+    T = tri.GetTopology()
+    # Horizontal, vertical, and diagonal edges
+    assert T["nedge"] == 4*4 + 5*3 + 12
+    assert T["nopen"] == 14
+    assert T["nnonmanifold"] == 0
+    # Saved topology is reused until *Tris* is replaced
+    assert tri.GetTopology() is T
+    tri.Tris = np.vstack((tri.Tris[:-1], [[18, 19, 19]]))
+    assert tri.GetTopology() is not T
+
+
+# Open, nonmanifold, and component boundary edges
+def test_02_edges(monkeypatch):
+    tri = make_grid()
+    # Open edges are on the perimeter of the grid
+    E = tri.GetOpenEdges()
+    X = tri.Nodes[E - 1]
+    assert E.shape == (14, 2)
+    assert np.all(np.any(
+        (X[:, :, 0] == 0) | (X[:, :, 0] == 4) |
+        (X[:, :, 1] == 0) | (X[:, :, 1] == 1.5), axis=1))
+    assert tri.GetNonManifoldEdges().shape == (0, 2)
+    # Edges between components on two rows of horizontal edges
+    EC = tri.GetCompBoundaryEdges()
+    assert EC.shape == (8, 2)
+    assert np.all(np.isin(tri.Nodes[EC - 1, 1], [0.5, 1.0]))
+    # Edges around component 1 include the open edges next to it
+    assert tri.GetCompBoundaryEdges(1).shape == (10, 2)
+    # Python versions give the same edges, maybe in a different order
+    with monkeypatch.context() as m:
+        m.setattr(trifile, "_cape", None)
+        tri1 = make_grid()
+        assert tri1.GetTopology() is None
+        E1 = tri1.GetOpenEdges()
+        EC1 = tri1.GetCompBoundaryEdges()
+    assert set(map(tuple, E1)) == set(map(tuple, E))
+    assert set(map(tuple, EC1)) == set(map(tuple, EC))
+
+
+# Tri and node neighbors
+def test_03_neighbors(monkeypatch):
+    tri = make_grid()
+    assert np.all(tri.FindNeighbors(0) == [0, 4, 2])
+    assert np.all(tri.GetNodeNeighbors(7) == [1, 2, 6, 8, 12, 13])
+    # Python versions
+    with monkeypatch.context() as m:
+        m.setattr(trifile, "_cape", None)
+        tri1 = make_grid()
+        assert np.all(tri1.FindNeighbors(0) == [0, 4, 2])
+        assert np.all(tri1.GetNodeNeighbors(7) == [1, 2, 6, 8, 12, 13])
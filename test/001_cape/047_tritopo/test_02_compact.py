@@ -0,0 +1,94 @@
+# -*- coding: utf-8 -*-
+
+# Third-party
+import numpy as np
+import pytest
+
+# Local imports
+import cape.trifile as trifile
+
+
+# Compiled compaction is compared to Python versions
+pytestmark = pytest.mark.skipif(
+    trifile._cape is None, reason="compiled module not available")
+
+
+# Open 4x3 grid of 1 x 0.5 cells split into tris; one component per row
+def make_grid(x0=0.0):
+    x, y = np.meshgrid(x0 + np.arange(5.0), 0.5*np.arange(4.0))
+    nodes = np.vstack((x.ravel(), y.ravel(), np.zeros(x.size))).T
+    # Lower-left node of each cell, then two tris per cell
+    n = (np.arange(3)[:, None]*5 + np.arange(4) + 1).ravel()
+    tris = np.stack((
+        np.array([n, n + 1, n + 6]).T,
+        np.array([n, n + 6, n + 5]).T), axis=1).reshape((-1, 3))
+    compid = np.repeat([1, 2, 3], 8)
+    return trifile.Tri(Nodes=nodes, Tris=tris, CompID=compid)
+
+
+# Joining two grids that share one column of nodes
+def test_01_weld(monkeypatch):
+    tri = make_grid()
+    tri.Add(make_grid(4.0), tol=1e-8)
+    assert tri.nNode == 36
+    assert tri.Nodes.shape == (36, 3)
+    assert tri.Tris.max() == 36
+    assert np.all(tri.Nodes[:20] == make_grid().Nodes)
+    # Every node is still used
+    assert np.all(np.bincount(tri.Tris.ravel())[1:] >= 1)
+    # Welding again does nothing
+    T = tri.Tris.copy()
+    tri.WeldNodes()
+    assert np.all(tri.Tris == T)
+    # Python version
+    with monkeypatch.context() as m:
+        m.setattr(trifile, "_cape", None)
+        tri1 = make_grid()
+        tri1.Add(make_grid(4.0), tol=1e-8)
+    assert tri1.nNode == 36
+
+
+# Welding merges by distance into the first kept node, either way
+def test_02_weldtol(monkeypatch):
+    nodes = [[0.0, 0, 0], [0.09, 0, 0], [0.18, 0, 0], [1, 0, 0], [0, 1, 0]]
+    tris = [[1, 4, 5], [2, 4, 5], [3, 4, 5]]
+    tri = trifile.Tri(Nodes=np.array(nodes), Tris=np.array(tris))
+    tri.WeldNodes(tol=0.1)
+    with monkeypatch.context() as m:
+        m.setattr(trifile, "_cape", None)
+        tri1 = trifile.Tri(Nodes=np.array(nodes), Tris=np.array(tris))
+        tri1.WeldNodes(tol=0.1)
+    for t in (tri, tri1):
+        assert t.nNode == 4
+        assert np.all(t.Nodes[:, 0] == [0.0, 0.18, 1.0, 0.0])
+        assert np.all(t.Tris == [[1, 3, 4], [1, 3, 4], [2, 3, 4]])
+
+
+# Component with unused nodes
+def test_03_unused(monkeypatch):
+    tri = make_grid().GetSubTri(2)
+    assert tri.nNode == 10
+    assert tri.Tris.min() == 1 and tri.Tris.max() == 10
+    with monkeypatch.context() as m:
+        m.setattr(trifile, "_cape", None)
+        tri1 = make_grid().GetSubTri(2)
+    assert np.all(tri1.Nodes == tri.Nodes)
+    assert np.all(tri1.Tris == tri.Tris)
+
+
+# Sliver tris between nodes 7 and 8
+def test_04_smalltris(monkeypatch):
+    tri = make_grid()
+    tri.Nodes[6, 0] = 2.0 - 1e-6
+    tri.RemoveSmallTris()
+    assert tri.nTri == 22
+    assert tri.nNode == 19
+    assert tri.CompID.size == 22
+    with monkeypatch.context() as m:
+        m.setattr(trifile, "_cape", None)
+        tri1 = make_grid()
+        tri1.Nodes[6, 0] = 2.0 - 1e-6
+        tri1.RemoveSmallTris()
+    assert np.all(tri1.Nodes == tri.Nodes)
+    assert np.all(tri1.Tris == tri.Tris)
+    assert np.all(tri1.CompID == tri.CompID)
@@ -0,0 +1,107 @@
+# -*- coding: utf-8 -*-
+
+# Third-party
+import numpy as np
+import pytest
+import testutils
+
+# Local imports
+from cape.gruvoc import ugridfile
+from cape.gruvoc.umesh import Umesh
+
+
+# Compiled reader is compared to Python reader throughout
+pytestmark = pytest.mark.skipif(
+    ugridfile._cape is None, reason="compiled module not available")
+
+# Source file
+UGRIDFILE = "ascii.ugrid"
+# Binary formats to test
+FORMATS = ("b4", "lb4", "b8", "lb8", "r4", "lr4", "r8", "lr8")
+# Surface slots of each mesh
+SURF_SLOTS = ("nodes", "tris", "tri_ids", "tri_flags", "tri_bcs")
+
+# Small ASCII UGRID file: two tets on top of two tris
+UGRID_ASCII = """5 2 0 2 0 0 0
+0.0 0.0 0.0
+1.0 0.0 0.0
+1.0 1.0 0.0
+0.0 1.0 0.0
+0.5 0.5 0.75
+1 2 3
+1 3 4
+1 2
+1 2 3 5
+1 3 4 5
+0
+3 3
+0 0
+4 5
+"""
+
+
+# Write the source mesh and read it
+def read_source():
+    with open(UGRIDFILE, "w") as fp:
+        fp.write(UGRID_ASCII)
+    return Umesh(UGRIDFILE)
+
+
+# Read a mesh from a file handle, which always uses the Python reader
+def read_fp(fname, **kw):
+    mesh = Umesh()
+    with open(fname, "rb") as fp:
+        ugridfile.read_ugrid(mesh, fp, **kw)
+    return mesh
+
+
+# Write each format and read it back with both readers
+@testutils.run_sandbox(__file__)
+def test_01_readwrite():
+    mesh0 = read_source()
+    assert mesh0.ntet == 2
+    assert np.all(mesh0.tri_bcs == [4, 5])
+    # Loop through formats
+    for fmt in ("ascii",) + FORMATS:
+        fname = f"mesh.{fmt}.ugrid"
+        mesh0.write_ugrid(fname, fmt=fmt)
+        mesh1 = Umesh(fname)
+        mesh2 = read_fp(fname)
+        for slot in SURF_SLOTS + ("tets", "tet_ids"):
+            assert np.allclose(getattr(mesh1, slot), getattr(mesh0, slot))
+            assert np.allclose(getattr(mesh2, slot), getattr(mesh0, slot))
+
+
+# Read only the surface
+@testutils.run_sandbox(__file__)
+def test_02_novol():
+    mesh0 = read_source()
+    # Loop through formats
+    for fmt in ("ascii",) + FORMATS:
+        fname = f"mesh.{fmt}.ugrid"
+        mesh0.write_ugrid(fname, fmt=fmt)
+        # Compiled and Python readers
+        mesh1 = Umesh()
+        mesh1.read_ugrid(fname, novol=True)
+        mesh2 = read_fp(fname, novol=True)
+        # Surface flags and BCs come after the skipped volume cells
+        for mesh in (mesh1, mesh2):
+            assert mesh.tets is None
+            for slot in SURF_SLOTS:
+                assert np.allclose(getattr(mesh, slot), getattr(mesh0, slot))
+
+
+# Read selected groups
+@testutils.run_sandbox(__file__)
+def test_03_sections():
+    mesh0 = read_source()
+    # Loop through formats
+    for fmt in ("ascii",) + FORMATS:
+        fname = f"mesh.{fmt}.ugrid"
+        mesh0.write_ugrid(fname, fmt=fmt)
+        mesh1 = Umesh()
+        mesh1.read_ugrid(fname, sections=("tris", "surf_ids"))
+        mesh2 = read_fp(fname, sections=("tris", "surf_ids"))
+        for mesh in (mesh1, mesh2):
+            assert mesh.nodes is None
+            assert np.all(mesh.tri_ids == mesh0.tri_ids)
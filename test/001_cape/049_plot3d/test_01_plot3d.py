@@ -0,0 +1,100 @@
+# -*- coding: utf-8 -*-
+
+# Standard library
+import contextlib
+
+# Third-party
+import numpy as np
+import pytest
+import testutils
+
+# Local imports
+import cape.plot3d as plot3d
+from cape.pyover import plot3d as ovplot3d
+
+
+# Compiled reader is compared to Python reader throughout
+pytestmark = pytest.mark.skipif(
+    plot3d._cape is None, reason="compiled module not available")
+
+# Binary formats to test
+FORMATS = ("b4", "lb4", "b8", "lb8", "r4", "lr4", "r8", "lr8")
+
+
+# Two grids, stored as x, y, z of all points
+def make_grid():
+    x0 = plot3d.X()
+    x0.NG = 2
+    x0.dims = np.array([[3, 2, 2], [2, 2, 1]])
+    x0.X = np.arange(48, dtype="float").reshape((3, 16)) / 7.0
+    x0.iblank = False
+    return x0
+
+
+# Read with Python reader
+@contextlib.contextmanager
+def python_reader():
+    mod = plot3d._cape
+    plot3d._cape = None
+    try:
+        yield
+    finally:
+        plot3d._cape = mod
+
+
+# Write each format and read it back
+@testutils.run_sandbox(__file__)
+def test_01_grid():
+    x0 = make_grid()
+    for fmt in FORMATS:
+        fname = f"grid.{fmt}.x"
+        x0.Write(fname, fmt=fmt)
+        x1 = plot3d.X(fname)
+        assert x1.ext == fmt
+        assert np.all(x1.dims == x0.dims)
+        assert np.allclose(x1.X, x0.X)
+        # Python reader (record files only)
+        if "r" in fmt:
+            with python_reader():
+                x2 = plot3d.X(fname)
+            assert np.allclose(x2.X, x0.X)
+        # Second grid only
+        x3 = plot3d.X(fname, grids=[2])
+        assert x3.NG == 1
+        assert np.all(x3.IG == [2])
+        assert np.allclose(x3.X, x0.X[:, 12:])
+
+
+# Grid with IBLANK
+@testutils.run_sandbox(__file__)
+def test_02_iblank():
+    x0 = make_grid()
+    x0.iblank = True
+    x0.IB = np.array([1, 0, -1, 1] * 4, dtype="int32")
+    x0.Write("grid.ib.x", fmt="lb8")
+    x1 = plot3d.X("grid.ib.x")
+    assert x1.iblank
+    assert np.all(x1.IB == x0.IB)
+
+
+# OVERFLOW q file with 6 states and 2 grids
+@testutils.run_sandbox(__file__)
+def test_03_overflow_q():
+    hdr = np.array([
+        [0.8, 2.0, 1e6, 0.0, 1.4, 0.0, 450.0, 0,
+         0.0, 0.0, 0.0, 1.0, 1.0, 0.8, 0.0, 0.0],
+        [0.8, 2.0, 1e6, 1.0, 1.4, 0.0, 450.0, 1,
+         0.0, 0.0, 0.0, 1.0, 1.0, 0.8, 0.0, 0.0]])
+    Q = [np.ones((6, 2, 2, 3)), np.ones((6, 1, 2, 2))]
+    H = {"kind": "q", "fmt": "r8", "nqc": 0, "header": hdr}
+    plot3d._cape.WriteP3D("q.x.save", H, Q)
+    # Read the second grid
+    q = ovplot3d.Q("q.x.save", grids=[2])
+    assert q.ext == "r8"
+    assert q.nGrid == 2
+    assert q.Q[0] is None
+    assert q.Q[1].shape == (6, 1, 2, 2)
+    assert np.all(q._TIME == [0.0, 1.0])
+    assert np.all(q._IGAMMA == [0, 1])
+    # Read first grid on demand
+    assert q.GetQ(1).shape == (6, 2, 2, 3)
@@ -0,0 +1,78 @@
+# -*- coding: utf-8 -*-
+
+# Third-party
+import numpy as np
+import pytest
+import testutils
+
+# Local imports
+import cape.trifile as trifile
+
+
+# SURF readers are compared to compiled module
+pytestmark = pytest.mark.skipif(
+    trifile._cape is None, reason="compiled module not available")
+
+# Binary formats to test
+FORMATS = ("b4", "lb4", "b8", "lb8", "r4", "lr4", "r8", "lr8")
+
+
+# Two unit cells, one split into tris and one quad
+def make_surf():
+    nodes = np.array([
+        [0.0, 0.0, 0.0], [1.0, 0.0, 0.0], [2.0, 0.0, 0.0],
+        [0.0, 1.0, 0.0], [1.0, 1.0, 0.0], [2.0, 1.0, 0.0]])
+    tris = np.array([[1, 2, 5], [1, 5, 4]])
+    tri = trifile.Tri(Nodes=nodes, Tris=tris, CompID=np.array([1, 2]))
+    # BL parameters and BCs
+    tri.blds = 1e-4 * np.arange(1.0, tri.nNode + 1)
+    tri.bldel = 0.01 * np.arange(1.0, tri.nNode + 1)
+    tri.BCs = np.array([-1, 0])
+    # Quad
+    tri.Quads = np.array([[2, 3, 6, 5]])
+    tri.CompIDQuad = np.array([9])
+    tri.BCsQuad = np.array([2])
+    tri.nQuad = 1
+    return tri
+
+
+# Compiled and Python ASCII readers agree
+@testutils.run_sandbox(__file__)
+def test_01_ascii():
+    tri = make_surf()
+    tri.WriteSurf("grid.surf")
+    tri1 = trifile.Tri()
+    tri1.ReadSurfFast("grid.surf")
+    tri2 = trifile.Tri()
+    tri2.ReadSurfSlow("grid.surf")
+    for k in ("Nodes", "blds", "bldel", "Tris", "CompID", "BCs", "Quads"):
+        assert np.allclose(getattr(tri1, k), getattr(tri2, k))
+
+
+# Binary files, format from file name
+@testutils.run_sandbox(__file__)
+def test_02_bin():
+    tri = make_surf()
+    for fmt in FORMATS:
+        fname = f"grid.{fmt}.surf"
+        tri.WriteSurf(fname)
+        # Read it back, detecting format
+        tri1 = trifile.Tri()
+        tri1.ReadSurf(fname)
+        assert tri1.nNode == tri.nNode
+        assert tri1.nTri == tri.nTri
+        assert tri1.nQuad == 1
+        assert np.allclose(tri1.Nodes, tri.Nodes)
+        assert np.allclose(tri1.blds, tri.blds)
+        assert np.allclose(tri1.bldel, tri.bldel)
+        assert np.all(tri1.Tris == tri.Tris)
+        assert np.all(tri1.CompID == tri.CompID)
+        assert np.all(tri1.BCs == tri.BCs)
+        assert np.all(tri1.Quads == tri.Quads)
+        assert np.all(tri1.CompIDQuad == tri.CompIDQuad)
+        assert np.all(tri1.BCsQuad == tri.BCsQuad)
+        # Explicit format
+        X, T, Q = trifile._cape.ReadSurf(fname, fmt)
+        assert X.shape == (tri.nNode, 5)
+        assert T.shape == (tri.nTri, 6)
+        assert Q.shape[0] == 1
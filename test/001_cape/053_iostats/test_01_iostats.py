@@ -0,0 +1,45 @@
+# -*- coding: utf-8 -*-
+
+# Standard library
+import os
+
+# Third-party
+import numpy as np
+import pytest
+import testutils
+
+# Local imports
+import cape.trifile as trifile
+
+
+# Counters are in compiled module
+pytestmark = pytest.mark.skipif(
+    trifile._cape is None, reason="compiled module not available")
+
+# Single tri
+NODES = np.array([[0.0, 0.0, 0.0], [1.0, 0.0, 0.0], [0.0, 1.0, 0.0]])
+TRIS = np.array([[1, 2, 3]], dtype="i4")
+COMPID = np.array([1], dtype="i4")
+
+
+# Counters of extension functions
+@testutils.run_sandbox(__file__)
+def test_01_io_stats():
+    # Start from zero
+    trifile._cape.io_stats(reset=True)
+    assert trifile._cape.io_stats() == {}
+    # Write and read a file
+    trifile._cape.WriteTri_lb4(NODES, TRIS, COMPID, "a.tri")
+    nbyte = os.path.getsize("a.tri")
+    trifile._cape.ReadTri("a.tri")
+    # Write to memory
+    trifile._cape.WriteTri_lb4(NODES, TRIS, COMPID, bytearray())
+    # Check counters
+    stats = trifile._cape.io_stats(True)
+    assert stats["WriteTri_lb4"]["calls"] == 2
+    assert stats["WriteTri_lb4"]["bytes"] == 2 * nbyte
+    assert stats["ReadTri"]["calls"] == 1
+    assert stats["ReadTri"]["bytes"] == nbyte
+    assert stats["ReadTri"]["time"] >= 0.0
+    # Reset
+    assert trifile._cape.io_stats() == {}
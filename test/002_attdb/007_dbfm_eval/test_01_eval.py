@@ -1,6 +1,7 @@
 # -*- coding: utf-8 -*-
 
 # Third-party modules
+import numpy as np
 import testutils
 
 # Import CSV module
@@ -79,6 +80,26 @@ def test_02_clmx():
     # Test CLMX and CLNX
     assert abs(db("bullet.CLMX", *x) - 0.35217470) <= TOL
     assert abs(db("bullet.CLNX", *x) - 0.11741142) <= TOL
-        
 
 
+# Test evaluation at many points at once
+@testutils.run_testdir(__file__)
+def test_03_batch():
+    db = dbfm.FMDataKit(MAT_FILE)
+    # Normal force column
+    col = db.get_col_by_tag("CN")
+    # Standard args
+    args = ["mach", "alpha", "beta"]
+    # Get break points
+    db.create_bkpts(args)
+    # Set evaluation
+    db.make_responses([col], "linear", args)
+    # Conditions, some of them outside the break points
+    mach = np.linspace(0.5, 1.2, 15)
+    alph = np.linspace(-6.0, 6.0, 15)
+    beta = 0.5
+    # Evaluate all at once
+    v = db(col, mach, alph, beta)
+    # Compare to one point at a time
+    for j in range(mach.size):
+        assert abs(v[j] - db(col, mach[j], alph[j], beta)) <= TOL
@@ -1,10 +1,12 @@
 # -*- coding: utf-8 -*-
 
 # Third-party
+import numpy as np
 import testutils
 
 # Local imports
 import cape.dkit.rdb as rdb
+from cape.dkit import tsvfile
 
 
 # Read a dense tab-separated file
@@ -24,3 +26,18 @@ def test_02_read_tsv():
     assert db.get_col_type("beta") == "float64"
     assert db.get_col_type("CN") == "float64"
 
+
+
+# Compare extension and Python readers
+@testutils.run_testdir(__file__)
+def test_03_read_tsv_c():
+    # Read same file both ways
+    db1 = tsvfile.TSVFile()
+    db1.c_read_tsv("CN-default.tsv")
+    db2 = tsvfile.TSVFile()
+    db2.py_read_tsv("CN-default.tsv")
+    # Compare
+    assert db1.cols == db2.cols
+    for col in db1.cols:
+        assert db1[col].dtype.name == db2[col].dtype.name
+        assert np.allclose(db1[col], db2[col])
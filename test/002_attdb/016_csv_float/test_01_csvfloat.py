@@ -90,3 +90,38 @@ def test_05_csv_py():
     assert abs(mach - 1.2) <= TOL
     assert abs(beta - 4.0) <= TOL
 
+
+
+# Test incremental read of growing file
+@testutils.run_sandbox(__file__, CSVFILE)
+def test_06_csv_tail():
+    # Copy of file to append to
+    fname = "aeroenv-tail.csv"
+    with open(CSVFILE, 'r') as f:
+        lines = f.readlines()
+    with open(fname, 'w') as f:
+        f.writelines(lines)
+    # Initial (full) read
+    db = csvfile.CSVFile()
+    db.read_csv_tail(fname)
+    n = db.n
+    # Append rows, the last one incomplete
+    with open(fname, 'a') as f:
+        f.write(" 1.50,  2.00,  1.00\n 1.50,  4.00,")
+    # Read new rows only
+    db.read_csv_tail()
+    assert db.n == n + 1
+    assert db._n["beta"] == n + 1
+    assert abs(db["alpha"][n] - 2.0) <= TOL
+    # Finish last row
+    with open(fname, 'a') as f:
+        f.write("  2.00\n")
+    db.read_csv_tail()
+    assert db.n == n + 2
+    assert abs(db["beta"][n + 1] - 2.0) <= TOL
+    # Rewrite file with fewer rows
+    with open(fname, 'w') as f:
+        f.writelines(lines[:5])
+    db.read_csv_tail()
+    assert db.n == 4
+    assert abs(db["beta"][2] + 2.0) <= TOL
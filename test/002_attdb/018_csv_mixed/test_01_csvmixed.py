@@ -1,6 +1,11 @@
 # -*- coding: utf-8 -*-
 
+# Standard library
+import os
+import shutil
+
 # Third-party
+import pytest
 import testutils
 
 # Local imports
@@ -9,6 +14,7 @@ from cape.dkit import csvfile
 
 # File names
 CSVFILE = "runmatrix.csv"
+CSVCOPY = "runmatrix-cache.csv"
 # Test tolerance
 TOL = 1e-8
 
@@ -44,3 +50,31 @@ def test_02_dtypes():
     assert db["mach"].dtype.name == "float16"
     assert db["alpha"].dtype.name == "float32"
 
+
+
+# Test binary cache of columns
+@testutils.run_sandbox(__file__, CSVFILE)
+def test_03_cache():
+    # Skip if not compiled
+    if csvfile._cape is None:
+        pytest.skip("compiled module not available")
+    # Work on a copy
+    shutil.copy(CSVFILE, CSVCOPY)
+    # First read writes cache
+    db1 = csvfile.CSVFile(CSVCOPY, Cache=True)
+    fcache = db1.get_colcache_fname(CSVCOPY)
+    assert os.path.isfile(fcache)
+    # Second read uses it
+    db2 = csvfile.CSVFile(CSVCOPY, Cache=True)
+    assert db2.n == db1.n
+    for col in db1.cols:
+        assert list(db2[col]) == list(db1[col])
+    assert isinstance(db2["config"], list)
+    # Rewrite source with a different value
+    with open(CSVCOPY, "r") as fp:
+        txt = fp.read()
+    with open(CSVCOPY, "w") as fp:
+        fp.write(txt.replace("@user3", "@user9"))
+    # Stale cache is ignored
+    db3 = csvfile.CSVFile(CSVCOPY, Cache=True)
+    assert db3["user"][6] == "@user9"